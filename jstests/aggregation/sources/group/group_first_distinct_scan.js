@@ -0,0 +1,133 @@
+// A $sort followed by a $group with only $first (or only $last) accumulators, grouped on the
+// leading sort field, can be answered by a DISTINCT_SCAN which reads a single index entry per
+// group, as can a $group with no accumulators at all. In this test file, we check the results and,
+// through explain(), that the optimization is only used when it is safe.
+//
+// Cannot implicitly shard accessed collections because the explain output from a mongod when run
+// against a sharded collection is wrapped in a "shards" object with keys for each shard.
+// @tags: [do_not_wrap_aggregations_in_facets,assumes_unsharded_collection]
+load('jstests/libs/analyze_plan.js');
+
+(function() {
+    "use strict";
+
+    var coll = db.group_first_distinct_scan;
+    coll.drop();
+
+    for (var device = 0; device < 5; device++) {
+        for (var ts = 0; ts < 20; ts++) {
+            assert.writeOK(coll.insert({device: device, ts: ts, val: device * 100 + ts}));
+        }
+    }
+    assert.commandWorked(coll.createIndex({device: 1, ts: -1, val: 1}));
+
+    var latestPerDevice = [
+        {$sort: {device: 1, ts: -1}},
+        {$group: {_id: "$device", ts: {$first: "$ts"}, val: {$first: "$val"}}}
+    ];
+    var expected = [];
+    for (var device = 0; device < 5; device++) {
+        expected.push({_id: device, ts: 19, val: device * 100 + 19});
+    }
+
+    function runSorted(pipeline) {
+        return coll.aggregate(pipeline).toArray().sort(function(a, b) {
+            return a._id - b._id;
+        });
+    }
+
+    function winningPlan(pipeline) {
+        var explained = coll.explain().aggregate(pipeline);
+        return explained.stages[0].$cursor.queryPlanner.winningPlan;
+    }
+
+    assert.eq(expected, runSorted(latestPerDevice));
+    var plan = winningPlan(latestPerDevice);
+    assert(planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    assert(!planHasStage(plan, "FETCH"), tojson(plan));
+
+    // A field outside the index still uses the DISTINCT_SCAN, with a FETCH.
+    assert.writeOK(coll.update({}, {$set: {other: 1}}, {multi: true}));
+    var withFetch = [
+        {$sort: {device: 1, ts: -1}},
+        {$group: {_id: "$device", ts: {$first: "$ts"}, other: {$first: "$other"}}}
+    ];
+    plan = winningPlan(withFetch);
+    assert(planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    assert(planHasStage(plan, "FETCH"), tojson(plan));
+
+    // With a preceding $match.
+    var matched = [{$match: {device: {$gte: 3}}}].concat(latestPerDevice);
+    assert.eq(expected.slice(3), runSorted(matched));
+    assert(planHasStage(winningPlan(matched), "DISTINCT_SCAN"));
+
+    // Accumulators other than $first need every document of the group.
+    var withSum = [{$sort: {device: 1, ts: -1}}, {$group: {_id: "$device", n: {$sum: 1}}}];
+    assert(!planHasStage(winningPlan(withSum), "DISTINCT_SCAN"));
+    assert.eq(20, runSorted(withSum)[0].n);
+
+    // A $limit between the $sort and the $group applies to the documents before grouping.
+    var withLimit = [{$sort: {device: 1, ts: -1}}, {$limit: 30}].concat(latestPerDevice.slice(1));
+    assert(!planHasStage(winningPlan(withLimit), "DISTINCT_SCAN"));
+    assert.eq(2, runSorted(withLimit).length);
+
+    // The group key must be the leading sort field.
+    var otherOrder = [
+        {$sort: {ts: -1, device: 1}},
+        {$group: {_id: "$device", ts: {$first: "$ts"}, val: {$first: "$val"}}}
+    ];
+    assert(!planHasStage(winningPlan(otherOrder), "DISTINCT_SCAN"));
+
+    // $last finds the last document of each group by scanning in the reverse of the sort.
+    var earliestPerDevice = [
+        {$sort: {device: 1, ts: -1}},
+        {$group: {_id: "$device", ts: {$last: "$ts"}, val: {$last: "$val"}}}
+    ];
+    var expectedEarliest = [];
+    for (var device = 0; device < 5; device++) {
+        expectedEarliest.push({_id: device, ts: 0, val: device * 100});
+    }
+    assert.eq(expectedEarliest, runSorted(earliestPerDevice));
+    assert(planHasStage(winningPlan(earliestPerDevice), "DISTINCT_SCAN"));
+
+    // A mix of $first and $last needs both ends of each group.
+    var firstAndLast = [
+        {$sort: {device: 1, ts: -1}},
+        {$group: {_id: "$device", first: {$first: "$ts"}, last: {$last: "$ts"}}}
+    ];
+    assert(!planHasStage(winningPlan(firstAndLast), "DISTINCT_SCAN"));
+    assert.eq({_id: 0, first: 19, last: 0}, runSorted(firstAndLast)[0]);
+
+    // A $group with no accumulators needs no $sort.
+    var distinctDevices = [{$group: {_id: "$device"}}];
+    assert.eq([{_id: 0}, {_id: 1}, {_id: 2}, {_id: 3}, {_id: 4}], runSorted(distinctDevices));
+    assert(planHasStage(winningPlan(distinctDevices), "DISTINCT_SCAN"));
+
+    // Arrays in the index fields after the grouped one still leave one entry per group.
+    var multikeyColl = db.group_first_distinct_scan_multikey;
+    multikeyColl.drop();
+    assert.commandWorked(multikeyColl.createIndex({device: 1, ts: -1, tags: 1}));
+    assert.writeOK(multikeyColl.insert({device: 0, ts: 1, tags: ["a", "b"]}));
+    assert.writeOK(multikeyColl.insert({device: 0, ts: 2, tags: ["c", "d"]}));
+    assert.writeOK(multikeyColl.insert({device: 1, ts: 1, tags: ["e"]}));
+    var latestTags = [
+        {$sort: {device: 1, ts: -1}},
+        {$group: {_id: "$device", tags: {$first: "$tags"}}}
+    ];
+    var explained = multikeyColl.explain().aggregate(latestTags);
+    assert(planHasStage(explained.stages[0].$cursor.queryPlanner.winningPlan, "DISTINCT_SCAN"),
+           tojson(explained));
+    assert.eq([{_id: 0, tags: ["c", "d"]}, {_id: 1, tags: ["e"]}],
+              multikeyColl.aggregate(latestTags).toArray().sort(function(a, b) {
+                  return a._id - b._id;
+              }));
+
+    // Once the grouped field is multikey a DISTINCT_SCAN could return a document more than once.
+    assert.writeOK(coll.insert({device: [5, 6], ts: 100, val: 0}));
+    expected.push({_id: [5, 6], ts: 100, val: 0});
+    assert(!planHasStage(winningPlan(latestPerDevice), "DISTINCT_SCAN"));
+    assert(!planHasStage(winningPlan(distinctDevices), "DISTINCT_SCAN"));
+    assert.eq(expected, coll.aggregate(latestPerDevice).toArray().sort(function(a, b) {
+        return bsonWoCompare({x: a._id}, {x: b._id});
+    }));
+}());
@@ -0,0 +1,68 @@
+// A $match on the keys of a preceding $group also filters the input of the $group, when doing so
+// keeps every document of the groups the $match returns. In this test file, we check that the
+// results are unchanged and, through explain(), which predicates filter the input.
+//
+// Cannot implicitly shard accessed collections because the explain output from a mongod when run
+// against a sharded collection is wrapped in a "shards" object with keys for each shard.
+// @tags: [do_not_wrap_aggregations_in_facets,assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    var coll = db.group_match_on_group_key;
+    coll.drop();
+
+    assert.writeOK(coll.insert({_id: 0, a: 1}));
+    assert.writeOK(coll.insert({_id: 1, a: NumberLong(1)}));
+    assert.writeOK(coll.insert({_id: 2, a: 2}));
+    assert.writeOK(coll.insert({_id: 3, a: [1, 2]}));
+    assert.writeOK(coll.insert({_id: 4}));
+    assert.writeOK(coll.insert({_id: 5, a: null}));
+    assert.writeOK(coll.insert({_id: 6, a: "abc"}));
+    assert.writeOK(coll.insert({_id: 7, a: "ABC"}));
+
+    function countPerGroup(match, options) {
+        return coll
+            .aggregate([{$group: {_id: "$a", n: {$sum: 1}}}, {$match: match}, {$sort: {_id: 1}}],
+                       options || {})
+            .toArray();
+    }
+
+    function cursorQuery(pipeline) {
+        var explain = coll.explain().aggregate(pipeline);
+        assert(explain.hasOwnProperty("stages"), tojson(explain));
+        return explain.stages[0].$cursor.query;
+    }
+
+    // Arrays group as a whole, and a number matches the arrays containing it.
+    assert.eq([{_id: 1, n: 2}, {_id: [1, 2], n: 1}], countPerGroup({_id: 1}));
+    assert.eq([{_id: 2, n: 1}, {_id: [1, 2], n: 1}], countPerGroup({_id: {$gte: 2}}));
+    assert.eq([{_id: 2, n: 1}, {_id: [1, 2], n: 1}], countPerGroup({_id: {$in: [2, 3]}}));
+    assert.eq(
+        {a: {$eq: 1}},
+        cursorQuery([{$group: {_id: "$a", n: {$sum: 1}}}, {$match: {_id: 1, n: {$gt: 1}}}]));
+
+    // Documents without the field group with those where it is null, so predicates which match
+    // null are not used to filter the input.
+    assert.eq([{_id: null, n: 2}], countPerGroup({_id: null}));
+    assert.eq([{_id: null, n: 2}, {_id: 1, n: 2}, {_id: [1, 2], n: 1}],
+              countPerGroup({$or: [{_id: null}, {_id: 1}]}));
+    assert.eq({},
+              cursorQuery([{$group: {_id: "$a", n: {$sum: 1}}}, {$match: {_id: {$ne: 1}}}]));
+
+    // Keys of a compound _id which are top-level fields can filter the input.
+    var compound = [
+        {$group: {_id: {k: "$a", c: {$literal: 0}}, n: {$sum: 1}}},
+        {$match: {"_id.k": {$lt: 2}, "_id.c": 0}},
+        {$sort: {"_id.k": 1}}
+    ];
+    assert.eq([{_id: {k: 1, c: 0}, n: 2}, {_id: {k: [1, 2], c: 0}, n: 1}],
+              coll.aggregate(compound).toArray());
+    assert.eq({a: {$lt: 2}}, cursorQuery(compound));
+
+    // Strings which the collation considers equal group together, and are all kept by the
+    // filter.
+    var caseInsensitive = {collation: {locale: "en_US", strength: 2}};
+    var res = countPerGroup({_id: "abc"}, caseInsensitive);
+    assert.eq(1, res.length, tojson(res));
+    assert.eq(2, res[0].n, tojson(res));
+}());
@@ -0,0 +1,34 @@
+// Tests that $out, which builds the indexes of the output collection only after inserting all of
+// the results, still fails on a unique index violation and leaves the output collection untouched.
+// @tags: [assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    var input = db.out_deferred_index_build_in;
+    var output = db.out_deferred_index_build_out;
+    input.drop();
+    output.drop();
+
+    for (var i = 0; i < 10; i++) {
+        assert.writeOK(input.insert({_id: i, a: i % 5}));
+    }
+    assert.writeOK(output.insert({_id: "original"}));
+    assert.commandWorked(output.createIndex({a: 1}, {unique: true}));
+    assert.commandWorked(output.createIndex({b: 1}));
+
+    // Distinct values of 'a' build every index.
+    input.aggregate([{$match: {_id: {$lt: 5}}}, {$out: output.getName()}]);
+    assert.eq(5, output.find().itcount());
+    assert.eq(3, output.getIndexes().length);
+    assert.eq(1, output.find({a: 3}).hint({a: 1}).itcount());
+
+    // Duplicate values of 'a' fail the $out.
+    assert.commandFailed(db.runCommand(
+        {aggregate: input.getName(), pipeline: [{$out: output.getName()}], cursor: {}}));
+    assert.eq(5, output.find().itcount());
+    assert.eq(3, output.getIndexes().length);
+
+    var tempCollections = db.runCommand({listCollections: 1, filter: {name: /tmp\.agg_out/}});
+    assert.commandWorked(tempCollections);
+    assert.eq([], tempCollections.cursor.firstBatch);
+}());
@@ -0,0 +1,81 @@
+// Tests that a batch of upserts by _id, whose _ids are looked up together and whose inserts are
+// batched, behaves as if the upserts were performed one after the other.
+(function() {
+    "use strict";
+
+    var coll = db.batched_id_upserts;
+    coll.drop();
+
+    assert.writeOK(coll.insert([{_id: 1, n: 10}, {_id: 3, n: 30}, {_id: 5, s: "str"}]));
+
+    var bulk = coll.initializeOrderedBulkOp();
+    bulk.find({_id: 0}).upsert().updateOne({$set: {n: 0}, $setOnInsert: {created: true}});
+    bulk.find({_id: 1}).upsert().updateOne({$inc: {n: 1}, $setOnInsert: {created: true}});
+    bulk.find({_id: 2}).upsert().replaceOne({n: 20});
+    bulk.find({_id: 4}).upsert().updateOne({$inc: {n: 4}});
+    // Upserts to an _id inserted earlier in the batch update it.
+    bulk.find({_id: 4}).upsert().updateOne({$inc: {n: 4}});
+    bulk.find({_id: 3}).upsert().updateOne({$set: {n: 31}});
+    bulk.find({_id: 6}).upsert().updateOne({$set: {n: 60}});
+    var res = assert.writeOK(bulk.execute());
+    assert.eq(4, res.nUpserted, tojson(res));
+    assert.eq(3, res.nMatched, tojson(res));
+    assert.eq(3, res.nModified, tojson(res));
+    assert.eq([0, 2, 4, 6],
+              res.getUpsertedIds().map(function(upsert) {
+                  return upsert._id;
+              }),
+              tojson(res));
+    assert.eq([0, 2, 3, 6],
+              res.getUpsertedIds().map(function(upsert) {
+                  return upsert.index;
+              }),
+              tojson(res));
+
+    assert.eq({_id: 0, n: 0, created: true}, coll.findOne({_id: 0}));
+    assert.eq({_id: 1, n: 11}, coll.findOne({_id: 1}));
+    assert.eq({_id: 2, n: 20}, coll.findOne({_id: 2}));
+    assert.eq({_id: 3, n: 31}, coll.findOne({_id: 3}));
+    assert.eq({_id: 4, n: 8}, coll.findOne({_id: 4}));
+    assert.eq({_id: 6, n: 60}, coll.findOne({_id: 6}));
+
+    // An ordered batch stops at its first error, leaving the upserts after it undone.
+    bulk = coll.initializeOrderedBulkOp();
+    bulk.find({_id: 7}).upsert().updateOne({$set: {n: 70}});
+    bulk.find({_id: 5}).upsert().updateOne({$inc: {s: 1}});
+    bulk.find({_id: 8}).upsert().updateOne({$set: {n: 80}});
+    assert.throws(function() {
+        bulk.execute();
+    });
+    assert.eq(1, coll.count({_id: 7}));
+    assert.eq(0, coll.count({_id: 8}));
+
+    // An unordered batch reports the error at its index and performs the others.
+    bulk = coll.initializeUnorderedBulkOp();
+    bulk.find({_id: 9}).upsert().updateOne({$set: {n: 90}});
+    bulk.find({_id: 5}).upsert().updateOne({$inc: {s: 1}});
+    bulk.find({_id: 10}).upsert().updateOne({$set: {n: 100}});
+    var error = assert.throws(function() {
+        bulk.execute();
+    });
+    assert.eq(1, error.getWriteErrorCount(), tojson(error));
+    assert.eq(1, error.getWriteErrorAt(0).index, tojson(error));
+    assert.eq(2, error.toResult().nUpserted, tojson(error));
+    assert.eq(1, coll.count({_id: 9}));
+    assert.eq(1, coll.count({_id: 10}));
+
+    // An upserted document which is invalid is reported at its own index.
+    bulk = coll.initializeUnorderedBulkOp();
+    bulk.find({_id: 11}).upsert().updateOne({$set: {n: 110}});
+    bulk.find({_id: 12}).upsert().updateOne({$set: {$bad: 1}});
+    bulk.find({_id: 14}).upsert().updateOne({$set: {n: 140}});
+    error = assert.throws(function() {
+        bulk.execute();
+    });
+    assert.eq(1, error.getWriteErrorCount(), tojson(error));
+    assert.eq(1, error.getWriteErrorAt(0).index, tojson(error));
+    assert.eq(0, coll.count({_id: 12}));
+    assert.eq(2, coll.count({_id: {$in: [11, 14]}}));
+
+    assert(coll.validate().valid);
+}());
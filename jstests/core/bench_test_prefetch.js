@@ -0,0 +1,37 @@
+// Tests that benchRun find ops which prefetch their getMore batches see every document.
+(function() {
+    "use strict";
+
+    var t = db.bench_test_prefetch;
+    t.drop();
+
+    var bulk = t.initializeUnorderedBulkOp();
+    for (var i = 0; i < 100; i++) {
+        bulk.insert({_id: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    var benchArgs = {
+        ops: [{
+            op: "find",
+            ns: t.getFullName(),
+            query: {},
+            batchSize: 10,
+            prefetch: true,
+            expected: 100
+        }],
+        parallel: 2,
+        seconds: 2,
+        host: db.getMongo().host
+    };
+
+    if (jsTest.options().auth) {
+        benchArgs['db'] = 'admin';
+        benchArgs['username'] = jsTest.options().authUser;
+        benchArgs['password'] = jsTest.options().authPassword;
+    }
+
+    var res = benchRun(benchArgs);
+    assert.eq(0, res.errCount, tojson(res));
+    assert.gt(res.query, 0, tojson(res));
+}());
@@ -0,0 +1,61 @@
+// Tests the per-range hashes that dbHash returns with 'rangeSize'.
+// @tags: [assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    var mydb = db.getSiblingDB("dbhash_ranges");
+    assert.commandWorked(mydb.dropDatabase());
+
+    var docs = [];
+    for (var i = 0; i < 500; i++) {
+        docs.push({_id: i, x: i});
+    }
+    assert.writeOK(mydb.a.insert(docs));
+    assert.writeOK(mydb.b.insert(docs));
+
+    assert.commandFailed(mydb.runCommand({dbHash: 1, rangeSize: 0}));
+    assert.commandFailed(mydb.runCommand({dbHash: 1, rangeSize: "10"}));
+
+    var plain = assert.commandWorked(mydb.runCommand({dbHash: 1}));
+    assert(!plain.hasOwnProperty("ranges"), tojson(plain));
+
+    var res = assert.commandWorked(mydb.runCommand({dbHash: 1, rangeSize: 20}));
+    // The hash of a whole collection does not depend on its ranges being hashed too.
+    assert.eq(plain.collections.a, res.collections.a);
+    assert.eq(plain.md5, res.md5);
+
+    var ranges = res.ranges.a;
+    assert.gt(ranges.length, 1, tojson(res));
+    assert.eq(0, ranges[0].min, tojson(ranges));
+    var total = 0;
+    for (var j = 0; j < ranges.length; j++) {
+        total += ranges[j].count;
+        if (j > 0) {
+            assert.gt(ranges[j].min, ranges[j - 1].min, tojson(ranges));
+        }
+    }
+    assert.eq(500, total, tojson(ranges));
+    assert.eq(ranges, res.ranges.b);
+
+    // A changed document only changes the hash of the range it is in, and documents missing
+    // from one collection leave the bounds of the other ranges where they were.
+    var m = 0;
+    while (ranges[m].count < 3) {
+        m++;
+    }
+    assert.writeOK(mydb.b.update({_id: ranges[m].min + 1}, {$set: {x: -1}}));
+    assert.writeOK(mydb.b.remove({_id: ranges[m].min + 2}));
+    var changed = assert.commandWorked(mydb.runCommand({dbHash: 1, rangeSize: 20})).ranges.b;
+    assert.eq(ranges.length, changed.length, tojson(changed));
+    for (var k = 0; k < ranges.length; k++) {
+        assert.eq(ranges[k].min, changed[k].min, tojson(changed));
+        if (k === m) {
+            assert.neq(ranges[k].md5, changed[k].md5, tojson(changed));
+            assert.eq(ranges[k].count - 1, changed[k].count, tojson(changed));
+        } else {
+            assert.eq(ranges[k], changed[k], tojson(changed));
+        }
+    }
+
+    assert.commandWorked(mydb.dropDatabase());
+}());
@@ -138,3 +138,17 @@ explain = db.runCommand(
     {explain: {count: collName, query: {a: 2}, limit: 2}, verbosity: "executionStats"});
 checkCountExplain(explain, 1);
 checkCountScanIndexExplain(explain, {a: 2}, {a: 2}, true, true);
+
+// An $in is counted by seeking to each of its values in turn.
+assert.eq(11, db.runCommand({count: collName, query: {a: {$in: [1, 2, 3]}}}).n);
+explain = db.runCommand(
+    {explain: {count: collName, query: {a: {$in: [1, 2, 3]}}}, verbosity: "executionStats"});
+checkCountExplain(explain, 11);
+checkCountScanIndexExplain(explain, {a: 1}, {a: 1}, true, true);
+var countScan = getPlanStage(explain.executionStats.executionStages, "COUNT_SCAN");
+assert.eq([
+    {startKey: {a: 2}, startKeyInclusive: true, endKey: {a: 2}, endKeyInclusive: true},
+    {startKey: {a: 3}, startKeyInclusive: true, endKey: {a: 3}, endKeyInclusive: true}
+],
+          countScan.additionalIndexBounds,
+          tojson(countScan));
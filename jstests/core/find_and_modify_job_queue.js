@@ -0,0 +1,44 @@
+// Cannot implicitly shard accessed collections because of following errmsg: A single
+// update/delete on a sharded collection must contain an exact match on _id or contain the shard
+// key.
+// @tags: [assumes_unsharded_collection]
+
+// Ensures that concurrent find and modify commands taking jobs from a queue each take a different
+// job, and apply their whole update once, when write conflicts make them retry.
+(function() {
+    "use strict";
+
+    var t = db.find_and_modify_job_queue;
+    t.drop();
+
+    assert.commandWorked(t.ensureIndex({status: 1, priority: -1}));
+    var numJobs = 200;
+    var bulk = t.initializeUnorderedBulkOp();
+    for (var i = 0; i < numJobs; i++) {
+        bulk.insert({_id: i, status: "ready", priority: i % 10, takenBy: []});
+    }
+    assert.writeOK(bulk.execute());
+
+    var numWorkers = 4;
+    var joins = [];
+    for (var w = 0; w < numWorkers; w++) {
+        joins.push(startParallelShell(
+            "var coll = db.find_and_modify_job_queue;" +
+            "while (coll.findAndModify({query: {status: 'ready'}," +
+            "                           sort: {priority: -1}," +
+            "                           update: {$set: {status: 'taken'}," +
+            "                                    $push: {takenBy: " + w + "}," +
+            "                                    $inc: {attempts: 1}}," +
+            "                           new: true})) {}"));
+    }
+    joins.forEach(function(join) {
+        join();
+    });
+
+    assert.eq(0, t.count({status: "ready"}));
+    t.find().forEach(function(doc) {
+        assert.eq("taken", doc.status, tojson(doc));
+        assert.eq(1, doc.attempts, tojson(doc));
+        assert.eq(1, doc.takenBy.length, tojson(doc));
+    });
+})();
@@ -0,0 +1,50 @@
+// Tests find commands which read a single document by _id, which the server answers with a lookup
+// in the _id index rather than a query plan.
+(function() {
+    "use strict";
+
+    var coll = db.find_id_point_read;
+    coll.drop();
+
+    assert.writeOK(coll.insert({_id: 0, a: 1, b: {c: 2, d: 3}}));
+    assert.writeOK(coll.insert({_id: "str", a: 4}));
+    assert.writeOK(coll.insert({_id: 2, arr: [1, 2, 3]}));
+
+    assert.eq([{_id: 0, a: 1, b: {c: 2, d: 3}}], coll.find({_id: 0}).toArray());
+    assert.eq([{_id: "str", a: 4}], coll.find({_id: "str"}).toArray());
+    assert.eq([], coll.find({_id: 1}).toArray());
+
+    // Inclusion and exclusion projections.
+    assert.eq([{_id: 0, a: 1}], coll.find({_id: 0}, {a: 1}).toArray());
+    assert.eq([{a: 1}], coll.find({_id: 0}, {_id: 0, a: 1}).toArray());
+    assert.eq([{_id: 0, b: {c: 2}}], coll.find({_id: 0}, {"b.c": 1}).toArray());
+    assert.eq([{_id: 0, a: 1}], coll.find({_id: 0}, {b: 0}).toArray());
+    assert.eq([{}], coll.find({_id: 0}, {_id: 0, x: 1}).toArray());
+
+    // Projections the point read leaves to the regular plan.
+    assert.eq([{_id: 2, arr: [1]}], coll.find({_id: 2}, {arr: {$slice: 1}}).toArray());
+    assert.commandFailed(
+        db.runCommand({find: coll.getName(), filter: {_id: 0}, projection: {a: 1, b: 0}}));
+
+    // Options which don't keep the read from returning a single batch.
+    var res = db.runCommand({find: coll.getName(), filter: {_id: 0}, limit: 1, batchSize: 1});
+    assert.commandWorked(res);
+    assert.eq(0, res.cursor.id);
+    assert.eq([{_id: 0, a: 1, b: {c: 2, d: 3}}], res.cursor.firstBatch);
+
+    // A batch size of 0 still returns an empty first batch and a cursor.
+    res = db.runCommand({find: coll.getName(), filter: {_id: 0}, batchSize: 0});
+    assert.commandWorked(res);
+    assert.eq([], res.cursor.firstBatch);
+    assert.eq([{_id: 0, a: 1, b: {c: 2, d: 3}}], new DBCommandCursor(db.getMongo(), res).toArray());
+
+    // A collection which doesn't exist.
+    assert.eq([], db.find_id_point_read_missing.find({_id: 0}).toArray());
+
+    // A view on the collection.
+    db.find_id_point_read_view.drop();
+    assert.commandWorked(
+        db.createView("find_id_point_read_view", coll.getName(), [{$project: {a: 1}}]));
+    assert.eq([{_id: 0, a: 1}], db.find_id_point_read_view.find({_id: 0}).toArray());
+    db.find_id_point_read_view.drop();
+}());
@@ -0,0 +1,55 @@
+// Tests that a text search sorted by the text score with a limit, which only fetches the best
+// scoring documents, returns the same results as the full search.
+// @tags: [assumes_unsharded_collection]
+load("jstests/libs/analyze_plan.js");
+
+(function() {
+    "use strict";
+
+    var coll = db.fts_score_sort_limit;
+    coll.drop();
+
+    var docs = [];
+    for (var i = 0; i < 100; i++) {
+        docs.push({_id: i, a: "content" + " filler".repeat(i % 17), b: i % 2});
+    }
+    assert.writeOK(coll.insert(docs));
+    assert.commandWorked(coll.createIndex({a: "text"}));
+
+    function scores(query, limit) {
+        var cursor = coll.find(query, {score: {$meta: "textScore"}})
+                         .sort({score: {$meta: "textScore"}});
+        if (limit) {
+            cursor = cursor.limit(limit);
+        }
+        return cursor.toArray().map(function(doc) {
+            return doc.score;
+        });
+    }
+
+    function assertTopScores(query, limit) {
+        var expected = scores(query).slice(0, limit);
+        assert.eq(expected, scores(query, limit), tojson(query));
+    }
+
+    assertTopScores({$text: {$search: "content"}}, 5);
+    assertTopScores({$text: {$search: "content"}, b: 1}, 5);
+    assertTopScores({$text: {$search: "content -filler"}}, 5);
+    assertTopScores({$text: {$search: "content"}}, 200);
+
+    // Phrases and negated terms are checked before the best scoring documents are chosen.
+    assertTopScores({$text: {$search: "\"content filler filler\""}}, 5);
+    assertTopScores({$text: {$search: "content -\"filler filler filler\""}}, 5);
+    assertTopScores({$text: {$search: "\"content filler\" -\"filler filler\""}, b: 0}, 5);
+    assertTopScores({$text: {$search: "Content", $caseSensitive: true}}, 5);
+
+    // Only the returned documents are fetched.
+    var explain = coll.find({$text: {$search: "content"}}, {score: {$meta: "textScore"}})
+                      .sort({score: {$meta: "textScore"}})
+                      .limit(5)
+                      .explain("executionStats");
+    var textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, tojson(explain));
+    assert.eq(5, textOr.docsExamined, tojson(explain));
+    assert.eq(5, explain.executionStats.nReturned, tojson(explain));
+}());
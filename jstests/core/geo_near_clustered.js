@@ -0,0 +1,43 @@
+// Tests that a geoNear search over a dense cluster of points surrounded by sparse points, whose
+// search intervals are sized from the density of the previous ones, returns every point in order
+// of distance.
+(function() {
+    "use strict";
+
+    var coll = db.geo_near_clustered;
+    coll.drop();
+
+    var docs = [];
+    for (var i = 0; i < 500; i++) {
+        var coordinates = [(i % 25) * 0.0004, Math.floor(i / 25) * 0.0004];
+        docs.push({loc: {type: "Point", coordinates: coordinates}});
+    }
+    for (var i = 0; i < 50; i++) {
+        docs.push({loc: {type: "Point", coordinates: [1 + i, 0.5 * i]}});
+    }
+    assert.writeOK(coll.insert(docs));
+    assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+    var results = coll.aggregate([{
+                          $geoNear: {
+                              near: {type: "Point", coordinates: [0, 0]},
+                              distanceField: "dist",
+                              spherical: true,
+                              limit: 1000
+                          }
+                      }])
+                      .toArray();
+    assert.eq(550, results.length);
+    for (var i = 1; i < results.length; i++) {
+        assert.lte(results[i - 1].dist, results[i].dist, tojson(results[i]));
+    }
+
+    assert.eq(550, coll.find({loc: {$nearSphere: {type: "Point", coordinates: [0, 0]}}}).itcount());
+
+    var explain = coll.find({loc: {$nearSphere: {type: "Point", coordinates: [0, 0]}}})
+                      .limit(1000)
+                      .explain("executionStats");
+    var nearStage = explain.executionStats.executionStages.inputStage;
+    assert.eq(550, explain.executionStats.nReturned, tojson(explain));
+    assert.eq(nearStage.inputStages.length, nearStage.searchIntervals.length, tojson(explain));
+}());
@@ -0,0 +1,39 @@
+// Tests that the keys of a batch of inserted documents, which are inserted into each index in key
+// order rather than document by document, end up in every index.
+// @tags: [assumes_unsharded_collection]
+load("jstests/libs/analyze_plan.js");
+
+(function() {
+    "use strict";
+
+    var coll = db.insert_batch_index_keys;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({device: 1, ts: -1}));
+    assert.commandWorked(coll.createIndex({tags: 1}));
+    assert.commandWorked(coll.createIndex({u: 1}, {unique: true, sparse: true}));
+
+    var docs = [];
+    for (var i = 0; i < 100; i++) {
+        docs.push({_id: i, device: i % 7, ts: 100 - i, tags: [i % 3, i % 5]});
+    }
+    assert.writeOK(coll.insert(docs));
+
+    assert.eq(100, coll.find().hint({device: 1, ts: -1}).itcount());
+    // Documents with i divisible by 3 or 5.
+    assert.eq(47, coll.find({tags: 0}).hint({tags: 1}).itcount());
+    assert(coll.validate().valid);
+
+    // The multikey flag is set by the documents of the batch with more than one key.
+    var explain = coll.find({tags: 1}).hint({tags: 1}).explain();
+    var ixscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+    assert.neq(null, ixscan, tojson(explain));
+    assert.eq(true, ixscan.isMultiKey, tojson(explain));
+
+    // A duplicate key within the batch leaves the documents before it inserted.
+    var res = coll.insert([{_id: 100, u: 1}, {_id: 101, u: 2}, {_id: 102, u: 1}, {_id: 103, u: 3}]);
+    assert.writeError(res);
+    assert.eq(2, coll.find({u: {$exists: true}}).hint({u: 1}).itcount());
+    assert.eq(102, coll.find().itcount());
+    assert(coll.validate().valid);
+}());
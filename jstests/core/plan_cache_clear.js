@@ -53,7 +53,7 @@ assert.eq(0, getShapes().length, 'plan cache should be empty after successful pl
 // As collections change over time, the query optimizer deletes the query plan and re-evaluates
 // after any of the following events:
 // - The reIndex rebuilds the index.
-// - You add or drop an index.
+// - You drop an index, or add one on a field the query refers to.
 // - The mongod process restarts.
 //
 
@@ -78,5 +78,11 @@ assert.eq(1, getShapes().length, 'plan cache should not be empty after query');
 t.ensureIndex({b: 1});
 assert.eq(0, getShapes().length, 'plan cache should be empty after adding index');
 
+// Adding an index on a field the cached query does not refer to leaves its entry in the cache.
+assert.eq(1, t.find({a: 1, b: 1}).itcount(), 'unexpected document count');
+assert.eq(1, getShapes().length, 'plan cache should not be empty after query');
+t.ensureIndex({c: 1});
+assert.eq(1, getShapes().length, 'plan cache should keep entries unaffected by a new index');
+
 // Case 3: The mongod process restarts
 // Not applicable.
@@ -0,0 +1,54 @@
+// Tests that splitVector with a 'sampleSize' picks split points close to those of a full scan of
+// the chunk.
+// Cannot implicitly shard accessed collections because the "splitVector" command cannot be run
+// on a sharded collection
+// @tags: [assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    var coll = db.splitvector_sample;
+    coll.drop();
+    assert.commandWorked(coll.createIndex({x: 1}));
+
+    var numDocs = 20000;
+    var str = new Array(200).join("x");
+    var bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < numDocs; i++) {
+        bulk.insert({x: i, str: str});
+    }
+    assert.writeOK(bulk.execute());
+
+    function splitKeys(cmd) {
+        var res = assert.commandWorked(db.runCommand(Object.extend(
+            {splitVector: coll.getFullName(), keyPattern: {x: 1}, maxChunkSize: 1}, cmd)));
+        return res.splitKeys;
+    }
+
+    function assertCloseToFullScan(range) {
+        var scanned = splitKeys(range);
+        var sampled = splitKeys(Object.extend({sampleSize: 2000}, range));
+        assert.gt(scanned.length, 0);
+        assert.lte(Math.abs(sampled.length - scanned.length),
+                   Math.max(1, scanned.length * 0.3),
+                   tojson({scanned: scanned, sampled: sampled}));
+
+        var min = range.min ? range.min.x : -1;
+        var max = range.max ? range.max.x : numDocs;
+        for (var i = 0; i < sampled.length; i++) {
+            assert.gt(sampled[i].x, min, tojson(sampled));
+            assert.lt(sampled[i].x, max, tojson(sampled));
+            if (i > 0) {
+                assert.gt(sampled[i].x, sampled[i - 1].x, tojson(sampled));
+            }
+        }
+    }
+
+    assertCloseToFullScan({});
+    assertCloseToFullScan({min: {x: 5000}, max: {x: 15000}});
+
+    // A maximum number of split points still applies.
+    assert.lte(splitKeys({sampleSize: 2000, maxSplitPoints: 2}).length, 2);
+
+    // 'force' always scans, and splits at the median.
+    assert.eq([{x: numDocs / 2}], splitKeys({sampleSize: 2000, force: true}));
+}());
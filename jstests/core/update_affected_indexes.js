@@ -0,0 +1,52 @@
+// Tests that an update which changes the keys of only some of a collection's indexes leaves every
+// index consistent with the documents.
+(function() {
+    "use strict";
+
+    var coll = db.update_affected_indexes;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: 1, c: 1}));
+    assert.commandWorked(coll.createIndex({"d.e": 1}));
+    assert.commandWorked(coll.createIndex({f: 1}, {partialFilterExpression: {g: {$gt: 0}}}));
+    assert.commandWorked(coll.createIndex({t: "text"}));
+
+    assert.writeOK(
+        coll.insert({_id: 0, a: 1, b: 1, c: 1, d: {e: 1}, f: 1, g: 0, t: "x", other: 1}));
+
+    function assertFoundWithIndex(query, index) {
+        assert.eq(1, coll.find(query).hint(index).itcount(), tojson({query: query, index: index}));
+    }
+
+    // Touches none of the indexed paths.
+    assert.writeOK(coll.update({_id: 0}, {$inc: {other: 1}}));
+    assertFoundWithIndex({a: 1}, {a: 1});
+    assertFoundWithIndex({b: 1, c: 1}, {b: 1, c: 1});
+
+    // Touches a single field of a compound index.
+    assert.writeOK(coll.update({_id: 0}, {$set: {c: 2}}));
+    assertFoundWithIndex({b: 1, c: 2}, {b: 1, c: 1});
+    assert.eq(0, coll.find({b: 1, c: 1}).hint({b: 1, c: 1}).itcount());
+    assertFoundWithIndex({a: 1}, {a: 1});
+
+    // Touches a parent of an indexed path.
+    assert.writeOK(coll.update({_id: 0}, {$set: {d: {e: 2}}}));
+    assertFoundWithIndex({"d.e": 2}, {"d.e": 1});
+    assert.eq(0, coll.find({"d.e": 1}).hint({"d.e": 1}).itcount());
+
+    // Touches only the field of a partial index's filter.
+    assert.writeOK(coll.update({_id: 0}, {$set: {g: 1}}));
+    assertFoundWithIndex({f: 1, g: {$gt: 0}}, {f: 1});
+
+    // Touches a field of the text index.
+    assert.writeOK(coll.update({_id: 0}, {$set: {t: "y"}}));
+    assert.eq(1, coll.find({$text: {$search: "y"}}).itcount());
+    assert.eq(0, coll.find({$text: {$search: "x"}}).itcount());
+
+    // Renames an indexed field away.
+    assert.writeOK(coll.update({_id: 0}, {$rename: {a: "z"}}));
+    assert.eq(0, coll.find({a: 1}).hint({a: 1}).itcount());
+
+    assert(coll.validate().valid);
+}());
@@ -0,0 +1,53 @@
+// Tests that the statements of an update batch which repeat the same update document, and so share
+// its parsed modifiers, each apply them as if they had been parsed on their own.
+(function() {
+    "use strict";
+
+    var coll = db.update_batch_repeated_modifiers;
+    coll.drop();
+
+    assert.writeOK(coll.insert([
+        {_id: 0, n: 0, a: [1, 2, 3], s: "a"},
+        {_id: 1, n: 0, a: [2, 3, 4], s: "b"},
+        {_id: 2, n: 0, a: [3, 4, 5], s: "A"}
+    ]));
+
+    var bulk = coll.initializeOrderedBulkOp();
+    bulk.find({_id: 0}).updateOne({$inc: {n: 1}});
+    // An upsert inserting with an update document first used for an update, and the reverse.
+    bulk.find({_id: 3}).upsert().updateOne({$inc: {n: 1}, $setOnInsert: {inserted: true}});
+    bulk.find({_id: 1}).updateOne({$inc: {n: 1}});
+    bulk.find({_id: 0}).upsert().updateOne({$inc: {n: 1}, $setOnInsert: {inserted: true}});
+    // The positional operator resolves against each statement's own query.
+    bulk.find({_id: 0, a: 2}).updateOne({$set: {"a.$": 20}});
+    bulk.find({_id: 1, a: 4}).updateOne({$set: {"a.$": 20}});
+    // The same modifiers with and without the multi flag.
+    bulk.find({n: {$gte: 1}}).update({$inc: {m: 1}});
+    bulk.find({_id: 2}).updateOne({$inc: {m: 1}});
+    bulk.find({n: {$gte: 2}}).update({$inc: {m: 1}});
+    // Equal modifiers with a collation, which only write commands support.
+    var hasCollation = db.getMongo().writeMode() === "commands";
+    if (hasCollation) {
+        bulk.find({s: "a"}).collation({locale: "en_US", strength: 2}).update({$push: {a: 0}});
+    }
+    bulk.find({s: "a"}).update({$push: {a: 0}});
+    assert.writeOK(bulk.execute());
+
+    assert.eq({_id: 0, n: 2, a: hasCollation ? [1, 20, 3, 0, 0] : [1, 20, 3, 0], s: "a", m: 2},
+              coll.findOne({_id: 0}));
+    assert.eq({_id: 1, n: 1, a: [2, 3, 20], s: "b", m: 1}, coll.findOne({_id: 1}));
+    assert.eq({_id: 2, n: 0, a: hasCollation ? [3, 4, 5, 0] : [3, 4, 5], s: "A", m: 1},
+              coll.findOne({_id: 2}));
+    assert.eq({_id: 3, n: 1, inserted: true, m: 1}, coll.findOne({_id: 3}));
+
+    // A statement whose update document failed to parse doesn't affect the ones after it.
+    bulk = coll.initializeUnorderedBulkOp();
+    bulk.find({_id: 0}).updateOne({$inc: {n: 1}, $set: {n: 0}});
+    bulk.find({_id: 1}).updateOne({$inc: {n: 1}, $set: {n: 0}});
+    bulk.find({_id: 2}).updateOne({$inc: {n: 1}});
+    var error = assert.throws(function() {
+        bulk.execute();
+    });
+    assert.eq(2, error.getWriteErrorCount(), tojson(error));
+    assert.eq(1, coll.findOne({_id: 2}).n);
+}());
@@ -0,0 +1,25 @@
+/**
+ * Tests that a log file written by a background thread, when logAsyncQueueSizeBytes is set, gets
+ * every message, including those logged while shutting down.
+ */
+(function() {
+    "use strict";
+
+    var logpath = MongoRunner.dataPath + "async_log.log";
+    var conn = MongoRunner.runMongod(
+        {logpath: logpath, slowms: 0, setParameter: {logAsyncQueueSizeBytes: 1024 * 1024}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+
+    assert.writeOK(testDB.async_log.insert({_id: 0}));
+    assert.eq(1, testDB.async_log.find().comment("async_log_marker").itcount());
+
+    var serverStatus = assert.commandWorked(testDB.adminCommand({serverStatus: 1}));
+    assert.eq(0, serverStatus.metrics.log.droppedMessages, tojson(serverStatus.metrics));
+
+    MongoRunner.stopMongod(conn);
+
+    var log = cat(logpath);
+    assert(log.includes("async_log_marker"), "slow query was not logged");
+    assert(log.includes("shutting down with code"), "shutdown was not logged");
+}());
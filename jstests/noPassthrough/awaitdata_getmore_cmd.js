@@ -123,4 +123,26 @@
     }
     assert.gte((new Date()) - now, 2000);
 
+    // An insert which the cursor does not return does not end the wait of its getMore, which
+    // returns the first matching document inserted within the time limit.
+    coll.drop();
+    assert.commandWorked(db.createCollection(collName, {capped: true, size: 2048}));
+    assert.writeOK(coll.insert({_id: 0, match: true}));
+    cmdRes = db.runCommand(
+        {find: collName, filter: {match: true}, batchSize: 1, awaitData: true, tailable: true});
+    assert.commandWorked(cmdRes);
+    assert.eq(cmdRes.cursor.firstBatch.length, 1);
+
+    var awaitShell = startParallelShell(function() {
+        var coll = db.getSiblingDB("test").await_data;
+        assert.writeOK(coll.insert({_id: 1, match: false}));
+        sleep(500);
+        assert.writeOK(coll.insert({_id: 2, match: true}));
+    }, mongo.port);
+
+    cmdRes = db.runCommand({getMore: cmdRes.cursor.id, collection: collName, maxTimeMS: 60000});
+    assert.commandWorked(cmdRes);
+    assert.eq(cmdRes.cursor.nextBatch, [{_id: 2, match: true}]);
+    awaitShell();
+
 })();
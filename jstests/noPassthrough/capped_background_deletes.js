@@ -0,0 +1,56 @@
+/**
+ * Tests that the documents in excess of the cap of a collection capped by size alone, which
+ * inserts leave to a background job on WiredTiger, are deleted and that the size of the collection
+ * stays bounded while they wait.
+ */
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+
+    if (testDB.serverStatus().storageEngine.name !== "wiredTiger") {
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    var maxSize = 1024 * 1024;
+    assert.commandWorked(testDB.createCollection("capped", {capped: true, size: maxSize}));
+    var coll = testDB.capped;
+
+    var payload = new Array(1024).join("x");
+    for (var i = 0; i < 50; i++) {
+        var bulk = coll.initializeUnorderedBulkOp();
+        for (var j = 0; j < 100; j++) {
+            bulk.insert({_id: i * 100 + j, payload: payload});
+        }
+        assert.writeOK(bulk.execute());
+
+        // Inserts delete the excess themselves once it grows past the slack of a tenth of the cap.
+        assert.lte(coll.stats().size, maxSize * 1.2, tojson(coll.stats()));
+    }
+
+    assert.soon(function() {
+        return coll.stats().size <= maxSize;
+    }, function() {
+        return tojson(coll.stats());
+    });
+
+    // The newest documents are kept, in insertion order.
+    var docs = coll.find({}, {_id: 1}).sort({$natural: -1}).toArray();
+    assert.eq(4999, docs[0]._id);
+    for (var k = 1; k < docs.length; k++) {
+        assert.eq(docs[k - 1]._id - 1, docs[k]._id);
+    }
+
+    var latencies = coll.stats().cappedDeleteLatencies;
+    assert.neq(undefined, latencies, tojson(coll.stats()));
+    var background = latencies.background;
+    assert.gt(background.lessThan1ms + background.lessThan10ms + background.lessThan100ms +
+                  background.atLeast100ms,
+              0,
+              tojson(latencies));
+
+    MongoRunner.stopMongod(conn);
+}());
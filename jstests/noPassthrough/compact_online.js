@@ -0,0 +1,46 @@
+/**
+ * Tests that an online compact compacts a collection and its indexes in place, under intent locks,
+ * and reports the space it freed.
+ */
+(function() {
+    "use strict";
+
+    var storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.compact_online;
+
+    assert.commandWorked(coll.createIndex({x: 1}));
+    var padding = new Array(1024).join("x");
+    var bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < 20000; i++) {
+        bulk.insert({_id: i, x: i, padding: padding});
+    }
+    assert.writeOK(bulk.execute());
+    assert.writeOK(coll.remove({_id: {$gte: 1000}}));
+    assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+    assert.commandFailedWithCode(coll.runCommand("compact", {online: true, chunkSeconds: 0}),
+                                 ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        coll.runCommand("compact", {online: true, throttleMillis: -1}), ErrorCodes.BadValue);
+    assert.commandFailedWithCode(testDB.runCommand({compact: "missing", online: true}),
+                                 ErrorCodes.NamespaceNotFound);
+
+    var res = assert.commandWorked(
+        coll.runCommand("compact", {online: true, chunkSeconds: 1, throttleMillis: 10}));
+    assert.gte(res.bytesFreed, 0, tojson(res));
+
+    // The collection and its index are intact.
+    assert.eq(1000, coll.find().itcount());
+    assert.eq(1000, coll.find({x: {$gte: 0}}).hint({x: 1}).itcount());
+    assert(coll.validate().valid);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,47 @@
+/**
+ * Tests that the sampling CPU profiler charges its samples to stacks and to the operations which
+ * were running, and reports them in serverStatus.
+ */
+(function() {
+    "use strict";
+
+    if (_isWindows()) {
+        return;
+    }
+
+    var conn = MongoRunner.runMongod(
+        {setParameter: {cpuProfilingEnabled: true, cpuProfilingSampleIntervalMicros: 1000}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.cpu_profiler;
+
+    var docs = [];
+    for (var i = 0; i < 1000; i++) {
+        docs.push({_id: i, a: i % 10, s: "x".repeat(100)});
+    }
+    assert.writeOK(coll.insert(docs));
+
+    // Keep the server busy until the aggregation has been sampled.
+    assert.soon(function() {
+        coll.aggregate([{$group: {_id: "$a", n: {$sum: 1}, s: {$push: "$s"}}}]).itcount();
+
+        var cpuProfile = testDB.serverStatus().cpuProfile;
+        assert.neq(undefined, cpuProfile);
+        for (var op in cpuProfile.operations) {
+            var operation = cpuProfile.operations[op];
+            if (operation.command === "aggregate" && operation.ns === coll.getFullName()) {
+                return operation.samples > 0;
+            }
+        }
+        return false;
+    });
+
+    var cpuProfile = testDB.serverStatus().cpuProfile;
+    assert.gt(cpuProfile.stats.totalSamples, 0, tojson(cpuProfile.stats));
+    assert.gt(Object.keys(cpuProfile.stacks).length, 0, tojson(cpuProfile.stats));
+    var stack = cpuProfile.stacks[Object.keys(cpuProfile.stacks)[0]];
+    assert.gt(stack.samples, 0, tojson(stack));
+    assert.gt(stack.stack.length, 0, tojson(stack));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,66 @@
+/**
+ * Tests that explain reports the execution time of each plan stage in microseconds, and the
+ * storage engine work done by each stage, and that the profiler and the slow operation log report
+ * the storage engine work of the operation.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn = MongoRunner.runMongod({useLogFiles: true});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.explain_storage_stats;
+
+    const docs = [];
+    for (let i = 0; i < 100; i++) {
+        docs.push({_id: i, a: i, padding: "x".repeat(100)});
+    }
+    assert.writeOK(coll.insert(docs));
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    const explain = coll.find({a: {$gte: 10}}).explain("executionStats");
+    const execStages = explain.executionStats.executionStages;
+    const fetch = getPlanStage(execStages, "FETCH");
+    const ixscan = getPlanStage(execStages, "IXSCAN");
+    assert.neq(null, fetch, tojson(explain));
+    assert.neq(null, ixscan, tojson(explain));
+
+    [fetch, ixscan].forEach(function(stage) {
+        assert(stage.hasOwnProperty("executionTimeMicros"), tojson(stage));
+        assert.lte(
+            stage.executionTimeMillisEstimate * 1000, stage.executionTimeMicros, tojson(stage));
+    });
+    assert.lte(ixscan.executionTimeMicros, fetch.executionTimeMicros, tojson(explain));
+
+    if (testDB.serverStatus().storageEngine.name !== "wiredTiger") {
+        // Only WiredTiger counts the work done through its cursors.
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    // The index scan positions its cursor once, then reads the 90 keys in the range.
+    assert.eq(1, ixscan.storage.cursorSeeks, tojson(ixscan));
+    assert.gte(ixscan.storage.cursorNexts, 89, tojson(ixscan));
+    assert.gt(ixscan.storage.bytesRead, 0, tojson(ixscan));
+
+    // A stage's counters include those of its children, and the fetch looks up each document.
+    assert.gte(fetch.storage.cursorSeeks, ixscan.storage.cursorSeeks + 90, tojson(explain));
+    assert.gte(fetch.storage.bytesRead, ixscan.storage.bytesRead + 90 * 100, tojson(explain));
+
+    // The profiler and the slow operation log report the work of the whole operation.
+    assert.commandWorked(testDB.setProfilingLevel(2, -1));
+    assert.eq(90, coll.find({a: {$gte: 10}}).comment("storage_stats").itcount());
+    const profileEntry = testDB.system.profile.findOne({"query.comment": "storage_stats"});
+    assert.neq(null, profileEntry);
+    assert.gte(profileEntry.storage.cursorSeeks, 91, tojson(profileEntry));
+    assert.gte(profileEntry.storage.bytesRead, 90 * 100, tojson(profileEntry));
+
+    const log = cat(conn.fullOptions.logFile);
+    assert(/comment: "storage_stats".* storage:{ cursorSeeks: \d+/.test(log),
+           "slow operation log line with storage counters missing in " + conn.fullOptions.logFile);
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,54 @@
+/**
+ * Tests that a find with a blocking sort spills to disk when 'allowDiskUse' is set, instead of
+ * failing once it exceeds internalQueryExecMaxBlockingSortBytes.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn =
+        MongoRunner.runMongod({setParameter: "internalQueryExecMaxBlockingSortBytes=10240"});
+    assert.neq(null, conn, "Failed to start mongod");
+    const testDB = conn.getDB("test");
+    const coll = testDB.find_allow_disk_use;
+    coll.drop();
+
+    const kNumDocs = 1000;
+    const padding = "x".repeat(100);
+    for (let i = 0; i < kNumDocs; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: (i * 7) % kNumDocs, padding: padding}));
+    }
+
+    // Without 'allowDiskUse' the sort runs out of memory.
+    assert.commandFailed(testDB.runCommand({find: coll.getName(), sort: {a: 1}}));
+    assert.commandFailed(
+        testDB.runCommand({find: coll.getName(), sort: {a: 1}, allowDiskUse: "yes"}));
+
+    function checkSorted(cmd, expectedCount) {
+        let res = assert.commandWorked(testDB.runCommand(cmd));
+        let docs = res.cursor.firstBatch;
+        while (res.cursor.id != 0) {
+            res = assert.commandWorked(
+                testDB.runCommand({getMore: res.cursor.id, collection: coll.getName()}));
+            docs = docs.concat(res.cursor.nextBatch);
+        }
+        assert.eq(expectedCount, docs.length);
+        for (let i = 0; i < docs.length; ++i) {
+            assert.eq(i, docs[i].a, tojson(docs[i]));
+        }
+    }
+
+    checkSorted({find: coll.getName(), sort: {a: 1}, allowDiskUse: true}, kNumDocs);
+    checkSorted({find: coll.getName(), sort: {a: 1}, limit: 500, allowDiskUse: true}, 500);
+
+    const explain = assert.commandWorked(testDB.runCommand({
+        explain: {find: coll.getName(), sort: {a: 1}, allowDiskUse: true},
+        verbosity: "executionStats"
+    }));
+    const sortStage = getPlanStage(explain.executionStats.executionStages, "SORT");
+    assert.neq(null, sortStage, tojson(explain));
+    assert.eq(true, sortStage.usedDisk, tojson(sortStage));
+
+    MongoRunner.stopMongod(conn);
+}());
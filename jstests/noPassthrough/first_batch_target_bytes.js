@@ -0,0 +1,56 @@
+/**
+ * Tests that a find without a batchSize sizes its first batch by bytes rather than by the default
+ * of 101 documents when internalQueryFirstBatchTargetBytes is set.
+ */
+(function() {
+    "use strict";
+
+    var conn =
+        MongoRunner.runMongod({setParameter: {internalQueryFirstBatchTargetBytes: 64 * 1024}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var small = testDB.first_batch_target_bytes_small;
+    var large = testDB.first_batch_target_bytes_large;
+
+    var bulk = small.initializeUnorderedBulkOp();
+    for (var i = 0; i < 5000; i++) {
+        bulk.insert({_id: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    var str = new Array(16 * 1024).join("x");
+    bulk = large.initializeUnorderedBulkOp();
+    for (var i = 0; i < 200; i++) {
+        bulk.insert({_id: i, str: str});
+    }
+    assert.writeOK(bulk.execute());
+
+    function firstBatchSize(coll, cmd) {
+        var res =
+            assert.commandWorked(testDB.runCommand(Object.extend({find: coll.getName()}, cmd)));
+        return res.cursor.firstBatch.length;
+    }
+
+    // Small documents fill the first batch well past the default batch size.
+    var nSmall = firstBatchSize(small, {});
+    assert.gt(nSmall, 101);
+    assert.lt(nSmall, 5000);
+
+    // Large documents end the first batch once it holds the target number of bytes.
+    assert.eq(4, firstBatchSize(large, {}));
+
+    // The whole result set is still returned across getMores.
+    assert.eq(5000, small.find().itcount());
+    assert.eq(200, large.find().itcount());
+
+    // An explicit batchSize is still respected.
+    assert.eq(10, firstBatchSize(small, {batchSize: 10}));
+    assert.eq(150, firstBatchSize(large, {batchSize: 150}));
+
+    // Without a target the default batch size applies again.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryFirstBatchTargetBytes: 0}));
+    assert.eq(101, firstBatchSize(small, {}));
+
+    MongoRunner.stopMongod(conn);
+}());
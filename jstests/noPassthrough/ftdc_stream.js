@@ -0,0 +1,54 @@
+// Tests the getDiagnosticDataStream command returns the samples collected by full-time diagnostic
+// data capture in order, and that the fast collectors collect the serverStatus sections asked for.
+(function() {
+    'use strict';
+
+    var m = MongoRunner.runMongod({
+        setParameter: {
+            diagnosticDataCollectionPeriodMillis: 100,
+            diagnosticDataCollectionFastSections: "opcounters,connections,noSuchSection",
+            diagnosticDataCollectionFastPeriodMillis: 10,
+        }
+    });
+    assert.neq(null, m, "mongod failed to start");
+    var admin = m.getDB("admin");
+
+    function getStream(afterId, fast) {
+        var res = admin.runCommand({getDiagnosticDataStream: 1, afterId: afterId, fast: fast});
+        assert.commandWorked(res);
+        return res;
+    }
+
+    // Periodic samples hold the whole serverStatus.
+    var res;
+    assert.soon(function() {
+        res = getStream(-1, false);
+        return res.samples.length >= 2;
+    });
+    assert(res.samples[0].data.serverStatus.hasOwnProperty("mem"), tojson(res.samples[0]));
+    for (var i = 1; i < res.samples.length; ++i) {
+        assert.eq(res.samples[i - 1].id + 1, res.samples[i].id, tojson(res));
+    }
+    assert.eq(res.samples[res.samples.length - 1].id, res.lastId);
+
+    // Asking again only returns the newer samples.
+    var next = getStream(res.lastId, false);
+    next.samples.forEach(function(sample) {
+        assert.gt(sample.id, res.lastId, tojson(next));
+    });
+
+    // Fast samples hold only the known sections asked for.
+    assert.soon(function() {
+        res = getStream(-1, true);
+        return res.samples.length >= 10;
+    });
+    var fastStatus = res.samples[0].data.serverStatus;
+    assert(fastStatus.hasOwnProperty("opcounters"), tojson(fastStatus));
+    assert(fastStatus.hasOwnProperty("connections"), tojson(fastStatus));
+    assert(!fastStatus.hasOwnProperty("mem"), tojson(fastStatus));
+    assert(!fastStatus.hasOwnProperty("noSuchSection"), tojson(fastStatus));
+
+    assert.commandFailed(admin.runCommand({getDiagnosticDataStream: 1, afterId: "a"}));
+
+    MongoRunner.stopMongod(m);
+})();
@@ -0,0 +1,43 @@
+/**
+ * Tests that serverStatus reports latency percentiles per command, and that the operation latency
+ * histograms of serverStatus and $collStats report percentiles too.
+ */
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.latency_percentiles;
+
+    for (var i = 0; i < 20; i++) {
+        assert.writeOK(coll.insert({_id: i}));
+        assert.eq(1, coll.find({_id: i}).itcount());
+    }
+
+    function assertPercentiles(percentiles, context) {
+        assert.neq(undefined, percentiles, context);
+        assert.lte(percentiles.p50, percentiles.p90, context);
+        assert.lte(percentiles.p90, percentiles.p99, context);
+        assert.lte(percentiles.p99, percentiles.p999, context);
+        assert.lte(percentiles.p999, percentiles.max, context);
+    }
+
+    var commandLatencies = testDB.serverStatus().commandLatencies;
+    assert.neq(undefined, commandLatencies.find, tojson(commandLatencies));
+    assert.gte(commandLatencies.find.ops, 20, tojson(commandLatencies));
+    assertPercentiles(commandLatencies.find, tojson(commandLatencies));
+    assert.gte(commandLatencies.insert.ops, 20, tojson(commandLatencies));
+    assertPercentiles(commandLatencies.insert, tojson(commandLatencies));
+
+    var opLatencies = testDB.serverStatus().opLatencies;
+    assertPercentiles(opLatencies.reads.percentiles, tojson(opLatencies));
+    assertPercentiles(opLatencies.writes.percentiles, tojson(opLatencies));
+
+    var latencyStats = coll.aggregate([{$collStats: {latencyStats: {}}}]).next().latencyStats;
+    assert.eq(20, latencyStats.writes.ops, tojson(latencyStats));
+    assertPercentiles(latencyStats.reads.percentiles, tojson(latencyStats));
+    assertPercentiles(latencyStats.writes.percentiles, tojson(latencyStats));
+
+    MongoRunner.stopMongod(conn);
+}());
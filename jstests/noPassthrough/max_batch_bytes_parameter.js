@@ -0,0 +1,40 @@
+/**
+ * Tests that find and getMore batches respect the internalQueryMaxBatchBytes parameter.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: "internalQueryMaxBatchBytes=100000"});
+    assert.neq(null, conn, "Failed to start mongod");
+    const testDB = conn.getDB("test");
+    const coll = testDB.max_batch_bytes_parameter;
+    coll.drop();
+
+    // Each document is a little over 30KB, so a batch holds three of them.
+    const bigString = "x".repeat(30 * 1024);
+    const kNumDocs = 10;
+    for (let i = 0; i < kNumDocs; ++i) {
+        assert.writeOK(coll.insert({_id: i, s: bigString}));
+    }
+
+    let res = assert.commandWorked(testDB.runCommand({find: coll.getName(), batchSize: 100}));
+    assert.eq(3, res.cursor.firstBatch.length, tojson(res.cursor.firstBatch.length));
+    let numReturned = res.cursor.firstBatch.length;
+
+    while (res.cursor.id != 0) {
+        res = assert.commandWorked(
+            testDB.runCommand({getMore: res.cursor.id, collection: coll.getName()}));
+        assert.lte(res.cursor.nextBatch.length, 3, tojson(res.cursor.nextBatch.length));
+        assert.gt(res.cursor.nextBatch.length, 0, tojson(res.cursor.nextBatch.length));
+        numReturned += res.cursor.nextBatch.length;
+    }
+    assert.eq(kNumDocs, numReturned);
+
+    // A single document larger than the budget is still returned.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryMaxBatchBytes: 1024}));
+    res = assert.commandWorked(testDB.runCommand({find: coll.getName(), batchSize: 100}));
+    assert.eq(1, res.cursor.firstBatch.length, tojson(res.cursor.firstBatch.length));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,97 @@
+// Tests that mapReduce jobs whose map and reduce functions are run without JavaScript produce the
+// same results as when they are run by the JavaScript engine.
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.mr_native_functions;
+
+    var keys = [
+        "a",
+        "b",
+        NumberInt(1),
+        1,
+        2.5,
+        NumberLong(1),
+        NumberLong("9007199254740993"),
+        NumberDecimal("1.0"),
+        true,
+        null,
+        ObjectId("000000000000000000000001"),
+        ISODate("2017-01-01"),
+        {x: 1},
+        [1, 2],
+        /re/
+    ];
+    var values = [1, 0.1, NumberInt(2), NumberLong(3), NumberDecimal("0.2"), "s", null, {y: 1}];
+
+    var docs = [];
+    for (var i = 0; i < 300; i++) {
+        var doc = {_id: i, k: keys[i % keys.length], v: values[i % values.length]};
+        if (i % 7 === 0) {
+            delete doc.k;
+        }
+        if (i % 11 === 0) {
+            delete doc.v;
+        }
+        docs.push(doc);
+    }
+    // Documents with only doubles to sum, for each of a few keys.
+    for (var i = 300; i < 600; i++) {
+        docs.push({_id: i, k: "sum" + (i % 3), v: i / 10});
+    }
+    assert.writeOK(coll.insert(docs));
+
+    function runMapReduce(map, reduce, options) {
+        var res = assert.commandWorked(testDB.runCommand(
+            Object.extend({mapReduce: coll.getName(), map: map, reduce: reduce}, options)));
+        var results = res.results || testDB[res.result].find().toArray();
+        return results.sort(function(a, b) {
+            return bsonWoCompare({_id: a._id}, {_id: b._id});
+        });
+    }
+
+    function setUseNativeFunctions(enabled) {
+        assert.commandWorked(
+            testDB.adminCommand({setParameter: 1, mapReduceUseNativeFunctions: enabled}));
+    }
+
+    function assertSameResults(map, reduce, options) {
+        setUseNativeFunctions(true);
+        var nativeResults = runMapReduce(map, reduce, options);
+        setUseNativeFunctions(false);
+        var jsResults = runMapReduce(map, reduce, options);
+
+        assert.eq(tojson(jsResults), tojson(nativeResults));
+        assert.eq(0, bsonWoCompare({r: jsResults}, {r: nativeResults}), tojson(nativeResults));
+    }
+
+    var sum = function(key, values) {
+        return Array.sum(values);
+    };
+
+    assertSameResults(function() {
+        emit(this.k, this.v);
+    }, sum, {out: {inline: 1}});
+    assertSameResults(function() {
+        emit(this.k, 1);
+    }, sum, {out: {inline: 1}});
+    assertSameResults(function() {
+        emit(this.v, this.k);
+    }, sum, {out: {inline: 1}});
+    assertSameResults(function() {
+        emit(this.k, this.v);
+    }, sum, {out: "mr_native_functions_out", query: {k: /^sum/}});
+    assertSameResults(function() {
+        emit(this.k, 1);
+    }, sum, {
+        out: {inline: 1},
+        finalize: function(key, value) {
+            return value * 2;
+        }
+    });
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,70 @@
+/**
+ * Tests that the $queryShapeStats aggregation stage reports the execution statistics accumulated
+ * for each query shape run against a collection, and that the number of shapes kept is bounded.
+ */
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({setParameter: {internalQueryShapeStatsMaxEntries: 3}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.query_shape_stats;
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    var bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < 100; i++) {
+        bulk.insert({_id: i, a: i % 10, b: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    function shapeStats() {
+        return coll.aggregate([{$queryShapeStats: {}}, {$sort: {count: -1}}]).toArray();
+    }
+
+    // Queries which differ only in their values share a shape.
+    for (var i = 0; i < 10; i++) {
+        assert.eq(10, coll.find({a: i}).itcount());
+    }
+    assert.eq(4, coll.find({b: {$gt: 95}}).sort({b: -1}).itcount());
+
+    var stats = shapeStats();
+    assert.eq(2, stats.length, tojson(stats));
+    assert.eq(10, stats[0].count, tojson(stats));
+    assert.eq(100, stats[0].nreturned, tojson(stats));
+    assert.gte(stats[0].keysExamined, 100, tojson(stats));
+    assert.eq(100, stats[0].docsExamined, tojson(stats));
+    assert.eq(coll.getFullName(), stats[0].ns, tojson(stats));
+    assert.lte(stats[0].p99TimeMicros, stats[0].maxTimeMicros, tojson(stats));
+    assert.lte(stats[0].maxTimeMicros, stats[0].totalTimeMicros, tojson(stats));
+    assert.gt(stats[0].responseBytes, 0, tojson(stats));
+    assert.eq(1, stats[1].count, tojson(stats));
+    assert.eq(100, stats[1].docsExamined, tojson(stats));
+    assert.eq(1, stats[1].inMemorySorts, tojson(stats));
+
+    // Updates and deletes are attributed to the shape of their query too.
+    assert.writeOK(coll.update({b: {$lt: 5}}, {$inc: {c: 1}}, {multi: true}));
+    stats = shapeStats();
+    assert.eq(3, stats.length, tojson(stats));
+
+    // Beyond the maximum number of shapes the least recently run one is forgotten.
+    assert.eq(0, coll.find({c: 1}).itcount());
+    stats = shapeStats();
+    assert.eq(3, stats.length, tojson(stats));
+    assert.eq(0,
+              stats.filter(function(shape) {
+                  return shape.count === 10;
+              }).length,
+              tojson(stats));
+
+    // Shapes are forgotten when their collection is dropped.
+    coll.drop();
+    assert.eq(0, shapeStats().length);
+
+    // The stage requires an empty specification.
+    assert.commandFailedWithCode(
+        testDB.runCommand(
+            {aggregate: coll.getName(), pipeline: [{$queryShapeStats: {a: 1}}], cursor: {}}),
+        40411);
+
+    MongoRunner.stopMongod(conn);
+}());
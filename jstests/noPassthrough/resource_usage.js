@@ -0,0 +1,53 @@
+/**
+ * Tests that the resourceUsage command reports the resources used by operations per database and
+ * per authenticated user.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({auth: ""});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const admin = conn.getDB("admin");
+    assert.commandWorked(admin.runCommand({createUser: "admin", pwd: "pwd", roles: ["root"]}));
+    assert(admin.auth("admin", "pwd"));
+
+    const tenantDB = conn.getDB("tenant");
+    assert.commandWorked(
+        tenantDB.runCommand({createUser: "tenant", pwd: "pwd", roles: ["readWrite"]}));
+    admin.logout();
+
+    assert(tenantDB.auth("tenant", "pwd"));
+    const docs = [];
+    for (let i = 0; i < 100; i++) {
+        docs.push({_id: i, padding: "x".repeat(100)});
+    }
+    assert.writeOK(tenantDB.coll.insert(docs));
+    assert.eq(100, tenantDB.coll.find().itcount());
+    tenantDB.logout();
+
+    assert(admin.auth("admin", "pwd"));
+    const usage = assert.commandWorked(admin.runCommand({resourceUsage: 1}));
+
+    const dbUsage = usage.databases.find(entry => entry.db === "tenant");
+    assert.neq(undefined, dbUsage, tojson(usage));
+    assert.gte(dbUsage.ops, 2, tojson(dbUsage));
+    assert.gte(dbUsage.docsExamined, 100, tojson(dbUsage));
+    assert.gt(dbUsage.networkBytesIn, 100 * 100, tojson(dbUsage));
+    assert.gt(dbUsage.networkBytesOut, 100 * 100, tojson(dbUsage));
+    assert.gte(dbUsage.cpuMicros, 0, tojson(dbUsage));
+    assert.gt(dbUsage.executionMicros, 0, tojson(dbUsage));
+
+    const userUsage = usage.users.find(entry => entry.user === "tenant@tenant");
+    assert.neq(undefined, userUsage, tojson(usage));
+    assert.gte(userUsage.ops, 2, tojson(userUsage));
+    assert.gte(userUsage.docsExamined, 100, tojson(userUsage));
+
+    // Operations run while no user is authenticated, like the authentications, only count against
+    // their database.
+    assert.neq(undefined, usage.users.find(entry => entry.user === "admin@admin"), tojson(usage));
+    assert.eq(2, usage.users.length, tojson(usage));
+
+    admin.logout();
+    MongoRunner.stopMongod(conn);
+})();
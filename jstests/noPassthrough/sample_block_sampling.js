@@ -0,0 +1,53 @@
+/**
+ * Tests that a $sample too large for a random cursor uses a block sample of the collection when
+ * internalDocumentSourceSampleBlockSize is set, and still returns distinct documents.
+ */
+(function() {
+    "use strict";
+
+    var storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    var conn = MongoRunner.runMongod({setParameter: {internalDocumentSourceSampleBlockSize: 16}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.sample_block_sampling;
+
+    var nDocs = 10000;
+    var bulk = coll.initializeUnorderedBulkOp();
+    for (var i = 0; i < nDocs; i++) {
+        bulk.insert({_id: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    function usesRandomCursor(sampleSize) {
+        var explain = coll.explain().aggregate([{$sample: {size: sampleSize}}]);
+        return explain.stages.some(function(stage) {
+            return stage.hasOwnProperty("$sampleFromRandomCursor");
+        });
+    }
+
+    // Larger than a random cursor serves alone, but within what a block sample serves.
+    var sampleSize = 2000;
+    assert(usesRandomCursor(sampleSize));
+    var ids = {};
+    var results = coll.aggregate([{$sample: {size: sampleSize}}]).toArray();
+    assert.eq(sampleSize, results.length);
+    results.forEach(function(doc) {
+        assert(!ids[doc._id], "$sample returned the same document twice: " + doc._id);
+        ids[doc._id] = true;
+    });
+
+    // Most of the collection is still sampled with a random sort.
+    assert(!usesRandomCursor(nDocs * 0.9));
+
+    // Without block sampling the larger sample falls back to a random sort as well.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalDocumentSourceSampleBlockSize: 0}));
+    assert(!usesRandomCursor(sampleSize));
+
+    MongoRunner.stopMongod(conn);
+}());
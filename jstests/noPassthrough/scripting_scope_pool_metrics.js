@@ -0,0 +1,43 @@
+// Tests that the reuse of pooled JavaScript scopes, and of the functions compiled in them, is
+// reported in serverStatus, and that scopes are not kept with a pool size of zero.
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.scripting_scope_pool_metrics;
+    assert.writeOK(coll.insert([{a: 1}, {a: 2}, {a: 3}]));
+
+    function scriptingMetrics() {
+        return testDB.serverStatus().metrics.scripting;
+    }
+
+    function runWhere() {
+        assert.eq(2, coll.find({$where: "this.a > 1"}).itcount());
+    }
+
+    runWhere();
+    var before = scriptingMetrics();
+    runWhere();
+    var after = scriptingMetrics();
+
+    // The second query reuses the scope of the first, along with the function compiled in it.
+    assert.eq(before.scopePool.hits + 1, after.scopePool.hits, tojson(after));
+    assert.eq(before.scopePool.misses, after.scopePool.misses, tojson(after));
+    assert.gt(after.functionCache.hits, before.functionCache.hits, tojson(after));
+    assert.gt(after.functionCache.misses, 0, tojson(after));
+
+    // Without a pool, each query needs a new scope. The scope already pooled is discarded once it
+    // is released.
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, scriptingEngineScopePoolSize: 0}));
+    runWhere();
+    before = scriptingMetrics();
+    runWhere();
+    runWhere();
+    after = scriptingMetrics();
+    assert.eq(before.scopePool.hits, after.scopePool.hits, tojson(after));
+    assert.eq(before.scopePool.misses + 2, after.scopePool.misses, tojson(after));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,54 @@
+/**
+ * Tests that a compound index whose leading field is unconstrained by the query can be used by
+ * skipping through the distinct values of that field, when internalQueryPlannerEnableSkipScan is
+ * set.
+ */
+load("jstests/libs/analyze_plan.js");
+
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: "internalQueryPlannerEnableSkipScan=true"});
+    assert.neq(null, conn, "Failed to start mongod");
+    const testDB = conn.getDB("test");
+    const coll = testDB.skip_scan;
+    coll.drop();
+
+    // A handful of distinct leading values, each with many documents.
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        bulk.insert({region: i % 4, ts: i, tag: i % 10});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({region: 1, ts: -1}));
+
+    function winningPlan(query) {
+        return coll.find(query).explain().queryPlanner.winningPlan;
+    }
+
+    // The index can only be used by skipping over its unconstrained leading field.
+    const rangeQuery = {ts: {$gte: 990}};
+    assert.eq(10, coll.find(rangeQuery).itcount());
+    let plan = winningPlan(rangeQuery);
+    assert(isIxscan(plan), tojson(plan));
+    assert.eq(coll.find(rangeQuery).hint({$natural: 1}).sort({ts: 1}).toArray(),
+              coll.find(rangeQuery).sort({ts: 1}).toArray());
+
+    // Other predicates are applied after the fetch.
+    assert.eq(1, coll.find({ts: {$gte: 990}, tag: 5}).itcount());
+
+    // A multikey leading field must not produce duplicates.
+    assert.writeOK(coll.insert({region: [1, 2, 3], ts: 5000}));
+    assert.eq(1, coll.find({ts: 5000}).itcount());
+    assert.eq(11, coll.find(rangeQuery).itcount());
+
+    // With the parameter off the query falls back to a collection scan.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryPlannerEnableSkipScan: false}));
+    coll.getPlanCache().clear();
+    plan = winningPlan(rangeQuery);
+    assert(isCollscan(plan), tojson(plan));
+    assert.eq(11, coll.find(rangeQuery).itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
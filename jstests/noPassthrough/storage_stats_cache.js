@@ -0,0 +1,50 @@
+/**
+ * Tests that the storage sizes reported by dbStats and listDatabases are served from a cache while
+ * it is younger than storageStatsCacheMillis, while the counts reported by dbStats stay current.
+ */
+(function() {
+    "use strict";
+
+    var storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    var conn = MongoRunner.runMongod({setParameter: {storageStatsCacheMillis: 60 * 60 * 1000}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+
+    assert.writeOK(testDB.a.insert({_id: 0}));
+
+    function sizeOnDisk() {
+        var res = assert.commandWorked(testDB.adminCommand({listDatabases: 1}));
+        return res.databases.filter(function(db) {
+            return db.name === "test";
+        })[0].sizeOnDisk;
+    }
+
+    var stats = assert.commandWorked(testDB.runCommand({dbStats: 1}));
+    var size = sizeOnDisk();
+
+    // A new collection and index add files, but the cached sizes are still reported.
+    assert.writeOK(testDB.b.insert({_id: 0, x: 1}));
+    assert.commandWorked(testDB.b.createIndex({x: 1}));
+
+    var cachedStats = assert.commandWorked(testDB.runCommand({dbStats: 1}));
+    assert.eq(stats.collections + 1, cachedStats.collections, tojson(cachedStats));
+    assert.eq(stats.objects + 1, cachedStats.objects, tojson(cachedStats));
+    assert.eq(stats.indexes + 2, cachedStats.indexes, tojson(cachedStats));
+    assert.eq(stats.storageSize, cachedStats.storageSize, tojson(cachedStats));
+    assert.eq(stats.indexSize, cachedStats.indexSize, tojson(cachedStats));
+    assert.eq(size, sizeOnDisk());
+
+    // Without the cache the sizes are recomputed.
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, storageStatsCacheMillis: 0}));
+    var freshStats = assert.commandWorked(testDB.runCommand({dbStats: 1}));
+    assert.gt(freshStats.storageSize, stats.storageSize, tojson(freshStats));
+    assert.gt(freshStats.indexSize, stats.indexSize, tojson(freshStats));
+    assert.gt(sizeOnDisk(), size);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,61 @@
+// Tests that startRecordingTraffic records the messages received from clients, and that
+// mongotrafficreplay replays them against another mongod.
+(function() {
+    'use strict';
+
+    var recordingDir = MongoRunner.dataPath + "traffic_recording/";
+    assert(mkdir(recordingDir));
+
+    var m = MongoRunner.runMongod({setParameter: {trafficRecordingDirectory: recordingDir}});
+    assert.neq(null, m, "mongod failed to start");
+    var admin = m.getDB("admin");
+
+    // The recording has to be a file of the recording directory.
+    assert.commandFailedWithCode(
+        admin.runCommand({startRecordingTraffic: 1, filename: "../outside.bin"}),
+        ErrorCodes.BadValue);
+    assert.commandFailedWithCode(admin.runCommand({stopRecordingTraffic: 1}),
+                                 ErrorCodes.IllegalOperation);
+
+    assert.commandWorked(admin.runCommand({startRecordingTraffic: 1, filename: "recording.bin"}));
+    assert.commandFailedWithCode(
+        admin.runCommand({startRecordingTraffic: 1, filename: "other.bin"}),
+        ErrorCodes.IllegalOperation);
+
+    var coll = m.getDB("test").traffic_recording;
+    for (var i = 0; i < 10; i++) {
+        assert.writeOK(coll.insert({_id: i}));
+    }
+    assert.eq(10, coll.find().itcount());
+
+    var status = assert.commandWorked(admin.runCommand({serverStatus: 1, trafficRecording: 1}));
+    assert.eq(true, status.trafficRecording.running, tojson(status.trafficRecording));
+
+    var res = assert.commandWorked(admin.runCommand({stopRecordingTraffic: 1}));
+    assert.eq(false, res.running, tojson(res));
+    assert.gte(res.messagesRecorded, 12, tojson(res));
+    assert.eq(0, res.messagesDropped, tojson(res));
+    assert.gt(res.bytesWritten, 0, tojson(res));
+
+    // A recording file is never overwritten.
+    assert.commandFailedWithCode(
+        admin.runCommand({startRecordingTraffic: 1, filename: "recording.bin"}),
+        ErrorCodes.FileAlreadyOpen);
+
+    // Replaying the recording against another mongod inserts the same documents.
+    var target = MongoRunner.runMongod({});
+    assert.neq(null, target, "mongod failed to start");
+
+    var exitCode = runMongoProgram("mongotrafficreplay",
+                                   "--recording",
+                                   recordingDir + "recording.bin",
+                                   "--dest",
+                                   target.host,
+                                   "--speed",
+                                   "0");
+    assert.eq(0, exitCode);
+    assert.eq(10, target.getDB("test").traffic_recording.find().itcount());
+
+    MongoRunner.stopMongod(target);
+    MongoRunner.stopMongod(m);
+}());
@@ -0,0 +1,59 @@
+/**
+ * Tests that the TTL monitor deletes every expired document, and only those, when it processes
+ * several collections at once and deletes in batches smaller than the number of expired documents.
+ */
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({
+        setParameter: {
+            ttlMonitorSleepSecs: 1,
+            ttlMonitorWorkerThreads: 3,
+            ttlMonitorDeleteBatchSize: 7,
+            ttlMonitorEnabled: false
+        }
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+
+    var now = new Date();
+    var past = new Date(now.getTime() - 3600 * 1000);
+    var future = new Date(now.getTime() + 3600 * 1000);
+
+    var numCollections = 5;
+    for (var i = 0; i < numCollections; i++) {
+        var coll = testDB["ttl" + i];
+        assert.commandWorked(
+            coll.createIndex({date: i % 2 === 0 ? 1 : -1}, {expireAfterSeconds: 60}));
+
+        var bulk = coll.initializeUnorderedBulkOp();
+        for (var j = 0; j < 50; j++) {
+            bulk.insert({expired: true, date: past});
+            // A document expires once any of its dates has.
+            bulk.insert({expired: true, date: [future, past]});
+            bulk.insert({expired: false, date: future});
+            bulk.insert({expired: false, date: "not a date"});
+        }
+        assert.writeOK(bulk.execute());
+    }
+
+    var deletedBefore = testDB.serverStatus().metrics.ttl.deletedDocuments;
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+    assert.soon(function() {
+        for (var i = 0; i < numCollections; i++) {
+            if (testDB["ttl" + i].count({expired: true}) !== 0) {
+                return false;
+            }
+        }
+        return true;
+    }, "the TTL monitor didn't delete the expired documents");
+
+    for (var i = 0; i < numCollections; i++) {
+        assert.eq(100, testDB["ttl" + i].count({expired: false}));
+    }
+    assert.eq(numCollections * 100,
+              testDB.serverStatus().metrics.ttl.deletedDocuments - deletedBefore);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,44 @@
+// Tests that an unordered insert split across several threads reports its write errors and
+// inserted count as if it had been executed by one.
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({setParameter: "internalInsertMaxParallelism=4"});
+    assert.neq(null, conn, "mongod failed to start");
+    var coll = conn.getDB("test").unordered_insert_parallelism;
+
+    // Documents which collide with these are spread over every slice of the insert.
+    var dupIndexes = [5, 260, 499, 500, 777, 999];
+    assert.writeOK(coll.insert(dupIndexes.map(function(i) {
+        return {_id: i};
+    })));
+
+    var docs = [];
+    for (var i = 0; i < 1000; i++) {
+        docs.push({_id: i, x: i});
+    }
+
+    var res = coll.insert(docs, {ordered: false});
+    assert.writeError(res);
+    assert.eq(994, res.nInserted, tojson(res));
+    var errors = res.getWriteErrors();
+    assert.eq(dupIndexes, errors.map(function(err) {
+        return err.index;
+    }), tojson(errors));
+    errors.forEach(function(err) {
+        assert.eq(ErrorCodes.DuplicateKey, err.code, tojson(err));
+    });
+    assert.eq(1000, coll.find().itcount());
+    assert.eq(994, coll.find({x: {$exists: true}}).itcount());
+
+    // An ordered insert still stops at its first error.
+    coll.drop();
+    assert.writeOK(coll.insert({_id: 300}));
+    res = coll.insert(docs, {ordered: true});
+    assert.writeError(res);
+    assert.eq(300, res.nInserted, tojson(res));
+    assert.eq(300, res.getWriteErrors()[0].index, tojson(res));
+    assert.eq(301, coll.find().itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that the time operations spend blocked outside of locks is reported per operation in the
+ * profiler and in total in serverStatus.
+ */
+(function() {
+    "use strict";
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+    var coll = testDB.wait_events;
+
+    for (var i = 0; i < 10; i++) {
+        assert.writeOK(coll.insert({_id: i}));
+    }
+
+    var before = testDB.serverStatus().waitEvents;
+    assert.eq(0, before.fetch.count, tojson(before));
+
+    // Make the query yield after every document, and sleep each time it yields.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+    assert.commandWorked(testDB.adminCommand({
+        configureFailPoint: "setYieldAllLocksWait",
+        mode: "alwaysOn",
+        data: {namespace: coll.getFullName(), waitForMillis: 5}
+    }));
+    assert.commandWorked(testDB.setProfilingLevel(2));
+
+    assert.eq(10, coll.find().comment("wait_events").itcount());
+
+    assert.commandWorked(testDB.setProfilingLevel(0));
+    assert.commandWorked(
+        testDB.adminCommand({configureFailPoint: "setYieldAllLocksWait", mode: "off"}));
+
+    var profileEntry = testDB.system.profile.findOne({"query.comment": "wait_events"});
+    assert.neq(null, profileEntry);
+    assert.gte(profileEntry.waits.yield.count, profileEntry.numYield, tojson(profileEntry));
+    assert.gte(profileEntry.waits.yield.micros, 5 * 1000, tojson(profileEntry));
+
+    // A journaled write waits for the journal.
+    assert.writeOK(coll.insert({_id: 10}, {writeConcern: {j: true}}));
+
+    var after = testDB.serverStatus().waitEvents;
+    assert.gte(after.yield.count, before.yield.count + profileEntry.numYield, tojson(after));
+    assert.gte(after.journal.count, before.journal.count + 1, tojson(after));
+
+    MongoRunner.stopMongod(conn);
+}());
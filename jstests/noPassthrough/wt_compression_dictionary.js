@@ -0,0 +1,72 @@
+/**
+ * Tests that a compression dictionary built from the documents of one collection can be used as
+ * the block compressor of another, and that its data can still be read after a restart.
+ */
+(function() {
+    "use strict";
+
+    var storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    var conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    var testDB = conn.getDB("test");
+
+    function makeEvent(i) {
+        return {
+            _id: i,
+            type: "page_view",
+            user: {id: i % 97, country: "NZ", agent: "Mozilla/5.0 (X11; Linux x86_64)"},
+            url: "https://example.com/products/" + (i % 13),
+            ts: new Date(1500000000000 + i)
+        };
+    }
+
+    var bulk = testDB.events_sample.initializeUnorderedBulkOp();
+    for (var i = 0; i < 500; i++) {
+        bulk.insert(makeEvent(i));
+    }
+    assert.writeOK(bulk.execute());
+
+    assert.commandFailedWithCode(
+        testDB.runCommand({createCompressionDictionary: "missing", name: "events"}),
+        ErrorCodes.NamespaceNotFound);
+    assert.commandFailedWithCode(
+        testDB.runCommand({createCompressionDictionary: "events_sample", name: "bad-name"}),
+        ErrorCodes.BadValue);
+
+    var res = assert.commandWorked(
+        testDB.runCommand({createCompressionDictionary: "events_sample", name: "events"}));
+    assert.gt(res.dictionarySize, 0, tojson(res));
+    assert.gt(res.sampledDocuments, 0, tojson(res));
+    var compressor = res.compressor;
+
+    // A dictionary cannot be replaced.
+    assert.commandFailed(
+        testDB.runCommand({createCompressionDictionary: "events_sample", name: "events"}));
+
+    assert.commandWorked(testDB.createCollection(
+        "events",
+        {storageEngine: {wiredTiger: {configString: "block_compressor=" + compressor}}}));
+    bulk = testDB.events.initializeUnorderedBulkOp();
+    for (i = 0; i < 5000; i++) {
+        bulk.insert(makeEvent(i));
+    }
+    assert.writeOK(bulk.execute());
+    assert.eq(makeEvent(1234), testDB.events.findOne({_id: 1234}));
+
+    MongoRunner.stopMongod(conn);
+
+    // The dictionary is registered again when the data files are reopened.
+    conn = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+    assert.neq(null, conn, "mongod was unable to restart");
+    testDB = conn.getDB("test");
+    assert.eq(5000, testDB.events.find().itcount());
+    assert.eq(makeEvent(4321), testDB.events.findOne({_id: 4321}));
+    assert(testDB.events.validate(true).valid);
+
+    MongoRunner.stopMongod(conn);
+}());
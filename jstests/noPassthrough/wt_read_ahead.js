@@ -0,0 +1,36 @@
+/**
+ * Tests that collection scans return every document, in order, with WiredTiger read-ahead enabled.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: "wiredTigerReadAheadRecords=16"});
+    assert.neq(null, conn, "Failed to start mongod");
+    const testDB = conn.getDB("test");
+    const coll = testDB.wt_read_ahead;
+    coll.drop();
+
+    const kNumDocs = 1000;
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < kNumDocs; ++i) {
+        bulk.insert({_id: i, s: "x".repeat(100)});
+    }
+    assert.writeOK(bulk.execute());
+
+    // Small batches make the scan yield and restore between getMores while reads are in flight.
+    let docs = coll.find().batchSize(10).toArray();
+    assert.eq(kNumDocs, docs.length);
+
+    docs = coll.find().sort({$natural: -1}).batchSize(10).toArray();
+    assert.eq(kNumDocs, docs.length);
+    for (let i = 0; i < kNumDocs; ++i) {
+        assert.eq(kNumDocs - 1 - i, docs[i]._id, tojson(docs[i]));
+    }
+
+    // Read-ahead can be turned off at runtime.
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, wiredTigerReadAheadRecords: 0}));
+    assert.eq(kNumDocs, coll.find().itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
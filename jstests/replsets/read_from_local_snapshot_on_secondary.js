@@ -0,0 +1,52 @@
+/**
+ * Tests that, with readFromLocalSnapshotOnSecondaries enabled, reads with local read concern on a
+ * secondary are served from the snapshot taken after the last applied batch and see the data of
+ * collections created after that snapshot.
+ */
+
+load("jstests/replsets/rslib.js");  // For startSetIfSupportsReadMajority.
+
+(function() {
+    "use strict";
+
+    var name = "read_from_local_snapshot_on_secondary";
+    var replTest = new ReplSetTest({
+        name: name,
+        nodes: [{}, {rsConfig: {priority: 0}}],
+        nodeOptions: {
+            enableMajorityReadConcern: '',
+            setParameter: "readFromLocalSnapshotOnSecondaries=true"
+        }
+    });
+
+    if (!startSetIfSupportsReadMajority(replTest)) {
+        jsTest.log("skipping test since storage engine doesn't support committed reads");
+        return;
+    }
+    replTest.initiate();
+
+    var primary = replTest.getPrimary();
+    var secondary = replTest.getSecondary();
+    secondary.setSlaveOk();
+    var collPrimary = primary.getDB(name).coll;
+    var collSecondary = secondary.getDB(name).coll;
+
+    var bulk = collPrimary.initializeUnorderedBulkOp();
+    for (var i = 0; i < 100; i++) {
+        bulk.insert({_id: i});
+    }
+    assert.writeOK(bulk.execute({w: 2}));
+
+    // The snapshot is taken shortly after the batch is applied.
+    assert.soon(function() {
+        return collSecondary.find().readConcern("local").itcount() == 100;
+    });
+
+    // A collection created after the last snapshot is read without the snapshot.
+    var otherPrimary = primary.getDB(name).other;
+    var otherSecondary = secondary.getDB(name).other;
+    assert.writeOK(otherPrimary.insert({_id: 0}, {writeConcern: {w: 2}}));
+    assert.eq(1, otherSecondary.find().readConcern("local").itcount());
+
+    replTest.stopSet();
+}());
@@ -0,0 +1,44 @@
+/**
+ * Tests that with autoSplitOnShard the shard counts the bytes written to its chunks through every
+ * mongos and splits the chunks itself, while the mongoses started with autoSplitOnShards leave the
+ * splitting to it.
+ */
+(function() {
+    'use strict';
+
+    var s = new ShardingTest({
+        name: "autosplit_on_shard",
+        shards: 1,
+        mongos: 2,
+        other: {
+            enableAutoSplit: true,
+            chunkSize: 1,
+            shardOptions: {setParameter: {autoSplitOnShard: true}},
+            mongosOptions: {setParameter: {autoSplitOnShards: true}}
+        }
+    });
+
+    assert.commandWorked(s.s0.adminCommand({enablesharding: "test"}));
+    assert.commandWorked(s.s0.adminCommand({shardcollection: "test.foo", key: {num: 1}}));
+
+    var bigString = "";
+    while (bigString.length < 1024 * 50) {
+        bigString += "asocsancdnsjfnsdnfsjdhfasdfasdfasdfnsadofnsadlkfnsaldknfsad";
+    }
+
+    var colls = [s.s0.getDB("test").foo, s.s1.getDB("test").foo];
+    var initialChunks = s.config.chunks.count({ns: "test.foo"});
+
+    // Spread the writes over both mongoses, so that neither of them alone sees enough of them.
+    for (var i = 0; i < 200; i++) {
+        assert.writeOK(colls[i % 2].insert({num: i, s: bigString}));
+    }
+
+    assert.soon(function() {
+        return s.config.chunks.count({ns: "test.foo"}) > initialChunks;
+    }, "the shard did not split the chunk it owns", 60 * 1000);
+
+    assert.eq(200, colls[0].find().itcount());
+
+    s.stop();
+})();
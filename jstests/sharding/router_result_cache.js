@@ -0,0 +1,48 @@
+/**
+ * Tests that mongos answers repeated queries against a namespace listed in
+ * routerResultCacheNamespaces from its result cache, and that writes routed through the mongos
+ * invalidate the cached results.
+ */
+(function() {
+    'use strict';
+
+    var st = new ShardingTest({
+        shards: 1,
+        mongos: 1,
+        other: {
+            mongosOptions: {
+                setParameter: {
+                    routerResultCacheNamespaces: "test.ref",
+                    internalQueryRouterResultCacheTTLMillis: 10 * 60 * 1000
+                }
+            }
+        }
+    });
+
+    var mongosDB = st.s.getDB("test");
+    var shardDB = st.shard0.getDB("test");
+
+    assert.writeOK(mongosDB.ref.insert([{_id: 0}, {_id: 1}]));
+    assert.writeOK(mongosDB.other.insert([{_id: 0}, {_id: 1}]));
+    assert.eq(2, mongosDB.ref.find().itcount());
+    assert.eq(2, mongosDB.other.find().itcount());
+
+    // A write made directly against the shard goes unseen by the cached query, but not by a
+    // different query or by a query against a namespace which isn't cached.
+    assert.writeOK(shardDB.ref.insert({_id: 2}));
+    assert.writeOK(shardDB.other.insert({_id: 2}));
+    assert.eq(2, mongosDB.ref.find().itcount());
+    assert.eq(3, mongosDB.ref.find({_id: {$gte: 0}}).itcount());
+    assert.eq(3, mongosDB.other.find().itcount());
+
+    // A write routed through mongos drops the cached results.
+    assert.writeOK(mongosDB.ref.insert({_id: 3}));
+    assert.eq(4, mongosDB.ref.find().itcount());
+
+    // Caching can be turned off at runtime.
+    assert.commandWorked(st.s.adminCommand({setParameter: 1, routerResultCacheNamespaces: []}));
+    assert.writeOK(shardDB.ref.insert({_id: 4}));
+    assert.eq(5, mongosDB.ref.find().itcount());
+
+    st.stop();
+})();
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+namespace {
+
+bool fieldNameLess(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.fieldNameStringData() < rhs.fieldNameStringData();
+}
+
+bool fieldNameLessThanName(const BSONElement& elt, StringData name) {
+    return elt.fieldNameStringData() < name;
+}
+
+}  // namespace
+
+const int BSONFieldIndex::kLinearLookups;
+
+BSONElement BSONFieldIndex::getField(StringData name) const {
+    if (!_built) {
+        if (_lookups < kLinearLookups) {
+            ++_lookups;
+            return _obj.getField(name);
+        }
+        _build();
+    }
+
+    auto it = std::lower_bound(_sorted.begin(), _sorted.end(), name, fieldNameLessThanName);
+    if (it == _sorted.end() || it->fieldNameStringData() != name) {
+        return BSONElement();
+    }
+    return *it;
+}
+
+void BSONFieldIndex::_build() const {
+    for (auto&& elt : _obj) {
+        _sorted.push_back(elt);
+    }
+
+    // A stable sort keeps the first of several elements with the same name first.
+    std::stable_sort(_sorted.begin(), _sorted.end(), fieldNameLess);
+    _built = true;
+}
+
+}  // namespace mongo
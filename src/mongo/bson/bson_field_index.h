@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Looks up the top-level fields of a BSONObj by name, for callers which look up many fields of
+ * the same wide document. BSONObj::getField() scans the elements in order, so looking up k fields
+ * of an n field document costs O(k * n) name comparisons.
+ *
+ * The first kLinearLookups lookups scan the object like BSONObj::getField(). Later lookups build,
+ * once, a table of the elements sorted by field name and binary search it. Callers which only look
+ * up a field or two therefore never pay for building the table.
+ *
+ * getField() returns the first element with the name, the same as BSONObj::getField(), also when
+ * the object has duplicate field names.
+ *
+ * Holds a reference to the object, which must not be modified while the index is in use. Not
+ * thread safe, as lookups update the index's state.
+ */
+class BSONFieldIndex {
+    MONGO_DISALLOW_COPYING(BSONFieldIndex);
+
+public:
+    static const int kLinearLookups = 4;
+
+    explicit BSONFieldIndex(const BSONObj& obj) : _obj(obj) {}
+
+    const BSONObj& obj() const {
+        return _obj;
+    }
+
+    /**
+     * Returns true if this indexes the object at the same address as 'obj'.
+     */
+    bool isIndexOf(const BSONObj& obj) const {
+        return obj.objdata() == _obj.objdata();
+    }
+
+    /**
+     * Returns the first top-level element named 'name', or EOO if there is none.
+     */
+    BSONElement getField(StringData name) const;
+
+    /**
+     * Returns true once lookups use the sorted table rather than scanning the object.
+     */
+    bool isBuilt() const {
+        return _built;
+    }
+
+private:
+    void _build() const;
+
+    const BSONObj _obj;
+
+    mutable int _lookups = 0;
+    mutable bool _built = false;
+
+    // The elements of '_obj' sorted by field name, with elements of the same name in document
+    // order. Filled in by _build().
+    mutable std::vector<BSONElement> _sorted;
+};
+
+}  // namespace mongo
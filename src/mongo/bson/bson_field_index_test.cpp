@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Looks up each of 'names' in 'obj' through a BSONFieldIndex, twice over so that the lookups are
+ * made both before and after the index is built, and checks they find what BSONObj::getField()
+ * finds.
+ */
+void assertSameAsGetField(const BSONObj& obj, const std::vector<std::string>& names) {
+    BSONFieldIndex index(obj);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (auto&& name : names) {
+            BSONElement expected = obj.getField(name);
+            BSONElement actual = index.getField(name);
+            ASSERT_EQUALS(expected.rawdata(), actual.rawdata()) << name;
+            ASSERT_EQUALS(expected.eoo(), actual.eoo()) << name;
+        }
+    }
+}
+
+TEST(BSONFieldIndexTest, ScansObjectForFirstLookups) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2);
+    BSONFieldIndex index(obj);
+    for (int i = 0; i < BSONFieldIndex::kLinearLookups; ++i) {
+        ASSERT_EQUALS(2, index.getField("b").numberInt());
+        ASSERT_FALSE(index.isBuilt());
+    }
+    ASSERT_EQUALS(1, index.getField("a").numberInt());
+    ASSERT_TRUE(index.isBuilt());
+}
+
+TEST(BSONFieldIndexTest, FindsEveryFieldOfWideDocument) {
+    BSONObjBuilder builder;
+    std::vector<std::string> names;
+    for (int i = 299; i >= 0; --i) {
+        std::string name = str::stream() << "field" << i;
+        builder.append(name, i);
+        names.push_back(name);
+    }
+    BSONObj obj = builder.obj();
+
+    names.push_back("missing");
+    names.push_back("field");
+    names.push_back("field3000");
+    names.push_back("");
+    assertSameAsGetField(obj, names);
+}
+
+TEST(BSONFieldIndexTest, ReturnsFirstOfDuplicateFields) {
+    BSONObj obj = BSON("b" << 1 << "a" << 2 << "b" << 3 << "a" << 4 << "c" << 5);
+    assertSameAsGetField(obj, {"a", "b", "c", "d"});
+
+    BSONFieldIndex index(obj);
+    for (int i = 0; i <= BSONFieldIndex::kLinearLookups; ++i) {
+        ASSERT_EQUALS(1, index.getField("b").numberInt());
+        ASSERT_EQUALS(2, index.getField("a").numberInt());
+    }
+    ASSERT_TRUE(index.isBuilt());
+}
+
+TEST(BSONFieldIndexTest, EmptyAndPrefixFieldNames) {
+    BSONObj obj = BSON(""
+                       << 1
+                       << "ab"
+                       << 2
+                       << "a"
+                       << 3
+                       << "abc"
+                       << 4);
+    assertSameAsGetField(obj, {"", "a", "ab", "abc", "abcd", "b"});
+}
+
+TEST(BSONFieldIndexTest, EmptyObject) {
+    assertSameAsGetField(BSONObj(), {"", "a"});
+}
+
+TEST(BSONFieldIndexTest, IsIndexOfSameObjectOnly) {
+    BSONObj obj = BSON("a" << 1);
+    BSONFieldIndex index(obj);
+    ASSERT_TRUE(index.isIndexOf(obj));
+    ASSERT_FALSE(index.isIndexOf(obj.copy()));
+}
+
+}  // namespace
+}  // namespace mongo
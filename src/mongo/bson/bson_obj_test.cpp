@@ -487,6 +487,87 @@ TEST(BSONObjCompare, StringOrder3) {
     ASSERT_TRUE(n.woCompare(ll, k) == n.woCompare(d, k));
 }
 
+// Compares strings in reverse byte order, to check that string comparators are used for values of
+// the same type.
+class ReverseStringComparator : public StringData::ComparatorInterface {
+public:
+    int compare(StringData left, StringData right) const final {
+        return right.compare(left);
+    }
+
+    void hash_combine(size_t& seed, StringData stringToHash) const final {
+        MONGO_UNREACHABLE;
+    }
+};
+
+TEST(BSONObjCompare, SameTypeValues) {
+    ASSERT_LT(BSON("x" << -5).woCompare(BSON("x" << 3)), 0);
+    ASSERT_GT(BSON("x" << std::numeric_limits<int>::max())
+                  .woCompare(BSON("x" << std::numeric_limits<int>::min())),
+              0);
+    ASSERT_LT(BSON("x" << std::numeric_limits<long long>::min())
+                  .woCompare(BSON("x" << std::numeric_limits<long long>::max())),
+              0);
+    ASSERT_LT(BSON("x" << std::numeric_limits<double>::quiet_NaN()).woCompare(BSON("x" << -1.0)),
+              0);
+    ASSERT_EQ(BSON("x" << std::numeric_limits<double>::quiet_NaN())
+                  .woCompare(BSON("x" << std::numeric_limits<double>::quiet_NaN())),
+              0);
+    ASSERT_EQ(BSON("x" << 0.0).woCompare(BSON("x" << -0.0)), 0);
+
+    OID low("000000000000000000000001");
+    OID high("100000000000000000000000");
+    ASSERT_LT(BSON("x" << low).woCompare(BSON("x" << high)), 0);
+    ASSERT_GT(BSON("x" << high).woCompare(BSON("x" << low)), 0);
+
+    ASSERT_LT(BSON("x"
+                   << "ab")
+                  .woCompare(BSON("x"
+                                  << "abc")),
+              0);
+    BSONObjBuilder withNul;
+    withNul.append("x", StringData("a\0b", 3));
+    ASSERT_GT(withNul.obj().woCompare(BSON("x"
+                                           << "a")),
+              0);
+
+    ReverseStringComparator reverse;
+    ASSERT_GT(BSON("x"
+                   << "a")
+                  .woCompare(BSON("x"
+                                  << "b"),
+                             BSONObj(),
+                             true,
+                             &reverse),
+              0);
+}
+
+TEST(BSONObjCompare, SameTypeValuesConsiderFieldNames) {
+    ASSERT_LT(BSON("a" << 2).woCompare(BSON("b" << 1)), 0);
+    ASSERT_GT(BSON("a" << 2).woCompare(BSON("b" << 1), BSONObj(), false), 0);
+    ASSERT_LT(BSON("a" << 3LL).woCompare(BSON("a" << 4LL)), 0);
+    ASSERT_GT(BSON("b" << 3LL).woCompare(BSON("a" << 4LL)), 0);
+}
+
+TEST(BSONObjCompare, BinaryEqualObjects) {
+    BSONObj obj = BSON("a" << 1 << "b" << BSON("c"
+                                                << "x")
+                           << "d"
+                           << std::numeric_limits<double>::quiet_NaN());
+    BSONObj copy = obj.copy();
+    ASSERT_EQ(obj.woCompare(copy), 0);
+    ASSERT_EQ(obj.woCompare(copy, BSON("a" << -1 << "b" << -1 << "d" << -1)), 0);
+    ASSERT_EQ(obj.woCompare(copy, Ordering::make(BSON("a" << -1))), 0);
+
+    // Same size, differing in the last byte of a value.
+    BSONObj other = BSON("a" << 1 << "b" << BSON("c"
+                                                  << "y")
+                             << "d"
+                             << std::numeric_limits<double>::quiet_NaN());
+    ASSERT_LT(obj.woCompare(other), 0);
+    ASSERT_GT(obj.woCompare(other, BSON("a" << 1 << "b" << -1)), 0);
+}
+
 TEST(BSONObjCompare, NumericBounds) {
     BSONObj l, r;
     {
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+void benchmarkValidate(BenchmarkState& state, const BSONObj& obj) {
+    state.setBytesPerIteration(obj.objsize());
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    }
+}
+
+/**
+ * Returns a document of about 'targetSize' bytes, built of copies of 'element' under increasing
+ * field names.
+ */
+BSONObj makeDocument(int targetSize, const BSONObj& element) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int i = 0; builder.len() < targetSize; ++i) {
+        builder.appendAs(element.firstElement(), str::stream() << "field" << i);
+    }
+    return builder.obj();
+}
+
+// A document like one of a time series, with many short fields of fixed size types.
+BENCHMARK(ValidateBSON, ManyNumbers4MB) {
+    benchmarkValidate(state, makeDocument(4 * 1024 * 1024, BSON("" << 1.5)));
+}
+
+BENCHMARK(ValidateBSON, ManyShortStrings4MB) {
+    benchmarkValidate(state,
+                      makeDocument(4 * 1024 * 1024,
+                                   BSON(""
+                                        << "short string")));
+}
+
+BENCHMARK(ValidateBSON, LongStrings4MB) {
+    benchmarkValidate(state, makeDocument(4 * 1024 * 1024, BSON("" << std::string(4096, 'x'))));
+}
+
+BENCHMARK(ValidateBSON, ManySubdocuments4MB) {
+    const BSONObj subdocument =
+        BSON("" << BSON("name"
+                        << "sensor"
+                        << "value"
+                        << 12
+                        << "ts"
+                        << Date_t::fromMillisSinceEpoch(1)
+                        << "tags"
+                        << BSON_ARRAY("a"
+                                      << "b")));
+    benchmarkValidate(state, makeDocument(4 * 1024 * 1024, subdocument));
+}
+
+BENCHMARK(ValidateBSON, LongFieldNames4MB) {
+    BSONObjBuilder builder;
+    for (int i = 0; builder.len() < 4 * 1024 * 1024; ++i) {
+        builder.append(str::stream() << std::string(40, 'n') << i, i);
+    }
+    benchmarkValidate(state, builder.obj());
+}
+
+BENCHMARK(ValidateBSON, SmallDocument) {
+    benchmarkValidate(state,
+                      BSON("_id" << OID::gen() << "name"
+                                 << "joe"
+                                 << "age"
+                                 << 33
+                                 << "address"
+                                 << BSON("street"
+                                         << "Main Street"
+                                         << "number"
+                                         << 12)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -29,6 +29,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cstring>
+#include <memory>
+
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/db/jsobj.h"
@@ -353,4 +356,50 @@ TEST(BSONValidateBool, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateFast, FieldNamesOfEveryLength) {
+    // Covers names ending within, at the end of and after each block scanned inline for the NUL.
+    for (int len = 0; len < 48; ++len) {
+        const std::string name(len, 'a');
+        const BSONObj obj = BSON(name << 1 << "b" + name << "x");
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+        // Copy the document up to, but excluding, the NUL ending the first field name into a
+        // buffer of exactly that size, so that reading past its end can be detected.
+        const int truncatedSize = 5 + len;
+        std::unique_ptr<char[]> truncated(new char[truncatedSize]);
+        std::memcpy(truncated.get(), obj.objdata(), truncatedSize);
+        const Status status = validateBSON(truncated.get(), truncatedSize, BSONVersion::kLatest);
+        ASSERT_EQUALS(ErrorCodes::InvalidBSON, status);
+        ASSERT_STRING_CONTAINS(status.reason(), "no end of c-string");
+    }
+}
+
+TEST(BSONValidateFast, EveryFixedSizeTypeIsValidated) {
+    BSONObjBuilder bob;
+    bob.appendMinKey("minKey");
+    bob.appendMaxKey("maxKey");
+    bob.appendNull("null");
+    bob.appendUndefined("undefined");
+    bob.append("oid", OID::gen());
+    bob.append("int", 1);
+    bob.append("double", 1.5);
+    bob.append("long", 1LL);
+    bob.append("timestamp", Timestamp(1, 1));
+    bob.appendDate("date", Date_t::fromMillisSinceEpoch(1));
+    const BSONObj obj = bob.obj();
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+    // The value of each element is cut off in turn.
+    for (BSONObjIterator it(obj); it.more();) {
+        const BSONElement elem = it.next();
+        if (elem.valuesize() == 0) {
+            continue;
+        }
+        const int truncatedSize = elem.value() - obj.objdata() + elem.valuesize() - 1;
+        std::unique_ptr<char[]> truncated(new char[truncatedSize]);
+        std::memcpy(truncated.get(), obj.objdata(), truncatedSize);
+        ASSERT_NOT_OK(validateBSON(truncated.get(), truncatedSize, BSONVersion::kLatest));
+    }
+}
+
 }  // namespace
@@ -349,6 +349,37 @@ int compareElementStringValues(const BSONElement& leftStr, const BSONElement& ri
     return lsz - rsz;
 }
 
+/**
+ * Most comparisons in sorts, index key lookups and ordered containers are between values of the
+ * same type. For the types compared most often, 'l' and 'r' of that type are compared here without
+ * looking up their canonical types. Returns false if the type is not one of those.
+ */
+inline bool compareCommonTypeValues(const BSONElement& l,
+                                    const BSONElement& r,
+                                    const StringData::ComparatorInterface* comparator,
+                                    int* result) {
+    switch (l.type()) {
+        case NumberInt:
+            *result = compareInts(l._numberInt(), r._numberInt());
+            return true;
+        case NumberLong:
+            *result = compareLongs(l._numberLong(), r._numberLong());
+            return true;
+        case NumberDouble:
+            *result = compareDoubles(l._numberDouble(), r._numberDouble());
+            return true;
+        case jstOID:
+            *result = memcmp(l.value(), r.value(), OID::kOIDSize);
+            return true;
+        case String:
+            *result = comparator ? comparator->compare(l.valueStringData(), r.valueStringData())
+                                 : compareElementStringValues(l, r);
+            return true;
+        default:
+            return false;
+    }
+}
+
 }  // namespace
 
 int BSONElement::getGtLtOp(int def) const {
@@ -397,6 +428,16 @@ std::vector<BSONElement> BSONElement::Array() const {
 int BSONElement::woCompare(const BSONElement& e,
                            bool considerFieldName,
                            const StringData::ComparatorInterface* comparator) const {
+    int valueResult;
+    if (type() == e.type() && compareCommonTypeValues(*this, e, comparator, &valueResult)) {
+        if (considerFieldName) {
+            int x = strcmp(fieldName(), e.fieldName());
+            if (x != 0)
+                return x;
+        }
+        return valueResult;
+    }
+
     int lt = (int)canonicalType();
     int rt = (int)e.canonicalType();
     int x = lt - rt;
@@ -109,6 +109,10 @@ int BSONObj::woCompare(const BSONObj& r,
         return r.isEmpty() ? 0 : -1;
     if (r.isEmpty())
         return 1;
+    // Objects with the same bytes compare equal under any ordering and string comparator, and
+    // memcmp() finds that faster than comparing the elements.
+    if (binaryEqual(r))
+        return 0;
 
     BSONObjIterator i(*this);
     BSONObjIterator j(r);
@@ -145,6 +149,8 @@ int BSONObj::woCompare(const BSONObj& r,
         return r.isEmpty() ? 0 : -1;
     if (r.isEmpty())
         return 1;
+    if (binaryEqual(r))
+        return 0;
 
     bool ordered = !idxKey.isEmpty();
 
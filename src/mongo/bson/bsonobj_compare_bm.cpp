@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+void benchmarkCompare(BenchmarkState& state, const BSONObj& lhs, const BSONObj& rhs) {
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(lhs.woCompare(rhs));
+    }
+}
+
+BENCHMARK(BSONObjCompare, Ints) {
+    benchmarkCompare(state, BSON("" << 1), BSON("" << 2));
+}
+
+BENCHMARK(BSONObjCompare, Longs) {
+    benchmarkCompare(state, BSON("" << (1LL << 40)), BSON("" << (1LL << 41)));
+}
+
+BENCHMARK(BSONObjCompare, Strings) {
+    benchmarkCompare(state,
+                     BSON(""
+                          << "customer-000123"),
+                     BSON(""
+                          << "customer-000124"));
+}
+
+BENCHMARK(BSONObjCompare, ObjectIds) {
+    const OID low("5a0000000000000000000001");
+    const OID high("5a0000000000000000000002");
+    benchmarkCompare(state, BSON("" << low), BSON("" << high));
+}
+
+BENCHMARK(BSONObjCompare, CompoundKeyEqualPrefix) {
+    benchmarkCompare(state,
+                     BSON("" << 7 << ""
+                             << "region"
+                             << ""
+                             << 1),
+                     BSON("" << 7 << ""
+                             << "region"
+                             << ""
+                             << 2));
+}
+
+BENCHMARK(BSONObjCompare, EqualDocuments) {
+    BSONObj obj = BSON("_id" << OID("5a0000000000000000000001") << "name"
+                             << "sensor"
+                             << "location"
+                             << BSON("x" << 1.5 << "y" << 2.5)
+                             << "tags"
+                             << BSON_ARRAY("a"
+                                           << "b"
+                                           << "c"));
+    benchmarkCompare(state, obj, obj.copy());
+}
+
+}  // namespace
+}  // namespace mongo
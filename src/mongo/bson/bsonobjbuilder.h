@@ -232,25 +232,20 @@ public:
 
     /** Append a boolean element */
     BSONObjBuilder& appendBool(StringData fieldName, int val) {
-        _b.appendNum((char)Bool);
-        _b.appendStr(fieldName);
-        _b.appendNum((char)(val ? 1 : 0));
+        *_appendElementHeader(Bool, fieldName, 1) = val ? 1 : 0;
         return *this;
     }
 
     /** Append a boolean element */
     BSONObjBuilder& append(StringData fieldName, bool val) {
-        _b.appendNum((char)Bool);
-        _b.appendStr(fieldName);
-        _b.appendNum((char)(val ? 1 : 0));
+        *_appendElementHeader(Bool, fieldName, 1) = val ? 1 : 0;
         return *this;
     }
 
     /** Append a 32 bit integer element */
     BSONObjBuilder& append(StringData fieldName, int n) {
-        _b.appendNum((char)NumberInt);
-        _b.appendStr(fieldName);
-        _b.appendNum(n);
+        DataView(_appendElementHeader(NumberInt, fieldName, sizeof(n)))
+            .write(tagLittleEndian(n));
         return *this;
     }
 
@@ -270,9 +265,8 @@ public:
 
     /** Append a NumberLong */
     BSONObjBuilder& append(StringData fieldName, long long n) {
-        _b.appendNum((char)NumberLong);
-        _b.appendStr(fieldName);
-        _b.appendNum(n);
+        DataView(_appendElementHeader(NumberLong, fieldName, sizeof(n)))
+            .write(tagLittleEndian(n));
         return *this;
     }
 
@@ -346,9 +340,8 @@ public:
 
     /** Append a double element */
     BSONObjBuilder& append(StringData fieldName, double n) {
-        _b.appendNum((char)NumberDouble);
-        _b.appendStr(fieldName);
-        _b.appendNum(n);
+        DataView(_appendElementHeader(NumberDouble, fieldName, sizeof(n)))
+            .write(tagLittleEndian(n));
         return *this;
     }
 
@@ -454,10 +447,10 @@ public:
     }
     /** Append a string element */
     BSONObjBuilder& append(StringData fieldName, StringData str) {
-        _b.appendNum((char)String);
-        _b.appendStr(fieldName);
-        _b.appendNum((int)str.size() + 1);
-        _b.appendStr(str, true);
+        const int sizeWithNUL = str.size() + 1;
+        char* const value = _appendElementHeader(String, fieldName, sizeof(int) + sizeWithNUL);
+        DataView(value).write(tagLittleEndian(sizeWithNUL));
+        str.copyTo(value + sizeof(int), true);
         return *this;
     }
 
@@ -744,6 +737,17 @@ public:
     }
 
 private:
+    /**
+     * Grows the buffer once for a whole element of type 't' with a value of 'valueSize' bytes,
+     * writes the type byte and the field name, and returns where the value is to be written.
+     */
+    char* _appendElementHeader(BSONType t, StringData fieldName, int valueSize) {
+        char* const start = _b.skip(1 + fieldName.size() + 1 + valueSize);
+        *start = static_cast<char>(t);
+        fieldName.copyTo(start + 1, true);
+        return start + 1 + fieldName.size() + 1;
+    }
+
     char* _done() {
         if (_doneCalled)
             return _b.buf() + _offset;
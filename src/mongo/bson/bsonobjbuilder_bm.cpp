@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+BENCHMARK(BSONObjBuilder, SmallDocument) {
+    while (state.keepRunning()) {
+        BSONObjBuilder builder;
+        builder.append("_id", 1);
+        builder.append("name", "joe");
+        builder.append("score", 4.5);
+        benchmarkDoNotOptimize(builder.obj());
+    }
+}
+
+BENCHMARK(BSONObjBuilder, NestedDocument) {
+    while (state.keepRunning()) {
+        BSONObjBuilder builder;
+        builder.append("_id", 1);
+        {
+            BSONObjBuilder sub(builder.subobjStart("address"));
+            sub.append("street", "Main Street");
+            sub.append("number", 12);
+        }
+        {
+            BSONArrayBuilder arr(builder.subarrayStart("tags"));
+            arr.append("a");
+            arr.append("b");
+            arr.append("c");
+        }
+        benchmarkDoNotOptimize(builder.obj());
+    }
+}
+
+BENCHMARK(BSONObjBuilder, HundredFields) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 100; ++i) {
+        names.push_back(str::stream() << "field" << i);
+    }
+
+    while (state.keepRunning()) {
+        BSONObjBuilder builder;
+        for (int i = 0; i < 100; ++i) {
+            builder.append(names[i], i);
+        }
+        benchmarkDoNotOptimize(builder.obj());
+    }
+}
+
+}  // namespace
+}  // namespace mongo
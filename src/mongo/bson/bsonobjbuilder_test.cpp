@@ -361,5 +361,40 @@ TEST(BSONObjBuilderTest, ReturningANonOwningBSONObjBuilderWorks) {
     ASSERT_BSONOBJ_EQ(outer.obj(), BSON("nested" << BSON("a" << 1 << "b" << 2)));
 }
 
+TEST(BSONObjBuilderTest, FixedSizeAndStringAppendsMatchParsedJson) {
+    BSONObjBuilder bob;
+    bob.append("int", -7);
+    bob.append("long", 1LL << 40);
+    bob.append("double", 4.5);
+    bob.append("true", true);
+    bob.appendBool("false", 0);
+    bob.append("string", "abc"_sd);
+    bob.append("empty", ""_sd);
+    bob.append("", 1);
+    BSONObj obj = bob.obj();
+
+    BSONObj expected = fromjson(
+        "{int: -7, long: NumberLong(1099511627776), double: 4.5, true: true, false: false, "
+        "string: 'abc', empty: '', '': 1}");
+    ASSERT(obj.binaryEqual(expected));
+}
+
+TEST(BSONObjBuilderTest, FixedSizeAndStringAppendsGrowTheBuffer) {
+    const std::string longName(1000, 'n');
+    const std::string longString(5000, 's');
+    BSONObjBuilder bob(16);
+    bob.append(longName, 1);
+    bob.append(longName, longString);
+    bob.append(longName, 2.5);
+    BSONObj obj = bob.obj();
+
+    BSONObjIterator it(obj);
+    ASSERT_EQ(1, it.next().Int());
+    ASSERT_EQ(longString, it.next().String());
+    ASSERT_EQ(2.5, it.next().Double());
+    ASSERT_FALSE(it.more());
+    ASSERT_EQ(4 + 3 * (1 + 1001) + 4 + 8 + 4 + 5001 + 1, obj.objsize());
+}
+
 }  // unnamed namespace
 }  // namespace mongo
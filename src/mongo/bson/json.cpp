@@ -31,8 +31,14 @@
 
 #include <cstdint>
 
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_JSON_SSE2
+#endif
+
 #include "mongo/base/parse_number.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/platform/strtoll.h"
 #include "mongo/util/base64.h"
@@ -66,7 +72,6 @@ enum {
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
     FIELD_RESERVE_SIZE = 4096,
-    STRINGVAL_RESERVE_SIZE = 4096,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
     NS_RESERVE_SIZE = 64,
@@ -80,6 +85,43 @@ static const char *LBRACE = "{", *RBRACE = "}", *LBRACKET = "[", *RBRACKET = "]"
                   *RPAREN = ")", *COLON = ":", *COMMA = ",", *FORWARDSLASH = "/",
                   *SINGLEQUOTE = "'", *DOUBLEQUOTE = "\"";
 
+namespace {
+
+/**
+ * Returns the first character in [p, end) which is 'quote', a backslash or a control character,
+ * or 'end' if there is none. These are the only characters of a quoted string which JParse::chars()
+ * has to look at one at a time. On x86-64 the input is scanned 16 bytes at a time.
+ */
+const char* findSpecialStringChar(const char* p, const char* end, char quote) {
+#ifdef MONGO_JSON_SSE2
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i maxControl = _mm_set1_epi8(0x1F);
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // A byte is a control character if its unsigned maximum with 0x1F is 0x1F.
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, maxControl), maxControl));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return p + countTrailingZeros64(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != quote && *p != '\\' && static_cast<unsigned char>(*p) > 0x1F) {
+        ++p;
+    }
+    return p;
+}
+
+inline bool isDecimalDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+}  // namespace
+
 JParse::JParse(StringData str)
     : _buf(str.rawData()), _input(_buf), _input_end(_input + str.size()) {}
 
@@ -95,6 +137,26 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
+    // Strings and numbers are the most common values, and none of the tokens tried below starts
+    // like them, so they are recognized from their first character.
+    skipWhitespace();
+    if (_input < _input_end) {
+        const char c = *_input;
+        if (c == '"' || c == '\'') {
+            std::string valueString;
+            Status ret = quotedString(&valueString);
+            if (ret != Status::OK()) {
+                return ret;
+            }
+            builder.append(fieldName, valueString);
+            return Status::OK();
+        }
+        const bool negative = c == '-' && _input + 1 < _input_end;
+        if (isDecimalDigit(c) || (negative && isDecimalDigit(_input[1]))) {
+            return number(fieldName, builder);
+        }
+    }
+
     if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
@@ -152,7 +214,6 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
         }
     } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
         std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
         Status ret = quotedString(&valueString);
         if (ret != Status::OK()) {
             return ret;
@@ -202,7 +263,6 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
 
     // Special object
     std::string firstField;
-    firstField.reserve(FIELD_RESERVE_SIZE);
     Status ret = field(&firstField);
     if (ret != Status::OK()) {
         return ret;
@@ -316,7 +376,6 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         }
         while (readToken(COMMA)) {
             std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
             Status fieldRet = field(&fieldName);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
@@ -999,6 +1058,32 @@ Status JParse::regexOptCheck(StringData opt) {
 }
 
 Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
+    // Most numbers are decimal integers short enough not to overflow, which are converted here
+    // without calling both strtod() and strtoll() below.
+    const char* p = _input;
+    const bool negative = p < _input_end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    const char* const digits = p;
+    long long magnitude = 0;
+    while (p < _input_end && p - digits < 18 && isDecimalDigit(*p)) {
+        magnitude = magnitude * 10 + (*p - '0');
+        ++p;
+    }
+    // Anything that could continue the number, such as a fraction, exponent, hex prefix or 19th
+    // digit, is left to the general conversion.
+    if (p > digits && p < _input_end && !isDecimalDigit(*p) && !strchr(".eExX", *p)) {
+        const long long retll = negative ? -magnitude : magnitude;
+        if (retll == static_cast<int>(retll)) {
+            builder.append(fieldName, static_cast<int>(retll));
+        } else {
+            builder.append(fieldName, retll);
+        }
+        _input = p;
+        return Status::OK();
+    }
+
     char* endptrll;
     char* endptrd;
     long long retll;
@@ -1100,7 +1185,20 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
         return parseError("Unexpected end of input");
     }
     const char* q = _input;
-    while (q < _input_end && !match(*q, terminalSet)) {
+    // A quoted string is copied in runs of the characters which need no escaping or checks.
+    const bool quoted = allowedSet == NULL && terminalSet[0] != '\0' && terminalSet[1] == '\0';
+    while (q < _input_end) {
+        if (quoted) {
+            const char* runEnd = findSpecialStringChar(q, _input_end, terminalSet[0]);
+            result->append(q, runEnd - q);
+            q = runEnd;
+            if (q >= _input_end) {
+                break;
+            }
+        }
+        if (match(*q, terminalSet)) {
+            break;
+        }
         MONGO_JSON_DEBUG("q: " << q);
         if (allowedSet != NULL) {
             if (!match(*q, allowedSet)) {
@@ -1217,6 +1315,13 @@ inline bool JParse::readToken(const char* token) {
     return readTokenImpl(token, true);
 }
 
+inline void JParse::skipWhitespace() {
+    // See readTokenImpl() for the reason for the cast.
+    while (_input < _input_end && isspace(*reinterpret_cast<const unsigned char*>(_input))) {
+        ++_input;
+    }
+}
+
 bool JParse::readTokenImpl(const char* token, bool advance) {
     MONGO_JSON_DEBUG("token: " << token);
     const char* check = _input;
@@ -1246,7 +1351,6 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
 bool JParse::readField(StringData expectedField) {
     MONGO_JSON_DEBUG("expectedField: " << expectedField);
     std::string nextField;
-    nextField.reserve(FIELD_RESERVE_SIZE);
     Status ret = field(&nextField);
     if (ret != Status::OK()) {
         return false;
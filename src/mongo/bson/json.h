@@ -443,6 +443,11 @@ private:
      */
     bool readTokenImpl(const char* token, bool advance = true);
 
+    /**
+     * Advances the pointer to our buffer past any whitespace.
+     */
+    inline void skipWhitespace();
+
     /**
      * @return true if the next field in our stream matches field.
      * Handles single quoted, double quoted, and unquoted field names
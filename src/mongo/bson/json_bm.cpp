@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+void benchmarkFromJson(BenchmarkState& state, const std::string& json) {
+    state.setBytesPerIteration(json.size());
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(fromjson(json));
+    }
+}
+
+/**
+ * Returns the relaxed JSON of a document built of 'count' copies of 'element' under increasing
+ * field names.
+ */
+std::string makeJson(int count, const BSONObj& element) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < count; ++i) {
+        builder.appendAs(element.firstElement(), str::stream() << "field" << i);
+    }
+    return tojson(builder.obj());
+}
+
+BENCHMARK(FromJson, ManyIntegers) {
+    benchmarkFromJson(state, makeJson(10000, BSON("" << 123456)));
+}
+
+BENCHMARK(FromJson, ManyDoubles) {
+    benchmarkFromJson(state, makeJson(10000, BSON("" << 1234.5678)));
+}
+
+BENCHMARK(FromJson, ManyShortStrings) {
+    benchmarkFromJson(state,
+                      makeJson(10000,
+                               BSON(""
+                                    << "short string")));
+}
+
+BENCHMARK(FromJson, LongStrings) {
+    benchmarkFromJson(state, makeJson(1000, BSON("" << std::string(4096, 'x'))));
+}
+
+BENCHMARK(FromJson, LongStringsWithEscapes) {
+    std::string value;
+    for (int i = 0; i < 64; ++i) {
+        value += std::string(60, 'x') + "\n\"";
+    }
+    benchmarkFromJson(state, makeJson(1000, BSON("" << value)));
+}
+
+BENCHMARK(FromJson, ExtendedJsonTypes) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        BSONObjBuilder sub(builder.subobjStart(str::stream() << "doc" << i));
+        sub.append("_id", OID::gen());
+        sub.appendDate("date", Date_t::fromMillisSinceEpoch(1000LL * i));
+        sub.append("long", 1LL << 40);
+        sub.append("ts", Timestamp(i, 1));
+        sub.done();
+    }
+    benchmarkFromJson(state, tojson(builder.obj()));
+}
+
+BENCHMARK(FromJson, Nested) {
+    const BSONObj subdocument = BSON("" << BSON("name"
+                                                << "sensor"
+                                                << "value"
+                                                << 12
+                                                << "tags"
+                                                << BSON_ARRAY("a"
+                                                              << "b")));
+    benchmarkFromJson(state, makeJson(5000, subdocument));
+}
+
+}  // namespace
+}  // namespace mongo
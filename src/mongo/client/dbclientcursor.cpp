@@ -130,6 +130,15 @@ void DBClientCursor::_assembleInit(Message& toSend) {
     toSend.setData(dbGetMore, b.buf(), b.len());
 }
 
+void DBClientCursor::_assembleGetMore(Message& toSend) {
+    BufBuilder b;
+    b.appendNum(opts);
+    b.appendStr(ns);
+    b.appendNum(nextBatchSize());
+    b.appendNum(cursorId);
+    toSend.setData(dbGetMore, b.buf(), b.len());
+}
+
 bool DBClientCursor::init() {
     Message toSend;
     _assembleInit(toSend);
@@ -145,6 +154,7 @@ bool DBClientCursor::init() {
         return false;
     }
     dataReceived();
+    _prefetchNextBatch();
     return true;
 }
 
@@ -180,24 +190,31 @@ bool DBClientCursor::initLazyFinish(bool& retry) {
 void DBClientCursor::requestMore() {
     verify(cursorId && batch.pos == batch.nReturned);
 
+    if (_getMoreInFlight) {
+        // The request for this batch was sent when the previous one arrived.
+        _getMoreInFlight = false;
+        Message response;
+        uassert(40410, "recv failed while receiving a prefetched batch", _client->recv(response));
+        batch.m = std::move(response);
+        dataReceived();
+        _prefetchNextBatch();
+        return;
+    }
+
     if (haveLimit) {
         nToReturn -= batch.nReturned;
         verify(nToReturn > 0);
     }
-    BufBuilder b;
-    b.appendNum(opts);
-    b.appendStr(ns);
-    b.appendNum(nextBatchSize());
-    b.appendNum(cursorId);
 
     Message toSend;
-    toSend.setData(dbGetMore, b.buf(), b.len());
+    _assembleGetMore(toSend);
     Message response;
 
     if (_client) {
         _client->call(toSend, response);
         this->batch.m = std::move(response);
         dataReceived();
+        _prefetchNextBatch();
     } else {
         verify(_scopedHost.size());
         ScopedDbConnection conn(_scopedHost);
@@ -210,6 +227,46 @@ void DBClientCursor::requestMore() {
     }
 }
 
+void DBClientCursor::enablePrefetch() {
+    if (haveLimit || tailable() || (opts & QueryOption_Exhaust) || !_client ||
+        !_client->lazySupported()) {
+        return;
+    }
+
+    _prefetch = true;
+    _prefetchNextBatch();
+}
+
+void DBClientCursor::_prefetchNextBatch() {
+    if (!_prefetch || _getMoreInFlight || !cursorId || !_client) {
+        return;
+    }
+
+    Message toSend;
+    _assembleGetMore(toSend);
+    _client->say(toSend);
+    _getMoreInFlight = true;
+}
+
+void DBClientCursor::_discardPrefetchedBatch() {
+    if (!_getMoreInFlight) {
+        return;
+    }
+    _getMoreInFlight = false;
+
+    Message response;
+    if (!_client->recv(response)) {
+        return;
+    }
+
+    // The server may have exhausted the cursor with this batch, in which case there is nothing
+    // left to kill.
+    QueryResult::View qr = response.singleData().view2ptr();
+    if (!(qr.getResultFlags() & ResultFlag_CursorNotFound)) {
+        cursorId = qr.getCursorId();
+    }
+}
+
 /** with QueryOption_Exhaust, the server just blasts data at us (marked at end with cursorid==0). */
 void DBClientCursor::exhaustReceiveMore() {
     verify(cursorId && batch.pos == batch.nReturned);
@@ -427,6 +484,7 @@ bool DBClientCursor::peekError(BSONObj* error) {
 
 void DBClientCursor::attach(AScopedConnection* conn) {
     verify(_scopedHost.size() == 0);
+    verify(!_prefetch);
     verify(conn);
     verify(conn->get());
 
@@ -505,7 +563,9 @@ DBClientCursor::DBClientCursor(DBClientBase* client,
       cursorId(cursorId),
       _ownCursor(true),
       wasError(false),
-      _enabledBSONVersion(Validator<BSONObj>::enabledBSONVersion()) {}
+      _enabledBSONVersion(Validator<BSONObj>::enabledBSONVersion()),
+      _prefetch(false),
+      _getMoreInFlight(false) {}
 
 DBClientCursor::~DBClientCursor() {
     kill();
@@ -514,6 +574,10 @@ DBClientCursor::~DBClientCursor() {
 void DBClientCursor::kill() {
     DESTRUCTOR_GUARD(
 
+        // A prefetched reply still on the wire has to be read before the connection can send
+        // anything else.
+        _discardPrefetchedBatch();
+
         if (cursorId && _ownCursor && !globalInShutdownDeprecated()) {
             if (_client) {
                 _client->killCursor(cursorId);
@@ -155,6 +155,16 @@ public:
         batchSize = newBatchSize;
     }
 
+    /**
+     * Pipelines the getMore requests of this cursor: as soon as a batch arrives the request for
+     * the next one is sent, so the server produces it while the caller consumes the current one.
+     *
+     * The connection must not be used for anything else until the cursor is exhausted or
+     * killed. Cursors with a limit, tailable and exhaust cursors, and cursors whose connection
+     * does not support lazy requests ignore this.
+     */
+    void enablePrefetch();
+
     DBClientCursor(DBClientBase* client,
                    const std::string& ns,
                    const BSONObj& query,
@@ -268,6 +278,8 @@ private:
     std::string _lazyHost;
     bool wasError;
     BSONVersion _enabledBSONVersion;
+    bool _prefetch;
+    bool _getMoreInFlight;
 
     void dataReceived() {
         bool retry;
@@ -285,8 +297,21 @@ private:
 
     void requestMore();
 
+    /**
+     * Sends the getMore for the batch after the current one, if prefetching is enabled and the
+     * cursor is still open.
+     */
+    void _prefetchNextBatch();
+
+    /**
+     * Receives the reply to a prefetched getMore which the caller no longer wants, so that the
+     * connection can be used again. Only the cursor id is kept from it.
+     */
+    void _discardPrefetchedBatch();
+
     // init pieces
     void _assembleInit(Message& toSend);
+    void _assembleGetMore(Message& toSend);
 };
 
 /** iterate over objects in current batch only - will not cause a network call
@@ -106,6 +106,19 @@ public:
      */
     virtual void markHostUnreachable(const HostAndPort& host, const Status& status) = 0;
 
+    /**
+     * Reports to the targeter that a request is about to be sent to 'host', which it returned
+     * earlier. Every call must be balanced by a call to markRequestFinished once the response
+     * has arrived or the request has failed, so that the targeter can prefer less loaded hosts
+     * for subsequent requests.
+     */
+    virtual void markRequestStarted(const HostAndPort& host) = 0;
+
+    /**
+     * Reports to the targeter that a request reported through markRequestStarted is done.
+     */
+    virtual void markRequestFinished(const HostAndPort& host) = 0;
+
 protected:
     RemoteCommandTargeter() = default;
 };
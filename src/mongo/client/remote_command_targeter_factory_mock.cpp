@@ -65,6 +65,14 @@ public:
         _mock->markHostUnreachable(host, status);
     }
 
+    void markRequestStarted(const HostAndPort& host) override {
+        _mock->markRequestStarted(host);
+    }
+
+    void markRequestFinished(const HostAndPort& host) override {
+        _mock->markRequestFinished(host);
+    }
+
 private:
     const std::shared_ptr<RemoteCommandTargeter> _mock;
 };
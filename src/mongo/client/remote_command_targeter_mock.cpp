@@ -68,6 +68,10 @@ void RemoteCommandTargeterMock::markHostNotMaster(const HostAndPort& host, const
 void RemoteCommandTargeterMock::markHostUnreachable(const HostAndPort& host, const Status& status) {
 }
 
+void RemoteCommandTargeterMock::markRequestStarted(const HostAndPort& host) {}
+
+void RemoteCommandTargeterMock::markRequestFinished(const HostAndPort& host) {}
+
 void RemoteCommandTargeterMock::setConnectionStringReturnValue(const ConnectionString returnValue) {
     _connectionStringReturnValue = std::move(returnValue);
 }
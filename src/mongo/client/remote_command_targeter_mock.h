@@ -70,6 +70,16 @@ public:
      */
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
 
+    /**
+     * No-op for the mock.
+     */
+    void markRequestStarted(const HostAndPort& host) override;
+
+    /**
+     * No-op for the mock.
+     */
+    void markRequestFinished(const HostAndPort& host) override;
+
     /**
      * Sets the return value for the next call to connectionString.
      */
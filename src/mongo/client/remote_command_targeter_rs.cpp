@@ -100,4 +100,16 @@ void RemoteCommandTargeterRS::markHostUnreachable(const HostAndPort& host, const
     _rsMonitor->failedHost(host, status);
 }
 
+void RemoteCommandTargeterRS::markRequestStarted(const HostAndPort& host) {
+    invariant(_rsMonitor);
+
+    _rsMonitor->requestStarted(host);
+}
+
+void RemoteCommandTargeterRS::markRequestFinished(const HostAndPort& host) {
+    invariant(_rsMonitor);
+
+    _rsMonitor->requestFinished(host);
+}
+
 }  // namespace mongo
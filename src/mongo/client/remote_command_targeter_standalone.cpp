@@ -62,4 +62,12 @@ void RemoteCommandTargeterStandalone::markHostUnreachable(const HostAndPort& hos
     dassert(host == _hostAndPort);
 }
 
+void RemoteCommandTargeterStandalone::markRequestStarted(const HostAndPort& host) {
+    dassert(host == _hostAndPort);
+}
+
+void RemoteCommandTargeterStandalone::markRequestFinished(const HostAndPort& host) {
+    dassert(host == _hostAndPort);
+}
+
 }  // namespace mongo
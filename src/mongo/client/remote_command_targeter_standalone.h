@@ -53,6 +53,10 @@ public:
 
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
 
+    void markRequestStarted(const HostAndPort& host) override;
+
+    void markRequestFinished(const HostAndPort& host) override;
+
 private:
     const HostAndPort _hostAndPort;
 };
@@ -181,8 +181,12 @@ ReplicaSetMonitor::ReplicaSetMonitor(const MongoURI& uri)
 void ReplicaSetMonitor::init() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     invariant(_executor);
+    _scheduleRefresh_inlock(_executor->now());
+}
+
+void ReplicaSetMonitor::_scheduleRefresh_inlock(Date_t when) {
     std::weak_ptr<ReplicaSetMonitor> that(shared_from_this());
-    auto status = _executor->scheduleWork([=](const CallbackArgs& cbArgs) {
+    auto status = _executor->scheduleWorkAt(when, [=](const CallbackArgs& cbArgs) {
         if (auto ptr = that.lock()) {
             ptr->_refresh(cbArgs);
         }
@@ -195,7 +199,7 @@ void ReplicaSetMonitor::init() {
     }
 
     if (!status.isOK()) {
-        severe() << "Can't start refresh for replica set " << getName()
+        severe() << "Can't schedule refresh for replica set " << getName()
                  << causedBy(redact(status.getStatus()));
         fassertFailed(40139);
     }
@@ -203,6 +207,21 @@ void ReplicaSetMonitor::init() {
     _refresherHandle = status.getValue();
 }
 
+void ReplicaSetMonitor::_refreshNow() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_refresherHandle || _isRemovedFromManager.load()) {
+        return;
+    }
+
+    if (_isRefreshing) {
+        _refreshNowRequested = true;
+        return;
+    }
+
+    _executor->cancel(_refresherHandle);
+    _scheduleRefresh_inlock(_executor->now());
+}
+
 ReplicaSetMonitor::~ReplicaSetMonitor() {
     // need this lock because otherwise can get race with scheduling in _refresh
     stdx::lock_guard<stdx::mutex> lk(_mutex);
@@ -224,39 +243,32 @@ void ReplicaSetMonitor::_refresh(const CallbackArgs& cbArgs) {
         return;
     }
 
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // A callback which _refreshNow replaced may have started before it could be canceled.
+        if (cbArgs.myHandle != _refresherHandle) {
+            return;
+        }
+        _isRefreshing = true;
+        _refreshNowRequested = false;
+    }
+
     Timer t;
     startOrContinueRefresh().refreshAll();
     LOG(1) << "Refreshing replica set " << getName() << " took " << t.millis() << " msec";
     {
         // reschedule itself
         invariant(_executor);
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _isRefreshing = false;
+
         if (_isRemovedFromManager.load()) {  // already removed so no need to refresh
             LOG(1) << "Stopping refresh for replica set " << getName() << " because its removed";
             return;
         }
 
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-        std::weak_ptr<ReplicaSetMonitor> that(shared_from_this());
-        auto status = _executor->scheduleWorkAt(_executor->now() + kRefreshPeriod,
-                                                [=](const CallbackArgs& cbArgs) {
-                                                    if (auto ptr = that.lock()) {
-                                                        ptr->_refresh(cbArgs);
-                                                    }
-                                                });
-
-        if (status.getStatus() == ErrorCodes::ShutdownInProgress) {
-            LOG(1) << "Cant schedule refresh for " << getName()
-                   << ". Executor shutdown in progress";
-            return;
-        }
-
-        if (!status.isOK()) {
-            severe() << "Can't continue refresh for replica set " << getName() << " due to "
-                     << redact(status.getStatus());
-            fassertFailed(40140);
-        }
-
-        _refresherHandle = status.getValue();
+        _scheduleRefresh_inlock(_refreshNowRequested ? _executor->now()
+                                                     : _executor->now() + kRefreshPeriod);
     }
 }
 
@@ -318,11 +330,36 @@ Refresher ReplicaSetMonitor::startOrContinueRefresh() {
 }
 
 void ReplicaSetMonitor::failedHost(const HostAndPort& host, const Status& status) {
+    bool wasMaster = false;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+        Node* node = _state->findNode(host);
+        if (node) {
+            wasMaster = node->isMaster;
+            node->markFailed(status);
+        }
+        DEV _state->checkInvariants();
+    }
+
+    if (wasMaster) {
+        _refreshNow();
+    }
+}
+
+void ReplicaSetMonitor::requestStarted(const HostAndPort& host) {
     stdx::lock_guard<stdx::mutex> lk(_state->mutex);
     Node* node = _state->findNode(host);
     if (node)
-        node->markFailed(status);
-    DEV _state->checkInvariants();
+        node->outstandingRequests++;
+}
+
+void ReplicaSetMonitor::requestFinished(const HostAndPort& host) {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    Node* node = _state->findNode(host);
+    // The node may have been removed and added back while the request was running, in which
+    // case its count started over.
+    if (node && node->outstandingRequests > 0)
+        node->outstandingRequests--;
 }
 
 bool ReplicaSetMonitor::isPrimary(const HostAndPort& host) const {
@@ -1142,13 +1179,26 @@ HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) con
                     }
                 }
 
+                if (matchingNodes.size() == 1) {
+                    return matchingNodes.front()->host;
+                }
+
                 // of the remaining nodes, pick one at random (or use round-robin)
                 if (ReplicaSetMonitor::useDeterministicHostSelection) {
                     // only in tests
                     return matchingNodes[roundRobin++ % matchingNodes.size()]->host;
                 } else {
-                    // normal case
-                    return matchingNodes[rand.nextInt32(matchingNodes.size())]->host;
+                    // normal case: pick two at random and keep the one with fewer requests in
+                    // flight, so that a node which is falling behind gets less of the load
+                    // without the whole load moving to whichever node is least loaded.
+                    const size_t first = rand.nextInt32(matchingNodes.size());
+                    const size_t second = (first + 1 + rand.nextInt32(matchingNodes.size() - 1)) %
+                        matchingNodes.size();
+                    if (matchingNodes[second]->outstandingRequests <
+                        matchingNodes[first]->outstandingRequests) {
+                        return matchingNodes[second]->host;
+                    }
+                    return matchingNodes[first]->host;
                 };
             }
 
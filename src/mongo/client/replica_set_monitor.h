@@ -116,9 +116,24 @@ public:
      * Call this when you get a connection error. If you get an error while trying to refresh our
      * view of a host, call Refresher::failedHost instead because it bypasses taking the monitor's
      * mutex.
+     *
+     * If 'host' was believed to be the primary, the background refresh is brought forward so that
+     * the new primary is found without waiting for the next refresh period.
      */
     void failedHost(const HostAndPort& host, const Status& status);
 
+    /**
+     * Notifies this Monitor that a request is being sent to 'host', so that it is considered more
+     * loaded than its peers when choosing among secondaries or for nearest reads. Must be
+     * balanced by a call to requestFinished.
+     */
+    void requestStarted(const HostAndPort& host);
+
+    /**
+     * Notifies this Monitor that a request reported through requestStarted is done.
+     */
+    void requestFinished(const HostAndPort& host);
+
     /**
      * Returns true if this node is the master based ONLY on local data. Be careful, return may
      * be stale.
@@ -267,10 +282,29 @@ private:
      */
     void _refresh(const executor::TaskExecutor::CallbackArgs&);
 
-    // Serializes refresh and protects _refresherHandle
+    /**
+     * Schedules the next run of _refresh at 'when' and records its handle in _refresherHandle.
+     * Must be called with _mutex held.
+     */
+    void _scheduleRefresh_inlock(Date_t when);
+
+    /**
+     * Runs the background refresh as soon as possible instead of at its scheduled time. If a
+     * refresh is running, the next one is started right after it.
+     */
+    void _refreshNow();
+
+    // Serializes refresh and protects _refresherHandle and _isRefreshing
     stdx::mutex _mutex;
     executor::TaskExecutor::CallbackHandle _refresherHandle;
 
+    // True while _refresh runs, during which _refresherHandle is the handle of the running
+    // callback and can no longer be canceled
+    bool _isRefreshing{false};
+
+    // Set by _refreshNow while a refresh is running, so that the next one is not delayed
+    bool _refreshNowRequested{false};
+
     const SetStatePtr _state;
     executor::TaskExecutor* _executor;
     AtomicBool _isRemovedFromManager{false};
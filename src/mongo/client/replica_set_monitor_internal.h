@@ -133,6 +133,7 @@ public:
         Date_t lastWriteDateUpdateTime{};  // set to the local system's time at the time of updating
                                            // lastWriteDate
         repl::OpTime opTime{};             // from isMasterReply
+        int outstandingRequests{0};        // requests sent to this node which have not finished
     };
 
     typedef std::vector<Node> Nodes;
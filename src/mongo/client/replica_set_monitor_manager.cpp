@@ -38,13 +38,13 @@
 #include "mongo/client/replica_set_monitor.h"
 #include "mongo/executor/network_connection_hook.h"
 #include "mongo/executor/network_interface_factory.h"
-#include "mongo/executor/network_interface_thread_pool.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/rpc/metadata/egress_metadata_hook_list.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/map_util.h"
 
@@ -56,11 +56,17 @@ using std::string;
 using std::vector;
 
 using executor::NetworkInterface;
-using executor::NetworkInterfaceThreadPool;
 using executor::TaskExecutorPool;
 using executor::TaskExecutor;
 using executor::ThreadPoolTaskExecutor;
 
+namespace {
+
+// Upper bound on the number of replica sets whose hosts are refreshed at the same time.
+const size_t kMaxRefreshThreads = 16;
+
+}  // namespace
+
 ReplicaSetMonitorManager::ReplicaSetMonitorManager() {}
 
 ReplicaSetMonitorManager::~ReplicaSetMonitorManager() {
@@ -86,9 +92,15 @@ void ReplicaSetMonitorManager::_setupTaskExecutorInLock(const std::string& name)
         // construct task executor
         auto net = executor::makeNetworkInterface(
             "ReplicaSetMonitor-TaskExecutor", nullptr, std::move(hookList));
-        auto netPtr = net.get();
+
+        // Refreshes block on isMaster calls to each host of their set, so they get a thread pool
+        // of their own rather than running one at a time on the network interface's thread.
+        ThreadPool::Options threadPoolOptions;
+        threadPoolOptions.poolName = "ReplicaSetMonitor";
+        threadPoolOptions.minThreads = 1;
+        threadPoolOptions.maxThreads = kMaxRefreshThreads;
         _taskExecutor = stdx::make_unique<ThreadPoolTaskExecutor>(
-            stdx::make_unique<NetworkInterfaceThreadPool>(netPtr), std::move(net));
+            stdx::make_unique<ThreadPool>(threadPoolOptions), std::move(net));
         LOG(1) << "Starting up task executor for monitoring replica sets in response to request to "
                   "monitor set: "
                << redact(name);
@@ -1061,6 +1061,24 @@ TEST(MultiTags, NearestMultiTagsNoMatch) {
     ASSERT(host.empty());
 }
 
+TEST(ReplSetMonitorReadPref, SecOnlyPrefersFewerOutstandingRequests) {
+    vector<Node> nodes = getThreeMemberWithTags();
+    TagSet tags(getDefaultTagSet());
+
+    nodes[0].outstandingRequests = 10;
+    nodes[2].outstandingRequests = 1;
+
+    // With only two eligible nodes both are always compared, so the less loaded one wins.
+    for (int i = 0; i < 20; i++) {
+        bool isPrimarySelected = false;
+        HostAndPort host =
+            selectNode(nodes, mongo::ReadPreference::SecondaryOnly, tags, 3, &isPrimarySelected);
+
+        ASSERT(!isPrimarySelected);
+        ASSERT_EQUALS("c", host.host());
+    }
+}
+
 TEST(TagSet, DefaultConstructorMatchesAll) {
     TagSet tags;
     ASSERT_BSONOBJ_EQ(tags.getTagBSON(), BSON_ARRAY(BSONObj()));
@@ -50,6 +50,8 @@
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/db/stats/resource_usage.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/rpc/command_reply_builder.h"
 #include "mongo/rpc/command_request.h"
@@ -544,6 +546,7 @@ void assembleResponse(OperationContext* opCtx,
     }
 
     OpDebug& debug = currentOp.debug();
+    debug.requestLength = m.header().dataLen();
 
     long long logThresholdMs = serverGlobalParams.slowMS;
     bool shouldLogOpDebug = shouldLog(logger::LogSeverity::Debug(1));
@@ -617,6 +620,16 @@ void assembleResponse(OperationContext* opCtx,
     Top::get(opCtx->getServiceContext())
         .incrementGlobalLatencyStats(
             opCtx, currentOp.totalTimeMicros(), currentOp.getReadWriteType());
+    QueryShapeStats::get(opCtx->getServiceContext())
+        .record(currentOp, opCtx->getServiceContext()->getFastClockSource()->now());
+    if (!c.isInDirectClient()) {
+        // The operations of a DBDirectClient are already part of the operation running them.
+        ResourceUsage::get(opCtx->getServiceContext())
+            .record(currentOp, AuthorizationSession::get(c)->getAuthenticatedUserNames());
+    }
+    if (Command* command = currentOp.getCommand()) {
+        command->recordLatency(currentOp.totalTimeMicros());
+    }
 
     const bool shouldSample = serverGlobalParams.sampleRate == 1.0
         ? true
@@ -285,7 +285,8 @@ Status AuthorizationSession::checkAuthForAggregate(const NamespaceString& ns,
         if (str::equals("$indexStats", firstPipelineStage.firstElementFieldName())) {
             Privilege::addPrivilegeToPrivilegeVector(
                 &privileges, Privilege(inputResource, ActionType::indexStats));
-        } else if (str::equals("$collStats", firstPipelineStage.firstElementFieldName())) {
+        } else if (str::equals("$collStats", firstPipelineStage.firstElementFieldName()) ||
+                   str::equals("$queryShapeStats", firstPipelineStage.firstElementFieldName())) {
             Privilege::addPrivilegeToPrivilegeVector(
                 &privileges, Privilege(inputResource, ActionType::collStats));
         } else {
@@ -646,6 +647,9 @@ bool AuthorizationSession::isAuthorizedForActionsOnNamespace(const NamespaceStri
 }
 
 static const int resourceSearchListCapacity = 5;
+
+// Maximum number of resources whose actions an AuthorizationSession caches.
+static const size_t kMaxCachedResources = 1000;
 /**
  * Builds from "target" an exhaustive list of all ResourcePatterns that match "target".
  *
@@ -776,6 +780,7 @@ void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
 }
 
 void AuthorizationSession::_buildAuthenticatedRolesVector() {
+    _resourceActionsCache.clear();
     _authenticatedRoleNames.clear();
     for (UserSet::iterator it = _authenticatedUsers.begin(); it != _authenticatedUsers.end();
          ++it) {
@@ -790,39 +795,58 @@ void AuthorizationSession::_buildAuthenticatedRolesVector() {
 bool AuthorizationSession::_isAuthorizedForPrivilege(const Privilege& privilege) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
-    ResourcePattern resourceSearchList[resourceSearchListCapacity];
-    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
-
     ActionSet unmetRequirements = privilege.getActions();
 
     PrivilegeVector defaultPrivileges = getDefaultPrivileges();
-    for (PrivilegeVector::iterator it = defaultPrivileges.begin(); it != defaultPrivileges.end();
-         ++it) {
-        for (int i = 0; i < resourceSearchListLength; ++i) {
-            if (!(it->getResourcePattern() == resourceSearchList[i]))
-                continue;
+    if (!defaultPrivileges.empty()) {
+        ResourcePattern resourceSearchList[resourceSearchListCapacity];
+        const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+        for (PrivilegeVector::iterator it = defaultPrivileges.begin();
+             it != defaultPrivileges.end();
+             ++it) {
+            for (int i = 0; i < resourceSearchListLength; ++i) {
+                if (!(it->getResourcePattern() == resourceSearchList[i]))
+                    continue;
+
+                ActionSet userActions = it->getActions();
+                unmetRequirements.removeAllActionsFromSet(userActions);
+
+                if (unmetRequirements.empty())
+                    return true;
+            }
+        }
+    }
 
-            ActionSet userActions = it->getActions();
-            unmetRequirements.removeAllActionsFromSet(userActions);
+    unmetRequirements.removeAllActionsFromSet(_getAuthenticatedActionsForResource(target));
+    return unmetRequirements.empty();
+}
 
-            if (unmetRequirements.empty())
-                return true;
-        }
+const ActionSet& AuthorizationSession::_getAuthenticatedActionsForResource(
+    const ResourcePattern& target) {
+    auto cached = _resourceActionsCache.find(target);
+    if (cached != _resourceActionsCache.end()) {
+        return cached->second;
     }
 
+    ResourcePattern resourceSearchList[resourceSearchListCapacity];
+    const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
+
+    ActionSet actions;
     for (UserSet::iterator it = _authenticatedUsers.begin(); it != _authenticatedUsers.end();
          ++it) {
         User* user = *it;
         for (int i = 0; i < resourceSearchListLength; ++i) {
-            ActionSet userActions = user->getActionsForResource(resourceSearchList[i]);
-            unmetRequirements.removeAllActionsFromSet(userActions);
-
-            if (unmetRequirements.empty())
-                return true;
+            actions.addAllActionsFromSet(user->getActionsForResource(resourceSearchList[i]));
         }
     }
 
-    return false;
+    // A session touching an unbounded number of namespaces starts over rather than growing
+    // without limit.
+    if (_resourceActionsCache.size() >= kMaxCachedResources) {
+        _resourceActionsCache.clear();
+    }
+    return _resourceActionsCache.emplace(target, actions).first->second;
 }
 
 void AuthorizationSession::setImpersonatedUserData(std::vector<UserName> usernames,
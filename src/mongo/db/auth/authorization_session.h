@@ -39,9 +39,11 @@
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authz_session_external_state.h"
 #include "mongo/db/auth/privilege.h"
+#include "mongo/db/auth/resource_pattern.h"
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/platform/unordered_map.h"
 
 namespace mongo {
 
@@ -284,7 +286,8 @@ public:
 protected:
     // Builds a vector of all roles held by users who are authenticated on this connection. The
     // vector is stored in _authenticatedRoleNames. This function is called when users are
-    // logged in or logged out, as well as when the user cache is determined to be out of date.
+    // logged in or logged out, as well as when the user cache is determined to be out of date,
+    // so it also drops the actions cached in _resourceActionsCache.
     void _buildAuthenticatedRolesVector();
 
     // All Users who have been authenticated on this connection.
@@ -305,6 +308,10 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Returns the union of the actions the authenticated users are granted on every resource
+    // pattern matching 'target', caching it in _resourceActionsCache.
+    const ActionSet& _getAuthenticatedActionsForResource(const ResourcePattern& target);
+
     // Helper for recursively checking for privileges in an aggregation pipeline.
     void _addPrivilegesForStage(const std::string& db,
                                 const BSONObj& cmdObj,
@@ -314,6 +321,10 @@ private:
 
     std::unique_ptr<AuthzSessionExternalState> _externalState;
 
+    // The actions the authenticated users hold on each resource checked so far. The users and
+    // their privileges only change when _authenticatedUsers does, which clears this cache.
+    unordered_map<ResourcePattern, ActionSet> _resourceActionsCache;
+
     // A vector of impersonated UserNames and a vector of those users' RoleNames.
     // These are used in the auditing system. They are not used for authz checks.
     std::vector<UserName> _impersonatedUserNames;
@@ -609,6 +609,22 @@ TEST_F(AuthorizationSessionTest, CanAggregateCollStatsWithCollStatsAction) {
     ASSERT_OK(authzSession->checkAuthForAggregate(testFooNss, cmdObj));
 }
 
+TEST_F(AuthorizationSessionTest, CannotAggregateQueryShapeStatsWithoutCollStatsAction) {
+    authzSession->assumePrivilegesForDB(Privilege(testFooCollResource, {ActionType::find}));
+
+    BSONArray pipeline = BSON_ARRAY(BSON("$queryShapeStats" << BSONObj()));
+    BSONObj cmdObj = BSON("aggregate" << testFooNss.coll() << "pipeline" << pipeline);
+    ASSERT_EQ(ErrorCodes::Unauthorized, authzSession->checkAuthForAggregate(testFooNss, cmdObj));
+}
+
+TEST_F(AuthorizationSessionTest, CanAggregateQueryShapeStatsWithCollStatsAction) {
+    authzSession->assumePrivilegesForDB(Privilege(testFooCollResource, {ActionType::collStats}));
+
+    BSONArray pipeline = BSON_ARRAY(BSON("$queryShapeStats" << BSONObj()));
+    BSONObj cmdObj = BSON("aggregate" << testFooNss.coll() << "pipeline" << pipeline);
+    ASSERT_OK(authzSession->checkAuthForAggregate(testFooNss, cmdObj));
+}
+
 TEST_F(AuthorizationSessionTest, CannotAggregateIndexStatsWithoutIndexStatsAction) {
     authzSession->assumePrivilegesForDB(Privilege(testFooCollResource, {ActionType::find}));
 
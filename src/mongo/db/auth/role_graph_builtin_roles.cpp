@@ -211,6 +211,7 @@ MONGO_INITIALIZER(AuthorizationBuiltinRoles)(InitializerContext* context) {
         << ActionType::setParameter
         << ActionType::shutdown
         << ActionType::touch
+        << ActionType::trafficRecord
         << ActionType::unlock
         << ActionType::diagLogging
         << ActionType::flushRouterConfig  // clusterManager gets this also
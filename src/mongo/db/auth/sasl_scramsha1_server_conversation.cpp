@@ -38,6 +38,7 @@
 #include "mongo/crypto/mechanism_scram.h"
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/db/auth/sasl_options.h"
+#include "mongo/db/auth/scram_sha1_server_cache.h"
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/log.h"
@@ -51,6 +52,14 @@ namespace mongo {
 using std::unique_ptr;
 using std::string;
 
+namespace {
+
+// Credentials generated for users which only have MONGODB-CR credentials, shared by all
+// conversations.
+SCRAMSHA1ServerCache mixedModeCredentialsCache;
+
+}  // namespace
+
 SaslSCRAMSHA1ServerConversation::SaslSCRAMSHA1ServerConversation(
     SaslAuthenticationSession* saslAuthSession)
     : SaslServerConversation(saslAuthSession), _step(0), _authMessage(""), _nonce("") {}
@@ -190,12 +199,20 @@ StatusWith<bool> SaslSCRAMSHA1ServerConversation::_firstStep(std::vector<string>
         // Use a default value of 5000 for the scramIterationCount when in mixed mode,
         // overriding the default value (10000) used for SCRAM mode or the user-given value.
         const int mixedModeScramIterationCount = 5000;
-        BSONObj scramCreds =
-            scram::generateCredentials(_creds.password, mixedModeScramIterationCount);
-        _creds.scram.iterationCount = scramCreds[scram::iterationCountFieldName].Int();
-        _creds.scram.salt = scramCreds[scram::saltFieldName].String();
-        _creds.scram.storedKey = scramCreds[scram::storedKeyFieldName].String();
-        _creds.scram.serverKey = scramCreds[scram::serverKeyFieldName].String();
+        auto cachedCreds = mixedModeCredentialsCache.getCachedCredentials(
+            userName, _creds.password, mixedModeScramIterationCount);
+        if (cachedCreds) {
+            _creds.scram = std::move(*cachedCreds);
+        } else {
+            BSONObj scramCreds =
+                scram::generateCredentials(_creds.password, mixedModeScramIterationCount);
+            _creds.scram.iterationCount = scramCreds[scram::iterationCountFieldName].Int();
+            _creds.scram.salt = scramCreds[scram::saltFieldName].String();
+            _creds.scram.storedKey = scramCreds[scram::storedKeyFieldName].String();
+            _creds.scram.serverKey = scramCreds[scram::serverKeyFieldName].String();
+            mixedModeCredentialsCache.setCachedCredentials(
+                userName, _creds.password, _creds.scram);
+        }
     }
 
     // Generate server-first-message
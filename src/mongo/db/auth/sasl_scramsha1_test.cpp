@@ -36,6 +36,7 @@
 #include "mongo/db/auth/authz_session_external_state_mock.h"
 #include "mongo/db/auth/native_sasl_authentication_session.h"
 #include "mongo/db/auth/sasl_scramsha1_server_conversation.h"
+#include "mongo/db/auth/scram_sha1_server_cache.h"
 #include "mongo/db/service_context_noop.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
@@ -239,6 +240,10 @@ protected:
         authzSession = stdx::make_unique<AuthorizationSession>(
             stdx::make_unique<AuthzSessionExternalStateMock>(authzManager.get()));
 
+        startSaslSessions();
+    }
+
+    void startSaslSessions() {
         saslServerSession = stdx::make_unique<NativeSaslAuthenticationSession>(authzSession.get());
         saslServerSession->setOpCtxt(opCtx.get());
         saslServerSession->start("test", "SCRAM-SHA-1", "mongodb", "MockServer.test", 1, false);
@@ -504,4 +509,87 @@ TEST(SCRAMSHA1Cache, testSetAndReset) {
     ASSERT_TRUE(*newSecret.storedKey == *cachedSecret->storedKey);
 }
 
+User::SCRAMCredentials makeServerCacheCredentials(StringData salt, int iterationCount) {
+    User::SCRAMCredentials creds;
+    creds.iterationCount = iterationCount;
+    creds.salt = salt.toString();
+    creds.serverKey = "serverKey";
+    creds.storedKey = "storedKey";
+    return creds;
+}
+
+TEST(SCRAMSHA1ServerCache, testSetAndGet) {
+    SCRAMSHA1ServerCache cache;
+    UserName user("sajack", "test");
+
+    ASSERT_FALSE(cache.getCachedCredentials(user, "digest", 5000));
+
+    cache.setCachedCredentials(user, "digest", makeServerCacheCredentials("salt", 5000));
+    auto cachedCreds = cache.getCachedCredentials(user, "digest", 5000);
+    ASSERT_TRUE(cachedCreds);
+    ASSERT_EQ("salt", cachedCreds->salt);
+    ASSERT_EQ("serverKey", cachedCreds->serverKey);
+    ASSERT_EQ("storedKey", cachedCreds->storedKey);
+
+    ASSERT_FALSE(cache.getCachedCredentials(UserName("sajack", "admin"), "digest", 5000));
+    ASSERT_FALSE(cache.getCachedCredentials(user, "newDigest", 5000));
+    ASSERT_FALSE(cache.getCachedCredentials(user, "digest", 10000));
+}
+
+TEST(SCRAMSHA1ServerCache, testSetAndReset) {
+    SCRAMSHA1ServerCache cache;
+    UserName user("sajack", "test");
+
+    cache.setCachedCredentials(user, "digest", makeServerCacheCredentials("salt", 5000));
+    cache.setCachedCredentials(user, "newDigest", makeServerCacheCredentials("newSalt", 5000));
+
+    ASSERT_EQ(1U, cache.size());
+    ASSERT_FALSE(cache.getCachedCredentials(user, "digest", 5000));
+    auto cachedCreds = cache.getCachedCredentials(user, "newDigest", 5000);
+    ASSERT_TRUE(cachedCreds);
+    ASSERT_EQ("newSalt", cachedCreds->salt);
+}
+
+TEST(SCRAMSHA1ServerCache, testSizeIsBounded) {
+    SCRAMSHA1ServerCache cache(2);
+
+    cache.setCachedCredentials(UserName("a", "test"), "digest", makeServerCacheCredentials("s", 1));
+    cache.setCachedCredentials(UserName("b", "test"), "digest", makeServerCacheCredentials("s", 1));
+    cache.setCachedCredentials(UserName("c", "test"), "digest", makeServerCacheCredentials("s", 1));
+
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_TRUE(cache.getCachedCredentials(UserName("c", "test"), "digest", 1));
+}
+
+TEST_F(SCRAMSHA1Fixture, testMONGODBCRReusesGeneratedCredentials) {
+    std::vector<std::string> salts;
+    SCRAMMutators mutator;
+    mutator.setMutator(SaslTestState(SaslTestState::kServer, 1),
+                       [&salts](std::string& serverMessage) {
+                           auto saltBegin = serverMessage.find("s=");
+                           auto saltEnd = serverMessage.find(',', saltBegin);
+                           salts.push_back(serverMessage.substr(saltBegin, saltEnd - saltBegin));
+                       });
+
+    authzManagerExternalState->insertPrivilegeDocument(
+        opCtx.get(), generateMONGODBCRUserDocument("crjack", "crjack"), BSONObj());
+
+    for (int i = 0; i < 2; ++i) {
+        if (i > 0) {
+            startSaslSessions();
+        }
+
+        saslClientSession->setParameter(NativeSaslClientSession::parameterUser, "crjack");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterPassword,
+                                        createPasswordDigest("crjack", "crjack"));
+        ASSERT_OK(saslClientSession->initialize());
+
+        ASSERT_EQ(goalState, runSteps(saslServerSession.get(), saslClientSession.get(), mutator));
+    }
+
+    // The second conversation advertises the salt generated for the first one.
+    ASSERT_EQ(2U, salts.size());
+    ASSERT_EQ(salts[0], salts[1]);
+}
+
 }  // namespace mongo
@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/scram_sha1_server_cache.h"
+
+namespace mongo {
+
+constexpr size_t SCRAMSHA1ServerCache::kDefaultMaxEntries;
+
+SCRAMSHA1ServerCache::SCRAMSHA1ServerCache(size_t maxEntries) : _maxEntries(maxEntries) {}
+
+boost::optional<User::SCRAMCredentials> SCRAMSHA1ServerCache::getCachedCredentials(
+    const UserName& userName, const std::string& passwordDigest, int iterationCount) const {
+    const stdx::lock_guard<stdx::mutex> lock(_userToCredentialsMutex);
+
+    auto found = _userToCredentials.find(userName);
+    if (found == _userToCredentials.end()) {
+        return {};
+    }
+
+    // The password may have changed since the credentials were generated, in which case they
+    // must not be used and the derivation has to be rerun.
+    const auto& record = found->second;
+    if (record.first != passwordDigest || record.second.iterationCount != iterationCount) {
+        return {};
+    }
+    return record.second;
+}
+
+void SCRAMSHA1ServerCache::setCachedCredentials(UserName userName,
+                                                std::string passwordDigest,
+                                                User::SCRAMCredentials credentials) {
+    if (_maxEntries == 0) {
+        return;
+    }
+
+    const stdx::lock_guard<stdx::mutex> lock(_userToCredentialsMutex);
+
+    auto record = std::make_pair(std::move(passwordDigest), std::move(credentials));
+
+    auto found = _userToCredentials.find(userName);
+    if (found != _userToCredentials.end()) {
+        found->second = std::move(record);
+        return;
+    }
+
+    if (_userToCredentials.size() >= _maxEntries) {
+        _userToCredentials.erase(_userToCredentials.begin());
+    }
+    _userToCredentials.emplace(std::move(userName), std::move(record));
+}
+
+size_t SCRAMSHA1ServerCache::size() const {
+    const stdx::lock_guard<stdx::mutex> lock(_userToCredentialsMutex);
+    return _userToCredentials.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/auth/user.h"
+#include "mongo/db/auth/user_name.h"
+#include "mongo/db/auth/user_name_hash.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A cache for the SCRAM-SHA-1 credentials the server generates on the fly for users which only
+ * have MONGODB-CR credentials.
+ *
+ * In mixed MONGODB-CR/SCRAM mode the server has to derive a salt, StoredKey and ServerKey from
+ * the user's password digest before it can answer the client's first message. This derivation
+ * is as expensive as the client's own, and without a cache it is rerun, with a fresh salt, on
+ * every conversation. Since the server then advertises a new salt each time, the clients'
+ * SCRAMSHA1ClientCache never hits either.
+ *
+ * Entries are keyed by user and tagged with the password digest they were generated from, so a
+ * password change is never answered with stale credentials. The cache holds at most a fixed
+ * number of users; once full, an arbitrary entry is evicted to make room for a new one.
+ */
+class SCRAMSHA1ServerCache {
+    MONGO_DISALLOW_COPYING(SCRAMSHA1ServerCache);
+
+public:
+    static constexpr size_t kDefaultMaxEntries = 10000;
+
+    explicit SCRAMSHA1ServerCache(size_t maxEntries = kDefaultMaxEntries);
+
+    /**
+     * Returns the credentials recorded for the specified user, if they were generated from the
+     * provided password digest with the provided iteration count. Otherwise, no credentials are
+     * returned.
+     */
+    boost::optional<User::SCRAMCredentials> getCachedCredentials(
+        const UserName& userName, const std::string& passwordDigest, int iterationCount) const;
+
+    /**
+     * Records the credentials generated for the specified user, along with the password digest
+     * used to generate them.
+     */
+    void setCachedCredentials(UserName userName,
+                              std::string passwordDigest,
+                              User::SCRAMCredentials credentials);
+
+    /**
+     * Returns the number of users with cached credentials.
+     */
+    size_t size() const;
+
+private:
+    const size_t _maxEntries;
+
+    mutable stdx::mutex _userToCredentialsMutex;
+    stdx::unordered_map<UserName, std::pair<std::string, User::SCRAMCredentials>>
+        _userToCredentials;
+};
+
+}  // namespace mongo
@@ -50,6 +50,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -128,6 +129,23 @@ std::unique_ptr<CollatorInterface> parseCollation(OperationContext* opCtx,
 
     return std::move(collator.getValue());
 }
+
+// Returns true unless the paths indexed by 'descriptor' are known and none of them can be changed
+// by an update of 'modifiedPaths'.
+bool indexMightBeAffected(OperationContext* opCtx,
+                          const CollectionInfoCache& infoCache,
+                          const IndexDescriptor* descriptor,
+                          const FieldRefSet& modifiedPaths) {
+    const UpdateIndexData* indexedPaths = infoCache.getIndexKeys(opCtx, descriptor);
+    if (!indexedPaths)
+        return true;
+
+    for (const FieldRef* path : modifiedPaths) {
+        if (indexedPaths->mightBeIndexed(path->dottedField()))
+            return true;
+    }
+    return false;
+}
 }
 
 using std::unique_ptr;
@@ -609,7 +627,8 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* opCtx,
                                                 bool enforceQuota,
                                                 bool indexesAffected,
                                                 OpDebug* opDebug,
-                                                OplogUpdateEntryArgs* args) {
+                                                OplogUpdateEntryArgs* args,
+                                                const FieldRefSet* modifiedPaths) {
     {
         auto status = checkValidation(opCtx, newDoc);
         if (!status.isOK()) {
@@ -660,7 +679,7 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* opCtx,
                               << " != "
                               << newDoc.objsize()};
 
-    // At the end of this step, we will have a map of UpdateTickets, one per index, which
+    // At the end of this step, we will have a map of UpdateTickets, one per affected index, which
     // represent the index updates needed to be done, based on the changes between oldDoc and
     // newDoc.
     OwnedPointerMap<IndexDescriptor*, UpdateTicket> updateTickets;
@@ -668,6 +687,11 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* opCtx,
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            if (modifiedPaths &&
+                !indexMightBeAffected(opCtx, _infoCache, descriptor, *modifiedPaths)) {
+                continue;
+            }
+
             IndexCatalogEntry* entry = ii.catalogEntry(descriptor);
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
@@ -703,12 +727,15 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* opCtx,
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            auto ticket = updateTickets.map().find(descriptor);
+            if (ticket == updateTickets.map().end())
+                continue;
+
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
             int64_t keysInserted;
             int64_t keysDeleted;
-            Status ret = iam->update(
-                opCtx, *updateTickets.mutableMap()[descriptor], &keysInserted, &keysDeleted);
+            Status ret = iam->update(opCtx, *ticket->second, &keysInserted, &keysDeleted);
             if (!ret.isOK())
                 return StatusWith<RecordId>(ret);
             if (opDebug) {
@@ -58,6 +58,7 @@ namespace mongo {
 class CollectionCatalogEntry;
 class DatabaseCatalogEntry;
 class ExtentManager;
+class FieldRefSet;
 class IndexCatalog;
 class MatchExpression;
 class MultiIndexBlock;
@@ -315,6 +316,8 @@ public:
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     * 'modifiedPaths' Optional argument. When not null, it holds every path the update may have
+     * changed, and only the indexes on one of those paths are updated.
      * @return the post update location of the doc (may or may not be the same as oldLocation)
      */
     StatusWith<RecordId> updateDocument(OperationContext* opCtx,
@@ -324,7 +327,8 @@ public:
                                         bool enforceQuota,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
-                                        OplogUpdateEntryArgs* args);
+                                        OplogUpdateEntryArgs* args,
+                                        const FieldRefSet* modifiedPaths = nullptr);
 
     bool updateWithDamagesSupported() const;
 
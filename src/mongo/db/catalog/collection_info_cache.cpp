@@ -64,6 +64,57 @@ CollectionInfoCache::~CollectionInfoCache() {
     }
 }
 
+namespace {
+
+/**
+ * Adds to 'indexedPaths' every path whose modification may change the keys that the index
+ * described by 'descriptor' and 'entry' generates for a document.
+ */
+void addIndexedPaths(const IndexDescriptor* descriptor,
+                     const IndexCatalogEntry* entry,
+                     UpdateIndexData* indexedPaths) {
+    if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
+        BSONObjIterator j(descriptor->keyPattern());
+        while (j.more()) {
+            BSONElement e = j.next();
+            indexedPaths->addPath(e.fieldName());
+        }
+    } else {
+        fts::FTSSpec ftsSpec(descriptor->infoObj());
+
+        if (ftsSpec.wildcard()) {
+            indexedPaths->allPathsIndexed();
+        } else {
+            for (size_t i = 0; i < ftsSpec.numExtraBefore(); ++i) {
+                indexedPaths->addPath(ftsSpec.extraBefore(i));
+            }
+            for (fts::Weights::const_iterator it = ftsSpec.weights().begin();
+                 it != ftsSpec.weights().end();
+                 ++it) {
+                indexedPaths->addPath(it->first);
+            }
+            for (size_t i = 0; i < ftsSpec.numExtraAfter(); ++i) {
+                indexedPaths->addPath(ftsSpec.extraAfter(i));
+            }
+            // Any update to a path containing "language" as a component could change the
+            // language of a subdocument.  Add the override field as a path component.
+            indexedPaths->addPathComponent(ftsSpec.languageOverrideField());
+        }
+    }
+
+    // handle partial indexes
+    const MatchExpression* filter = entry->getFilterExpression();
+    if (filter) {
+        unordered_set<std::string> paths;
+        QueryPlannerIXSelect::getFields(filter, "", &paths);
+        for (auto it = paths.begin(); it != paths.end(); ++it) {
+            indexedPaths->addPath(*it);
+        }
+    }
+}
+
+}  // namespace
+
 const UpdateIndexData& CollectionInfoCache::getIndexKeys(OperationContext* opCtx) const {
     // This requires "some" lock, and MODE_IS is an expression for that, for now.
     dassert(opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_IS));
@@ -71,8 +122,17 @@ const UpdateIndexData& CollectionInfoCache::getIndexKeys(OperationContext* opCtx
     return _indexedPaths;
 }
 
+const UpdateIndexData* CollectionInfoCache::getIndexKeys(OperationContext* opCtx,
+                                                         const IndexDescriptor* desc) const {
+    dassert(opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_IS));
+    invariant(_keysComputed);
+    auto it = _indexedPathsByIndex.find(desc);
+    return it == _indexedPathsByIndex.end() ? nullptr : &it->second;
+}
+
 void CollectionInfoCache::computeIndexKeys(OperationContext* opCtx) {
     _indexedPaths.clear();
+    _indexedPathsByIndex.clear();
 
     bool hadTTLIndex = _hasTTLIndex;
     _hasTTLIndex = false;
@@ -80,51 +140,15 @@ void CollectionInfoCache::computeIndexKeys(OperationContext* opCtx) {
     IndexCatalog::IndexIterator i = _collection->getIndexCatalog()->getIndexIterator(opCtx, true);
     while (i.more()) {
         IndexDescriptor* descriptor = i.next();
+        const IndexCatalogEntry* entry = i.catalogEntry(descriptor);
 
-        if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
-            BSONObj key = descriptor->keyPattern();
-            const BSONObj& infoObj = descriptor->infoObj();
-            if (infoObj.hasField("expireAfterSeconds")) {
-                _hasTTLIndex = true;
-            }
-            BSONObjIterator j(key);
-            while (j.more()) {
-                BSONElement e = j.next();
-                _indexedPaths.addPath(e.fieldName());
-            }
-        } else {
-            fts::FTSSpec ftsSpec(descriptor->infoObj());
-
-            if (ftsSpec.wildcard()) {
-                _indexedPaths.allPathsIndexed();
-            } else {
-                for (size_t i = 0; i < ftsSpec.numExtraBefore(); ++i) {
-                    _indexedPaths.addPath(ftsSpec.extraBefore(i));
-                }
-                for (fts::Weights::const_iterator it = ftsSpec.weights().begin();
-                     it != ftsSpec.weights().end();
-                     ++it) {
-                    _indexedPaths.addPath(it->first);
-                }
-                for (size_t i = 0; i < ftsSpec.numExtraAfter(); ++i) {
-                    _indexedPaths.addPath(ftsSpec.extraAfter(i));
-                }
-                // Any update to a path containing "language" as a component could change the
-                // language of a subdocument.  Add the override field as a path component.
-                _indexedPaths.addPathComponent(ftsSpec.languageOverrideField());
-            }
+        if (descriptor->getAccessMethodName() != IndexNames::TEXT &&
+            descriptor->infoObj().hasField("expireAfterSeconds")) {
+            _hasTTLIndex = true;
         }
 
-        // handle partial indexes
-        const IndexCatalogEntry* entry = i.catalogEntry(descriptor);
-        const MatchExpression* filter = entry->getFilterExpression();
-        if (filter) {
-            unordered_set<std::string> paths;
-            QueryPlannerIXSelect::getFields(filter, "", &paths);
-            for (auto it = paths.begin(); it != paths.end(); ++it) {
-                _indexedPaths.addPath(*it);
-            }
-        }
+        addIndexedPaths(descriptor, entry, &_indexedPaths);
+        addIndexedPaths(descriptor, entry, &_indexedPathsByIndex[descriptor]);
     }
 
     TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
@@ -213,7 +237,12 @@ void CollectionInfoCache::addedIndex(OperationContext* opCtx, const IndexDescrip
     invariant(opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_X));
     invariant(desc);
 
-    rebuildIndexData(opCtx);
+    // A new index can only change the plans of queries on its fields, so the rest of the plan
+    // cache is kept.
+    const size_t numRemoved = _planCache->removeEntriesAffectedByIndex(desc->keyPattern());
+    LOG(1) << _collection->ns().ns() << ": removed " << numRemoved
+           << " plan cache entries that may use new index " << desc->indexName();
+    updateIndexData(opCtx);
 
     _indexUsageTracker.registerIndex(desc->indexName(), desc->keyPattern());
 }
@@ -228,7 +257,11 @@ void CollectionInfoCache::droppedIndex(OperationContext* opCtx, StringData index
 
 void CollectionInfoCache::rebuildIndexData(OperationContext* opCtx) {
     clearQueryCache();
+    updateIndexData(opCtx);
+}
 
+void CollectionInfoCache::updateIndexData(OperationContext* opCtx) {
+    invalidateIndexEntries();
     _keysComputed = false;
     computeIndexKeys(opCtx);
     updatePlanCacheIndexEntries(opCtx);
@@ -237,4 +270,58 @@ void CollectionInfoCache::rebuildIndexData(OperationContext* opCtx) {
 CollectionIndexUsageMap CollectionInfoCache::getIndexUsageStats() const {
     return _indexUsageTracker.getUsageStats();
 }
+
+std::shared_ptr<const std::vector<IndexEntry>> CollectionInfoCache::getIndexEntries(
+    OperationContext* opCtx) {
+    // Descriptors are replaced whenever an index is created, dropped or has its definition
+    // changed, so comparing them is enough to tell whether the snapshot is still current.
+    std::vector<const IndexDescriptor*> descriptors;
+    std::vector<const IndexCatalogEntry*> catalogEntries;
+    IndexCatalog::IndexIterator ii = _collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (ii.more()) {
+        const IndexDescriptor* desc = ii.next();
+        descriptors.push_back(desc);
+        catalogEntries.push_back(ii.catalogEntry(desc));
+    }
+
+    uint64_t version;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_indexEntriesMutex);
+        if (_indexEntries && _indexEntriesDescriptors == descriptors) {
+            return _indexEntries;
+        }
+        version = _indexEntriesVersion;
+    }
+
+    auto indexEntries = std::make_shared<std::vector<IndexEntry>>();
+    indexEntries->reserve(descriptors.size());
+    for (size_t i = 0; i < descriptors.size(); ++i) {
+        const IndexDescriptor* desc = descriptors[i];
+        const IndexCatalogEntry* ice = catalogEntries[i];
+        indexEntries->emplace_back(desc->keyPattern(),
+                                   desc->getAccessMethodName(),
+                                   desc->isMultikey(opCtx),
+                                   ice->getMultikeyPaths(opCtx),
+                                   desc->isSparse(),
+                                   desc->unique(),
+                                   desc->indexName(),
+                                   ice->getFilterExpression(),
+                                   desc->infoObj(),
+                                   ice->getCollator());
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_indexEntriesMutex);
+    if (version == _indexEntriesVersion) {
+        _indexEntries = indexEntries;
+        _indexEntriesDescriptors = std::move(descriptors);
+    }
+    return indexEntries;
+}
+
+void CollectionInfoCache::invalidateIndexEntries() {
+    stdx::lock_guard<stdx::mutex> lk(_indexEntriesMutex);
+    ++_indexEntriesVersion;
+    _indexEntries.reset();
+    _indexEntriesDescriptors.clear();
+}
 }
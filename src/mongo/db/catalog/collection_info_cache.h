@@ -30,10 +30,16 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <vector>
+
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/db/query/index_entry.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
@@ -66,6 +72,14 @@ public:
     */
     const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const;
 
+    /**
+     * Returns the paths indexed by 'desc' alone, in the same form as the overload above, or
+     * nullptr if they are not known. In that case callers must assume that any update affects the
+     * index.
+     */
+    const UpdateIndexData* getIndexKeys(OperationContext* opCtx,
+                                        const IndexDescriptor* desc) const;
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
@@ -75,6 +89,21 @@ public:
      */
     CollectionIndexUsageMap getIndexUsageStats() const;
 
+    /**
+     * Returns an IndexEntry for each ready index of the collection, as used by the query planner.
+     * The same immutable snapshot is shared by every caller until the set of indexes or the
+     * multikey state of one of them changes, so that planning a query doesn't rebuild it.
+     *
+     * Must be called with at least a shared collection lock.
+     */
+    std::shared_ptr<const std::vector<IndexEntry>> getIndexEntries(OperationContext* opCtx);
+
+    /**
+     * Discards the snapshot returned by getIndexEntries(). Must be called once an index's
+     * in-memory multikey state has changed.
+     */
+    void invalidateIndexEntries();
+
     /**
      * Builds internal cache state based on the current state of the Collection's IndexCatalog
      */
@@ -114,6 +143,9 @@ private:
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
 
+    // The same paths, split up by index.
+    std::map<const IndexDescriptor*, UpdateIndexData> _indexedPathsByIndex;
+
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
 
@@ -124,6 +156,18 @@ private:
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
 
+    // Protects the snapshot of planner index entries, which may be invalidated by writers holding
+    // only an intent lock on the collection.
+    stdx::mutex _indexEntriesMutex;
+    std::shared_ptr<const std::vector<IndexEntry>> _indexEntries;
+
+    // The descriptors the snapshot was built from, to detect index catalog changes.
+    std::vector<const IndexDescriptor*> _indexEntriesDescriptors;
+
+    // Incremented on each invalidation, so that a snapshot built concurrently with one is not
+    // kept.
+    uint64_t _indexEntriesVersion = 0;
+
     void computeIndexKeys(OperationContext* opCtx);
     void updatePlanCacheIndexEntries(OperationContext* opCtx);
 
@@ -133,6 +177,11 @@ private:
      */
     void rebuildIndexData(OperationContext* opCtx);
 
+    /**
+     * Like rebuildIndexData(), but leaves the cached query plans in place.
+     */
+    void updateIndexData(OperationContext* opCtx);
+
     bool _hasTTLIndex = false;
 };
 
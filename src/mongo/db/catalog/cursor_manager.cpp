@@ -321,50 +321,53 @@ void CursorManager::invalidateAll(bool collectionGoingAway, const std::string& r
         }
         _nonCachedExecutors.clear();
 
-        if (collectionGoingAway) {
-            // we're going to wipe out the world
-            for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-                ClientCursor* cc = i->second;
+        for (auto&& partition : _partitions) {
+            stdx::lock_guard<SimpleMutex> partitionLk(partition.mutex);
 
-                cc->kill();
+            if (collectionGoingAway) {
+                // we're going to wipe out the world
+                for (CursorMap::const_iterator i = partition.cursors.begin();
+                     i != partition.cursors.end();
+                     ++i) {
+                    ClientCursor* cc = i->second;
 
-                // If the CC is pinned, somebody is actively using it and we do not delete it.
-                // Instead we notify the holder that we killed it.  The holder will then delete the
-                // CC.
-                //
-                // If the CC is not pinned, there is nobody actively holding it.  We can safely
-                // delete it.
-                if (!cc->_isPinned) {
-                    toDelete.push_back(cc);
+                    cc->kill();
+
+                    // If the CC is pinned, somebody is actively using it and we do not delete it.
+                    // Instead we notify the holder that we killed it.  The holder will then delete
+                    // the CC.
+                    //
+                    // If the CC is not pinned, there is nobody actively holding it.  We can safely
+                    // delete it.
+                    if (!cc->_isPinned) {
+                        toDelete.push_back(cc);
+                    }
                 }
+                continue;
             }
-        } else {
-            CursorMap newMap;
 
             // collection will still be around, just all PlanExecutors are invalid
-            for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
+            for (CursorMap::iterator i = partition.cursors.begin(); i != partition.cursors.end();) {
                 ClientCursor* cc = i->second;
 
                 // Note that a valid ClientCursor state is "no cursor no executor."  This is because
                 // the set of active cursor IDs in ClientCursor is used as representation of query
                 // state.
                 if (!cc->getExecutor()) {
-                    newMap.insert(*i);
+                    ++i;
                     continue;
                 }
 
                 if (cc->_isPinned) {
                     // Pinned cursors need to stay alive, so we leave them around.
-                    if (cc->getExecutor())
-                        cc->getExecutor()->kill(reason);
-                    newMap.insert(*i);
+                    cc->getExecutor()->kill(reason);
+                    ++i;
                 } else {
                     cc->kill();
                     toDelete.push_back(cc);
+                    i = partition.cursors.erase(i);
                 }
             }
-
-            _cursors = newMap;
         }
     }
 
@@ -394,10 +397,15 @@ void CursorManager::invalidateDocument(OperationContext* opCtx,
         exec->invalidate(opCtx, dl, type);
     }
 
-    for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        PlanExecutor* exec = i->second->getExecutor();
-        if (exec) {
-            exec->invalidate(opCtx, dl, type);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> partitionLk(partition.mutex);
+
+        for (CursorMap::const_iterator i = partition.cursors.begin(); i != partition.cursors.end();
+             ++i) {
+            PlanExecutor* exec = i->second->getExecutor();
+            if (exec) {
+                exec->invalidate(opCtx, dl, type);
+            }
         }
     }
 }
@@ -405,26 +413,25 @@ void CursorManager::invalidateDocument(OperationContext* opCtx,
 std::size_t CursorManager::timeoutCursors(int millisSinceLastCall) {
     vector<ClientCursor*> toDelete;
 
-    {
-        stdx::lock_guard<SimpleMutex> lk(_mutex);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> partitionLk(partition.mutex);
 
-        for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
+        for (CursorMap::iterator i = partition.cursors.begin(); i != partition.cursors.end();) {
             ClientCursor* cc = i->second;
             // shouldTimeout() ensures that we skip pinned cursors.
-            if (cc->shouldTimeout(millisSinceLastCall))
+            if (cc->shouldTimeout(millisSinceLastCall)) {
+                cc->kill();
                 toDelete.push_back(cc);
-        }
-
-        for (vector<ClientCursor*>::const_iterator i = toDelete.begin(); i != toDelete.end(); ++i) {
-            ClientCursor* cc = *i;
-            _deregisterCursor_inlock(cc);
-            cc->kill();
+                i = partition.cursors.erase(i);
+            } else {
+                ++i;
+            }
         }
     }
 
-    // ClientCursors must be destroyed without holding '_mutex'. This is because the destruction of
-    // a ClientCursor may itself require accessing this CursorManager (e.g. when deregistering a
-    // non-cached PlanExecutor).
+    // ClientCursors must be destroyed without holding any of the partitions' mutexes. This is
+    // because the destruction of a ClientCursor may itself require accessing this CursorManager
+    // (e.g. when deregistering a non-cached PlanExecutor).
     for (auto* cursor : toDelete) {
         delete cursor;
     }
@@ -444,9 +451,10 @@ void CursorManager::deregisterExecutor(PlanExecutor* exec) {
 }
 
 StatusWith<ClientCursorPin> CursorManager::pinCursor(CursorId id) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorMap::const_iterator it = _cursors.find(id);
-    if (it == _cursors.end()) {
+    auto& partition = _getPartition(id);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    CursorMap::const_iterator it = partition.cursors.find(id);
+    if (it == partition.cursors.end()) {
         return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
     }
 
@@ -457,60 +465,75 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(CursorId id) {
 }
 
 void CursorManager::unpin(ClientCursor* cursor) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    stdx::lock_guard<SimpleMutex> lk(_getPartition(cursor->cursorid()).mutex);
 
     invariant(cursor->_isPinned);
     cursor->_isPinned = false;
 }
 
 void CursorManager::getCursorIds(std::set<CursorId>* openCursors) const {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-    for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        ClientCursor* cc = i->second;
-        openCursors->insert(cc->cursorid());
+        for (CursorMap::const_iterator i = partition.cursors.begin(); i != partition.cursors.end();
+             ++i) {
+            ClientCursor* cc = i->second;
+            openCursors->insert(cc->cursorid());
+        }
     }
 }
 
 size_t CursorManager::numCursors() const {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    return _cursors.size();
+    size_t count = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        count += partition.cursors.size();
+    }
+    return count;
 }
 
-CursorId CursorManager::_allocateCursorId_inlock() {
+CursorId CursorManager::_allocateCursorId(stdx::unique_lock<SimpleMutex>* partitionLock) {
     for (int i = 0; i < 10000; i++) {
         // The leading two bits of a CursorId are used to determine if the cursor is registered on
         // the global cursor manager.
         CursorId id;
-        if (isGlobalManager()) {
-            // This is the global cursor manager, so generate a random number and make sure the
-            // first two bits are 01.
-            uint64_t mask = 0x3FFFFFFFFFFFFFFF;
-            uint64_t bitToSet = 1ULL << 62;
-            id = ((_random->nextInt64() & mask) | bitToSet);
-        } else {
-            // The first 2 bits are 0, the next 30 bits are the collection identifier, the next 32
-            // bits are random.
-            uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
-            id = cursorIdFromParts(_collectionCacheRuntimeId, myPart);
+        {
+            stdx::lock_guard<SimpleMutex> lk(_mutex);
+            if (isGlobalManager()) {
+                // This is the global cursor manager, so generate a random number and make sure
+                // the first two bits are 01.
+                uint64_t mask = 0x3FFFFFFFFFFFFFFF;
+                uint64_t bitToSet = 1ULL << 62;
+                id = ((_random->nextInt64() & mask) | bitToSet);
+            } else {
+                // The first 2 bits are 0, the next 30 bits are the collection identifier, the
+                // next 32 bits are random.
+                uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
+                id = cursorIdFromParts(_collectionCacheRuntimeId, myPart);
+            }
         }
-        if (_cursors.count(id) == 0)
+
+        auto& partition = _getPartition(id);
+        stdx::unique_lock<SimpleMutex> lk(partition.mutex);
+        if (partition.cursors.count(id) == 0) {
+            *partitionLock = std::move(lk);
             return id;
+        }
     }
     fassertFailed(17360);
 }
 
 ClientCursorPin CursorManager::registerCursor(ClientCursorParams&& cursorParams) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorId cursorId = _allocateCursorId_inlock();
+    stdx::unique_lock<SimpleMutex> lk;
+    CursorId cursorId = _allocateCursorId(&lk);
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
         new ClientCursor(std::move(cursorParams), this, cursorId));
     return _registerCursor_inlock(std::move(clientCursor));
 }
 
 ClientCursorPin CursorManager::registerRangePreserverCursor(const Collection* collection) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorId cursorId = _allocateCursorId_inlock();
+    stdx::unique_lock<SimpleMutex> lk;
+    CursorId cursorId = _allocateCursorId(&lk);
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
         new ClientCursor(collection, this, cursorId));
     return _registerCursor_inlock(std::move(clientCursor));
@@ -521,14 +544,14 @@ ClientCursorPin CursorManager::_registerCursor_inlock(
     CursorId cursorId = clientCursor->cursorid();
     invariant(cursorId);
 
-    // Transfer ownership of the cursor to '_cursors'.
+    // Transfer ownership of the cursor to its partition.
     ClientCursor* unownedCursor = clientCursor.release();
-    _cursors[cursorId] = unownedCursor;
+    _getPartition(cursorId).cursors[cursorId] = unownedCursor;
     return ClientCursorPin(unownedCursor);
 }
 
 void CursorManager::deregisterCursor(ClientCursor* cc) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    stdx::lock_guard<SimpleMutex> lk(_getPartition(cc->cursorid()).mutex);
     _deregisterCursor_inlock(cc);
 }
 
@@ -536,10 +559,11 @@ Status CursorManager::eraseCursor(OperationContext* opCtx, CursorId id, bool sho
     ClientCursor* cursor;
 
     {
-        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        auto& partition = _getPartition(id);
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-        CursorMap::iterator it = _cursors.find(id);
-        if (it == _cursors.end()) {
+        CursorMap::iterator it = partition.cursors.find(id);
+        if (it == partition.cursors.end()) {
             if (shouldAudit) {
                 audit::logKillCursorsAuthzCheck(
                     opCtx->getClient(), _nss, id, ErrorCodes::CursorNotFound);
@@ -563,12 +587,12 @@ Status CursorManager::eraseCursor(OperationContext* opCtx, CursorId id, bool sho
         }
 
         cursor->kill();
-        _deregisterCursor_inlock(cursor);
+        partition.cursors.erase(it);
     }
 
-    // ClientCursors must be destroyed without holding '_mutex'. This is because the destruction of
-    // a ClientCursor may itself require accessing this CursorManager (e.g. when deregistering a
-    // non-cached PlanExecutor).
+    // ClientCursors must be destroyed without holding the partition's mutex. This is because the
+    // destruction of a ClientCursor may itself require accessing this CursorManager (e.g. when
+    // deregistering a non-cached PlanExecutor).
     delete cursor;
     return Status::OK();
 }
@@ -576,6 +600,6 @@ Status CursorManager::eraseCursor(OperationContext* opCtx, CursorId id, bool sho
 void CursorManager::_deregisterCursor_inlock(ClientCursor* cc) {
     invariant(cc);
     CursorId id = cc->cursorid();
-    _cursors.erase(id);
+    _getPartition(id).cursors.erase(id);
 }
 }  // namespace mongo
@@ -30,12 +30,15 @@
 
 #pragma once
 
+#include <array>
 
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/invalidation_type.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/unordered_map.h"
 #include "mongo/platform/unordered_set.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/mutex.h"
 
 namespace mongo {
@@ -67,7 +70,9 @@ class PlanExecutor;
  * cursor manager.
  *
  * The CursorManager is internally synchronized; operations on a given collection may call methods
- * concurrently on that collection's CursorManager.
+ * concurrently on that collection's CursorManager. The ClientCursors are spread by id over a number
+ * of partitions, each with its own mutex, so that operations on different cursors (such as the pin
+ * and unpin of every getMore) rarely contend with each other.
  *
  * See clientcursor.h for more information.
  */
@@ -189,8 +194,33 @@ public:
 private:
     friend class ClientCursorPin;
 
-    CursorId _allocateCursorId_inlock();
+    static const size_t kNumPartitions = 16;
+
+    typedef unordered_map<CursorId, ClientCursor*> CursorMap;
+
+    struct Partition {
+        mutable SimpleMutex mutex;
+        CursorMap cursors;
+    };
+
+    Partition& _getPartition(CursorId id) {
+        return _partitions[static_cast<uint64_t>(id) % kNumPartitions];
+    }
+
+    /**
+     * Returns an id which no registered cursor has, locking the partition it belongs to in
+     * 'partitionLock'. The new cursor must be registered before the partition is unlocked.
+     */
+    CursorId _allocateCursorId(stdx::unique_lock<SimpleMutex>* partitionLock);
+
+    /**
+     * The partition of 'cc' must be locked.
+     */
     void _deregisterCursor_inlock(ClientCursor* cc);
+
+    /**
+     * The partition of the cursor's id must be locked.
+     */
     ClientCursorPin _registerCursor_inlock(
         std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor);
 
@@ -206,12 +236,13 @@ private:
     uint32_t _collectionCacheRuntimeId;
     std::unique_ptr<PseudoRandom> _random;
 
+    // Guards '_random' and '_nonCachedExecutors'. When it is held along with the mutexes of
+    // partitions, it is taken first, and the partitions are locked in order.
     mutable SimpleMutex _mutex;
 
     typedef unordered_set<PlanExecutor*> ExecSet;
     ExecSet _nonCachedExecutors;
 
-    typedef std::map<CursorId, ClientCursor*> CursorMap;
-    CursorMap _cursors;
+    std::array<Partition, kNumPartitions> _partitions;
 };
 }  // namespace mongo
@@ -60,6 +60,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_d.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_engine.h"
@@ -298,10 +299,20 @@ void Database::getStats(OperationContext* opCtx, BSONObjBuilder* output, double
     long long nViews = 0;
     long long objects = 0;
     long long size = 0;
-    long long storageSize = 0;
-    long long numExtents = 0;
     long long indexes = 0;
-    long long indexSize = 0;
+
+    const auto maxAge = Milliseconds(storageGlobalParams.storageStatsCacheMillis.load());
+    const Date_t now = Date_t::now();
+    StorageStats storageStats;
+    bool useCachedStorageStats = false;
+    if (maxAge > Milliseconds(0)) {
+        stdx::lock_guard<stdx::mutex> lk(_storageStatsMutex);
+        if (_cachedStorageStats.computedAt != Date_t() &&
+            now - _cachedStorageStats.computedAt < maxAge) {
+            storageStats = _cachedStorageStats;
+            useCachedStorageStats = true;
+        }
+    }
 
     for (list<string>::const_iterator it = collections.begin(); it != collections.end(); ++it) {
         const string ns = *it;
@@ -313,13 +324,22 @@ void Database::getStats(OperationContext* opCtx, BSONObjBuilder* output, double
         nCollections += 1;
         objects += collection->numRecords(opCtx);
         size += collection->dataSize(opCtx);
+        indexes += collection->getIndexCatalog()->numIndexesTotal(opCtx);
+
+        if (useCachedStorageStats)
+            continue;
 
         BSONObjBuilder temp;
-        storageSize += collection->getRecordStore()->storageSize(opCtx, &temp);
-        numExtents += temp.obj()["numExtents"].numberInt();  // XXX
+        storageStats.storageSize += collection->getRecordStore()->storageSize(opCtx, &temp);
+        storageStats.numExtents += temp.obj()["numExtents"].numberInt();  // XXX
 
-        indexes += collection->getIndexCatalog()->numIndexesTotal(opCtx);
-        indexSize += collection->getIndexSize(opCtx);
+        storageStats.indexSize += collection->getIndexSize(opCtx);
+    }
+
+    if (!useCachedStorageStats && maxAge > Milliseconds(0)) {
+        storageStats.computedAt = now;
+        stdx::lock_guard<stdx::mutex> lk(_storageStatsMutex);
+        _cachedStorageStats = storageStats;
     }
 
     getViewCatalog()->iterate(opCtx, [&](const ViewDefinition& view) { nViews += 1; });
@@ -329,10 +349,10 @@ void Database::getStats(OperationContext* opCtx, BSONObjBuilder* output, double
     output->appendNumber("objects", objects);
     output->append("avgObjSize", objects == 0 ? 0 : double(size) / double(objects));
     output->appendNumber("dataSize", size / scale);
-    output->appendNumber("storageSize", storageSize / scale);
-    output->appendNumber("numExtents", numExtents);
+    output->appendNumber("storageSize", storageStats.storageSize / scale);
+    output->appendNumber("numExtents", storageStats.numExtents);
     output->appendNumber("indexes", indexes);
-    output->appendNumber("indexSize", indexSize / scale);
+    output->appendNumber("indexSize", storageStats.indexSize / scale);
 
     _dbEntry->appendExtraStats(opCtx, output, scale);
 }
@@ -396,6 +416,7 @@ Status Database::dropCollectionEvenIfSystem(OperationContext* opCtx,
     LOG(1) << "\t dropIndexes done";
 
     Top::get(opCtx->getClient()->getServiceContext()).collectionDropped(fullns.toString());
+    QueryShapeStats::get(opCtx->getServiceContext()).collectionDropped(fullns.ns());
 
     // We want to destroy the Collection object before telling the StorageEngine to destroy the
     // RecordStore.
@@ -474,6 +495,7 @@ Status Database::renameCollection(OperationContext* opCtx,
         _clearCollectionCache(opCtx, toNS, clearCacheReason);
 
         Top::get(opCtx->getClient()->getServiceContext()).collectionDropped(fromNS.toString());
+        QueryShapeStats::get(opCtx->getServiceContext()).collectionDropped(fromNS);
     }
 
     opCtx->recoveryUnit()->registerChange(new AddCollectionChange(opCtx, this, toNS));
@@ -625,6 +647,7 @@ void Database::dropDatabase(OperationContext* opCtx, Database* db) {
 
     for (auto&& coll : *db) {
         Top::get(opCtx->getClient()->getServiceContext()).collectionDropped(coll->ns().ns(), true);
+        QueryShapeStats::get(opCtx->getServiceContext()).collectionDropped(coll->ns().ns());
     }
 
     dbHolder().close(opCtx, name);
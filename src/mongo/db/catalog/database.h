@@ -40,8 +40,10 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -143,6 +145,11 @@ public:
         return _profileName.c_str();
     }
 
+    /**
+     * Appends the dbStats of this database to 'output'. The storage sizes are served from a cache
+     * while it is younger than the 'storageStatsCacheMillis' parameter; the counts are always
+     * current.
+     */
     void getStats(OperationContext* opCtx, BSONObjBuilder* output, double scale = 1);
 
     const DatabaseCatalogEntry* getDatabaseCatalogEntry() const;
@@ -232,6 +239,17 @@ private:
                                StringData fullns,
                                const std::string& reason);
 
+    /**
+     * The parts of dbStats that have to be read from the storage engine for every collection and
+     * index, which getStats() caches.
+     */
+    struct StorageStats {
+        long long storageSize = 0;
+        long long numExtents = 0;
+        long long indexSize = 0;
+        Date_t computedAt;
+    };
+
     class AddCollectionChange;
     class RemoveCollectionChange;
 
@@ -250,6 +268,10 @@ private:
     DurableViewCatalogImpl _durableViews;  // interface for system.views operations
     ViewCatalog _views;                    // in-memory representation of _durableViews
 
+    // getStats() runs under a shared database lock, so its cache has its own mutex.
+    stdx::mutex _storageStatsMutex;
+    StorageStats _cachedStorageStats;
+
     friend class Collection;
     friend class NamespaceDetails;
     friend class IndexCatalog;
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <array>
 #include <set>
 #include <string>
 
@@ -44,6 +45,11 @@ class OperationContext;
 
 /**
  * Registry of opened databases.
+ *
+ * The databases are spread over a number of partitions by name, each with its own mutex, so that
+ * looking up a database, which every operation does, does not contend on a single mutex with the
+ * operations on all other databases. Names which differ only in casing share a partition, so that
+ * a new database can be checked against them in one partition.
  */
 class DatabaseHolder {
 public:
@@ -83,11 +89,28 @@ public:
     std::set<std::string> getNamesWithConflictingCasing(StringData name);
 
 private:
-    std::set<std::string> _getNamesWithConflictingCasing_inlock(StringData name);
+    static const size_t kNumPartitions = 16;
 
     typedef StringMap<Database*> DBs;
-    mutable SimpleMutex _m;
-    DBs _dbs;
+
+    struct Partition {
+        mutable SimpleMutex mutex;
+        DBs dbs;
+    };
+
+    /**
+     * Returns the partition of the database named 'dbName', ignoring its casing.
+     */
+    Partition& _getPartition(StringData dbName);
+    const Partition& _getPartition(StringData dbName) const;
+
+    /**
+     * The mutex of 'partition' must be held.
+     */
+    static std::set<std::string> _getNamesWithConflictingCasing_inlock(const Partition& partition,
+                                                                       StringData name);
+
+    std::array<Partition, kNumPartitions> _partitions;
 };
 
 DatabaseHolder& dbHolder();
@@ -1264,17 +1264,13 @@ Status IndexCatalog::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
-    for (auto bsonRecord : bsonRecords) {
-        int64_t inserted;
-        invariant(bsonRecord.id != RecordId());
-        Status status = index->accessMethod()->insert(
-            opCtx, *bsonRecord.docPtr, bsonRecord.id, options, &inserted);
-        if (!status.isOK())
-            return status;
+    int64_t inserted;
+    Status status = index->accessMethod()->insertRecords(opCtx, bsonRecords, options, &inserted);
+    if (!status.isOK())
+        return status;
 
-        if (keysInsertedOut) {
-            *keysInsertedOut += inserted;
-        }
+    if (keysInsertedOut) {
+        *keysInsertedOut += inserted;
     }
     return Status::OK();
 }
@@ -291,6 +291,11 @@ void IndexCatalogEntry::setMultikey(OperationContext* opCtx, const MultikeyPaths
             _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
         }
     }
+
+    // Only now that the in-memory state is updated can the planner's index entries be rebuilt.
+    if (_infoCache) {
+        _infoCache->invalidateIndexEntries();
+    }
 }
 
 // ----
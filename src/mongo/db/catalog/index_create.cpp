@@ -48,12 +48,15 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/progress_meter.h"
+#include "mongo/util/queue.h"
 #include "mongo/util/quick_exit.h"
 
 namespace mongo {
@@ -89,6 +92,41 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+namespace {
+const int kMaxKeyGenerationThreads = 64;
+
+// A hybrid build applies side table entries in batches of this many, and leaves fewer than
+// kMaxSideWritesLeftForCommit of them to be applied by commit().
+const size_t kSideWritesBatchSize = 1000;
+const size_t kMaxSideWritesLeftForCommit = 1000;
+}  // namespace
+
+MONGO_EXPORT_SERVER_PARAMETER(internalIndexBuildHybridBackground, bool, false);
+
+AtomicInt32 internalIndexBuildKeyGenerationThreads(1);
+
+class ExportedIndexBuildKeyGenerationThreadsParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedIndexBuildKeyGenerationThreadsParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "internalIndexBuildKeyGenerationThreads",
+              &internalIndexBuildKeyGenerationThreads) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 1 || potentialNewValue > kMaxKeyGenerationThreads) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "internalIndexBuildKeyGenerationThreads must be "
+                                           "between 1 and "
+                                        << kMaxKeyGenerationThreads);
+        }
+
+        return Status::OK();
+    }
+
+} exportedIndexBuildKeyGenerationThreadsParameter;
+
 
 /**
  * On rollback sets MultiIndexBlock::_needToCleanup to true.
@@ -124,6 +162,151 @@ private:
     MultiIndexBlock* const _indexer;
 };
 
+/**
+ * Generates the index keys of the documents read by a foreground build's collection scan on
+ * several threads. Copies of the documents are handed to the threads in batches, round-robin,
+ * and each thread adds the keys it generates through its own shard of every index's
+ * BulkBuilder. The scan itself stays on the build's thread, as only that thread may use the
+ * OperationContext.
+ */
+class MultiIndexBlock::ParallelKeyGenerator {
+    MONGO_DISALLOW_COPYING(ParallelKeyGenerator);
+
+public:
+    ParallelKeyGenerator(MultiIndexBlock* indexer, size_t numThreads) : _indexer(indexer) {
+        for (size_t i = 0; i < numThreads; i++) {
+            _queues.push_back(stdx::make_unique<BatchQueue>(kMaxQueuedBatches));
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            _threads.emplace_back([this, i] { _generateKeys(i); });
+        }
+    }
+
+    ~ParallelKeyGenerator() {
+        if (!_threads.empty()) {
+            _failed.store(true);
+            _stop();
+        }
+    }
+
+    /**
+     * Queues a copy of 'doc' to have its keys generated. Returns the first error hit by any of
+     * the threads so far, in which case the build should be failed.
+     */
+    Status add(const BSONObj& doc, const RecordId& loc) {
+        if (_failed.load()) {
+            return _getStatus();
+        }
+
+        if (!_batch) {
+            _batch = std::make_shared<Batch>();
+        }
+        _batch->docs.emplace_back(doc.getOwned(), loc);
+        _batch->bytes += doc.objsize();
+        if (_batch->docs.size() >= kBatchSize || _batch->bytes >= kMaxBatchBytes) {
+            _flush();
+        }
+        return Status::OK();
+    }
+
+    /**
+     * Waits for the keys of every queued document to be generated, and returns the first error
+     * hit by any of the threads.
+     */
+    Status finish() {
+        _flush();
+        _stop();
+        return _getStatus();
+    }
+
+    size_t numThreads() const {
+        return _queues.size();
+    }
+
+private:
+    struct Batch {
+        std::vector<std::pair<BSONObj, RecordId>> docs;
+        size_t bytes = 0;
+    };
+
+    // A null batch tells a thread that there will be no more.
+    using BatchQueue = BlockingQueue<std::shared_ptr<Batch>>;
+
+    static const size_t kBatchSize = 256;
+    static const size_t kMaxBatchBytes = 1024 * 1024;
+    static const size_t kMaxQueuedBatches = 4;
+
+    void _flush() {
+        if (!_batch) {
+            return;
+        }
+        _queues[_nextQueue]->push(std::move(_batch));
+        _batch.reset();
+        _nextQueue = (_nextQueue + 1) % _queues.size();
+    }
+
+    void _stop() {
+        for (auto&& queue : _queues) {
+            queue->push(nullptr);
+        }
+        for (auto&& thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+    }
+
+    void _generateKeys(size_t shard) {
+        BatchQueue& queue = *_queues[shard];
+        while (auto batch = queue.blockingPop()) {
+            // Keep draining the queue after a failure, so that the scan is never blocked on it.
+            if (_failed.load()) {
+                continue;
+            }
+
+            Status status = Status::OK();
+            try {
+                for (auto&& doc : batch->docs) {
+                    status = _indexer->_insertIntoShard(shard, doc.first, doc.second);
+                    if (!status.isOK()) {
+                        break;
+                    }
+                }
+            } catch (...) {
+                status = exceptionToStatus();
+            }
+
+            if (!status.isOK()) {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                if (_status.isOK()) {
+                    _status = status;
+                }
+                _failed.store(true);
+            }
+        }
+    }
+
+    Status _getStatus() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _status;
+    }
+
+    MultiIndexBlock* const _indexer;
+
+    // One queue per thread. Each is only pushed to by the build's thread and only popped from
+    // by its own key generation thread.
+    std::vector<std::unique_ptr<BatchQueue>> _queues;
+    std::vector<stdx::thread> _threads;
+
+    // The batch being filled by add(), and the queue it goes to once full.
+    std::shared_ptr<Batch> _batch;
+    size_t _nextQueue = 0;
+
+    AtomicBool _failed{false};
+
+    stdx::mutex _mutex;
+    Status _status = Status::OK();  // The first error, guarded by _mutex.
+};
+
 MultiIndexBlock::MultiIndexBlock(OperationContext* opCtx, Collection* collection)
     : _collection(collection),
       _opCtx(opCtx),
@@ -133,6 +316,9 @@ MultiIndexBlock::MultiIndexBlock(OperationContext* opCtx, Collection* collection
       _needToCleanup(true) {}
 
 MultiIndexBlock::~MultiIndexBlock() {
+    // Stop any key generation threads before the indexes they add to are cleaned up.
+    _keyGenerator.reset();
+
     if (!_needToCleanup || _indexes.empty())
         return;
     while (true) {
@@ -207,6 +393,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
         // Any foreground indexes make all indexes be built in the foreground.
         _buildInBackground = (_buildInBackground && info["background"].trueValue());
     }
+    _buildHybrid = _buildInBackground && internalIndexBuildHybridBackground.load();
 
     std::vector<BSONObj> indexInfoObjs;
     indexInfoObjs.reserve(indexSpecs.size());
@@ -238,10 +425,15 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
         if (!status.isOK())
             return status;
 
-        if (!_buildInBackground) {
+        if (!_buildInBackground || _buildHybrid) {
             // Bulk build process requires foreground building as it assumes nothing is changing
-            // under it.
+            // under it. A hybrid build makes sure that nothing does by having concurrent writes
+            // go to a side table instead of the index.
             index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+            _eachIndexBuildMaxMemoryUsageBytes = eachIndexBuildMaxMemoryUsageBytes;
+            if (_buildHybrid) {
+                index.real->beginSideWrites();
+            }
         }
 
         const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
@@ -256,6 +448,8 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
         if (index.bulk)
             log() << "\t building index using bulk method; build may temporarily use up to "
                   << eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024 << " megabytes of RAM";
+        if (_buildHybrid)
+            log() << "\t recording concurrent writes in a side table until the bulk load is done";
 
         index.filterExpression = index.block->getEntry()->getFilterExpression();
 
@@ -295,6 +489,12 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
 
     unsigned long long n = 0;
 
+    // Nothing changes under a foreground build, so its keys can be generated away from the scan.
+    if (!_buildInBackground) {
+        generateKeysInParallel();
+    }
+    const size_t numKeyGenerationThreads = _keyGenerator ? _keyGenerator->numThreads() : 1;
+
     unique_ptr<PlanExecutor> exec(InternalPlanner::collectionScan(
         _opCtx, _collection->ns().ns(), _collection, PlanExecutor::YIELD_MANUAL));
     if (_buildInBackground) {
@@ -364,6 +564,15 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
                 WorkingSetCommon::toStatusString(objToIndex.value()),
             state == PlanExecutor::IS_EOF);
 
+    if (_keyGenerator) {
+        Status status = _finishKeyGeneration();
+        if (!status.isOK()) {
+            return status;
+        }
+        log() << "\t generated index keys for " << n << " records on " << numKeyGenerationThreads
+              << " threads. " << t.seconds() << " secs";
+    }
+
     if (MONGO_FAIL_POINT(hangAfterStartingIndexBuild)) {
         // Need the index build to hang before the progress meter is marked as finished so we can
         // reliably check that the index build has actually started in js tests.
@@ -396,12 +605,51 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
     if (!ret.isOK())
         return ret;
 
+    if (_buildHybrid) {
+        // Catch up with the writes made during the scan and bulk load while the collection can
+        // still be written to, so that there is little left to apply under the exclusive lock.
+        ret = _drainSideWrites(kMaxSideWritesLeftForCommit);
+        if (!ret.isOK())
+            return ret;
+    }
+
     log() << "build index done.  scanned " << n << " total records. " << t.seconds() << " secs";
 
     return Status::OK();
 }
 
+void MultiIndexBlock::generateKeysInParallel() {
+    invariant(!_buildInBackground);
+    invariant(!_keyGenerator);
+
+    const size_t numThreads = std::min(
+        std::max(internalIndexBuildKeyGenerationThreads.load(), 1), kMaxKeyGenerationThreads);
+    if (numThreads <= 1) {
+        return;
+    }
+
+    for (auto&& index : _indexes) {
+        // Nothing has been inserted yet, so the bulk builders can simply be replaced by sharded
+        // ones.
+        index.bulk = index.real->initiateBulk(_eachIndexBuildMaxMemoryUsageBytes, numThreads);
+    }
+    _keyGenerator = stdx::make_unique<ParallelKeyGenerator>(this, numThreads);
+}
+
+Status MultiIndexBlock::_finishKeyGeneration() {
+    if (!_keyGenerator) {
+        return Status::OK();
+    }
+    Status status = _keyGenerator->finish();
+    _keyGenerator.reset();
+    return status;
+}
+
 Status MultiIndexBlock::insert(const BSONObj& doc, const RecordId& loc) {
+    if (_keyGenerator) {
+        return _keyGenerator->add(doc, loc);
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
             continue;
@@ -421,7 +669,53 @@ Status MultiIndexBlock::insert(const BSONObj& doc, const RecordId& loc) {
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertIntoShard(size_t shard, const BSONObj& doc, const RecordId& loc) {
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
+            continue;
+        }
+
+        int64_t unused;
+        invariant(_indexes[i].bulk);
+        Status idxStatus = _indexes[i].bulk->insertIntoShard(
+            shard, _opCtx, doc, loc, _indexes[i].options, &unused);
+        if (!idxStatus.isOK())
+            return idxStatus;
+    }
+    return Status::OK();
+}
+
+Status MultiIndexBlock::_drainSideWrites(size_t maxEntriesLeft) {
+    for (auto&& index : _indexes) {
+        IndexBuildSideTable* sideTable = index.real->sideTable();
+        invariant(sideTable);
+
+        while (sideTable->size() >= maxEntriesLeft) {
+            if (_allowInterruption)
+                _opCtx->checkForInterrupt();
+
+            const auto entries = sideTable->take(kSideWritesBatchSize);
+            Status status = Status::OK();
+            MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
+                WriteUnitOfWork wunit(_opCtx);
+                status = index.real->applySideWrites(_opCtx, entries, index.options);
+                if (status.isOK())
+                    wunit.commit();
+            }
+            MONGO_WRITE_CONFLICT_RETRY_LOOP_END(
+                _opCtx, "applying side writes", _collection->ns().ns());
+            if (!status.isOK())
+                return status;
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlock::doneInserting(std::set<RecordId>* dupsOut) {
+    Status keyGenerationStatus = _finishKeyGeneration();
+    if (!keyGenerationStatus.isOK())
+        return keyGenerationStatus;
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].bulk == NULL)
             continue;
@@ -446,6 +740,17 @@ void MultiIndexBlock::abortWithoutCleanup() {
 }
 
 void MultiIndexBlock::commit() {
+    if (_buildHybrid) {
+        for (auto&& index : _indexes) {
+            // The exclusive lock keeps any more entries from being added. They are only removed
+            // once this unit of work commits, so that a retry applies them all again.
+            IndexAccessMethod* real = index.real;
+            uassertStatusOK(
+                real->applySideWrites(_opCtx, real->sideTable()->peekAll(), index.options));
+            _opCtx->recoveryUnit()->onCommit([real] { real->endSideWrites(); });
+        }
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         _indexes[i].block->success();
     }
@@ -39,6 +39,7 @@
 #include "mongo/base/status.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -47,6 +48,19 @@ class BSONObj;
 class Collection;
 class OperationContext;
 
+/**
+ * The number of threads a foreground build generates index keys on, while the collection scan
+ * runs on the build's own thread. A value of 1 generates keys on the build's thread.
+ */
+extern AtomicInt32 internalIndexBuildKeyGenerationThreads;
+
+/**
+ * Whether background builds sort the keys from their collection scan and bulk load them, rather
+ * than inserting them into the index one at a time. The keys changed by concurrent writes are
+ * recorded in a side table meanwhile, and applied after the bulk load.
+ */
+extern AtomicBool internalIndexBuildHybridBackground;
+
 /**
  * Builds one or more indexes.
  *
@@ -132,6 +146,17 @@ public:
      */
     Status insertAllDocumentsInCollection(std::set<RecordId>* dupsOut = NULL);
 
+    /**
+     * Call this after init() and before the first insert() to have the keys of the inserted
+     * documents generated on internalIndexBuildKeyGenerationThreads threads. insert() then only
+     * queues the documents, and reports the errors of earlier ones, and doneInserting() waits
+     * for all of their keys. Does nothing if only one thread is configured.
+     *
+     * Only for foreground builds. Do not call if you call insertAllDocumentsInCollection(),
+     * which does this itself.
+     */
+    void generateKeysInParallel();
+
     /**
      * Call this after init() for each document in the collection.
      *
@@ -159,6 +184,9 @@ public:
      * Marks the index ready for use. Should only be called as the last method after
      * doneInserting() or insertAllDocumentsInCollection() return success.
      *
+     * If the collection was written to during a hybrid background build, the writes remaining in
+     * the side table are applied here. This throws if one of them violates a unique constraint.
+     *
      * Should be called inside of a WriteUnitOfWork. If the index building is to be logOp'd,
      * logOp() should be called from the same unit of work as commit().
      *
@@ -189,6 +217,7 @@ public:
 private:
     class SetNeedToCleanupOnRollback;
     class CleanupIndexesVectorOnRollback;
+    class ParallelKeyGenerator;
 
     struct IndexToBuild {
         std::unique_ptr<IndexCatalog::IndexBuildBlock> block;
@@ -200,8 +229,31 @@ private:
         InsertDeleteOptions options;
     };
 
+    /**
+     * Like insert(), but adds the keys through shard number 'shard' of each index's BulkBuilder.
+     * Only valid for foreground builds, and may be called from any thread.
+     */
+    Status _insertIntoShard(size_t shard, const BSONObj& doc, const RecordId& loc);
+
+    /**
+     * Applies the writes recorded in the indexes' side tables during a hybrid build while the
+     * collection is still being written to, until fewer than 'maxEntriesLeft' remain in each.
+     */
+    Status _drainSideWrites(size_t maxEntriesLeft);
+
+    /**
+     * Waits for the keys of every document queued by insert() to be generated, if
+     * generateKeysInParallel() started threads for them, and returns their first error.
+     */
+    Status _finishKeyGeneration();
+
     std::vector<IndexToBuild> _indexes;
 
+    // Set by generateKeysInParallel(). Declared after _indexes, as its threads add to their
+    // BulkBuilders.
+    std::unique_ptr<ParallelKeyGenerator> _keyGenerator;
+    std::size_t _eachIndexBuildMaxMemoryUsageBytes = 0;
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     // Pointers not owned here and must outlive 'this'
@@ -209,6 +261,7 @@ private:
     OperationContext* _opCtx;
 
     bool _buildInBackground;
+    bool _buildHybrid = false;  // Background, but by bulk loading. Set by init().
     bool _allowInterruption;
     bool _ignoreUnique;
 
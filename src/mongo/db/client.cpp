@@ -91,6 +91,20 @@ void Client::destroy() {
     currentClient.reset(nullptr);
 }
 
+ServiceContext::UniqueClient Client::releaseCurrent() {
+    auto& client = *currentClient.getMake();
+    invariant(client);
+    invariant(!client->getOperationContext());
+    return std::move(client);
+}
+
+void Client::setCurrent(ServiceContext::UniqueClient client) {
+    invariant(client);
+    invariant(currentClient.getMake()->get() == nullptr);
+    client->_threadId = stdx::this_thread::get_id();
+    *currentClient.getMake() = std::move(client);
+}
+
 namespace {
 int64_t generateSeed(const std::string& desc) {
     size_t seed = 0;
@@ -132,6 +132,20 @@ public:
      */
     static void destroy();
 
+    /**
+     * Detaches the Client stored in TLS for the current thread and returns it to the caller. The
+     * current thread must have a Client, and must not be running an operation on its behalf.
+     *
+     * Together with setCurrent(), this allows a Client to be carried between threads when it is
+     * not bound to a dedicated thread, for example when a Session is driven asynchronously.
+     */
+    static ServiceContext::UniqueClient releaseCurrent();
+
+    /**
+     * Attaches 'client' to the current thread, which must not already have a Client.
+     */
+    static void setCurrent(ServiceContext::UniqueClient client);
+
     std::string clientAddress(bool includePort = false) const;
     const std::string& desc() const {
         return _desc;
@@ -212,7 +226,7 @@ private:
     const std::string _desc;
 
     // OS id of the thread, which owns this client
-    const stdx::thread::id _threadId;
+    stdx::thread::id _threadId;
 
     // > 0 for things "conn", 0 otherwise
     const ConnectionId _connectionId;
@@ -32,6 +32,7 @@
 
 #include "mongo/db/commands.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -72,6 +73,13 @@ namespace {
 ExportedServerParameter<bool, ServerParameterType::kStartupOnly> testCommandsParameter(
     ServerParameterSet::getGlobal(), "enableTestCommands", &Command::testCommandsEnabled);
 
+// Replies larger than this manage their own preallocation through reserveBytesForReply(), so the
+// running average is capped to keep a few huge replies from inflating every later allocation.
+const std::size_t kMaxReplyBufferSizeHint = 1024 * 1024;
+
+// Each new reply moves the running average 1/kReplySizeAverageWeight of the way to its size.
+const long long kReplySizeAverageWeight = 8;
+
 }  // namespace
 
 Command::~Command() = default;
@@ -119,6 +127,22 @@ ResourcePattern Command::parseResourcePattern(const std::string& dbname,
     return ResourcePattern::forExactNamespace(NamespaceString(ns));
 }
 
+std::size_t Command::replyBufferSizeHint() const {
+    const auto reserved = reserveBytesForReply();
+    if (reserved) {
+        return reserved;
+    }
+    return std::min<std::size_t>(_averageReplyBytes.load(), kMaxReplyBufferSizeHint);
+}
+
+void Command::recordReplySize(std::size_t bytes) {
+    // Concurrent updates may drop a sample, which is harmless since the result is only a hint.
+    const auto average = static_cast<long long>(_averageReplyBytes.load());
+    const auto sample = static_cast<long long>(bytes);
+    _averageReplyBytes.store(average ? average + (sample - average) / kReplySizeAverageWeight
+                                     : sample);
+}
+
 Command::Command(StringData name, bool webUI, StringData oldName)
     : _name(name.toString()),
       _webUI(webUI),
@@ -428,6 +452,20 @@ stdx::function<void(OperationContext*, const DBException&)> registeredRegisterEr
     [](OperationContext*, const DBException&) { fassertFailed(40357); };
 }  // namespace
 
+bool CommandFieldNameSet::insert(StringData fieldName) {
+    for (size_t i = 0; i < _numScanned; ++i) {
+        if (_scanned[i] == fieldName)
+            return false;
+    }
+
+    if (_numScanned < kMaxScannedFields) {
+        _scanned[_numScanned++] = fieldName;
+        return true;
+    }
+
+    return _hashed.try_emplace(fieldName, true).second;
+}
+
 void Command::registerRegisterError(
     stdx::function<void(OperationContext*, const DBException&)> handler) {
     registeredRegisterErrorHandler = std::move(handler);
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <string>
 #include <vector>
@@ -42,7 +43,9 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/logical_time.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/rpc/request_interface.h"
 #include "mongo/stdx/functional.h"
@@ -129,6 +132,34 @@ public:
         return 0u;
     }
 
+    /**
+     * Returns the number of bytes to preallocate for this command's reply. This is the value of
+     * reserveBytesForReply() for commands which override it, and otherwise a running average of
+     * the sizes of this command's recent replies, so that the reply buffer rarely has to be
+     * regrown while the command runs.
+     */
+    std::size_t replyBufferSizeHint() const;
+
+    /**
+     * Folds the size of a reply produced by this command into the average returned by
+     * replyBufferSizeHint().
+     */
+    void recordReplySize(std::size_t bytes);
+
+    /**
+     * Records the latency in microseconds of one execution of this command.
+     */
+    void recordLatency(uint64_t micros) {
+        _latencies.increment(micros);
+    }
+
+    /**
+     * Returns the latencies recorded by recordLatency().
+     */
+    HdrLatencyHistogram getLatencies() const {
+        return _latencies.snapshot();
+    }
+
     /* run the given command
        implement this...
 
@@ -246,7 +277,7 @@ public:
     /* Return true if a replica set secondary should go into "recovering"
        (unreadable) state while running this command.
      */
-    virtual bool maintenanceMode() const {
+    virtual bool maintenanceMode(const BSONObj& cmdObj) const {
         return false;
     }
 
@@ -506,6 +537,12 @@ private:
     ServerStatusMetricField<Counter64> _commandsExecutedMetric;
     ServerStatusMetricField<Counter64> _commandsFailedMetric;
 
+    // Running average of the size of this command's replies, in bytes.
+    AtomicUInt64 _averageReplyBytes;
+
+    // Latencies of the executions of this command.
+    ShardedHdrLatencyHistogram _latencies;
+
     friend void mongo::execCommandClient(OperationContext* opCtx,
                                          Command* c,
                                          int queryOptions,
@@ -519,4 +556,30 @@ private:
                                            rpc::ReplyBuilderInterface* replyBuilder);
 };
 
+/**
+ * The set of top-level field names seen so far while iterating over a command object, used to
+ * reject commands which repeat a field. Commands have only a handful of fields, which are compared
+ * against each other in place; only the fields beyond those are copied into a hash table.
+ */
+class CommandFieldNameSet {
+    MONGO_DISALLOW_COPYING(CommandFieldNameSet);
+
+public:
+    CommandFieldNameSet() = default;
+
+    /**
+     * Adds 'fieldName' to the set, returning false if it was already there. The field name must
+     * stay valid for the life of the set.
+     */
+    bool insert(StringData fieldName);
+
+private:
+    static const size_t kMaxScannedFields = 16;
+
+    std::array<StringData, kMaxScannedFields> _scanned;
+    size_t _numScanned = 0;
+
+    StringMap<bool> _hashed;
+};
+
 }  // namespace mongo
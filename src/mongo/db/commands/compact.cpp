@@ -43,10 +43,13 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builder.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/util/log.h"
+#include "mongo/util/progress_meter.h"
 
 namespace mongo {
 
@@ -64,8 +67,9 @@ public:
     virtual bool slaveOk() const {
         return true;
     }
-    virtual bool maintenanceMode() const {
-        return true;
+    virtual bool maintenanceMode(const BSONObj& cmdObj) const {
+        // An online compact leaves the collection available, so the node stays readable.
+        return !cmdObj["online"].trueValue();
     }
     virtual void addRequiredPrivileges(const std::string& dbname,
                                        const BSONObj& cmdObj,
@@ -82,7 +86,12 @@ public:
                 "  [paddingFactor:<num>], [paddingBytes:<num>] }\n"
                 "  force - allows to run on a replica set primary\n"
                 "  validate - check records are noncorrupt before adding to newly compacting "
-                "extents. slower but safer (defaults to true in this version)\n";
+                "extents. slower but safer (defaults to true in this version)\n"
+                "{ compact : <collection_name>, online:true, [chunkSeconds:<num>],\n"
+                "  [throttleMillis:<num>] }\n"
+                "  online - compact in place under intent locks, without blocking the database\n"
+                "  chunkSeconds - how long each step of an online compact runs (default 1)\n"
+                "  throttleMillis - pause between the steps of an online compact (default 100)\n";
     }
     CompactCmd() : Command("compact") {}
 
@@ -94,6 +103,10 @@ public:
                      BSONObjBuilder& result) {
         NamespaceString nss = parseNsCollectionRequired(db, cmdObj);
 
+        if (cmdObj["online"].trueValue()) {
+            return appendCommandStatus(result, _runOnline(opCtx, nss, cmdObj, &result));
+        }
+
         repl::ReplicationCoordinator* replCoord = repl::getGlobalReplicationCoordinator();
         if (replCoord->getMemberState().primary() && !cmdObj["force"].trueValue()) {
             errmsg =
@@ -177,6 +190,120 @@ public:
 
         return true;
     }
+
+private:
+    /**
+     * Compacts the collection and then each of its indexes in place, 'chunkSeconds' of work at a
+     * time. Each step holds only intent locks, and the locks are released for 'throttleMillis'
+     * between steps, which yields to other operations and bounds the I/O spent on the compact.
+     */
+    static Status _runOnline(OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             const BSONObj& cmdObj,
+                             BSONObjBuilder* result) {
+        if (!nss.isNormal() || nss.isSystem()) {
+            return {ErrorCodes::InvalidNamespace,
+                    str::stream() << "can't compact namespace " << nss.ns()};
+        }
+
+        long long chunkSeconds = 1;
+        if (cmdObj.hasElement("chunkSeconds")) {
+            chunkSeconds = cmdObj["chunkSeconds"].numberLong();
+            if (chunkSeconds < 1 || chunkSeconds > 3600) {
+                return {ErrorCodes::BadValue, "chunkSeconds must be between 1 and 3600"};
+            }
+        }
+
+        long long throttleMillis = 100;
+        if (cmdObj.hasElement("throttleMillis")) {
+            throttleMillis = cmdObj["throttleMillis"].numberLong();
+            if (throttleMillis < 0 || throttleMillis > 60 * 1000) {
+                return {ErrorCodes::BadValue, "throttleMillis must be between 0 and 60000"};
+            }
+        }
+
+        // The record store, named by the empty string, and then the ready indexes.
+        std::vector<std::string> tables{""};
+        long long sizeBefore = 0;
+        {
+            AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+            Collection* collection = autoColl.getCollection();
+            if (!collection) {
+                return {ErrorCodes::NamespaceNotFound, "collection does not exist"};
+            }
+
+            RecordStore* rs = collection->getRecordStore();
+            if (!rs->compactSupported() || !rs->compactsInPlace()) {
+                return {ErrorCodes::CommandNotSupported,
+                        str::stream() << "online compact is not supported by " << rs->name()};
+            }
+
+            IndexCatalog::IndexIterator ii(
+                collection->getIndexCatalog()->getIndexIterator(opCtx, false));
+            while (ii.more()) {
+                tables.push_back(ii.next()->indexName());
+            }
+            sizeBefore = rs->storageSize(opCtx) + collection->getIndexSize(opCtx);
+        }
+
+        log() << "online compact " << nss.ns() << " begin, chunkSeconds: " << chunkSeconds
+              << ", throttleMillis: " << throttleMillis;
+
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        ProgressMeterHolder pm(CurOp::get(opCtx)->setMessage_inlock(
+            "compact: online", "Compact Progress", tables.size()));
+        lk.unlock();
+
+        long long sizeAfter = 0;
+        for (const auto& table : tables) {
+            while (true) {
+                opCtx->checkForInterrupt();
+
+                StatusWith<bool> done = true;
+                {
+                    AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+                    Collection* collection = autoColl.getCollection();
+                    if (!collection) {
+                        return {ErrorCodes::NamespaceNotFound,
+                                "collection was dropped during the compact"};
+                    }
+
+                    if (table.empty()) {
+                        done = collection->getRecordStore()->compactIncrementally(
+                            opCtx, Seconds(chunkSeconds));
+                    } else {
+                        IndexCatalog* indexCatalog = collection->getIndexCatalog();
+                        // An index dropped since the compact began is skipped.
+                        IndexDescriptor* desc = indexCatalog->findIndexByName(opCtx, table);
+                        if (desc) {
+                            done = indexCatalog->getIndex(desc)->compactIncrementally(
+                                opCtx, Seconds(chunkSeconds));
+                        }
+                    }
+
+                    sizeAfter = collection->getRecordStore()->storageSize(opCtx) +
+                        collection->getIndexSize(opCtx);
+                }
+
+                if (!done.isOK()) {
+                    return done.getStatus();
+                }
+                if (done.getValue()) {
+                    break;
+                }
+
+                opCtx->sleepFor(Milliseconds(throttleMillis));
+            }
+            pm.hit();
+        }
+        pm.finished();
+
+        const long long bytesFreed = std::max(sizeBefore - sizeAfter, 0LL);
+        log() << "online compact " << nss.ns() << " end, bytesFreed: " << bytesFreed;
+
+        result->appendNumber("bytesFreed", bytesFreed);
+        return Status::OK();
+    }
 };
 static CompactCmd compactCmd;
 }
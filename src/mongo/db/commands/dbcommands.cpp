@@ -294,7 +294,7 @@ public:
     virtual bool slaveOk() const {
         return true;
     }
-    virtual bool maintenanceMode() const {
+    virtual bool maintenanceMode(const BSONObj& cmdObj) const {
         return true;
     }
     virtual void help(stringstream& help) const {
@@ -1391,7 +1391,7 @@ StatusWith<repl::ReadConcernArgs> _extractReadConcern(const BSONObj& cmdObj,
 bool Command::run(OperationContext* opCtx,
                   const rpc::RequestInterface& request,
                   rpc::ReplyBuilderInterface* replyBuilder) {
-    auto bytesToReserve = reserveBytesForReply();
+    auto bytesToReserve = replyBufferSizeHint();
 
 // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in conjunction with the
 // additional memory pressure introduced by reply buffer pre-allocation, causes the concurrency
@@ -1417,7 +1417,8 @@ bool Command::run(OperationContext* opCtx,
         return result;
     }
 
-    Status rcStatus = waitForReadConcern(opCtx, readConcernArgsStatus.getValue());
+    Status rcStatus =
+        waitForReadConcern(opCtx, readConcernArgsStatus.getValue(), supportsReadConcern());
     if (!rcStatus.isOK()) {
         if (rcStatus == ErrorCodes::ExceededTimeLimit) {
             const int debugLevel =
@@ -1515,6 +1516,7 @@ bool Command::run(OperationContext* opCtx,
     }
 
     inPlaceReplyBob.doneFast();
+    recordReplySize(inPlaceReplyBob.len());
 
     BSONObjBuilder metadataBob;
     appendReplyMetadata(opCtx, request, &metadataBob);
@@ -1559,7 +1561,7 @@ void mongo::execCommandDatabase(OperationContext* opCtx,
         BSONElement shardVersionFieldIdx;
         BSONElement queryOptionMaxTimeMSField;
 
-        StringMap<int> topLevelFields;
+        CommandFieldNameSet topLevelFields;
         for (auto&& element : request.getCommandArgs()) {
             StringData fieldName = element.fieldNameStringData();
             if (fieldName == QueryRequest::cmdOptionMaxTimeMS) {
@@ -1575,7 +1577,7 @@ void mongo::execCommandDatabase(OperationContext* opCtx,
             uassert(ErrorCodes::FailedToParse,
                     str::stream() << "Parsed command object contains duplicate top level key: "
                                   << fieldName,
-                    topLevelFields[fieldName]++ == 0);
+                    topLevelFields.insert(fieldName));
         }
 
         if (Command::isHelpRequest(helpField)) {
@@ -1635,7 +1637,7 @@ void mongo::execCommandDatabase(OperationContext* opCtx,
             LOG(2) << "command: " << request.getCommandName();
         }
 
-        if (command->maintenanceMode()) {
+        if (command->maintenanceMode(request.getCommandArgs())) {
             mmSetter.reset(new MaintenanceModeSetter);
         }
 
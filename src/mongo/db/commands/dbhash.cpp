@@ -36,6 +36,7 @@
 
 #include <map>
 #include <string>
+#include <third_party/murmurhash3/MurmurHash3.h>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
@@ -101,6 +102,18 @@ public:
             }
         }
 
+        // With 'rangeSize', the documents of each collection are also hashed in ranges of about
+        // that many, split at _id values picked by their own hash so that the ranges of two
+        // members line up even where their documents differ.
+        long long rangeSize = 0;
+        if (BSONElement rangeSizeElt = cmdObj["rangeSize"]) {
+            if (!rangeSizeElt.isNumber() || rangeSizeElt.numberLong() <= 0) {
+                errmsg = "rangeSize has to be a positive number";
+                return false;
+            }
+            rangeSize = rangeSizeElt.numberLong();
+        }
+
         list<string> colls;
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
@@ -132,6 +145,7 @@ public:
                                                                             "system.views"};
 
 
+        BSONObjBuilder rangesBuilder;
         BSONObjBuilder bb(result.subobjStart("collections"));
         for (list<string>::iterator i = colls.begin(); i != colls.end(); i++) {
             string fullCollectionName = *i;
@@ -151,7 +165,14 @@ public:
                 continue;
 
             bool fromCache = false;
-            string hash = _hashCollection(opCtx, db, fullCollectionName, &fromCache);
+            string hash;
+            if (rangeSize) {
+                BSONArrayBuilder ranges(rangesBuilder.subarrayStart(shortCollectionName));
+                hash = _hashCollection(
+                    opCtx, db, fullCollectionName, &fromCache, rangeSize, &ranges);
+            } else {
+                hash = _hashCollection(opCtx, db, fullCollectionName, &fromCache);
+            }
 
             bb.append(shortCollectionName, hash);
 
@@ -166,6 +187,9 @@ public:
         string hash = digestToString(d);
 
         result.append("md5", hash);
+        if (rangeSize) {
+            result.append("ranges", rangesBuilder.done());
+        }
         result.appendNumber("timeMillis", timer.millis());
 
         result.append("fromCache", cached);
@@ -195,15 +219,45 @@ private:
         return ns.isConfigDB();
     }
 
+    /**
+     * Returns whether the document with _id 'id' starts a new range, of 'rangeSize' documents on
+     * average.
+     */
+    static bool _startsRange(const BSONElement& id, long long rangeSize) {
+        uint32_t hash;
+        MurmurHash3_x86_32(id.value(), id.valuesize(), 0, &hash);
+        return hash % static_cast<unsigned long long>(rangeSize) == 0;
+    }
+
+    static void _appendRange(BSONArrayBuilder* ranges,
+                             const BSONObj& minId,
+                             long long count,
+                             md5_state_t* st) {
+        md5digest d;
+        md5_finish(st, d);
+
+        BSONObjBuilder range(ranges->subobjStart());
+        range.appendAs(minId.firstElement(), "min");
+        range.appendNumber("count", count);
+        range.append("md5", digestToString(d));
+    }
+
+    /**
+     * If 'ranges' is given, also appends to it the hashes of the ranges of about 'rangeSize'
+     * documents of a collection with an _id index, each as {min: <first _id>, count, md5}.
+     */
     std::string _hashCollection(OperationContext* opCtx,
                                 Database* db,
                                 const std::string& fullCollectionName,
-                                bool* fromCache) {
+                                bool* fromCache,
+                                long long rangeSize = 0,
+                                BSONArrayBuilder* ranges = nullptr) {
         stdx::unique_lock<stdx::mutex> cachedHashedLock(_cachedHashedMutex, stdx::defer_lock);
 
         NamespaceString ns(fullCollectionName);
 
-        if (_isCachable(ns)) {
+        // The cache only holds the hashes of whole collections.
+        if (_isCachable(ns) && !ranges) {
             cachedHashedLock.lock();
             string hash = _cachedHashed[ns.db().toString()][ns.coll().toString()];
             if (hash.size() > 0) {
@@ -238,9 +292,18 @@ private:
             return "no _id _index";
         }
 
+        // Only an _id index scan returns the documents in an order which splits into ranges.
+        if (!desc) {
+            ranges = nullptr;
+        }
+
         md5_state_t st;
         md5_init(&st);
 
+        md5_state_t rangeState;
+        BSONObj rangeMinId;
+        long long rangeCount = 0;
+
         long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
@@ -248,6 +311,20 @@ private:
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
             md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
             n++;
+
+            if (ranges) {
+                const BSONElement id = c["_id"];
+                if (rangeCount == 0 || _startsRange(id, rangeSize)) {
+                    if (rangeCount > 0) {
+                        _appendRange(ranges, rangeMinId, rangeCount, &rangeState);
+                    }
+                    md5_init(&rangeState);
+                    rangeMinId = id.wrap();
+                    rangeCount = 0;
+                }
+                md5_append(&rangeState, (const md5_byte_t*)c.objdata(), c.objsize());
+                rangeCount++;
+            }
         }
         if (PlanExecutor::IS_EOF != state) {
             warning() << "error while hashing, db dropped? ns=" << fullCollectionName;
@@ -255,6 +332,10 @@ private:
                       "Plan executor error while running dbHash command: " +
                           WorkingSetCommon::toStatusString(c));
         }
+        if (rangeCount > 0) {
+            _appendRange(ranges, rangeMinId, rangeCount, &rangeState);
+        }
+
         md5digest d;
         md5_finish(&st, d);
         string hash = digestToString(d);
@@ -53,6 +53,7 @@
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/ops/parsed_delete.h"
 #include "mongo/db/ops/parsed_update.h"
+#include "mongo/db/ops/update_driver.h"
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/explain.h"
@@ -377,6 +378,15 @@ public:
         auto curOp = CurOp::get(opCtx);
         OpDebug* opDebug = &curOp->debug();
 
+        // Concurrent findAndModify commands often conflict over the document they match, as when
+        // several workers take the first job of a queue. The update is parsed on the first attempt
+        // only and its driver reused when a write conflict retries the command. A collation is
+        // parsed into the driver, so updates with one are parsed on every attempt.
+        const UpdateDriver::Options updateDriverOptions;
+        UpdateDriver updateDriver(updateDriverOptions);
+        const bool canReuseUpdateDriver = args.getCollation().isEmpty();
+        bool updateDriverIsParsed = false;
+
         // Although usually the PlanExecutor handles WCE internally, it will throw WCEs when it is
         // executing a findAndModify. This is done to ensure that we can always match, modify, and
         // return the document under concurrency, if a matching document exists.
@@ -463,11 +473,15 @@ public:
                 const bool isExplain = false;
                 makeUpdateRequest(args, isExplain, &updateLifecycle, &request);
 
-                ParsedUpdate parsedUpdate(opCtx, &request);
+                ParsedUpdate parsedUpdate(opCtx,
+                                          &request,
+                                          canReuseUpdateDriver ? &updateDriver : nullptr,
+                                          updateDriverIsParsed);
                 Status parsedUpdateStatus = parsedUpdate.parseRequest();
                 if (!parsedUpdateStatus.isOK()) {
                     return appendCommandStatus(result, parsedUpdateStatus);
                 }
+                updateDriverIsParsed = canReuseUpdateDriver;
 
                 AutoGetOrCreateDb autoDb(opCtx, dbName, MODE_IX);
                 Lock::CollectionLock collLock(opCtx->lockState(), nsString.ns(), MODE_IX);
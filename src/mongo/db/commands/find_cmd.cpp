@@ -41,19 +41,28 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/run_aggregate.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/projection_exec.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/collection_metadata.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -62,6 +71,140 @@ namespace {
 
 const char kTermField[] = "term";
 
+/**
+ * Returns whether 'proj' only includes or only excludes fields, which ProjectionExec can apply
+ * without the parsed query. Rejects anything ParsedProjection would need to validate or interpret.
+ */
+bool isSimpleProjection(const BSONObj& proj) {
+    boost::optional<bool> include;
+    for (auto&& elt : proj) {
+        if (!elt.isNumber() && elt.type() != BSONType::Bool) {
+            return false;
+        }
+
+        auto fieldName = elt.fieldNameStringData();
+        if (fieldName.empty() || fieldName.find('$') != std::string::npos) {
+            return false;
+        }
+
+        if (fieldName == "_id") {
+            continue;
+        }
+        if (include && *include != elt.trueValue()) {
+            return false;
+        }
+        include = elt.trueValue();
+    }
+    return true;
+}
+
+/**
+ * Returns whether 'qr' reads at most one document by its _id, with none of the options, such as a
+ * sort, hint or skip, which would keep the plan getExecutorFind() chooses from being an IDHACK.
+ */
+bool isIdPointRead(const QueryRequest& qr) {
+    return CanonicalQuery::isSimpleIdQuery(qr.getFilter()) && qr.getSort().isEmpty() &&
+        qr.getHint().isEmpty() && qr.getCollation().isEmpty() && qr.getMin().isEmpty() &&
+        qr.getMax().isEmpty() && !qr.getSkip() && (!qr.getLimit() || *qr.getLimit() > 0) &&
+        (!qr.getBatchSize() || *qr.getBatchSize() > 0) && !qr.returnKey() &&
+        !qr.showRecordId() && !qr.isSnapshot() && !qr.isTailable() && !qr.isOplogReplay() &&
+        isSimpleProjection(qr.getProj());
+}
+
+/**
+ * Answers the find command 'qr', for which isIdPointRead() is true, by looking its _id up in the
+ * _id index of 'collection', fetching the document and applying the projection. Documents which
+ * this shard doesn't own are filtered out as a ShardFilterStage would.
+ *
+ * Returns false without touching 'result' if the query needs a regular plan instead, since there
+ * is no collection or it has no _id index.
+ */
+bool runIdPointRead(OperationContext* opCtx,
+                    const NamespaceString& nss,
+                    Collection* collection,
+                    const QueryRequest& qr,
+                    BSONObjBuilder* result) {
+    if (!collection) {
+        return false;
+    }
+    const IndexDescriptor* idIndex = collection->getIndexCatalog()->findIdIndex(opCtx);
+    if (!idIndex) {
+        return false;
+    }
+
+    opCtx->checkForInterrupt();
+
+    PlanSummaryStats summaryStats;
+    summaryStats.indexesUsed.insert(idIndex->indexName());
+
+    BSONObj obj;
+    bool found = false;
+    RecordId recordId = collection->getIndexCatalog()->getIndex(idIndex)->findSingle(
+        opCtx, qr.getFilter()["_id"].wrap());
+    summaryStats.totalKeysExamined = recordId.isNull() ? 0 : 1;
+
+    Snapshotted<BSONObj> doc;
+    if (!recordId.isNull() && collection->findDoc(opCtx, recordId, &doc)) {
+        summaryStats.totalDocsExamined = 1;
+        obj = doc.value();
+        found = true;
+
+        if (ShardingState::get(opCtx)->needCollectionMetadata(opCtx, nss.ns())) {
+            auto metadata = CollectionShardingState::get(opCtx, nss)->getMetadata();
+            if (metadata) {
+                ShardKeyPattern shardKeyPattern(metadata->getKeyPattern());
+                found = metadata->keyBelongsToMe(shardKeyPattern.extractShardKeyFromDoc(obj));
+            }
+        }
+    }
+
+    if (found && !qr.getProj().isEmpty()) {
+        ProjectionExec projExec(
+            qr.getProj(), nullptr, nullptr, ExtensionsCallbackDisallowExtensions());
+        WorkingSetMember member;
+        member.obj = Snapshotted<BSONObj>(SnapshotId(), obj);
+        member.transitionToOwnedObj();
+        uassertStatusOK(projExec.transform(&member));
+        obj = member.obj.value();
+    }
+
+    // Make sure the document was read at the expected collection version.
+    CollectionShardingState::get(opCtx, nss)->checkShardVersionOrThrow(opCtx);
+
+    const long long numResults = found ? 1 : 0;
+    summaryStats.nReturned = numResults;
+
+    // Fill out curop as endQueryOp() would from the stats of an IDHACK plan.
+    auto curOp = CurOp::get(opCtx);
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        curOp->setPlanSummary_inlock(std::string("IDHACK"));
+    }
+    curOp->debug().nreturned = numResults;
+    curOp->debug().cursorid = -1;
+    curOp->debug().cursorExhausted = true;
+    curOp->debug().setPlanSummaryMetrics(summaryStats);
+    collection->infoCache()->notifyOfQuery(opCtx, summaryStats.indexesUsed);
+    if (curOp->shouldDBProfile()) {
+        curOp->debug().execStats = BSON("stage"
+                                        << "IDHACK"
+                                        << "nReturned"
+                                        << numResults
+                                        << "keysExamined"
+                                        << static_cast<long long>(summaryStats.totalKeysExamined)
+                                        << "docsExamined"
+                                        << static_cast<long long>(summaryStats.totalDocsExamined));
+    }
+
+    CursorResponseBuilder firstBatch(
+        /*isInitialResponse*/ true, result, FindCommon::maxBytesPerBatch());
+    if (numResults) {
+        firstBatch.append(obj);
+    }
+    firstBatch.done(0, nss.ns());
+    return true;
+}
+
 }  // namespace
 
 /**
@@ -287,6 +430,16 @@ public:
         const int ntoskip = -1;
         beginQueryOp(opCtx, nss, cmdObj, ntoreturn, ntoskip);
 
+        // Answer reads of a single document by _id without building a CanonicalQuery or a
+        // PlanExecutor. If the namespace turns out to need a regular plan, such as when it is a
+        // view, the locks are released and the query is planned as usual.
+        if (internalQueryExecEnableIdPointReads.load() && isIdPointRead(*qr)) {
+            AutoGetCollectionOrViewForReadCommand ctx(opCtx, nss);
+            if (runIdPointRead(opCtx, nss, ctx.getCollection(), *qr, &result)) {
+                return true;
+            }
+        }
+
         // Finish the parsing step by using the QueryRequest to create a CanonicalQuery.
         ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
         auto statusWithCQ = CanonicalQuery::canonicalize(opCtx, std::move(qr), extensionsCallback);
@@ -352,11 +505,12 @@ public:
         const QueryRequest& originalQR = exec->getCanonicalQuery()->getQueryRequest();
 
         // Stream query results, adding them to a BSONArray as we go.
-        CursorResponseBuilder firstBatch(/*isInitialResponse*/ true, &result);
+        CursorResponseBuilder firstBatch(
+            /*isInitialResponse*/ true, &result, FindCommon::maxBytesPerBatch());
         BSONObj obj;
         PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
         long long numResults = 0;
-        while (!FindCommon::enoughForFirstBatch(originalQR, numResults) &&
+        while (!FindCommon::enoughForFirstBatch(originalQR, numResults, firstBatch.bytesUsed()) &&
                PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL))) {
             // If we can't fit this result inside the current batch, then we stash it for later.
             if (!FindCommon::haveSpaceForNext(obj, numResults, firstBatch.bytesUsed())) {
@@ -118,7 +118,7 @@ public:
         // The extra 1K is an artifact of how we construct batches. We consider a batch to be full
         // when it exceeds the goal batch size. In the case that we are just below the limit and
         // then read a large document, the extra 1K helps prevent a final realloc+memcpy.
-        return FindCommon::kMaxBytesToReturnToClientAtOnce + 1024u;
+        return FindCommon::maxBytesPerBatch() + 1024u;
     }
 
     /**
@@ -340,7 +340,8 @@ public:
         }
 
         CursorId respondWithId = 0;
-        CursorResponseBuilder nextBatch(/*isInitialResponse*/ false, &result);
+        CursorResponseBuilder nextBatch(
+            /*isInitialResponse*/ false, &result, FindCommon::maxBytesPerBatch());
         BSONObj obj;
         // generateBatch() will not initialize 'state' if it exceeds the time limiting generating
         // the next batch for an awaitData cursor. In this case, 'state' should be
@@ -360,31 +361,37 @@ public:
         }
 
         // If this is an await data cursor, and we hit EOF without generating any results, then
-        // we block waiting for new data to arrive.
-        if (isCursorAwaitData(cursor) && state == PlanExecutor::IS_EOF && numResults == 0) {
+        // we block waiting for new data to arrive. A notification only means that an insert was
+        // committed, which may not be visible to this cursor yet (e.g. behind an earlier oplog
+        // write still in progress), so we keep waiting while the batches come back empty rather
+        // than returning an empty batch for the client to ask for again.
+        if (isCursorAwaitData(cursor)) {
             auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+            const auto timeout = opCtx->getRemainingMaxTimeMicros();
+            bool waited = false;
+
             // Return immediately if we need to update the commit time.
-            if (!request.lastKnownCommittedOpTime ||
-                (request.lastKnownCommittedOpTime == replCoord->getLastCommittedOpTime())) {
-                // Retrieve the notifier which we will wait on until new data arrives. We make sure
-                // to do this in the lock because once we drop the lock it is possible for the
-                // collection to become invalid. The notifier itself will outlive the collection if
-                // the collection is dropped, as we keep a shared_ptr to it.
-                auto notifier = readLock->getCollection()->getCappedInsertNotifier();
-
-                // Save the PlanExecutor and drop our locks.
+            while (state == PlanExecutor::IS_EOF && numResults == 0 &&
+                   (!request.lastKnownCommittedOpTime ||
+                    (request.lastKnownCommittedOpTime == replCoord->getLastCommittedOpTime()))) {
+                const auto remaining = opCtx->getRemainingMaxTimeMicros();
+                if (waited && (remaining <= Microseconds{0} || notifier->isDead())) {
+                    break;
+                }
+
+                // Save the PlanExecutor and drop our locks. The notifier was retrieved under the
+                // lock and outlives the collection if it is dropped, as we keep a shared_ptr to
+                // it.
                 exec->saveState();
                 readLock.reset();
 
                 // Block waiting for data.
-                const auto timeout = opCtx->getRemainingMaxTimeMicros();
-                notifier->wait(notifierVersion, timeout);
-                notifier.reset();
+                notifier->wait(notifierVersion, remaining);
+                waited = true;
 
-                // Set expected latency to match wait time. This makes sure the logs aren't spammed
-                // by awaitData queries that exceed slowms due to blocking on the
-                // CappedInsertNotifier.
-                curOp->setExpectedLatencyMs(durationCount<Milliseconds>(timeout));
+                // Must get the version before we call generateBatch, as above.
+                const uint64_t prevVersion = notifierVersion;
+                notifierVersion = notifier->getVersion();
 
                 readLock.emplace(opCtx, request.nss);
                 exec->restoreState();
@@ -395,8 +402,21 @@ public:
                 if (!batchStatus.isOK()) {
                     return appendCommandStatus(result, batchStatus);
                 }
+
+                if (notifierVersion == prevVersion) {
+                    // The wait timed out.
+                    break;
+                }
+            }
+
+            if (waited) {
+                // Set expected latency to match wait time. This makes sure the logs aren't spammed
+                // by awaitData queries that exceed slowms due to blocking on the
+                // CappedInsertNotifier.
+                curOp->setExpectedLatencyMs(durationCount<Milliseconds>(timeout));
             }
         }
+        notifier.reset();
 
         PlanSummaryStats postExecutionStats;
         Explain::getSummaryStats(*exec, &postExecutionStats);
@@ -32,6 +32,8 @@
 
 #include "mongo/db/commands/mr.h"
 
+#include <pcrecpp.h>
+
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connpool.h"
@@ -66,6 +68,7 @@
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/parallel.h"
@@ -75,10 +78,12 @@
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/text.h"
 
 namespace mongo {
 
@@ -96,6 +101,10 @@ namespace dps = ::mongo::dotted_path_support;
 
 namespace mr {
 
+// Whether map and reduce functions of the forms NativeEmitMapper and NativeSumReducer recognize
+// are run without JavaScript.
+MONGO_EXPORT_SERVER_PARAMETER(mapReduceUseNativeFunctions, bool, true);
+
 AtomicUInt32 Config::JOB_NUMBER;
 
 JSFunction::JSFunction(const std::string& type, const BSONElement& e) {
@@ -273,6 +282,181 @@ void JSReducer::_reduce(const BSONList& tuples, BSONObj& key, int& endSizeEstima
     _reduce(x, key, endSizeEstimate);
 }
 
+namespace {
+
+// Largest magnitude of a JavaScript Date, in milliseconds.
+const long long kMaxJSDateMillis = 8640000000000000LL;
+
+/**
+ * Returns true if 'e' converts to a JavaScript value which converts back to the BSON that
+ * NativeEmitMapper would emit for it.
+ */
+bool emitsNatively(const BSONElement& e) {
+    switch (e.type()) {
+        case NumberDouble:
+        case NumberInt:
+        case NumberLong:
+        case NumberDecimal:
+        case Bool:
+        case jstNULL:
+        case jstOID:
+            return true;
+        case String:
+            return isValidUTF8(e.String());
+        case Date: {
+            const long long millis = e.date().toMillisSinceEpoch();
+            return millis >= -kMaxJSDateMillis && millis <= kMaxJSDateMillis;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Appends 'e' the way it comes back from JavaScript, where all numbers but NumberLong and
+ * NumberDecimal are doubles.
+ */
+void appendAsEmitted(BSONObjBuilder* builder, StringData fieldName, const BSONElement& e) {
+    if (e.type() == NumberInt) {
+        builder->append(fieldName, static_cast<double>(e.numberInt()));
+    } else {
+        builder->appendAs(e, fieldName);
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<NativeEmitMapper> NativeEmitMapper::parse(const BSONElement& code) {
+    if (code.type() != Code && code.type() != String)
+        return nullptr;
+
+    // The literal is limited to decimal integers so that it reads the same in JavaScript.
+    static const pcrecpp::RE mapRE(
+        "\\s*function\\s*[\\w$]*\\s*\\(\\s*\\)\\s*\\{"
+        "\\s*emit\\s*\\(\\s*this\\.([A-Za-z_$][\\w$]*)\\s*,"
+        "\\s*(?:this\\.([A-Za-z_$][\\w$]*)|(0|[1-9][0-9]{0,8}))\\s*\\)\\s*;?"
+        "\\s*\\}\\s*;?\\s*");
+
+    std::string keyField;
+    std::string valueField;
+    std::string valueLiteral;
+    if (!mapRE.FullMatch(code.valueStringData().toString(), &keyField, &valueField, &valueLiteral))
+        return nullptr;
+
+    if (!valueField.empty()) {
+        return stdx::make_unique<NativeEmitMapper>(
+            code, std::move(keyField), std::move(valueField), 0);
+    }
+    return stdx::make_unique<NativeEmitMapper>(
+        code, std::move(keyField), boost::none, std::stod(valueLiteral));
+}
+
+NativeEmitMapper::NativeEmitMapper(const BSONElement& code,
+                                   std::string keyField,
+                                   boost::optional<std::string> valueField,
+                                   double valueLiteral)
+    : _keyField(std::move(keyField)),
+      _valueField(std::move(valueField)),
+      _valueLiteral(valueLiteral),
+      _jsMapper(code) {}
+
+void NativeEmitMapper::init(State* state) {
+    _state = state;
+    _jsMapper.init(state);
+}
+
+void NativeEmitMapper::map(const BSONObj& o) {
+    const BSONElement key = o[_keyField];
+    const BSONElement value = _valueField ? o[*_valueField] : BSONElement();
+    if (!emitsNatively(key) || (_valueField && !emitsNatively(value))) {
+        _jsMapper.map(o);
+        return;
+    }
+
+    BSONObjBuilder b;
+    appendAsEmitted(&b, "0", key);
+    if (_valueField) {
+        appendAsEmitted(&b, "1", value);
+    } else {
+        b.append("1", _valueLiteral);
+    }
+    BSONObj args = b.obj();
+    uassert(13069,
+            "an emit can't be more than half max bson size",
+            args.objsize() < (BSONObjMaxUserSize / 2));
+    _state->emit(args);
+}
+
+std::unique_ptr<NativeSumReducer> NativeSumReducer::parse(const BSONElement& code) {
+    if (code.type() != Code && code.type() != String)
+        return nullptr;
+
+    static const pcrecpp::RE reduceRE(
+        "\\s*function\\s*[\\w$]*\\s*\\(\\s*[A-Za-z_$][\\w$]*\\s*,\\s*([A-Za-z_$][\\w$]*)\\s*\\)"
+        "\\s*\\{\\s*return\\s+Array\\.sum\\s*\\(\\s*\\1\\s*\\)\\s*;?\\s*\\}\\s*;?\\s*");
+
+    if (!reduceRE.FullMatch(code.valueStringData().toString()))
+        return nullptr;
+    return stdx::make_unique<NativeSumReducer>(code);
+}
+
+void NativeSumReducer::init(State* state) {
+    _jsReducer.init(state);
+}
+
+bool NativeSumReducer::_sum(const BSONList& tuples, double* sum) {
+    for (size_t i = 0; i < tuples.size(); ++i) {
+        BSONObjIterator j(tuples[i]);
+        j.next();
+        const BSONElement value = j.next();
+        if (value.type() != NumberDouble)
+            return false;
+        *sum = i == 0 ? value.Double() : *sum + value.Double();
+    }
+    return true;
+}
+
+BSONObj NativeSumReducer::reduce(const BSONList& tuples) {
+    if (tuples.size() <= 1)
+        return tuples[0];
+
+    double sum;
+    if (!_sum(tuples, &sum)) {
+        const long long jsReduces = _jsReducer.numReduces;
+        BSONObj res = _jsReducer.reduce(tuples);
+        numReduces += _jsReducer.numReduces - jsReduces;
+        return res;
+    }
+    ++numReduces;
+
+    BSONObjBuilder b;
+    b.appendAs(tuples[0].firstElement(), "0");
+    b.append("1", sum);
+    return b.obj();
+}
+
+BSONObj NativeSumReducer::finalReduce(const BSONList& tuples, Finalizer* finalizer) {
+    double sum;
+    if (tuples.size() == 1 || !_sum(tuples, &sum)) {
+        const long long jsReduces = _jsReducer.numReduces;
+        BSONObj res = _jsReducer.finalReduce(tuples, finalizer);
+        numReduces += _jsReducer.numReduces - jsReduces;
+        return res;
+    }
+    ++numReduces;
+
+    BSONObjBuilder b;
+    b.appendAs(tuples[0].firstElement(), "_id");
+    b.append("value", sum);
+    BSONObj res = b.obj();
+
+    if (finalizer) {
+        res = finalizer->finalize(res);
+    }
+
+    return res;
+}
+
 Config::Config(const string& _dbname, const BSONObj& cmdObj) {
     dbname = _dbname;
     uassert(ErrorCodes::TypeMismatch,
@@ -321,8 +505,20 @@ Config::Config(const string& _dbname, const BSONObj& cmdObj) {
         if (cmdObj["scope"].type() == Object)
             scopeSetup = cmdObj["scope"].embeddedObjectUserCheck();
 
-        mapper.reset(new JSMapper(cmdObj["map"]));
-        reducer.reset(new JSReducer(cmdObj["reduce"]));
+        // The native functions stand in for the emit() and Array.sum() of the global scope, so
+        // they are not used when the job can supply its own.
+        const bool useNative =
+            mapReduceUseNativeFunctions.load() && !jsMode && scopeSetup.isEmpty();
+
+        if (useNative)
+            mapper = NativeEmitMapper::parse(cmdObj["map"]);
+        if (!mapper)
+            mapper.reset(new JSMapper(cmdObj["map"]));
+
+        if (useNative)
+            reducer = NativeSumReducer::parse(cmdObj["reduce"]);
+        if (!reducer)
+            reducer.reset(new JSReducer(cmdObj["reduce"]));
         if (cmdObj["finalize"].type() && cmdObj["finalize"].trueValue())
             finalizer.reset(new JSFinalizer(cmdObj["finalize"]));
 
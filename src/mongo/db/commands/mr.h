@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -175,6 +177,75 @@ private:
     JSFunction _func;
 };
 
+// ------------  native function implementations -----------
+
+/**
+ * Runs a map function of the form
+ *     function() { emit(this.<keyField>, this.<valueField>); }
+ * or one emitting an integer literal as the value, without entering JavaScript. The emitted
+ * values are the ones the JavaScript function would produce, so a document whose key or value
+ * would not come back from JavaScript unchanged is mapped by the original function instead.
+ */
+class NativeEmitMapper : public Mapper {
+public:
+    /**
+     * Returns a mapper for 'code' if it is one of the recognized forms, otherwise nullptr.
+     */
+    static std::unique_ptr<NativeEmitMapper> parse(const BSONElement& code);
+
+    NativeEmitMapper(const BSONElement& code,
+                     std::string keyField,
+                     boost::optional<std::string> valueField,
+                     double valueLiteral);
+
+    void map(const BSONObj& o) override;
+    void init(State* state) override;
+
+    const std::string& getKeyField() const {
+        return _keyField;
+    }
+
+    const boost::optional<std::string>& getValueField() const {
+        return _valueField;
+    }
+
+private:
+    State* _state = nullptr;
+    const std::string _keyField;
+    const boost::optional<std::string> _valueField;
+    const double _valueLiteral;
+
+    JSMapper _jsMapper;
+};
+
+/**
+ * Runs a reduce function of the form
+ *     function(key, values) { return Array.sum(values); }
+ * without entering JavaScript when all of the values are doubles, adding them in the same order
+ * as Array.sum. Any other list of values is reduced by the original function.
+ */
+class NativeSumReducer : public Reducer {
+public:
+    /**
+     * Returns a reducer for 'code' if it is of the recognized form, otherwise nullptr.
+     */
+    static std::unique_ptr<NativeSumReducer> parse(const BSONElement& code);
+
+    NativeSumReducer(const BSONElement& code) : _jsReducer(code) {}
+    void init(State* state) override;
+
+    BSONObj reduce(const BSONList& tuples) override;
+    BSONObj finalReduce(const BSONList& tuples, Finalizer* finalizer) override;
+
+private:
+    /**
+     * Sums the values of 'tuples' into 'sum'. Returns false if one of them is not a double.
+     */
+    static bool _sum(const BSONList& tuples, double* sum);
+
+    JSReducer _jsReducer;
+};
+
 // -----------------
 
 
@@ -35,6 +35,7 @@
 #include <string>
 
 #include "mongo/db/json.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
 
 using namespace mongo;
@@ -254,4 +255,100 @@ TEST(ConfigTest, CollationNotAnObjectFailsToParse) {
     ASSERT_THROWS(mr::Config(dbname, cmdObj), UserException);
 }
 
+/**
+ * Returns the config of an inline mapReduce with the given functions and extra options.
+ */
+std::unique_ptr<mr::Config> makeConfig(const std::string& map,
+                                       const std::string& reduce,
+                                       const BSONObj& options = BSONObj()) {
+    BSONObjBuilder bob;
+    bob.append("mapReduce", "myCollection");
+    bob.appendCode("map", map);
+    bob.appendCode("reduce", reduce);
+    bob.append("out", BSON("inline" << 1));
+    bob.appendElements(options);
+    return stdx::make_unique<mr::Config>("myDB", bob.obj());
+}
+
+TEST(ConfigTest, RecognizesNativeEmitMapper) {
+    auto config = makeConfig("function() { emit(this.k, this.v); }", "function(k, v) {}");
+    auto mapper = dynamic_cast<mr::NativeEmitMapper*>(config->mapper.get());
+    ASSERT(mapper);
+    ASSERT_EQ(mapper->getKeyField(), "k");
+    ASSERT_EQ(*mapper->getValueField(), "v");
+
+    config = makeConfig("function map ( ) {\n  emit(this.$key,1);\n};", "function(k, v) {}");
+    mapper = dynamic_cast<mr::NativeEmitMapper*>(config->mapper.get());
+    ASSERT(mapper);
+    ASSERT_EQ(mapper->getKeyField(), "$key");
+    ASSERT_FALSE(mapper->getValueField());
+}
+
+TEST(ConfigTest, DoesNotRecognizeOtherMapFunctions) {
+    for (auto&& map : {"function() { emit(this.a.b, 1); }",
+                       "function() { emit(this.k, 1.5); }",
+                       "function() { emit(this.k, 010); }",
+                       "function() { emit(this.k, this.v); emit(this.v, 1); }",
+                       "function() { emit(this['k'], 1); }",
+                       "function(x) { emit(this.k, x); }"}) {
+        auto config = makeConfig(map, "function(k, v) {}");
+        ASSERT_FALSE(dynamic_cast<mr::NativeEmitMapper*>(config->mapper.get())) << map;
+    }
+}
+
+TEST(ConfigTest, RecognizesNativeSumReducer) {
+    auto config =
+        makeConfig("function() {}", "function(key, values) { return Array.sum(values); }");
+    ASSERT(dynamic_cast<mr::NativeSumReducer*>(config->reducer.get()));
+
+    for (auto&& reduce : {"function(key, values) { return Array.sum(key); }",
+                          "function(key, values) { return Array.sum(values) + 1; }",
+                          "function(values) { return Array.sum(values); }"}) {
+        config = makeConfig("function() {}", reduce);
+        ASSERT_FALSE(dynamic_cast<mr::NativeSumReducer*>(config->reducer.get())) << reduce;
+    }
+}
+
+TEST(ConfigTest, NativeFunctionsAreNotUsedInJSModeOrWithAScope) {
+    const std::string map = "function() { emit(this.k, this.v); }";
+    const std::string reduce = "function(k, v) { return Array.sum(v); }";
+
+    auto config = makeConfig(map, reduce, BSON("jsMode" << true));
+    ASSERT_FALSE(dynamic_cast<mr::NativeEmitMapper*>(config->mapper.get()));
+    ASSERT_FALSE(dynamic_cast<mr::NativeSumReducer*>(config->reducer.get()));
+
+    config = makeConfig(map, reduce, BSON("scope" << BSON("x" << 1)));
+    ASSERT_FALSE(dynamic_cast<mr::NativeEmitMapper*>(config->mapper.get()));
+    ASSERT_FALSE(dynamic_cast<mr::NativeSumReducer*>(config->reducer.get()));
+}
+
+TEST(NativeSumReducerTest, SumsDoublesInOrder) {
+    auto config = makeConfig("function() {}", "function(k, v) { return Array.sum(v); }");
+    auto reducer = config->reducer.get();
+
+    mr::BSONList tuples{BSON("0"
+                             << "a"
+                             << "1"
+                             << 0.1),
+                        BSON("0"
+                             << "a"
+                             << "1"
+                             << 0.2),
+                        BSON("0"
+                             << "a"
+                             << "1"
+                             << 0.3)};
+    ASSERT_BSONOBJ_EQ(reducer->reduce(tuples),
+                      BSON("0"
+                           << "a"
+                           << "1"
+                           << (0.1 + 0.2) + 0.3));
+    ASSERT_BSONOBJ_EQ(reducer->finalReduce(tuples, nullptr),
+                      BSON("_id"
+                           << "a"
+                           << "value"
+                           << (0.1 + 0.2) + 0.3));
+    ASSERT_EQ(reducer->numReduces, 2);
+}
+
 }  // namespace
@@ -182,6 +182,14 @@ public:
         (*_sections)[section->getSectionName()] = section;
     }
 
+    ServerStatusSection* findSection(StringData sectionName) const {
+        if (_sections == 0) {
+            return nullptr;
+        }
+        SectionMap::const_iterator i = _sections->find(sectionName.toString());
+        return i == _sections->end() ? nullptr : i->second;
+    }
+
 private:
     const Date_t _started;
     bool _runCalled;
@@ -197,6 +205,10 @@ ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionNa
     cmdServerStatus.addSection(this);
 }
 
+ServerStatusSection* findServerStatusSection(StringData sectionName) {
+    return cmdServerStatus.findSection(sectionName);
+}
+
 OpCounterServerStatusSection::OpCounterServerStatusSection(const string& sectionName,
                                                            OpCounters* counters)
     : ServerStatusSection(sectionName), _counters(counters) {}
@@ -296,12 +308,13 @@ public:
     }
 
     BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElement) const {
-        BSONObj result;
+        BSONObjBuilder result;
         if (getSSLManager()) {
-            result = getSSLManager()->getSSLConfiguration().getServerStatusBSON();
+            result.appendElements(getSSLManager()->getSSLConfiguration().getServerStatusBSON());
+            getSSLManager()->appendHandshakeStats(&result);
         }
 
-        return result;
+        return result.obj();
     }
 } security;
 #endif
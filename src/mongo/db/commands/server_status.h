@@ -121,4 +121,10 @@ public:
 private:
     const OpCounters* _counters;
 };
+
+/**
+ * Returns the registered section named 'sectionName', or nullptr if there is none. Sections are
+ * registered by static initialization, so this is only valid to call after it is complete.
+ */
+ServerStatusSection* findServerStatusSection(StringData sectionName);
 }
@@ -0,0 +1,213 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem/path.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/traffic_recorder.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// Directory the traffic recordings are written to. Recording is disabled when it is not set, so
+// that the commands below cannot be used to write files anywhere else.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(trafficRecordingDirectory, std::string, "");
+
+const int kMaxFileSizeMBDefault = 1024;
+const int kBufferSizeMBDefault = 64;
+
+void addTrafficRecordPrivileges(std::vector<Privilege>* out) {
+    ActionSet actions;
+    actions.addAction(ActionType::trafficRecord);
+    out->push_back(Privilege(ResourcePattern::forClusterResource(), actions));
+}
+
+/**
+ * Reads a size in megabytes from the command, which defaults to 'defaultValue'.
+ */
+StatusWith<long long> extractSizeBytes(const BSONObj& cmdObj,
+                                       StringData fieldName,
+                                       long long defaultValue) {
+    long long sizeMB;
+    Status status = bsonExtractIntegerFieldWithDefault(cmdObj, fieldName, defaultValue, &sizeMB);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (sizeMB <= 0) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << fieldName << "' must be positive, not " << sizeMB};
+    }
+
+    return sizeMB * 1024 * 1024;
+}
+
+/**
+ * Starts recording the messages received from clients.
+ *
+ * {startRecordingTraffic: 1, filename: <string>, maxFileSizeMB: <number>, bufferSizeMB: <number>}
+ *
+ * 'filename' is a file name within the directory set by the trafficRecordingDirectory parameter.
+ * See TrafficRecorder for the format of the recording, which mongotrafficreplay replays.
+ */
+class StartRecordingTrafficCommand final : public Command {
+public:
+    StartRecordingTrafficCommand() : Command("startRecordingTraffic") {}
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    void help(std::stringstream& help) const override {
+        help << "start recording the messages received from clients to a file, for replay";
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) override {
+        addTrafficRecordPrivileges(out);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int options,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
+        uassert(ErrorCodes::IllegalOperation,
+                "Traffic recording is disabled, as the trafficRecordingDirectory parameter is not "
+                "set",
+                !trafficRecordingDirectory.empty());
+
+        std::string filename;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "filename", &filename));
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "Traffic recording file name must be a plain file name, not "
+                              << filename,
+                !filename.empty() && boost::filesystem::path(filename).filename() == filename &&
+                    filename != "." && filename != "..");
+
+        TrafficRecorder::Options recorderOptions;
+        recorderOptions.filename =
+            (boost::filesystem::path(trafficRecordingDirectory) / filename).string();
+        recorderOptions.maxFileSizeBytes =
+            uassertStatusOK(extractSizeBytes(cmdObj, "maxFileSizeMB", kMaxFileSizeMBDefault));
+        recorderOptions.maxBufferedBytes =
+            uassertStatusOK(extractSizeBytes(cmdObj, "bufferSizeMB", kBufferSizeMBDefault));
+
+        uassertStatusOK(TrafficRecorder::get(opCtx->getServiceContext()).start(recorderOptions));
+        return true;
+    }
+} startRecordingTrafficCommand;
+
+/**
+ * Stops the recording started by startRecordingTraffic, and returns its statistics.
+ *
+ * {stopRecordingTraffic: 1}
+ */
+class StopRecordingTrafficCommand final : public Command {
+public:
+    StopRecordingTrafficCommand() : Command("stopRecordingTraffic") {}
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    void help(std::stringstream& help) const override {
+        help << "stop recording the messages received from clients";
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) override {
+        addTrafficRecordPrivileges(out);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int options,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(TrafficRecorder::get(opCtx->getServiceContext()).stop(&result));
+        return true;
+    }
+} stopRecordingTrafficCommand;
+
+class TrafficRecordingServerStatusSection final : public ServerStatusSection {
+public:
+    TrafficRecordingServerStatusSection() : ServerStatusSection("trafficRecording") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    void addRequiredPrivileges(std::vector<Privilege>* out) override {
+        addTrafficRecordPrivileges(out);
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        TrafficRecorder::get(opCtx->getServiceContext()).appendStats(&builder);
+        return builder.obj();
+    }
+} trafficRecordingServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
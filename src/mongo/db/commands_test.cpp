@@ -29,6 +29,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/platform/basic.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
@@ -85,4 +86,92 @@ TEST(Commands, appendOperationTime) {
 
     ASSERT_BSONOBJ_EQ(actualResult.obj(), expectedResult.obj());
 }
+
+namespace {
+
+class ReplySizeTestCommand : public Command {
+public:
+    ReplySizeTestCommand(StringData name, std::size_t bytesToReserve)
+        : Command(name), _bytesToReserve(bytesToReserve) {}
+
+    std::size_t reserveBytesForReply() const override {
+        return _bytesToReserve;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) override {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int options,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
+        return true;
+    }
+
+private:
+    const std::size_t _bytesToReserve;
+};
+
+// Commands register themselves globally, so they must outlive the tests.
+ReplySizeTestCommand averagingTestCommand("replySizeHintAveragingTestCommand", 0u);
+ReplySizeTestCommand reservingTestCommand("replySizeHintReservingTestCommand", 4096u);
+
+}  // namespace
+
+TEST(Commands, replyBufferSizeHintFollowsRecentReplies) {
+    ASSERT_EQ(averagingTestCommand.replyBufferSizeHint(), 0u);
+
+    averagingTestCommand.recordReplySize(800u);
+    ASSERT_EQ(averagingTestCommand.replyBufferSizeHint(), 800u);
+
+    // Each later reply moves the hint an eighth of the way towards its size.
+    averagingTestCommand.recordReplySize(1600u);
+    ASSERT_EQ(averagingTestCommand.replyBufferSizeHint(), 900u);
+
+    // The hint stays bounded even when replies are huge.
+    for (int i = 0; i < 200; ++i) {
+        averagingTestCommand.recordReplySize(BSONObjMaxUserSize);
+    }
+    ASSERT_EQ(averagingTestCommand.replyBufferSizeHint(), 1024u * 1024u);
+}
+
+TEST(Commands, replyBufferSizeHintPrefersExplicitReservation) {
+    reservingTestCommand.recordReplySize(100u);
+    ASSERT_EQ(reservingTestCommand.replyBufferSizeHint(), 4096u);
+}
+
+TEST(Commands, fieldNameSetDetectsRepeatedFields) {
+    CommandFieldNameSet fields;
+    ASSERT_TRUE(fields.insert("isMaster"));
+    ASSERT_TRUE(fields.insert("maxTimeMS"));
+    ASSERT_FALSE(fields.insert("isMaster"));
+    ASSERT_FALSE(fields.insert("maxTimeMS"));
+    ASSERT_TRUE(fields.insert("ismaster"));
+}
+
+TEST(Commands, fieldNameSetDetectsRepeatedFieldsBeyondTheScannedOnes) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 40; ++i) {
+        names.push_back(str::stream() << "field" << i);
+    }
+
+    CommandFieldNameSet fields;
+    for (auto&& name : names) {
+        ASSERT_TRUE(fields.insert(name));
+    }
+    for (auto&& name : names) {
+        ASSERT_FALSE(fields.insert(name));
+    }
+}
 }  // namespace mongo
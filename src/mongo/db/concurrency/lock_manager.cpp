@@ -40,6 +40,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -120,6 +121,9 @@ static const char* LockRequestStatusNames[] = {
 MONGO_STATIC_ASSERT((sizeof(LockRequestStatusNames) / sizeof(LockRequestStatusNames[0])) ==
                     LockRequest::StatusCount);
 
+// The number of requests on the conflict queues of all LockHeads, across all LockManagers.
+AtomicInt32 numWaitingRequests;
+
 }  // namespace
 
 /**
@@ -249,6 +253,7 @@ struct LockHead {
 
     // Methods to maintain the conflict queue
     void incConflictModeCount(LockMode mode) {
+        numWaitingRequests.fetchAndAdd(1);
         invariant(conflictCounts[mode] >= 0);
         if (++conflictCounts[mode] == 1) {
             invariant((conflictModes & modeMask(mode)) == 0);
@@ -257,6 +262,7 @@ struct LockHead {
     }
 
     void decConflictModeCount(LockMode mode) {
+        numWaitingRequests.fetchAndSubtract(1);
         invariant(conflictCounts[mode] >= 1);
         if (--conflictCounts[mode] == 0) {
             invariant((conflictModes & modeMask(mode)) == modeMask(mode));
@@ -404,11 +410,27 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+// Balance scalability of intent locks against potential added cost of conflicting locks, which
+// have to visit every partition holding the resource. The exact value doesn't appear very
+// important, but should be a power of two and at least twice the number of cores, so that the
+// lockers of concurrently running threads tend to land in distinct partitions.
+unsigned numPartitionsForHost() {
+    const unsigned kMinPartitions = 32;
+    const unsigned kMaxPartitions = 1024;
+
+    unsigned target = 2 * stdx::thread::hardware_concurrency();
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < target && numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
 
-LockManager::LockManager() {
+}  // namespace
+
+LockManager::LockManager() : _numPartitions(numPartitionsForHost()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -805,6 +827,10 @@ LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
     return &_partitions[request->locker->getId() % _numPartitions];
 }
 
+bool LockManager::hasWaitingRequests() {
+    return numWaitingRequests.load() > 0;
+}
+
 void LockManager::dump() const {
     log() << "Dumping LockManager @ " << static_cast<const void*>(this) << '\n';
 
@@ -124,6 +124,13 @@ public:
      */
     void dump() const;
 
+    /**
+     * Returns whether any new lock request, on any LockManager, is queued waiting to be granted.
+     * Pending conversions of already granted requests are not counted. This is only a hint, as
+     * requests may be queued or granted as soon as it returns.
+     */
+    static bool hasWaitingRequests();
+
     /**
      * Dumps the contents of all locks into a BSON object
      * to be used in lockInfo command in the shell.
@@ -140,11 +147,18 @@ private:
 
     // These types describe the locks hash table
 
+    // Buckets and partitions are allocated in arrays and are each protected by their own mutex.
+    // Separating neighbouring elements by a cache line keeps threads working on different
+    // elements from contending on the same line.
+    static const size_t kCacheLineSize = 64;
+
     struct LockBucket {
         SimpleMutex mutex;
         typedef unordered_map<ResourceId, LockHead*> Map;
         Map data;
         LockHead* findOrInsert(ResourceId resId);
+
+        char padding[kCacheLineSize];
     };
 
     // Each locker maps to a partition that is used for resources acquired in intent modes
@@ -156,6 +170,8 @@ private:
         typedef unordered_map<ResourceId, PartitionedLockHead*> Map;
         SimpleMutex mutex;
         Map data;
+
+        char padding[kCacheLineSize];
     };
 
     /**
@@ -214,7 +230,8 @@ private:
     static const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    // Scaled with the number of cores, so that concurrently running lockers rarely share one.
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 
@@ -26,9 +26,20 @@
  *    it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/debug_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -316,6 +327,31 @@ TEST(LockManager, Conflict) {
     ASSERT(request2.numNotifies == 1);
 }
 
+TEST(LockManager, HasWaitingRequestsWhileRequestIsQueued) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    MMAPV1LockerImpl locker1;
+    MMAPV1LockerImpl locker2;
+
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+
+    ASSERT_FALSE(LockManager::hasWaitingRequests());
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_S));
+    ASSERT_FALSE(LockManager::hasWaitingRequests());
+
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request2, MODE_X));
+    ASSERT_TRUE(LockManager::hasWaitingRequests());
+
+    // Granting the queued request leaves nothing waiting.
+    lockMgr.unlock(&request1);
+    ASSERT(request2.lastResult == LOCK_OK);
+    ASSERT_FALSE(LockManager::hasWaitingRequests());
+
+    lockMgr.unlock(&request2);
+}
+
 TEST(LockManager, MultipleConflict) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
@@ -951,4 +987,92 @@ TEST(LockManager, Fairness) {
     ASSERT(lockMgr.unlock(&requestIX1));
 }
 
+TEST(LockManager, IntentLocksFromManyLockersMigrate) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    // Use more lockers than there are partitions, so that the resource is partitioned everywhere
+    const int kNumLockers = 2048;
+    std::vector<std::unique_ptr<MMAPV1LockerImpl>> lockers;
+    std::vector<std::unique_ptr<LockRequestCombo>> requests;
+    for (int i = 0; i < kNumLockers; i++) {
+        lockers.push_back(stdx::make_unique<MMAPV1LockerImpl>());
+        requests.push_back(stdx::make_unique<LockRequestCombo>(lockers.back().get()));
+        ASSERT(LOCK_OK ==
+               lockMgr.lock(resId, requests.back().get(), (i % 2) ? MODE_IX : MODE_IS));
+    }
+
+    // A conflicting request must wait for all of the partitioned intent locks
+    MMAPV1LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestX, MODE_X));
+
+    for (int i = 0; i < kNumLockers; i++) {
+        ASSERT_EQ(0, requestX.numNotifies);
+        ASSERT(lockMgr.unlock(requests[i].get()));
+    }
+    ASSERT_EQ(LOCK_OK, requestX.lastResult);
+    ASSERT_EQ(1, requestX.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestX));
+}
+
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads to use for lock perf
+const int kPerfIterations = 100 * 1000;
+
+/**
+ * Has each of 'numThreads' threads, using its own locker, lock and unlock 'resId' in 'mode'
+ * kPerfIterations times. Returns the average time in nanoseconds per lock/unlock pair.
+ */
+double timeLockUnlock(LockManager* lockMgr, ResourceId resId, LockMode mode, int numThreads) {
+    std::vector<stdx::thread> threads;
+    AtomicInt32 ready{0};
+    AtomicInt64 elapsedMicros{0};
+
+    for (int threadId = 0; threadId < numThreads; threadId++) {
+        threads.emplace_back([&]() {
+            MMAPV1LockerImpl locker;
+            TrackingLockGrantNotification notify;
+
+            // Busy-wait until everybody is ready
+            ready.fetchAndAdd(1);
+            while (ready.load() < numThreads) {
+            }
+
+            Timer t;
+            for (int i = 0; i < kPerfIterations; i++) {
+                LockRequest request;
+                request.initNew(&locker, &notify);
+                invariant(lockMgr->lock(resId, &request, mode) == LOCK_OK);
+                invariant(lockMgr->unlock(&request));
+            }
+            elapsedMicros.fetchAndAdd(t.micros());
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return elapsedMicros.load() * 1000.0 / (static_cast<double>(numThreads) * kPerfIterations);
+}
+
+}  // namespace
+
+// Compares intent locks, which use the per-locker partitions, with shared locks, which always
+// go through the resource's lock bucket, as the number of contending threads grows.
+TEST(LockManager, ContendedIntentLockPerformance) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    for (int numThreads = 1; numThreads <= kMaxPerfThreads; numThreads *= 2) {
+        const double intentNanos = timeLockUnlock(&lockMgr, resId, MODE_IS, numThreads);
+        const double sharedNanos = timeLockUnlock(&lockMgr, resId, MODE_S, numThreads);
+        log() << numThreads << " threads: MODE_IS " << intentNanos << " ns, MODE_S "
+              << sharedNanos << " ns per lock/unlock" << (kDebugBuild ? " (DEBUG BUILD!)" : "");
+    }
+}
+
 }  // namespace mongo
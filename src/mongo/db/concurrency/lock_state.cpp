@@ -36,6 +36,7 @@
 
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
@@ -258,6 +259,21 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+template <bool IsForMMAPV1>
+bool LockerImpl<IsForMMAPV1>::hasLockWaiters() const {
+    if (LockManager::hasWaitingRequests()) {
+        return true;
+    }
+
+    for (auto mode : {MODE_IS, MODE_IX}) {
+        auto holder = ticketHolders[mode];
+        if (holder && holder->queued() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 template <bool IsForMMAPV1>
 LockerImpl<IsForMMAPV1>::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
@@ -314,7 +330,11 @@ LockResult LockerImpl<IsForMMAPV1>::lockGlobalBegin(LockMode mode) {
         auto holder = ticketHolders[mode];
         if (holder) {
             _clientState.store(reader ? kQueuedReader : kQueuedWriter);
-            holder->waitForTicket();
+            // Only an actual wait for a ticket is reported as a wait event.
+            if (!holder->tryAcquire()) {
+                WaitEventScope waitForTicket(WaitEvent::kTicket);
+                holder->waitForTicket();
+            }
         }
         _clientState.store(reader ? kActiveReader : kActiveWriter);
         _modeForTicket = mode;
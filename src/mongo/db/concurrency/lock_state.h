@@ -247,6 +247,8 @@ public:
     virtual bool hasLockPending() const {
         return getWaitingResource().isValid();
     }
+
+    virtual bool hasLockWaiters() const;
 };
 
 typedef LockerImpl<false> DefaultLockerImpl;
@@ -314,6 +314,14 @@ public:
      */
     virtual bool hasLockPending() const = 0;
 
+    /**
+     * Returns whether some operation is waiting for a lock or queued for a ticket of the global
+     * lock, such that releasing the locks this locker holds may let it make progress. This is a
+     * hint for long-running operations deciding whether to yield, and may be stale by the time it
+     * returns.
+     */
+    virtual bool hasLockWaiters() const = 0;
+
     /**
      * If set to false, this opts out of conflicting with replication's use of the
      * ParallelBatchWriterMode lock. Code that opts-out must be ok with seeing an inconsistent view
@@ -163,6 +163,10 @@ public:
     virtual bool hasLockPending() const {
         invariant(false);
     }
+
+    virtual bool hasLockWaiters() const {
+        return false;
+    }
 };
 
 }  // namespace mongo
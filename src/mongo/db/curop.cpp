@@ -44,6 +44,7 @@
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
+#include "mongo/util/cpu_profiler.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
 
@@ -226,7 +227,11 @@ CurOp* CurOp::get(const OperationContext& opCtx) {
 
 CurOp::CurOp(OperationContext* opCtx) : CurOp(opCtx, &_curopStack(opCtx)) {}
 
-CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
+CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack)
+    : _opCtx(opCtx),
+      _stack(stack),
+      _threadWaitState(ThreadWaitState::get()),
+      _threadCpuSamples(CpuProfiler::threadSampleCount()) {
     if (opCtx) {
         _stack->push(opCtx, this);
     } else {
@@ -254,21 +259,69 @@ ProgressMeter& CurOp::setMessage_inlock(const char* msg,
 
 CurOp::~CurOp() {
     invariant(this == _stack->pop());
+    if (_parent) {
+        _parent->_setCpuProfilerOperation();
+    } else {
+        CpuProfiler::clearThreadOperation();
+    }
 }
 
 void CurOp::setNS_inlock(StringData ns) {
     _ns = ns.toString();
+    _setCpuProfilerOperation();
+}
+
+void CurOp::setCommand_inlock(Command* command) {
+    _command = command;
+    _setCpuProfilerOperation();
+}
+
+void CurOp::_setCpuProfilerOperation() const {
+    if (!CpuProfiler::isRunning()) {
+        return;
+    }
+    CpuProfiler::setThreadOperation(_command ? StringData(_command->getName())
+                                             : StringData(logicalOpToString(_logicalOp)),
+                                    _ns);
 }
 
 void CurOp::ensureStarted() {
     if (_start == 0) {
         _start = curTimeMicros64();
+        _waitEventsAtStart = _threadWaitState->totals();
+        _cpuSamplesAtStart = _threadCpuSamples->load();
+        _cpuMicrosAtStart = curThreadCpuTimeMicros64();
+        if (_opCtx && _opCtx->recoveryUnit()) {
+            _recoveryUnitAtStart = _opCtx->recoveryUnit();
+            _storageStatsAtStart = _recoveryUnitAtStart->storageStats();
+        }
+    }
+}
+
+void CurOp::done() {
+    _end = curTimeMicros64();
+    if (_start) {
+        _debug.waitEvents = _threadWaitState->totals();
+        _debug.waitEvents -= _waitEventsAtStart;
+
+        const long long cpuMicros = curThreadCpuTimeMicros64();
+        if (_cpuMicrosAtStart >= 0 && cpuMicros >= 0) {
+            _debug.cpuMicros = cpuMicros - _cpuMicrosAtStart;
+        }
+
+        // The counters of a recovery unit the operation switched to can't be compared with those
+        // taken at the start.
+        if (_recoveryUnitAtStart && _opCtx->recoveryUnit() == _recoveryUnitAtStart) {
+            _debug.storageStats = _recoveryUnitAtStart->storageStats();
+            _debug.storageStats -= _storageStatsAtStart;
+        }
     }
 }
 
 void CurOp::enter_inlock(const char* ns, boost::optional<int> dbProfileLevel) {
     ensureStarted();
     _ns = ns;
+    _setCpuProfilerOperation();
     if (dbProfileLevel) {
         raiseDbProfileLevel(*dbProfileLevel);
     }
@@ -417,6 +470,20 @@ void CurOp::reportState(BSONObjBuilder* builder) {
     }
 
     builder->append("numYields", _numYields);
+
+    if (_start) {
+        auto waitEvents = _threadWaitState->totals();
+        waitEvents -= _waitEventsAtStart;
+        if (!waitEvents.empty()) {
+            BSONObjBuilder waitsBuilder(builder->subobjStart("waits"));
+            waitEvents.append(&waitsBuilder);
+        }
+        _threadWaitState->appendCurrentWait("waitingFor", builder);
+
+        if (CpuProfiler::isRunning()) {
+            builder->appendNumber("cpuSamples", _threadCpuSamples->load() - _cpuSamplesAtStart);
+        }
+    }
 }
 
 namespace {
@@ -547,7 +614,22 @@ string OpDebug::report(Client* client,
 
     s << " numYields:" << curop.numYields();
 
+    if (!waitEvents.empty()) {
+        BSONObjBuilder waits;
+        waitEvents.append(&waits);
+        s << " waits:" << waits.obj().toString();
+    }
+
+    if (!storageStats.empty()) {
+        BSONObjBuilder storage;
+        storageStats.append(&storage);
+        s << " storage:" << storage.obj().toString();
+    }
+
     OPDEBUG_TOSTRING_HELP(nreturned);
+    if (requestLength > 0) {
+        s << " reqlen:" << requestLength;
+    }
     if (responseLength > 0) {
         s << " reslen:" << responseLength;
     }
@@ -562,6 +644,8 @@ string OpDebug::report(Client* client,
         s << " protocol:" << getProtoString(networkOp);
     }
 
+    OPDEBUG_TOSTRING_HELP(cpuMicros);
+
     s << " " << (executionTimeMicros / 1000) << "ms";
 
     return s.str();
@@ -652,6 +736,16 @@ void OpDebug::append(const CurOp& curop,
 
     b.appendNumber("numYield", curop.numYields());
 
+    if (!waitEvents.empty()) {
+        BSONObjBuilder waits(b.subobjStart("waits"));
+        waitEvents.append(&waits);
+    }
+
+    if (!storageStats.empty()) {
+        BSONObjBuilder storage(b.subobjStart("storage"));
+        storageStats.append(&storage);
+    }
+
     {
         BSONObjBuilder locks(b.subobjStart("locks"));
         lockStats.report(&locks);
@@ -662,11 +756,13 @@ void OpDebug::append(const CurOp& curop,
     }
 
     OPDEBUG_APPEND_NUMBER(nreturned);
+    OPDEBUG_APPEND_NUMBER(requestLength);
     OPDEBUG_APPEND_NUMBER(responseLength);
     if (iscommand) {
         b.append("protocol", getProtoString(networkOp));
     }
     b.appendIntOrLL("millis", executionTimeMicros / 1000);
+    OPDEBUG_APPEND_NUMBER(cpuMicros);
 
     if (!curop.getPlanSummary().empty()) {
         b.append("planSummary", curop.getPlanSummary());
@@ -31,11 +31,15 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/stats/wait_events.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/net/message.h"
 #include "mongo/util/progress_meter.h"
@@ -90,6 +94,11 @@ public:
     long long ntoskip{-1};
     bool exhaust{false};
 
+    // The namespace and plan cache key of the first query planned by this operation, from which
+    // its per-query-shape statistics are accumulated. Empty if it planned no query.
+    std::string queryShapeNs;
+    std::string queryShape;
+
     // debugging/profile info
     long long keysExamined{-1};
     long long docsExamined{-1};
@@ -119,6 +128,12 @@ public:
     long long keysDeleted{0};   // Number of index keys removed.
     long long writeConflicts{0};
 
+    // The number of waits and the time waited for each kind of wait event, other than locks.
+    WaitEventCounters waitEvents;
+
+    // The storage engine work done through the operation's recovery unit.
+    StorageOperationStats storageStats;
+
     BSONObj execStats;  // Owned here.
 
     // error handling
@@ -126,7 +141,9 @@ public:
 
     // response info
     long long executionTimeMicros{0};
+    long long cpuMicros{-1};  // CPU time of the thread running the operation, -1 if unknown.
     long long nreturned{-1};
+    int requestLength{-1};
     int responseLength{-1};
 };
 
@@ -224,6 +241,9 @@ public:
     OpDebug& debug() {
         return _debug;
     }
+    const OpDebug& debug() const {
+        return _debug;
+    }
 
     /**
      * Gets the name of the namespace on which the current operation operates.
@@ -291,9 +311,7 @@ public:
         ensureStarted();
         return _start;
     }
-    void done() {
-        _end = curTimeMicros64();
-    }
+    void done();
     bool isDone() const {
         return _end > 0;
     }
@@ -337,9 +355,7 @@ public:
     Command* getCommand() const {
         return _command;
     }
-    void setCommand_inlock(Command* command) {
-        _command = command;
-    }
+    void setCommand_inlock(Command* command);
 
     /**
      * Returns whether the current operation is a read, write, or command.
@@ -427,12 +443,36 @@ private:
 
     CurOp(OperationContext*, CurOpStack*);
 
+    /**
+     * Charges the CPU profiler samples of this thread to this operation's command and namespace.
+     */
+    void _setCpuProfilerOperation() const;
+
+    OperationContext* const _opCtx;
     CurOpStack* _stack;
     CurOp* _parent{nullptr};
     Command* _command{nullptr};
     long long _start{0};
     long long _end{0};
 
+    // The wait state of the thread running the operation, and its totals when the operation
+    // started.
+    const ThreadWaitState* const _threadWaitState;
+    WaitEventCounters _waitEventsAtStart;
+
+    // The number of CPU profiler samples of the thread running the operation, and that number
+    // when the operation started.
+    const std::atomic<long long>* const _threadCpuSamples;  // NOLINT
+    long long _cpuSamplesAtStart{0};
+
+    // The recovery unit of the operation, and its storage engine counters, when the operation
+    // started.
+    const RecoveryUnit* _recoveryUnitAtStart{nullptr};
+    StorageOperationStats _storageStatsAtStart;
+
+    // The CPU time used by the thread running the operation when the operation started.
+    long long _cpuMicrosAtStart{-1};
+
     // _networkOp represents the network-level op code: OP_QUERY, OP_GET_MORE, OP_COMMAND, etc.
     NetworkOp _networkOp{opInvalid};  // only set this through setNetworkOp_inlock() to keep synced
     // _logicalOp is the logical operation type, ie 'dbQuery' regardless of whether this is an
@@ -121,11 +121,13 @@
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/transport/transport_layer_legacy.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
 #include "mongo/util/concurrency/task.h"
 #include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/cpu_profiler.h"
 #include "mongo/util/exception_filter_win32.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
@@ -472,10 +474,6 @@ ExitCode _initAndListen(int listenPort) {
 
     checked_cast<ServiceContextMongoD*>(getGlobalServiceContext())->createLockFile();
 
-    transport::TransportLayerLegacy::Options options;
-    options.port = listenPort;
-    options.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongod>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
@@ -483,8 +481,27 @@ ExitCode _initAndListen(int listenPort) {
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
     // Create, start, and attach the TL
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
-    auto res = transportLayer->setup();
+    std::unique_ptr<transport::TransportLayer> transportLayer;
+    Status res = Status::OK();
+    if (serverGlobalParams.transportLayer == "asio") {
+        transport::TransportLayerASIO::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+        options.ioThreads = serverGlobalParams.transportLayerIOThreads;
+
+        auto asioTransportLayer = stdx::make_unique<transport::TransportLayerASIO>(options, sepPtr);
+        res = asioTransportLayer->setup();
+        transportLayer = std::move(asioTransportLayer);
+    } else {
+        transport::TransportLayerLegacy::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+
+        auto legacyTransportLayer =
+            stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
+        res = legacyTransportLayer->setup();
+        transportLayer = std::move(legacyTransportLayer);
+    }
     if (!res.isOK()) {
         error() << "Failed to set up listener: " << res;
         return EXIT_NET_ERROR;
@@ -654,6 +671,9 @@ ExitCode _initAndListen(int listenPort) {
         reloadShardRegistryUntilSuccess(startupOpCtx.get());
     }
 
+    // Started after forking, as profiling timers are not inherited by the forked process.
+    CpuProfiler::startIfEnabled();
+
     if (!storageGlobalParams.readOnly) {
         logStartup(startupOpCtx.get());
 
@@ -890,6 +910,7 @@ MONGO_INITIALIZER_WITH_PREREQUISITES(CreateReplicationManager,
 
     repl::TopologyCoordinatorImpl::Options topoCoordOptions;
     topoCoordOptions.maxSyncSourceLagSecs = Seconds(repl::maxSyncSourceLagSecs);
+    topoCoordOptions.syncSourceRegionTag = repl::syncSourceRegionTag;
     topoCoordOptions.clusterRole = serverGlobalParams.clusterRole;
 
     std::array<std::uint8_t, 20> tempKey = {};
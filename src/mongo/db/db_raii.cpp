@@ -126,6 +126,23 @@ void AutoGetCollectionForRead::_ensureMajorityCommittedSnapshotIsValid(const Nam
         }
         auto mySnapshot = opCtx->recoveryUnit()->getMajorityCommittedSnapshot();
         if (!mySnapshot) {
+            auto localSnapshot = opCtx->recoveryUnit()->getLocalSnapshot();
+            if (!localSnapshot || localSnapshot >= minSnapshot) {
+                return;
+            }
+
+            // The collection changed after the local snapshot was taken, so read the latest data
+            // instead, which requires waiting for the current batch of oplog application. That is
+            // only possible if no locks acquired without the PBWM lock are still held.
+            _autoColl = boost::none;
+            uassert(ErrorCodes::LocalSnapshotNotAvailable,
+                    str::stream() << "Collection " << nss.ns()
+                                  << " changed after the local snapshot was taken",
+                    !opCtx->lockState()->isLocked());
+            opCtx->recoveryUnit()->abandonSnapshot();
+            opCtx->recoveryUnit()->clearReadFromLocalSnapshot();
+            opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(true);
+            _autoColl.emplace(opCtx, nss, MODE_IS);
             return;
         }
         if (mySnapshot >= minSnapshot) {
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/multi_plan.h"
+#include "mongo/db/exec/scoped_storage_stats.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/explain.h"
@@ -72,10 +73,11 @@ CachedPlanStage::CachedPlanStage(OperationContext* opCtx,
 }
 
 Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
-    // Adds the amount of time taken by pickBestPlan() to executionTimeMillis. There's lots of
-    // execution work that happens here, so this is needed for the time accounting to
-    // make sense.
-    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    // Adds the time taken and the storage engine work done by pickBestPlan() to this stage's
+    // stats. There's lots of execution work that happens here, so this is needed for the
+    // accounting to make sense.
+    ScopedTimer timer(getTickSource(), &_commonStats.executionTimeNanos);
+    ScopedStorageStats storageStats(getOpCtx(), &_commonStats.storageStats);
 
     // If we work this many times during the trial period, then we will replan the
     // query from scratch.
@@ -108,6 +108,9 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = _params.collection->getCursor(getOpCtx(), forward);
+            if (_params.readAhead && !_params.tailable) {
+                _cursor->hintSequentialScan();
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -59,6 +59,10 @@ struct CollectionScanParams {
 
     // If non-zero, how many documents will we look at?
     size_t maxScan = 0;
+
+    // Should the storage engine be told that this scan reads the collection sequentially, so that
+    // it may read ahead of the cursor? Ignored for tailable scans.
+    bool readAhead = false;
 };
 
 }  // namespace mongo
@@ -73,6 +73,8 @@ CountScan::CountScan(OperationContext* opCtx, const CountScanParams& params, Wor
       _workingSet(workingSet),
       _descriptor(params.descriptor),
       _iam(params.descriptor->getIndexCatalog()->getIndex(params.descriptor)),
+      _currentRange(0),
+      _needSeek(false),
       _shouldDedup(params.descriptor->isMultikey(opCtx)),
       _params(params) {
     _specificStats.keyPattern = _params.descriptor->keyPattern();
@@ -88,10 +90,19 @@ CountScan::CountScan(OperationContext* opCtx, const CountScanParams& params, Wor
     _specificStats.isPartial = _params.descriptor->isPartial();
     _specificStats.indexVersion = static_cast<int>(_params.descriptor->version());
 
+    _ranges.push_back(IndexKeyRange{_params.startKey,
+                                    _params.startKeyInclusive,
+                                    _params.endKey,
+                                    _params.endKeyInclusive});
+    _ranges.insert(
+        _ranges.end(), _params.additionalRanges.begin(), _params.additionalRanges.end());
+
     // endKey must be after startKey in index order since we only do forward scans.
-    dassert(_params.startKey.woCompare(_params.endKey,
-                                       Ordering::make(params.descriptor->keyPattern()),
-                                       /*compareFieldNames*/ false) <= 0);
+    for (auto&& range : _ranges) {
+        dassert(range.startKey.woCompare(range.endKey,
+                                         Ordering::make(params.descriptor->keyPattern()),
+                                         /*compareFieldNames*/ false) <= 0);
+    }
 }
 
 
@@ -108,9 +119,15 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
         if (needInit) {
             // First call to work().  Perform cursor init.
             _cursor = _iam->newCursor(getOpCtx());
-            _cursor->setEndPosition(_params.endKey, _params.endKeyInclusive);
+        }
+
+        if (needInit || _needSeek) {
+            // Position the cursor at the start of the current range.
+            const IndexKeyRange& range = _ranges[_currentRange];
+            _cursor->setEndPosition(range.endKey, range.endKeyInclusive);
 
-            entry = _cursor->seek(_params.startKey, _params.startKeyInclusive, kWantLoc);
+            entry = _cursor->seek(range.startKey, range.startKeyInclusive, kWantLoc);
+            _needSeek = false;
         } else {
             entry = _cursor->next(kWantLoc);
         }
@@ -126,6 +143,11 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     ++_specificStats.keysExamined;
 
     if (!entry) {
+        if (++_currentRange < _ranges.size()) {
+            _needSeek = true;
+            return PlanStage::NEED_TIME;
+        }
+
         _commonStats.isEOF = true;
         _cursor.reset();
         return PlanStage::IS_EOF;
@@ -196,6 +218,16 @@ unique_ptr<PlanStageStats> CountScan::getStats() {
     countStats->endKey = replaceBSONFieldNames(_params.endKey, countStats->keyPattern);
     countStats->endKeyInclusive = _params.endKeyInclusive;
 
+    BSONArrayBuilder additionalBoundsBuilder;
+    for (auto&& range : _params.additionalRanges) {
+        BSONObjBuilder rangeBob(additionalBoundsBuilder.subobjStart());
+        rangeBob.append("startKey", replaceBSONFieldNames(range.startKey, countStats->keyPattern));
+        rangeBob.append("startKeyInclusive", range.startKeyInclusive);
+        rangeBob.append("endKey", replaceBSONFieldNames(range.endKey, countStats->keyPattern));
+        rangeBob.append("endKeyInclusive", range.endKeyInclusive);
+    }
+    countStats->additionalIndexBounds = additionalBoundsBuilder.arr();
+
     ret->specific = std::move(countStats);
 
     return ret;
@@ -34,6 +34,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
 #include "mongo/platform/unordered_set.h"
 
@@ -54,10 +55,15 @@ struct CountScanParams {
 
     BSONObj endKey;
     bool endKeyInclusive;
+
+    // Further ranges of keys to count after the one above, in index order, when the bounds are
+    // several disjoint ranges such as those of an $in.
+    std::vector<IndexKeyRange> additionalRanges;
 };
 
 /**
- * Used by the count command. Scans an index from a start key to an end key. Creates a
+ * Used by the count command. Scans an index from a start key to an end key, and then through each
+ * of the additional ranges of keys in turn. Creates a
  * WorkingSetMember for each matching index key in RID_AND_OBJ state. It has a null record id and an
  * empty object with a null snapshot id rather than real data. Returning real data is unnecessary
  * since all we need is the count.
@@ -97,6 +103,13 @@ private:
 
     std::unique_ptr<SortedDataInterface::Cursor> _cursor;
 
+    // All of the ranges of keys to count, and which one the cursor is in.
+    std::vector<IndexKeyRange> _ranges;
+    size_t _currentRange;
+
+    // True once the cursor has run off the end of one range and must seek to the next.
+    bool _needSeek;
+
     // Could our index have duplicates?  If so, we use _returned to dedup.
     bool _shouldDedup;
     unordered_set<RecordId, RecordId::Hasher> _returned;
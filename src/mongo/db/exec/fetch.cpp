@@ -30,12 +30,18 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/storage/record_fetcher.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/mongoutils/str.h"
@@ -58,7 +64,10 @@ FetchStage::FetchStage(OperationContext* opCtx,
       _collection(collection),
       _ws(ws),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      // Without document-level locking, results may need a RecordFetcher to page in their
+      // document, which only the one-at-a-time path supports.
+      _batchSize(supportsDocLocking() ? std::max(1, internalQueryExecFetchBatchSize.load()) : 1) {
     _children.emplace_back(child);
 }
 
@@ -71,6 +80,10 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_pending.empty() || !_fetched.empty()) {
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -79,6 +92,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 1) {
+        return doWorkBatched(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -150,9 +167,104 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatched(WorkingSetID* out) {
+    // Return whatever the previous batch fetched before asking the child for more.
+    if (_fetched.empty()) {
+        if (_pending.size() < _batchSize && !child()->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState status = child()->work(&id);
+
+            if (PlanStage::ADVANCED == status) {
+                _pending.push_back(id);
+                if (_pending.size() < _batchSize) {
+                    return PlanStage::NEED_TIME;
+                }
+            } else if (PlanStage::IS_EOF == status) {
+                if (_pending.empty()) {
+                    return PlanStage::IS_EOF;
+                }
+            } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
+                *out = id;
+                if (WorkingSet::INVALID_ID == id) {
+                    Status status(ErrorCodes::InternalError,
+                                  "fetch stage failed to read in results from child");
+                    *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+                }
+                return status;
+            } else {
+                if (PlanStage::NEED_YIELD == status) {
+                    *out = id;
+                }
+                return status;
+            }
+        }
+
+        try {
+            fetchPending();
+        } catch (const WriteConflictException& wce) {
+            // The members stay pending, and are fetched again after the yield.
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+
+        if (_fetched.empty()) {
+            // None of the pending documents exist any longer.
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    WorkingSetID id = _fetched.front();
+    _fetched.pop_front();
+    return returnIfMatches(_ws->get(id), id, out);
+}
+
+void FetchStage::fetchPending() {
+    std::vector<RecordId> ids;
+    for (auto id : _pending) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!member->hasObj()) {
+            // We need a valid RecordId to fetch from and this is the only state that has one.
+            verify(WorkingSetMember::RID_AND_IDX == member->getState());
+            verify(member->hasRecordId());
+            ids.push_back(member->recordId);
+        }
+    }
+
+    std::vector<boost::optional<Record>> records;
+    if (!ids.empty()) {
+        if (!_cursor)
+            _cursor = _collection->getCursor(getOpCtx());
+        _cursor->seekExactBatch(ids, &records);
+    }
+
+    auto record = records.begin();
+    for (auto id : _pending) {
+        WorkingSetMember* member = _ws->get(id);
+        if (member->hasObj()) {
+            ++_specificStats.alreadyHasObj;
+        } else {
+            const auto& fetched = *record++;
+            if (!fetched || !WorkingSetCommon::fetchFromRecord(getOpCtx(), _ws, id, *fetched)) {
+                _ws->free(id);
+                continue;
+            }
+        }
+        _fetched.push_back(id);
+    }
+    _pending.clear();
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
+
+    // Buffered members may have been handed unowned documents by the child.
+    for (auto id : _pending) {
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
+    for (auto id : _fetched) {
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
 }
 
 void FetchStage::doRestoreState() {
@@ -180,6 +292,19 @@ void FetchStage::doInvalidate(OperationContext* opCtx, const RecordId& dl, Inval
             WorkingSetCommon::fetchAndInvalidateRecordId(opCtx, member, _collection);
         }
     }
+
+    for (auto id : _pending) {
+        WorkingSetMember* member = _ws->get(id);
+        if (member->hasRecordId() && (member->recordId == dl)) {
+            WorkingSetCommon::fetchAndInvalidateRecordId(opCtx, member, _collection);
+        }
+    }
+    for (auto id : _fetched) {
+        WorkingSetMember* member = _ws->get(id);
+        if (member->hasRecordId() && (member->recordId == dl)) {
+            WorkingSetCommon::fetchAndInvalidateRecordId(opCtx, member, _collection);
+        }
+    }
 }
 
 PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -45,6 +46,10 @@ class SeekableRecordCursor;
  * In WorkingSetMember terms, it transitions from RID_AND_IDX to RID_AND_OBJ by reading
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
+ * On storage engines with document-level locking, the stage can collect several of its child's
+ * results and look up their documents together; see internalQueryExecFetchBatchSize. Results
+ * are still returned in the order the child produced them.
+ *
  * Preconditions: Valid RecordId.
  */
 class FetchStage : public PlanStage {
@@ -83,6 +88,17 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Implements doWork() when results are fetched in batches of more than one.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
+    /**
+     * Looks up the documents of all members in '_pending', moving those that still exist to
+     * '_fetched'. May throw WriteConflictException, in which case the members stay pending.
+     */
+    void fetchPending();
+
     // Collection which is used by this stage. Used to resolve record ids retrieved by child
     // stages. The lifetime of the collection must supersede that of the stage.
     const Collection* _collection;
@@ -98,6 +114,15 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The most child results to collect before fetching their documents together.
+    const size_t _batchSize;
+
+    // Results received from the child whose documents have not been looked up yet, and results
+    // whose documents have been looked up but which have not been returned yet. Both are in the
+    // order the child produced them.
+    std::deque<WorkingSetID> _pending;
+    std::deque<WorkingSetID> _fetched;
+
     // Stats
     FetchStats _specificStats;
 };
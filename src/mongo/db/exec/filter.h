@@ -54,7 +54,7 @@ public:
         // BSONElementIterator does some interesting things with arrays that I don't think
         // SimpleArrayElementIterator does.
         if (_wsm->hasObj()) {
-            return new BSONElementIterator(path, _wsm->obj.value());
+            return new BSONElementIterator(path, _wsm->obj.value(), &_wsm->getObjFieldIndex());
         }
 
         // NOTE: This (kind of) duplicates code in WorkingSetMember::getFieldDotted.
@@ -266,6 +266,34 @@ static R2Annulus twoDDistanceBounds(const GeoNearParams& nearParams,
     return fullBounds;
 }
 
+// The number of results each search interval should hold.
+static const double kTargetResultsPerInterval = 450;
+
+/**
+ * Returns the width of the next search interval, which starts where 'lastBounds' ends. The
+ * number of results found in the last interval gives the density of documents around it, and
+ * with it the width the next interval needs to hold about kTargetResultsPerInterval results.
+ * The width changes at most four fold from one interval to the next, since the density of
+ * clustered data can change abruptly.
+ */
+static double nextBoundsIncrement(const IntervalStats& lastIntervalStats,
+                                  const R2Annulus& lastBounds,
+                                  double lastBoundsIncrement) {
+    const double inner = max(0.0, lastBounds.getInner());
+    const double outer = lastBounds.getOuter();
+    const double maxIncrement = lastBoundsIncrement * 4;
+    const double minIncrement = lastBoundsIncrement / 4;
+
+    if (lastIntervalStats.numResultsReturned == 0 || outer <= inner) {
+        return maxIncrement;
+    }
+
+    // Results per unit of area, treating the annulus as flat.
+    const double density = lastIntervalStats.numResultsReturned / (outer * outer - inner * inner);
+    const double nextOuter = sqrt(outer * outer + kTargetResultsPerInterval / density);
+    return min(max(nextOuter - outer, minIncrement), maxIncrement);
+}
+
 class GeoNear2DStage::DensityEstimator {
 public:
     DensityEstimator(PlanStage::Children* children,
@@ -607,13 +635,8 @@ StatusWith<NearStage::CoveredInterval*>  //
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextBoundsIncrement(
+            _specificStats.intervalStats.back(), _currBounds, _boundsIncrement);
     }
 
     _boundsIncrement =
@@ -1040,13 +1063,8 @@ StatusWith<NearStage::CoveredInterval*>  //
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextBoundsIncrement(
+            _specificStats.intervalStats.back(), _currBounds, _boundsIncrement);
     }
 
     invariant(_boundsIncrement > 0.0);
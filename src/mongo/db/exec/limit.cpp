@@ -28,6 +28,8 @@
 
 #include "mongo/db/exec/limit.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/stdx/memory.h"
@@ -86,6 +88,26 @@ PlanStage::StageState LimitStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState LimitStage::doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) {
+    if (0 == _numToReturn) {
+        ++batch->works;
+        return PlanStage::IS_EOF;
+    }
+
+    // Each of our units of work is one of our child's, and any of them may produce a result.
+    const size_t childMaxWorks = std::min(maxWorks, static_cast<size_t>(_numToReturn));
+    StageState status = child()->workBatch(ws, childMaxWorks, batch);
+    _numToReturn -= batch->ids.size();
+
+    if ((PlanStage::FAILURE == status || PlanStage::DEAD == status) &&
+        WorkingSet::INVALID_ID == batch->stateId) {
+        Status status(ErrorCodes::InternalError,
+                      "limit stage failed to read in results from child");
+        batch->stateId = WorkingSetCommon::allocateStatusMember(_ws, status);
+    }
+    return status;
+}
+
 unique_ptr<PlanStageStats> LimitStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_LIMIT);
@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/scoped_storage_stats.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/explain.h"
@@ -201,10 +202,11 @@ size_t MultiPlanStage::getTrialPeriodNumToReturn(const CanonicalQuery& query) {
 }
 
 Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
-    // Adds the amount of time taken by pickBestPlan() to executionTimeMillis. There's lots of
-    // execution work that happens here, so this is needed for the time accounting to
-    // make sense.
-    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    // Adds the time taken and the storage engine work done by pickBestPlan() to this stage's
+    // stats. There's lots of execution work that happens here, so this is needed for the
+    // accounting to make sense.
+    ScopedTimer timer(getTickSource(), &_commonStats.executionTimeNanos);
+    ScopedStorageStats storageStats(getOpCtx(), &_commonStats.storageStats);
 
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), _collection);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
@@ -29,10 +29,10 @@
 #pragma once
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
-#include "mongo/platform/unordered_set.h"
 
 namespace mongo {
 
@@ -79,7 +79,7 @@ private:
     bool _dedup;
 
     // Which RecordIds have we returned?
-    unordered_set<RecordId, RecordId::Hasher> _seen;
+    RecordIdSet _seen;
 
     // Stats
     OrStats _specificStats;
@@ -32,6 +32,7 @@
 
 #include "mongo/db/exec/plan_stage.h"
 
+#include "mongo/db/exec/scoped_storage_stats.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
@@ -40,7 +41,8 @@ namespace mongo {
 
 PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     invariant(_opCtx);
-    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    ScopedTimer timer(getTickSource(), &_commonStats.executionTimeNanos);
+    ScopedStorageStats storageStats(_opCtx, &_commonStats.storageStats);
     ++_commonStats.works;
 
     StageState workResult = doWork(out);
@@ -56,6 +58,57 @@ PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     return workResult;
 }
 
+PlanStage::StageState PlanStage::workBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) {
+    invariant(_opCtx);
+    invariant(maxWorks > 0);
+    ScopedTimer timer(getTickSource(), &_commonStats.executionTimeNanos);
+    ScopedStorageStats storageStats(_opCtx, &_commonStats.storageStats);
+
+    batch->ids.clear();
+    batch->works = 0;
+    batch->stateId = WorkingSet::INVALID_ID;
+
+    StageState batchResult = doWorkBatch(ws, maxWorks, batch);
+    invariant(batch->works > 0 && batch->works <= maxWorks);
+
+    // Every unit of work advanced or needed time, except for one which ended the batch early.
+    const size_t numAdvanced = batch->ids.size();
+    const bool endedEarly =
+        StageState::ADVANCED != batchResult && StageState::NEED_TIME != batchResult;
+    invariant(numAdvanced + (endedEarly ? 1 : 0) <= batch->works);
+
+    _commonStats.works += batch->works;
+    _commonStats.advanced += numAdvanced;
+    _commonStats.needTime += batch->works - numAdvanced - (endedEarly ? 1 : 0);
+    if (StageState::NEED_YIELD == batchResult) {
+        ++_commonStats.needYield;
+    }
+
+    return batchResult;
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) {
+    while (batch->works < maxWorks) {
+        // Our last result may point into memory which the next unit of work invalidates.
+        if (!batch->ids.empty()) {
+            ws->get(batch->ids.back())->makeObjOwnedIfNeeded();
+        }
+
+        ++batch->works;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState workResult = doWork(&id);
+
+        if (StageState::ADVANCED == workResult) {
+            batch->ids.push_back(id);
+        } else if (StageState::NEED_TIME != workResult) {
+            batch->stateId = id;
+            return workResult;
+        }
+    }
+
+    return batch->ids.empty() ? StageState::NEED_TIME : StageState::ADVANCED;
+}
+
 void PlanStage::saveState() {
     ++_commonStats.yields;
     for (auto&& child : _children) {
@@ -105,8 +158,8 @@ void PlanStage::reattachToOperationContext(OperationContext* opCtx) {
     doReattachToOperationContext();
 }
 
-ClockSource* PlanStage::getClock() const {
-    return _opCtx->getServiceContext()->getFastClockSource();
+TickSource* PlanStage::getTickSource() const {
+    return _opCtx->getServiceContext()->getTickSource();
 }
 
 }  // namespace mongo
@@ -37,10 +37,10 @@
 
 namespace mongo {
 
-class ClockSource;
 class Collection;
 class OperationContext;
 class RecordId;
+class TickSource;
 
 /**
  * A PlanStage ("stage") is the basic building block of a "Query Execution Plan."  A stage is
@@ -188,6 +188,38 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * The output of workBatch().
+     */
+    struct WorkBatch {
+        // The results produced, in the order work() would have produced them. As with work(),
+        // the caller must free them from the working set when done with them.
+        std::vector<WorkingSetID> ids;
+
+        // The number of units of work performed.
+        size_t works = 0;
+
+        // When the batch ends in IS_EOF, NEED_YIELD, DEAD or FAILURE, the out parameter that
+        // work(...) would have returned along with that state.
+        WorkingSetID stateId = WorkingSet::INVALID_ID;
+    };
+
+    /**
+     * Performs up to 'maxWorks' units of work, with the same effect as calling work() that many
+     * times, and fills out 'batch' with the results. Stops early once a unit of work ends in
+     * IS_EOF, NEED_YIELD, DEAD or FAILURE and returns that state. The results in 'batch' came
+     * before it, so the caller must consume them first. Otherwise returns ADVANCED if any
+     * results were produced and NEED_TIME if not.
+     *
+     * The objects of all results but the last are made owned, as the later units of work may
+     * have moved the storage engine cursors they pointed into.
+     *
+     * Stages which simply stream their child's results override doWorkBatch() so that whole
+     * batches pass through them. Any other stage is worked one unit at a time, which still
+     * saves the bookkeeping work() does for every unit.
+     */
+    StageState workBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch);
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -324,6 +356,14 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs up to 'maxWorks' units of work.  See comment at workBatch() above. 'batch' has
+     * been reset by the caller.
+     *
+     * The default implementation calls doWork() in a loop.
+     */
+    virtual StageState doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch);
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
@@ -358,7 +398,7 @@ protected:
      */
     virtual void doInvalidate(OperationContext* opCtx, const RecordId& dl, InvalidationType type) {}
 
-    ClockSource* getClock() const;
+    TickSource* getTickSource() const;
 
     OperationContext* getOpCtx() const {
         return _opCtx;
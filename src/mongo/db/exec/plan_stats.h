@@ -37,6 +37,7 @@
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -64,7 +65,7 @@ struct CommonStats {
           advanced(0),
           needTime(0),
           needYield(0),
-          executionTimeMillis(0),
+          executionTimeNanos(0),
           isEOF(false) {}
     // String giving the type of the stage. Not owned.
     const char* stageTypeStr;
@@ -84,8 +85,12 @@ struct CommonStats {
     // is no filter affixed, then 'filter' should be an empty BSONObj.
     BSONObj filter;
 
-    // Time elapsed while working inside this stage.
-    long long executionTimeMillis;
+    // Time elapsed while working inside this stage, including the time spent in its children.
+    long long executionTimeNanos;
+
+    // Storage engine work done while working inside this stage, including the work done by its
+    // children.
+    StorageOperationStats storageStats;
 
     // TODO: have some way of tracking WSM sizes (or really any series of #s).  We can measure
     // the size of our inputs and the size of our outputs.  We can do a lot with the WS here.
@@ -242,6 +247,7 @@ struct CountScanStats : public SpecificStats {
         specific->collation = collation.getOwned();
         specific->startKey = startKey.getOwned();
         specific->endKey = endKey.getOwned();
+        specific->additionalIndexBounds = additionalIndexBounds.getOwned();
         return specific;
     }
 
@@ -260,6 +266,9 @@ struct CountScanStats : public SpecificStats {
     bool startKeyInclusive;
     bool endKeyInclusive;
 
+    // The start and end keys of any further ranges scanned after the first, in the same form.
+    BSONObj additionalIndexBounds;
+
     int indexVersion;
 
     // Set to true if the index used for the count scan is multikey.
@@ -508,7 +517,7 @@ struct ProjectionStats : public SpecificStats {
 };
 
 struct SortStats : public SpecificStats {
-    SortStats() : forcedFetches(0), memUsage(0), memLimit(0) {}
+    SortStats() : forcedFetches(0), memUsage(0), memLimit(0), usedDisk(false) {}
 
     SpecificStats* clone() const final {
         SortStats* specific = new SortStats(*this);
@@ -524,6 +533,9 @@ struct SortStats : public SpecificStats {
     // What's our memory limit?
     size_t memLimit;
 
+    // Did the sort write results to temporary files?
+    bool usedDisk;
+
     // The number of results to return from the sort.
     size_t limit;
 
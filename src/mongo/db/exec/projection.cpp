@@ -130,14 +130,18 @@ void ProjectionStage::getSimpleInclusionFields(const BSONObj& projObj, FieldSet*
 void ProjectionStage::transformSimpleInclusion(const BSONObj& in,
                                                const FieldSet& includedFields,
                                                BSONObjBuilder& bob) {
-    // Look at every field in the source document and see if we're including it.
+    // Look at the fields in the source document and see if we're including them. Once every
+    // included field has been found there is no need to look at the rest, which saves scanning
+    // most of a wide document when only a few of its fields are projected.
+    size_t nFieldsNeeded = includedFields.size();
     BSONObjIterator inputIt(in);
-    while (inputIt.more()) {
+    while (inputIt.more() && nFieldsNeeded > 0) {
         BSONElement elt = inputIt.next();
         auto fieldIt = includedFields.find(elt.fieldNameStringData());
         if (includedFields.end() != fieldIt) {
             // If so, add it to the builder.
             bob.append(elt);
+            --nFieldsNeeded;
         }
     }
 }
@@ -227,6 +231,36 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(WorkingSet* ws,
+                                                   size_t maxWorks,
+                                                   WorkBatch* batch) {
+    StageState status = child()->workBatch(ws, maxWorks, batch);
+
+    for (size_t i = 0; i < batch->ids.size(); ++i) {
+        Status projStatus = transform(_ws->get(batch->ids[i]));
+        if (!projStatus.isOK()) {
+            warning() << "Couldn't execute projection, status = " << redact(projStatus);
+
+            // Working one unit at a time, we would have stopped at this result, so the results
+            // after it are not returned either.
+            for (size_t j = i; j < batch->ids.size(); ++j) {
+                _ws->free(batch->ids[j]);
+            }
+            batch->ids.resize(i);
+            batch->stateId = WorkingSetCommon::allocateStatusMember(_ws, projStatus);
+            return PlanStage::FAILURE;
+        }
+    }
+
+    if ((PlanStage::FAILURE == status || PlanStage::DEAD == status) &&
+        WorkingSet::INVALID_ID == batch->stateId) {
+        Status status(ErrorCodes::InternalError,
+                      "projection stage failed to read in results from child");
+        batch->stateId = WorkingSetCommon::allocateStatusMember(_ws, status);
+    }
+    return status;
+}
+
 unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_PROJECTION);
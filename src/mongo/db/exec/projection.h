@@ -88,6 +88,7 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) final;
 
     StageType stageType() const final {
         return STAGE_PROJECTION;
@@ -108,7 +109,8 @@ public:
 
     /**
      * Applies a simple inclusion projection to 'in', including
-     * only the fields specified by 'includedFields'.
+     * only the fields specified by 'includedFields'. Like ParsedDeps, this stops
+     * reading 'in' once as many fields as 'includedFields' holds have been copied.
      *
      * The resulting document is constructed using 'bob'.
      */
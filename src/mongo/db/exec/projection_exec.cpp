@@ -179,6 +179,12 @@ ProjectionExec::ProjectionExec(const BSONObj& spec,
             _arrayOpType = ARRAY_OP_POSITIONAL;
         }
     }
+
+    _topLevelOnly = !_special && ARRAY_OP_NORMAL == _arrayOpType && _matchers.empty() &&
+        _meta.empty() && !_hasReturnKey;
+    for (auto&& field : _fields) {
+        _topLevelOnly = _topLevelOnly && field.second->_fields.empty() && !field.second->_special;
+    }
 }
 
 ProjectionExec::~ProjectionExec() {
@@ -377,6 +383,11 @@ Status ProjectionExec::transform(WorkingSetMember* member) const {
 Status ProjectionExec::transform(const BSONObj& in,
                                  BSONObjBuilder* bob,
                                  const MatchDetails* details) const {
+    if (_topLevelOnly) {
+        transformTopLevelOnly(in, bob);
+        return Status::OK();
+    }
+
     const ArrayOpType& arrayOpType = _arrayOpType;
 
     BSONObjIterator it(in);
@@ -442,6 +453,38 @@ Status ProjectionExec::transform(const BSONObj& in,
     return Status::OK();
 }
 
+void ProjectionExec::transformTopLevelOnly(const BSONObj& in, BSONObjBuilder* bob) const {
+    // The elements kept since the last one dropped, which are contiguous in 'in'.
+    const char* runStart = nullptr;
+    int runSize = 0;
+
+    for (auto&& elt : in) {
+        bool keep;
+        auto fieldName = elt.fieldNameStringData();
+        if (fieldName == "_id") {
+            keep = _includeID;
+        } else {
+            auto field = _fields.find(fieldName);
+            keep = (_fields.end() == field) ? _include : field->second->_include;
+        }
+
+        if (keep) {
+            if (!runStart) {
+                runStart = elt.rawdata();
+            }
+            runSize += elt.size();
+        } else if (runStart) {
+            bob->bb().appendBuf(runStart, runSize);
+            runStart = nullptr;
+            runSize = 0;
+        }
+    }
+
+    if (runStart) {
+        bob->bb().appendBuf(runStart, runSize);
+    }
+}
+
 void ProjectionExec::appendArray(BSONObjBuilder* bob, const BSONObj& array, bool nested) const {
     int skip = nested ? 0 : _skip;
     int limit = nested ? -1 : _limit;
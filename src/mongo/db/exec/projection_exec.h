@@ -112,6 +112,12 @@ private:
                      BSONObjBuilder* bob,
                      const MatchDetails* details = NULL) const;
 
+    /**
+     * Applies a projection for which '_topLevelOnly' is true to 'in', appending the result to
+     * 'bob'. Consecutive elements of 'in' which are kept are copied into 'bob' together.
+     */
+    void transformTopLevelOnly(const BSONObj& in, BSONObjBuilder* bob) const;
+
     /**
      * See transform(...) above.
      */
@@ -180,6 +186,11 @@ private:
     // meta-projection.
     std::vector<StringData> _sortKeyMetaFields;
 
+    // True if this projection only includes or excludes top-level fields, without any $slice,
+    // $elemMatch, positional or $meta projection. Such a projection decides whether to keep each
+    // element of the input document from its field name alone.
+    bool _topLevelOnly = false;
+
     // The collator this projection should use to compare strings. Needed for projection operators
     // that perform matching (e.g. elemMatch projection). If null, the collation is a simple binary
     // compare.
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/projection_exec.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+/**
+ * Returns a document with fields 'f0' through 'f<numFields - 1>' after its _id.
+ */
+BSONObj makeWideDocument(int numFields) {
+    BSONObjBuilder bob;
+    bob.append("_id", 0);
+    for (int i = 0; i < numFields; ++i) {
+        bob.append(str::stream() << "f" << i, i);
+    }
+    return bob.obj();
+}
+
+void projectDocument(unittest::BenchmarkState& state,
+                     const BSONObj& projection,
+                     const BSONObj& doc) {
+    ProjectionExec exec(projection, nullptr, nullptr, ExtensionsCallbackDisallowExtensions());
+
+    while (state.keepRunning()) {
+        WorkingSetMember member;
+        member.obj = Snapshotted<BSONObj>(SnapshotId(), doc);
+        member.transitionToOwnedObj();
+        invariantOK(exec.transform(&member));
+        benchmarkDoNotOptimize(member.obj.value());
+    }
+}
+
+BENCHMARK(ProjectionExec, TopLevelInclusionOfContiguousFields) {
+    projectDocument(state, fromjson("{f0: 1, f1: 1, f2: 1, f3: 1, f4: 1}"), makeWideDocument(50));
+}
+
+BENCHMARK(ProjectionExec, TopLevelInclusionOfScatteredFields) {
+    projectDocument(
+        state, fromjson("{f0: 1, f10: 1, f20: 1, f30: 1, f40: 1}"), makeWideDocument(50));
+}
+
+BENCHMARK(ProjectionExec, TopLevelExclusion) {
+    projectDocument(state, fromjson("{_id: 0, f25: 0}"), makeWideDocument(50));
+}
+
+BENCHMARK(ProjectionExec, DottedInclusion) {
+    projectDocument(state,
+                    fromjson("{'a.b': 1, 'a.c': 1}"),
+                    fromjson("{_id: 0, a: {b: 1, c: 2, d: 3}, e: 4, f: 5}"));
+}
+
+}  // namespace
+}  // namespace mongo
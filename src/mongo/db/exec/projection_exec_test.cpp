@@ -261,6 +261,26 @@ TEST(ProjectionExecTest, TransformSliceSkipLimit) {
     testTransform("{a: {$slice: [10, 10]}}", "{}", "{a: [4, 6, 8]}", true, "{a: []}");
 }
 
+//
+// Top-level projections.
+//
+
+TEST(ProjectionExecTest, TransformTopLevelInclusion) {
+    testTransform(
+        "{a: 1, c: 1}", "{}", "{_id: 0, a: 1, b: 2, c: 3, d: 4}", true, "{_id: 0, a: 1, c: 3}");
+    testTransform("{_id: 0, b: 1, c: 1}", "{}", "{_id: 0, a: 1, b: 2, c: 3}", true, "{b: 2, c: 3}");
+    testTransform("{_id: 1}", "{}", "{a: 1, _id: 0}", true, "{_id: 0}");
+    testTransform("{a: 1, 'b.c': 1}", "{}", "{a: 1, b: {c: 2, d: 3}}", true, "{a: 1, b: {c: 2}}");
+    testTransform("{x: 1}", "{}", "{a: 1, b: {c: 2}}", true, "{}");
+}
+
+TEST(ProjectionExecTest, TransformTopLevelExclusion) {
+    testTransform(
+        "{b: 0, d: 0}", "{}", "{_id: 0, a: 1, b: 2, c: 3, d: 4}", true, "{_id: 0, a: 1, c: 3}");
+    testTransform("{_id: 0, a: 0}", "{}", "{_id: 0, a: 1, b: [2, 3]}", true, "{b: [2, 3]}");
+    testTransform("{_id: 0}", "{}", "{a: 1, _id: 0, b: 2}", true, "{a: 1, b: 2}");
+}
+
 //
 // Dotted projections.
 //
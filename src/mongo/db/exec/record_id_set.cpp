@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+bool RecordIdSet::insert(const RecordId& id) {
+    Container& container = _containers[highBits(id)];
+    const uint16_t low = lowBits(id);
+
+    if (!container.bitmap.empty()) {
+        uint64_t& word = container.bitmap[low / 64];
+        const uint64_t bit = uint64_t(1) << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++_size;
+        return true;
+    }
+
+    auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (it != container.array.end() && *it == low) {
+        return false;
+    }
+    ++_size;
+
+    if (container.array.size() < kMaxArraySize) {
+        container.array.insert(it, low);
+        return true;
+    }
+
+    // The array is full, so switch this container over to a bitmap.
+    container.bitmap.assign(kBitmapWords, 0);
+    for (uint16_t value : container.array) {
+        container.bitmap[value / 64] |= uint64_t(1) << (value % 64);
+    }
+    container.bitmap[low / 64] |= uint64_t(1) << (low % 64);
+    std::vector<uint16_t>().swap(container.array);
+    return true;
+}
+
+bool RecordIdSet::contains(const RecordId& id) const {
+    auto it = _containers.find(highBits(id));
+    if (it == _containers.end()) {
+        return false;
+    }
+
+    const Container& container = it->second;
+    const uint16_t low = lowBits(id);
+    if (!container.bitmap.empty()) {
+        return container.bitmap[low / 64] & (uint64_t(1) << (low % 64));
+    }
+    return std::binary_search(container.array.begin(), container.array.end(), low);
+}
+
+bool RecordIdSet::erase(const RecordId& id) {
+    auto it = _containers.find(highBits(id));
+    if (it == _containers.end()) {
+        return false;
+    }
+
+    Container& container = it->second;
+    const uint16_t low = lowBits(id);
+    if (!container.bitmap.empty()) {
+        uint64_t& word = container.bitmap[low / 64];
+        const uint64_t bit = uint64_t(1) << (low % 64);
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+    } else {
+        auto pos = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (pos == container.array.end() || *pos != low) {
+            return false;
+        }
+        container.array.erase(pos);
+        if (container.array.empty()) {
+            _containers.erase(it);
+        }
+    }
+
+    --_size;
+    return true;
+}
+
+void RecordIdSet::clear() {
+    _containers.clear();
+    _size = 0;
+}
+
+size_t RecordIdSet::getMemUsage() const {
+    size_t memUsage = 0;
+    for (auto&& entry : _containers) {
+        memUsage += sizeof(entry) + entry.second.array.capacity() * sizeof(uint16_t) +
+            entry.second.bitmap.capacity() * sizeof(uint64_t);
+    }
+    return memUsage;
+}
+
+}  // namespace mongo
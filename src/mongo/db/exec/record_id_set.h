@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds stored as a compressed bitmap, for stages which only need to know whether
+ * they have seen a RecordId before.
+ *
+ * RecordIds are split on their high 48 bits into containers which hold the low 16 bits of each
+ * member. A container starts out as a sorted array of 16-bit values and is converted to a
+ * 65536-bit bitmap once the array would be larger than the bitmap. Storage engines which hand
+ * out RecordIds in increasing order therefore store densely populated ranges at about one bit
+ * per member, rather than the tens of bytes per node of a hash set.
+ */
+class RecordIdSet {
+public:
+    /**
+     * Adds 'id' to the set. Returns true if it was not already a member.
+     */
+    bool insert(const RecordId& id);
+
+    /**
+     * Returns true if 'id' is a member of the set.
+     */
+    bool contains(const RecordId& id) const;
+
+    /**
+     * Removes 'id' from the set. Returns true if it was a member.
+     */
+    bool erase(const RecordId& id);
+
+    void clear();
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns an approximation of the number of bytes used by the containers of the set.
+     */
+    size_t getMemUsage() const;
+
+private:
+    // A container is converted to a bitmap once its array would take more space than the bitmap.
+    static const size_t kBitmapWords = (1 << 16) / 64;
+    static const size_t kMaxArraySize = kBitmapWords * sizeof(uint64_t) / sizeof(uint16_t);
+
+    struct Container {
+        // Sorted low bits of the members. Unused once 'bitmap' is non-empty.
+        std::vector<uint16_t> array;
+
+        // Either empty or 'kBitmapWords' words with one bit per possible member.
+        std::vector<uint64_t> bitmap;
+    };
+
+    static uint64_t highBits(const RecordId& id) {
+        return static_cast<uint64_t>(id.repr()) >> 16;
+    }
+
+    static uint16_t lowBits(const RecordId& id) {
+        return static_cast<uint16_t>(static_cast<uint64_t>(id.repr()) & 0xFFFF);
+    }
+
+    stdx::unordered_map<uint64_t, Container> _containers;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
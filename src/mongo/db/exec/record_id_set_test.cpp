@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_set.h"
+
+#include <set>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdSetTest, InsertContainsAndErase) {
+    RecordIdSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(RecordId(1)));
+
+    ASSERT_TRUE(set.insert(RecordId(1)));
+    ASSERT_FALSE(set.insert(RecordId(1)));
+    ASSERT_TRUE(set.insert(RecordId(1 << 20)));
+    ASSERT_TRUE(set.insert(RecordId(RecordId::max())));
+    ASSERT_TRUE(set.insert(RecordId(RecordId::min())));
+    ASSERT_EQ(4U, set.size());
+
+    ASSERT_TRUE(set.contains(RecordId(1)));
+    ASSERT_TRUE(set.contains(RecordId(1 << 20)));
+    ASSERT_TRUE(set.contains(RecordId::max()));
+    ASSERT_TRUE(set.contains(RecordId::min()));
+    ASSERT_FALSE(set.contains(RecordId(2)));
+    ASSERT_FALSE(set.contains(RecordId((1 << 20) + 1)));
+
+    ASSERT_TRUE(set.erase(RecordId(1)));
+    ASSERT_FALSE(set.erase(RecordId(1)));
+    ASSERT_FALSE(set.contains(RecordId(1)));
+    ASSERT_EQ(3U, set.size());
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(RecordId(1 << 20)));
+    ASSERT_EQ(0U, set.getMemUsage());
+}
+
+TEST(RecordIdSetTest, DenseRangeIsStoredAsBitmap) {
+    RecordIdSet set;
+    const int64_t kNumIds = 100 * 1000;
+    for (int64_t i = 1; i <= kNumIds; ++i) {
+        ASSERT_TRUE(set.insert(RecordId(i)));
+    }
+    ASSERT_EQ(static_cast<size_t>(kNumIds), set.size());
+
+    for (int64_t i = 1; i <= kNumIds; ++i) {
+        ASSERT_TRUE(set.contains(RecordId(i)));
+    }
+    ASSERT_FALSE(set.contains(RecordId(kNumIds + 1)));
+
+    // Each full container takes 8KB as a bitmap, so the set is far smaller than one pointer per
+    // member.
+    ASSERT_LT(set.getMemUsage(), kNumIds * sizeof(void*) / 4);
+
+    for (int64_t i = 2; i <= kNumIds; i += 2) {
+        ASSERT_TRUE(set.erase(RecordId(i)));
+    }
+    ASSERT_EQ(static_cast<size_t>(kNumIds / 2), set.size());
+    ASSERT_TRUE(set.contains(RecordId(1)));
+    ASSERT_FALSE(set.contains(RecordId(2)));
+}
+
+TEST(RecordIdSetTest, MatchesStdSetForRandomIds) {
+    PseudoRandom random(1);
+    RecordIdSet set;
+    std::set<RecordId> expected;
+
+    for (int i = 0; i < 50 * 1000; ++i) {
+        // Draw from a range that spans a few containers so that some of them turn into bitmaps.
+        const RecordId id(random.nextInt64(4 * (1 << 16)));
+        if (random.nextInt32(4) == 0) {
+            ASSERT_EQ(expected.erase(id) == 1, set.erase(id));
+        } else {
+            ASSERT_EQ(expected.insert(id).second, set.insert(id));
+        }
+        ASSERT_EQ(expected.size(), set.size());
+    }
+
+    for (int64_t i = 0; i < 4 * (1 << 16); ++i) {
+        ASSERT_EQ(expected.count(RecordId(i)) == 1, set.contains(RecordId(i)));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -29,16 +29,16 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/scoped_timer.h"
-#include "mongo/util/clock_source.h"
 
 namespace mongo {
 
-ScopedTimer::ScopedTimer(ClockSource* cs, long long* counter)
-    : _clock(cs), _counter(counter), _start(cs->now()) {}
+ScopedTimer::ScopedTimer(TickSource* ts, long long* counterNanos)
+    : _tickSource(ts), _counter(counterNanos), _start(ts->getTicks()) {}
 
 ScopedTimer::~ScopedTimer() {
-    long long elapsed = durationCount<Milliseconds>(_clock->now() - _start);
-    *_counter += elapsed;
+    const TickSource::Tick elapsed = _tickSource->getTicks() - _start;
+    const double nanosPerTick = 1.0e9 / _tickSource->getTicksPerSecond();
+    *_counter += static_cast<long long>(elapsed * nanosPerTick);
 }
 
 }  // namespace mongo
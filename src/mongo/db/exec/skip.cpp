@@ -27,6 +27,9 @@
 */
 
 #include "mongo/db/exec/skip.h"
+
+#include <algorithm>
+
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/stdx/memory.h"
@@ -87,6 +90,31 @@ PlanStage::StageState SkipStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState SkipStage::doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) {
+    StageState status = child()->workBatch(ws, maxWorks, batch);
+
+    if (_toSkip > 0) {
+        const auto numToDrop = std::min(batch->ids.size(), static_cast<size_t>(_toSkip));
+        for (size_t i = 0; i < numToDrop; ++i) {
+            _ws->free(batch->ids[i]);
+        }
+        batch->ids.erase(batch->ids.begin(), batch->ids.begin() + numToDrop);
+        _toSkip -= numToDrop;
+
+        if (PlanStage::ADVANCED == status && batch->ids.empty()) {
+            status = PlanStage::NEED_TIME;
+        }
+    }
+
+    if ((PlanStage::FAILURE == status || PlanStage::DEAD == status) &&
+        WorkingSet::INVALID_ID == batch->stateId) {
+        Status status(ErrorCodes::InternalError,
+                      "skip stage failed to read in results from child");
+        batch->stateId = WorkingSetCommon::allocateStatusMember(_ws, status);
+    }
+    return status;
+}
+
 unique_ptr<PlanStageStats> SkipStage::getStats() {
     _commonStats.isEOF = isEOF();
     _specificStats.skip = _toSkip;
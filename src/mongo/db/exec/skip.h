@@ -48,6 +48,7 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSet* ws, size_t maxWorks, WorkBatch* batch) final;
 
     StageType stageType() const final {
         return STAGE_SKIP;
@@ -67,6 +67,37 @@ bool SortStage::WorkingSetComparator::operator()(const SortableDataItem& lhs,
     return lhs.recordId < rhs.recordId;
 }
 
+namespace {
+
+/**
+ * Results which carry computed data other than their sort key can't be rebuilt from a spilled
+ * document.
+ */
+bool canSpill(const WorkingSetMember& member) {
+    for (int i = 0; i < WSM_COMPUTED_NUM_TYPES; ++i) {
+        const auto type = static_cast<WorkingSetComputedDataType>(i);
+        if (WSM_SORT_KEY != type && member.hasComputed(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+SortStage::SpillComparator::SpillComparator(BSONObj pattern) {
+    // The trailing RecordId breaks ties, in ascending order as in WorkingSetComparator.
+    BSONObjBuilder patternBob;
+    patternBob.appendElements(pattern);
+    patternBob.append("$recordId", 1);
+    _pattern = patternBob.obj();
+}
+
+int SortStage::SpillComparator::operator()(const Data& lhs, const Data& rhs) const {
+    // False means ignore field names.
+    return lhs.first.woCompare(rhs.first, _pattern, false);
+}
+
 SortStage::SortStage(OperationContext* opCtx,
                      const SortStageParams& params,
                      WorkingSet* ws,
@@ -78,7 +109,9 @@ SortStage::SortStage(OperationContext* opCtx,
       _limit(params.limit),
       _sorted(false),
       _resultIterator(_data.end()),
-      _memUsage(0) {
+      _memUsage(0),
+      _allowDiskUse(params.allowDiskUse),
+      _tempDir(params.tempDir) {
     _children.emplace_back(child);
 
     BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
@@ -97,18 +130,31 @@ SortStage::~SortStage() {}
 bool SortStage::isEOF() {
     // We're done when our child has no more results, we've sorted the child's results, and
     // we've returned all sorted results.
-    return child()->isEOF() && _sorted && (_data.end() == _resultIterator);
+    if (!child()->isEOF() || !_sorted) {
+        return false;
+    }
+    return _spillIterator ? !_spillIterator->more() : (_data.end() == _resultIterator);
 }
 
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
     if (_memUsage > maxBytes) {
-        mongoutils::str::stream ss;
-        ss << "Sort operation used more than the maximum " << maxBytes
-           << " bytes of RAM. Add an index, or specify a smaller limit.";
-        Status status(ErrorCodes::OperationFailed, ss);
-        *out = WorkingSetCommon::allocateStatusMember(_ws, status);
-        return PlanStage::FAILURE;
+        // A sort with a limit of one never holds more than a single result, so spilling would
+        // not help it.
+        Status status = Status::OK();
+        if (_allowDiskUse && _limit != 1) {
+            status = spill();
+        } else {
+            mongoutils::str::stream ss;
+            ss << "Sort operation used more than the maximum " << maxBytes
+               << " bytes of RAM. Add an index, or specify a smaller limit.";
+            status = Status(ErrorCodes::OperationFailed, ss);
+        }
+
+        if (!status.isOK()) {
+            *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+            return PlanStage::FAILURE;
+        }
     }
 
     if (isEOF()) {
@@ -148,14 +194,31 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
                 item.recordId = member->recordId;
             }
 
-            addToBuffer(item);
+            if (_sorter) {
+                if (!canSpill(*member)) {
+                    Status status(ErrorCodes::OperationFailed,
+                                  "Sort operation spilled to disk but its input carries metadata "
+                                  "which can't be written to disk. Add an index, or specify a "
+                                  "smaller limit.");
+                    *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+                    return PlanStage::FAILURE;
+                }
+                member->makeObjOwnedIfNeeded();
+                addToSorter(item);
+            } else {
+                addToBuffer(item);
+            }
 
             return PlanStage::NEED_TIME;
         } else if (PlanStage::IS_EOF == code) {
             // TODO: We don't need the lock for this.  We could ask for a yield and do this work
             // unlocked.  Also, this is performing a lot of work for one call to work(...)
-            sortBuffer();
-            _resultIterator = _data.begin();
+            if (_sorter) {
+                _spillIterator.reset(_sorter->done());
+            } else {
+                sortBuffer();
+                _resultIterator = _data.begin();
+            }
             _sorted = true;
             return PlanStage::NEED_TIME;
         } else if (PlanStage::FAILURE == code || PlanStage::DEAD == code) {
@@ -178,8 +241,13 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     }
 
     // Returning results.
-    verify(_resultIterator != _data.end());
     verify(_sorted);
+    if (_spillIterator) {
+        *out = makeMemberFromSpilled();
+        return PlanStage::ADVANCED;
+    }
+
+    verify(_resultIterator != _data.end());
     *out = _resultIterator->wsid;
     _resultIterator++;
 
@@ -221,7 +289,8 @@ unique_ptr<PlanStageStats> SortStage::getStats() {
     _commonStats.isEOF = isEOF();
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
     _specificStats.memLimit = maxBytes;
-    _specificStats.memUsage = _memUsage;
+    _specificStats.memUsage = _sorter ? _sorter->memUsed() : _memUsage;
+    _specificStats.usedDisk = _sorter && _sorter->numFiles() > 0;
     _specificStats.limit = _limit;
     _specificStats.sortPattern = _pattern.getOwned();
 
@@ -340,4 +409,80 @@ void SortStage::sortBuffer() {
     }
 }
 
+Status SortStage::spill() {
+    invariant(!_sorter);
+
+    std::vector<SortableDataItem> items;
+    items.swap(_data);
+    if (_dataSet) {
+        items.insert(items.end(), _dataSet->begin(), _dataSet->end());
+        _dataSet->clear();
+    }
+
+    for (auto&& item : items) {
+        if (!canSpill(*_ws->get(item.wsid))) {
+            // Put the data back so that the WSMs are still tracked for invalidations.
+            _data.swap(items);
+            return Status(ErrorCodes::OperationFailed,
+                          "Sort operation used more than the maximum RAM but its input carries "
+                          "metadata which can't be written to disk. Add an index, or specify a "
+                          "smaller limit.");
+        }
+    }
+
+    const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
+    _sorter.reset(SpillSorter::make(SortOptions()
+                                        .Limit(_limit)
+                                        .MaxMemoryUsageBytes(maxBytes)
+                                        .ExtSortAllowed()
+                                        .TempDir(_tempDir),
+                                    SpillComparator(_sortKeyComparator->pattern)));
+    for (auto&& item : items) {
+        addToSorter(item);
+    }
+    _memUsage = 0;
+
+    LOG(1) << "Sort operation exceeded " << maxBytes << " bytes of RAM, spilling to disk";
+    return Status::OK();
+}
+
+void SortStage::addToSorter(const SortableDataItem& item) {
+    BSONObjBuilder keyBob;
+    keyBob.appendElements(item.sortKey);
+    keyBob.append("", item.recordId.repr());
+
+    WorkingSetMember* member = _ws->get(item.wsid);
+    _sorter->add(keyBob.obj(), member->obj.value().getOwned());
+
+    if (member->hasRecordId()) {
+        _wsidByRecordId.erase(member->recordId);
+    }
+    _ws->free(item.wsid);
+}
+
+WorkingSetID SortStage::makeMemberFromSpilled() {
+    SpillSorter::Data data = _spillIterator->next();
+
+    // Drop the RecordId, which is the last element of the key.
+    BSONObjBuilder sortKeyBob;
+    BSONObjIterator keyIt(data.first);
+    while (keyIt.more()) {
+        BSONElement elt = keyIt.next();
+        if (keyIt.more()) {
+            sortKeyBob.append(elt);
+        }
+    }
+
+    // The document may have changed since it was buffered, so it doesn't belong to any snapshot.
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), data.second.getOwned());
+    _ws->transitionToOwnedObj(id);
+    member->addComputed(new SortKeyComputedData(sortKeyBob.obj()));
+    return id;
+}
+
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
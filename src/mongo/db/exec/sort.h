@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -37,6 +39,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/platform/unordered_map.h"
 
 namespace mongo {
@@ -46,7 +49,7 @@ class BtreeKeyGenerator;
 // Parameters that must be provided to a SortStage
 class SortStageParams {
 public:
-    SortStageParams() : collection(NULL), limit(0) {}
+    SortStageParams() : collection(NULL), limit(0), allowDiskUse(false) {}
 
     // Used for resolving RecordIds to BSON
     const Collection* collection;
@@ -56,6 +59,11 @@ public:
 
     // Equal to 0 for no limit.
     size_t limit;
+
+    // Whether the sort may write its buffered results to files in 'tempDir' instead of failing
+    // once they exceed internalQueryExecMaxBlockingSortBytes.
+    bool allowDiskUse;
+    std::string tempDir;
 };
 
 /**
@@ -65,6 +73,10 @@ public:
  *   -- For each field in 'pattern', all inputs in the child must handle a getFieldDotted for that
  *   field.
  *   -- All WSMs produced by the child stage must have the sort key available as WSM computed data.
+ *
+ * If allowed to use disk, the stage moves everything it has buffered into an external Sorter once
+ * it runs out of memory. From then on the results are owned documents which no longer carry their
+ * RecordId, as the stage can't see invalidations of results held on disk.
  */
 class SortStage final : public PlanStage {
 public:
@@ -152,6 +164,38 @@ private:
      */
     void sortBuffer();
 
+    // Orders spilled results on their keys, which are the sort key followed by the RecordId.
+    class SpillComparator {
+    public:
+        typedef std::pair<BSONObj, BSONObj> Data;
+
+        explicit SpillComparator(BSONObj pattern);
+
+        int operator()(const Data& lhs, const Data& rhs) const;
+
+    private:
+        BSONObj _pattern;
+    };
+
+    // Maps a sort key with the RecordId appended to the document.
+    typedef Sorter<BSONObj, BSONObj> SpillSorter;
+
+    /**
+     * Moves every buffered result into '_sorter', which is created here, and frees their WSMs.
+     * Fails if a buffered result can't be reconstructed from its document and sort key alone.
+     */
+    Status spill();
+
+    /**
+     * Adds 'item' to '_sorter' and frees its WSM.
+     */
+    void addToSorter(const SortableDataItem& item);
+
+    /**
+     * Returns the next result of '_spillIterator' in a newly allocated WSM.
+     */
+    WorkingSetID makeMemberFromSpilled();
+
     // Comparator for data buffer
     // Initialization follows sort key generator
     std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
@@ -178,6 +222,14 @@ private:
 
     // The usage in bytes of all buffered data that we're sorting.
     size_t _memUsage;
+
+    const bool _allowDiskUse;
+    const std::string _tempDir;
+
+    // Set once the buffered data has been spilled. All further input goes to '_sorter', and the
+    // results are read back through '_spillIterator'.
+    std::unique_ptr<SpillSorter> _sorter;
+    std::unique_ptr<SpillSorter::Iterator> _spillIterator;
 };
 
 }  // namespace mongo
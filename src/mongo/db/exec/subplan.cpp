@@ -37,6 +37,7 @@
 
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/exec/multi_plan.h"
+#include "mongo/db/exec/scoped_storage_stats.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/get_executor.h"
@@ -499,9 +500,11 @@ Status SubplanStage::choosePlanWholeQuery(PlanYieldPolicy* yieldPolicy) {
 }
 
 Status SubplanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
-    // Adds the amount of time taken by pickBestPlan() to executionTimeMillis. There's lots of
-    // work that happens here, so this is needed for the time accounting to make sense.
-    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    // Adds the time taken and the storage engine work done by pickBestPlan() to this stage's
+    // stats. There's lots of execution work that happens here, so this is needed for the
+    // accounting to make sense.
+    ScopedTimer timer(getTickSource(), &_commonStats.executionTimeNanos);
+    ScopedStorageStats storageStats(getOpCtx(), &_commonStats.storageStats);
 
     // Plan each branch of the $or.
     Status subplanningStatus = planSubqueries();
@@ -95,7 +95,19 @@ const SpecificStats* TextStage::getSpecificStats() const {
 unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
                                                WorkingSet* ws,
                                                const MatchExpression* filter) const {
-    auto textScorer = make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, _params.index);
+    // If the TEXT_MATCH stage may reject documents, the TEXT_OR stage has to apply the same checks
+    // before it can stop at the best scoring 'limit' documents.
+    const bool textMatchMayReject = !_params.query.getNegatedTerms().empty() ||
+        !_params.query.getPositivePhr().empty() || !_params.query.getNegatedPhr().empty() ||
+        _params.query.getCaseSensitive() || _params.query.getDiacriticSensitive();
+
+    auto textScorer = make_unique<TextOrStage>(opCtx,
+                                               _params.spec,
+                                               ws,
+                                               filter,
+                                               _params.index,
+                                               _params.limit,
+                                               textMatchMayReject ? &_params.query : nullptr);
 
     // Get all the index scans for each term in our query.
     for (const auto& term : _params.query.getTermsForBounds()) {
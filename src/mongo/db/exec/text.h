@@ -62,6 +62,9 @@ struct TextStageParams {
 
     // The text query.
     FTSQueryImpl query;
+
+    // If non-zero, only the 'limit' highest scoring documents are needed by the parent.
+    size_t limit = 0;
 };
 
 /**
@@ -28,6 +28,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -58,14 +59,21 @@ TextOrStage::TextOrStage(OperationContext* opCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         IndexDescriptor* index)
+                         IndexDescriptor* index,
+                         size_t limit,
+                         const fts::FTSQueryImpl* limitQuery)
     : PlanStage(kStageType, opCtx),
       _ftsSpec(ftsSpec),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _limit(limit),
       _filter(filter),
       _idRetrying(WorkingSet::INVALID_ID),
-      _index(index) {}
+      _index(index) {
+    if (_limit && limitQuery) {
+        _limitMatcher = stdx::make_unique<fts::FTSMatcher>(*limitQuery, _ftsSpec);
+    }
+}
 
 TextOrStage::~TextOrStage() {}
 
@@ -206,6 +214,15 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         _scoreIterator = _scores.begin();
         _internalState = State::kReturningResults;
 
+        if (_limit) {
+            for (const auto& scoreEntry : _scores) {
+                if (scoreEntry.second.score >= 0) {
+                    _bestResults.emplace_back(scoreEntry.second.score, scoreEntry.first);
+                }
+            }
+            std::make_heap(_bestResults.begin(), _bestResults.end());
+        }
+
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childState) {
         // If a stage fails, it may create a status WSM to indicate why it
@@ -228,6 +245,10 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
 }
 
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
+    if (_limit) {
+        return returnBestResult(out);
+    }
+
     if (_scoreIterator == _scores.end()) {
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
@@ -251,6 +272,60 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState TextOrStage::returnBestResult(WorkingSetID* out) {
+    if (_numReturned == _limit || _bestResults.empty()) {
+        _internalState = State::kDone;
+        return PlanStage::IS_EOF;
+    }
+
+    const double score = _bestResults.front().first;
+    const RecordId recordId = _bestResults.front().second;
+
+    // Skip documents which were invalidated since the terms were read.
+    if (_scores.find(recordId) == _scores.end()) {
+        std::pop_heap(_bestResults.begin(), _bestResults.end());
+        _bestResults.pop_back();
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID wsid = _ws->allocate();
+    WorkingSetMember* wsm = _ws->get(wsid);
+    wsm->recordId = recordId;
+    _ws->transitionToRecordIdAndIdx(wsid);
+
+    bool stillMatches;
+    try {
+        stillMatches = WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor);
+    } catch (const WriteConflictException& wce) {
+        // The candidate stays on the heap, so the fetch is retried after yielding.
+        _ws->free(wsid);
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+    ++_specificStats.fetches;
+
+    std::pop_heap(_bestResults.begin(), _bestResults.end());
+    _bestResults.pop_back();
+
+    // The document may have been deleted or changed since the filter was applied to it.
+    if (stillMatches && _filter) {
+        stillMatches = _filter->matchesBSON(wsm->obj.value());
+    }
+    if (stillMatches && _limitMatcher) {
+        stillMatches = _limitMatcher->matches(wsm->obj.value());
+    }
+
+    if (!stillMatches) {
+        _ws->free(wsid);
+        return PlanStage::NEED_TIME;
+    }
+
+    ++_numReturned;
+    wsm->addComputed(new TextScoreComputedData(score));
+    *out = wsid;
+    return PlanStage::ADVANCED;
+}
+
 /**
  * Provides support for covered matching on non-text fields of a compound text index.
  */
@@ -340,7 +415,11 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         return NEED_TIME;
     }
 
-    if (WorkingSet::INVALID_ID == textRecordData->wsid) {
+    if (_limit && textRecordData->seen) {
+        // Documents are only fetched once the best scoring ones are known, so there is no working
+        // set member to keep for this RecordId.
+        _ws->free(wsid);
+    } else if (WorkingSet::INVALID_ID == textRecordData->wsid) {
         // We haven't seen this RecordId before.
         invariant(textRecordData->score == 0);
         bool shouldKeep = true;
@@ -374,7 +453,30 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             }
         }
 
-        if (shouldKeep && !wsm->hasObj()) {
+        if (_limit && shouldKeep && _limitMatcher) {
+            try {
+                if (!wsm->hasObj()) {
+                    shouldKeep = WorkingSetCommon::fetch(getOpCtx(), _ws, wsid, _recordCursor);
+                    ++_specificStats.fetches;
+                }
+                shouldKeep = shouldKeep && _limitMatcher->matches(wsm->obj.value());
+            } catch (const WriteConflictException& wce) {
+                wsm->makeObjOwnedIfNeeded();
+                _idRetrying = wsid;
+                *out = WorkingSet::INVALID_ID;
+                return NEED_YIELD;
+            }
+        }
+
+        if (_limit) {
+            // The document is fetched later if it turns out to be among the best scoring ones.
+            _ws->free(wsid);
+            if (!shouldKeep) {
+                textRecordData->score = -1;
+                return NEED_TIME;
+            }
+            textRecordData->seen = true;
+        } else if (shouldKeep && !wsm->hasObj()) {
             // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
             // already.
             try {
@@ -388,16 +490,18 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             }
         }
 
-        if (!shouldKeep) {
-            _ws->free(wsid);
-            textRecordData->score = -1;
-            return NEED_TIME;
-        }
+        if (!_limit) {
+            if (!shouldKeep) {
+                _ws->free(wsid);
+                textRecordData->score = -1;
+                return NEED_TIME;
+            }
 
-        textRecordData->wsid = wsid;
+            textRecordData->wsid = wsid;
 
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        wsm->makeObjOwnedIfNeeded();
+            // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
+            wsm->makeObjOwnedIfNeeded();
+        }
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
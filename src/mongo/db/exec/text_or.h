@@ -33,6 +33,8 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/fts/fts_matcher.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/expression.h"
@@ -52,6 +54,10 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If a limit is given, only the 'limit' highest scoring documents are returned, in no particular
+ * order. Only the scores are buffered while reading the terms, and only the returned documents
+ * are fetched, unless a filter or the text query needs them earlier.
  */
 class TextOrStage final : public PlanStage {
 public:
@@ -76,7 +82,9 @@ public:
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                IndexDescriptor* index);
+                IndexDescriptor* index,
+                size_t limit = 0,
+                const fts::FTSQueryImpl* limitQuery = nullptr);
     ~TextOrStage();
 
     void addChild(unique_ptr<PlanStage> child);
@@ -125,6 +133,12 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Worker for kReturningResults when there is a limit. Fetches and returns the best scoring
+     * document left.
+     */
+    StageState returnBestResult(WorkingSetID* out);
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -143,15 +157,33 @@ private:
      *  Map each buffered record id to this data.
      */
     struct TextRecordData {
-        TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
+        TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0), seen(false) {}
         WorkingSetID wsid;
         double score;
+
+        // Whether the filter has been applied to this document. Only used when there is a limit,
+        // since no working set member is kept for the document then.
+        bool seen;
     };
 
     typedef unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // If non-zero, the number of documents to return.
+    const size_t _limit;
+
+    // When there is a limit, checks the phrases and negated terms of the text query before a
+    // document can be counted among the best scoring ones. Documents rejected after the limit
+    // was applied could not be replaced.
+    std::unique_ptr<fts::FTSMatcher> _limitMatcher;
+
+    // The number of documents returned so far when there is a limit.
+    size_t _numReturned = 0;
+
+    // Max-heap of the (score, RecordId) candidates not yet returned when there is a limit.
+    std::vector<std::pair<double, RecordId>> _bestResults;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
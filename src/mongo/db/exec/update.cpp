@@ -535,11 +535,13 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     const auto createIdField = !_collection->isCapped();
 
     // Ensure if _id exists it is first
+    bool addedIdField = false;
     status = ensureIdFieldIsFirst(&_doc);
     if (status.code() == ErrorCodes::InvalidIdField) {
         // Create ObjectId _id field if we are doing that
         if (createIdField) {
             uassertStatusOK(addObjectIDIdField(&_doc));
+            addedIdField = true;
         }
     } else {
         uassertStatusOK(status);
@@ -617,6 +619,10 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 args.update = logObj;
                 args.criteria = idQuery;
                 args.fromMigrate = request->isFromMigration();
+                // A modifier-style update can only change the keys of the indexes on the fields
+                // it touched. A replacement, or an _id added above, may change any of them.
+                const FieldRefSet* modifiedPaths =
+                    (driver->isDocReplacement() || addedIdField) ? nullptr : &updatedFields;
                 StatusWith<RecordId> res = _collection->updateDocument(getOpCtx(),
                                                                        recordId,
                                                                        oldObj,
@@ -624,7 +630,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                                                        true,
                                                                        driver->modsAffectIndices(),
                                                                        _params.opDebug,
-                                                                       &args);
+                                                                       &args,
+                                                                       modifiedPaths);
                 uassertStatusOK(res.getStatus());
                 newRecordId = res.getValue();
             }
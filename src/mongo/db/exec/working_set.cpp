@@ -28,6 +28,8 @@
 
 #include "mongo/db/exec/working_set.h"
 
+#include <algorithm>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
@@ -39,26 +41,34 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+const size_t WorkingSet::kMinMembersPerBlock;
+const size_t WorkingSet::kMaxMembersPerBlock;
+const size_t WorkingSet::kMaxMembersKeptByClear;
+
 WorkingSet::MemberHolder::MemberHolder() : member(NULL) {}
 WorkingSet::MemberHolder::~MemberHolder() {}
 
 WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
-WorkingSet::~WorkingSet() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
-}
+WorkingSet::~WorkingSet() = default;
 
 WorkingSetID WorkingSet::allocate() {
     if (_freeList == INVALID_ID) {
         // The free list is empty so we need to make a single new WSM to return. This relies on
         // vector::resize being amortized O(1) for efficient allocation. Note that the free list
         // remains empty until something is returned by a call to free().
+        if (_lastBlockUsed == _lastBlockSize) {
+            _lastBlockSize = _memberBlocks.empty()
+                ? kMinMembersPerBlock
+                : std::min(2 * _lastBlockSize, kMaxMembersPerBlock);
+            _memberBlocks.emplace_back(new WorkingSetMember[_lastBlockSize]);
+            _lastBlockUsed = 0;
+        }
+
         WorkingSetID id = _data.size();
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
-        _data.back().member = new WorkingSetMember();
+        _data.back().member = &_memberBlocks.back()[_lastBlockUsed++];
         return id;
     }
 
@@ -96,14 +106,30 @@ bool WorkingSet::isFlagged(WorkingSetID id) const {
 }
 
 void WorkingSet::clear() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
-    _data.clear();
+    if (_data.size() > kMaxMembersKeptByClear) {
+        _data.clear();
+        _memberBlocks.clear();
+        _lastBlockSize = 0;
+        _lastBlockUsed = 0;
+
+        // Since working set is now empty, the free list pointer should
+        // point to nothing.
+        _freeList = INVALID_ID;
+    } else {
+        for (size_t i = 0; i < _data.size(); i++) {
+            if (!isFree(i)) {
+                _data[i].member->clear();
+            }
+        }
 
-    // Since working set is now empty, the free list pointer should
-    // point to nothing.
-    _freeList = INVALID_ID;
+        // Thread every member onto the free list, lowest id first, so that ids are handed out
+        // in the same order as by a new WorkingSet.
+        _freeList = INVALID_ID;
+        for (size_t i = _data.size(); i > 0; --i) {
+            _data[i - 1].nextFreeOrSelf = _freeList;
+            _freeList = i - 1;
+        }
+    }
 
     _flagged.clear();
     _yieldSensitiveIds.clear();
@@ -147,6 +173,10 @@ void WorkingSetMember::clear() {
 
     keyData.clear();
     obj.reset();
+    recordId = RecordId();
+    isSuspicious = false;
+    _fetcher.reset();
+    _objFieldIndex = boost::none;
     _state = WorkingSetMember::INVALID;
 }
 
@@ -208,7 +238,20 @@ bool WorkingSetMember::hasFetcher() const {
 bool WorkingSetMember::getFieldDotted(const string& field, BSONElement* out) const {
     // If our state is such that we have an object, use it.
     if (hasObj()) {
-        *out = dps::extractElementAtPath(obj.value(), field);
+        // The same as dps::extractElementAtPath(), but looking up the top-level fields in the
+        // member's field index.
+        const BSONFieldIndex& fieldIndex = getObjFieldIndex();
+        *out = fieldIndex.getField(field);
+        if (out->eoo()) {
+            size_t dotOffset = field.find('.');
+            if (dotOffset != std::string::npos) {
+                BSONElement sub = fieldIndex.getField(StringData(field).substr(0, dotOffset));
+                if (sub.type() == Object || sub.type() == Array) {
+                    *out = dps::extractElementAtPath(sub.embeddedObject(),
+                                                     StringData(field).substr(dotOffset + 1));
+                }
+            }
+        }
         return true;
     }
 
@@ -232,6 +275,14 @@ bool WorkingSetMember::getFieldDotted(const string& field, BSONElement* out) con
     return false;
 }
 
+const BSONFieldIndex& WorkingSetMember::getObjFieldIndex() const {
+    invariant(hasObj());
+    if (!_objFieldIndex || !_objFieldIndex->isIndexOf(obj.value())) {
+        _objFieldIndex.emplace(obj.value());
+    }
+    return *_objFieldIndex;
+}
+
 size_t WorkingSetMember::getMemUsage() const {
     size_t memUsage = 0;
 
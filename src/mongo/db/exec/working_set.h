@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <memory>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
@@ -113,7 +116,8 @@ public:
     const unordered_set<WorkingSetID>& getFlagged() const;
 
     /**
-     * Removes and deallocates all members of this working set.
+     * Removes all members of this working set. Their storage is kept for reuse unless there was
+     * a lot of it.
      */
     void clear();
 
@@ -147,10 +151,25 @@ private:
         // Free list link if freed. Points to self if in use.
         WorkingSetID nextFreeOrSelf;
 
-        // Owning pointer
+        // Points into one of '_memberBlocks'.
         WorkingSetMember* member;
     };
 
+    // The first block of members holds this many; each block after it is twice as large as the
+    // one before, up to kMaxMembersPerBlock.
+    static const size_t kMinMembersPerBlock = 8;
+    static const size_t kMaxMembersPerBlock = 512;
+
+    // clear() gives the members back to the heap rather than keeping them once there are more
+    // than this many.
+    static const size_t kMaxMembersKeptByClear = 4096;
+
+    // Storage for the members. Their number only grows, and allocating them in blocks costs a
+    // heap allocation per block rather than one per member.
+    std::vector<std::unique_ptr<WorkingSetMember[]>> _memberBlocks;
+    size_t _lastBlockSize = 0;
+    size_t _lastBlockUsed = 0;
+
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
     // Elements are added to _freeList rather than removed when freed.
     std::vector<MemberHolder> _data;
@@ -326,6 +345,13 @@ public:
      */
     bool getFieldDotted(const std::string& field, BSONElement* out) const;
 
+    /**
+     * Returns an index of the top-level fields of 'obj', shared by the stages which look up
+     * fields of this member. It is built again if 'obj' has been replaced since the last call.
+     * Only valid until 'obj' is next modified. Must only be called if hasObj() is true.
+     */
+    const BSONFieldIndex& getObjFieldIndex() const;
+
     /**
      * Returns expected memory usage of working set member.
      */
@@ -339,6 +365,8 @@ private:
     std::unique_ptr<WorkingSetComputedData> _computed[WSM_COMPUTED_NUM_TYPES];
 
     std::unique_ptr<RecordFetcher> _fetcher;
+
+    mutable boost::optional<BSONFieldIndex> _objFieldIndex;
 };
 
 }  // namespace mongo
@@ -105,7 +105,19 @@ bool WorkingSetCommon::fetch(OperationContext* opCtx,
         return false;
     }
 
-    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
+    return fetchFromRecord(opCtx, workingSet, id, *record);
+}
+
+// static
+bool WorkingSetCommon::fetchFromRecord(OperationContext* opCtx,
+                                       WorkingSet* workingSet,
+                                       WorkingSetID id,
+                                       const Record& record) {
+    WorkingSetMember* member = workingSet->get(id);
+    invariant(member->hasRecordId());
+    invariant(record.id == member->recordId);
+
+    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), record.data.toBson()};
 
     if (member->isSuspicious) {
         // Make sure that all of the keyData is still valid for this copy of the document.
@@ -37,6 +37,7 @@ class CanonicalQuery;
 class Collection;
 class OperationContext;
 class SeekableRecordCursor;
+struct Record;
 
 class WorkingSetCommon {
 public:
@@ -75,6 +76,15 @@ public:
                       WorkingSetID id,
                       unowned_ptr<SeekableRecordCursor> cursor);
 
+    /**
+     * Like fetch(), but uses 'record', which the caller has already looked up by the member's
+     * RecordId, rather than reading the document through a cursor.
+     */
+    static bool fetchFromRecord(OperationContext* opCtx,
+                                WorkingSet* workingSet,
+                                WorkingSetID id,
+                                const Record& record);
+
     static bool fetchIfUnfetched(OperationContext* opCtx,
                                  WorkingSet* workingSet,
                                  WorkingSetID id,
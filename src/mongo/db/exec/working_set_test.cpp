@@ -32,6 +32,9 @@
 
 
 #include "mongo/db/exec/working_set.h"
+
+#include <vector>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
 #include "mongo/db/storage/snapshot.h"
@@ -154,4 +157,53 @@ TEST_F(WorkingSetFixture, getDottedFieldFromIndex) {
     ASSERT_FALSE(member->getFieldDotted("y", &elt));
 }
 
+// Members are reused once freed, and come back cleared.
+TEST(WorkingSetTest, FreedMembersAreReused) {
+    WorkingSet ws;
+    WorkingSetID first = ws.allocate();
+    WorkingSetMember* member = ws.get(first);
+    member->recordId = RecordId(42);
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("a" << 1));
+    member->isSuspicious = true;
+    ws.transitionToRecordIdAndObj(first);
+    ws.free(first);
+    ASSERT_TRUE(ws.isFree(first));
+
+    ASSERT_EQUALS(first, ws.allocate());
+    ASSERT_EQUALS(member, ws.get(first));
+    ASSERT_EQUALS(WorkingSetMember::INVALID, member->getState());
+    ASSERT_TRUE(member->recordId.isNull());
+    ASSERT_TRUE(member->obj.value().isEmpty());
+    ASSERT_FALSE(member->isSuspicious);
+}
+
+// Members allocated over several blocks stay where they are, and clear() hands them out again
+// in the order of a new WorkingSet.
+TEST(WorkingSetTest, ClearKeepsMembers) {
+    WorkingSet ws;
+    std::vector<WorkingSetID> ids;
+    std::vector<WorkingSetMember*> members;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(ws.allocate());
+        members.push_back(ws.get(ids.back()));
+        members.back()->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("i" << i));
+        ws.transitionToOwnedObj(ids.back());
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQUALS(members[i], ws.get(ids[i]));
+        ASSERT_EQUALS(i, members[i]->obj.value()["i"].numberInt());
+    }
+
+    ws.free(ids[7]);
+    ws.clear();
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ws.isFree(ids[i]));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQUALS(ids[i], ws.allocate());
+        ASSERT_EQUALS(members[i], ws.get(ids[i]));
+        ASSERT_EQUALS(WorkingSetMember::INVALID, members[i]->getState());
+    }
+}
+
 }  // namespace
@@ -46,6 +46,10 @@
 
 namespace mongo {
 
+const size_t FTDCController::kMaxPeriodicStreamSamples;
+const size_t FTDCController::kMaxFastStreamSamples;
+const size_t FTDCController::kMaxPendingSamples;
+
 void FTDCController::setEnabled(bool enabled) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.enabled = enabled;
@@ -57,6 +61,12 @@ void FTDCController::setPeriod(Milliseconds millis) {
     _condvar.notify_one();
 }
 
+void FTDCController::setFastPeriod(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.fastPeriod = millis;
+    _fastCondvar.notify_one();
+}
+
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
@@ -90,6 +100,16 @@ void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addFastCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _fastCollectors.add(std::move(collector));
+        _hasFastCollectors = true;
+    }
+}
+
 void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
@@ -106,12 +126,45 @@ BSONObj FTDCController::getMostRecentPeriodicDocument() {
     }
 }
 
+std::vector<FTDCController::StreamSample> FTDCController::getStreamSamples(
+    Stream stream, long long afterId, size_t maxBytes, long long* firstAvailableId) {
+    const auto index = static_cast<size_t>(stream);
+    std::vector<StreamSample> result;
+
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    const auto& samples = _streamSamples[index];
+
+    *firstAvailableId = samples.empty() ? _nextStreamSampleId[index] : samples.front().id;
+
+    size_t bytes = 0;
+    for (const auto& sample : samples) {
+        if (sample.id <= afterId) {
+            continue;
+        }
+
+        const size_t size = sample.doc.objsize();
+        if (!result.empty() && bytes + size > maxBytes) {
+            break;
+        }
+
+        bytes += size;
+        result.push_back(sample);
+    }
+
+    return result;
+}
+
 void FTDCController::start() {
     log() << "Initializing full-time diagnostic data capture with directory '"
           << _path.generic_string() << "'";
 
-    // Start the thread
+    // Start the threads
     _thread = stdx::thread(stdx::bind(&FTDCController::doLoop, this));
+    _writerThread = stdx::thread(stdx::bind(&FTDCController::doWriteLoop, this));
+
+    if (_hasFastCollectors) {
+        _fastThread = stdx::thread(stdx::bind(&FTDCController::doFastLoop, this));
+    }
 
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
@@ -139,12 +192,27 @@ void FTDCController::stop() {
         _configTemp.enabled = false;
         _state = State::kStopRequested;
 
-        // Wake up the thread if sleeping so that it will check if we are done
+        // Wake up the threads if sleeping so that they will check if we are done
         _condvar.notify_one();
+        _fastCondvar.notify_one();
+        _pendingSamplesCondvar.notify_all();
     }
 
     _thread.join();
 
+    if (_fastThread.joinable()) {
+        _fastThread.join();
+    }
+
+    // Let the writer finish writing the samples already collected before it exits
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        _writerStopRequested = true;
+        _pendingSamplesCondvar.notify_all();
+    }
+
+    _writerThread.join();
+
     _state = State::kDone;
 
     if (_mgr) {
@@ -203,26 +271,24 @@ void FTDCController::doLoop() {
             // TODO: consider only running this thread if we are enabled
             // for now, we just keep an idle thread as it is simplier
             if (_config.enabled) {
-                // Delay initialization of FTDCFileManager until we are sure the user has enabled
-                // FTDC
-                if (!_mgr) {
-                    auto swMgr =
-                        FTDCFileManager::create(&_config, _path, &_rotateCollectors, client);
-
-                    _mgr = uassertStatusOK(std::move(swMgr));
-                }
-
                 auto collectSample = _periodicCollectors.collect(client);
 
-                Status s = _mgr->writeSampleAndRotateIfNeeded(
-                    client, std::get<0>(collectSample), std::get<1>(collectSample));
-
-                uassertStatusOK(s);
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
 
                 // Store a reference to the most recent document from the periodic collectors
-                {
-                    stdx::lock_guard<stdx::mutex> lock(_mutex);
-                    _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                _addStreamSample(lock, Stream::kPeriodic, std::get<0>(collectSample));
+
+                // Hand the sample to the writer thread. If the writer has fallen far behind, wait
+                // for it rather than hold an unbounded number of samples in memory.
+                _pendingSamplesCondvar.wait(lock, [this] {
+                    return _pendingSamples.size() < kMaxPendingSamples || _writerFailed ||
+                        _state == State::kStopRequested;
+                });
+
+                if (!_writerFailed) {
+                    _pendingSamples.push_back(std::move(collectSample));
+                    _pendingSamplesCondvar.notify_all();
                 }
             }
         }
@@ -233,4 +299,115 @@ void FTDCController::doLoop() {
     }
 }
 
+void FTDCController::doWriteLoop() {
+    try {
+        Client::initThread("ftdcWriter");
+        Client* client = &cc();
+
+        while (true) {
+            std::tuple<BSONObj, Date_t> sample;
+
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+
+                _pendingSamplesCondvar.wait(
+                    lock, [this] { return !_pendingSamples.empty() || _writerStopRequested; });
+
+                // We are only asked to stop once no more samples will be collected, so we are
+                // done once we have written all of them
+                if (_pendingSamples.empty()) {
+                    break;
+                }
+
+                sample = std::move(_pendingSamples.front());
+                _pendingSamples.pop_front();
+                _pendingSamplesCondvar.notify_all();
+
+                // Pick up the configuration settings the collection thread last saw
+                _writerConfig = _config;
+            }
+
+            // Delay initialization of FTDCFileManager until we are sure the user has enabled
+            // FTDC
+            if (!_mgr) {
+                auto swMgr =
+                    FTDCFileManager::create(&_writerConfig, _path, &_rotateCollectors, client);
+
+                _mgr = uassertStatusOK(std::move(swMgr));
+            }
+
+            Status s = _mgr->writeSampleAndRotateIfNeeded(
+                client, std::get<0>(sample), std::get<1>(sample));
+
+            uassertStatusOK(s);
+        }
+    } catch (...) {
+        warning() << "Uncaught exception in '" << exceptionToStatus()
+                  << "' in full-time diagnostic data capture writer. No more diagnostic data will "
+                     "be written to disk.";
+
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        _writerFailed = true;
+        _pendingSamples.clear();
+        _pendingSamplesCondvar.notify_all();
+    }
+}
+
+void FTDCController::doFastLoop() {
+    try {
+        Client::initThread("ftdcFast");
+        Client* client = &cc();
+
+        while (true) {
+            auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+
+                auto next_time = FTDCUtil::roundTime(now, _configTemp.fastPeriod);
+
+                // We ignore spurious wakeups by just doing an iteration of the loop
+                auto status = _fastCondvar.wait_until(lock, next_time.toSystemTimePoint());
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+
+                // If we were signalled, then we have a config update only
+                if (status == stdx::cv_status::no_timeout || !_configTemp.enabled) {
+                    continue;
+                }
+            }
+
+            auto collectSample = _fastCollectors.collect(client);
+
+            stdx::unique_lock<stdx::mutex> lock(_mutex);
+            _addStreamSample(lock, Stream::kFast, std::get<0>(collectSample));
+        }
+    } catch (...) {
+        warning() << "Uncaught exception in '" << exceptionToStatus()
+                  << "' in full-time diagnostic data capture fast collection. Shutting down fast "
+                     "collection.";
+    }
+}
+
+void FTDCController::_addStreamSample(const stdx::unique_lock<stdx::mutex>& lock,
+                                      Stream stream,
+                                      BSONObj doc) {
+    if (doc.isEmpty()) {
+        return;
+    }
+
+    const auto index = static_cast<size_t>(stream);
+    const size_t maxSamples =
+        stream == Stream::kPeriodic ? kMaxPeriodicStreamSamples : kMaxFastStreamSamples;
+
+    auto& samples = _streamSamples[index];
+    if (samples.size() >= maxSamples) {
+        samples.pop_front();
+    }
+
+    samples.push_back({_nextStreamSampleId[index]++, std::move(doc)});
+}
+
 }  // namespace mongo
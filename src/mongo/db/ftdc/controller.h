@@ -30,7 +30,11 @@
 
 #include <boost/filesystem/path.hpp>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/ftdc/collector.h"
@@ -49,14 +53,53 @@ class ServiceContext;
  * Responsible for periodic collection of samples, writing them to disk,
  * and rotation.
  *
+ * Samples are collected on one thread and compressed and written to disk on another, so that the
+ * time to compress and write a sample does not delay the next collection. The most recent samples
+ * are also kept in memory for getDiagnosticDataStream, as are the samples of the fast collectors,
+ * which are collected more often and never written to disk.
+ *
  * Exposes an methods to response to configuration changes in a thread-safe manner.
  */
 class FTDCController {
     MONGO_DISALLOW_COPYING(FTDCController);
 
 public:
+    /**
+     * The streams of samples kept in memory.
+     */
+    enum class Stream {
+        // Samples of the periodic collectors, which are also written to disk.
+        kPeriodic,
+
+        // Samples of the fast collectors.
+        kFast,
+    };
+
+    /**
+     * Number of samples kept in memory for each stream.
+     */
+    static const size_t kMaxPeriodicStreamSamples = 60;
+    static const size_t kMaxFastStreamSamples = 600;
+
+    /**
+     * Number of collected samples which may be waiting to be written to disk. The collection
+     * thread waits for the writer thread once there are this many.
+     */
+    static const size_t kMaxPendingSamples = 60;
+
+    /**
+     * A sample of a stream, numbered in the order it was collected.
+     */
+    struct StreamSample {
+        long long id;
+        BSONObj doc;
+    };
+
     FTDCController(const boost::filesystem::path path, FTDCConfig config)
-        : _path(path), _config(std::move(config)), _configTemp(_config) {}
+        : _path(path),
+          _config(std::move(config)),
+          _configTemp(_config),
+          _writerConfig(_config) {}
 
     ~FTDCController() = default;
 
@@ -70,6 +113,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for collection by the fast collectors.
+     */
+    void setFastPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -99,6 +147,12 @@ public:
      */
     void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a metric collector to collect every fast period, for the fast stream only. These should
+     * be cheap, i.e. a few serverStatus sections.
+     */
+    void addFastCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
      *
@@ -130,12 +184,39 @@ public:
      */
     BSONObj getMostRecentPeriodicDocument();
 
+    /**
+     * Get the samples of 'stream' numbered after 'afterId', oldest first, up to a total of
+     * 'maxBytes' of documents. At least one sample is returned if there is any.
+     *
+     * Sets 'firstAvailableId' to the number of the oldest sample still kept, or of the next
+     * sample if there is none, so callers can tell whether they missed any.
+     */
+    std::vector<StreamSample> getStreamSamples(Stream stream,
+                                               long long afterId,
+                                               size_t maxBytes,
+                                               long long* firstAvailableId);
+
 private:
     /**
-     * Do periodic statistics collection, and all other work on the background thread.
+     * Do periodic statistics collection on the background thread.
      */
     void doLoop();
 
+    /**
+     * Compress and write the collected samples to disk on the writer thread.
+     */
+    void doWriteLoop();
+
+    /**
+     * Do fast statistics collection on the fast collection thread.
+     */
+    void doFastLoop();
+
+    /**
+     * Add a sample to the in-memory stream, dropping the oldest if full. Requires _mutex.
+     */
+    void _addStreamSample(const stdx::unique_lock<stdx::mutex>& lock, Stream stream, BSONObj doc);
+
 private:
     /**
     * Private enum to track state.
@@ -174,7 +255,8 @@ private:
     // Directory to store files
     const boost::filesystem::path _path;
 
-    // Mutex to protect the condvar, configuration changes, and most recent periodic document.
+    // Mutex to protect the condvars, configuration changes, most recent periodic document, and
+    // pending and stream samples.
     stdx::mutex _mutex;
     stdx::condition_variable _condvar;
 
@@ -192,14 +274,43 @@ private:
     // Owned
     BSONObj _mostRecentPeriodicDocument;
 
+    // Set of fast collectors
+    FTDCCollectorCollection _fastCollectors;
+    bool _hasFastCollectors{false};
+
+    // Condition variable to signal the fast collection thread on config changes and stop.
+    stdx::condition_variable _fastCondvar;
+
+    // Samples collected by the background thread, but not yet written by the writer thread.
+    stdx::condition_variable _pendingSamplesCondvar;
+    std::deque<std::tuple<BSONObj, Date_t>> _pendingSamples;
+
+    // Set once the writer thread should exit after writing the pending samples, or if it failed
+    // and will not write any more.
+    bool _writerStopRequested{false};
+    bool _writerFailed{false};
+
+    // Config settings used by the writer thread and its file manager, copied from _config.
+    FTDCConfig _writerConfig;
+
+    // Recent samples of each stream, and the number of the next sample of each stream.
+    std::deque<StreamSample> _streamSamples[2];
+    long long _nextStreamSampleId[2] = {0, 0};
+
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
-    // Background collection and writing thread
+    // Background collection thread
     stdx::thread _thread;
+
+    // Background writing thread
+    stdx::thread _writerThread;
+
+    // Background fast collection thread, only started if there are fast collectors.
+    stdx::thread _fastThread;
 };
 
 }  // namespace mongo
@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <iostream>
 
@@ -38,6 +39,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/compressor.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
@@ -47,6 +49,8 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -153,6 +157,46 @@ public:
     }
 };
 
+class FTDCMetricsCollectorMockMany : public FTDCMetricsCollectorMockTee {
+public:
+    void generateDocument(BSONObjBuilder& builder, std::uint32_t counter) final {
+        for (int i = 0; i < 1000; ++i) {
+            builder.append(str::stream() << "key" << i, static_cast<long long>(counter * i));
+        }
+    }
+};
+
+// Measure the cost of collecting a sample, and of compressing it, which the writer thread now does
+// instead of the collection thread. Only logged, as timings vary too much between machines to
+// assert on.
+TEST(FTDCControllerTest, BenchmarkCollectionOverhead) {
+    const int kSamples = 300;
+
+    FTDCConfig config;
+    FTDCCollectorCollection collectors;
+    collectors.add(stdx::make_unique<FTDCMetricsCollectorMockMany>());
+
+    FTDCCompressor compressor(&config);
+    Client* client = &cc();
+
+    long long collectMicros = 0;
+    long long compressMicros = 0;
+
+    for (int i = 0; i < kSamples; ++i) {
+        Timer timer;
+        auto sample = collectors.collect(client);
+        collectMicros += timer.micros();
+
+        timer.reset();
+        ASSERT_OK(compressor.addSample(std::get<0>(sample), std::get<1>(sample)).getStatus());
+        compressMicros += timer.micros();
+    }
+
+    unittest::log() << "Collection of a sample of 1000 metrics took "
+                    << collectMicros / kSamples << "us and its compression took "
+                    << compressMicros / kSamples << "us on average";
+}
+
 // Test a run of the controller and the data it logs to log file
 TEST(FTDCControllerTest, TestFull) {
     unittest::TempDir tempdir("metrics_testpath");
@@ -277,4 +321,81 @@ TEST(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs);
 }
 
+// Test the samples of the periodic and fast collectors are kept in memory in order, and that the
+// fast samples are not written to disk
+TEST(FTDCControllerTest, TestStreams) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(1);
+    config.fastPeriod = Milliseconds(1);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(100);
+    c2Ptr->setSignalOnCount(100);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.addFastCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for 100 samples of each to have occured
+    c1Ptr->wait();
+    c2Ptr->wait();
+
+    c.stop();
+
+    // Only the most recent samples are kept, numbered in order
+    long long firstAvailableId;
+    auto periodic =
+        c.getStreamSamples(FTDCController::Stream::kPeriodic, -1, 1024 * 1024, &firstAvailableId);
+    ASSERT_EQUALS(periodic.size(), FTDCController::kMaxPeriodicStreamSamples);
+    ASSERT_EQUALS(periodic.front().id, firstAvailableId);
+    ASSERT_EQUALS(static_cast<size_t>(periodic.back().id + 1), c1Ptr->getDocs().size());
+
+    for (size_t i = 1; i < periodic.size(); ++i) {
+        ASSERT_EQUALS(periodic[i].id, periodic[i - 1].id + 1);
+    }
+
+    auto fast =
+        c.getStreamSamples(FTDCController::Stream::kFast, -1, 1024 * 1024, &firstAvailableId);
+    auto docsFast = c2Ptr->getDocs();
+    ASSERT_EQUALS(fast.size(), std::min(docsFast.size(), FTDCController::kMaxFastStreamSamples));
+    ASSERT_EQUALS(static_cast<size_t>(firstAvailableId), docsFast.size() - fast.size());
+
+    // Only the samples after the one asked for, and at least one however small the limit
+    auto afterLast = c.getStreamSamples(
+        FTDCController::Stream::kFast, fast.back().id, 1024 * 1024, &firstAvailableId);
+    ASSERT_TRUE(afterLast.empty());
+
+    auto limited = c.getStreamSamples(
+        FTDCController::Stream::kFast, fast.front().id, 1, &firstAvailableId);
+    ASSERT_EQUALS(limited.size(), 1UL);
+    ASSERT_EQUALS(limited.front().id, fast.front().id + 1);
+
+    // Only the periodic samples are written to disk
+    auto files = scanDirectory(dir);
+
+    ASSERT_EQUALS(files.size(), 1UL);
+
+    auto docsPeriodic = c1Ptr->getDocs();
+    std::vector<BSONObj> allDocs(docsPeriodic.begin(), docsPeriodic.end());
+
+    ValidateDocumentList(files[0], allDocs);
+}
+
 }  // namespace mongo
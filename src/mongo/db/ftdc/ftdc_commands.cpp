@@ -29,6 +29,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/init.h"
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/client.h"
@@ -40,6 +41,30 @@
 namespace mongo {
 namespace {
 
+/**
+ * Checks the privileges needed to view the data of the periodic collectors installed by
+ * startFTDC.
+ */
+Status checkAuthForDiagnosticData(Client* client) {
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forClusterResource(), ActionType::serverStatus)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forClusterResource(), ActionType::replSetGetStatus)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forExactNamespace(NamespaceString("local", "oplog.rs")),
+            ActionType::collStats)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    return Status::OK();
+}
+
 /**
  * Get the most recent document FTDC collected from its periodic collectors.
  *
@@ -68,24 +93,59 @@ public:
     Status checkAuthForCommand(Client* client,
                                const std::string& dbname,
                                const BSONObj& cmdObj) override {
+        return checkAuthForDiagnosticData(client);
+    }
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forClusterResource(), ActionType::serverStatus)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int options,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forClusterResource(), ActionType::replSetGetStatus)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+        result.append(
+            "data",
+            FTDCController::get(opCtx->getServiceContext())->getMostRecentPeriodicDocument());
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forExactNamespace(NamespaceString("local", "oplog.rs")),
-                ActionType::collStats)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+        return true;
+    }
+};
+
+/**
+ * Get the samples FTDC collected after a given sample, so that a monitoring tool can follow the
+ * diagnostic data as it is collected rather than read the files on disk.
+ *
+ * {getDiagnosticDataStream: 1, afterId: <number>, fast: <bool>}
+ *
+ * Returns the samples numbered after 'afterId' (all those kept in memory by default), oldest
+ * first, from the fast collectors if 'fast' is true, or else from the periodic collectors.
+ * 'lastId' is the 'afterId' to pass next, and if 'firstAvailableId' is greater than 'afterId' + 1
+ * some samples were dropped before they could be read.
+ */
+class GetDiagnosticDataStreamCommand final : public Command {
+public:
+    GetDiagnosticDataStreamCommand() : Command("getDiagnosticDataStream") {}
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    void help(std::stringstream& help) const override {
+        help << "get the diagnostic data collection samples collected after a given sample";
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
 
-        return Status::OK();
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) override {
+        return checkAuthForDiagnosticData(client);
     }
 
     bool run(OperationContext* opCtx,
@@ -94,19 +154,53 @@ public:
              int options,
              std::string& errmsg,
              BSONObjBuilder& result) override {
+        long long afterId;
+        Status status = bsonExtractIntegerFieldWithDefault(cmdObj, "afterId", -1, &afterId);
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
 
-        result.append(
-            "data",
-            FTDCController::get(opCtx->getServiceContext())->getMostRecentPeriodicDocument());
+        bool fast;
+        status = bsonExtractBooleanFieldWithDefault(cmdObj, "fast", false, &fast);
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
+
+        long long firstAvailableId;
+        auto samples = FTDCController::get(opCtx->getServiceContext())
+                           ->getStreamSamples(fast ? FTDCController::Stream::kFast
+                                                   : FTDCController::Stream::kPeriodic,
+                                              afterId,
+                                              kMaxReplyDataBytes,
+                                              &firstAvailableId);
+
+        long long lastId = afterId;
+        BSONArrayBuilder samplesBuilder(result.subarrayStart("samples"));
+        for (const auto& sample : samples) {
+            BSONObjBuilder sampleBuilder(samplesBuilder.subobjStart());
+            sampleBuilder.append("id", sample.id);
+            sampleBuilder.append("data", sample.doc);
+            lastId = sample.id;
+        }
+        samplesBuilder.doneFast();
+
+        result.append("lastId", lastId);
+        result.append("firstAvailableId", firstAvailableId);
 
         return true;
     }
+
+private:
+    // Leave room in the reply for the fields around the sample documents.
+    static const size_t kMaxReplyDataBytes = 8 * 1024 * 1024;
 };
 
 Command* ftdcCommand;
+Command* ftdcStreamCommand;
 
 MONGO_INITIALIZER(CreateDiagnosticDataCommand)(InitializerContext* context) {
     ftdcCommand = new GetDiagnosticDataCommand();
+    ftdcStreamCommand = new GetDiagnosticDataStreamCommand();
 
     return Status::OK();
 }
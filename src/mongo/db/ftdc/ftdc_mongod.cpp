@@ -26,6 +26,8 @@
  * then also delete it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kFTDC
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/ftdc/ftdc_mongod.h"
@@ -38,6 +40,7 @@
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
@@ -48,6 +51,8 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/util/log.h"
+#include "mongo/util/stringutils.h"
 
 namespace mongo {
 
@@ -113,6 +118,38 @@ public:
 
 } exportedFTDCPeriodParameter;
 
+AtomicInt32 localFastPeriodMillis(FTDCConfig::kFastPeriodMillisDefault);
+
+class ExportedFTDCFastPeriodParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCFastPeriodParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionFastPeriodMillis",
+              &localFastPeriodMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 10) {
+            return Status(
+                ErrorCodes::BadValue,
+                "diagnosticDataCollectionFastPeriodMillis must be greater than or equal to 10ms");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setFastPeriod(Milliseconds(potentialNewValue));
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCFastPeriodParameter;
+
+// Comma-separated list of serverStatus sections to collect every fast period. None by default,
+// in which case the fast collection thread is not started.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(diagnosticDataCollectionFastSections, std::string, "");
+
 // Scale the values down since are defaults are in bytes, but the user interface is MB
 AtomicInt32 localMaxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024));
 
@@ -281,6 +318,30 @@ private:
     Command* _command;
 };
 
+/**
+ * Collects a few serverStatus sections without running the whole serverStatus command, so that
+ * they are cheap enough to collect many times a second.
+ */
+class FTDCServerStatusSectionsCollector final : public FTDCCollectorInterface {
+public:
+    explicit FTDCServerStatusSectionsCollector(std::vector<ServerStatusSection*> sections)
+        : _sections(std::move(sections)) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        for (auto section : _sections) {
+            section->appendSection(opCtx, BSONElement(), &builder);
+        }
+    }
+
+    std::string name() const override {
+        return "serverStatus";
+    }
+
+private:
+    // Not owned
+    std::vector<ServerStatusSection*> _sections;
+};
+
 }  // namespace
 
 // Register the FTDC system
@@ -299,6 +360,7 @@ void startFTDC() {
     config.maxDirectorySizeBytes = localMaxDirectorySizeMB.load() * 1024 * 1024;
     config.maxSamplesPerArchiveMetricChunk = localMaxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk = localMaxSamplesPerInterimMetricChunk.load();
+    config.fastPeriod = Milliseconds(localFastPeriodMillis.load());
 
     auto controller = stdx::make_unique<FTDCController>(dir, config);
 
@@ -337,6 +399,33 @@ void startFTDC() {
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Install fast collectors
+    // These are collected on the fast period interval in FTDCConfig, and only kept in memory for
+    // getDiagnosticDataStream.
+    std::vector<std::string> fastSectionNames;
+    splitStringDelim(diagnosticDataCollectionFastSections, &fastSectionNames, ',');
+
+    std::vector<ServerStatusSection*> fastSections;
+    for (const auto& sectionName : fastSectionNames) {
+        if (sectionName.empty()) {
+            continue;
+        }
+
+        auto section = findServerStatusSection(sectionName);
+        if (!section) {
+            warning() << "Unknown serverStatus section '" << sectionName
+                      << "' in diagnosticDataCollectionFastSections will not be collected";
+            continue;
+        }
+
+        fastSections.push_back(section);
+    }
+
+    if (!fastSections.empty()) {
+        controller->addFastCollector(
+            stdx::make_unique<FTDCServerStatusSectionsCollector>(std::move(fastSections)));
+    }
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
@@ -68,19 +68,24 @@ bool BasicFTSTokenizer::moveNext() {
             continue;
         }
 
-        string word = tolowerString(token.data);
+        // Reuse the buffers of the previous token rather than allocating new strings.
+        _word.assign(token.data.rawData(), token.data.size());
+        for (char& c : _word) {
+            c = tolower(c);
+        }
 
         // Stop words are case-sensitive so we need them to be lower cased to check
         // against the stop word list
-        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(word)) {
+        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & FTSTokenizer::kGenerateCaseSensitiveTokens) {
-            word = token.data.toString();
+            _word.assign(token.data.rawData(), token.data.size());
         }
 
-        _stem = _stemmer.stem(word).toString();
+        StringData stem = _stemmer.stem(_word);
+        _stem.assign(stem.rawData(), stem.size());
         return true;
     }
 }
@@ -77,6 +77,7 @@ private:
     std::unique_ptr<Tokenizer> _tokenizer;
     Options _options;
 
+    std::string _word;
     std::string _stem;
 };
 
@@ -37,6 +37,8 @@ namespace mongo {
 
 namespace fts {
 
+const size_t Stemmer::kMaxCachedStems;
+
 Stemmer::Stemmer(const FTSLanguage* language) {
     _stemmer = NULL;
     if (language->str() != "none")
@@ -54,6 +56,11 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    StringMapTraits::HashedKey hashedWord(word);
+    auto cached = _stemCache.find(hashedWord);
+    if (cached != _stemCache.end())
+        return cached->second;
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -62,7 +69,14 @@ StringData Stemmer::stem(StringData word) const {
         invariant(false);
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    // Bound the memory used by the cache. Clearing it is much simpler than tracking the least
+    // recently used words and the frequent words come back quickly.
+    if (_stemCache.size() >= kMaxCachedStems)
+        _stemCache.clear();
+
+    std::string& stemmed = _stemCache.get(hashedWord);
+    stemmed.assign((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    return stemmed;
 }
 }
 }
@@ -33,6 +33,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
+#include "mongo/util/string_map.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
 
 namespace mongo {
@@ -57,11 +58,22 @@ public:
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
+     *
+     * Stems are remembered, so stemming a word seen before by this Stemmer is a lookup.
      */
     StringData stem(StringData word) const;
 
+    /**
+     * The number of stems remembered before the cache is emptied.
+     */
+    static const size_t kMaxCachedStems = 4096;
+
 private:
     struct sb_stemmer* _stemmer;
+
+    // Maps each word stemmed so far to its stem. Natural language repeats the same words often,
+    // which makes this much cheaper than running the stemmer again.
+    mutable StringMap<std::string> _stemCache;
 };
 }
 }
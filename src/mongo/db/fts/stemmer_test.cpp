@@ -48,5 +48,24 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, RepeatedWords) {
+    Stemmer s(&languageEnglishV2);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQUALS("run", s.stem("running"));
+        ASSERT_EQUALS("walk", s.stem("walking"));
+        ASSERT_EQUALS("Run", s.stem("Running"));
+    }
+}
+
+TEST(English, MoreWordsThanCached) {
+    Stemmer s(&languageEnglishV2);
+    for (size_t i = 0; i < Stemmer::kMaxCachedStems + 10; i++) {
+        std::string word = "walking" + std::to_string(i);
+        ASSERT_EQUALS(word, s.stem(word));
+    }
+    ASSERT_EQUALS("run", s.stem("running"));
+    ASSERT_EQUALS("walk", s.stem("walking"));
+}
 }
 }
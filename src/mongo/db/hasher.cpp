@@ -35,6 +35,7 @@
 #include "mongo/db/hasher.h"
 
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/startup_test.h"
@@ -47,6 +48,11 @@ namespace {
 
 typedef unsigned char HashDigest[16];
 
+/**
+ * Gathers the hashed representation of an element in a buffer, and computes its MD5 in a single
+ * pass once it is complete. Most elements fit in the buffer's inline storage, and hashing the input
+ * at once avoids the bookkeeping md5_append() does for each of the small pieces it is made of.
+ */
 class Hasher {
     MONGO_DISALLOW_COPYING(Hasher);
 
@@ -62,21 +68,22 @@ public:
     void finish(HashDigest out);
 
 private:
-    md5_state_t _md5State;
-    HashSeed _seed;
+    StackBufBuilder _input;
 };
 
-Hasher::Hasher(HashSeed seed) : _seed(seed) {
-    md5_init(&_md5State);
-    md5_append(&_md5State, reinterpret_cast<const md5_byte_t*>(&_seed), sizeof(_seed));
+Hasher::Hasher(HashSeed seed) {
+    _input.appendBuf(&seed, sizeof(seed));
 }
 
 void Hasher::addData(const void* keyData, size_t numBytes) {
-    md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
+    _input.appendBuf(keyData, numBytes);
 }
 
 void Hasher::finish(HashDigest out) {
-    md5_finish(&_md5State, out);
+    md5_state_t md5State;
+    md5_init(&md5State);
+    md5_append(&md5State, reinterpret_cast<const md5_byte_t*>(_input.buf()), _input.len());
+    md5_finish(&md5State, out);
 }
 
 void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/hasher.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+void benchmarkHash(BenchmarkState& state, const BSONObj& obj) {
+    const BSONElement elem = obj.firstElement();
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(
+            BSONElementHasher::hash64(elem, BSONElementHasher::DEFAULT_HASH_SEED));
+    }
+}
+
+BENCHMARK(BSONElementHasher, Int) {
+    benchmarkHash(state, BSON("" << 42));
+}
+
+BENCHMARK(BSONElementHasher, ObjectId) {
+    benchmarkHash(state, BSON("" << OID("5a0000000000000000000001")));
+}
+
+BENCHMARK(BSONElementHasher, String) {
+    benchmarkHash(state,
+                  BSON(""
+                       << "customer-000123"));
+}
+
+BENCHMARK(BSONElementHasher, Object) {
+    benchmarkHash(state,
+                  BSON("" << BSON("region"
+                                  << "emea"
+                                  << "id"
+                                  << 7
+                                  << "tags"
+                                  << BSON_ARRAY(1 << 2 << 3))));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -249,11 +249,14 @@ BtreeKeyGeneratorV1::BtreeKeyGeneratorV1(std::vector<const char*> fieldNames,
 }
 
 BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
+                                                    const BSONFieldIndex* fieldIndex,
                                                     const PositionalPathInfo& positionalInfo,
                                                     const char** field,
                                                     bool* arrayNestedArray) const {
-    std::string firstField = mongoutils::str::before(*field, '.');
-    bool haveObjField = !obj.getField(firstField).eoo();
+    const char* dot = strchr(*field, '.');
+    const StringData firstField = dot ? StringData(*field, dot - *field) : StringData(*field);
+    BSONElement firstElt = fieldIndex ? fieldIndex->getField(firstField) : obj.getField(firstField);
+    bool haveObjField = !firstElt.eoo();
     BSONElement arrField = positionalInfo.positionallyIndexedElt;
 
     // An index component field name cannot exist in both a document
@@ -269,7 +272,15 @@ BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
 
     *arrayNestedArray = false;
     if (haveObjField) {
-        return dps::extractElementAtPathOrArrayAlongPath(obj, *field);
+        // Continue from the element already found, as dps::extractElementAtPathOrArrayAlongPath()
+        // would after looking it up again.
+        *field = dot ? dot + 1 : *field + firstField.size();
+        if (firstElt.type() == Array || **field == '\0') {
+            return firstElt;
+        } else if (firstElt.type() == Object) {
+            return dps::extractElementAtPathOrArrayAlongPath(firstElt.embeddedObject(), *field);
+        }
+        return BSONElement();
     } else if (positionalInfo.hasPositionallyIndexedElt()) {
         if (arrField.type() == Array) {
             *arrayNestedArray = true;
@@ -301,6 +312,7 @@ void BtreeKeyGeneratorV1::_getKeysArrEltFixed(std::vector<const char*>* fieldNam
     getKeysImplWithArray(*fieldNames,
                          *fixed,
                          arrEntry.type() == Object ? arrEntry.embeddedObject() : BSONObj(),
+                         nullptr,
                          keys,
                          numNotFound,
                          positionalInfo,
@@ -343,13 +355,27 @@ void BtreeKeyGeneratorV1::getKeysImpl(std::vector<const char*> fieldNames,
         invariant(multikeyPaths->empty());
         multikeyPaths->resize(fieldNames.size());
     }
-    getKeysImplWithArray(fieldNames, fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths);
+    // Key patterns with few fields look each up with a scan of the document. For more, the lookups
+    // are made through an index of the document's fields once a few have been made.
+    boost::optional<BSONFieldIndex> fieldIndex;
+    if (fieldNames.size() > static_cast<size_t>(BSONFieldIndex::kLinearLookups)) {
+        fieldIndex.emplace(obj);
+    }
+    getKeysImplWithArray(fieldNames,
+                         fixed,
+                         obj,
+                         fieldIndex.get_ptr(),
+                         keys,
+                         0,
+                         _emptyPositionalInfo,
+                         multikeyPaths);
 }
 
 void BtreeKeyGeneratorV1::getKeysImplWithArray(
     std::vector<const char*> fieldNames,
     std::vector<BSONElement> fixed,
     const BSONObj& obj,
+    const BSONFieldIndex* fieldIndex,
     BSONObjSet* keys,
     unsigned numNotFound,
     const std::vector<PositionalPathInfo>& positionalInfo,
@@ -390,8 +416,8 @@ void BtreeKeyGeneratorV1::getKeysImplWithArray(
 
         bool arrayNestedArray;
         // Extract element matching fieldName[ i ] from object xor array.
-        BSONElement e =
-            extractNextElement(obj, positionalInfo[i], &fieldNames[i], &arrayNestedArray);
+        BSONElement e = extractNextElement(
+            obj, fieldIndex, positionalInfo[i], &fieldNames[i], &arrayNestedArray);
 
         if (e.eoo()) {
             // if field not present, set to null
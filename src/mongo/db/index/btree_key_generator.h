@@ -32,6 +32,7 @@
 #include <set>
 #include <vector>
 
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
@@ -187,10 +188,13 @@ private:
 
     /**
      * This recursive method does the heavy-lifting for getKeysImpl().
+     *
+     * If 'fieldIndex' is not null, it indexes 'obj' and is used to find the fields of 'obj'.
      */
     void getKeysImplWithArray(std::vector<const char*> fieldNames,
                               std::vector<BSONElement> fixed,
                               const BSONObj& obj,
+                              const BSONFieldIndex* fieldIndex,
                               BSONObjSet* keys,
                               unsigned numNotFound,
                               const std::vector<PositionalPathInfo>& positionalInfo,
@@ -203,6 +207,8 @@ private:
      * The 'positionalInfo' arg is used for handling a field path where 'obj' has an
      * array indexed by position. See the comments for PositionalPathInfo for more detail.
      *
+     * If 'fieldIndex' is not null, it indexes 'obj' and is used to find the first part of the path.
+     *
      * Returns the element extracted as a result of traversing the path, or an indexed array
      * if we encounter one during the path traversal.
      *
@@ -229,6 +235,7 @@ private:
      *   the second array element.
      */
     BSONElement extractNextElement(const BSONObj& obj,
+                                   const BSONFieldIndex* fieldIndex,
                                    const PositionalPathInfo& positionalInfo,
                                    const char** field,
                                    bool* arrayNestedArray) const;
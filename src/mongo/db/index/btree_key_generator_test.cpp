@@ -180,6 +180,29 @@ TEST(BtreeKeyGeneratorTest, GetKeysFromObjectDotted) {
     ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysFromObjectWithManyIndexedFields) {
+    // Enough fields for the document's fields to be looked up through a BSONFieldIndex.
+    BSONObj keyPattern = fromjson("{f: 1, b: 1, 'd.x': 1, missing: 1, a: 1, 'e.y': 1, c: 1}");
+    BSONObj genKeysFrom =
+        fromjson("{a: 1, b: 2, c: 3, d: {x: 4}, e: 5, f: 6, g: 7, a: 8, 'd.x': 9, '': 10}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 6, '': 2, '': 4, '': null, '': 1, '': null, '': 3}"));
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeysFromArrayWithManyIndexedFields) {
+    BSONObj keyPattern = fromjson("{a: 1, b: 1, c: 1, d: 1, 'e.x': 1, 'e.y': 1}");
+    BSONObj genKeysFrom = fromjson("{f: 0, a: 1, b: 2, c: 3, d: 4, e: [{x: 5, y: 6}, {x: 7}]}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 1, '': 2, '': 3, '': 4, '': 5, '': 6}"));
+    expectedKeys.insert(fromjson("{'': 1, '': 2, '': 3, '': 4, '': 7, '': null}"));
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    expectedMultikeyPaths[4] = {0U};
+    expectedMultikeyPaths[5] = {0U};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
 TEST(BtreeKeyGeneratorTest, GetKeysFromArraySimple) {
     BSONObj keyPattern = fromjson("{a: 1}");
     BSONObj genKeysFrom = fromjson("{a: [1, 2, 3]}");
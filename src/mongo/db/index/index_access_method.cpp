@@ -32,6 +32,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -44,9 +45,11 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/progress_meter.h"
 
@@ -134,44 +137,126 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
     getKeys(obj, options.getKeysMode, &keys, &multikeyPaths);
 
     Status ret = Status::OK();
-    for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
-        Status status = _newInterface->insert(opCtx, *i, loc, options.dupsAllowed);
+    if (_sideTable) {
+        _sideTable->record(opCtx, IndexBuildSideTable::Op::kInsert, keys, loc);
+        *numInserted = keys.size();
+    } else {
+        for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
+            Status status = _newInterface->insert(opCtx, *i, loc, options.dupsAllowed);
+
+            // Everything's OK, carry on.
+            if (status.isOK()) {
+                ++*numInserted;
+                continue;
+            }
+
+            // Error cases.
+
+            if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+                continue;
+            }
+
+            if (status.code() == ErrorCodes::DuplicateKeyValue) {
+                // A document might be indexed multiple times during a background index build
+                // if it moves ahead of the collection scan cursor (e.g. via an update).
+                if (!_btreeState->isReady(opCtx)) {
+                    LOG(3) << "key " << *i
+                           << " already in index during background indexing (ok)";
+                    continue;
+                }
+            }
+
+            // Clean up after ourselves.
+            for (BSONObjSet::const_iterator j = keys.begin(); j != i; ++j) {
+                removeOneKey(opCtx, *j, loc, options.dupsAllowed);
+                *numInserted = 0;
+            }
+
+            return status;
+        }
+    }
+
+    if (*numInserted > 1 || isMultikeyFromPaths(multikeyPaths)) {
+        _btreeState->setMultikey(opCtx, multikeyPaths);
+    }
+
+    return ret;
+}
+
+Status IndexAccessMethod::insertRecords(OperationContext* opCtx,
+                                        const std::vector<BsonRecord>& records,
+                                        const InsertDeleteOptions& options,
+                                        int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+
+    // The side table records the keys of each document together, and a single document gains
+    // nothing from the sort.
+    if (_sideTable || records.size() == 1) {
+        for (const auto& record : records) {
+            int64_t inserted;
+            Status status = insert(opCtx, *record.docPtr, record.id, options, &inserted);
+            if (!status.isOK())
+                return status;
+            *numInserted += inserted;
+        }
+        return Status::OK();
+    }
+
+    // Generate the keys of every document first, so that they can be inserted in key order.
+    std::vector<std::pair<BSONObj, RecordId>> keys;
+    std::vector<MultikeyPaths> multikeyPathsToSet;
+    BSONObjSet docKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    for (const auto& record : records) {
+        invariant(record.id != RecordId());
+        docKeys.clear();
+        MultikeyPaths multikeyPaths;
+        getKeys(*record.docPtr, options.getKeysMode, &docKeys, &multikeyPaths);
+        if (docKeys.size() > 1 || isMultikeyFromPaths(multikeyPaths)) {
+            multikeyPathsToSet.push_back(std::move(multikeyPaths));
+        }
+        for (const auto& key : docKeys) {
+            keys.emplace_back(key, record.id);
+        }
+    }
+
+    const Ordering ordering = Ordering::make(_descriptor->keyPattern());
+    std::sort(keys.begin(), keys.end(), [&ordering](const auto& lhs, const auto& rhs) {
+        const int cmp = lhs.first.woCompare(rhs.first, ordering, false);
+        return cmp < 0 || (cmp == 0 && lhs.second < rhs.second);
+    });
+
+    for (auto i = keys.begin(); i != keys.end(); ++i) {
+        Status status = _newInterface->insert(opCtx, i->first, i->second, options.dupsAllowed);
 
-        // Everything's OK, carry on.
         if (status.isOK()) {
             ++*numInserted;
             continue;
         }
 
-        // Error cases.
+        // The error cases are handled as in insert().
 
         if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
             continue;
         }
 
-        if (status.code() == ErrorCodes::DuplicateKeyValue) {
-            // A document might be indexed multiple times during a background index build
-            // if it moves ahead of the collection scan cursor (e.g. via an update).
-            if (!_btreeState->isReady(opCtx)) {
-                LOG(3) << "key " << *i << " already in index during background indexing (ok)";
-                continue;
-            }
+        if (status.code() == ErrorCodes::DuplicateKeyValue && !_btreeState->isReady(opCtx)) {
+            LOG(3) << "key " << i->first << " already in index during background indexing (ok)";
+            continue;
         }
 
-        // Clean up after ourselves.
-        for (BSONObjSet::const_iterator j = keys.begin(); j != i; ++j) {
-            removeOneKey(opCtx, *j, loc, options.dupsAllowed);
-            *numInserted = 0;
+        for (auto j = keys.begin(); j != i; ++j) {
+            removeOneKey(opCtx, j->first, j->second, options.dupsAllowed);
         }
-
+        *numInserted = 0;
         return status;
     }
 
-    if (*numInserted > 1 || isMultikeyFromPaths(multikeyPaths)) {
+    for (const auto& multikeyPaths : multikeyPathsToSet) {
         _btreeState->setMultikey(opCtx, multikeyPaths);
     }
 
-    return ret;
+    return Status::OK();
 }
 
 void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
@@ -213,6 +298,12 @@ Status IndexAccessMethod::remove(OperationContext* opCtx,
     MultikeyPaths* multikeyPaths = nullptr;
     getKeys(obj, options.getKeysMode, &keys, multikeyPaths);
 
+    if (_sideTable) {
+        _sideTable->record(opCtx, IndexBuildSideTable::Op::kDelete, keys, loc);
+        *numDeleted = keys.size();
+        return Status::OK();
+    }
+
     for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
         removeOneKey(opCtx, *i, loc, options.dupsAllowed);
         ++*numDeleted;
@@ -377,6 +468,14 @@ Status IndexAccessMethod::update(OperationContext* opCtx,
         _btreeState->setMultikey(opCtx, ticket.newMultikeyPaths);
     }
 
+    if (_sideTable) {
+        _sideTable->record(opCtx, IndexBuildSideTable::Op::kDelete, ticket.removed, ticket.loc);
+        _sideTable->record(opCtx, IndexBuildSideTable::Op::kInsert, ticket.added, ticket.loc);
+        *numInserted = ticket.added.size();
+        *numDeleted = ticket.removed.size();
+        return Status::OK();
+    }
+
     for (size_t i = 0; i < ticket.removed.size(); ++i) {
         _newInterface->unindex(opCtx, ticket.removed[i], ticket.loc, ticket.dupsAllowed);
     }
@@ -400,52 +499,122 @@ Status IndexAccessMethod::update(OperationContext* opCtx,
     return Status::OK();
 }
 
+void IndexAccessMethod::beginSideWrites() {
+    invariant(!_sideTable);
+    _sideTable = stdx::make_unique<IndexBuildSideTable>();
+}
+
+void IndexAccessMethod::endSideWrites() {
+    _sideTable.reset();
+}
+
+Status IndexAccessMethod::applySideWrites(OperationContext* opCtx,
+                                          const std::vector<IndexBuildSideTable::Entry>& entries,
+                                          const InsertDeleteOptions& options) {
+    for (auto&& entry : entries) {
+        if (entry.op == IndexBuildSideTable::Op::kDelete) {
+            // The index is still being built, so only the entry for this exact RecordId may go.
+            removeOneKey(opCtx, entry.key, entry.loc, /*dupsAllowed*/ true);
+            continue;
+        }
+
+        Status status = _newInterface->insert(opCtx, entry.key, entry.loc, options.dupsAllowed);
+        if (status.isOK()) {
+            continue;
+        }
+        if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+            continue;
+        }
+        if (status.code() == ErrorCodes::DuplicateKeyValue) {
+            // The collection scan already saw this version of the document.
+            continue;
+        }
+        return status;
+    }
+    return Status::OK();
+}
+
 Status IndexAccessMethod::compact(OperationContext* opCtx) {
     return this->_newInterface->compact(opCtx);
 }
 
+StatusWith<bool> IndexAccessMethod::compactIncrementally(OperationContext* opCtx,
+                                                         Seconds timeLimit) {
+    return this->_newInterface->compactIncrementally(opCtx, timeLimit);
+}
+
 std::unique_ptr<IndexAccessMethod::BulkBuilder> IndexAccessMethod::initiateBulk(
-    size_t maxMemoryUsageBytes) {
-    return std::unique_ptr<BulkBuilder>(new BulkBuilder(this, _descriptor, maxMemoryUsageBytes));
+    size_t maxMemoryUsageBytes, size_t numShards) {
+    invariant(numShards > 0);
+    return std::unique_ptr<BulkBuilder>(
+        new BulkBuilder(this, _descriptor, maxMemoryUsageBytes, numShards));
+}
+
+namespace {
+void mergeMultikeyPaths(const MultikeyPaths& from, MultikeyPaths* into) {
+    if (from.empty()) {
+        return;
+    }
+    if (into->empty()) {
+        *into = from;
+        return;
+    }
+    invariant(into->size() == from.size());
+    for (size_t i = 0; i < from.size(); ++i) {
+        (*into)[i].insert(from[i].begin(), from[i].end());
+    }
 }
+}  // namespace
 
 IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
                                             const IndexDescriptor* descriptor,
-                                            size_t maxMemoryUsageBytes)
-    : _sorter(Sorter::make(
-          SortOptions()
-              .TempDir(storageGlobalParams.dbpath + "/_tmp")
-              .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
-          BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
-      _real(index) {}
+                                            size_t maxMemoryUsageBytes,
+                                            size_t numShards)
+    : _shards(numShards), _real(index), _descriptor(descriptor) {
+    // Several shards already keep several threads busy, so only a lone shard's sorter may use
+    // threads of its own.
+    const size_t numSorterThreads =
+        numShards == 1 ? std::max(internalSorterNumThreads.load(), 1) : 1;
+    for (auto&& shard : _shards) {
+        shard.sorter.reset(Sorter::make(
+            SortOptions()
+                .TempDir(storageGlobalParams.dbpath + "/_tmp")
+                .ExtSortAllowed()
+                .MaxMemoryUsageBytes(maxMemoryUsageBytes / numShards)
+                .NumThreads(numSorterThreads),
+            BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version())));
+    }
+}
 
 Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
                                               const BSONObj& obj,
                                               const RecordId& loc,
                                               const InsertDeleteOptions& options,
                                               int64_t* numInserted) {
+    return insertIntoShard(0, opCtx, obj, loc, options, numInserted);
+}
+
+Status IndexAccessMethod::BulkBuilder::insertIntoShard(size_t shardNum,
+                                                       OperationContext* opCtx,
+                                                       const BSONObj& obj,
+                                                       const RecordId& loc,
+                                                       const InsertDeleteOptions& options,
+                                                       int64_t* numInserted) {
+    invariant(shardNum < _shards.size());
+    Shard& shard = _shards[shardNum];
+
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
 
     _real->getKeys(obj, options.getKeysMode, &keys, &multikeyPaths);
 
-    _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || (keys.size() > 1);
+    shard.everGeneratedMultipleKeys = shard.everGeneratedMultipleKeys || (keys.size() > 1);
 
-    if (!multikeyPaths.empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
-            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
-                _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
-            }
-        }
-    }
+    mergeMultikeyPaths(multikeyPaths, &shard.indexMultikeyPaths);
 
     for (BSONObjSet::iterator it = keys.begin(); it != keys.end(); ++it) {
-        _sorter->add(*it, loc);
-        _keysInserted++;
+        shard.sorter->add(*it, loc);
+        shard.keysInserted++;
     }
 
     if (NULL != numInserted) {
@@ -455,6 +624,28 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+IndexAccessMethod::BulkBuilder::Sorter::Iterator* IndexAccessMethod::BulkBuilder::done() {
+    for (auto&& shard : _shards) {
+        _keysInserted += shard.keysInserted;
+        _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || shard.everGeneratedMultipleKeys;
+        mergeMultikeyPaths(shard.indexMultikeyPaths, &_indexMultikeyPaths);
+    }
+
+    if (_shards.size() == 1) {
+        return _shards.front().sorter->done();
+    }
+
+    // Each shard's keys are sorted independently, so they still need merging into one stream.
+    std::vector<std::shared_ptr<Sorter::Iterator>> iters;
+    for (auto&& shard : _shards) {
+        iters.push_back(std::shared_ptr<Sorter::Iterator>(shard.sorter->done()));
+    }
+    return Sorter::Iterator::merge(
+        iters,
+        SortOptions(),
+        BtreeExternalSortComparison(_descriptor->keyPattern(), _descriptor->version()));
+}
+
 
 Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
                                      std::unique_ptr<BulkBuilder> bulk,
@@ -463,7 +654,7 @@ Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
                                      set<RecordId>* dupsToDrop) {
     Timer timer;
 
-    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(bulk->_sorter->done());
+    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(bulk->done());
 
     stdx::unique_lock<Client> lk(*opCtx->getClient());
     ProgressMeterHolder pm(*opCtx->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
@@ -33,11 +33,13 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/index_build_side_table.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
 
 namespace mongo {
@@ -85,7 +87,18 @@ public:
                   int64_t* numInserted);
 
     /**
-     * Analogous to above, but remove the records instead of inserting them.
+     * Like insert(), for each of 'records'. The keys of all the documents are generated first and
+     * inserted in key order, which touches each part of the index once rather than once per
+     * document. 'numInserted' will be set to the number of keys added to the index. If an error
+     * is returned, none of the keys will have been inserted.
+     */
+    Status insertRecords(OperationContext* opCtx,
+                         const std::vector<BsonRecord>& records,
+                         const InsertDeleteOptions& options,
+                         int64_t* numInserted);
+
+    /**
+     * Analogous to insert(), but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
      */
     Status remove(OperationContext* opCtx,
@@ -192,6 +205,12 @@ public:
      */
     Status compact(OperationContext* opCtx);
 
+    /**
+     * Does up to 'timeLimit' of the work of compact() without blocking other operations on the
+     * index, and returns whether the compaction is complete.
+     */
+    StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds timeLimit);
+
     //
     // Bulk operations support
     //
@@ -207,25 +226,62 @@ public:
                       const InsertDeleteOptions& options,
                       int64_t* numInserted);
 
+        /**
+         * Like insert(), but sorts the keys with the sorter of shard number 'shard', which must
+         * be less than numShards(). Calls for different shards may be made concurrently from
+         * different threads. Only keys are generated, so 'opCtx' is not used.
+         */
+        Status insertIntoShard(size_t shard,
+                               OperationContext* opCtx,
+                               const BSONObj& obj,
+                               const RecordId& loc,
+                               const InsertDeleteOptions& options,
+                               int64_t* numInserted);
+
+        size_t numShards() const {
+            return _shards.size();
+        }
+
     private:
         friend class IndexAccessMethod;
 
         using Sorter = mongo::Sorter<BSONObj, RecordId>;
 
+        /**
+         * The keys inserted into one shard, along with what they say about the index.
+         */
+        struct Shard {
+            std::unique_ptr<Sorter> sorter;
+            int64_t keysInserted = 0;
+
+            // Set to true if at least one document causes IndexAccessMethod::getKeys() to return
+            // a BSONObjSet with size strictly greater than one.
+            bool everGeneratedMultipleKeys = false;
+
+            // Holds the path components that cause this index to be multikey. The
+            // 'indexMultikeyPaths' vector remains empty if this index doesn't support path-level
+            // multikey tracking.
+            MultikeyPaths indexMultikeyPaths;
+        };
+
         BulkBuilder(const IndexAccessMethod* index,
                     const IndexDescriptor* descriptor,
-                    size_t maxMemoryUsageBytes);
+                    size_t maxMemoryUsageBytes,
+                    size_t numShards);
+
+        /**
+         * Returns all keys inserted into every shard in sorted order, and totals up the shards'
+         * key counts and multikey information.
+         */
+        Sorter::Iterator* done();
 
-        std::unique_ptr<Sorter> _sorter;
+        std::vector<Shard> _shards;
         const IndexAccessMethod* _real;
-        int64_t _keysInserted = 0;
+        const IndexDescriptor* _descriptor;
 
-        // Set to true if at least one document causes IndexAccessMethod::getKeys() to return a
-        // BSONObjSet with size strictly greater than one.
+        // Totals across all shards, available after done().
+        int64_t _keysInserted = 0;
         bool _everGeneratedMultipleKeys = false;
-
-        // Holds the path components that cause this index to be multikey. The '_indexMultikeyPaths'
-        // vector remains empty if this index doesn't support path-level multikey tracking.
         MultikeyPaths _indexMultikeyPaths;
     };
 
@@ -238,8 +294,10 @@ public:
      *
      * maxMemoryUsageBytes: amount of memory consumed before the external sorter starts spilling to
      *                      disk
+     * numShards: number of threads which may insert into the BulkBuilder at once, each through
+     *            its own sorter. maxMemoryUsageBytes is divided between them.
      */
-    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes);
+    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes, size_t numShards = 1);
 
     /**
      * Call this when you are ready to finish your bulk work.
@@ -256,6 +314,31 @@ public:
                       bool dupsAllowed,
                       std::set<RecordId>* dups);
 
+    /**
+     * Diverts the key changes made by insert(), remove() and update() into a side table, rather
+     * than writing them into the index, until endSideWrites() is called. This lets a background
+     * build bulk load the keys from its collection scan while the collection is written to.
+     *
+     * Both must be called with the collection locked exclusively.
+     */
+    void beginSideWrites();
+    void endSideWrites();
+
+    /**
+     * Returns the side table key changes are diverted into, or null if they are not diverted.
+     */
+    IndexBuildSideTable* sideTable() const {
+        return _sideTable.get();
+    }
+
+    /**
+     * Writes 'entries' taken from the side table into the index, in order. For use by the
+     * background build of this index only.
+     */
+    Status applySideWrites(OperationContext* opCtx,
+                           const std::vector<IndexBuildSideTable::Entry>& entries,
+                           const InsertDeleteOptions& options);
+
     /**
      * Specifies whether getKeys should relax the index constraints or not.
      */
@@ -318,6 +401,10 @@ private:
                       bool dupsAllowed);
 
     const std::unique_ptr<SortedDataInterface> _newInterface;
+
+    // Non-null while key changes are diverted into a side table. Only set or reset while the
+    // collection is locked exclusively.
+    std::unique_ptr<IndexBuildSideTable> _sideTable;
 };
 
 /**
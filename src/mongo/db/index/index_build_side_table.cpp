@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_build_side_table.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+
+namespace mongo {
+
+void IndexBuildSideTable::_recordOnCommit(OperationContext* opCtx, std::vector<Entry> entries) {
+    if (entries.empty()) {
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit([ this, entries = std::move(entries) ] {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _entries.insert(_entries.end(), entries.begin(), entries.end());
+    });
+}
+
+std::vector<IndexBuildSideTable::Entry> IndexBuildSideTable::take(size_t maxEntries) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const auto end = _entries.begin() + std::min(maxEntries, _entries.size());
+    std::vector<Entry> entries(std::make_move_iterator(_entries.begin()),
+                               std::make_move_iterator(end));
+    _entries.erase(_entries.begin(), end);
+    return entries;
+}
+
+std::vector<IndexBuildSideTable::Entry> IndexBuildSideTable::peekAll() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return std::vector<Entry>(_entries.begin(), _entries.end());
+}
+
+size_t IndexBuildSideTable::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _entries.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Records the index key changes made by writes to a collection while one of its indexes is being
+ * built in the background by bulk loading. Such writes cannot go into the index itself until the
+ * sorted keys from the build's collection scan have been loaded, so they are applied afterwards,
+ * in the order they were committed.
+ *
+ * This class is thread safe.
+ */
+class IndexBuildSideTable {
+    MONGO_DISALLOW_COPYING(IndexBuildSideTable);
+
+public:
+    enum class Op { kInsert, kDelete };
+
+    struct Entry {
+        Op op;
+        BSONObj key;
+        RecordId loc;
+    };
+
+    IndexBuildSideTable() = default;
+
+    /**
+     * Records 'op' for each of 'keys' pointing to 'loc', once the WriteUnitOfWork of 'opCtx'
+     * commits. Nothing is recorded if it rolls back.
+     */
+    template <typename Keys>
+    void record(OperationContext* opCtx, Op op, const Keys& keys, const RecordId& loc) {
+        std::vector<Entry> entries;
+        for (auto&& key : keys) {
+            entries.push_back({op, key.getOwned(), loc});
+        }
+        _recordOnCommit(opCtx, std::move(entries));
+    }
+
+    /**
+     * Removes and returns up to 'maxEntries' of the oldest entries.
+     */
+    std::vector<Entry> take(size_t maxEntries);
+
+    /**
+     * Returns a copy of every entry, leaving them in place.
+     */
+    std::vector<Entry> peekAll() const;
+
+    size_t size() const;
+
+private:
+    void _recordOnCommit(OperationContext* opCtx, std::vector<Entry> entries);
+
+    mutable stdx::mutex _mutex;
+    std::deque<Entry> _entries;
+};
+
+}  // namespace mongo
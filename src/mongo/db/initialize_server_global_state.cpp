@@ -43,6 +43,7 @@
 #include <syslog.h>
 #endif
 
+#include "mongo/base/counter.h"
 #include "mongo/base/init.h"
 #include "mongo/client/sasl_client_authenticate.h"
 #include "mongo/config.h"
@@ -50,7 +51,11 @@
 #include "mongo/db/auth/authorization_manager_global.h"
 #include "mongo/db/auth/internal_user_auth.h"
 #include "mongo/db/auth/security_key.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/async_rotatable_file_appender.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -61,6 +66,7 @@
 #include "mongo/logger/rotatable_file_writer.h"
 #include "mongo/logger/syslog_appender.h"
 #include "mongo/platform/process_id.h"
+#include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/listen.h"
@@ -81,6 +87,22 @@ using std::cerr;
 using std::cout;
 using std::endl;
 
+namespace {
+
+// If positive, the log file is written by a background thread that the logging threads hand their
+// formatted messages to, and this is the most bytes of messages that may wait for it.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logAsyncQueueSizeBytes, int, 0);
+
+// Whether a message that does not fit in the queue of the log file's background thread waits for
+// room, rather than being dropped and counted in log.droppedMessages.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logAsyncBlockWhenQueueFull, bool, false);
+
+Counter64 logDroppedMessages;
+ServerStatusMetricField<Counter64> displayLogDroppedMessages("log.droppedMessages",
+                                                             &logDroppedMessages);
+
+}  // namespace
+
 #ifndef _WIN32
 // support for exit value propagation with fork
 void launchSignal(int sig) {
@@ -286,13 +308,37 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            MessageLogDomain::AppenderAutoPtr(new RotatableFileAppender<MessageEventEphemeral>(
-                new MessageEventDetailsEncoder, writer.getValue())));
-        manager->getNamedDomain("javascriptOutput")
-            ->attachAppender(
+        if (logAsyncQueueSizeBytes > 0) {
+            using logger::AsyncLogWriter;
+            using logger::AsyncRotatableFileAppender;
+
+            // Like the file writer, this lives until the process exits. Once the shutdown tasks
+            // run, messages are written by the threads that log them, so none are lost on exit.
+            const auto overflowPolicy = logAsyncBlockWhenQueueFull
+                ? AsyncLogWriter::OverflowPolicy::kBlock
+                : AsyncLogWriter::OverflowPolicy::kDrop;
+            auto asyncWriter = new AsyncLogWriter(writer.getValue(),
+                                                  logAsyncQueueSizeBytes,
+                                                  overflowPolicy,
+                                                  &logDroppedMessages);
+            registerShutdownTask([asyncWriter] { asyncWriter->stopAsync(); });
+
+            manager->getGlobalDomain()->attachAppender(MessageLogDomain::AppenderAutoPtr(
+                new AsyncRotatableFileAppender<MessageEventEphemeral>(
+                    new MessageEventDetailsEncoder, asyncWriter)));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(MessageLogDomain::AppenderAutoPtr(
+                    new AsyncRotatableFileAppender<MessageEventEphemeral>(
+                        new MessageEventDetailsEncoder, asyncWriter)));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
                 MessageLogDomain::AppenderAutoPtr(new RotatableFileAppender<MessageEventEphemeral>(
                     new MessageEventDetailsEncoder, writer.getValue())));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(MessageLogDomain::AppenderAutoPtr(
+                    new RotatableFileAppender<MessageEventEphemeral>(new MessageEventDetailsEncoder,
+                                                                     writer.getValue())));
+        }
 
         if (serverGlobalParams.logAppend && exists) {
             log() << "***** SERVER RESTARTED *****";
@@ -39,6 +39,7 @@ Status ArrayMatchingMatchExpression::setPath(StringData path) {
     _path = path;
     Status s = _elementPath.init(_path);
     _elementPath.setTraverseLeafArray(false);
+    _elementPath.enableLeafPath();
     return s;
 }
 
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <memory>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    const CollatorInterface* collator = nullptr;
+    auto result =
+        MatchExpressionParser::parse(query, ExtensionsCallbackDisallowExtensions(), collator);
+    invariantOK(result.getStatus());
+    return std::move(result.getValue());
+}
+
+const BSONObj kDocument = fromjson(
+    "{_id: 1, a: 5, b: 'hello', c: {d: 3, e: [1, 2, 3, 4, 5]}, f: [{g: 1}, {g: 2}, {g: 3}]}");
+
+BENCHMARK(MatchExpression, Equality) {
+    const auto expr = parse(fromjson("{b: 'hello'}"));
+    BSONMatchableDocument doc(kDocument);
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(expr->matches(&doc));
+    }
+}
+
+BENCHMARK(MatchExpression, ConjunctionOfRanges) {
+    const auto expr = parse(fromjson("{a: {$gt: 1, $lt: 10}, 'c.d': {$gte: 3}}"));
+    BSONMatchableDocument doc(kDocument);
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(expr->matches(&doc));
+    }
+}
+
+BENCHMARK(MatchExpression, ArrayElemMatch) {
+    const auto expr = parse(fromjson("{f: {$elemMatch: {g: {$gte: 3}}}}"));
+    BSONMatchableDocument doc(kDocument);
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(expr->matches(&doc));
+    }
+}
+
+BENCHMARK(MatchExpression, InNoMatch) {
+    const auto expr = parse(fromjson("{'c.e': {$in: [10, 11, 12, 13, 14, 15]}}"));
+    BSONMatchableDocument doc(kDocument);
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(expr->matches(&doc));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 #include <cmath>
 #include <pcrecpp.h>
 
+#include "mongo/base/compare_numbers.h"
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
@@ -48,7 +49,9 @@ namespace mongo {
 
 Status LeafMatchExpression::setPath(StringData path) {
     _path = path;
-    return _elementPath.init(_path);
+    Status s = _elementPath.init(_path);
+    _elementPath.enableLeafPath();
+    return s;
 }
 
 
@@ -111,6 +114,31 @@ Status ComparisonMatchExpression::init(StringData path, const BSONElement& rhs)
 
 
 bool ComparisonMatchExpression::matchesSingleElement(const BSONElement& e) const {
+    // Fast paths for the most common types, when both sides have the same one. These skip the
+    // canonical type and NaN checks below, which the generic comparison needs.
+    if (e.type() == _rhs.type()) {
+        switch (e.type()) {
+            case NumberInt:
+                return _matchesComparisonResult(compareInts(e._numberInt(), _rhs._numberInt()));
+            case NumberLong:
+                return _matchesComparisonResult(
+                    compareLongs(e._numberLong(), _rhs._numberLong()));
+            case NumberDouble:
+                if (!std::isnan(e._numberDouble()) && !std::isnan(_rhs._numberDouble())) {
+                    return _matchesComparisonResult(
+                        compareDoubles(e._numberDouble(), _rhs._numberDouble()));
+                }
+                break;
+            case String:
+                if (!_collator) {
+                    return _matchesComparisonResult(
+                        e.valueStringData().compare(_rhs.valueStringData()));
+                }
+                break;
+            default:
+                break;
+        }
+    }
 
     if (e.canonicalType() != _rhs.canonicalType()) {
         // some special cases
@@ -148,8 +176,10 @@ bool ComparisonMatchExpression::matchesSingleElement(const BSONElement& e) const
         }
     }
 
-    int x = compareElementValues(e, _rhs, _collator);
+    return _matchesComparisonResult(compareElementValues(e, _rhs, _collator));
+}
 
+bool ComparisonMatchExpression::_matchesComparisonResult(int x) const {
     switch (matchType()) {
         case LT:
             return x < 0;
@@ -137,6 +137,13 @@ protected:
 
     // Collator used to compare elements. By default, simple binary comparison will be used.
     const CollatorInterface* _collator = nullptr;
+
+private:
+    /**
+     * Returns whether an element which compares to the rhs as 'x' does (negative if the element
+     * is smaller, zero if equal, positive if larger) satisfies this comparison.
+     */
+    bool _matchesComparisonResult(int x) const;
 };
 
 //
@@ -83,6 +83,47 @@ TEST(ComparisonMatchExpression, StringMatchingRespectsCollation) {
                           NULL));
 }
 
+TEST(ComparisonMatchExpression, ComparesValuesOfTheSameType) {
+    BSONObj operand = BSON("int" << 5 << "long" << 5LL << "double" << 5.5 << "string"
+                                 << "b");
+    BSONObj lower = BSON("int" << 4 << "long" << 4LL << "double" << 4.5 << "string"
+                               << "a");
+    BSONObj higher = BSON("int" << 6 << "long" << 6LL << "double" << 6.5 << "string"
+                                << "bb");
+
+    for (auto&& rhs : operand) {
+        LTMatchExpression lt;
+        ASSERT(lt.init("", rhs).isOK());
+        GTEMatchExpression gte;
+        ASSERT(gte.init("", rhs).isOK());
+        EqualityMatchExpression eq;
+        ASSERT(eq.init("", rhs).isOK());
+
+        StringData field = rhs.fieldNameStringData();
+        ASSERT(lt.matchesSingleElement(lower[field]));
+        ASSERT(!lt.matchesSingleElement(rhs));
+        ASSERT(!lt.matchesSingleElement(higher[field]));
+        ASSERT(!gte.matchesSingleElement(lower[field]));
+        ASSERT(gte.matchesSingleElement(rhs));
+        ASSERT(gte.matchesSingleElement(higher[field]));
+        ASSERT(!eq.matchesSingleElement(lower[field]));
+        ASSERT(eq.matchesSingleElement(rhs));
+    }
+}
+
+TEST(ComparisonMatchExpression, ComparesNaNDoubles) {
+    BSONObj operand = BSON("a" << std::numeric_limits<double>::quiet_NaN());
+    EqualityMatchExpression eq;
+    ASSERT(eq.init("a", operand["a"]).isOK());
+    ASSERT(eq.matchesBSON(operand, NULL));
+    ASSERT(!eq.matchesBSON(BSON("a" << 1.0), NULL));
+
+    BSONObj one = BSON("a" << 1.0);
+    LTMatchExpression lt;
+    ASSERT(lt.init("a", one["a"]).isOK());
+    ASSERT(!lt.matchesBSON(operand, NULL));
+}
+
 TEST(EqOp, MatchesElement) {
     BSONObj operand = BSON("a" << 5);
     BSONObj match = BSON("a" << 5.0);
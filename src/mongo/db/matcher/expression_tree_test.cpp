@@ -203,6 +203,37 @@ TEST(AndOp, MatchesThreeClauses) {
     ASSERT(!andOp.matchesBSON(BSON("a" << 10 << "b" << 6), NULL));
 }
 
+TEST(AndOp, MatchesClausesOnFieldsOfTheSameSubdocument) {
+    BSONObj baseOperand1 = BSON("$gt" << 1);
+    BSONObj baseOperand2 = BSON("$lt" << 10);
+    BSONObj baseOperand3 = BSON("$eq" << 3);
+
+    unique_ptr<ComparisonMatchExpression> sub1(new GTMatchExpression());
+    ASSERT(sub1->init("a.b.c", baseOperand1["$gt"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub2(new LTMatchExpression());
+    ASSERT(sub2->init("a.b.d", baseOperand2["$lt"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub3(new EqualityMatchExpression());
+    ASSERT(sub3->init("a.e", baseOperand3["$eq"]).isOK());
+
+    AndMatchExpression andOp;
+    andOp.add(sub1.release());
+    andOp.add(sub2.release());
+    andOp.add(sub3.release());
+
+    ASSERT(andOp.matchesBSON(fromjson("{a: {b: {c: 5, d: 6}, e: 3}}"), NULL));
+    ASSERT(!andOp.matchesBSON(fromjson("{a: {b: {c: 5, d: 60}, e: 3}}"), NULL));
+    ASSERT(!andOp.matchesBSON(fromjson("{a: {b: {c: 5}, e: 3}}"), NULL));
+    ASSERT(!andOp.matchesBSON(fromjson("{a: {b: 5, e: 3}}"), NULL));
+    ASSERT(!andOp.matchesBSON(fromjson("{a: 5}"), NULL));
+
+    // Arrays on the way to the leaf are still traversed.
+    ASSERT(andOp.matchesBSON(fromjson("{a: [{b: {c: 5}}, {b: [{d: 6}]}, {e: 3}]}"), NULL));
+    ASSERT(andOp.matchesBSON(fromjson("{a: {b: [{c: 0}, {c: 5, d: 6}], e: [3]}}"), NULL));
+    ASSERT(!andOp.matchesBSON(fromjson("{a: [{b: {c: 5}}, {e: 3}]}"), NULL));
+}
+
 TEST(AndOp, ElemMatchKey) {
     BSONObj baseOperand1 = BSON("a" << 1);
     BSONObj baseOperand2 = BSON("b" << 2);
@@ -34,9 +34,39 @@
 
 namespace mongo {
 
-BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
+BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj), _fieldIndex(_obj) {
     _iteratorUsed = false;
 }
 
 BSONMatchableDocument::~BSONMatchableDocument() {}
+
+BSONElement BSONMatchableDocument::_findParent(const ElementPath& path) const {
+    const StringData parentPath = path.parentPath();
+    for (size_t i = 0; i < kParentCacheSize; ++i) {
+        if (_parentCache[i].parentPath == parentPath) {
+            return _parentCache[i].parent;
+        }
+    }
+
+    // Walk down through subdocuments only. Arrays are left to the full path iterator, which knows
+    // how to traverse them.
+    BSONElement parent;
+    BSONObj obj = _obj;
+    const FieldRef& fieldRef = path.fieldRef();
+    for (size_t i = 0; i + 1 < fieldRef.numParts(); ++i) {
+        const StringData part = fieldRef.getPart(i);
+        parent = i == 0 ? _fieldIndex.getField(part) : obj.getField(part);
+        if (parent.type() != Object) {
+            parent = BSONElement();
+            break;
+        }
+        obj = parent.embeddedObject();
+    }
+
+    ParentCacheEntry& entry = _parentCache[_parentCacheNext];
+    entry.parentPath = parentPath;
+    entry.parent = parent;
+    _parentCacheNext = (_parentCacheNext + 1) % kParentCacheSize;
+    return parent;
+}
 }
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/path.h"
@@ -84,10 +85,22 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
+        BSONObj context = _obj;
+        const BSONFieldIndex* fieldIndex = &_fieldIndex;
+        if (const ElementPath* leafPath = path->leafPath()) {
+            // Start from the leaf's parent subdocument if there are no arrays on the way to it.
+            BSONElement parent = _findParent(*path);
+            if (parent.type() == Object) {
+                context = parent.embeddedObject();
+                fieldIndex = nullptr;
+                path = leafPath;
+            }
+        }
+
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, context, fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, context, fieldIndex);
         return &_iterator;
     }
 
@@ -100,8 +113,28 @@ public:
     }
 
 private:
+    /**
+     * Returns the element at path->parentPath() if every part of it is a subdocument, and EOO
+     * otherwise. Recently found parents are cached, as filters often have several predicates on
+     * fields of the same subdocument.
+     */
+    BSONElement _findParent(const ElementPath& path) const;
+
+    struct ParentCacheEntry {
+        StringData parentPath;
+        BSONElement parent;
+    };
+    static const size_t kParentCacheSize = 4;
+
     BSONObj _obj;
+
+    // Finds the top-level fields of '_obj' for filters with many predicates.
+    BSONFieldIndex _fieldIndex;
+
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    mutable ParentCacheEntry _parentCache[kParentCacheSize];
+    mutable size_t _parentCacheNext = 0;  // next entry to replace
 };
 }
@@ -39,9 +39,22 @@ Status ElementPath::init(StringData path) {
     _shouldTraverseNonleafArrays = true;
     _shouldTraverseLeafArray = true;
     _fieldRef.parse(path);
+    _leafPath.reset();
+    _parentPath = StringData();
     return Status::OK();
 }
 
+void ElementPath::enableLeafPath() {
+    const size_t numParts = _fieldRef.numParts();
+    if (numParts < 2) {
+        return;
+    }
+    _leafPath.reset(new ElementPath());
+    _leafPath->init(_fieldRef.getPart(numParts - 1));
+    _leafPath->setTraverseLeafArray(_shouldTraverseLeafArray);
+    _parentPath = _fieldRef.dottedSubstring(0, numParts - 1);
+}
+
 // -----
 
 ElementIterator::~ElementIterator() {}
@@ -87,16 +100,21 @@ BSONElementIterator::BSONElementIterator() {
     _path = NULL;
 }
 
-BSONElementIterator::BSONElementIterator(const ElementPath* path, const BSONObj& context)
-    : _path(path), _context(context) {
+BSONElementIterator::BSONElementIterator(const ElementPath* path,
+                                         const BSONObj& context,
+                                         const BSONFieldIndex* fieldIndex)
+    : _path(path), _context(context), _fieldIndex(fieldIndex) {
     _state = BEGIN;
 }
 
 BSONElementIterator::~BSONElementIterator() {}
 
-void BSONElementIterator::reset(const ElementPath* path, const BSONObj& context) {
+void BSONElementIterator::reset(const ElementPath* path,
+                                const BSONObj& context,
+                                const BSONFieldIndex* fieldIndex) {
     _path = path;
     _context = context;
+    _fieldIndex = fieldIndex;
     _state = BEGIN;
     _next.reset();
 
@@ -191,7 +209,7 @@ bool BSONElementIterator::more() {
 
     if (_state == BEGIN) {
         size_t idxPath = 0;
-        BSONElement e = getFieldDottedOrArray(_context, _path->fieldRef(), &idxPath);
+        BSONElement e = getFieldDottedOrArray(_context, _path->fieldRef(), &idxPath, _fieldIndex);
 
         if (e.type() != Array) {
             _next.reset(e, BSONElement(), false);
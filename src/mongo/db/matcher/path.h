@@ -31,15 +31,23 @@
 #pragma once
 
 
+#include <memory>
+
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 
 namespace mongo {
 
 class ElementPath {
+    MONGO_DISALLOW_COPYING(ElementPath);
+
 public:
+    ElementPath() = default;
+
     Status init(StringData path);
 
     void setTraverseNonleafArrays(bool b) {
@@ -47,6 +55,34 @@ public:
     }
     void setTraverseLeafArray(bool b) {
         _shouldTraverseLeafArray = b;
+        if (_leafPath) {
+            _leafPath->setTraverseLeafArray(b);
+        }
+    }
+
+    /**
+     * For a path with more than one part, such as "a.b.c", builds a path of just the last part
+     * ("c") with the same leaf array traversal. When the parent ("a.b") resolves to a
+     * subdocument without passing through an array, iterating the leaf path over that
+     * subdocument gives the same elements as iterating the full path over the document. This
+     * lets a MatchableDocument share the walk down to a subdocument between paths with the same
+     * parent. Must be called after init().
+     */
+    void enableLeafPath();
+
+    /**
+     * The path built by enableLeafPath(), or NULL if there is none.
+     */
+    const ElementPath* leafPath() const {
+        return _leafPath.get();
+    }
+
+    /**
+     * The dotted path of all but the last part, e.g. "a.b" for "a.b.c". Empty for single-part
+     * paths.
+     */
+    StringData parentPath() const {
+        return _parentPath;
     }
 
     const FieldRef& fieldRef() const {
@@ -63,6 +99,9 @@ private:
     FieldRef _fieldRef;
     bool _shouldTraverseNonleafArrays;
     bool _shouldTraverseLeafArray;
+
+    std::unique_ptr<ElementPath> _leafPath;
+    StringData _parentPath;  // points into _fieldRef
 };
 
 class ElementIterator {
@@ -137,11 +176,19 @@ private:
 class BSONElementIterator : public ElementIterator {
 public:
     BSONElementIterator();
-    BSONElementIterator(const ElementPath* path, const BSONObj& context);
+    /**
+     * If 'fieldIndex' is not null, it must index 'context' and outlive the iterator. It is used to
+     * find the first part of the path.
+     */
+    BSONElementIterator(const ElementPath* path,
+                        const BSONObj& context,
+                        const BSONFieldIndex* fieldIndex = nullptr);
 
     virtual ~BSONElementIterator();
 
-    void reset(const ElementPath* path, const BSONObj& context);
+    void reset(const ElementPath* path,
+               const BSONObj& context,
+               const BSONFieldIndex* fieldIndex = nullptr);
 
     bool more();
     Context next();
@@ -155,6 +202,7 @@ private:
 
     const ElementPath* _path;
     BSONObj _context;
+    const BSONFieldIndex* _fieldIndex = nullptr;
 
     enum State { BEGIN, IN_ARRAY, DONE } _state;
     Context _next;
@@ -40,9 +40,13 @@ bool isAllDigits(StringData str) {
     return true;
 }
 
-BSONElement getFieldDottedOrArray(const BSONObj& doc, const FieldRef& path, size_t* idxPath) {
+BSONElement getFieldDottedOrArray(const BSONObj& doc,
+                                  const FieldRef& path,
+                                  size_t* idxPath,
+                                  const BSONFieldIndex* fieldIndex) {
+    dassert(!fieldIndex || fieldIndex->isIndexOf(doc));
     if (path.numParts() == 0)
-        return doc.getField("");
+        return fieldIndex ? fieldIndex->getField("") : doc.getField("");
 
     BSONElement res;
 
@@ -50,7 +54,11 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc, const FieldRef& path, size
     bool stop = false;
     size_t partNum = 0;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        if (partNum == 0 && fieldIndex) {
+            res = fieldIndex->getField(path.getPart(partNum));
+        } else {
+            res = curr.getField(path.getPart(partNum));
+        }
 
         switch (res.type()) {
             case EOO:
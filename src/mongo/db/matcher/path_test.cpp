@@ -92,6 +92,30 @@ TEST(Path, RootArray2) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, FieldIndexFindsSameElementsAsScan) {
+    BSONObj doc = fromjson("{x: 1, a: {b: [1, {c: 2}]}, y: 3, a: 4, b: [5, 6]}");
+
+    for (auto&& path : {"a", "a.b", "a.b.c", "a.b.1.c", "b", "y", "z", "x.y"}) {
+        ElementPath p;
+        ASSERT(p.init(path).isOK());
+
+        BSONFieldIndex fieldIndex(doc);
+        for (int pass = 0; pass <= BSONFieldIndex::kLinearLookups; ++pass) {
+            BSONElementIterator scanCursor(&p, doc);
+            BSONElementIterator indexCursor(&p, doc, &fieldIndex);
+            while (scanCursor.more()) {
+                ASSERT(indexCursor.more()) << path;
+                ElementIterator::Context scanned = scanCursor.next();
+                ElementIterator::Context indexed = indexCursor.next();
+                ASSERT_EQUALS(scanned.element().rawdata(), indexed.element().rawdata()) << path;
+                ASSERT_EQUALS(scanned.outerArray(), indexed.outerArray()) << path;
+            }
+            ASSERT(!indexCursor.more()) << path;
+        }
+        ASSERT(fieldIndex.isBuilt());
+    }
+}
+
 TEST(Path, Nested1) {
     ElementPath p;
     ASSERT(p.init("a.b").isOK());
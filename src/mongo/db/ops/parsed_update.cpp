@@ -40,7 +40,23 @@
 namespace mongo {
 
 ParsedUpdate::ParsedUpdate(OperationContext* opCtx, const UpdateRequest* request)
-    : _opCtx(opCtx), _request(request), _driver(UpdateDriver::Options()), _canonicalQuery() {}
+    : ParsedUpdate(opCtx, request, nullptr, false) {}
+
+ParsedUpdate::ParsedUpdate(OperationContext* opCtx,
+                           const UpdateRequest* request,
+                           UpdateDriver* driver,
+                           bool driverIsParsed)
+    : _opCtx(opCtx),
+      _request(request),
+      _driver(driver),
+      _driverIsParsed(driverIsParsed),
+      _canonicalQuery() {
+    invariant(!_driverIsParsed || (_driver && _request->getCollation().isEmpty()));
+    if (!_driver) {
+        _ownedDriver.emplace(UpdateDriver::Options());
+        _driver = _ownedDriver.get_ptr();
+    }
+}
 
 Status ParsedUpdate::parseRequest() {
     // It is invalid to request that the UpdateStage return the prior or newly-updated version
@@ -83,7 +99,7 @@ Status ParsedUpdate::parseRequest() {
 Status ParsedUpdate::parseQuery() {
     dassert(!_canonicalQuery.get());
 
-    if (!_driver.needMatchDetails() && CanonicalQuery::isSimpleIdQuery(_request->getQuery())) {
+    if (!_driver->needMatchDetails() && CanonicalQuery::isSimpleIdQuery(_request->getQuery())) {
         return Status::OK();
     }
 
@@ -131,11 +147,18 @@ Status ParsedUpdate::parseUpdate() {
     const bool shouldValidate =
         !(!_opCtx->writesAreReplicated() || ns.isConfigDB() || _request->isFromMigration());
 
-    _driver.setLogOp(true);
-    _driver.setModOptions(ModifierInterface::Options(
+    _driver->setLogOp(true);
+    _driver->setModOptions(ModifierInterface::Options(
         !_opCtx->writesAreReplicated(), shouldValidate, _collator.get()));
 
-    return _driver.parse(_request->getUpdates(), _request->isMulti());
+    if (_driverIsParsed) {
+        // The modifiers are already parsed. Only undo what the earlier update may have changed.
+        _driver->refreshIndexKeys(nullptr);
+        _driver->setCollator(_collator.get());
+        return Status::OK();
+    }
+
+    return _driver->parse(_request->getUpdates(), _request->isMulti());
 }
 
 PlanExecutor::YieldPolicy ParsedUpdate::yieldPolicy() const {
@@ -167,13 +190,13 @@ const UpdateRequest* ParsedUpdate::getRequest() const {
 }
 
 UpdateDriver* ParsedUpdate::getDriver() {
-    return &_driver;
+    return _driver;
 }
 
 void ParsedUpdate::setCollator(std::unique_ptr<CollatorInterface> collator) {
     _collator = std::move(collator);
 
-    _driver.setCollator(_collator.get());
+    _driver->setCollator(_collator.get());
 }
 
 }  // namespace mongo
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/db/ops/update_driver.h"
@@ -66,6 +68,21 @@ public:
      */
     ParsedUpdate(OperationContext* opCtx, const UpdateRequest* request);
 
+    /**
+     * Constructs a parsed update which applies its modifiers with 'driver' rather than with a
+     * driver of its own. If 'driverIsParsed' is true, 'driver' was successfully parsed by an
+     * earlier ParsedUpdate, from a request for the same namespace with the same update document
+     * and multi flag and without a collation, so that parsing the update again can be skipped.
+     * This request must have no collation either.
+     *
+     * The objects pointed to by "request" and "driver" must stay in scope for the life of the
+     * constructed ParsedUpdate.
+     */
+    ParsedUpdate(OperationContext* opCtx,
+                 const UpdateRequest* request,
+                 UpdateDriver* driver,
+                 bool driverIsParsed);
+
     /**
      * Parses the update request to a canonical query and an update driver. On success, the
      * parsed update can be used to create a PlanExecutor for this update.
@@ -146,8 +163,14 @@ private:
     // The collator for the parsed update.  Owned here.
     std::unique_ptr<CollatorInterface> _collator;
 
-    // Driver for processing updates on matched documents.
-    UpdateDriver _driver;
+    // Driver for processing updates on matched documents, unless the caller provided one.
+    boost::optional<UpdateDriver> _ownedDriver;
+
+    // Points to _ownedDriver or to the driver provided by the caller.
+    UpdateDriver* _driver;
+
+    // Whether _driver was parsed before this ParsedUpdate was constructed.
+    const bool _driverIsParsed;
 
     // Parsed query object, or NULL if the query proves to be an id hack query.
     std::unique_ptr<CanonicalQuery> _canonicalQuery;
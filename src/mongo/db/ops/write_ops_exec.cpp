@@ -30,20 +30,27 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/bson/mutable/document.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_metrics.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/update.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/introspect.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/ops/delete_request.h"
@@ -52,15 +59,19 @@
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/ops/update_request.h"
+#include "mongo/db/ops/update_result.h"
 #include "mongo/db/ops/write_ops_exec.h"
+#include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/rpc/command_reply.h"
@@ -68,7 +79,10 @@
 #include "mongo/rpc/command_request.h"
 #include "mongo/rpc/command_request_builder.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
@@ -98,6 +112,8 @@ void finishCurOp(OperationContext* opCtx, CurOp* curOp) {
                     curOp->totalTimeMicros(),
                     curOp->isCommand(),
                     curOp->getReadWriteType());
+        QueryShapeStats::get(opCtx->getServiceContext())
+            .record(*curOp, opCtx->getServiceContext()->getFastClockSource()->now());
 
         if (!curOp->debug().exceptionInfo.empty()) {
             LOG(3) << "Caught Assertion in " << redact(logicalOpToString(curOp->getLogicalOp()))
@@ -401,6 +417,263 @@ static bool insertBatchAndHandleErrors(OperationContext* opCtx,
     return true;
 }
 
+/**
+ * Inserts the documents of 'wholeOp' from 'begin' up to 'end', appending their results to 'out'.
+ */
+static void performInsertsInRange(OperationContext* opCtx,
+                                  const InsertOp& wholeOp,
+                                  std::vector<BSONObj>::const_iterator begin,
+                                  std::vector<BSONObj>::const_iterator end,
+                                  WriteResult* out) {
+    DisableDocumentValidationIfTrue docValidationDisabler(opCtx, wholeOp.bypassDocumentValidation);
+    LastOpFixer lastOpFixer(opCtx, wholeOp.ns);
+
+    size_t bytesInBatch = 0;
+    std::vector<BSONObj> batch;
+    const size_t maxBatchSize = internalInsertMaxBatchSize.load();
+    batch.reserve(std::min(static_cast<size_t>(end - begin), maxBatchSize));
+
+    for (auto it = begin; it != end; ++it) {
+        const BSONObj& doc = *it;
+        const bool isLastDoc = (it + 1 == end);
+        auto fixedDoc = fixDocumentForInsert(opCtx->getServiceContext(), doc);
+        if (!fixedDoc.isOK()) {
+            // Handled after we insert anything in the batch to be sure we report errors in the
+            // correct order. In an ordered insert, if one of the docs ahead of us fails, we should
+            // behave as-if we never got to this document.
+        } else {
+            batch.push_back(fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue()));
+            bytesInBatch += batch.back().objsize();
+            if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < insertVectorMaxBytes)
+                continue;  // Add more to batch before inserting.
+        }
+
+        bool canContinue = insertBatchAndHandleErrors(opCtx, wholeOp, batch, &lastOpFixer, out);
+        batch.clear();  // We won't need the current batch any more.
+        bytesInBatch = 0;
+
+        if (canContinue && !fixedDoc.isOK()) {
+            globalOpCounters.gotInsert();
+            canContinue = handleError(
+                opCtx,
+                UserException(fixedDoc.getStatus().code(), fixedDoc.getStatus().reason()),
+                wholeOp,
+                out);
+        }
+
+        if (!canContinue)
+            break;
+    }
+}
+
+namespace {
+
+// Unordered inserts are only split up if each thread gets at least this many documents.
+const size_t kMinDocumentsPerInsertSlice = 100;
+
+// The most threads an unordered insert may use besides the one serving the request.
+const size_t kMaxInsertWorkers = 16;
+
+ThreadPool* getInsertWorkerPool() {
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "UnorderedInsertWorkers";
+        options.minThreads = 0;
+        options.maxThreads = kMaxInsertWorkers;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+        };
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+/**
+ * Returns the number of slices among which the documents of 'wholeOp' should be split, each
+ * slice after the first being inserted by a worker thread.
+ */
+size_t numInsertSlices(OperationContext* opCtx, const InsertOp& wholeOp) {
+    const int maxParallelism = internalInsertMaxParallelism.load();
+    if (!wholeOp.continueOnError || maxParallelism <= 1)
+        return 1;
+
+    // The workers write through their own Client and OperationContext, which only inherit the
+    // request's deadline. Anything else about the operation that could change how or whether the
+    // documents may be written rules them out.
+    if (wholeOp.ns.isSystem() || wholeOp.ns.isLocal() || opCtx->lockState()->isLocked() ||
+        opCtx->getClient()->isInDirectClient() || !opCtx->writesAreReplicated() ||
+        OperationShardingState::get(opCtx).hasShardVersion()) {
+        return 1;
+    }
+
+    const size_t maxSlices = std::min(static_cast<size_t>(maxParallelism), kMaxInsertWorkers + 1);
+    return std::max(size_t(1),
+                    std::min(maxSlices, wholeOp.documents.size() / kMinDocumentsPerInsertSlice));
+}
+
+/**
+ * The outcome of inserting one slice of an unordered insert.
+ */
+struct InsertSlice {
+    std::vector<BSONObj>::const_iterator begin;
+    std::vector<BSONObj>::const_iterator end;
+    WriteResult out;
+    long long ninserted = 0;
+    // Set if the slice failed as a whole, as an ordered insert would have.
+    std::exception_ptr exception;
+};
+
+/**
+ * Keeps track of the worker threads inserting slices of one unordered insert, so that the request
+ * thread can wait for them and pass a kill on to them.
+ */
+class InsertWorkers {
+    MONGO_DISALLOW_COPYING(InsertWorkers);
+
+public:
+    InsertWorkers() = default;
+
+    /**
+     * Inserts 'slice' on the worker pool, or on this thread if the pool refuses the task.
+     */
+    void start(OperationContext* opCtx, const InsertOp& wholeOp, InsertSlice* slice) {
+        const auto deadline = opCtx->getDeadline();
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            ++_numRunning;
+        }
+        auto status = getInsertWorkerPool()->schedule([this, &wholeOp, slice, deadline] {
+            auto workerOpCtx = cc().makeOperationContext();
+            workerOpCtx->setDeadlineByDate(deadline);
+            _run(workerOpCtx.get(), wholeOp, slice);
+        });
+        if (!status.isOK()) {
+            _run(opCtx, wholeOp, slice);
+        }
+    }
+
+    /**
+     * Waits for every slice passed to start() to finish. Kills the workers' operations if the
+     * request's operation is killed in the meantime.
+     */
+    void waitForAll(OperationContext* opCtx) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (_numRunning > 0) {
+            if (!_killed && !opCtx->checkForInterruptNoAssert().isOK()) {
+                _killed = true;
+                for (auto workerOpCtx : _workerOpCtxs) {
+                    _kill_inlock(workerOpCtx);
+                }
+            }
+            _allDone.wait_for(lk, Milliseconds(100).toSystemDuration());
+        }
+    }
+
+private:
+    void _kill_inlock(OperationContext* workerOpCtx) {
+        stdx::lock_guard<Client> clientLk(*workerOpCtx->getClient());
+        workerOpCtx->getServiceContext()->killOperation(workerOpCtx);
+    }
+
+    void _run(OperationContext* opCtx, const InsertOp& wholeOp, InsertSlice* slice) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _workerOpCtxs.push_back(opCtx);
+            if (_killed) {
+                _kill_inlock(opCtx);
+            }
+        }
+
+        const auto ninsertedBefore = CurOp::get(opCtx)->debug().ninserted;
+        try {
+            performInsertsInRange(opCtx, wholeOp, slice->begin, slice->end, &slice->out);
+        } catch (...) {
+            slice->exception = std::current_exception();
+        }
+        slice->ninserted = CurOp::get(opCtx)->debug().ninserted - ninsertedBefore;
+
+        // Nothing may touch 'this' or 'slice' once _numRunning drops to zero.
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _workerOpCtxs.erase(std::find(_workerOpCtxs.begin(), _workerOpCtxs.end(), opCtx));
+        if (--_numRunning == 0) {
+            _allDone.notify_all();
+        }
+    }
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _allDone;
+    size_t _numRunning = 0;
+    bool _killed = false;
+    std::vector<OperationContext*> _workerOpCtxs;
+};
+
+/**
+ * Splits the documents of the unordered insert 'wholeOp' into 'numSlices' contiguous slices,
+ * inserts the first one on this thread and the others on the worker pool, and merges their
+ * results in statement order.
+ */
+WriteResult performInsertsInParallel(OperationContext* opCtx,
+                                     const InsertOp& wholeOp,
+                                     size_t numSlices) {
+    std::vector<InsertSlice> slices(numSlices);
+    const size_t numDocs = wholeOp.documents.size();
+    for (size_t i = 0; i < numSlices; ++i) {
+        slices[i].begin = wholeOp.documents.begin() + (numDocs * i) / numSlices;
+        slices[i].end = wholeOp.documents.begin() + (numDocs * (i + 1)) / numSlices;
+    }
+
+    {
+        InsertWorkers workers;
+        for (size_t i = 1; i < numSlices; ++i) {
+            workers.start(opCtx, wholeOp, &slices[i]);
+        }
+
+        auto& first = slices.front();
+        try {
+            performInsertsInRange(opCtx, wholeOp, first.begin, first.end, &first.out);
+        } catch (...) {
+            first.exception = std::current_exception();
+        }
+        workers.waitForAll(opCtx);
+    }
+
+    auto& curOp = *CurOp::get(opCtx);
+    WriteResult out;
+    out.results.reserve(numDocs);
+    for (size_t i = 0; i < numSlices; ++i) {
+        auto& slice = slices[i];
+        if (slice.exception) {
+            std::rethrow_exception(slice.exception);
+        }
+        if (i > 0) {
+            curOp.debug().ninserted += slice.ninserted;
+        }
+        std::move(slice.out.results.begin(),
+                  slice.out.results.end(),
+                  std::back_inserter(out.results));
+        if (slice.out.staleConfigException) {
+            out.staleConfigException = std::move(slice.out.staleConfigException);
+            break;
+        }
+    }
+
+    // The workers recorded their errors and optimes on their own Clients.
+    for (auto it = out.results.rbegin(); it != out.results.rend(); ++it) {
+        if (!it->isOK()) {
+            LastError::get(opCtx->getClient())
+                .setLastError(it->getStatus().code(), it->getStatus().reason());
+            break;
+        }
+    }
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+
+    return out;
+}
+
+}  // namespace
+
 WriteResult performInserts(OperationContext* opCtx, const InsertOp& wholeOp) {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());  // Does own retries.
     auto& curOp = *CurOp::get(opCtx);
@@ -433,54 +706,81 @@ WriteResult performInserts(OperationContext* opCtx, const InsertOp& wholeOp) {
         return performCreateIndexes(opCtx, wholeOp);
     }
 
-    DisableDocumentValidationIfTrue docValidationDisabler(opCtx, wholeOp.bypassDocumentValidation);
-    LastOpFixer lastOpFixer(opCtx, wholeOp.ns);
+    const size_t numSlices = numInsertSlices(opCtx, wholeOp);
+    if (numSlices > 1) {
+        return performInsertsInParallel(opCtx, wholeOp, numSlices);
+    }
 
     WriteResult out;
     out.results.reserve(wholeOp.documents.size());
+    performInsertsInRange(opCtx, wholeOp, wholeOp.documents.begin(), wholeOp.documents.end(), &out);
+    return out;
+}
 
-    size_t bytesInBatch = 0;
-    std::vector<BSONObj> batch;
-    const size_t maxBatchSize = internalInsertMaxBatchSize.load();
-    batch.reserve(std::min(wholeOp.documents.size(), maxBatchSize));
+namespace {
 
-    for (auto&& doc : wholeOp.documents) {
-        const bool isLastDoc = (&doc == &wholeOp.documents.back());
-        auto fixedDoc = fixDocumentForInsert(opCtx->getServiceContext(), doc);
-        if (!fixedDoc.isOK()) {
-            // Handled after we insert anything in the batch to be sure we report errors in the
-            // correct order. In an ordered insert, if one of the docs ahead of us fails, we should
-            // behave as-if we never got to this document.
-        } else {
-            batch.push_back(fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue()));
-            bytesInBatch += batch.back().objsize();
-            if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < insertVectorMaxBytes)
-                continue;  // Add more to batch before inserting.
-        }
+/**
+ * Keeps the UpdateDriver parsed for each of the last few distinct update documents of a batch, so
+ * that the statements which repeat one of them don't parse it again. The mutable documents which
+ * each driver applies its modifiers to are reused along with it.
+ *
+ * Only statements without a collation can share a driver, as its modifiers may otherwise hold on
+ * to the collator of the statement which parsed them.
+ */
+class UpdateDriverCache {
+    MONGO_DISALLOW_COPYING(UpdateDriverCache);
 
-        bool canContinue = insertBatchAndHandleErrors(opCtx, wholeOp, batch, &lastOpFixer, &out);
-        batch.clear();  // We won't need the current batch any more.
-        bytesInBatch = 0;
+public:
+    struct Entry {
+        BSONObj update;
+        bool multi = false;
+        std::unique_ptr<UpdateDriver> driver;
 
-        if (canContinue && !fixedDoc.isOK()) {
-            globalOpCounters.gotInsert();
-            canContinue = handleError(
-                opCtx,
-                UserException(fixedDoc.getStatus().code(), fixedDoc.getStatus().reason()),
-                wholeOp,
-                &out);
+        // Whether 'driver' was successfully parsed from 'update'.
+        bool isParsed = false;
+    };
+
+    UpdateDriverCache() = default;
+
+    /**
+     * Returns the entry for the update document of 'op', making a new one with an unparsed
+     * driver if there is none, or nullptr if 'op' can't share a driver.
+     */
+    Entry* get(const UpdateOp::SingleUpdate& op) {
+        if (!op.collation.isEmpty())
+            return nullptr;
+
+        for (auto&& entry : _entries) {
+            if (entry.multi == op.multi && entry.update.binaryEqual(op.update))
+                return &entry;
         }
 
-        if (!canContinue)
-            break;
+        if (_entries.size() < kMaxEntries) {
+            _entries.emplace_back();
+        }
+        auto& entry = _entries[_nextToReplace];
+        _nextToReplace = (_nextToReplace + 1) % kMaxEntries;
+
+        entry.update = op.update;
+        entry.multi = op.multi;
+        entry.driver = stdx::make_unique<UpdateDriver>(UpdateDriver::Options());
+        entry.isParsed = false;
+        return &entry;
     }
 
-    return out;
-}
+private:
+    static const size_t kMaxEntries = 8;
+
+    std::vector<Entry> _entries;
+    size_t _nextToReplace = 0;
+};
+
+}  // namespace
 
 static WriteResult::SingleResult performSingleUpdateOp(OperationContext* opCtx,
                                                        const NamespaceString& ns,
-                                                       const UpdateOp::SingleUpdate& op) {
+                                                       const UpdateOp::SingleUpdate& op,
+                                                       UpdateDriverCache* driverCache) {
     globalOpCounters.gotUpdate();
     auto& curOp = *CurOp::get(opCtx);
     {
@@ -503,8 +803,16 @@ static WriteResult::SingleResult performSingleUpdateOp(OperationContext* opCtx,
     request.setUpsert(op.upsert);
     request.setYieldPolicy(PlanExecutor::YIELD_AUTO);  // ParsedUpdate overrides this for $isolated.
 
-    ParsedUpdate parsedUpdate(opCtx, &request);
-    uassertStatusOK(parsedUpdate.parseRequest());
+    auto cachedDriver = driverCache->get(op);
+    ParsedUpdate parsedUpdate(opCtx,
+                              &request,
+                              cachedDriver ? cachedDriver->driver.get() : nullptr,
+                              cachedDriver && cachedDriver->isParsed);
+    Status parseStatus = parsedUpdate.parseRequest();
+    if (cachedDriver) {
+        cachedDriver->isParsed = parseStatus.isOK();
+    }
+    uassertStatusOK(parseStatus);
 
     boost::optional<AutoGetCollection> collection;
     while (true) {
@@ -564,6 +872,244 @@ static WriteResult::SingleResult performSingleUpdateOp(OperationContext* opCtx,
     return {nMatchedOrInserted, res.numDocsModified, res.upserted};
 }
 
+/**
+ * Performs 'singleOp' under its own nested CurOp. Returns true if the caller can continue.
+ */
+static bool performUpdateAndHandleErrors(OperationContext* opCtx,
+                                         const UpdateOp& wholeOp,
+                                         const UpdateOp::SingleUpdate& singleOp,
+                                         UpdateDriverCache* driverCache,
+                                         LastOpFixer* lastOpFixer,
+                                         WriteResult* out) {
+    // TODO: don't create nested CurOp for legacy writes.
+    // Add Command pointer to the nested CurOp.
+    auto& parentCurOp = *CurOp::get(opCtx);
+    Command* cmd = parentCurOp.getCommand();
+    CurOp curOp(opCtx);
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        curOp.setCommand_inlock(cmd);
+    }
+    ON_BLOCK_EXIT([&] { finishCurOp(opCtx, &curOp); });
+    try {
+        lastOpFixer->startingOp();
+        out->results.emplace_back(performSingleUpdateOp(opCtx, wholeOp.ns, singleOp, driverCache));
+        lastOpFixer->finishedOpSuccessfully();
+    } catch (const DBException& ex) {
+        return handleError(opCtx, ex, wholeOp, out);
+    }
+    return true;
+}
+
+/**
+ * Returns true if 'op' is an upsert of the single document with a given _id, which is what a
+ * batched upsert can handle.
+ */
+static bool isIdUpsert(const UpdateOp::SingleUpdate& op) {
+    return op.upsert && !op.multi && op.collation.isEmpty() && op.query.nFields() == 1 &&
+        CanonicalQuery::isSimpleIdQuery(op.query);
+}
+
+/**
+ * Looks up the _ids of the upserts from 'begin' up to 'end' in a single pass over the _id index,
+ * in key order. Returns, for each of them, whether it is the first of them to its _id and no
+ * document had that _id, in which case it can only insert. All of them are reported as needing an
+ * update if the _ids can't be looked up this way.
+ */
+static std::vector<bool> findIdUpsertsToInsert(
+    OperationContext* opCtx,
+    const NamespaceString& ns,
+    std::vector<UpdateOp::SingleUpdate>::const_iterator begin,
+    std::vector<UpdateOp::SingleUpdate>::const_iterator end) {
+    const size_t numOps = end - begin;
+    std::vector<bool> toInsert(numOps, false);
+
+    // The insert path handles capped collections by inserting one document at a time, so there is
+    // nothing to batch. With a default collation the _id index doesn't compare BSON values as is.
+    {
+        AutoGetCollection collection(opCtx, ns, MODE_IS);
+        Collection* coll = collection.getCollection();
+        if (!coll || coll->isCapped() || coll->getDefaultCollator())
+            return toInsert;
+
+        IndexCatalog* indexCatalog = coll->getIndexCatalog();
+        IndexDescriptor* idIndex = indexCatalog->findIdIndex(opCtx);
+        if (!idIndex)
+            return toInsert;
+
+        std::vector<size_t> order(numOps);
+        for (size_t i = 0; i < numOps; ++i) {
+            order[i] = i;
+        }
+        auto idOf = [&](size_t i) { return (begin + i)->query.firstElement(); };
+        std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return idOf(lhs).woCompare(idOf(rhs), false) < 0;
+        });
+
+        auto cursor = indexCatalog->getIndex(idIndex)->newCursor(opCtx);
+        for (size_t i = 0; i < numOps; ++i) {
+            // Only the first of the upserts to an _id may insert it, the others come after it.
+            if (i > 0 && idOf(order[i]).woCompare(idOf(order[i - 1]), false) == 0)
+                continue;
+
+            BSONObjBuilder key;
+            key.appendAs(idOf(order[i]), "");
+            toInsert[order[i]] = !cursor->seekExact(key.obj());
+        }
+    }
+
+    // What is found is only a hint, the writes recheck it with their own snapshot.
+    opCtx->recoveryUnit()->abandonSnapshot();
+    return toInsert;
+}
+
+/**
+ * Inserts the documents of 'upserts', which were found to match no document, in a single batch,
+ * as an insert would, and records each of them as an upsert. If anything stops the batch from
+ * being written, for instance because a document was inserted with one of their _ids since they
+ * were looked up, they are performed one at a time as ordinary updates instead.
+ *
+ * Returns true if the caller can continue.
+ */
+static bool insertIdUpsertsAndHandleErrors(
+    OperationContext* opCtx,
+    const UpdateOp& wholeOp,
+    const std::vector<const UpdateOp::SingleUpdate*>& upserts,
+    UpdateDriverCache* driverCache,
+    LastOpFixer* lastOpFixer,
+    WriteResult* out) {
+    if (upserts.empty())
+        return true;
+
+    std::vector<BSONObj> docs;
+    if (upserts.size() > 1) {
+        try {
+            boost::optional<AutoGetCollection> collection;
+            while (true) {
+                opCtx->checkForInterrupt();
+                if (MONGO_FAIL_POINT(failAllUpdates)) {
+                    uasserted(ErrorCodes::InternalError, "failAllUpdates failpoint active!");
+                }
+
+                collection.emplace(opCtx, wholeOp.ns, MODE_IX);
+                if (collection->getCollection())
+                    break;
+
+                collection.reset();  // unlock.
+                makeCollection(opCtx, wholeOp.ns);
+            }
+            assertCanWrite_inlock(opCtx, wholeOp.ns);
+
+            const bool isInternalRequest = !opCtx->writesAreReplicated();
+            docs.reserve(upserts.size());
+            for (auto op : upserts) {
+                UpdateLifecycleImpl updateLifecycle(wholeOp.ns);
+                UpdateRequest request(wholeOp.ns);
+                request.setLifecycle(&updateLifecycle);
+                request.setQuery(op->query);
+                request.setUpdates(op->update);
+                request.setUpsert(true);
+
+                ParsedUpdate parsedUpdate(opCtx, &request);
+                uassertStatusOK(parsedUpdate.parseRequest());
+                uassert(ErrorCodes::InternalError,
+                        "upsert can't be inserted without its canonical query",
+                        !parsedUpdate.hasParsedQuery());
+
+                mutablebson::Document doc;
+                UpdateStats stats;
+                BSONObj newObj;
+                uassertStatusOK(UpdateStage::applyUpdateOpsForInsert(opCtx,
+                                                                     nullptr,
+                                                                     op->query,
+                                                                     parsedUpdate.getDriver(),
+                                                                     &doc,
+                                                                     isInternalRequest,
+                                                                     wholeOp.ns,
+                                                                     &stats,
+                                                                     &newObj));
+                docs.push_back(std::move(newObj));
+            }
+
+            lastOpFixer->startingOp();
+            insertDocuments(opCtx, collection->getCollection(), docs.begin(), docs.end());
+            lastOpFixer->finishedOpSuccessfully();
+        } catch (const DBException& ex) {
+            // Behave as-if we never tried the batch. The loop below reports any lasting errors.
+            docs.clear();
+        }
+    }
+
+    if (docs.empty()) {
+        for (auto op : upserts) {
+            if (!performUpdateAndHandleErrors(opCtx, wholeOp, *op, driverCache, lastOpFixer, out))
+                return false;
+        }
+        return true;
+    }
+
+    auto& parentCurOp = *CurOp::get(opCtx);
+    Command* cmd = parentCurOp.getCommand();
+    for (size_t i = 0; i < upserts.size(); ++i) {
+        globalOpCounters.gotUpdate();
+
+        CurOp curOp(opCtx);
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            curOp.setCommand_inlock(cmd);
+            curOp.setNS_inlock(wholeOp.ns.ns());
+            curOp.setNetworkOp_inlock(dbUpdate);
+            curOp.setLogicalOp_inlock(LogicalOp::opUpdate);
+            curOp.setQuery_inlock(upserts[i]->query);
+            curOp.ensureStarted();
+        }
+        curOp.debug().nMatched = 0;
+        curOp.debug().nModified = 0;
+        curOp.debug().upsert = true;
+        finishCurOp(opCtx, &curOp);
+
+        UpdateResult res(false, true, 0, 0, docs[i]);
+        LastError::get(opCtx->getClient()).recordUpdate(false, 1, res.upserted);
+        out->results.emplace_back(WriteResult::SingleResult{1, 0, res.upserted});
+    }
+    return true;
+}
+
+/**
+ * Performs the upserts by _id from 'begin' up to 'end'. Their _ids are looked up together first.
+ * Those which can only insert are inserted in batches, and the others are performed as ordinary
+ * updates, all in statement order.
+ *
+ * Returns true if the caller can continue.
+ */
+static bool performIdUpsertsAndHandleErrors(
+    OperationContext* opCtx,
+    const UpdateOp& wholeOp,
+    std::vector<UpdateOp::SingleUpdate>::const_iterator begin,
+    std::vector<UpdateOp::SingleUpdate>::const_iterator end,
+    UpdateDriverCache* driverCache,
+    LastOpFixer* lastOpFixer,
+    WriteResult* out) {
+    const auto toInsert = findIdUpsertsToInsert(opCtx, wholeOp.ns, begin, end);
+
+    std::vector<const UpdateOp::SingleUpdate*> inserts;
+    for (auto it = begin; it != end; ++it) {
+        if (toInsert[it - begin]) {
+            inserts.push_back(&*it);
+            continue;
+        }
+
+        const bool canContinue =
+            insertIdUpsertsAndHandleErrors(
+                opCtx, wholeOp, inserts, driverCache, lastOpFixer, out) &&
+            performUpdateAndHandleErrors(opCtx, wholeOp, *it, driverCache, lastOpFixer, out);
+        if (!canContinue)
+            return false;
+        inserts.clear();
+    }
+    return insertIdUpsertsAndHandleErrors(opCtx, wholeOp, inserts, driverCache, lastOpFixer, out);
+}
+
 WriteResult performUpdates(OperationContext* opCtx, const UpdateOp& wholeOp) {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());  // Does own retries.
     uassertStatusOK(userAllowedWriteNS(wholeOp.ns));
@@ -571,28 +1117,32 @@ WriteResult performUpdates(OperationContext* opCtx, const UpdateOp& wholeOp) {
     DisableDocumentValidationIfTrue docValidationDisabler(opCtx, wholeOp.bypassDocumentValidation);
     LastOpFixer lastOpFixer(opCtx, wholeOp.ns);
 
+    UpdateDriverCache driverCache;
+    const bool batchIdUpserts = internalUpdateBatchIdUpserts.load();
+    const size_t maxBatchSize = internalInsertMaxBatchSize.load();
+
     WriteResult out;
     out.results.reserve(wholeOp.updates.size());
-    for (auto&& singleOp : wholeOp.updates) {
-        // TODO: don't create nested CurOp for legacy writes.
-        // Add Command pointer to the nested CurOp.
-        auto& parentCurOp = *CurOp::get(opCtx);
-        Command* cmd = parentCurOp.getCommand();
-        CurOp curOp(opCtx);
-        {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            curOp.setCommand_inlock(cmd);
-        }
-        ON_BLOCK_EXIT([&] { finishCurOp(opCtx, &curOp); });
-        try {
-            lastOpFixer.startingOp();
-            out.results.emplace_back(performSingleUpdateOp(opCtx, wholeOp.ns, singleOp));
-            lastOpFixer.finishedOpSuccessfully();
-        } catch (const DBException& ex) {
-            const bool canContinue = handleError(opCtx, ex, wholeOp, &out);
-            if (!canContinue)
-                break;
+    for (auto it = wholeOp.updates.begin(); it != wholeOp.updates.end();) {
+        if (batchIdUpserts && isIdUpsert(*it)) {
+            auto batchEnd = std::next(it);
+            while (batchEnd != wholeOp.updates.end() &&
+                   static_cast<size_t>(batchEnd - it) < maxBatchSize && isIdUpsert(*batchEnd)) {
+                ++batchEnd;
+            }
+
+            if (batchEnd - it > 1) {
+                if (!performIdUpsertsAndHandleErrors(
+                        opCtx, wholeOp, it, batchEnd, &driverCache, &lastOpFixer, &out))
+                    break;
+                it = batchEnd;
+                continue;
+            }
         }
+
+        if (!performUpdateAndHandleErrors(opCtx, wholeOp, *it, &driverCache, &lastOpFixer, &out))
+            break;
+        ++it;
     }
 
     return out;
@@ -52,6 +52,9 @@ namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision
 const char countName[] = "count";
+
+// The number of doubles or integers gathered from a batch before they are added to the total.
+const size_t kBatchBufferSize = 128;
 }  // namespace
 
 void AccumulatorAvg::processInternal(const Value& input, bool merging) {
@@ -92,6 +95,57 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    // As for $sum, consecutive inputs that are added to '_nonDecimalTotal' the same way are
+    // gathered into plain arrays and summed together, preserving the order of additions.
+    double doubles[kBatchBufferSize];
+    size_t numDoubles = 0;
+    long long longs[kBatchBufferSize];
+    size_t numLongs = 0;
+
+    auto flushDoubles = [&] {
+        _nonDecimalTotal.addDoubles(doubles, numDoubles);
+        _count += numDoubles;
+        numDoubles = 0;
+    };
+    auto flushLongs = [&] {
+        _nonDecimalTotal.addLongs(longs, numLongs);
+        _count += numLongs;
+        numLongs = 0;
+    };
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberInt:
+            case NumberDouble:
+                if (numLongs > 0 || numDoubles == kBatchBufferSize) {
+                    flushLongs();
+                    flushDoubles();
+                }
+                doubles[numDoubles++] = input.getDouble();
+                break;
+            case NumberLong:
+                if (numDoubles > 0 || numLongs == kBatchBufferSize) {
+                    flushDoubles();
+                    flushLongs();
+                }
+                longs[numLongs++] = input.getLong();
+                break;
+            default:
+                flushDoubles();
+                flushLongs();
+                processInternal(input, merging);
+        }
+    }
+    flushDoubles();
+    flushLongs();
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorAvg(expCtx);
@@ -30,6 +30,7 @@
 
 #include "mongo/db/pipeline/accumulator.h"
 
+#include "mongo/base/compare_numbers.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/value.h"
@@ -61,6 +62,27 @@ void AccumulatorMinMax::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorMinMax::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    // Find the best of each run of consecutive doubles by comparing the doubles directly, since
+    // collation does not affect numbers, and offer only that one to processInternal(). Like
+    // processInternal(), keep the first of several equal values.
+    auto it = inputs.begin();
+    while (it != inputs.end()) {
+        if (it->getType() != NumberDouble) {
+            processInternal(*it++, merging);
+            continue;
+        }
+
+        auto best = it;
+        for (++it; it != inputs.end() && it->getType() == NumberDouble; ++it) {
+            if (compareDoubles(best->getDouble(), it->getDouble()) * _sense > 0) {
+                best = it;
+            }
+        }
+        processInternal(*best, merging);
+    }
+}
+
 Value AccumulatorMinMax::getValue(bool toBeMerged) const {
     if (_val.missing()) {
         return Value(BSONNULL);
@@ -52,6 +52,9 @@ const char* AccumulatorSum::getOpName() const {
 namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision.
+
+// The number of doubles or integers gathered from a batch before they are added to the total.
+const size_t kBatchBufferSize = 128;
 }  // namespace
 
 
@@ -84,6 +87,53 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    // Gather consecutive doubles, and consecutive integers, into plain arrays that are summed
+    // together. The arrays are flushed whenever the kind of input changes, so values are still
+    // added in input order and the total is identical to processing them one by one.
+    double doubles[kBatchBufferSize];
+    size_t numDoubles = 0;
+    long long longs[kBatchBufferSize];
+    size_t numLongs = 0;
+
+    auto flushDoubles = [&] {
+        nonDecimalTotal.addDoubles(doubles, numDoubles);
+        numDoubles = 0;
+    };
+    auto flushLongs = [&] {
+        nonDecimalTotal.addLongs(longs, numLongs);
+        numLongs = 0;
+    };
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberDouble:
+                if (numLongs > 0 || numDoubles == kBatchBufferSize) {
+                    flushLongs();
+                    flushDoubles();
+                }
+                totalType = Value::getWidestNumeric(totalType, NumberDouble);
+                doubles[numDoubles++] = input.getDouble();
+                break;
+            case NumberInt:
+            case NumberLong:
+                if (numDoubles > 0 || numLongs == kBatchBufferSize) {
+                    flushDoubles();
+                    flushLongs();
+                }
+                totalType = Value::getWidestNumeric(totalType, input.getType());
+                longs[numLongs++] = input.coerceToLong();
+                break;
+            default:
+                flushDoubles();
+                flushLongs();
+                processInternal(input, merging);
+        }
+    }
+    flushDoubles();
+    flushLongs();
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorSum(expCtx);
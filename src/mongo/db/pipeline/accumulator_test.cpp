@@ -66,6 +66,15 @@ static void assertExpectedResults(
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
 
+            // Asserts that result equals expected result when all input is processed as a batch.
+            {
+                boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
+                accum->processBatch(op.first, false);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
+
             // Asserts that result equals expected result when all input is on one shard.
             {
                 boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
@@ -334,6 +343,50 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+TEST(Accumulators, ProcessBatchMatchesProcessingEachInput) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+
+    // Long enough runs of each numeric type to fill the batch buffers more than once, interleaved
+    // with values that are not summed the same way.
+    std::vector<Value> inputs;
+    for (int i = 0; i < 300; ++i) {
+        inputs.push_back(Value(i * 1.1 - 100.05));
+    }
+    for (int i = 0; i < 300; ++i) {
+        inputs.push_back(i % 2 ? Value(i) : Value(static_cast<long long>(i) << 40));
+        if (i % 97 == 0) {
+            inputs.push_back(Value(0.1 * i));
+            inputs.push_back(Value(BSONNULL));
+            inputs.push_back(Value("string"_sd));
+        }
+    }
+    inputs.push_back(Value(-0.0));
+    inputs.push_back(Value(std::numeric_limits<double>::quiet_NaN()));
+    inputs.push_back(Value(Decimal128("0.25")));
+
+    for (auto&& accumulatorName : {"$sum", "$avg", "$min", "$max"}) {
+        auto factory = AccumulationStatement::getFactory(accumulatorName);
+
+        // Check results on inputs both with and without the trailing decimal.
+        for (size_t numInputs : {inputs.size() - 1, inputs.size()}) {
+            std::vector<Value> batch(inputs.begin(), inputs.begin() + numInputs);
+
+            boost::intrusive_ptr<Accumulator> expected(factory(expCtx));
+            for (auto&& input : batch) {
+                expected->process(input, false);
+            }
+
+            boost::intrusive_ptr<Accumulator> batched(factory(expCtx));
+            batched->processBatch(batch, false);
+
+            ASSERT_VALUE_EQ(expected->getValue(false), batched->getValue(false));
+            ASSERT_EQUALS(expected->getValue(false).getType(), batched->getValue(false).getType());
+            ASSERT_VALUE_EQ(expected->getValue(true), batched->getValue(true));
+            ASSERT_EQUALS(expected->memUsageForSorter(), batched->memUsageForSorter());
+        }
+    }
+}
+
 TEST(Accumulators, AddToSetRespectsCollation) {
     intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     expCtx->setCollator(
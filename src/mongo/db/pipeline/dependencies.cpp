@@ -172,7 +172,15 @@ Document documentHelper(const BSONObj& bson, const Document& neededFields, int n
 
         --nFieldsNeeded;  // Found a needed field.
         if (isNeeded.getType() == Bool) {
-            md.addField(fieldName, Value(bsonElement));
+            if (bsonElement.type() == BSONType::Object && bson.isOwned()) {
+                // The sub-document can share our buffer, and then only the parts of it which
+                // are used get converted.
+                BSONObj subObj = bsonElement.embeddedObject();
+                subObj.shareOwnershipWith(bson);
+                md.addField(fieldName, Value(subObj));
+            } else {
+                md.addField(fieldName, Value(bsonElement));
+            }
         } else {
             dassert(isNeeded.getType() == Object);
 
@@ -158,5 +158,25 @@ TEST(DependenciesToProjectionTest,
     ASSERT_BSONOBJ_EQ(deps.toProjection(), BSON(Document::metaFieldTextScore << metaTextScore));
 }
 
+TEST(ParsedDepsTest, ExtractsOnlyNeededFields) {
+    DepsTracker deps;
+    deps.fields = {"a", "c.d"};
+    auto parsedDeps = deps.toParsedDeps();
+    ASSERT(parsedDeps);
+
+    BSONObj input = BSON("a" << BSON("x" << 1 << "y" << 2) << "b" << 3 << "c"
+                             << BSON("d" << 4 << "e" << 5)
+                             << "f"
+                             << 6);
+    Document extracted = parsedDeps->extractFields(input);
+    ASSERT_EQ(2U, extracted.size());
+    ASSERT_BSONOBJ_EQ(BSON("a" << BSON("x" << 1 << "y" << 2) << "c" << BSON("d" << 4)),
+                      extracted.toBson());
+
+    // Unowned input, such as a record read straight from storage, gives the same result.
+    BSONObj unowned(input.objdata());
+    ASSERT_BSONOBJ_EQ(extracted.toBson(), parsedDeps->extractFields(unowned).toBson());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -45,7 +45,66 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
+namespace {
+bool isMetaFieldName(StringData fieldName) {
+    return fieldName == Document::metaFieldTextScore || fieldName == Document::metaFieldRandVal;
+}
+}  // namespace
+
+DocumentStorage::DocumentStorage(const BSONObj& bson, bool skipMetaFields) : DocumentStorage() {
+    invariant(bson.isOwned());
+    _bson = bson;
+    _bsonHasMetaFields = skipMetaFields;
+
+    BSONObjIterator it(_bson);
+    if (it.more()) {
+        _bsonNext = it.next().rawdata();
+    }
+}
+
 Position DocumentStorage::findField(StringData requested) const {
+    Position pos = findFieldInCache(requested);
+    if (!pos.found() && _bsonNext) {
+        pos = const_cast<DocumentStorage*>(this)->loadUntil(requested);
+    }
+    return pos;
+}
+
+Position DocumentStorage::loadUntil(StringData requested) {
+    while (_bsonNext) {
+        Position pos = loadNextField();
+        if (pos.found() && getField(pos).nameSD() == requested) {
+            return pos;
+        }
+    }
+    return Position();
+}
+
+Position DocumentStorage::loadNextField() {
+    const BSONElement elem(_bsonNext);
+    _bsonNext += elem.size();
+    if (*_bsonNext == EOO) {
+        _bsonNext = NULL;
+    }
+
+    const StringData fieldName = elem.fieldNameStringData();
+    if (_bsonHasMetaFields && fieldName[0] == '$' && isMetaFieldName(fieldName)) {
+        return Position();
+    }
+
+    Position pos = getNextPosition();
+    if (elem.type() == Object) {
+        // Let the sub-document reference our buffer so it can be converted lazily as well.
+        BSONObj subObj = elem.embeddedObject();
+        subObj.shareOwnershipWith(_bson);
+        appendField(fieldName) = Value(subObj);
+    } else {
+        appendField(fieldName) = Value(elem);
+    }
+    return pos;
+}
+
+Position DocumentStorage::findFieldInCache(StringData requested) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
     if (_numFields >= HASH_TAB_MIN) {  // hash lookup
@@ -62,7 +121,7 @@ Position DocumentStorage::findField(StringData requested) const {
             pos = elem.nextCollision;
         }
     } else {  // linear scan
-        for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
+        for (DocumentStorageIterator it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
             if (it->nameLen == reqSize && memcmp(requested.rawData(), it->_name, reqSize) == 0) {
                 return it.position();
             }
@@ -183,6 +242,9 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 }
 
 intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
+    // The clone is about to be modified, so it doesn't keep the BSON.
+    fillCache();
+
     intrusive_ptr<DocumentStorage> out(new DocumentStorage());
 
     // Make a copy of the buffer.
@@ -203,7 +265,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     out->_randVal = _randVal;
 
     // Tell values that they have been memcpyed (updates ref counts)
-    for (DocumentStorageIterator it = out->iteratorAll(); !it.atEnd(); it.advance()) {
+    for (DocumentStorageIterator it = out->iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.memcpyed();
     }
 
@@ -213,12 +275,18 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
 DocumentStorage::~DocumentStorage() {
     std::unique_ptr<char[]> deleteBufferAtScopeEnd(_buffer);
 
-    for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
+    for (DocumentStorageIterator it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 }
 
 Document::Document(const BSONObj& bson) {
+    if (bson.isOwned() && !bson.isEmpty()) {
+        // We can hold on to owned BSON and only convert the fields which are actually used.
+        _storage = new DocumentStorage(bson, false);
+        return;
+    }
+
     MutableDocument md(bson.nFields());
 
     BSONObjIterator it(bson);
@@ -279,6 +347,37 @@ BSONObj Document::toBsonWithMetaData() const {
 }
 
 Document Document::fromBsonWithMetaData(const BSONObj& bson) {
+    if (bson.isOwned() && !bson.isEmpty()) {
+        // Only the metadata is extracted up front. The fields are converted lazily.
+        bool hasMetaFields = false;
+        double textScore = 0;
+        double randVal = 0;
+        bool hasTextScore = false;
+        bool hasRandVal = false;
+        BSONForEach(elem, bson) {
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName[0] != '$') {
+                continue;
+            }
+            if (fieldName == metaFieldTextScore) {
+                textScore = elem.Double();
+                hasTextScore = hasMetaFields = true;
+            } else if (fieldName == metaFieldRandVal) {
+                randVal = elem.Double();
+                hasRandVal = hasMetaFields = true;
+            }
+        }
+
+        intrusive_ptr<DocumentStorage> storage(new DocumentStorage(bson, hasMetaFields));
+        if (hasTextScore) {
+            storage->setTextScore(textScore);
+        }
+        if (hasRandVal) {
+            storage->setRandMetaField(randVal);
+        }
+        return Document(storage.get());
+    }
+
     MutableDocument md;
 
     BSONObjIterator it(bson);
@@ -373,7 +472,11 @@ size_t Document::getApproximateSize() const {
     size_t size = sizeof(DocumentStorage);
     size += storage().allocatedBytes();
 
-    for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
+    // Fields which haven't been converted yet are accounted for by the size of the BSON.
+    size += storage().bsonBytes();
+    for (DocumentStorageIterator it = storage().iteratorCacheOnly(); !it.atEnd(); it.advance()) {
+        if (it->val.missing())
+            continue;
         size += it->val.getApproximateSize();
         size -= sizeof(Value);  // already accounted for above
     }
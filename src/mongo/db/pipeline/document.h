@@ -93,7 +93,10 @@ public:
     /// Empty Document (does no allocation)
     Document() {}
 
-    /// Create a new Document deep-converted from the given BSONObj.
+    /**
+     * Create a new Document from the given BSONObj. If 'bson' is owned, the Document holds on to
+     * it and only converts fields as they are accessed. Otherwise it is deep-converted up front.
+     */
     explicit Document(const BSONObj& bson);
 
     /**
@@ -533,7 +536,7 @@ private:
         _storage = ds.detach();
     }
 
-    // This is split into 3 functions to speed up the fast-path
+    // This is split into 4 functions to speed up the fast-path
     DocumentStorage& storage() {
         if (MONGO_unlikely(!_storage))
             return newStorage();
@@ -541,6 +544,9 @@ private:
         if (MONGO_unlikely(_storage->isShared()))
             return clonedStorage();
 
+        if (MONGO_unlikely(storagePtr()->hasBson()))
+            return releasedStorage();
+
         // This function exists to ensure this is safe
         return const_cast<DocumentStorage&>(*storagePtr());
     }
@@ -552,6 +558,12 @@ private:
         reset(storagePtr()->clone());
         return const_cast<DocumentStorage&>(*storagePtr());
     }
+    DocumentStorage& releasedStorage() {
+        // Modifying a document detaches it from the BSON it was created from.
+        DocumentStorage& storage = const_cast<DocumentStorage&>(*storagePtr());
+        storage.releaseBson();
+        return storage;
+    }
 
     // recursive helpers for same-named public methods
     MutableValue getNestedFieldHelper(const FieldPath& dottedField, size_t level);
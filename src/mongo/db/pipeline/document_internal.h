@@ -34,6 +34,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include "mongo/base/static_assert.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -178,7 +179,14 @@ private:
     bool _includeMissing;
 };
 
-/// Storage class used by both Document and MutableDocument
+/** Storage class used by both Document and MutableDocument
+ *
+ *  Storage created from a BSONObj converts its fields lazily: fields are only added to _buffer
+ *  as lookups reach them, or all at once when the document is iterated or modified. This makes
+ *  reading a few fields of a wide document much cheaper than converting all of it up front.
+ *  Lazy conversion mutates the storage behind const methods, so as with Document in general, a
+ *  DocumentStorage must not be used by more than one thread at a time.
+ */
 class DocumentStorage : public RefCountable {
 public:
     DocumentStorage()
@@ -187,10 +195,19 @@ public:
           _usedBytes(0),
           _numFields(0),
           _hashTabMask(0),
+          _bsonNext(NULL),
+          _bsonHasMetaFields(false),
           _metaFields(),
           _textScore(0),
           _randVal(0) {}
 
+    /**
+     * Creates storage whose fields are those of 'bson', which must be owned. If
+     * 'skipMetaFields' is true, top-level fields with metadata names such as "$textScore" are
+     * not treated as fields of the document.
+     */
+    DocumentStorage(const BSONObj& bson, bool skipMetaFields);
+
     ~DocumentStorage();
 
     enum MetaType : char {
@@ -220,6 +237,26 @@ public:
     /// Returns the position of the named field (may be missing) or Position()
     Position findField(StringData name) const;
 
+    /// True if this storage was created from BSON and has not been modified since.
+    bool hasBson() const {
+        return _bson.isOwned();
+    }
+
+    /// The size of the BSON backing this storage, if any.
+    size_t bsonBytes() const {
+        return hasBson() ? _bson.objsize() : 0;
+    }
+
+    /**
+     * Converts any remaining fields and detaches this storage from its BSON. Must be called
+     * before modifying the storage.
+     */
+    void releaseBson() {
+        fillCache();
+        _bson = BSONObj();
+        _bsonHasMetaFields = false;
+    }
+
     // Document uses these
     const ValueElement& getField(Position pos) const {
         verify(pos.found());
@@ -254,11 +291,18 @@ public:
 
     /// This skips missing values
     DocumentStorageIterator iterator() const {
+        fillCache();
         return DocumentStorageIterator(_firstElement, end(), false);
     }
 
     /// This includes missing values
     DocumentStorageIterator iteratorAll() const {
+        fillCache();
+        return iteratorCacheOnly();
+    }
+
+    /// Like iteratorAll(), but without converting fields that are still pending in the BSON.
+    DocumentStorageIterator iteratorCacheOnly() const {
         return DocumentStorageIterator(_firstElement, end(), true);
     }
 
@@ -313,6 +357,25 @@ private:
     /// Allocates space in _buffer. Copies existing data if there is any.
     void alloc(unsigned newSize);
 
+    /// Like findField, but only considers fields which have already been converted.
+    Position findFieldInCache(StringData name) const;
+
+    /// Converts pending fields up to and including the first one named 'name'.
+    Position loadUntil(StringData name);
+
+    /// Converts the next pending field. Returns its position, or Position() if it was skipped.
+    Position loadNextField();
+
+    /// Converts all pending fields.
+    void fillCache() const {
+        if (MONGO_unlikely(_bsonNext != NULL)) {
+            auto self = const_cast<DocumentStorage*>(this);
+            while (self->_bsonNext) {
+                self->loadNextField();
+            }
+        }
+    }
+
     /// Call after adding field to _buffer and increasing _numFields
     void addFieldToHashTable(Position pos);
 
@@ -348,7 +411,7 @@ private:
     /// Adds all fields to the hash table
     void rehash() {
         hashTabInit();
-        for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance())
+        for (DocumentStorageIterator it = iteratorCacheOnly(); !it.atEnd(); it.advance())
             addFieldToHashTable(it.position());
     }
 
@@ -382,6 +445,11 @@ private:
     unsigned _numFields;    // this includes removed fields
     unsigned _hashTabMask;  // equal to hashTabBuckets()-1 but used more often
 
+    // If owned, the document this storage was created from. Cleared by releaseBson().
+    BSONObj _bson;
+    const char* _bsonNext;    // next field of _bson to convert, or NULL once all are converted
+    bool _bsonHasMetaFields;  // _bson has fields which are metadata rather than document fields
+
     std::bitset<MetaType::NUM_FIELDS> _metaFields;
     double _textScore;
     double _randVal;
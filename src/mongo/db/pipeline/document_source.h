@@ -544,6 +544,11 @@ public:
         virtual CollectionIndexUsageMap getIndexStats(OperationContext* opCtx,
                                                       const NamespaceString& ns) = 0;
 
+        /**
+         * Returns the execution statistics of the query shapes run against collection "nss"
+         */
+        virtual std::vector<BSONObj> getQueryShapeStats(const NamespaceString& nss) const = 0;
+
         /**
          * Appends operation latency statistics for collection "nss" to "builder"
          */
@@ -30,6 +30,7 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -38,15 +39,20 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -157,16 +163,23 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     }
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                results[facetId].emplace_back(next.releaseDocument());
+    const size_t numThreads = std::min(
+        _facets.size(),
+        static_cast<size_t>(std::max(1, internalDocumentSourceFacetMaxThreads.load())));
+    if (numThreads > 1 && canRunFacetsConcurrently()) {
+        runFacetsConcurrently(numThreads, &results);
+    } else {
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                const auto& pipeline = _facets[facetId].pipeline;
+                auto next = pipeline->getSources().back()->getNext();
+                for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                    results[facetId].emplace_back(next.releaseDocument());
+                }
+                allPipelinesEOF = allPipelinesEOF && next.isEOF();
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
 
@@ -179,6 +192,70 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     return resultDoc.freeze();
 }
 
+bool DocumentSourceFacet::canRunFacetsConcurrently() const {
+    for (auto&& facet : _facets) {
+        for (auto&& stage : facet.pipeline->getSources()) {
+            // $sample draws from the Client's random number generator.
+            if (dynamic_cast<DocumentSourceNeedsMongod*>(stage.get()) ||
+                dynamic_cast<DocumentSourceSample*>(stage.get())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void DocumentSourceFacet::runFacetsConcurrently(size_t numThreads,
+                                                std::vector<std::vector<Value>>* results) {
+    _teeBuffer->setBatchesLoadedByCaller();
+
+    std::vector<Status> statuses(_facets.size(), Status::OK());
+    bool moreInput = true;
+    while (moreInput) {
+        // Once the input is exhausted, one more round lets each sub-pipeline see EOF and produce
+        // whatever it has been holding back, such as the groups of a $group.
+        moreInput = _teeBuffer->loadNextBatchForConsumers();
+
+        AtomicUInt32 nextFacetId;
+        auto runFacets = [&] {
+            for (size_t facetId = nextFacetId.fetchAndAdd(1); facetId < _facets.size();
+                 facetId = nextFacetId.fetchAndAdd(1)) {
+                try {
+                    const auto& pipeline = _facets[facetId].pipeline;
+                    auto next = pipeline->getSources().back()->getNext();
+                    for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                        (*results)[facetId].emplace_back(next.releaseDocument());
+                    }
+                } catch (const DBException& ex) {
+                    statuses[facetId] = ex.toStatus();
+                }
+            }
+        };
+
+        // The worker threads only live as long as one batch, so that none outlives an exception
+        // thrown on this thread.
+        std::vector<stdx::thread> workers;
+        auto joinWorkers = [&] {
+            for (auto&& worker : workers) {
+                worker.join();
+            }
+            workers.clear();
+        };
+        ON_BLOCK_EXIT(joinWorkers);
+
+        for (size_t i = 1; i < numThreads; ++i) {
+            workers.emplace_back(runFacets);
+        }
+        runFacets();
+        joinWorkers();
+
+        for (auto&& status : statuses) {
+            uassertStatusOK(status);
+        }
+        pExpCtx->checkForInterrupt();
+    }
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
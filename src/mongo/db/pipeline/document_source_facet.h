@@ -137,6 +137,20 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns true if no stage of any sub-pipeline uses the OperationContext, such as to query a
+     * collection, other than to check for interrupts. Only then may the sub-pipelines run on
+     * several threads at once.
+     */
+    bool canRunFacetsConcurrently() const;
+
+    /**
+     * Runs the sub-pipelines over each batch of '_teeBuffer' on up to 'numThreads' threads,
+     * appending the output of each to its entry of 'results'. The sub-pipelines of one batch all
+     * finish before the next batch is loaded, so they share that single buffered batch.
+     */
+    void runFacetsConcurrently(size_t numThreads, std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -43,8 +43,11 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -282,6 +285,47 @@ TEST_F(DocumentSourceFacetTest,
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ShouldRunFacetsOnSeveralThreadsOverSeveralBatches) {
+    auto ctx = getExpCtx();
+
+    const int originalMaxThreads = internalDocumentSourceFacetMaxThreads.load();
+    const int originalBufferSizeBytes = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceFacetMaxThreads.store(originalMaxThreads);
+        internalQueryFacetBufferSizeBytes.store(originalBufferSizeBytes);
+    });
+    internalDocumentSourceFacetMaxThreads.store(3);
+    internalQueryFacetBufferSizeBytes.store(100);  // Only a few documents fit in each batch.
+
+    std::vector<DocumentSourceFacet::FacetPipeline> facets;
+    for (int i = 0; i < 5; i++) {
+        auto pipeline = uassertStatusOK(Pipeline::create(
+            {DocumentSourceSkip::create(ctx, i), DocumentSourceLimit::create(ctx, 20)}, ctx));
+        facets.emplace_back(str::stream() << "skip" << i, pipeline);
+    }
+    auto facetStage = DocumentSourceFacet::create(std::move(facets), ctx);
+
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50; i++) {
+        inputs.push_back(Document{{"_id", i}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    facetStage->setSource(mock.get());
+
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT_EQ(output.getDocument().size(), 5UL);
+    for (int i = 0; i < 5; i++) {
+        vector<Value> expected;
+        for (int id = i; id < i + 20; id++) {
+            expected.emplace_back(Document{{"_id", id}});
+        }
+        ASSERT_VALUE_EQ(output.getDocument()[std::string(str::stream() << "skip" << i)],
+                        Value(expected));
+    }
+    ASSERT(facetStage->getNext().isEOF());
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSubPipeline) {
     auto ctx = getExpCtx();
 
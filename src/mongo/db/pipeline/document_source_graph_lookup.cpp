@@ -33,6 +33,7 @@
 #include "mongo/base/init.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_comparator.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/stdx/memory.h"
 
@@ -179,7 +181,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -194,12 +196,12 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
-            // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+        // Query for all keys that were in the frontier and not in the cache, populating
+        // '_frontier' for the next iteration of search.
+        for (auto&& matchStage : matchStages) {
+            // We've already allocated space for the $match stage in '_fromPipeline', which is
+            // followed by '_fromProjection' if there is one.
+            _fromPipeline[_fromPipeline.size() - (_fromProjection ? 2 : 1)] = matchStage;
             auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
             while (auto next = pipeline->getNext()) {
                 uassert(40271,
@@ -273,7 +275,7 @@ void DocumentSourceGraphLookUp::addToCache(Document result, const ValueUnordered
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -291,35 +293,88 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
+    // Create queries of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]},
+    // splitting the frontier between them so that no query grows too large to build.
     //
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+    // We wrap each query in a $match so that it can be parsed into a DocumentSourceMatch when
     // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    {
-        BSONObjBuilder query(match.subobjStart("$match"));
+    const size_t maxQueryValueBytes =
+        std::max(internalDocumentSourceGraphLookupFrontierQueryMaxBytes.load(), 1);
+    std::vector<BSONObj> matchStages;
+    auto it = _frontier.begin();
+    while (it != _frontier.end()) {
+        BSONObjBuilder match;
         {
-            BSONArrayBuilder andObj(query.subarrayStart("$and"));
-            if (_additionalFilter) {
-                andObj << *_additionalFilter;
-            }
-
+            BSONObjBuilder query(match.subobjStart("$match"));
             {
-                BSONObjBuilder connectToObj(andObj.subobjStart());
+                BSONArrayBuilder andObj(query.subarrayStart("$and"));
+                if (_additionalFilter) {
+                    andObj << *_additionalFilter;
+                }
+
                 {
-                    BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                    BSONObjBuilder connectToObj(andObj.subobjStart());
                     {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                        {
+                            BSONArrayBuilder in(subObj.subarrayStart("$in"));
+                            size_t queryValueBytes = 0;
+                            do {
+                                queryValueBytes += it->getApproximateSize();
+                                in << *it;
+                                ++it;
+                            } while (it != _frontier.end() &&
+                                     queryValueBytes + it->getApproximateSize() <=
+                                         maxQueryValueBytes);
                         }
                     }
                 }
             }
         }
+        matchStages.push_back(match.obj());
+    }
+
+    return matchStages;
+}
+
+boost::optional<BSONObj> DocumentSourceGraphLookUp::makeProjectionForFromDocuments(
+    Pipeline::SourceContainer::const_iterator first,
+    Pipeline::SourceContainer::const_iterator last) const {
+    // Gather the fields used by the rest of the pipeline, much as Pipeline::getDependencies()
+    // does. Only fields are of interest here; the documents from the 'from' collection carry no
+    // metadata.
+    DepsTracker deps(DepsTracker::MetadataAvailable::kNoMetadata);
+    bool knowAllFields = false;
+    for (; first != last && !knowAllFields; ++first) {
+        DepsTracker localDeps(deps.getMetadataAvailable());
+        auto status = (*first)->getDependencies(&localDeps);
+        if (status == DocumentSource::NOT_SUPPORTED || localDeps.needWholeDocument) {
+            return boost::none;
+        }
+        deps.fields.insert(localDeps.fields.begin(), localDeps.fields.end());
+        knowAllFields = status & DocumentSource::EXHAUSTIVE_FIELDS;
+    }
+
+    if (!knowAllFields) {
+        return boost::none;
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    // The search itself needs '_id' to de-duplicate the documents, 'connectFromField' to recurse,
+    // and 'connectToField' to cache them.
+    DepsTracker fromDeps(DepsTracker::MetadataAvailable::kNoMetadata);
+    fromDeps.fields = {"_id", _connectFromField.fullPath(), _connectToField.fullPath()};
+
+    const auto asPath = _as.fullPath();
+    for (auto&& field : deps.fields) {
+        if (expression::isPathPrefixOf(asPath, field)) {
+            fromDeps.fields.insert(field.substr(asPath.size() + 1));
+        } else if (field == asPath || expression::isPathPrefixOf(field, asPath)) {
+            // The 'as' documents are used whole.
+            return boost::none;
+        }
+    }
+
+    return fromDeps.toProjection();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
@@ -367,6 +422,16 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
         container->erase(std::next(itr));
         return itr;
     }
+
+    // Project away the fields of the queried documents which the rest of the pipeline doesn't
+    // use, so the search doesn't copy and cache them.
+    if (_fromProjection) {
+        _fromPipeline.pop_back();
+    }
+    _fromProjection = makeProjectionForFromDocuments(std::next(itr), container->end());
+    if (_fromProjection) {
+        _fromPipeline.push_back(BSON("$project" << *_fromProjection));
+    }
     return std::next(itr);
 }
 
@@ -468,8 +533,8 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline = resolvedNamespace.pipeline;
 
     // We append an additional BSONObj to '_fromPipeline' as a placeholder for the $match stage
-    // we'll eventually construct from the input document.
-    _fromPipeline.reserve(_fromPipeline.size() + 1);
+    // we'll eventually construct from the input document, leaving room for a trailing $project.
+    _fromPipeline.reserve(_fromPipeline.size() + 2);
     _fromPipeline.push_back(BSONObj());
 }
 
@@ -60,6 +60,8 @@ public:
 
     /**
      * Attempts to combine with a subsequent $unwind stage, setting the internal '_unwind' field.
+     * Otherwise, restricts the documents queried from the 'from' collection to the fields the rest
+     * of the pipeline uses, if those are known.
      */
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
@@ -115,15 +117,27 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection, each wrapped in a $match, by using
+     * the contents of '_frontier'. The values of a large frontier are split between several
+     * queries, each with at most internalDocumentSourceGraphLookupFrontierQueryMaxBytes of values.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns an empty vector if no query is necessary, i.e., all values were retrieved from the
+     * cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
+
+    /**
+     * Returns the inclusion projection to apply to the documents queried from the 'from'
+     * collection, given the stages in the range ['first', 'last') which consume the output of this
+     * stage. The projection keeps '_id', 'connectFromField', 'connectToField', and whichever
+     * fields of the 'as' documents those stages use. Returns boost::none if the dependencies of
+     * those stages are not known, or if they use the 'as' documents in their entirety.
+     */
+    boost::optional<BSONObj> makeProjectionForFromDocuments(
+        Pipeline::SourceContainer::const_iterator first,
+        Pipeline::SourceContainer::const_iterator last) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -180,6 +194,10 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
+    // The $project stage trailing the $match in '_fromPipeline', if the rest of the pipeline needs
+    // only some of the fields of the documents this stage outputs.
+    boost::optional<BSONObj> _fromProjection;
+
     size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
@@ -35,11 +35,14 @@
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/stub_mongod_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -72,11 +75,17 @@ public:
         pipeline.getValue()->addInitialSource(DocumentSourceMock::create(_results));
         pipeline.getValue()->optimizePipeline();
 
+        ++_numPipelinesMade;
         return pipeline;
     }
 
+    int numPipelinesMade() const {
+        return _numPipelinesMade;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numPipelinesMade = 0;
 };
 
 TEST_F(DocumentSourceGraphLookUpTest,
@@ -612,5 +621,127 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSplitLargeFrontierBetweenSeveralQueries) {
+    auto expCtx = getExpCtx();
+
+    auto originalMaxBytes = internalDocumentSourceGraphLookupFrontierQueryMaxBytes.load();
+    ON_BLOCK_EXIT([originalMaxBytes] {
+        internalDocumentSourceGraphLookupFrontierQueryMaxBytes.store(originalMaxBytes);
+    });
+    // Put each value of the frontier in a query of its own.
+    internalDocumentSourceGraphLookupFrontierQueryMaxBytes.store(1);
+
+    auto inputMock = DocumentSourceMock::create(Document({{"_id", 0}}));
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    std::deque<DocumentSource::GetNextResult> fromContents{
+        Document{{"_id", "a"_sd}, {"to", 0}, {"from", std::vector<Value>{Value(1), Value(2)}}},
+        Document{{"_id", "b"_sd}, {"to", 1}},
+        Document{{"_id", "c"_sd}, {"to", 2}}};
+    auto mongod = std::make_shared<MockMongodImplementation>(std::move(fromContents));
+
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx, "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(mongod);
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto results = next.releaseDocument()["results"];
+    ASSERT_EQ(results.getArrayLength(), 3UL);
+
+    // One query for the starting value, and one for each of the two values of the next frontier.
+    ASSERT_EQ(mongod->numPipelinesMade(), 3);
+    ASSERT(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldProjectQueriedDocumentsToFieldsUsedLater) {
+    auto expCtx = getExpCtx();
+
+    auto inputMock = DocumentSourceMock::create(Document({{"_id", 0}}));
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    std::deque<DocumentSource::GetNextResult> fromContents{
+        Document{{"_id", "a"_sd}, {"to", 0}, {"name", "x"_sd}, {"extra", 1}}};
+
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx, "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(
+        std::make_shared<MockMongodImplementation>(std::move(fromContents)));
+
+    Pipeline::SourceContainer container{
+        graphLookupStage, DocumentSourceProject::create(BSON("results.name" << 1), expCtx)};
+    graphLookupStage->optimizeAt(container.begin(), &container);
+    ASSERT_EQ(container.size(), 2UL);
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    Document expectedResult{
+        {"_id", 0},
+        {"results",
+         std::vector<Value>{Value{Document{{"_id", "a"_sd}, {"to", 0}, {"name", "x"_sd}}}}}};
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), expectedResult);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldNotProjectQueriedDocumentsUsedWhole) {
+    auto expCtx = getExpCtx();
+
+    auto inputMock = DocumentSourceMock::create(Document({{"_id", 0}}));
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    std::deque<DocumentSource::GetNextResult> fromContents{
+        Document{{"_id", "a"_sd}, {"to", 0}, {"name", "x"_sd}, {"extra", 1}}};
+
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx, "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(
+        std::make_shared<MockMongodImplementation>(std::move(fromContents)));
+
+    Pipeline::SourceContainer container{
+        graphLookupStage, DocumentSourceProject::create(BSON("results" << 1), expCtx)};
+    graphLookupStage->optimizeAt(container.begin(), &container);
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    Document expectedResult{
+        {"_id", 0},
+        {"results",
+         std::vector<Value>{Value{
+             Document{{"_id", "a"_sd}, {"to", 0}, {"name", "x"_sd}, {"extra", 1}}}}}};
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), expectedResult);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -28,17 +28,29 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <deque>
+
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_tree.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -51,6 +63,94 @@ REGISTER_DOCUMENT_SOURCE(group,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceGroup::createFromBson);
 
+namespace {
+
+// The most inputs for a single group that are queued before being handed to its accumulators.
+const size_t kMaxBatchedGroupInputs = 64;
+
+// The number of inputs handed to a partition's worker thread at a time.
+const size_t kPartitionBatchSize = 256;
+
+// The number of batches which may wait for a worker thread before the thread reading the input
+// blocks.
+const size_t kMaxQueuedPartitionBatches = 4;
+
+/**
+ * Returns the memory used by a new entry of a group map: its _id, the vector of accumulators and
+ * the accumulators as they were created. Their growth is accounted for as they process input.
+ */
+size_t newGroupMemUsage(const Value& id, const DocumentSourceGroup::Accumulators& group) {
+    size_t size = id.getApproximateSize() + sizeof(group) +
+        group.capacity() * sizeof(DocumentSourceGroup::Accumulators::value_type);
+    for (auto&& accumulator : group) {
+        size += accumulator->memUsageForSorter();
+    }
+    return size;
+}
+
+size_t numPartitionsFromKnob() {
+    const int numPartitions = internalDocumentSourceGroupPartitions.load();
+    return std::min(static_cast<size_t>(std::max(numPartitions, 1)),
+                    DocumentSourceGroup::kMaxPartitions);
+}
+
+}  // namespace
+
+/**
+ * A bounded queue of batches of (_id, accumulator arguments) pairs, each batch destined for the
+ * groups of a single partition.
+ */
+class DocumentSourceGroup::PartitionQueue {
+    MONGO_DISALLOW_COPYING(PartitionQueue);
+
+public:
+    using Batch = std::vector<std::pair<Value, std::vector<Value>>>;
+
+    PartitionQueue() = default;
+
+    /**
+     * Adds 'batch' to the queue, waiting while the queue is full.
+     */
+    void push(Batch batch) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _notFull.wait(lk, [&] { return _batches.size() < kMaxQueuedPartitionBatches; });
+        _batches.push_back(std::move(batch));
+        _notEmpty.notify_one();
+    }
+
+    /**
+     * Removes and returns the oldest batch, waiting for one if the queue is empty. Returns
+     * boost::none once the queue is both closed and empty.
+     */
+    boost::optional<Batch> pop() {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _notEmpty.wait(lk, [&] { return !_batches.empty() || _closed; });
+        if (_batches.empty()) {
+            return boost::none;
+        }
+        Batch batch = std::move(_batches.front());
+        _batches.pop_front();
+        _notFull.notify_one();
+        return std::move(batch);
+    }
+
+    /**
+     * Indicates that no more batches will be pushed.
+     */
+    void close() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _closed = true;
+        _notEmpty.notify_one();
+    }
+
+private:
+    stdx::mutex _mutex;
+    stdx::condition_variable _notEmpty;
+    stdx::condition_variable _notFull;
+    std::deque<Batch> _batches;
+    bool _closed = false;
+};
+
 const char* DocumentSourceGroup::getSourceName() const {
     return "$group";
 }
@@ -66,11 +166,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
         invariant(initializationResult.isEOF());
     }
 
-    for (auto&& accum : _currentAccumulators) {
-        accum->reset();  // Prep accumulators for a new group.
-    }
-
     if (_spilled) {
+        for (auto&& accum : _currentAccumulators) {
+            accum->reset();  // Prep accumulators for a new group.
+        }
         return getNextSpilled();
     } else if (_streaming) {
         return getNextStreaming();
@@ -120,65 +219,122 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 
     Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->inShard);
 
-    if (++groupsIterator == _groups->end())
+    if (++groupsIterator == _groups->end() && !loadNextPartition())
         dispose();
 
     return std::move(out);
 }
 
+namespace {
+/**
+ * Returns true if 'doc' has a scalar, non-nullish value at each of 'paths', so that sorting on
+ * 'paths' puts it next to every other document of its group.
+ */
+bool hasGroupableSortKey(const Document& doc, const std::vector<FieldPath>& paths) {
+    for (auto&& path : paths) {
+        Value val = doc.getField(path.getFieldName(0));
+        for (size_t i = 1; i < path.getPathLength(); ++i) {
+            if (val.getType() != Object) {
+                return false;  // The value is missing, or under an array.
+            }
+            val = val.getDocument().getField(path.getFieldName(i));
+        }
+        if (val.nullish() || val.getType() == Array) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
-    // Streaming optimization is active.
-    if (!_firstDocOfNextGroup) {
+    // Streaming optimization is active. Each group is output as soon as a document of the next
+    // group arrives, so only the group in progress is held in memory.
+    while (!_streamingInputExhausted) {
         auto nextInput = pSource->getNext();
-        if (!nextInput.isAdvanced()) {
+        if (nextInput.isPaused()) {
             return nextInput;
         }
-        _firstDocOfNextGroup = nextInput.releaseDocument();
-    }
-
-    Value id;
-    do {
-        // Add to the current accumulator(s).
-        for (size_t i = 0; i < _currentAccumulators.size(); i++) {
-            _currentAccumulators[i]->process(vpExpression[i]->evaluate(_variables.get()),
-                                             _doingMerge);
+        if (nextInput.isEOF()) {
+            _streamingInputExhausted = true;
+            groupsIterator = _groups->begin();
+            if (_streamingGroupStarted) {
+                _streamingGroupStarted = false;
+                return makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
+            }
+            break;
         }
 
-        // Release our references to the previous input document before asking for the next. This
-        // makes operations like $unwind more efficient.
-        _variables->clearRoot();
+        Document input = nextInput.releaseDocument();
+        const bool inSortOrder = hasGroupableSortKey(input, _streamingSortPaths);
+        _variables->setRoot(std::move(input));
+        Value id = computeId(_variables.get());
 
-        // Retrieve the next document.
-        auto nextInput = pSource->getNext();
-        if (!nextInput.isAdvanced()) {
-            return nextInput;
+        Accumulators* group = &_currentAccumulators;
+        boost::optional<Document> out;
+        if (!inSortOrder) {
+            const size_t oldSize = _groups->size();
+            group = &(*_groups)[id];
+            if (_groups->size() != oldSize) {
+                for (size_t i = 0; i < vpAccumulatorFactory.size(); i++) {
+                    group->push_back(vpAccumulatorFactory[i](pExpCtx));
+                }
+                _memoryUsageBytes += newGroupMemUsage(id, *group);
+            }
+        } else if (!_streamingGroupStarted) {
+            _currentId = std::move(id);
+            _streamingGroupStarted = true;
+        } else if (!pExpCtx->getValueComparator().evaluate(_currentId == id)) {
+            // This document starts the next group, so the current one is complete.
+            out = makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
+            for (auto&& accum : _currentAccumulators) {
+                accum->reset();
+            }
+            _currentId = std::move(id);
         }
 
-        _firstDocOfNextGroup = nextInput.releaseDocument();
-
-        _variables->setRoot(*_firstDocOfNextGroup);
+        for (size_t i = 0; i < group->size(); i++) {
+            if (!inSortOrder) {
+                _memoryUsageBytes -= (*group)[i]->memUsageForSorter();
+            }
+            (*group)[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
+            if (!inSortOrder) {
+                _memoryUsageBytes += (*group)[i]->memUsageForSorter();
+            }
+        }
+        uassert(ErrorCodes::ExceededMemoryLimit,
+                "Exceeded memory limit for $group on null, missing or array values of sorted "
+                "input",
+                _memoryUsageBytes <= _maxMemoryUsageBytes);
 
-        // Compute the id. If it does not match _currentId, we will exit the loop, leaving
-        // _firstDocOfNextGroup set for the next time getNext() is called.
-        id = computeId(_variables.get());
-    } while (pExpCtx->getValueComparator().evaluate(_currentId == id));
+        // Release our references to the input document before asking for the next. This makes
+        // operations like $unwind more efficient.
+        _variables->clearRoot();
 
-    Document out = makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
-    _currentId = std::move(id);
+        if (out) {
+            return std::move(*out);
+        }
+    }
 
+    // Output the groups which were not in sort order.
+    if (groupsIterator == _groups->end()) {
+        dispose();
+        return GetNextResult::makeEOF();
+    }
+    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->inShard);
+    ++groupsIterator;
     return std::move(out);
 }
 
 void DocumentSourceGroup::dispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _partitions.clear();
     _sorterIterator.reset();
 
     // Make us look done.
     groupsIterator = _groups->end();
 
-    _firstDocOfNextGroup = boost::none;
-
     // Free our source's resources.
     pSource->dispose();
 }
@@ -276,6 +432,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _initialized(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
+      _numPartitions(numPartitionsFromKnob()),
       _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter) {}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
@@ -421,28 +578,6 @@ bool containsOnlyFieldPathsAndConstants(ExpressionObject* expressionObj) {
     return true;
 }
 
-void getFieldPathMap(ExpressionObject* expressionObj,
-                     std::string prefix,
-                     StringMap<std::string>* fields) {
-    // Given an expression with only constant and FieldPath leaf nodes, such as {x: {y: "$a.b"}},
-    // attempt to compute a map from each FieldPath leaf to the path of that leaf. In the example,
-    // this method would return: {"a.b" : "x.y"}.
-
-    for (auto&& it : expressionObj->getChildExpressions()) {
-        intrusive_ptr<Expression> childExp = it.second;
-        ExpressionObject* expObj = dynamic_cast<ExpressionObject*>(childExp.get());
-        ExpressionFieldPath* expPath = dynamic_cast<ExpressionFieldPath*>(childExp.get());
-
-        std::string newPrefix = prefix.empty() ? it.first : prefix + "." + it.first;
-
-        if (expObj) {
-            getFieldPathMap(expObj, newPrefix, fields);
-        } else if (expPath) {
-            (*fields)[expPath->getFieldPath().tail().fullPath()] = newPrefix;
-        }
-    }
-}
-
 void getFieldPathListForSpilled(ExpressionObject* expressionObj,
                                 std::string prefix,
                                 std::vector<std::string>* fields) {
@@ -469,9 +604,12 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
     boost::optional<BSONObj> inputSort = findRelevantInputSort();
     if (inputSort) {
-        // We can convert to streaming.
+        // We can convert to streaming. Documents are read as groups are output.
         _streaming = true;
         _inputSort = *inputSort;
+        for (auto&& sortField : _inputSort) {
+            _streamingSortPaths.emplace_back(sortField.fieldName());
+        }
 
         // Set up accumulators.
         _currentAccumulators.reserve(numAccumulators);
@@ -479,66 +617,85 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             _currentAccumulators.push_back(vpAccumulatorFactory[i](pExpCtx));
         }
 
-        // We only need to load the first document.
-        auto firstInput = pSource->getNext();
-        if (!firstInput.isAdvanced()) {
-            // Leave '_firstDocOfNextGroup' uninitialized and return.
-            return firstInput;
-        }
-        _firstDocOfNextGroup = firstInput.releaseDocument();
-        _variables->setRoot(*_firstDocOfNextGroup);
-
-        // Compute the _id value.
-        _currentId = computeId(_variables.get());
         _initialized = true;
         return DocumentSource::GetNextResult::makeEOF();
     }
 
     dassert(numAccumulators == vpExpression.size());
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
-    for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(16945,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _extSortAllowed);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+    // Consecutive inputs that belong to the same group are handed to its accumulators together,
+    // which lets them reduce runs of numbers without examining each Value separately. The group's
+    // memory usage is only brought up to date when the batch is flushed, so the batch is kept
+    // short.
+    Accumulators* batchGroup = nullptr;
+    Value batchId;
+    size_t batchSize = 0;
+    vector<vector<Value>> batchInputs(numAccumulators);
+    auto flushBatch = [&] {
+        if (!batchGroup) {
+            return;
+        }
+        for (size_t i = 0; i < numAccumulators; i++) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= (*batchGroup)[i]->memUsageForSorter();
+            (*batchGroup)[i]->processBatch(batchInputs[i], _doingMerge);
+            _memoryUsageBytes += (*batchGroup)[i]->memUsageForSorter();
+            batchInputs[i].clear();
         }
+        batchGroup = nullptr;
+        batchSize = 0;
+    };
 
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. A partitioned
+    // $group instead populates '_partitions', and never enters the loop.
+    GetNextResult input = _numPartitions > 1 ? initializePartitioned() : pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
         _variables->setRoot(input.releaseDocument());
 
         Value id = computeId(_variables.get());
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
+        if (batchGroup && !pExpCtx->getValueComparator().evaluate(id == batchId)) {
+            flushBatch();
+        }
 
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (size_t i = 0; i < numAccumulators; i++) {
-                group.push_back(vpAccumulatorFactory[i](pExpCtx));
+        bool inserted = false;
+        if (!batchGroup) {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                uassert(16945,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _extSortAllowed);
+                _sortedFiles.push_back(spill(&*_groups));
+                _memoryUsageBytes = 0;
             }
-        } else {
-            for (size_t i = 0; i < numAccumulators; i++) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= group[i]->memUsageForSorter();
+
+            // Look for the _id value in the map. If it's not there, add a new entry with a blank
+            // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+            // looking it up in '_groups' multiple times.
+            const size_t oldSize = _groups->size();
+            vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
+            inserted = _groups->size() != oldSize;
+
+            if (inserted) {
+                // Add the accumulators
+                group.reserve(numAccumulators);
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    group.push_back(vpAccumulatorFactory[i](pExpCtx));
+                }
+                _memoryUsageBytes += newGroupMemUsage(id, group);
             }
+
+            dassert(numAccumulators == group.size());
+            batchGroup = &group;
+            batchId = std::move(id);
         }
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+        /* queue the input for all the accumulators of the group we found */
         for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
-            _memoryUsageBytes += group[i]->memUsageForSorter();
+            batchInputs[i].push_back(vpExpression[i]->evaluate(_variables.get()));
+        }
+        if (++batchSize == kMaxBatchedGroupInputs) {
+            flushBatch();
         }
 
         // We are done with the ROOT document so release it.
@@ -551,10 +708,12 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 !_extSortAllowed &&          // don't change behavior when testing external sort
                 _sortedFiles.size() < 20) {  // don't open too many FDs
 
-                _sortedFiles.push_back(spill());
+                flushBatch();
+                _sortedFiles.push_back(spill(&*_groups));
             }
         }
     }
+    flushBatch();
 
     switch (input.getStatus()) {
         case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
@@ -564,11 +723,28 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             return input;  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
+            // Do any final steps necessary to prepare to output results. If any partition has
+            // spilled, every partition's groups are merged from disk together.
+            const bool anyPartitionSpilled =
+                std::any_of(_partitions.begin(), _partitions.end(), [](const Partition& partition) {
+                    return !partition.sortedFiles.empty();
+                });
+            if (anyPartitionSpilled) {
+                for (auto&& partition : _partitions) {
+                    for (auto&& file : partition.sortedFiles) {
+                        _sortedFiles.push_back(std::move(file));
+                    }
+                    if (!partition.groups->empty()) {
+                        _sortedFiles.push_back(spill(&*partition.groups));
+                    }
+                }
+                _partitions.clear();
+            }
+
             if (!_sortedFiles.empty()) {
                 _spilled = true;
                 if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
+                    _sortedFiles.push_back(spill(&*_groups));
                 }
 
                 // We won't be using groups again so free its memory.
@@ -585,6 +761,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
                 verify(_sorterIterator->more());  // we put data in, we should get something out.
                 _firstPartOfNextGroup = _sorterIterator->next();
+            } else if (!_partitions.empty()) {
+                // Output each partition's groups in turn.
+                loadNextPartition();
             } else {
                 // start the group iterator
                 groupsIterator = _groups->begin();
@@ -599,10 +778,145 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
-shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
+DocumentSource::GetNextResult DocumentSourceGroup::initializePartitioned() {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+
+    if (_partitions.empty()) {
+        _partitions.resize(_numPartitions);
+        for (auto&& partition : _partitions) {
+            partition.groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+        }
+    }
+
+    // The worker threads only live as long as this call, so that none outlive a pause or an
+    // exception thrown while evaluating the input.
+    std::vector<std::unique_ptr<PartitionQueue>> queues;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        queues.push_back(stdx::make_unique<PartitionQueue>());
+    }
+
+    std::vector<stdx::thread> workers;
+    bool workersJoined = false;
+    auto joinWorkers = [&] {
+        if (workersJoined) {
+            return;
+        }
+        workersJoined = true;
+        for (auto&& queue : queues) {
+            queue->close();
+        }
+        for (auto&& worker : workers) {
+            worker.join();
+        }
+    };
+    ON_BLOCK_EXIT(joinWorkers);
+
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        Partition* partition = &_partitions[i];
+        PartitionQueue* queue = queues[i].get();
+        workers.emplace_back([this, partition, queue] { accumulatePartition(partition, queue); });
+    }
+
+    const auto& comparator = pExpCtx->getValueComparator();
+    std::vector<PartitionQueue::Batch> batches(_numPartitions);
+    GetNextResult input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        _variables->setRoot(input.releaseDocument());
+
+        Value id = computeId(_variables.get());
+        vector<Value> arguments;
+        arguments.reserve(numAccumulators);
+        for (size_t i = 0; i < numAccumulators; i++) {
+            arguments.push_back(vpExpression[i]->evaluate(_variables.get()));
+        }
+
+        // We are done with the ROOT document so release it.
+        _variables->clearRoot();
+
+        const size_t partition = comparator.hash(id) % _numPartitions;
+        auto& batch = batches[partition];
+        batch.emplace_back(std::move(id), std::move(arguments));
+        if (batch.size() >= kPartitionBatchSize) {
+            queues[partition]->push(std::move(batch));
+            batch.clear();
+        }
+    }
+
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        if (!batches[i].empty()) {
+            queues[i]->push(std::move(batches[i]));
+        }
+    }
+    joinWorkers();
+
+    for (auto&& partition : _partitions) {
+        uassertStatusOK(partition.status);
+    }
+    return input;
+}
+
+void DocumentSourceGroup::accumulatePartition(Partition* partition, PartitionQueue* queue) {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+    const size_t maxMemoryUsageBytes = _maxMemoryUsageBytes / _numPartitions;
+    GroupsMap& groups = *partition->groups;
+
+    while (auto batch = queue->pop()) {
+        // Once this partition has failed, keep draining the queue so that the thread reading the
+        // input never waits on it.
+        if (!partition->status.isOK()) {
+            continue;
+        }
+
+        try {
+            for (auto&& update : *batch) {
+                if (partition->memoryUsageBytes > maxMemoryUsageBytes) {
+                    uassert(16945,
+                            "Exceeded memory limit for $group, but didn't allow external sort."
+                            " Pass allowDiskUse:true to opt in.",
+                            _extSortAllowed);
+                    partition->sortedFiles.push_back(spill(&groups));
+                    partition->memoryUsageBytes = 0;
+                }
+
+                const Value& id = update.first;
+                const size_t oldSize = groups.size();
+                Accumulators& group = groups[id];
+                if (groups.size() != oldSize) {
+                    group.reserve(numAccumulators);
+                    for (size_t i = 0; i < numAccumulators; i++) {
+                        group.push_back(vpAccumulatorFactory[i](pExpCtx));
+                    }
+                    partition->memoryUsageBytes += newGroupMemUsage(id, group);
+                }
+
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    partition->memoryUsageBytes -= group[i]->memUsageForSorter();
+                    group[i]->process(update.second[i], _doingMerge);
+                    partition->memoryUsageBytes += group[i]->memUsageForSorter();
+                }
+            }
+        } catch (...) {
+            partition->status = exceptionToStatus();
+        }
+    }
+}
+
+bool DocumentSourceGroup::loadNextPartition() {
+    while (_nextPartitionToOutput < _partitions.size()) {
+        auto& partition = _partitions[_nextPartitionToOutput++];
+        if (!partition.groups->empty()) {
+            _groups = std::move(partition.groups);
+            groupsIterator = _groups->begin();
+            return true;
+        }
+    }
+    return false;
+}
+
+shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill(GroupsMap* groups) const {
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
-    ptrs.reserve(_groups->size());
-    for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
+    ptrs.reserve(groups->size());
+    for (GroupsMap::const_iterator it = groups->begin(), end = groups->end(); it != end; ++it) {
         ptrs.push_back(&*it);
     }
 
@@ -634,18 +948,12 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
             break;
     }
 
-    _groups->clear();
+    groups->clear();
 
     return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
 }
 
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
-    if (true) {
-        // Until streaming $group correctly handles nullish values, the streaming behavior is
-        // disabled. See SERVER-23318.
-        return boost::none;
-    }
-
     if (!pSource) {
         // Sometimes when performing an explain, or using $group as the merge point, 'pSource' will
         // not be set.
@@ -705,69 +1013,187 @@ boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
     return boost::none;
 }
 
-BSONObjSet DocumentSourceGroup::getOutputSorts() {
-    if (!_initialized) {
-        initialize();  // Note this might not finish initializing, but that's OK. We just want to
-                       // do some initialization to try to determine if we are streaming or spilled.
-                       // False negatives are OK.
+boost::optional<std::string> DocumentSourceGroup::getFirstOfEachGroupPath() const {
+    return getIdPathIfAccumulatorsAre(&AccumulatorFirst::create);
+}
+
+boost::optional<std::string> DocumentSourceGroup::getLastOfEachGroupPath() const {
+    return getIdPathIfAccumulatorsAre(&AccumulatorLast::create);
+}
+
+boost::optional<std::string> DocumentSourceGroup::getDistinctPath() const {
+    if (!vpAccumulatorFactory.empty()) {
+        return boost::none;
     }
+    return getIdPathIfAccumulatorsAre(&AccumulatorFirst::create);
+}
 
-    if (!(_streaming || _spilled)) {
-        return SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+boost::optional<std::string> DocumentSourceGroup::getIdPathIfAccumulatorsAre(
+    Accumulator::Factory factory) const {
+    if (_doingMerge || !_idFieldNames.empty() || _idExpressions.size() != 1 ||
+        !dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
+        return boost::none;
     }
 
-    BSONObjBuilder sortOrder;
+    for (auto&& accumulatorFactory : vpAccumulatorFactory) {
+        if (accumulatorFactory != factory) {
+            return boost::none;
+        }
+    }
 
-    if (_idFieldNames.empty()) {
-        if (_spilled) {
-            sortOrder.append("_id", 1);
-        } else {
-            // We have an expression like {_id: "$a"}. Check if this is a FieldPath, and if it is,
-            // get the sort order out of it.
-            if (auto obj = dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
-                FieldPath _idSort = obj->getFieldPath();
-
-                sortOrder.append(
-                    "_id",
-                    _inputSort.getIntField(_idSort.getFieldName(_idSort.getPathLength() - 1)));
+    // Only paths into the input document, rather than a variable, leave a single field
+    // dependency.
+    DepsTracker deps;
+    _idExpressions[0]->addDependencies(&deps);
+    if (deps.needWholeDocument || deps.fields.size() != 1) {
+        return boost::none;
+    }
+    return *deps.fields.begin();
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceGroup::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get());
+    if (_filteredInputByIdMatch || !nextMatch || nextMatch->isTextQuery()) {
+        return std::next(itr);
+    }
+
+    // Gather the predicates of the $match which can also filter our input.
+    auto inputFilter = stdx::make_unique<AndMatchExpression>();
+    const MatchExpression* matchExpr = nextMatch->getMatchExpression();
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+            if (canFilterInputBy(matchExpr->getChild(i))) {
+                inputFilter->add(matchExpr->getChild(i)->shallowClone().release());
             }
         }
-    } else if (_streaming) {
-        // At this point, we know that _streaming is true, so _id must have only contained
-        // ExpressionObjects, ExpressionConstants or ExpressionFieldPaths. We now process each
-        // '_idExpression'.
-
-        // We populate 'fieldMap' such that each key is a field the input is sorted by, and the
-        // value is where that input field is located within the _id document. For example, if our
-        // _id object is {_id: {x: {y: "$a.b"}}}, 'fieldMap' would be: {'a.b': '_id.x.y'}.
-        StringMap<std::string> fieldMap;
-        for (size_t i = 0; i < _idFieldNames.size(); i++) {
-            intrusive_ptr<Expression> exp = _idExpressions[i];
-            if (auto obj = dynamic_cast<ExpressionObject*>(exp.get())) {
-                // _id is an object containing a nested document, such as: {_id: {x: {y: "$b"}}}.
-                getFieldPathMap(obj, "_id." + _idFieldNames[i], &fieldMap);
-            } else if (auto fieldPath = dynamic_cast<ExpressionFieldPath*>(exp.get())) {
-                FieldPath _idSort = fieldPath->getFieldPath();
-                fieldMap[_idSort.getFieldName(_idSort.getPathLength() - 1)] =
-                    "_id." + _idFieldNames[i];
-            }
+    } else if (canFilterInputBy(matchExpr)) {
+        inputFilter->add(matchExpr->shallowClone().release());
+    }
+
+    if (inputFilter->numChildren() == 0) {
+        return std::next(itr);
+    }
+
+    // The paths of the filter's leaves only refer to their storage, which has to outlive the
+    // serialization below.
+    std::deque<std::string> inputPaths;
+    expression::mapOver(inputFilter.get(), [this, &inputPaths](MatchExpression* node, std::string) {
+        if (node->isLogical()) {
+            return;
         }
+        inputPaths.push_back(*getInputPathForIdPath(node->path()));
+        invariantOK(static_cast<LeafMatchExpression*>(node)->setPath(inputPaths.back()));
+    });
 
-        // Because the order of '_inputSort' is important, we go through each field we are sorted on
-        // and append it to the BSONObjBuilder in order.
-        for (BSONElement sortField : _inputSort) {
-            std::string sortString = sortField.fieldNameStringData().toString();
+    BSONObjBuilder query;
+    if (inputFilter->numChildren() == 1) {
+        inputFilter->getChild(0)->serialize(&query);
+    } else {
+        inputFilter->serialize(&query);
+    }
+    container->insert(itr, DocumentSourceMatch::create(query.obj(), pExpCtx));
+    _filteredInputByIdMatch = true;
+
+    // The stage before the new $match may be able to optimize further, if there is such a stage.
+    return std::prev(itr) == container->begin() ? std::prev(itr) : std::prev(std::prev(itr));
+}
+
+boost::optional<std::string> DocumentSourceGroup::getInputPathForIdPath(StringData idPath) const {
+    if (idPath != "_id" && !expression::isPathPrefixOf("_id", idPath)) {
+        return boost::none;
+    }
+
+    // Find the group key 'idPath' descends into, and the rest of the path within it.
+    size_t idIndex = 0;
+    StringData pathWithinKey = idPath.substr(strlen("_id"));
+    if (!_idFieldNames.empty()) {
+        if (pathWithinKey.empty()) {
+            return boost::none;
+        }
+        StringData fieldName = pathWithinKey.substr(1);
+        const size_t dot = fieldName.find('.');
+        pathWithinKey = dot == std::string::npos ? StringData() : fieldName.substr(dot);
+        fieldName = fieldName.substr(0, dot);
 
-            auto itr = fieldMap.find(sortString);
+        auto it = std::find(_idFieldNames.begin(), _idFieldNames.end(), fieldName);
+        if (it == _idFieldNames.end()) {
+            return boost::none;
+        }
+        idIndex = it - _idFieldNames.begin();
+    }
+
+    if (!dynamic_cast<ExpressionFieldPath*>(_idExpressions[idIndex].get())) {
+        return boost::none;
+    }
 
-            // If our sort order is (a, b, c), we could not have converted to a streaming $group if
-            // our _id was predicated on (a, c) but not 'b'. Verify that this is true.
-            invariant(itr != fieldMap.end());
+    DepsTracker deps;
+    _idExpressions[idIndex]->addDependencies(&deps);
+    if (deps.needWholeDocument || deps.fields.size() != 1 ||
+        deps.fields.begin()->find('.') != std::string::npos) {
+        return boost::none;
+    }
+    return *deps.fields.begin() + pathWithinKey.toString();
+}
 
-            sortOrder.append(itr->second, _inputSort.getIntField(sortString));
+bool DocumentSourceGroup::canFilterInputBy(const MatchExpression* expr) const {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!canFilterInputBy(expr->getChild(i))) {
+                    return false;
+                }
+            }
+            return expr->numChildren() > 0;
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE: {
+            // Regular expressions are excluded as they may match only some of the strings a
+            // collation considers equal, and MinKey and MaxKey as ranges bounded by them include
+            // null.
+            const auto type = static_cast<const ComparisonMatchExpression*>(expr)->getData().type();
+            if (type == jstNULL || type == Undefined || type == RegEx || type == MinKey ||
+                type == MaxKey) {
+                return false;
+            }
+            break;
         }
+        case MatchExpression::MATCH_IN: {
+            auto inExpr = static_cast<const InMatchExpression*>(expr);
+            if (inExpr->hasNull() || !inExpr->getRegexes().empty()) {
+                return false;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    return static_cast<bool>(getInputPathForIdPath(expr->path()));
+}
+
+BSONObjSet DocumentSourceGroup::getOutputSorts() {
+    if (!_initialized) {
+        initialize();  // Note this might not finish initializing, but that's OK. We just want to
+                       // do some initialization to try to determine if we are streaming or spilled.
+                       // False negatives are OK.
+    }
+
+    // A streaming $group outputs groups whose input order is ambiguous last, after the rest, so
+    // it makes no claim about the order of its output. See '_streamingSortPaths'.
+    if (!_spilled) {
+        return SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    }
+
+    // We have spilled to disk, so groups come out of the sorter in _id order.
+    BSONObjBuilder sortOrder;
+    if (_idFieldNames.empty()) {
+        sortOrder.append("_id", 1);
     } else {
-        // We are blocking and have spilled to disk.
         std::vector<std::string> outputSort;
         for (size_t i = 0; i < _idFieldNames.size(); i++) {
             intrusive_ptr<Expression> exp = _idExpressions[i];
@@ -30,14 +30,19 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "mongo/base/status.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
+class MatchExpression;
+
 class DocumentSourceGroup final : public DocumentSource, public SplittableDocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<Accumulator>>;
@@ -45,6 +50,10 @@ public:
 
     static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    // The most hash partitions an unsorted $group will use, regardless of
+    // 'internalDocumentSourceGroupPartitions'.
+    static const size_t kMaxPartitions = 64;
+
     // Virtuals from DocumentSource.
     boost::intrusive_ptr<DocumentSource> optimize() final;
     GetDepsReturn getDependencies(DepsTracker* deps) const final;
@@ -54,6 +63,14 @@ public:
     const char* getSourceName() const final;
     BSONObjSet getOutputSorts() final;
 
+    /**
+     * Attempts to filter the input by the predicates of a subsequent $match on the group keys, so
+     * that only the groups the $match can keep are accumulated. The $match itself stays after the
+     * $group.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     /**
      * Convenience method for creating a new $group stage.
      */
@@ -88,27 +105,89 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * If this $group's _id is a single field path into the input document and every accumulator
+     * is $first, returns that path (e.g. "a.b" for {_id: "$a.b"}). Given input sorted first on
+     * that path, only the first document for each distinct value contributes to the output, so
+     * the input may be thinned to just those documents. Otherwise returns boost::none.
+     */
+    boost::optional<std::string> getFirstOfEachGroupPath() const;
+
+    /**
+     * Like getFirstOfEachGroupPath(), but for a $group whose accumulators are all $last. Only the
+     * last document for each distinct value contributes to the output.
+     */
+    boost::optional<std::string> getLastOfEachGroupPath() const;
+
+    /**
+     * Returns the path of a $group with a single field path _id and no accumulators, whose output
+     * is just the distinct values of that path whatever the order of its input. Otherwise returns
+     * boost::none.
+     */
+    boost::optional<std::string> getDistinctPath() const;
+
     bool isStreaming() const {
         return _streaming;
     }
 
+    /**
+     * Returns the number of hash partitions an unsorted $group divides its groups between. With
+     * more than one, the groups of each partition are updated by a thread of their own, and each
+     * partition spills to disk independently once it exceeds its share of the memory limit.
+     */
+    size_t getNumPartitions() const {
+        return _numPartitions;
+    }
+
     // Virtuals for SplittableDocumentSource.
     boost::intrusive_ptr<DocumentSource> getShardSource() final;
     boost::intrusive_ptr<DocumentSource> getMergeSource() final;
 
 private:
+    class PartitionQueue;
+
+    /**
+     * The groups of a partitioned $group whose keys hash to one partition, along with their memory
+     * usage and whatever they have spilled. Only the partition's worker thread touches it while
+     * accumulating.
+     */
+    struct Partition {
+        boost::optional<GroupsMap> groups;
+        size_t memoryUsageBytes = 0;
+        std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> sortedFiles;
+        Status status = Status::OK();
+    };
+
     explicit DocumentSourceGroup(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                                  size_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
 
     /**
      * getNext() dispatches to one of these three depending on what type of $group it is. All three
-     * of these methods expect '_currentAccumulators' to have been reset before being called, and
-     * also expect initialize() to have been called already.
+     * of these methods expect initialize() to have been called already. getNextSpilled() also
+     * expects '_currentAccumulators' to have been reset, while getNextStreaming() keeps the group
+     * in progress there between calls.
      */
     GetNextResult getNextStreaming();
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * If 'idPath' is a path within the output _id whose group key is a top-level field of the
+     * input, e.g. "_id.b" for {_id: "$a"} or {_id: {x: "$a"}, ...} with "_id.x.b", returns the
+     * corresponding input path ("a.b"). Otherwise returns boost::none. Dotted group keys are not
+     * mapped, as $group and $match traverse arrays along a dotted path differently.
+     */
+    boost::optional<std::string> getInputPathForIdPath(StringData idPath) const;
+
+    /**
+     * Returns whether a predicate on the group keys can also filter the input documents, which is
+     * the case if 'expr' is only made of comparisons and $in on paths getInputPathForIdPath() can
+     * map. Such predicates give the same result for values the $group considers equal, so every
+     * document of a group the predicate keeps also passes it. They are also false for null, which
+     * is the group key of documents without the field.
+     */
+    bool canFilterInputBy(const MatchExpression* expr) const;
+
     /**
      * Attempt to identify an input sort order that allows us to turn into a streaming $group. If we
      * find one, return it. Otherwise, return boost::none.
@@ -128,14 +207,41 @@ private:
     GetNextResult initialize();
 
     /**
-     * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
-     * does not exhaust the previous stage before returning, and thus does not maintain as large a
-     * store of documents at any one time, only an unsorted group can spill to disk.
+     * Populates '_partitions' from 'pSource' on behalf of initialize(). This thread computes the
+     * _id and the accumulator arguments of each input, and one worker thread per partition applies
+     * them to that partition's groups. Returns the last GetNextResult from 'pSource', which is
+     * either kEOF or kPauseExecution.
      */
-    std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
+    GetNextResult initializePartitioned();
+
+    /**
+     * Applies the batches read from 'queue' to 'partition' until the queue is closed. Runs on a
+     * worker thread, and records any failure in the partition's status.
+     */
+    void accumulatePartition(Partition* partition, PartitionQueue* queue);
+
+    /**
+     * Makes the groups of the next non-empty partition the ones returned by getNextStandard().
+     * Returns false when there are no partitions left.
+     */
+    bool loadNextPartition();
+
+    /**
+     * Spill 'groups' to disk, clearing it, and returns an iterator to the file. Note: Since a
+     * sorted $group does not exhaust the previous stage before returning, and thus does not
+     * maintain as large a store of documents at any one time, only an unsorted group can spill to
+     * disk.
+     */
+    std::shared_ptr<Sorter<Value, Value>::Iterator> spill(GroupsMap* groups) const;
 
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
+    /**
+     * Returns the path of the _id if it is a single field path into the input document and every
+     * accumulator is made by 'factory', or boost::none.
+     */
+    boost::optional<std::string> getIdPathIfAccumulatorsAre(Accumulator::Factory factory) const;
+
     /**
      * Computes the internal representation of the group key.
      */
@@ -164,6 +270,10 @@ private:
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
+    // Set once doOptimizeAt() has put a filter on the group keys before this stage, so that it is
+    // not added again when the pipeline revisits this stage.
+    bool _filteredInputByIdMatch = false;
+
     BSONObj _inputSort;
     bool _streaming;
     bool _initialized;
@@ -179,6 +289,11 @@ private:
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
+    // Used instead of '_groups' while accumulating, when '_numPartitions' is greater than one.
+    const size_t _numPartitions;
+    std::vector<Partition> _partitions;
+    size_t _nextPartitionToOutput = 0;
+
     // Only used when '_spilled' is false.
     GroupsMap::iterator groupsIterator;
 
@@ -187,8 +302,14 @@ private:
     const bool _extSortAllowed;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
-    // Only used when '_sorted' is true.
-    boost::optional<Document> _firstDocOfNextGroup;
+
+    // Only used when '_streaming' is true. The input is sorted on '_streamingSortPaths'. Sorting
+    // does not keep a group together when one of these values is nullish or an array, as null,
+    // undefined and missing sort alike but may group apart, and arrays group as a whole. Such
+    // groups are accumulated in '_groups' and output once the input is exhausted.
+    std::vector<FieldPath> _streamingSortPaths;
+    bool _streamingGroupStarted = false;
+    bool _streamingInputExhausted = false;
 };
 
 }  // namespace mongo
@@ -26,8 +26,11 @@
  *    then also delete it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
 #include <map>
@@ -47,12 +50,15 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -192,6 +198,184 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldCountTheAccumulatorsOfEachGroupAgainstTheMemoryLimit) {
+    auto expCtx = getExpCtx();
+    const size_t maxMemoryUsageBytes = 1000;
+    expCtx->inRouter = true;  // Disallow external sort.
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement sumStatement{"total",
+                                       AccumulationStatement::getFactory("$sum"),
+                                       ExpressionFieldPath::parse(expCtx, "$_id", vps)};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$_id", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {sumStatement}, idGen.getIdCount(), maxMemoryUsageBytes);
+
+    // The _id values alone take less than the limit, but the groups' accumulators do not fit.
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50; ++i) {
+        inputs.push_back(Document{{"_id", i}});
+    }
+    ASSERT_LT(50 * Value(0).getApproximateSize(), maxMemoryUsageBytes);
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
+}
+
+/**
+ * Sets the number of partitions used by $group stages created while this object is in scope.
+ */
+class GroupPartitionsGuard {
+public:
+    explicit GroupPartitionsGuard(int numPartitions)
+        : _oldNumPartitions(internalDocumentSourceGroupPartitions.load()) {
+        internalDocumentSourceGroupPartitions.store(numPartitions);
+    }
+
+    ~GroupPartitionsGuard() {
+        internalDocumentSourceGroupPartitions.store(_oldNumPartitions);
+    }
+
+private:
+    const int _oldNumPartitions;
+};
+
+/**
+ * Returns the result of grouping 'inputs' by "$key", counting and summing "$val" for each group,
+ * keyed by the group's _id. Pauses in the input are passed over.
+ */
+map<int, Document> groupByKey(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    deque<DocumentSource::GetNextResult> inputs,
+    size_t maxMemoryUsageBytes = DocumentSourceGroup::kDefaultMaxMemoryUsageBytes) {
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement countStatement{"count",
+                                         AccumulationStatement::getFactory("$sum"),
+                                         ExpressionConstant::create(expCtx, Value(1))};
+    AccumulationStatement sumStatement{"total",
+                                       AccumulationStatement::getFactory("$sum"),
+                                       ExpressionFieldPath::parse(expCtx, "$val", vps)};
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             ExpressionFieldPath::parse(expCtx, "$key", vps),
+                                             {countStatement, sumStatement},
+                                             idGen.getIdCount(),
+                                             maxMemoryUsageBytes);
+    auto mock = DocumentSourceMock::create(std::move(inputs));
+    group->setSource(mock.get());
+
+    map<int, Document> results;
+    for (auto next = group->getNext(); !next.isEOF(); next = group->getNext()) {
+        if (next.isPaused()) {
+            continue;
+        }
+        Document result = next.releaseDocument();
+        ASSERT_TRUE(results.emplace(result["_id"].coerceToInt(), result).second);
+    }
+    return results;
+}
+
+deque<DocumentSource::GetNextResult> makeKeyedInputs(int numInputs, int numKeys) {
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numInputs; ++i) {
+        inputs.emplace_back(Document{{"key", i % numKeys}, {"val", i}});
+    }
+    return inputs;
+}
+
+TEST_F(DocumentSourceGroupTest, PartitionedGroupShouldMatchUnpartitionedResults) {
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    const int numInputs = 10000;
+    const int numKeys = 1000;
+    map<int, Document> expected;
+    {
+        GroupPartitionsGuard partitions(1);
+        expected = groupByKey(expCtx, makeKeyedInputs(numInputs, numKeys));
+    }
+    ASSERT_EQ(expected.size(), static_cast<size_t>(numKeys));
+
+    GroupPartitionsGuard partitions(4);
+    auto results = groupByKey(expCtx, makeKeyedInputs(numInputs, numKeys));
+    ASSERT_EQ(results.size(), expected.size());
+    for (auto&& result : results) {
+        ASSERT_DOCUMENT_EQ(result.second, expected[result.first]);
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, PartitionedGroupShouldMergeSpilledPartitions) {
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->extSortAllowed = true;
+
+    // With 4 partitions, each partition may only use a quarter of this before spilling.
+    GroupPartitionsGuard partitions(4);
+    const size_t maxMemoryUsageBytes = 4000;
+    const int numInputs = 2000;
+    const int numKeys = 500;
+    auto results = groupByKey(expCtx, makeKeyedInputs(numInputs, numKeys), maxMemoryUsageBytes);
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(numKeys));
+    for (int key = 0; key < numKeys; ++key) {
+        // Each key was seen for 'val' equal to key, key + 500, key + 1000 and key + 1500.
+        ASSERT_DOCUMENT_EQ(results[key],
+                           (Document{{"_id", key}, {"count", 4}, {"total", 4 * key + 3000}}));
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, PartitionedGroupShouldErrorIfNotAllowedToSpillAndTooLarge) {
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow external sort.
+
+    GroupPartitionsGuard partitions(4);
+    const size_t maxMemoryUsageBytes = 1000;
+    ASSERT_THROWS_CODE(
+        groupByKey(expCtx, makeKeyedInputs(2000, 500), maxMemoryUsageBytes), UserException, 16945);
+}
+
+TEST_F(DocumentSourceGroupTest, PartitionedGroupShouldBeAbleToPauseLoading) {
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow external sort.
+
+    GroupPartitionsGuard partitions(4);
+    auto results = groupByKey(expCtx,
+                              {Document{{"key", 0}, {"val", 1}},
+                               DocumentSource::GetNextResult::makePauseExecution(),
+                               Document{{"key", 1}, {"val", 2}},
+                               Document{{"key", 0}, {"val", 3}}});
+
+    ASSERT_EQ(results.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(results[0], (Document{{"_id", 0}, {"count", 2}, {"total", 4}}));
+    ASSERT_DOCUMENT_EQ(results[1], (Document{{"_id", 1}, {"count", 1}, {"total", 2}}));
+}
+
+TEST_F(DocumentSourceGroupTest, PartitionedGroupThroughput) {
+    auto expCtx = getExpCtx();
+    expCtx->inRouter = true;  // Disallow external sort.
+
+    const int numInputs = 200000;
+    const int numKeys = 20000;
+    for (int numPartitions : {1, 2, 4, 8}) {
+        GroupPartitionsGuard partitions(numPartitions);
+        auto inputs = makeKeyedInputs(numInputs, numKeys);
+
+        Timer timer;
+        auto results = groupByKey(expCtx, std::move(inputs));
+        const long long micros = std::max(timer.micros(), 1LL);
+
+        ASSERT_EQ(results.size(), static_cast<size_t>(numKeys));
+        log() << numPartitions << " partitions: " << (numInputs * 1000000LL / micros)
+              << " documents/sec";
+    }
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -800,10 +984,8 @@ public:
 
         assertEOF(group());
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 1U);
-
-        ASSERT_EQUALS(outputSort.count(BSON("_id" << 1)), 1U);
+        // Groups whose input order is ambiguous are output last, so no output order is reported.
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -836,14 +1018,7 @@ public:
 
         assertEOF(source);
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 2U);
-
-        BSONObj correctSort = BSON("_id.x" << 1 << "_id.y" << -1);
-        ASSERT_EQUALS(outputSort.count(correctSort), 1U);
-
-        BSONObj prefixSort = BSON("_id.x" << 1);
-        ASSERT_EQUALS(outputSort.count(prefixSort), 1U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -851,7 +1026,9 @@ class StreamingWithMultipleLevels : public Base {
 public:
     void run() {
         auto source = DocumentSourceMock::create(
-            {"{a: {b: {c: 3}}, d: 1}", "{a: {b: {c: 1}}, d: 2}", "{a: {b: {c: 1}}, d: 0}"});
+            {"{a: {b: {c: 3, d: 1}}, d: 1}",
+             "{a: {b: {c: 1, d: 1}}, d: 2}",
+             "{a: {b: {c: 1, d: 1}}, d: 0}"});
         source->sorts = {BSON("a.b.c" << -1 << "a.b.d" << 1 << "d" << 1)};
 
         createGroup(fromjson("{_id: {x: {y: {z: '$a.b.c', q: '$a.b.d'}}, v: '$d'}}"));
@@ -869,17 +1046,7 @@ public:
 
         assertEOF(source);
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 3U);
-
-        BSONObj correctSort = fromjson("{'_id.x.y.z': -1, '_id.x.y.q': 1, '_id.v': 1}");
-        ASSERT_EQUALS(outputSort.count(correctSort), 1U);
-
-        BSONObj prefixSortTwo = fromjson("{'_id.x.y.z': -1, '_id.x.y.q': 1}");
-        ASSERT_EQUALS(outputSort.count(prefixSortTwo), 1U);
-
-        BSONObj prefixSortOne = fromjson("{'_id.x.y.z': -1}");
-        ASSERT_EQUALS(outputSort.count(prefixSortOne), 1U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -906,15 +1073,7 @@ public:
         ASSERT_VALUE_EQ(res.getDocument().getField("a"), Value(2));
         ASSERT_VALUE_EQ(res.getDocument().getField("b"), Value(3));
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-
-        ASSERT_EQUALS(outputSort.size(), 2U);
-
-        BSONObj correctSort = fromjson("{'_id.sub.z': 1}");
-        ASSERT_EQUALS(outputSort.count(correctSort), 1U);
-
-        BSONObj prefixSortTwo = fromjson("{'_id.sub.z': 1, '_id.sub.y': 1}");
-        ASSERT_EQUALS(outputSort.count(prefixSortTwo), 1U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -941,14 +1100,7 @@ public:
         ASSERT_VALUE_EQ(res.getDocument().getField("a"), Value(3));
         ASSERT_VALUE_EQ(res.getDocument().getField("b"), Value(1));
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 2U);
-
-        BSONObj correctSort = fromjson("{'_id.sub.x': -1}");
-        ASSERT_EQUALS(outputSort.count(correctSort), 1U);
-
-        BSONObj prefixSortTwo = fromjson("{'_id.sub.x': -1, '_id.sub.y': 1}");
-        ASSERT_EQUALS(outputSort.count(prefixSortTwo), 1U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -964,11 +1116,7 @@ public:
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 1U);
-
-        BSONObj correctSort = fromjson("{_id: 1}");
-        ASSERT_EQUALS(outputSort.count(correctSort), 1U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -984,8 +1132,7 @@ public:
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 0U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
     }
 };
 
@@ -1001,8 +1148,79 @@ public:
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
 
-        BSONObjSet outputSort = group()->getOutputSorts();
-        ASSERT_EQUALS(outputSort.size(), 0U);
+        ASSERT_EQUALS(group()->getOutputSorts().size(), 0U);
+    }
+};
+
+class StreamingOutputsAmbiguouslyOrderedGroupsLast : public Base {
+public:
+    void run() {
+        // Missing, undefined and null sort alike, and arrays sort by an element, so the members of
+        // these groups need not be adjacent.
+        auto source = DocumentSourceMock::create({"{a: null, n: 1}",
+                                                  "{n: 2}",
+                                                  "{a: undefined, n: 4}",
+                                                  "{a: null, n: 8}",
+                                                  "{a: 1, n: 16}",
+                                                  "{a: [1, 2], n: 32}",
+                                                  "{a: 1, n: 64}",
+                                                  "{a: [1, 2], n: 128}",
+                                                  "{a: 2, n: 256}"});
+        source->sorts = {BSON("a" << 1)};
+
+        createGroup(fromjson("{_id: '$a', n: {$sum: '$n'}}"));
+        group()->setSource(source.get());
+
+        auto res = group()->getNext();
+        ASSERT_TRUE(group()->isStreaming());
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 1, n: 80}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 2, n: 256}")));
+
+        std::vector<Document> rest;
+        for (res = group()->getNext(); res.isAdvanced(); res = group()->getNext()) {
+            rest.push_back(res.releaseDocument());
+        }
+        std::sort(rest.begin(), rest.end(), [](const Document& lhs, const Document& rhs) {
+            return Value::compare(lhs["n"], rhs["n"], nullptr) < 0;
+        });
+        ASSERT_EQUALS(rest.size(), 3U);
+        ASSERT_DOCUMENT_EQ(rest[0], Document(fromjson("{_id: undefined, n: 4}")));
+        ASSERT_DOCUMENT_EQ(rest[1], Document(fromjson("{_id: null, n: 11}")));
+        ASSERT_DOCUMENT_EQ(rest[2], Document(fromjson("{_id: [1, 2], n: 160}")));
+
+        assertEOF(group());
+    }
+};
+
+class StreamingAcrossPause : public Base {
+public:
+    void run() {
+        auto source =
+            DocumentSourceMock::create({Document{{"a", 1}, {"n", 1}},
+                                        DocumentSource::GetNextResult::makePauseExecution(),
+                                        Document{{"a", 1}, {"n", 2}},
+                                        Document{{"a", 2}, {"n", 4}}});
+        source->sorts = {BSON("a" << 1)};
+
+        createGroup(fromjson("{_id: '$a', n: {$sum: '$n'}}"));
+        group()->setSource(source.get());
+
+        ASSERT_TRUE(group()->getNext().isPaused());
+        ASSERT_TRUE(group()->isStreaming());
+
+        auto res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 1, n: 3}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 2, n: 4}")));
+
+        assertEOF(group());
     }
 };
 
@@ -1158,8 +1376,6 @@ public:
         add<Dependencies>();
         add<StringConstantIdAndAccumulatorExpressions>();
         add<ArrayConstantAccumulatorExpression>();
-#if 0
-        // Disabled tests until SERVER-23318 is implemented.
         add<StreamingOptimization>();
         add<StreamingWithMultipleIdFields>();
         add<NoOptimizationIfMissingDoubleSort>();
@@ -1171,7 +1387,8 @@ public:
         add<StreamingWithRootSubfield>();
         add<StreamingWithConstantAndFieldPath>();
         add<StreamingWithFieldRepeated>();
-#endif
+        add<StreamingOutputsAmbiguouslyOrderedGroupsLast>();
+        add<StreamingAcrossPause>();
     }
 };
 
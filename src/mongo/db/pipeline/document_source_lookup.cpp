@@ -30,13 +30,19 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -44,6 +50,8 @@ namespace mongo {
 using boost::intrusive_ptr;
 using std::vector;
 
+namespace dps = ::mongo::dotted_path_support;
+
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
                                            std::string as,
                                            std::string localField,
@@ -54,7 +62,10 @@ DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
       _as(std::move(as)),
       _localField(std::move(localField)),
       _foreignField(foreignField),
-      _foreignFieldFieldName(std::move(foreignField)) {
+      _foreignFieldFieldName(std::move(foreignField)),
+      _strategy(internalDocumentSourceLookupEnableHashJoin.load() ? JoinStrategy::kHashJoin
+                                                                  : JoinStrategy::kNestedLoop),
+      _cache(pExpCtx->getValueComparator()) {
     const auto& resolvedNamespace = pExpCtx->getResolvedNamespace(_fromNs);
     _fromExpCtx = pExpCtx->copyWith(resolvedNamespace.ns);
     _fromPipeline = resolvedNamespace.pipeline;
@@ -116,6 +127,108 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const vector<Value>&
     return orBuilder.obj();
 }
 
+// Approximate memory used by the hash join for each key of a foreign document, in addition to the
+// document itself.
+const size_t kHashJoinBytesPerKey = 4 * sizeof(size_t);
+
+/**
+ * Appends to 'keys' the hash of every value that an equality predicate on 'path' could match in
+ * 'doc', following the query language's array semantics, and the hash of null if the path
+ * may be missing. The keys may include values that would not match, but never omit one that
+ * would.
+ */
+void appendForeignJoinKeys(const BSONObj& doc,
+                           StringData path,
+                           const ValueComparator& comparator,
+                           std::vector<size_t>* keys) {
+    // An array at the end of the path is matched both by its elements and as a whole.
+    BSONElementSet elements;
+    std::set<size_t> arrayComponents;
+    dps::extractAllElementsAlongPath(doc, path, elements, true, &arrayComponents);
+    dps::extractAllElementsAlongPath(doc, path, elements, false);
+
+    // An equality to null also matches documents in which the path is missing, which may be the
+    // case for some elements of any array along the path.
+    bool mayMatchNull = elements.empty() || !arrayComponents.empty();
+    for (auto&& elem : elements) {
+        if (elem.type() == jstNULL || elem.type() == Undefined) {
+            mayMatchNull = true;
+        } else {
+            keys->push_back(comparator.hash(Value(elem)));
+        }
+    }
+
+    if (mayMatchNull) {
+        keys->push_back(comparator.hash(Value(BSONNULL)));
+    }
+}
+
+/**
+ * Returns the value of 'localField' in 'input' that the foreign collection is queried with. Missing
+ * values are treated as null.
+ */
+Value getLocalJoinValue(const Document& input, const FieldPath& localField) {
+    Value localFieldVal = input.getNestedField(localField);
+    return localFieldVal.missing() ? Value(BSONNULL) : localFieldVal;
+}
+
+/**
+ * Calls 'callback' with each value of 'localField' in 'input' that a foreign document may be joined
+ * on: the elements of an array, null for a missing field, or else the value itself.
+ */
+template <typename Callback>
+void forEachLocalJoinValue(const Document& input, const FieldPath& localField, Callback callback) {
+    Value localFieldVal = getLocalJoinValue(input, localField);
+
+    // As with the queries built by makeMatchStageFromInput(), an array matches on any of its
+    // elements.
+    if (localFieldVal.isArray()) {
+        for (auto&& value : localFieldVal.getArray()) {
+            callback(value);
+        }
+    } else {
+        callback(localFieldVal);
+    }
+}
+
+// The number of bits of the foreign key filter set for each key.
+const int kForeignKeyFilterNumProbes = 4;
+
+/**
+ * Calls 'callback' with the position of each bit of a foreign key filter with 'numBits' bits that
+ * represents 'key'.
+ */
+template <typename Callback>
+void forEachForeignKeyFilterBit(size_t numBits, size_t key, Callback callback) {
+    // The hashes of small integers are poorly distributed, so mix the key before deriving the
+    // probes from its two halves.
+    uint64_t mixed = key;
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    mixed *= 0xc4ceb9fe1a85ec53ULL;
+    mixed ^= mixed >> 33;
+
+    const uint64_t step = (mixed >> 32) | 1;
+    for (int i = 0; i < kForeignKeyFilterNumProbes; ++i) {
+        callback((mixed + i * step) % numBits);
+    }
+}
+
+void addToForeignKeyFilter(std::vector<uint64_t>* filter, size_t key) {
+    forEachForeignKeyFilterBit(filter->size() * 64, key, [filter](uint64_t bit) {
+        (*filter)[bit / 64] |= uint64_t(1) << (bit % 64);
+    });
+}
+
+bool foreignKeyFilterMayContain(const std::vector<uint64_t>& filter, size_t key) {
+    bool mayContain = true;
+    forEachForeignKeyFilterBit(filter.size() * 64, key, [&](uint64_t bit) {
+        mayContain = mayContain && (filter[bit / 64] & (uint64_t(1) << (bit % 64)));
+    });
+    return mayContain;
+}
+
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
@@ -145,20 +258,45 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
 
     auto matchStage =
         makeMatchStageFromInput(inputDoc, _localField, _foreignFieldFieldName, BSONObj());
-    // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-    _fromPipeline.back() = matchStage;
-    auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
 
     std::vector<Value> results;
     int objsize = 0;
-    while (auto result = pipeline->getNext()) {
-        objsize += result->getApproximateSize();
+    auto addResult = [&](Document&& result) {
+        objsize += result.getApproximateSize();
         uassert(4568,
                 str::stream() << "Total size of documents in " << _fromNs.coll() << " matching "
                               << matchStage
                               << " exceeds maximum document size",
                 objsize <= BSONObjMaxInternalSize);
-        results.emplace_back(std::move(*result));
+        results.emplace_back(std::move(result));
+    };
+
+    _buildHashTableIfNeeded();
+    if (_strategy == JoinStrategy::kHashJoin) {
+        for (auto&& result : _probeHashTable(inputDoc, matchStage)) {
+            addResult(std::move(result));
+        }
+    } else if (_mayHaveForeignMatch(inputDoc)) {
+        auto localValue = getLocalJoinValue(inputDoc, _localField);
+        if (auto cached = _findInCache(localValue)) {
+            for (auto&& result : *cached) {
+                addResult(Document(result));
+            }
+        } else {
+            // We've already allocated space for the trailing $match stage in '_fromPipeline'.
+            _fromPipeline.back() = matchStage;
+            auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+            while (auto result = pipeline->getNext()) {
+                addResult(std::move(*result));
+            }
+
+            std::vector<Document> toCache;
+            toCache.reserve(results.size());
+            for (auto&& result : results) {
+                toCache.push_back(result.getDocument());
+            }
+            _addToCache(std::move(localValue), std::move(toCache), objsize);
+        }
     }
 
     MutableDocument output(std::move(inputDoc));
@@ -280,8 +418,201 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     return itr;
 }
 
+void DocumentSourceLookUp::_buildHashTableIfNeeded() {
+    if (_strategy != JoinStrategy::kHashJoin || _hashTableBuilt) {
+        return;
+    }
+    _hashTableBuilt = true;
+
+    // Read the foreign collection through the view pipeline, if any, followed by any $match we
+    // have absorbed, exactly as the per-document queries would, less the join predicate itself.
+    std::vector<BSONObj> buildPipeline(_fromPipeline.begin(), _fromPipeline.end() - 1);
+    if (_additionalFilter && !_additionalFilter->isEmpty()) {
+        buildPipeline.push_back(BSON("$match" << *_additionalFilter));
+    }
+    auto pipeline = uassertStatusOK(_mongod->makePipeline(buildPipeline, _fromExpCtx));
+
+    const size_t maxMemoryBytes = internalDocumentSourceLookupMaxMemoryBytes.load();
+    const size_t filterWords =
+        std::max(internalDocumentSourceLookupForeignKeyFilterBytes.load(), 0) / sizeof(uint64_t);
+    const auto& comparator = _fromExpCtx->getValueComparator();
+    size_t memoryBytes = 0;
+    std::vector<size_t> keys;
+    while (auto result = pipeline->getNext()) {
+        pExpCtx->checkForInterrupt();
+
+        BSONObj doc = result->toBson();
+        keys.clear();
+        appendForeignJoinKeys(doc, _foreignField.fullPath(), comparator, &keys);
+
+        if (_hashJoinAbandoned) {
+            for (auto key : keys) {
+                addToForeignKeyFilter(&_foreignKeyFilter, key);
+            }
+            continue;
+        }
+
+        memoryBytes += doc.objsize() + keys.size() * kHashJoinBytesPerKey;
+        if (memoryBytes > maxMemoryBytes) {
+            // Rather than exceed the memory limit, fall back to querying the foreign collection for
+            // each input document.
+            _hashJoinDocs.clear();
+            _strategy = JoinStrategy::kNestedLoop;
+            _hashJoinAbandoned = true;
+            if (filterWords == 0) {
+                _hashJoinTable.clear();
+                return;
+            }
+
+            // Finish reading the foreign collection into the filter, starting with the keys of the
+            // documents read so far, so that input documents without a match need no query.
+            _foreignKeyFilter.assign(filterWords, 0);
+            for (auto&& entry : _hashJoinTable) {
+                addToForeignKeyFilter(&_foreignKeyFilter, entry.first);
+            }
+            _hashJoinTable.clear();
+            for (auto key : keys) {
+                addToForeignKeyFilter(&_foreignKeyFilter, key);
+            }
+            continue;
+        }
+
+        const size_t position = _hashJoinDocs.size();
+        _hashJoinDocs.push_back(std::move(doc));
+        for (auto key : keys) {
+            auto& positions = _hashJoinTable[key];
+            if (positions.empty() || positions.back() != position) {
+                positions.push_back(position);
+            }
+        }
+    }
+}
+
+std::vector<Document> DocumentSourceLookUp::_probeHashTable(const Document& input,
+                                                            const BSONObj& matchStage) {
+    const auto& comparator = _fromExpCtx->getValueComparator();
+    std::vector<size_t> candidates;
+    forEachLocalJoinValue(input, _localField, [&](const Value& value) {
+        auto it = _hashJoinTable.find(comparator.hash(value));
+        if (it != _hashJoinTable.end()) {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    });
+
+    std::vector<Document> results;
+    if (candidates.empty()) {
+        return results;
+    }
+
+    // Return matches in the order they were read from the foreign collection.
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // Candidates only share a hash with the local value, so check each of them against the
+    // predicate the nested loop strategy would have queried with.
+    auto expression = uassertStatusOK(
+        MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(),
+                                     ExtensionsCallbackNoop(),
+                                     _fromExpCtx->getCollator()));
+    for (auto position : candidates) {
+        const BSONObj& doc = _hashJoinDocs[position];
+        if (expression->matchesBSON(doc)) {
+            results.emplace_back(doc);
+        }
+    }
+    return results;
+}
+
+bool DocumentSourceLookUp::_mayHaveForeignMatch(const Document& input) const {
+    if (_foreignKeyFilter.empty()) {
+        return true;
+    }
+
+    const auto& comparator = _fromExpCtx->getValueComparator();
+    bool mayMatch = false;
+    forEachLocalJoinValue(input, _localField, [&](const Value& value) {
+        mayMatch =
+            mayMatch || foreignKeyFilterMayContain(_foreignKeyFilter, comparator.hash(value));
+    });
+    return mayMatch;
+}
+
+const std::vector<Document>* DocumentSourceLookUp::_findInCache(const Value& localValue) {
+    if (internalDocumentSourceLookupCacheMaxMemoryBytes.load() <= 0) {
+        return nullptr;
+    }
+
+    auto cached = _cache[localValue];
+    if (cached) {
+        ++_cacheHits;
+    } else {
+        ++_cacheMisses;
+    }
+    return cached;
+}
+
+void DocumentSourceLookUp::_addToCache(Value localValue,
+                                       std::vector<Document> results,
+                                       size_t resultsBytes) {
+    const int maxMemoryBytes = internalDocumentSourceLookupCacheMaxMemoryBytes.load();
+    if (maxMemoryBytes <= 0 || resultsBytes > static_cast<size_t>(maxMemoryBytes)) {
+        return;
+    }
+
+    _cache.replace(std::move(localValue), std::move(results));
+    _cache.evictDownTo(maxMemoryBytes);
+}
+
+boost::optional<Document> DocumentSourceLookUp::_nextUnwindValue() {
+    if (_pipeline) {
+        auto next = _pipeline->getNext();
+        if (!_pendingCacheKey) {
+            return next;
+        }
+
+        if (!next) {
+            _addToCache(std::move(*_pendingCacheKey),
+                        std::move(_pendingCacheResults),
+                        _pendingCacheBytes);
+            _pendingCacheKey = boost::none;
+        } else {
+            _pendingCacheBytes += next->getApproximateSize();
+            if (_pendingCacheBytes >
+                static_cast<size_t>(internalDocumentSourceLookupCacheMaxMemoryBytes.load())) {
+                _pendingCacheKey = boost::none;
+                _pendingCacheResults.clear();
+            } else {
+                _pendingCacheResults.push_back(*next);
+            }
+        }
+        return next;
+    }
+
+    if (_bufferedResultsIndex < _bufferedResults.size()) {
+        return std::move(_bufferedResults[_bufferedResultsIndex++]);
+    }
+    return boost::none;
+}
+
+std::string DocumentSourceLookUp::_strategyName() const {
+    switch (_strategy) {
+        case JoinStrategy::kNestedLoop:
+            return "nestedLoop";
+        case JoinStrategy::kHashJoin:
+            return "hashJoin";
+    }
+    MONGO_UNREACHABLE;
+}
+
 void DocumentSourceLookUp::dispose() {
     _pipeline.reset();
+    _bufferedResults.clear();
+    _hashJoinDocs.clear();
+    _hashJoinTable.clear();
+    _foreignKeyFilter.clear();
+    _cache.clear();
+    _pendingCacheKey = boost::none;
+    _pendingCacheResults.clear();
     pSource->dispose();
 }
 
@@ -366,7 +697,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     // Loop until we get a document that has at least one match.
     // Note we may return early from this loop if our source stage is exhausted or if the unwind
     // source was asked to return empty arrays and we get a document without a match.
-    while (!_pipeline || !_nextValue) {
+    while (!_nextValue) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isAdvanced()) {
             return nextInput;
@@ -377,12 +708,33 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
         BSONObj filter = _additionalFilter.value_or(BSONObj());
         auto matchStage =
             makeMatchStageFromInput(*_input, _localField, _foreignFieldFieldName, filter);
-        // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-        _fromPipeline.back() = matchStage;
-        _pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+
+        _buildHashTableIfNeeded();
+        if (_strategy == JoinStrategy::kHashJoin) {
+            _bufferedResults = _probeHashTable(*_input, matchStage);
+            _bufferedResultsIndex = 0;
+        } else if (_mayHaveForeignMatch(*_input)) {
+            auto localValue = getLocalJoinValue(*_input, _localField);
+            if (auto cached = _findInCache(localValue)) {
+                _pipeline.reset();
+                _bufferedResults = *cached;
+                _bufferedResultsIndex = 0;
+            } else {
+                // We've already allocated space for the trailing $match stage in '_fromPipeline'.
+                _fromPipeline.back() = matchStage;
+                _pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+                if (internalDocumentSourceLookupCacheMaxMemoryBytes.load() > 0) {
+                    _pendingCacheKey = std::move(localValue);
+                    _pendingCacheResults.clear();
+                    _pendingCacheBytes = 0;
+                }
+            }
+        } else {
+            _pipeline.reset();
+        }
 
         _cursorIndex = 0;
-        _nextValue = _pipeline->getNext();
+        _nextValue = _nextUnwindValue();
 
         if (_unwindSrc->preserveNullAndEmptyArrays() && !_nextValue) {
             // There were no results for this cursor, but the $unwind was asked to preserve empty
@@ -400,7 +752,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
 
     invariant(bool(_input) && bool(_nextValue));
     auto currentValue = *_nextValue;
-    _nextValue = _pipeline->getNext();
+    _nextValue = _nextUnwindValue();
 
     // Move input document into output if this is the last or only result, otherwise perform a copy.
     MutableDocument output(_nextValue ? *_input : std::move(*_input));
@@ -422,6 +774,18 @@ void DocumentSourceLookUp::serializeToArray(
                                       << "foreignField"
                                       << _foreignField.fullPath())));
     if (explain) {
+        output[getSourceName()]["strategy"] = Value(_strategyName());
+        if (_hashJoinAbandoned) {
+            output[getSourceName()]["hashJoinAbandoned"] = Value(true);
+        }
+        if (!_foreignKeyFilter.empty()) {
+            output[getSourceName()]["foreignKeyFilter"] = Value(true);
+        }
+        if (_cacheHits + _cacheMisses > 0) {
+            output[getSourceName()]["cache"] =
+                Value(DOC("hits" << _cacheHits << "misses" << _cacheMisses));
+        }
+
         if (_handlingUnwind) {
             const boost::optional<FieldPath> indexPath = _unwindSrc->indexPath();
             output[getSourceName()]["unwinding"] =
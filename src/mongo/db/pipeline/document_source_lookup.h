@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -127,8 +128,59 @@ private:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * How matches in the foreign collection are found for each input document.
+     *
+     * kNestedLoop issues a query against the foreign collection for every input document.
+     * kHashJoin reads the foreign collection once, building an in-memory hash table on the foreign
+     * field, and probes it for every input document. It is used when enabled by
+     * 'internalDocumentSourceLookupEnableHashJoin', and falls back to kNestedLoop if the hash
+     * table would exceed 'internalDocumentSourceLookupMaxMemoryBytes'.
+     */
+    enum class JoinStrategy { kNestedLoop, kHashJoin };
+
     GetNextResult unwindResult();
 
+    /**
+     * If the hash join strategy has been chosen but the hash table has not been built yet, reads
+     * the foreign collection into the hash table, or switches to the nested loop strategy if the
+     * memory limit is reached. Must be called after '_additionalFilter' has been computed.
+     */
+    void _buildHashTableIfNeeded();
+
+    /**
+     * Returns the foreign documents matching 'input' using the hash table. 'matchStage' is the
+     * $match stage the nested loop strategy would query the foreign collection with.
+     */
+    std::vector<Document> _probeHashTable(const Document& input, const BSONObj& matchStage);
+
+    /**
+     * Returns false if '_foreignKeyFilter' shows that no foreign document can match 'input'. May
+     * return true even when there is no match.
+     */
+    bool _mayHaveForeignMatch(const Document& input) const;
+
+    /**
+     * Returns the cached foreign documents matching an input document whose local field is
+     * 'localValue', or nullptr if they are not cached. Counts the cache hit or miss.
+     */
+    const std::vector<Document>* _findInCache(const Value& localValue);
+
+    /**
+     * Caches 'results' as the foreign documents matching an input document whose local field is
+     * 'localValue', unless 'resultsBytes' is more than the cache may hold.
+     */
+    void _addToCache(Value localValue, std::vector<Document> results, size_t resultsBytes);
+
+    /**
+     * Returns the next foreign document matching '_input' when absorbing an $unwind, from either
+     * '_pipeline' or '_bufferedResults', which holds the results of a hash table probe or of a
+     * cache hit.
+     */
+    boost::optional<Document> _nextUnwindValue();
+
+    std::string _strategyName() const;
+
     NamespaceString _fromNs;
     FieldPath _as;
     FieldPath _localField;
@@ -153,8 +205,40 @@ private:
     // '_handlingUnwind' is true.
     long long _cursorIndex = 0;
     boost::intrusive_ptr<Pipeline> _pipeline;
+    std::vector<Document> _bufferedResults;
+    size_t _bufferedResultsIndex = 0;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    JoinStrategy _strategy;
+
+    // The following members are used by the hash join strategy. '_hashJoinDocs' holds every
+    // document read from the foreign collection, and '_hashJoinTable' maps the hash of each value
+    // that a document's foreign field may be equal to onto the positions of those documents in
+    // '_hashJoinDocs'. Since hashes may collide, candidates are checked against the join
+    // predicate before being returned.
+    bool _hashTableBuilt = false;
+    bool _hashJoinAbandoned = false;
+    std::vector<BSONObj> _hashJoinDocs;
+    stdx::unordered_map<size_t, std::vector<size_t>> _hashJoinTable;
+
+    // If the hash table is abandoned for exceeding the memory limit, the rest of the foreign
+    // collection is still read to fill '_foreignKeyFilter', a Bloom filter over the same hashes
+    // '_hashJoinTable' is keyed on. The nested loop strategy then skips querying the foreign
+    // collection for input documents with no value in the filter. Empty if not in use.
+    std::vector<uint64_t> _foreignKeyFilter;
+
+    // The nested loop strategy caches the foreign documents matching each local field value it
+    // queries for, up to 'internalDocumentSourceLookupCacheMaxMemoryBytes', so that input documents
+    // repeating a value need no query. When absorbing an $unwind, the results of the current query
+    // are collected into '_pendingCacheResults' as they are returned and cached once exhausted,
+    // unless they grow too large, in which case '_pendingCacheKey' is reset.
+    LookupSetCache _cache;
+    boost::optional<Value> _pendingCacheKey;
+    std::vector<Document> _pendingCacheResults;
+    size_t _pendingCacheBytes = 0;
+    long long _cacheHits = 0;
+    long long _cacheMisses = 0;
 };
 
 }  // namespace mongo
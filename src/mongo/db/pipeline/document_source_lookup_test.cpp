@@ -43,6 +43,8 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/stub_mongod_interface.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -168,11 +170,17 @@ public:
         pipeline.getValue()->addInitialSource(DocumentSourceMock::create(_mockResults));
         pipeline.getValue()->optimizePipeline();
 
+        ++_numPipelinesMade;
         return pipeline;
     }
 
+    int numPipelinesMade() const {
+        return _numPipelinesMade;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
+    int _numPipelinesMade = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -325,5 +333,307 @@ TEST_F(DocumentSourceLookUpTest, LookupReportsFieldsModifiedByAbsorbedUnwind) {
     ASSERT_EQ(1U, modifiedPaths.paths.count("arrIndex"));
 }
 
+/**
+ * Enables the hash join strategy for $lookup stages created while this object is in scope.
+ */
+class HashJoinEnabler {
+public:
+    HashJoinEnabler() : _wasEnabled(internalDocumentSourceLookupEnableHashJoin.load()) {
+        internalDocumentSourceLookupEnableHashJoin.store(true);
+    }
+
+    ~HashJoinEnabler() {
+        internalDocumentSourceLookupEnableHashJoin.store(_wasEnabled);
+    }
+
+private:
+    const bool _wasEnabled;
+};
+
+TEST_F(DocumentSourceLookUpTest, HashJoinShouldMatchNestedLoopResults) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    HashJoinEnabler hashJoinEnabler;
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    const Value oneAndThree(vector<Value>{Value(1), Value(3)});
+    auto mockLocalSource = DocumentSourceMock::create({Document{{"foreignId", 1}},
+                                                       Document{{"foreignId", 2.0}},
+                                                       Document{{"foreignId", oneAndThree}},
+                                                       Document{{"other", 0}},
+                                                       Document{{"foreignId", 4}}});
+    lookup->setSource(mockLocalSource.get());
+
+    // The foreign documents exercise numeric equivalence, arrays and missing fields.
+    const Document keyOne{{"_id", 0}, {"key", 1}};
+    const Document keyTwo{{"_id", 1}, {"key", 2}};
+    const Document keyArray{{"_id", 2}, {"key", oneAndThree}};
+    const Document keyMissing{{"_id", 3}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(keyOne), Document(keyTwo), Document(keyArray), Document(keyMissing)};
+    lookup->injectMongodInterface(
+        std::make_shared<MockMongodInterface>(std::move(mockForeignContents)));
+
+    auto expectNext = [&](const Document& expected) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    };
+
+    expectNext(Document{{"foreignId", 1},
+                        {"foreignDocs", vector<Value>{Value(keyOne), Value(keyArray)}}});
+    expectNext(Document{{"foreignId", 2.0}, {"foreignDocs", vector<Value>{Value(keyTwo)}}});
+    expectNext(Document{{"foreignId", oneAndThree},
+                        {"foreignDocs", vector<Value>{Value(keyOne), Value(keyArray)}}});
+    expectNext(Document{{"other", 0}, {"foreignDocs", vector<Value>{Value(keyMissing)}}});
+    expectNext(Document{{"foreignId", 4}, {"foreignDocs", vector<Value>{}}});
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    vector<Value> explained;
+    lookup->serializeToArray(explained, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(explained.size(), 1UL);
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["strategy"], Value("hashJoin"_sd));
+    ASSERT_TRUE(explained[0]["$lookup"]["hashJoinAbandoned"].missing());
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinShouldSupportAbsorbedUnwind) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    HashJoinEnabler hashJoinEnabler;
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDoc"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    const bool preserveNullAndEmptyArrays = false;
+    const boost::optional<std::string> includeArrayIndex = boost::none;
+    lookup->setUnwindStage(DocumentSourceUnwind::create(
+        expCtx, "foreignDoc", preserveNullAndEmptyArrays, includeArrayIndex));
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"foreignId", 0}}, Document{{"foreignId", 1}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document first{{"_id", 0}, {"key", 1}};
+    const Document second{{"_id", 1}, {"key", 1}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document(first), Document(second)};
+    lookup->injectMongodInterface(
+        std::make_shared<MockMongodInterface>(std::move(mockForeignContents)));
+
+    // The input document without a match is dropped, and the other is unwound in foreign order.
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"foreignId", 1}, {"foreignDoc", first}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"foreignId", 1}, {"foreignDoc", second}}));
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinShouldFallBackToNestedLoopWhenOverMemoryLimit) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    HashJoinEnabler hashJoinEnabler;
+    const int oldMaxMemoryBytes = internalDocumentSourceLookupMaxMemoryBytes.load();
+    internalDocumentSourceLookupMaxMemoryBytes.store(1);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupMaxMemoryBytes.store(oldMaxMemoryBytes); });
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "_id"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::create({Document{{"foreignId", 0}}});
+    lookup->setSource(mockLocalSource.get());
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}},
+                                                             Document{{"_id", 1}}};
+    lookup->injectMongodInterface(
+        std::make_shared<MockMongodInterface>(std::move(mockForeignContents)));
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 0}, {"foreignDocs", vector<Value>{Value(Document{{"_id", 0}})}}}));
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    vector<Value> explained;
+    lookup->serializeToArray(explained, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(explained.size(), 1UL);
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["strategy"], Value("nestedLoop"_sd));
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["hashJoinAbandoned"], Value(true));
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinFallbackShouldSkipQueriesForMissingKeys) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    HashJoinEnabler hashJoinEnabler;
+    const int oldMaxMemoryBytes = internalDocumentSourceLookupMaxMemoryBytes.load();
+    internalDocumentSourceLookupMaxMemoryBytes.store(1);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupMaxMemoryBytes.store(oldMaxMemoryBytes); });
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"foreignId", 1}},
+                                    Document{{"foreignId", 5}},
+                                    Document{{"foreignId", vector<Value>{Value(6), Value(2)}}},
+                                    Document{{"other", 0}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document keyOne{{"_id", 0}, {"key", 1}};
+    const Document keyTwo{{"_id", 1}, {"key", 2}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document(keyOne), Document(keyTwo)};
+    auto mongodInterface = std::make_shared<MockMongodInterface>(std::move(mockForeignContents));
+    lookup->injectMongodInterface(mongodInterface);
+
+    auto expectNext = [&](const Document& expected) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    };
+
+    expectNext(Document{{"foreignId", 1}, {"foreignDocs", vector<Value>{Value(keyOne)}}});
+    expectNext(Document{{"foreignId", 5}, {"foreignDocs", vector<Value>{}}});
+    expectNext(Document{{"foreignId", vector<Value>{Value(6), Value(2)}},
+                        {"foreignDocs", vector<Value>{Value(keyTwo)}}});
+    expectNext(Document{{"other", 0}, {"foreignDocs", vector<Value>{}}});
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // One pipeline read the foreign collection, and only the two input documents with a key in the
+    // foreign collection were queried for.
+    ASSERT_EQ(3, mongodInterface->numPipelinesMade());
+
+    vector<Value> explained;
+    lookup->serializeToArray(explained, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(explained.size(), 1UL);
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["strategy"], Value("nestedLoop"_sd));
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["foreignKeyFilter"], Value(true));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldCacheResultsForRepeatedLocalValues) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::create({Document{{"foreignId", 1}},
+                                                       Document{{"foreignId", 5}},
+                                                       Document{{"foreignId", 1.0}},
+                                                       Document{{"foreignId", 5}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document keyOne{{"_id", 0}, {"key", 1}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document(keyOne)};
+    auto mongodInterface = std::make_shared<MockMongodInterface>(std::move(mockForeignContents));
+    lookup->injectMongodInterface(mongodInterface);
+
+    auto expectNext = [&](const Document& expected) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    };
+
+    expectNext(Document{{"foreignId", 1}, {"foreignDocs", vector<Value>{Value(keyOne)}}});
+    expectNext(Document{{"foreignId", 5}, {"foreignDocs", vector<Value>{}}});
+    expectNext(Document{{"foreignId", 1.0}, {"foreignDocs", vector<Value>{Value(keyOne)}}});
+    expectNext(Document{{"foreignId", 5}, {"foreignDocs", vector<Value>{}}});
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // Only the first occurrence of each value is queried for, including values without a match.
+    ASSERT_EQ(2, mongodInterface->numPipelinesMade());
+
+    vector<Value> explained;
+    lookup->serializeToArray(explained, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(explained.size(), 1UL);
+    ASSERT_VALUE_EQ(explained[0]["$lookup"]["cache"], Value(DOC("hits" << 2 << "misses" << 2)));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldCacheResultsWhenAbsorbingUnwind) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDoc"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    const bool preserveNullAndEmptyArrays = false;
+    const boost::optional<std::string> includeArrayIndex = boost::none;
+    lookup->setUnwindStage(DocumentSourceUnwind::create(
+        expCtx, "foreignDoc", preserveNullAndEmptyArrays, includeArrayIndex));
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"foreignId", 1}}, Document{{"foreignId", 1}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document first{{"_id", 0}, {"key", 1}};
+    const Document second{{"_id", 1}, {"key", 1}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document(first), Document(second)};
+    auto mongodInterface = std::make_shared<MockMongodInterface>(std::move(mockForeignContents));
+    lookup->injectMongodInterface(mongodInterface);
+
+    for (int i = 0; i < 2; ++i) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                           (Document{{"foreignId", 1}, {"foreignDoc", first}}));
+
+        next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                           (Document{{"foreignId", 1}, {"foreignDoc", second}}));
+    }
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_EQ(1, mongodInterface->numPipelinesMade());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -111,28 +111,35 @@ void DocumentSourceOut::initialize() {
                 ok);
     }
 
-    // copy indexes to _tempNs
-    for (std::list<BSONObj>::const_iterator it = _originalIndexes.begin();
-         it != _originalIndexes.end();
-         ++it) {
-        MutableDocument index((Document(*it)));
-        index.remove("_id");  // indexes shouldn't have _ids but some existing ones do
-        index["ns"] = Value(_tempNs.ns());
-
-        BSONObj indexBson = index.freeze().toBson();
-        conn->insert(_tempNs.getSystemIndexesCollection(), indexBson);
-        BSONObj err = conn->getLastErrorDetailed();
-        uassert(16995,
-                str::stream() << "copying index for $out failed."
-                              << " index: "
-                              << indexBson
-                              << " error: "
-                              << err,
-                DBClientWithCommands::getLastErrorString(err).empty());
-    }
     _initialized = true;
 }
 
+void DocumentSourceOut::copyIndexes() {
+    if (_originalIndexes.empty()) {
+        return;
+    }
+
+    // Build all of the indexes with a single createIndexes command, which scans the temporary
+    // collection once for all of them.
+    BSONObjBuilder cmd;
+    cmd << "createIndexes" << _tempNs.coll();
+    {
+        BSONArrayBuilder indexes(cmd.subarrayStart("indexes"));
+        for (auto&& indexSpec : _originalIndexes) {
+            MutableDocument index((Document(indexSpec)));
+            index.remove("_id");  // indexes shouldn't have _ids but some existing ones do
+            index["ns"] = Value(_tempNs.ns());
+            indexes.append(index.freeze().toBson());
+        }
+    }
+
+    BSONObj info;
+    bool ok = _mongod->directClient()->runCommand(_outputNs.db().toString(), cmd.done(), info);
+    uassert(16995,
+            str::stream() << "copying indexes for $out failed: " << info.toString(),
+            ok);
+}
+
 void DocumentSourceOut::spill(const vector<BSONObj>& toInsert) {
     BSONObj err = _mongod->insert(_tempNs, toInsert);
     uassert(16996,
@@ -178,6 +185,7 @@ DocumentSource::GetNextResult DocumentSourceOut::getNext() {
             return nextInput;  // Propagate the pause.
         }
         case GetNextResult::ReturnStatus::kEOF: {
+            copyIndexes();
 
             auto renameCommandObj =
                 BSON("renameCollection" << _tempNs.ns() << "to" << _outputNs.ns() << "dropTarget"
@@ -80,12 +80,19 @@ private:
      * Sets '_tempNs' to a unique temporary namespace, makes sure the output collection isn't
      * sharded or capped, and saves the collection options and indexes of the target collection.
      * Then creates the temporary collection we will insert into by copying the collection options
-     * and indexes from the target collection.
+     * from the target collection. Only its _id index is created up front; see copyIndexes().
      *
      * Sets '_initialized' to true upon completion.
      */
     void initialize();
 
+    /**
+     * Creates the indexes of the target collection on the temporary collection. This is done once
+     * all documents have been inserted, so that the indexes are built in bulk with a single scan of
+     * the temporary collection rather than maintained by every insert.
+     */
+    void copyIndexes();
+
     /**
      * Inserts all of 'toInsert' into the temporary collection.
      */
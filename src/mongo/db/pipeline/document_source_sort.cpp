@@ -37,6 +37,9 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs.h"
 
 namespace mongo {
 
@@ -239,6 +242,7 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
     if (pExpCtx->extSortAllowed && !pExpCtx->inRouter) {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
+        opts.numThreads = std::max(internalSorterNumThreads.load(), 1);
     }
 
     return opts;
@@ -310,16 +314,52 @@ void DocumentSourceSort::populateFromCursors(const vector<DBClientCursor*>& curs
     _populated = true;
 }
 
+namespace {
+/**
+ * Returns 'value' with every string it contains, at any depth, replaced by its comparison key under
+ * 'collator'. Comparing the results without a collator orders them as comparing the original
+ * values with the collator would, but without going through the collator on every comparison.
+ */
+Value toComparisonKey(const Value& value, const CollatorInterface* collator) {
+    switch (value.getType()) {
+        case String:
+            return Value(collator->getComparisonKey(value.getString()).getKeyData());
+        case Object: {
+            MutableDocument doc;
+            for (FieldIterator it(value.getDocument()); it.more();) {
+                auto field = it.next();
+                doc.addField(field.first, toComparisonKey(field.second, collator));
+            }
+            return doc.freezeToValue();
+        }
+        case Array: {
+            vector<Value> elements;
+            elements.reserve(value.getArrayLength());
+            for (auto&& element : value.getArray()) {
+                elements.push_back(toComparisonKey(element, collator));
+            }
+            return Value(std::move(elements));
+        }
+        default:
+            // Symbols and the remaining types are never compared with the collator.
+            return value;
+    }
+}
+}  // namespace
+
 Value DocumentSourceSort::extractKey(const Document& d) const {
     Variables vars(0, d);
+    const CollatorInterface* collator = pExpCtx->getCollator();
     if (vSortKey.size() == 1) {
-        return vSortKey[0]->evaluate(&vars);
+        Value key = vSortKey[0]->evaluate(&vars);
+        return collator ? toComparisonKey(key, collator) : key;
     }
 
     vector<Value> keys;
     keys.reserve(vSortKey.size());
     for (size_t i = 0; i < vSortKey.size(); i++) {
-        keys.push_back(vSortKey[i]->evaluate(&vars));
+        Value key = vSortKey[i]->evaluate(&vars);
+        keys.push_back(collator ? toComparisonKey(key, collator) : key);
     }
     return Value(std::move(keys));
 }
@@ -332,17 +372,20 @@ int DocumentSourceSort::compare(const Value& lhs, const Value& rhs) const {
       However, the tricky part is what to do is none of the sort keys are
       present.  In this case, consider the document less.
     */
+    // The strings within the keys have already been translated by extractKey(), so the keys are
+    // compared without the collator.
+    const ValueComparator& comparator = ValueComparator::kInstance;
     const size_t n = vSortKey.size();
     if (n == 1) {  // simple fast case
         if (vAscending[0])
-            return pExpCtx->getValueComparator().compare(lhs, rhs);
+            return comparator.compare(lhs, rhs);
         else
-            return -pExpCtx->getValueComparator().compare(lhs, rhs);
+            return -comparator.compare(lhs, rhs);
     }
 
     // compound sort
     for (size_t i = 0; i < n; i++) {
-        int cmp = pExpCtx->getValueComparator().compare(lhs[i], rhs[i]);
+        int cmp = comparator.compare(lhs[i], rhs[i]);
         if (cmp) {
             /* if necessary, adjust the return value by the key ordering */
             if (!vAscending[i])
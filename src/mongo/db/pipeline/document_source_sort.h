@@ -157,7 +157,8 @@ private:
     SortKey vSortKey;
     std::vector<char> vAscending;  // used like std::vector<bool> but without specialization
 
-    /// Extracts the fields in vSortKey from the Document;
+    /// Extracts the fields in vSortKey from the Document, with strings translated to their
+    /// comparison keys when there is a collator;
     Value extractKey(const Document& d) const;
 
     /// Compare two Values according to the specified sort key.
@@ -44,6 +44,8 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
@@ -353,6 +355,33 @@ TEST_F(DocumentSourceSortExecutionTest, ExtractArrayValues) {
                  "[{_id:1,a:[{b:1},{b:1}]},{_id:0,a:[{b:1},{b:2}]}]");
 }
 
+TEST_F(DocumentSourceSortExecutionTest, ShouldRespectCollation) {
+    getExpCtx()->setCollator(
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString));
+    checkResults({Document{{"_id", 0}, {"a", "ab"_sd}}, Document{{"_id", 1}, {"a", "ba"_sd}}},
+                 BSON("a" << 1),
+                 "[{_id:1,a:'ba'},{_id:0,a:'ab'}]");
+}
+
+TEST_F(DocumentSourceSortExecutionTest, ShouldRespectCollationWithinObjectsAndArrays) {
+    getExpCtx()->setCollator(
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString));
+    checkResults({Document{{"_id", 0}, {"a", DOC("b" << DOC_ARRAY("x"_sd << "ab"_sd))}},
+                  Document{{"_id", 1}, {"a", DOC("b" << DOC_ARRAY("x"_sd << "ba"_sd))}}},
+                 BSON("a" << 1),
+                 "[{_id:1,a:{b:['x','ba']}},{_id:0,a:{b:['x','ab']}}]");
+}
+
+TEST_F(DocumentSourceSortExecutionTest, ShouldRespectCollationInCompoundSortSpec) {
+    getExpCtx()->setCollator(
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString));
+    checkResults({Document{{"_id", 0}, {"a", "ab"_sd}, {"b", "ab"_sd}},
+                  Document{{"_id", 1}, {"a", "ab"_sd}, {"b", "ba"_sd}},
+                  Document{{"_id", 2}, {"a", "ba"_sd}, {"b", "ab"_sd}}},
+                 BSON("a" << 1 << "b" << -1),
+                 "[{_id:2,a:'ba',b:'ab'},{_id:0,a:'ab',b:'ab'},{_id:1,a:'ab',b:'ba'}]");
+}
+
 TEST_F(DocumentSourceSortExecutionTest, ShouldPauseWhenAskedTo) {
     auto sort = DocumentSourceSort::create(getExpCtx(), BSON("a" << 1));
     auto mock = DocumentSourceMock::create({DocumentSource::GetNextResult::makePauseExecution(),
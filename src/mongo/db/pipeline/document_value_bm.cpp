@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/field_path.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+const BSONObj kBson = fromjson(
+    "{_id: 1, a: 5, b: 'hello', c: {d: 3, e: [1, 2, 3, 4, 5]}, f: 2.5, g: true, h: 'world'}");
+
+BENCHMARK(Document, FromBsonAndGetField) {
+    while (state.keepRunning()) {
+        Document doc(kBson);
+        benchmarkDoNotOptimize(doc["h"]);
+    }
+}
+
+BENCHMARK(Document, GetNestedField) {
+    const Document doc(kBson);
+    const FieldPath path("c.d");
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(doc.getNestedField(path));
+    }
+}
+
+BENCHMARK(Document, BuildAndToBson) {
+    while (state.keepRunning()) {
+        MutableDocument md;
+        md.addField("_id", Value(1));
+        md.addField("name", Value(StringData("joe")));
+        md.addField("score", Value(4.5));
+        md.addField("sub", Value(Document{{"x", 1}, {"y", 2}}));
+        benchmarkDoNotOptimize(md.freeze().toBson());
+    }
+}
+
+BENCHMARK(Document, ModifyField) {
+    const Document doc(kBson);
+    while (state.keepRunning()) {
+        MutableDocument md(doc);
+        md.setField("a", Value(6));
+        benchmarkDoNotOptimize(md.freeze());
+    }
+}
+
+BENCHMARK(Value, CompareStrings) {
+    const Value lhs(StringData("some string value"));
+    const Value rhs(StringData("some string valuf"));
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(Value::compare(lhs, rhs, nullptr));
+    }
+}
+
+BENCHMARK(Value, CompareDocuments) {
+    const Value lhs{Document(kBson)};
+    const Value rhs{Document(kBson)};
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(Value::compare(lhs, rhs, nullptr));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -113,6 +113,64 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone);
 }
 
+TEST(DocumentConstruction, FromOwnedBsonConvertsFieldsOnAccess) {
+    BSONObj obj = BSON("a" << 1 << "b" << BSON("c" << 2) << "d"
+                           << "q");
+    ASSERT(obj.isOwned());
+    Document document = fromBson(obj);
+
+    // Fields can be looked up in any order.
+    ASSERT_EQUALS("q", document["d"].getString());
+    ASSERT_EQUALS(2, document.getNestedField(FieldPath("b.c")).getInt());
+    ASSERT_EQUALS(1, document["a"].getInt());
+    ASSERT(document["e"].missing());
+
+    // Iteration still follows the original field order.
+    ASSERT_EQUALS(3U, document.size());
+    ASSERT_EQUALS("a", getNthField(document, 0).first.toString());
+    ASSERT_EQUALS("b", getNthField(document, 1).first.toString());
+    ASSERT_EQUALS("d", getNthField(document, 2).first.toString());
+    assertRoundTrips(document);
+}
+
+TEST(DocumentConstruction, FromOwnedBsonFindsFirstOfDuplicateFields) {
+    Document document = fromBson(BSON("a" << 1 << "b" << 2 << "a" << 3));
+    ASSERT_EQUALS(2, document["b"].getInt());
+    ASSERT_EQUALS(1, document["a"].getInt());
+    ASSERT_EQUALS(3U, document.size());
+}
+
+TEST(DocumentConstruction, ModifyingPartiallyConvertedDocument) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2 << "c" << 3 << "d" << 4 << "e" << 5);
+    Document document = fromBson(obj);
+    ASSERT_EQUALS(2, document["b"].getInt());
+
+    MutableDocument md(std::move(document));
+    md["d"] = Value(40);
+    md["f"] = Value(6);
+    md.remove("a");
+    ASSERT_BSONOBJ_EQ(BSON("b" << 2 << "c" << 3 << "d" << 40 << "e" << 5 << "f" << 6),
+                      md.freeze().toBson());
+
+    // A copy that shares the storage sees neither the conversion nor the changes.
+    Document original = fromBson(obj);
+    Document copy = original;
+    MutableDocument mdCopy(copy);
+    mdCopy["a"] = Value(10);
+    ASSERT_EQUALS(1, original["a"].getInt());
+    ASSERT_BSONOBJ_EQ(obj, original.toBson());
+}
+
+TEST(DocumentConstruction, ModifyingNestedDocumentOfPartiallyConvertedDocument) {
+    Document document = fromBson(BSON("a" << BSON("b" << 1 << "c" << 2) << "d" << 3));
+    ASSERT_EQUALS(1, document.getNestedField(FieldPath("a.b")).getInt());
+
+    MutableDocument md(document);
+    md.setNestedField(FieldPath("a.c"), Value(20));
+    ASSERT_BSONOBJ_EQ(BSON("a" << BSON("b" << 1 << "c" << 20) << "d" << 3), md.freeze().toBson());
+    ASSERT_EQUALS(2, document.getNestedField(FieldPath("a.c")).getInt());
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -570,6 +628,18 @@ TEST(MetaFields, ToAndFromBson) {
     ASSERT_EQ(20, fromBson.getRandMetaField());
 }
 
+TEST(MetaFields, FromBsonSkipsMetaFieldsWhenConvertingLazily) {
+    BSONObj obj = BSON("a" << 1 << Document::metaFieldTextScore << 10.0 << "b" << 2);
+    Document doc = Document::fromBsonWithMetaData(obj);
+    ASSERT_TRUE(doc.hasTextScore());
+    ASSERT_FALSE(doc.hasRandMetaField());
+    ASSERT_EQ(10.0, doc.getTextScore());
+    ASSERT_EQ(2, doc["b"].getInt());
+    ASSERT(doc[Document::metaFieldTextScore].missing());
+    ASSERT_EQ(2U, doc.size());
+    ASSERT_BSONOBJ_EQ(BSON("a" << 1 << "b" << 2), doc.toBson());
+}
+
 TEST(MetaFields, BadSerialization) {
     // Write an unrecognized option to the buffer.
     BufBuilder bb;
@@ -622,6 +692,53 @@ public:
     }
 };
 
+/** Arrays converted from BSON keep every element, including those of nested arrays. */
+class ArrayFromBsonElement {
+public:
+    void run() {
+        Value value = fromBson(BSON("" << BSON_ARRAY(1 << BSON_ARRAY("a"_sd
+                                                                     << "b"_sd)
+                                                       << BSONArray())));
+        ASSERT_EQUALS(mongo::Array, value.getType());
+        ASSERT_EQUALS(3U, value.getArrayLength());
+        ASSERT_VALUE_EQ(value[0], Value(1));
+        ASSERT_VALUE_EQ(value[1], DOC_ARRAY("a"_sd
+                                            << "b"_sd));
+        ASSERT_EQUALS(0U, value[2].getArrayLength());
+        assertRoundTrips(value);
+    }
+};
+
+/** A copy of a Value stays valid after the Value it shares its storage with is released. */
+class SharedStorageOutlivesOriginal {
+public:
+    void run() {
+        std::unique_ptr<mongo::Value> original(
+            new mongo::Value(DOC_ARRAY(1 << std::string(100, 'x'))));
+        mongo::Value copy = *original;
+        mongo::Value element = copy[1];
+        original.reset();
+        ASSERT_EQUALS(2U, copy.getArrayLength());
+        ASSERT_EQUALS(std::string(100, 'x'), element.getString());
+        copy = mongo::Value();
+        ASSERT_EQUALS(std::string(100, 'x'), element.getString());
+    }
+};
+
+/** The approximate size of an array includes the spare capacity of its vector. */
+class ArrayApproximateSizeIncludesCapacity {
+public:
+    void run() {
+        vector<mongo::Value> array;
+        array.reserve(100);
+        array.push_back(mongo::Value(1));
+        const size_t elementSize = array.back().getApproximateSize();
+        mongo::Value value(std::move(array));
+        ASSERT_GTE(value.getApproximateSize(), 100 * sizeof(mongo::Value));
+        ASSERT_GTE(value.getApproximateSize(), sizeof(mongo::Value) + elementSize);
+    }
+};
+
 /** Int type. */
 class Int {
 public:
@@ -1733,6 +1850,9 @@ public:
         add<Document::AllTypesDoc>();
 
         add<Value::BSONArrayTest>();
+        add<Value::ArrayFromBsonElement>();
+        add<Value::SharedStorageOutlivesOriginal>();
+        add<Value::ArrayApproximateSizeIncludesCapacity>();
         add<Value::Int>();
         add<Value::Long>();
         add<Value::Double>();
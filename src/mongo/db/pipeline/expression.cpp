@@ -375,10 +375,48 @@ Value ExpressionAdd::evaluateInternal(Variables* vars) const {
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
+    // The common case of adding up ints, longs and a date is done with plain 64-bit arithmetic.
+    // On the first operand of any other type, or on overflow, the integral sum so far moves into
+    // 'nonDecimalTotal' and the remaining operands take the general path.
+    long long integralTotal = 0;
+    bool useIntegralTotal = true;
+
     const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
         Value val = vpOperand[i]->evaluateInternal(vars);
 
+        if (useIntegralTotal) {
+            long long operand = 0;
+            switch (val.getType()) {
+                case NumberInt:
+                    operand = val.getInt();
+                    break;
+                case NumberLong:
+                    operand = val.getLong();
+                    break;
+                case Date:
+                    operand = val.getDate();
+                    break;
+                default:
+                    useIntegralTotal = false;
+            }
+
+            long long sum;
+            if (useIntegralTotal && !mongoSignedAddOverflow64(integralTotal, operand, &sum)) {
+                integralTotal = sum;
+                if (val.getType() == Date) {
+                    uassert(16612, "only one date allowed in an $add expression", !haveDate);
+                    haveDate = true;
+                } else if (val.getType() == NumberLong) {
+                    totalType = NumberLong;
+                }
+                continue;
+            }
+
+            useIntegralTotal = false;
+            nonDecimalTotal.addLong(integralTotal);
+        }
+
         switch (val.getType()) {
             case NumberDecimal:
                 decimalTotal = decimalTotal.add(val.getDecimal());
@@ -411,6 +449,13 @@ Value ExpressionAdd::evaluateInternal(Variables* vars) const {
         }
     }
 
+    if (useIntegralTotal) {
+        if (haveDate)
+            return Value(Date_t::fromMillisSinceEpoch(integralTotal));
+        return totalType == NumberLong ? Value(integralTotal)
+                                       : Value::createIntOrLong(integralTotal);
+    }
+
     if (haveDate) {
         int64_t longTotal;
         if (totalType == NumberDecimal) {
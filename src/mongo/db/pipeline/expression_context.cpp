@@ -57,9 +57,9 @@ ExpressionContext::ExpressionContext(OperationContext* opCtx,
 
 void ExpressionContext::checkForInterrupt() {
     // This check could be expensive, at least in relative terms, so don't check every time.
-    if (--_interruptCounter == 0) {
+    if (_interruptCounter.subtractAndFetch(1) == 0) {
         opCtx->checkForInterrupt();
-        _interruptCounter = kInterruptCheckPeriod;
+        _interruptCounter.store(kInterruptCheckPeriod);
     }
 }
 
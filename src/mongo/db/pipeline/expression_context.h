@@ -42,6 +42,7 @@
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/explain_options.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/string_map.h"
 
@@ -144,7 +145,8 @@ protected:
     // A map from namespace to the resolved namespace, in case any views are involved.
     StringMap<ResolvedNamespace> _resolvedNamespaces;
 
-    int _interruptCounter = kInterruptCheckPeriod;
+    // Atomic since the sub-pipelines of a $facet may run on several threads at once.
+    AtomicWord<int> _interruptCounter{kInterruptCheckPeriod};
 };
 
 }  // namespace mongo
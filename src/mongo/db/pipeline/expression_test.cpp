@@ -1197,6 +1197,31 @@ class LongUndefined : public TwoOperandBase {
     }
 };
 
+/** Integral operands before a double are still summed exactly. */
+class IntLongDouble : public ExpectedResultBase {
+    void populateOperands(intrusive_ptr<ExpressionNary>& expression) {
+        expression->addOperand(ExpressionConstant::create(nullptr, Value(1)));
+        expression->addOperand(ExpressionConstant::create(nullptr, Value(2LL)));
+        expression->addOperand(ExpressionConstant::create(nullptr, Value(0.5)));
+    }
+    BSONObj expectedResult() {
+        return BSON("" << 3.5);
+    }
+};
+
+/** An intermediate sum which overflows a long does not lose precision. */
+class LongIntIntIntermediateOverflow : public ExpectedResultBase {
+    void populateOperands(intrusive_ptr<ExpressionNary>& expression) {
+        expression->addOperand(
+            ExpressionConstant::create(nullptr, Value(numeric_limits<long long>::max())));
+        expression->addOperand(ExpressionConstant::create(nullptr, Value(1)));
+        expression->addOperand(ExpressionConstant::create(nullptr, Value(-1)));
+    }
+    BSONObj expectedResult() {
+        return BSON("" << numeric_limits<long long>::max());
+    }
+};
+
 }  // namespace Add
 
 namespace And {
@@ -4135,6 +4160,8 @@ public:
         add<Add::LongDoubleNoOverflow>();
         add<Add::IntNull>();
         add<Add::LongUndefined>();
+        add<Add::IntLongDouble>();
+        add<Add::LongIntIntIntermediateOverflow>();
 
         add<And::NoOperands>();
         add<And::True>();
@@ -121,6 +121,29 @@ public:
         _memoryUsage += docSize;
     }
 
+    /**
+     * Sets the values with key "key" to "docs", replacing any already cached, and puts the key in
+     * the middle of the cache as insert() does. Unlike insert(), this can cache a key with no
+     * values.
+     */
+    void replace(Value key, std::vector<Document> docs) {
+        auto& byKey = boost::multi_index::get<1>(_container);
+        auto existing = byKey.find(key);
+        if (existing != byKey.end()) {
+            erase(boost::multi_index::project<0>(_container, existing));
+        }
+
+        size_t middle = size() / 2;
+        auto it = _container.begin();
+        std::advance(it, middle);
+
+        _memoryUsage += key.getApproximateSize();
+        for (auto&& doc : docs) {
+            _memoryUsage += doc.getApproximateSize();
+        }
+        _container.insert(it, {std::move(key), std::move(docs)});
+    }
+
     /**
      * Evict the least-recently-used item.
      */
@@ -129,18 +152,7 @@ public:
             return;
         }
 
-        const Cached& pair = _container.back();
-
-        size_t keySize = pair.first.getApproximateSize();
-        invariant(keySize <= _memoryUsage);
-        _memoryUsage -= keySize;
-
-        for (auto&& elem : pair.second) {
-            size_t valueSize = static_cast<size_t>(elem.getApproximateSize());
-            invariant(valueSize <= _memoryUsage);
-            _memoryUsage -= valueSize;
-        }
-        _container.erase(std::prev(_container.end()));
+        erase(std::prev(_container.end()));
     }
 
     /**
@@ -191,6 +203,22 @@ public:
     }
 
 private:
+    /**
+     * Removes the entry at "it", releasing the memory used by its key and values.
+     */
+    void erase(IndexedContainer::iterator it) {
+        size_t keySize = it->first.getApproximateSize();
+        invariant(keySize <= _memoryUsage);
+        _memoryUsage -= keySize;
+
+        for (auto&& elem : it->second) {
+            size_t valueSize = static_cast<size_t>(elem.getApproximateSize());
+            invariant(valueSize <= _memoryUsage);
+            _memoryUsage -= valueSize;
+        }
+        _container.erase(it);
+    }
+
     IndexedContainer _container;
 
     size_t _memoryUsage = 0;
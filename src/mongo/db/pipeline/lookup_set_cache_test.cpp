@@ -132,6 +132,26 @@ TEST(LookupSetCacheTest, EvictDoesRespectMemoryUsage) {
     ASSERT_FALSE(cache[Value(0)]);
 }
 
+TEST(LookupSetCacheTest, ReplaceDoesCacheEmptySetAndOverwriteExistingValues) {
+    LookupSetCache cache(defaultComparator);
+
+    cache.replace(Value(0), {});
+    ASSERT_TRUE(cache[Value(0)]);
+    ASSERT_TRUE(cache[Value(0)]->empty());
+
+    cache.insert(Value(1), intToDoc(0));
+    cache.replace(Value(1), {intToDoc(1), intToDoc(2)});
+    ASSERT_EQ(cache[Value(1)]->size(), 2UL);
+    ASSERT_FALSE(vectorContains(cache[Value(1)], intToDoc(0)));
+    ASSERT_TRUE(vectorContains(cache[Value(1)], intToDoc(2)));
+
+    // The memory of the replaced values is released.
+    cache.evictDownTo(Value(1).getApproximateSize() * 2 + intToDoc(1).getApproximateSize() * 2);
+    ASSERT_EQ(cache.size(), 2UL);
+    cache.evictDownTo(0);
+    ASSERT_EQ(cache.size(), 0UL);
+}
+
 TEST(LookupSetCacheTest, ComplexAccessPatternDoesBehaveCorrectly) {
     LookupSetCache cache(defaultComparator);
 
@@ -51,6 +51,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_merge_cursors.h"
 #include "mongo/db/pipeline/document_source_sample.h"
@@ -60,11 +61,13 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/record_store.h"
@@ -125,6 +128,10 @@ public:
         return collection->infoCache()->getIndexUsageStats();
     }
 
+    std::vector<BSONObj> getQueryShapeStats(const NamespaceString& nss) const final {
+        return QueryShapeStats::get(_ctx->opCtx->getServiceContext()).getStats(nss);
+    }
+
     void appendLatencyStats(const NamespaceString& nss,
                             bool includeHistograms,
                             BSONObjBuilder* builder) const final {
@@ -225,14 +232,31 @@ StatusWith<unique_ptr<PlanExecutor>> createRandomCursorExecutor(Collection* coll
                                                                 long long sampleSize,
                                                                 long long numRecords) {
     double kMaxSampleRatioForRandCursor = 0.05;
-    if (sampleSize > numRecords * kMaxSampleRatioForRandCursor || numRecords <= 100) {
+    double kMaxSampleRatioForBlockSampling = 0.5;
+    if (numRecords <= 100) {
         return {nullptr};
     }
 
-    // Attempt to get a random cursor from the RecordStore. If the RecordStore does not support
-    // random cursors, attempt to get one from the _id index.
-    std::unique_ptr<RecordCursor> rsRandCursor =
-        collection->getRecordStore()->getRandomCursor(opCtx);
+    std::unique_ptr<RecordCursor> rsRandCursor;
+    if (sampleSize > numRecords * kMaxSampleRatioForRandCursor) {
+        // Finding this many random records one at a time would return too many duplicates. A
+        // block sample, reading runs of neighbouring records from random starting points, is
+        // still much cheaper than scanning and sorting the collection, but its records are as
+        // correlated as neighbouring records are, so it is only used when enabled.
+        const long long blockSize = internalDocumentSourceSampleBlockSize.load();
+        if (blockSize <= 0 || sampleSize > numRecords * kMaxSampleRatioForBlockSampling) {
+            return {nullptr};
+        }
+        rsRandCursor =
+            collection->getRecordStore()->getBlockSampleCursor(opCtx, sampleSize, blockSize);
+        if (!rsRandCursor) {
+            return {nullptr};
+        }
+    } else {
+        // Attempt to get a random cursor from the RecordStore. If the RecordStore does not
+        // support random cursors, attempt to get one from the _id index.
+        rsRandCursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    }
 
     auto ws = stdx::make_unique<WorkingSet>();
     std::unique_ptr<PlanStage> stage;
@@ -290,15 +314,13 @@ StatusWith<unique_ptr<PlanExecutor>> createRandomCursorExecutor(Collection* coll
         opCtx, std::move(ws), std::move(stage), collection, PlanExecutor::YIELD_AUTO);
 }
 
-StatusWith<std::unique_ptr<PlanExecutor>> attemptToGetExecutor(
+StatusWith<std::unique_ptr<CanonicalQuery>> canonicalizeQuery(
     OperationContext* opCtx,
-    Collection* collection,
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     BSONObj queryObj,
     BSONObj projectionObj,
     BSONObj sortObj,
-    const AggregationRequest* aggRequest,
-    const size_t plannerOpts) {
+    const AggregationRequest* aggRequest) {
     auto qr = stdx::make_unique<QueryRequest>(pExpCtx->ns);
     qr->setFilter(queryObj);
     qr->setProj(projectionObj);
@@ -320,7 +342,19 @@ StatusWith<std::unique_ptr<PlanExecutor>> attemptToGetExecutor(
 
     const ExtensionsCallbackReal extensionsCallback(pExpCtx->opCtx, &pExpCtx->ns);
 
-    auto cq = CanonicalQuery::canonicalize(opCtx, std::move(qr), extensionsCallback);
+    return CanonicalQuery::canonicalize(opCtx, std::move(qr), extensionsCallback);
+}
+
+StatusWith<std::unique_ptr<PlanExecutor>> attemptToGetExecutor(
+    OperationContext* opCtx,
+    Collection* collection,
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    BSONObj queryObj,
+    BSONObj projectionObj,
+    BSONObj sortObj,
+    const AggregationRequest* aggRequest,
+    const size_t plannerOpts) {
+    auto cq = canonicalizeQuery(opCtx, pExpCtx, queryObj, projectionObj, sortObj, aggRequest);
 
     if (!cq.isOK()) {
         // Return an error instead of uasserting, since there are cases where the combination of
@@ -334,6 +368,55 @@ StatusWith<std::unique_ptr<PlanExecutor>> attemptToGetExecutor(
     return getExecutor(
         opCtx, collection, std::move(cq.getValue()), PlanExecutor::YIELD_AUTO, plannerOpts);
 }
+
+/**
+ * Returns the path of the $group immediately after the leading $sort if that $group only needs
+ * the first, or only the last, document of each group and the $sort orders by its _id first. Such
+ * input can come from a DISTINCT_SCAN returning one index entry per group. '*lastOfEachGroup' is
+ * set when it is the last document, which the DISTINCT_SCAN finds first by scanning in the
+ * reverse of the sort.
+ */
+boost::optional<std::string> getSingleDocumentGroupPathAfterSort(
+    const Pipeline::SourceContainer& sources,
+    const DocumentSourceSort& sortStage,
+    const BSONObj& sortObj,
+    bool* lastOfEachGroup) {
+    // A $limit coalesced into the $sort applies before grouping.
+    if (sources.size() < 2 || sortStage.getLimitSrc()) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(std::next(sources.begin())->get());
+    if (!groupStage) {
+        return boost::none;
+    }
+
+    *lastOfEachGroup = false;
+    auto groupPath = groupStage->getFirstOfEachGroupPath();
+    if (!groupPath) {
+        *lastOfEachGroup = true;
+        groupPath = groupStage->getLastOfEachGroupPath();
+    }
+    if (!groupPath || *groupPath != sortObj.firstElementFieldName()) {
+        return boost::none;
+    }
+    return groupPath;
+}
+
+/**
+ * Returns 'sortObj' with the direction of each field reversed, or boost::none if it sorts by
+ * anything other than field directions, such as a text score.
+ */
+boost::optional<BSONObj> reverseSortPattern(const BSONObj& sortObj) {
+    BSONObjBuilder reversed;
+    for (auto&& elem : sortObj) {
+        if (!elem.isNumber()) {
+            return boost::none;
+        }
+        reversed.append(elem.fieldName(), elem.number() < 0 ? 1 : -1);
+    }
+    return reversed.obj();
+}
 }  // namespace
 
 void PipelineD::prepareCursorSource(Collection* collection,
@@ -493,6 +576,33 @@ StatusWith<std::unique_ptr<PlanExecutor>> PipelineD::prepareExecutor(
 
     BSONObj emptyProjection;
     if (sortStage) {
+        // See if the query system can return just the first (or last) document for each group
+        // of a following $group. The $group still runs, but sees a single document per group.
+        bool lastOfEachGroup = false;
+        auto groupPath = getSingleDocumentGroupPathAfterSort(
+            pipeline->_sources, *sortStage, *sortObj, &lastOfEachGroup);
+        auto distinctSort = lastOfEachGroup ? reverseSortPattern(*sortObj)
+                                            : boost::optional<BSONObj>(*sortObj);
+        if (groupPath && distinctSort) {
+            auto cq = canonicalizeQuery(
+                opCtx, expCtx, queryObj, *projectionObj, *distinctSort, aggRequest);
+            if (cq.isOK()) {
+                auto swExecutorDistinct = getExecutorFirstOfEachDistinct(
+                    opCtx,
+                    collection,
+                    std::move(cq.getValue()),
+                    *groupPath,
+                    PlanExecutor::YIELD_AUTO,
+                    plannerOpts & ~QueryPlannerParams::NO_UNCOVERED_PROJECTIONS);
+                if (swExecutorDistinct.isOK()) {
+                    // The index provides the sort, so remove the $sort stage.
+                    pipeline->_sources.pop_front();
+                    *sortObj = *distinctSort;
+                    return std::move(swExecutorDistinct.getValue());
+                }
+            }
+        }
+
         // See if the query system can provide a non-blocking sort.
         auto swExecutorSort = attemptToGetExecutor(opCtx,
                                                    collection,
@@ -552,6 +662,32 @@ StatusWith<std::unique_ptr<PlanExecutor>> PipelineD::prepareExecutor(
     // sort.
     dassert(sortObj->isEmpty());
 
+    // A leading $group with no accumulators only needs one document for each distinct value of
+    // its _id, in any order, which a DISTINCT_SCAN over an index on that path can provide.
+    auto& sources = pipeline->_sources;
+    auto groupStage = sources.empty() ? nullptr
+                                      : dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (groupStage) {
+        if (auto groupPath = groupStage->getDistinctPath()) {
+            const BSONObj distinctSort = BSON(*groupPath << 1);
+            auto cq = canonicalizeQuery(
+                opCtx, expCtx, queryObj, *projectionObj, distinctSort, aggRequest);
+            if (cq.isOK()) {
+                auto swExecutorDistinct = getExecutorFirstOfEachDistinct(
+                    opCtx,
+                    collection,
+                    std::move(cq.getValue()),
+                    *groupPath,
+                    PlanExecutor::YIELD_AUTO,
+                    plannerOpts & ~QueryPlannerParams::NO_UNCOVERED_PROJECTIONS);
+                if (swExecutorDistinct.isOK()) {
+                    *sortObj = distinctSort;
+                    return std::move(swExecutorDistinct.getValue());
+                }
+            }
+        }
+    }
+
     // See if the query system can cover the projection.
     auto swExecutorProj = attemptToGetExecutor(
         opCtx, collection, expCtx, queryObj, *projectionObj, *sortObj, aggRequest, plannerOpts);
@@ -626,6 +626,52 @@ class MatchShouldDuplicateItselfBeforeRedact : public Base {
     }
 };
 
+class MatchOnGroupKeyShouldFilterGroupInput : public Base {
+    string inputPipeJson() {
+        return "[{$group: {_id: '$a', n: {$sum: 1}}}, "
+               " {$match: {_id: {$gt: 5}}}]";
+    }
+    string outputPipeJson() {
+        return "[{$match: {a: {$gt: 5}}}, "
+               " {$group: {_id: '$a', n: {$sum: {$const: 1}}}}, "
+               " {$match: {_id: {$gt: 5}}}]";
+    }
+};
+
+class MatchOnCompoundGroupKeyShouldFilterGroupInputByFieldPathKeys : public Base {
+    string inputPipeJson() {
+        return "[{$group: {_id: {x: '$a', y: {$const: 1}}, n: {$sum: 1}}}, "
+               " {$match: {'_id.x.b': {$in: [1, 2]}, '_id.y': 1, n: 1}}]";
+    }
+    string outputPipeJson() {
+        return "[{$match: {'a.b': {$in: [1, 2]}}}, "
+               " {$group: {_id: {x: '$a', y: {$const: 1}}, n: {$sum: {$const: 1}}}}, "
+               " {$match: {'_id.x.b': {$in: [1, 2]}, '_id.y': 1, n: 1}}]";
+    }
+};
+
+class MatchOnGroupKeyMatchingNullShouldNotFilterGroupInput : public Base {
+    string inputPipeJson() {
+        return "[{$group: {_id: '$a'}}, "
+               " {$match: {$or: [{_id: 1}, {_id: null}]}}]";
+    }
+    string outputPipeJson() {
+        return "[{$group: {_id: '$a'}}, "
+               " {$match: {$or: [{_id: 1}, {_id: null}]}}]";
+    }
+};
+
+class MatchOnDottedGroupKeyShouldNotFilterGroupInput : public Base {
+    string inputPipeJson() {
+        return "[{$group: {_id: '$a.b'}}, "
+               " {$match: {_id: 1}}]";
+    }
+    string outputPipeJson() {
+        return "[{$group: {_id: '$a.b'}}, "
+               " {$match: {_id: 1}}]";
+    }
+};
+
 class MatchShouldSwapWithUnwind : public Base {
     string inputPipeJson() {
         return "[{$unwind: '$a.b.c'}, "
@@ -1539,6 +1585,10 @@ public:
         add<Optimizations::Local::GraphLookupShouldNotCoalesceWithUnwindNotOnAs>();
         add<Optimizations::Local::GraphLookupShouldSwapWithMatch>();
         add<Optimizations::Local::MatchShouldDuplicateItselfBeforeRedact>();
+        add<Optimizations::Local::MatchOnGroupKeyShouldFilterGroupInput>();
+        add<Optimizations::Local::MatchOnCompoundGroupKeyShouldFilterGroupInputByFieldPathKeys>();
+        add<Optimizations::Local::MatchOnGroupKeyMatchingNullShouldNotFilterGroupInput>();
+        add<Optimizations::Local::MatchOnDottedGroupKeyShouldNotFilterGroupInput>();
         add<Optimizations::Local::MatchShouldSwapWithUnwind>();
         add<Optimizations::Local::MatchShouldNotOptimizeWhenMatchingOnIndexField>();
         add<Optimizations::Local::MatchOnPrefixShouldNotSwapOnUnwind>();
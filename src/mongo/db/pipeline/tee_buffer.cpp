@@ -49,6 +49,15 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_batchesLoadedByCaller) {
+        auto& consumer = _consumers[consumerId];
+        if (consumer.nLeftToReturn == 0) {
+            return _exhausted ? DocumentSource::GetNextResult::makeEOF()
+                              : DocumentSource::GetNextResult::makePauseExecution();
+        }
+        return _buffer[_buffer.size() - consumer.nLeftToReturn--];
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -75,6 +84,26 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+bool TeeBuffer::loadNextBatchForConsumers() {
+    invariant(_batchesLoadedByCaller);
+    if (_exhausted) {
+        return false;
+    }
+
+    if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        _buffer.clear();
+        _source->dispose();
+        _exhausted = true;
+        return false;
+    }
+
+    loadNextBatch();
+    _exhausted = _buffer.empty();
+    return !_exhausted;
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
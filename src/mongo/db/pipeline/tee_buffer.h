@@ -58,6 +58,24 @@ public:
         _source = source;
     }
 
+    /**
+     * Makes consumers only read the batch loaded by the last call to loadNextBatchForConsumers(),
+     * rather than loading the next batch once every consumer has reached the end of this one.
+     * getNext() and dispose() then only touch the state of the consumer they are called for, so
+     * the consumers may read a batch concurrently, on different threads, between two calls to
+     * loadNextBatchForConsumers(). Must be called before any consumer reads from this buffer.
+     */
+    void setBatchesLoadedByCaller() {
+        _batchesLoadedByCaller = true;
+    }
+
+    /**
+     * Loads the next batch for every consumer still in use, for a buffer whose batches are loaded
+     * by the caller. Returns false once the input is exhausted or every consumer has been
+     * disposed, after which getNext() returns EOF for every consumer.
+     */
+    bool loadNextBatchForConsumers();
+
     /**
      * Removes 'consumerId' as a consumer of this buffer. This is required to be called if a
      * consumer will not consume all input.
@@ -65,6 +83,10 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
+        if (_batchesLoadedByCaller) {
+            // The source is disposed by the next loadNextBatchForConsumers() instead.
+            return;
+        }
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
@@ -100,5 +122,10 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    bool _batchesLoadedByCaller = false;
+
+    // Set once a buffer whose batches are loaded by the caller has no more input to load.
+    bool _exhausted = false;
 };
 }  // namespace mongo
@@ -166,5 +166,44 @@ TEST(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDisp
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST(TeeBufferTest, ConsumersOfCallerLoadedBatchesOnlyReadTheCurrentBatch) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::create(inputs);
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+    teeBuffer->setBatchesLoadedByCaller();
+
+    // Nothing is loaded until the caller asks.
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    auto next0 = teeBuffer->getNext(0);
+    ASSERT_TRUE(next0.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next0.getDocument(), inputs.front().getDocument());
+
+    // Finishing the batch does not load the next one, even once every consumer has finished it.
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+    auto next1 = teeBuffer->getNext(1);
+    ASSERT_TRUE(next1.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next1.getDocument(), inputs.front().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(1).isPaused());
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    teeBuffer->dispose(1);
+    next0 = teeBuffer->getNext(0);
+    ASSERT_TRUE(next0.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next0.getDocument(), inputs.back().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(1).isPaused());
+
+    ASSERT_FALSE(teeBuffer->loadNextBatchForConsumers());
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+    ASSERT_FALSE(teeBuffer->loadNextBatchForConsumers());
+}
 }  // namespace
 }  // namespace mongo
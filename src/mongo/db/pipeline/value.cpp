@@ -55,6 +55,21 @@ using std::string;
 using std::stringstream;
 using std::vector;
 
+namespace {
+/**
+ * Converts the elements of a BSON array into a new RCVector. The elements are counted first so the
+ * vector is allocated once, rather than grown one reallocation at a time for each small array.
+ */
+intrusive_ptr<RCVector> makeRCVector(const BSONObj& arr) {
+    intrusive_ptr<RCVector> vec(new RCVector);
+    vec->vec.reserve(arr.nFields());
+    BSONForEach(sub, arr) {
+        vec->vec.push_back(Value(sub));
+    }
+    return vec;
+}
+}  // namespace
+
 void ValueStorage::verifyRefCountingIfShould() const {
     switch (type) {
         case MinKey:
@@ -174,11 +189,7 @@ Value::Value(const BSONElement& elem) : _storage(elem.type()) {
         }
 
         case Array: {
-            intrusive_ptr<RCVector> vec(new RCVector);
-            BSONForEach(sub, elem.embeddedObject()) {
-                vec->vec.push_back(Value(sub));
-            }
-            _storage.putVector(vec.get());
+            _storage.putVector(makeRCVector(elem.embeddedObject()).get());
             break;
         }
 
@@ -236,11 +247,7 @@ Value::Value(const BSONElement& elem) : _storage(elem.type()) {
 }
 
 Value::Value(const BSONArray& arr) : _storage(Array) {
-    intrusive_ptr<RCVector> vec(new RCVector);
-    BSONForEach(sub, arr) {
-        vec->vec.push_back(Value(sub));
-    }
-    _storage.putVector(vec.get());
+    _storage.putVector(makeRCVector(arr).get());
 }
 
 Value::Value(const vector<BSONObj>& vec) : _storage(Array) {
@@ -1086,11 +1093,13 @@ size_t Value::getApproximateSize() const {
             return sizeof(Value) + getDocument().getApproximateSize();
 
         case Array: {
-            size_t size = sizeof(Value);
-            size += sizeof(RCVector);
-            const size_t n = getArray().size();
-            for (size_t i = 0; i < n; ++i) {
-                size += getArray()[i].getApproximateSize();
+            const vector<Value>& array = getArray();
+            // The elements account for their own sizeof(Value), but the vector's spare capacity
+            // is allocated as well.
+            size_t size = sizeof(Value) + sizeof(RCVector) +
+                (array.capacity() - array.size()) * sizeof(Value);
+            for (auto&& elem : array) {
+                size += elem.getApproximateSize();
             }
             return size;
         }
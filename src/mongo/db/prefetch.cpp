@@ -43,6 +43,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/mmap_v1/mmap.h"
 #include "mongo/util/log.h"
@@ -116,11 +117,12 @@ void prefetchIndexPages(OperationContext* opCtx,
     }
 }
 
-// page in the data pages for a record associated with an object
-void prefetchRecordPages(OperationContext* opCtx,
-                         Database* db,
-                         const char* ns,
-                         const BSONObj& obj) {
+// page in the data pages for a record associated with an object. Returns the record's current
+// contents, or an empty object if it was not found.
+BSONObj prefetchRecordPages(OperationContext* opCtx,
+                            Database* db,
+                            const char* ns,
+                            const BSONObj& obj) {
     BSONElement _id;
     if (obj.getObjectID(_id)) {
         TimerHolder timer(&prefetchDocStats);
@@ -139,11 +141,13 @@ void prefetchRecordPages(OperationContext* opCtx,
                 }
                 // hit the last page, in case we missed it above
                 _dummy_char += *(result.objdata() + result.objsize() - 1);
+                return result;
             }
         } catch (const DBException& e) {
             LOG(2) << "ignoring exception in prefetchRecordPages(): " << redact(e);
         }
     }
+    return BSONObj();
 }
 }  // namespace
 
@@ -170,10 +174,12 @@ void prefetchPagesForReplicatedOp(OperationContext* opCtx, Database* db, const B
     BSONObj obj = op.getObjectField(opField);
     const char* ns = op.getStringField("ns");
 
-    // This will have to change for engines other than MMAP V1, because they might not have
-    // means for directly prefetching pages from the collection. For this purpose, acquire S
-    // lock on the database, instead of optimizing with IS.
-    Lock::CollectionLock collLock(opCtx->lockState(), ns, MODE_S);
+    // Engines without document level locking may not have means for directly prefetching pages
+    // from the collection, so acquire an S lock on the collection for them. The others read
+    // through their usual cursors, which only need IS.
+    const bool supportsDocLocking =
+        opCtx->getServiceContext()->getGlobalStorageEngine()->supportsDocLocking();
+    Lock::CollectionLock collLock(opCtx->lockState(), ns, supportsDocLocking ? MODE_IS : MODE_S);
 
     Collection* collection = db->getCollection(ns);
     if (!collection) {
@@ -193,24 +199,19 @@ void prefetchPagesForReplicatedOp(OperationContext* opCtx, Database* db, const B
     //     will be an insert. to do that we could do the prefetchRecordPage first and if DNE
     //     then we do #1.
     //
-    // note that on deletes 'obj' does not have all the keys we would want to prefetch on.
-    // a way to achieve that would be to prefetch the record first, and then afterwards do
-    // this part.
+    // On updates and deletes 'obj' only identifies the document, so the record is prefetched
+    // first and the index pages are then prefetched for the keys of its current version, which
+    // are the entries the writer will remove or replace.
     //
-    prefetchIndexPages(opCtx, collection, prefetchConfig, obj);
-
-    // do not prefetch the data for inserts; it doesn't exist yet
-    //
-    // we should consider doing the record prefetch for the delete op case as we hit the record
-    // when we delete.  note if done we only want to touch the first page.
-    //
-    // update: do record prefetch.
-    if ((*opType == 'u') &&
-        // do not prefetch the data for capped collections because
-        // they typically do not have an _id index for findById() to use.
-        !collection->isCapped()) {
-        prefetchRecordPages(opCtx, db, ns, obj);
+    // do not prefetch the data for inserts; it doesn't exist yet. do not prefetch the data for
+    // capped collections either because they typically do not have an _id index for findById()
+    // to use.
+    BSONObj current;
+    if ((*opType == 'u' || *opType == 'd') && !collection->isCapped()) {
+        current = prefetchRecordPages(opCtx, db, ns, obj);
     }
+
+    prefetchIndexPages(opCtx, collection, prefetchConfig, current.isEmpty() ? obj : current);
 }
 
 class ReplIndexPrefetch : public ServerParameter {
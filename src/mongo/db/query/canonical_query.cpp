@@ -232,6 +232,9 @@ void CanonicalQuery::setCollator(std::unique_ptr<CollatorInterface> collator) {
     // the object owned by '_collator'. We must associate the match expression tree with the new
     // value of '_collator'.
     _root->setCollator(_collator.get());
+
+    // Whether the predicates can use an index depends on the collation.
+    _planCacheKey = boost::none;
 }
 
 // static
@@ -29,6 +29,9 @@
 #pragma once
 
 
+#include <boost/optional.hpp>
+#include <string>
+
 #include "mongo/base/status.h"
 #include "mongo/db/dbmessage.h"
 #include "mongo/db/jsobj.h"
@@ -179,7 +182,27 @@ public:
         return _isIsolated;
     }
 
+    /**
+     * A plan cache key depends on the indexes of the collection as well as on the query, so the
+     * key remembered by memoizePlanCacheKey() is only returned for the same 'indexStateVersion'.
+     * Returns null if no key is remembered for it.
+     */
+    const std::string* getMemoizedPlanCacheKey(unsigned long long indexStateVersion) const {
+        return _planCacheKey && _planCacheKey->indexStateVersion == indexStateVersion
+            ? &_planCacheKey->key
+            : nullptr;
+    }
+
+    void memoizePlanCacheKey(unsigned long long indexStateVersion, std::string key) const {
+        _planCacheKey = MemoizedPlanCacheKey{indexStateVersion, std::move(key)};
+    }
+
 private:
+    struct MemoizedPlanCacheKey {
+        unsigned long long indexStateVersion;
+        std::string key;
+    };
+
     // You must go through canonicalize to create a CanonicalQuery.
     CanonicalQuery() {}
 
@@ -200,6 +223,10 @@ private:
     bool _hasNoopExtensions = false;
 
     bool _isIsolated;
+
+    // Computing the plan cache key is the same work each time the query is looked up in, or
+    // added to, the plan cache.
+    mutable boost::optional<MemoizedPlanCacheKey> _planCacheKey;
 };
 
 }  // namespace mongo
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+const NamespaceString kNss("testdb.testcoll");
+
+void canonicalizeQuery(unittest::BenchmarkState& state,
+                       const BSONObj& filter,
+                       const BSONObj& sort,
+                       const BSONObj& proj) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    while (state.keepRunning()) {
+        auto qr = stdx::make_unique<QueryRequest>(kNss);
+        qr->setFilter(filter);
+        qr->setSort(sort);
+        qr->setProj(proj);
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            opCtx.get(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+        invariantOK(statusWithCQ.getStatus());
+        benchmarkDoNotOptimize(statusWithCQ.getValue());
+    }
+}
+
+BENCHMARK(CanonicalQuery, Point) {
+    canonicalizeQuery(state, fromjson("{_id: 1}"), BSONObj(), BSONObj());
+}
+
+BENCHMARK(CanonicalQuery, RangeWithSortAndProjection) {
+    canonicalizeQuery(state,
+                      fromjson("{a: {$gte: 1, $lt: 100}, b: 'x'}"),
+                      fromjson("{c: -1}"),
+                      fromjson("{_id: 0, a: 1, c: 1}"));
+}
+
+BENCHMARK(CanonicalQuery, NestedOr) {
+    canonicalizeQuery(
+        state,
+        fromjson("{$or: [{a: 1, b: {$in: [1, 2, 3]}}, {c: {$exists: true}}, {d: {$ne: 5}}], e: 1}"),
+        BSONObj(),
+        BSONObj());
+}
+
+}  // namespace
+}  // namespace mongo
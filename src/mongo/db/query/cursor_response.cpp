@@ -32,6 +32,8 @@
 
 #include "mongo/db/query/cursor_response.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsontypes.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/chunk_version.h"
@@ -46,15 +48,42 @@ const char kNsField[] = "ns";
 const char kBatchField[] = "nextBatch";
 const char kBatchFieldInitial[] = "firstBatch";
 
+// Documents at least this large get the reply buffer grown to hold a whole batch at once.
+const int kLargeDocumentBytes = 1024 * 1024;
+
+// Room for the type byte and the array index that precede each document in the batch.
+const int kBatchElementOverheadBytes = 16;
+
 }  // namespace
 
 CursorResponseBuilder::CursorResponseBuilder(bool isInitialResponse,
-                                             BSONObjBuilder* commandResponse)
+                                             BSONObjBuilder* commandResponse,
+                                             int maxBatchBytes)
     : _responseInitialLen(commandResponse->bb().len()),
+      _maxBatchBytes(maxBatchBytes),
       _commandResponse(commandResponse),
       _cursorObject(commandResponse->subobjStart(kCursorField)),
       _batch(_cursorObject.subarrayStart(isInitialResponse ? kBatchFieldInitial : kBatchField)) {}
 
+void CursorResponseBuilder::append(const BSONObj& obj) {
+    invariant(_active);
+
+    // Growing the reply buffer copies all of the batch so far, and the buffer only grows to the
+    // next power of two that fits, so a batch of large documents gets copied over and over as it
+    // grows. Instead, make room for a full batch on the first large document, after which each
+    // document is copied only once, from the storage engine into the reply. Batches stop short
+    // of '_maxBatchBytes', so that is the size to grow to.
+    BufBuilder& buf = _batch.bb();
+    const int bytesNeeded = obj.objsize() + kBatchElementOverheadBytes;
+    if (obj.objsize() >= kLargeDocumentBytes && buf.len() + bytesNeeded > buf.getSize()) {
+        const int bytesToReserve = std::max(bytesNeeded, _maxBatchBytes - buf.len());
+        buf.reserveBytes(bytesToReserve);
+        buf.claimReservedBytes(bytesToReserve);
+    }
+
+    _batch.append(obj);
+}
+
 void CursorResponseBuilder::done(CursorId cursorId, StringData cursorNamespace) {
     invariant(_active);
     _batch.doneFast();
@@ -52,8 +52,13 @@ public:
      *
      * If the builder goes out of scope without a call to done(), any data appended to the
      * builder will be removed.
+     *
+     * 'maxBatchBytes' is the size at which the caller ends a batch. The builder uses it to size
+     * its buffer.
      */
-    CursorResponseBuilder(bool isInitialResponse, BSONObjBuilder* commandResponse);
+    CursorResponseBuilder(bool isInitialResponse,
+                          BSONObjBuilder* commandResponse,
+                          int maxBatchBytes = BSONObjMaxUserSize);
 
     ~CursorResponseBuilder() {
         if (_active)
@@ -65,10 +70,7 @@ public:
         return _batch.len();
     }
 
-    void append(const BSONObj& obj) {
-        invariant(_active);
-        _batch.append(obj);
-    }
+    void append(const BSONObj& obj);
 
     /**
      * Call this after successfully appending all fields that will be part of this response.
@@ -85,6 +87,7 @@ public:
 
 private:
     const int _responseInitialLen;  // Must be the first member so its initializer runs first.
+    const int _maxBatchBytes;
     bool _active = true;
     BSONObjBuilder* const _commandResponse;
     BSONObjBuilder _cursorObject;
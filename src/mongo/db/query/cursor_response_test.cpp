@@ -272,6 +272,29 @@ TEST(CursorResponseTest, addToBSONSubsequentResponse) {
     ASSERT_BSONOBJ_EQ(responseObj, expectedResponse);
 }
 
+// A batch of large documents should not have to keep growing the reply buffer.
+TEST(CursorResponseTest, builderReservesBatchForLargeDocuments) {
+    const std::string bigString(2 * 1024 * 1024, 'x');
+    const BSONObj bigDoc = BSON("_id" << 1 << "s" << bigString);
+
+    BSONObjBuilder builder;
+    CursorResponseBuilder batch(/*isInitialResponse*/ true, &builder);
+    batch.append(bigDoc);
+    const int bufferSize = builder.bb().getSize();
+    ASSERT_GTE(bufferSize, BSONObjMaxUserSize);
+    for (int i = 0; i < 6; ++i) {
+        batch.append(bigDoc);
+    }
+    ASSERT_EQ(bufferSize, builder.bb().getSize());
+    batch.done(CursorId(123), "testdb.testcoll");
+
+    StatusWith<CursorResponse> result =
+        CursorResponse::parseFromBSON(builder.append("ok", 1).obj());
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQ(result.getValue().getBatch().size(), 7U);
+    ASSERT_BSONOBJ_EQ(result.getValue().getBatch()[6], bigDoc);
+}
+
 }  // namespace
 
 }  // namespace mongo
@@ -270,7 +270,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
     // Some top-level exec stats get pulled out of the root stage.
     if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
         bob->appendNumber("nReturned", stats.common.advanced);
-        bob->appendNumber("executionTimeMillisEstimate", stats.common.executionTimeMillis);
+        bob->appendNumber("executionTimeMillisEstimate",
+                          stats.common.executionTimeNanos / 1000000);
+        bob->appendNumber("executionTimeMicros", stats.common.executionTimeNanos / 1000);
         bob->appendNumber("works", stats.common.works);
         bob->appendNumber("advanced", stats.common.advanced);
         bob->appendNumber("needTime", stats.common.needTime);
@@ -279,6 +281,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         bob->appendNumber("restoreState", stats.common.unyields);
         bob->appendNumber("isEOF", stats.common.isEOF);
         bob->appendNumber("invalidates", stats.common.invalidates);
+
+        // Only storage engines which count their work report it.
+        if (!stats.common.storageStats.empty()) {
+            BSONObjBuilder storageBob(bob->subobjStart("storage"));
+            stats.common.storageStats.append(&storageBob);
+        }
     }
 
     // Stage-specific stats
@@ -345,6 +353,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         indexBoundsBob.append("endKey", spec->endKey);
         indexBoundsBob.append("endKeyInclusive", spec->endKeyInclusive);
         bob->append("indexBounds", indexBoundsBob.obj());
+        if (!spec->additionalIndexBounds.isEmpty()) {
+            bob->appendArray("additionalIndexBounds", spec->additionalIndexBounds);
+        }
     } else if (STAGE_DELETE == stats.stageType) {
         DeleteStats* spec = static_cast<DeleteStats*>(stats.specific.get());
 
@@ -484,6 +495,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("memUsage", spec->memUsage);
             bob->appendNumber("memLimit", spec->memLimit);
+            if (spec->usedDisk) {
+                bob->appendBool("usedDisk", true);
+            }
         }
 
         if (spec->limit > 0) {
@@ -652,7 +666,8 @@ void Explain::generateExecStats(PlanStageStats* stats,
     if (totalTimeMillis) {
         out->appendNumber("executionTimeMillis", *totalTimeMillis);
     } else {
-        out->appendNumber("executionTimeMillisEstimate", stats->common.executionTimeMillis);
+        out->appendNumber("executionTimeMillisEstimate",
+                          stats->common.executionTimeNanos / 1000000);
     }
 
     // Flatten the stats tree into a list.
@@ -844,7 +859,7 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
     // root stage of the plan tree.
     const CommonStats* common = root->getCommonStats();
     statsOut->nReturned = common->advanced;
-    statsOut->executionTimeMillis = common->executionTimeMillis;
+    statsOut->executionTimeMicros = common->executionTimeNanos / 1000;
 
     // The other fields are aggregations over the stages in the plan tree. We flatten
     // the tree into a list and then compute these aggregations.
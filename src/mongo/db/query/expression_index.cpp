@@ -31,12 +31,18 @@
 #include <iostream>
 #include <unordered_set>
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
+#include "mongo/db/query/lru_key_value.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/mongoutils/str.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -108,28 +114,126 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
-std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
-    auto minLevel = internalQueryS2GeoCoarsestLevel.load();
-    auto maxLevel = internalQueryS2GeoFinestLevel.load();
+namespace {
 
-    uassert(28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
-    uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
-    uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
+/**
+ * The parameters of the S2RegionCoverer, read from the server parameters.
+ */
+struct S2CovererParams {
+    S2CovererParams()
+        : minLevel(internalQueryS2GeoCoarsestLevel.load()),
+          maxLevel(internalQueryS2GeoFinestLevel.load()),
+          maxCells(internalQueryS2GeoMaxCells.load()) {
+        uassert(
+            28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
+        uassert(
+            28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
+        uassert(
+            28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
+    }
 
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+};
+
+std::vector<S2CellId> computeCovering(const S2Region& region, const S2CovererParams& params) {
     S2RegionCoverer coverer;
-    coverer.set_min_level(minLevel);
-    coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(internalQueryS2GeoMaxCells.load());
+    coverer.set_min_level(params.minLevel);
+    coverer.set_max_level(params.maxLevel);
+    coverer.set_max_cells(params.maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
     return cover;
 }
 
+// Regions larger than this are not cached, which bounds the memory held by the keys of the cache.
+const int kMaxCachedRegionSize = 16 * 1024;
+
+Counter64 coveringCacheHits;
+Counter64 coveringCacheMisses;
+ServerStatusMetricField<Counter64> displayCoveringCacheHits("query.geoCoveringCache.hits",
+                                                            &coveringCacheHits);
+ServerStatusMetricField<Counter64> displayCoveringCacheMisses("query.geoCoveringCache.misses",
+                                                              &coveringCacheMisses);
+
+/**
+ * Remembers the coverings of the most recently queried regions, keyed by the region's BSON and
+ * the coverer parameters they were computed with. Shared by all queries.
+ */
+class S2CoveringCache {
+    MONGO_DISALLOW_COPYING(S2CoveringCache);
+
+public:
+    S2CoveringCache() = default;
+
+    /**
+     * Copies the covering cached for 'key' into 'out'. Returns false if there is none.
+     */
+    bool get(const std::string& key, std::vector<S2CellId>* out) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        std::vector<S2CellId>* cover;
+        if (!_cache || !_cache->get(key, &cover).isOK()) {
+            return false;
+        }
+        *out = *cover;
+        return true;
+    }
+
+    void add(const std::string& key, const std::vector<S2CellId>& cover, size_t maxSize) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // The size can change at runtime, in which case the entries are evicted all at once.
+        if (_maxSize != maxSize) {
+            _cache = stdx::make_unique<LRUKeyValue<std::string, std::vector<S2CellId>>>(maxSize);
+            _maxSize = maxSize;
+        }
+        _cache->add(key, new std::vector<S2CellId>(cover));
+    }
+
+private:
+    stdx::mutex _mutex;
+    size_t _maxSize = 0;
+    std::unique_ptr<LRUKeyValue<std::string, std::vector<S2CellId>>> _cache;
+};
+
+S2CoveringCache coveringCache;
+
+}  // namespace
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return computeCovering(region, S2CovererParams());
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& regionObj) {
+    const S2CovererParams params;
+    const int cacheSize = internalQueryS2GeoCoveringCacheSize.load();
+    if (cacheSize <= 0 || regionObj.objsize() > kMaxCachedRegionSize) {
+        return computeCovering(region, params);
+    }
+
+    std::string key = str::stream() << params.minLevel << ',' << params.maxLevel << ','
+                                    << params.maxCells << ',';
+    key.append(regionObj.objdata(), regionObj.objsize());
+
+    std::vector<S2CellId> cover;
+    if (coveringCache.get(key, &cover)) {
+        coveringCacheHits.increment();
+        return cover;
+    }
+
+    coveringCacheMisses.increment();
+    cover = computeCovering(region, params);
+    coveringCache.add(key, cover, cacheSize);
+    return cover;
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& regionObj,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionObj);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
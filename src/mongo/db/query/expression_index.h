@@ -64,6 +64,14 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Same as get2dsphereCovering(), but remembers the coverings of recently queried regions, as
+     * the same regions tend to be queried over and over. 'regionObj' must be the BSON 'region'
+     * was parsed from.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& regionObj);
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -75,6 +83,7 @@ public:
                                                 OrderedIntervalList* out);
 
     static void cover2dsphere(const S2Region& region,
+                              const BSONObj& regionObj,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
 };
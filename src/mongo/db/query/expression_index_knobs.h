@@ -59,4 +59,7 @@ extern AtomicInt32 internalQueryS2GeoCoarsestLevel;
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern AtomicInt32 internalQueryS2GeoMaxCells;
 
+// How many coverings of queried regions are remembered? Zero disables the cache.
+extern AtomicInt32 internalQueryS2GeoCoveringCacheSize;
+
 }  // namespace mongo
@@ -305,7 +305,7 @@ Message getMore(OperationContext* opCtx,
     int startingResult = 0;
 
     const int InitialBufSize =
-        512 + sizeof(QueryResult::Value) + FindCommon::kMaxBytesToReturnToClientAtOnce;
+        512 + sizeof(QueryResult::Value) + FindCommon::maxBytesPerBatch();
 
     BufBuilder bb(InitialBufSize);
     bb.skip(sizeof(QueryResult::Value));
@@ -623,7 +623,7 @@ std::string runQuery(OperationContext* opCtx,
             }
         }
 
-        if (FindCommon::enoughForFirstBatch(qr, numResults)) {
+        if (FindCommon::enoughForFirstBatch(qr, numResults, bb.len())) {
             LOG(5) << "Enough for first batch, wantMore=" << qr.wantMore()
                    << " ntoreturn=" << qr.getNToReturn().value_or(0)
                    << " numResults=" << numResults;
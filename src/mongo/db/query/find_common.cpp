@@ -30,7 +30,10 @@
 
 #include "mongo/db/query/find_common.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/util/assert_util.h"
 
@@ -38,8 +41,17 @@ namespace mongo {
 
 MONGO_FP_DECLARE(keepCursorPinnedDuringGetMore);
 
-bool FindCommon::enoughForFirstBatch(const QueryRequest& qr, long long numDocs) {
+bool FindCommon::enoughForFirstBatch(const QueryRequest& qr,
+                                     long long numDocs,
+                                     int bytesBuffered) {
     if (!qr.getEffectiveBatchSize()) {
+        const int targetBytes = internalQueryFirstBatchTargetBytes.load();
+        if (targetBytes > 0) {
+            // Small documents fill the batch with more than the default number of documents, so
+            // fewer getMores are needed, and large ones end it early to bound its memory.
+            return numDocs && bytesBuffered >= targetBytes;
+        }
+
         // We enforce a default batch size for the initial find if no batch size is specified.
         return numDocs >= QueryRequest::kDefaultBatchSize;
     }
@@ -47,6 +59,10 @@ bool FindCommon::enoughForFirstBatch(const QueryRequest& qr, long long numDocs)
     return numDocs >= qr.getEffectiveBatchSize().value();
 }
 
+int FindCommon::maxBytesPerBatch() {
+    return std::min(internalQueryMaxBatchBytes.load(), kMaxBytesToReturnToClientAtOnce);
+}
+
 bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered) {
     invariant(numDocs >= 0);
     if (!numDocs) {
@@ -55,7 +71,7 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
         return true;
     }
 
-    return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
+    return (bytesBuffered + nextDoc.objsize()) <= maxBytesPerBatch();
 }
 
 BSONObj FindCommon::transformSortSpec(const BSONObj& sortSpec) {
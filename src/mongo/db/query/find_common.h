@@ -56,11 +56,13 @@ public:
     static const int kInitReplyBufferSize = 32768;
 
     /**
-     * Returns true if the batchSize for the initial find has been satisfied.
+     * Returns true if the batchSize for the initial find has been satisfied, given the number of
+     * docs ('numDocs') and bytes ('bytesBuffered') in the batch so far.
      *
-     * If 'qr' does not have a batchSize, the default batchSize is respected.
+     * If 'qr' does not have a batchSize, the default batchSize is respected, unless
+     * internalQueryFirstBatchTargetBytes asks for the batch to be sized by bytes instead.
      */
-    static bool enoughForFirstBatch(const QueryRequest& qr, long long numDocs);
+    static bool enoughForFirstBatch(const QueryRequest& qr, long long numDocs, int bytesBuffered);
 
     /**
      * Returns true if the batchSize for the getMore has been satisfied.
@@ -72,6 +74,13 @@ public:
         return effectiveBatchSize && numDocs >= effectiveBatchSize;
     }
 
+    /**
+     * Returns the budget of user data for a single batch. This is kMaxBytesToReturnToClientAtOnce
+     * unless internalQueryMaxBatchBytes sets a smaller one, which trades more getMores for
+     * replies that reach the client sooner and take less memory per cursor.
+     */
+    static int maxBytesPerBatch();
+
     /**
      * Given the number of docs ('numDocs') and bytes ('bytesBuffered') currently buffered as a
      * response to a cursor-generating command, returns true if there are enough remaining bytes in
@@ -32,6 +32,7 @@
 
 #include "mongo/db/query/get_executor.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <limits>
 #include <memory>
@@ -39,6 +40,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
@@ -65,6 +67,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/query_knobs.h"
@@ -126,22 +129,8 @@ void fillOutPlannerParams(OperationContext* opCtx,
                           Collection* collection,
                           CanonicalQuery* canonicalQuery,
                           QueryPlannerParams* plannerParams) {
-    // If it's not NULL, we may have indices.  Access the catalog and fill out IndexEntry(s)
-    IndexCatalog::IndexIterator ii = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
-    while (ii.more()) {
-        const IndexDescriptor* desc = ii.next();
-        IndexCatalogEntry* ice = ii.catalogEntry(desc);
-        plannerParams->indices.push_back(IndexEntry(desc->keyPattern(),
-                                                    desc->getAccessMethodName(),
-                                                    desc->isMultikey(opCtx),
-                                                    ice->getMultikeyPaths(opCtx),
-                                                    desc->isSparse(),
-                                                    desc->unique(),
-                                                    desc->indexName(),
-                                                    ice->getFilterExpression(),
-                                                    desc->infoObj(),
-                                                    ice->getCollator()));
-    }
+    // If it's not NULL, we may have indices.  The collection caches an IndexEntry for each.
+    plannerParams->indices = *collection->infoCache()->getIndexEntries(opCtx);
 
     // If query supports index filters, filter params.indices by indices in query settings.
     // Ignore index filters when it is possible to use the id-hack.
@@ -212,6 +201,24 @@ void fillOutPlannerParams(OperationContext* opCtx,
 
 namespace {
 
+/**
+ * Attributes the operation to the shape of 'canonicalQuery', for the per-query-shape statistics.
+ * An operation which plans more than one query is attributed to the first.
+ */
+void setQueryShape(OperationContext* opCtx,
+                   Collection* collection,
+                   const CanonicalQuery& canonicalQuery) {
+    if (internalQueryShapeStatsMaxEntries.load() <= 0) {
+        return;
+    }
+
+    OpDebug& debug = CurOp::get(opCtx)->debug();
+    if (debug.queryShape.empty()) {
+        debug.queryShapeNs = canonicalQuery.ns();
+        debug.queryShape = collection->infoCache()->getPlanCache()->computeKey(canonicalQuery);
+    }
+}
+
 struct PrepareExecutionResult {
     PrepareExecutionResult(unique_ptr<CanonicalQuery> canonicalQuery,
                            unique_ptr<QuerySolution> querySolution,
@@ -225,6 +232,19 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Returns true if the plan in 'cs', rebuilt as 'qs' for the query being planned, is estimated to
+ * cost at least 'internalQueryCacheEstimatedCostRatio' times as much as for the query it was cached
+ * for. For example, an $in may now list many more values.
+ */
+bool isCachedSolutionMuchCostlier(const CachedSolution& cs, const QuerySolution& qs) {
+    const double ratio = internalQueryCacheEstimatedCostRatio.load();
+    if (ratio <= 0 || cs.decisionEstimatedCost <= 0) {
+        return false;
+    }
+    return PlanRanker::estimateCost(qs.root.get()) >= ratio * cs.decisionEstimatedCost;
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -269,6 +289,8 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         canonicalQuery->setCollator(collection->getDefaultCollator()->clone());
     }
 
+    setQueryShape(opCtx, collection, *canonicalQuery);
+
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
 
     // If we have an _id index we can use an idhack plan.
@@ -341,7 +363,17 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         QuerySolution* qs;
         Status status = QueryPlanner::planFromCache(*canonicalQuery, plannerParams, *cs, &qs);
 
-        if (status.isOK()) {
+        bool useCachedSolution = status.isOK();
+        if (useCachedSolution && isCachedSolutionMuchCostlier(*cs, *qs)) {
+            // Plan the query from scratch, replacing the cache entry, rather than working a cached
+            // plan that is unlikely to finish its trial period.
+            LOG(1) << "Cached plan is estimated to be much costlier than when it was cached, "
+                   << "replanning query: " << redact(canonicalQuery->toStringShort());
+            delete qs;
+            useCachedSolution = false;
+        }
+
+        if (useCachedSolution) {
             if ((plannerParams.options & QueryPlannerParams::IS_COUNT) && turnIxscanIntoCount(qs)) {
                 LOG(2) << "Using fast count: " << redact(canonicalQuery->toStringShort());
             }
@@ -419,6 +451,11 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         }
     }
 
+    // Working every candidate makes planning slower with each index that applies, so work only
+    // those with the lowest estimated cost.
+    PlanRanker::pruneCandidates(
+        &solutions, std::max(internalQueryPlanEvaluationMaxCandidates.load(), 0));
+
     if (1 == solutions.size()) {
         // Only one possible plan.  Run it.  Build the stages from the solution.
         PlanStage* rawRoot;
@@ -1083,23 +1120,22 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
         return false;
     }
 
-    // Make sure the bounds are OK.
-    BSONObj startKey;
-    bool startKeyInclusive;
-    BSONObj endKey;
-    bool endKeyInclusive;
-
-    if (!IndexBoundsBuilder::isSingleInterval(
-            isn->bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
+    // Make sure the bounds are OK. They may be several disjoint ranges, e.g. one per value of an
+    // $in, which the count scan seeks between.
+    std::vector<IndexKeyRange> ranges;
+    const int maxRanges = internalQueryMaxCountScanRanges.load();
+    if (maxRanges <= 0 ||
+        !IndexBoundsBuilder::isDisjointRanges(isn->bounds, maxRanges, &ranges)) {
         return false;
     }
 
     // Make the count node that we replace the fetch + ixscan with.
     CountScanNode* csn = new CountScanNode(isn->index);
-    csn->startKey = startKey;
-    csn->startKeyInclusive = startKeyInclusive;
-    csn->endKey = endKey;
-    csn->endKeyInclusive = endKeyInclusive;
+    csn->startKey = ranges[0].startKey;
+    csn->startKeyInclusive = ranges[0].startKeyInclusive;
+    csn->endKey = ranges[0].endKey;
+    csn->endKeyInclusive = ranges[0].endKeyInclusive;
+    csn->additionalRanges.assign(ranges.begin() + 1, ranges.end());
     // Takes ownership of 'cn' and deletes the old root.
     soln->root.reset(csn);
     return true;
@@ -1582,4 +1618,112 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorDistinct(OperationContext* opCtx
     return getExecutor(opCtx, collection, parsedDistinct->releaseQuery(), yieldPolicy);
 }
 
+namespace {
+
+/**
+ * Returns true if 'field', or any field before it in the key pattern of 'index', may have been
+ * indexed through an array. A DISTINCT_SCAN skipping to the next value of 'field' could then
+ * return a document more than once, or not return a document whose array holds a value already
+ * returned for another document. Arrays in the fields after 'field' only repeat a document under
+ * the same value of 'field', which the DISTINCT_SCAN already skips.
+ */
+bool isMultikeyUpTo(const IndexEntry& index, const std::string& field) {
+    if (!index.multikey) {
+        return false;
+    }
+    if (index.multikeyPaths.empty()) {
+        // Which of the fields are multikey is not known.
+        return true;
+    }
+
+    size_t position = 0;
+    for (auto&& elem : index.keyPattern) {
+        if (!index.multikeyPaths[position].empty()) {
+            return true;
+        }
+        if (field == elem.fieldName()) {
+            break;
+        }
+        ++position;
+    }
+    return false;
+}
+
+}  // namespace
+
+StatusWith<unique_ptr<PlanExecutor>> getExecutorFirstOfEachDistinct(
+    OperationContext* opCtx,
+    Collection* collection,
+    unique_ptr<CanonicalQuery> canonicalQuery,
+    const std::string& field,
+    PlanExecutor::YieldPolicy yieldPolicy,
+    size_t plannerOptions) {
+    if (!collection) {
+        return Status(ErrorCodes::BadValue, "collection does not exist");
+    }
+
+    if (canonicalQuery->getQueryRequest().getCollation().isEmpty() &&
+        collection->getDefaultCollator()) {
+        canonicalQuery->setCollator(collection->getDefaultCollator()->clone());
+    }
+
+    // Index keys under a non-simple collation are not the values the caller groups on.
+    if (canonicalQuery->getCollator()) {
+        return Status(ErrorCodes::BadValue, "query has a non-simple collation");
+    }
+
+    QueryPlannerParams plannerParams;
+    plannerParams.options = plannerOptions | QueryPlannerParams::NO_TABLE_SCAN;
+    fillOutPlannerParams(opCtx, collection, canonicalQuery.get(), &plannerParams);
+
+    // Only consider indexes which contain 'field' and can return each document at most once.
+    plannerParams.indices.erase(std::remove_if(plannerParams.indices.begin(),
+                                               plannerParams.indices.end(),
+                                               [&field](const IndexEntry& index) {
+                                                   return index.collator ||
+                                                       !index.keyPattern.hasField(field) ||
+                                                       isMultikeyUpTo(index, field);
+                                               }),
+                                plannerParams.indices.end());
+    if (plannerParams.indices.empty()) {
+        return Status(ErrorCodes::BadValue, "no suitable index for a distinct scan");
+    }
+
+    vector<QuerySolution*> solutions;
+    Status status = QueryPlanner::plan(*canonicalQuery, plannerParams, &solutions);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    unique_ptr<QuerySolution> distinctSolution;
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        unique_ptr<QuerySolution> solution(solutions[i]);
+        if (!distinctSolution && turnIxscanIntoDistinctIxscan(solution.get(), field)) {
+            distinctSolution = std::move(solution);
+        }
+    }
+    if (!distinctSolution) {
+        return Status(ErrorCodes::BadValue,
+                      "no plan could be turned into a distinct scan");
+    }
+
+    unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
+    PlanStage* rawRoot;
+    verify(StageBuilder::build(
+        opCtx, collection, *canonicalQuery, *distinctSolution, ws.get(), &rawRoot));
+    unique_ptr<PlanStage> root(rawRoot);
+
+    LOG(2) << "Using distinct scan for first of each value of " << field << ": "
+           << redact(canonicalQuery->toStringShort())
+           << ", planSummary: " << redact(Explain::getPlanSummary(root.get()));
+
+    return PlanExecutor::make(opCtx,
+                              std::move(ws),
+                              std::move(root),
+                              std::move(distinctSolution),
+                              std::move(canonicalQuery),
+                              collection,
+                              yieldPolicy);
+}
+
 }  // namespace mongo
@@ -116,6 +116,25 @@ StatusWith<std::unique_ptr<PlanExecutor>> getExecutorDistinct(
     ParsedDistinct* parsedDistinct,
     PlanExecutor::YieldPolicy yieldPolicy);
 
+/*
+ * Get an executor that returns only the first result of 'canonicalQuery' for each distinct value
+ * of 'field', by turning an index scan which provides the query's sort into a DISTINCT_SCAN.
+ * This is used to answer $group stages whose output depends only on the first document of each
+ * group. The query's sort must start with 'field'.
+ *
+ * Only indexes whose fields up to 'field' are not multikey are considered, as a DISTINCT_SCAN
+ * over such a field would return documents once per array element. Arrays in later fields of the
+ * index are fine. Returns a non-OK status if no such plan exists, in which case the caller should
+ * plan the query normally.
+ */
+StatusWith<std::unique_ptr<PlanExecutor>> getExecutorFirstOfEachDistinct(
+    OperationContext* opCtx,
+    Collection* collection,
+    std::unique_ptr<CanonicalQuery> canonicalQuery,
+    const std::string& field,
+    PlanExecutor::YieldPolicy yieldPolicy,
+    size_t plannerOptions);
+
 /*
  * Get a PlanExecutor for a query executing as part of a count command.
  *
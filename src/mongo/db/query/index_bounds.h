@@ -144,6 +144,16 @@ struct IndexBounds {
     BoundInclusion boundInclusion;
 };
 
+/**
+ * A contiguous range of keys in an index, from 'startKey' to 'endKey' in index order.
+ */
+struct IndexKeyRange {
+    BSONObj startKey;
+    bool startKeyInclusive;
+    BSONObj endKey;
+    bool endKeyInclusive;
+};
+
 /**
  * A helper used by IndexScan to navigate an index.
  */
@@ -30,6 +30,7 @@
 
 #include "mongo/db/query/index_bounds_builder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -579,7 +580,7 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphere(region, gme->getRawObj(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -1021,4 +1022,79 @@ bool IndexBoundsBuilder::isSingleInterval(const IndexBounds& bounds,
     }
 }
 
+// static
+bool IndexBoundsBuilder::isDisjointRanges(const IndexBounds& bounds,
+                                          size_t maxRanges,
+                                          std::vector<IndexKeyRange>* rangesOut) {
+    rangesOut->clear();
+    if (bounds.fields.empty()) {
+        return false;
+    }
+
+    // Every field before 'rangeField' has only point intervals. Each combination of those points
+    // with an interval on 'rangeField' is a single range.
+    size_t rangeField = 0;
+    size_t numRanges = 1;
+    for (; rangeField < bounds.fields.size(); ++rangeField) {
+        const std::vector<Interval>& intervals = bounds.fields[rangeField].intervals;
+        if (intervals.empty()) {
+            return false;
+        }
+        numRanges *= intervals.size();
+        if (numRanges > maxRanges) {
+            return false;
+        }
+
+        bool allPoints = std::all_of(intervals.begin(), intervals.end(), [](const Interval& ival) {
+            return ival.isPoint();
+        });
+        if (!allPoints || rangeField + 1 == bounds.fields.size()) {
+            break;
+        }
+    }
+
+    // The position in each of the fields up to and including 'rangeField' of the current
+    // combination. Advancing the last field fastest produces the ranges in index order.
+    std::vector<size_t> positions(rangeField + 1, 0);
+    IndexBounds single;
+    single.fields.resize(bounds.fields.size());
+    while (true) {
+        for (size_t i = 0; i < bounds.fields.size(); ++i) {
+            const OrderedIntervalList& oil = bounds.fields[i];
+            if (i > rangeField && 1 != oil.intervals.size()) {
+                rangesOut->clear();
+                return false;
+            }
+            single.fields[i].name = oil.name;
+            single.fields[i].intervals.assign(
+                1, i <= rangeField ? oil.intervals[positions[i]] : oil.intervals[0]);
+        }
+
+        IndexKeyRange range;
+        if (!isSingleInterval(single,
+                              &range.startKey,
+                              &range.startKeyInclusive,
+                              &range.endKey,
+                              &range.endKeyInclusive)) {
+            rangesOut->clear();
+            return false;
+        }
+        rangesOut->push_back(std::move(range));
+
+        size_t field = rangeField + 1;
+        while (field > 0) {
+            --field;
+            if (++positions[field] < bounds.fields[field].intervals.size()) {
+                break;
+            }
+            positions[field] = 0;
+        }
+        if (0 == field && 0 == positions[0]) {
+            break;
+        }
+    }
+
+    return true;
+}
+
 }  // namespace mongo
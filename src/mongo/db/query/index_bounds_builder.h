@@ -190,6 +190,17 @@ public:
                                  bool* startKeyInclusive,
                                  BSONObj* endKey,
                                  bool* endKeyInclusive);
+
+    /**
+     * Returns 'true' if the bounds 'bounds' can be represented as at most 'maxRanges' disjoint
+     * ranges of keys, each of which isSingleInterval() could describe. This is the case when any
+     * number of point intervals on a prefix of the fields is followed by intervals on one field
+     * and "all values" on the rest. The ranges are placed in '*rangesOut' in index order.
+     * Returns 'false' if otherwise.
+     */
+    static bool isDisjointRanges(const IndexBounds& bounds,
+                                 size_t maxRanges,
+                                 std::vector<IndexKeyRange>* rangesOut);
 };
 
 }  // namespace mongo
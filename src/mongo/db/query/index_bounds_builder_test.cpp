@@ -34,11 +34,15 @@
 #include <memory>
 
 #include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/expression_index.h"
+#include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+#include "third_party/s2/s2cellid.h"
 
 using namespace mongo;
 
@@ -1363,6 +1367,75 @@ TEST(IndexBoundsBuilderTest, EqualitySingleMissingSingleInterval) {
     ASSERT(!testSingleInterval(bounds));
 }
 
+//
+// isDisjointRanges
+//
+
+TEST(IndexBoundsBuilderTest, PointsFirstFieldAreDisjointRanges) {
+    // An $in on the first field of {a: 1, b: 1} is one range per value.
+    OrderedIntervalList oil_a("a");
+    OrderedIntervalList oil_b("b");
+    IndexBounds bounds;
+    oil_a.intervals.push_back(Interval(BSON("" << 1 << "" << 1), true, true));
+    oil_a.intervals.push_back(Interval(BSON("" << 3 << "" << 3), true, true));
+    oil_b.intervals.push_back(IndexBoundsBuilder::allValues());
+    bounds.fields.push_back(oil_a);
+    bounds.fields.push_back(oil_b);
+
+    std::vector<IndexKeyRange> ranges;
+    ASSERT(IndexBoundsBuilder::isDisjointRanges(bounds, 10, &ranges));
+    ASSERT_EQUALS(2U, ranges.size());
+    ASSERT_BSONOBJ_EQ(ranges[0].startKey, fromjson("{'': 1, '': {$minKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[0].endKey, fromjson("{'': 1, '': {$maxKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[1].startKey, fromjson("{'': 3, '': {$minKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[1].endKey, fromjson("{'': 3, '': {$maxKey: 1}}"));
+
+    // Too many ranges.
+    ASSERT(!IndexBoundsBuilder::isDisjointRanges(bounds, 1, &ranges));
+}
+
+TEST(IndexBoundsBuilderTest, PointsThenIntervalsAreDisjointRanges) {
+    // Each combination of the points on 'a' with the intervals on 'b' is a range, in index order.
+    OrderedIntervalList oil_a("a");
+    OrderedIntervalList oil_b("b");
+    OrderedIntervalList oil_c("c");
+    IndexBounds bounds;
+    oil_a.intervals.push_back(Interval(BSON("" << 1 << "" << 1), true, true));
+    oil_a.intervals.push_back(Interval(BSON("" << 2 << "" << 2), true, true));
+    oil_b.intervals.push_back(Interval(BSON("" << 4 << "" << 5), true, false));
+    oil_b.intervals.push_back(Interval(BSON("" << 7 << "" << 7), true, true));
+    oil_c.intervals.push_back(IndexBoundsBuilder::allValues());
+    bounds.fields.push_back(oil_a);
+    bounds.fields.push_back(oil_b);
+    bounds.fields.push_back(oil_c);
+
+    std::vector<IndexKeyRange> ranges;
+    ASSERT(IndexBoundsBuilder::isDisjointRanges(bounds, 10, &ranges));
+    ASSERT_EQUALS(4U, ranges.size());
+    ASSERT_BSONOBJ_EQ(ranges[0].startKey, fromjson("{'': 1, '': 4, '': {$minKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[0].endKey, fromjson("{'': 1, '': 5, '': {$minKey: 1}}"));
+    ASSERT_FALSE(ranges[0].endKeyInclusive);
+    ASSERT_BSONOBJ_EQ(ranges[1].startKey, fromjson("{'': 1, '': 7, '': {$minKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[2].startKey, fromjson("{'': 2, '': 4, '': {$minKey: 1}}"));
+    ASSERT_BSONOBJ_EQ(ranges[3].endKey, fromjson("{'': 2, '': 7, '': {$maxKey: 1}}"));
+}
+
+TEST(IndexBoundsBuilderTest, IntervalsOnTwoFieldsAreNotDisjointRanges) {
+    // A range on 'a' followed by a bounded 'b' is not a set of contiguous ranges.
+    OrderedIntervalList oil_a("a");
+    OrderedIntervalList oil_b("b");
+    IndexBounds bounds;
+    oil_a.intervals.push_back(Interval(BSON("" << 1 << "" << 3), true, true));
+    oil_b.intervals.push_back(Interval(BSON("" << 4 << "" << 4), true, true));
+    oil_b.intervals.push_back(Interval(BSON("" << 6 << "" << 6), true, true));
+    bounds.fields.push_back(oil_a);
+    bounds.fields.push_back(oil_b);
+
+    std::vector<IndexKeyRange> ranges;
+    ASSERT(!IndexBoundsBuilder::isDisjointRanges(bounds, 10, &ranges));
+    ASSERT(ranges.empty());
+}
+
 //
 // Complementing bounds for negations
 //
@@ -2137,4 +2210,29 @@ TEST(IndexBoundsBuilderTest, InWithStringAgainstHashedIndexWithCollatorUsesHashO
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
 }
 
+TEST(IndexBoundsBuilderTest, CachedS2CoveringMatchesComputedCovering) {
+    BSONObj obj = fromjson(
+        "{a: {$geoWithin: {$geometry: {type: 'Polygon', coordinates: "
+        "[[[0, 0], [0, 1], [1, 1], [1, 0], [0, 0]]]}}}}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    const GeoMatchExpression* gme = static_cast<const GeoMatchExpression*>(expr.get());
+    const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
+
+    std::vector<S2CellId> expected = ExpressionMapping::get2dsphereCovering(region);
+    ASSERT_FALSE(expected.empty());
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(expected == ExpressionMapping::get2dsphereCovering(region, gme->getRawObj()));
+    }
+
+    // A covering computed with other parameters is not returned from the cache.
+    const int oldMaxCells = internalQueryS2GeoMaxCells.load();
+    ON_BLOCK_EXIT([&] { internalQueryS2GeoMaxCells.store(oldMaxCells); });
+    internalQueryS2GeoMaxCells.store(4);
+
+    std::vector<S2CellId> expectedFewerCells = ExpressionMapping::get2dsphereCovering(region);
+    ASSERT_LESS_THAN_OR_EQUALS(expectedFewerCells.size(), 4U);
+    ASSERT_TRUE(expectedFewerCells ==
+                ExpressionMapping::get2dsphereCovering(region, gme->getRawObj()));
+}
+
 }  // namespace
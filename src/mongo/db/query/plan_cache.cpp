@@ -33,6 +33,7 @@
 #include "mongo/db/query/plan_cache.h"
 
 #include <algorithm>
+#include <functional>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -68,9 +70,10 @@ const char kEncodeCollationSection = '#';
  * user string are escaped with a backslash.
  */
 void encodeUserString(StringData s, StringBuilder* keyBuilder) {
+    // Append the characters between delimiters in one go, as most strings have none.
+    size_t runStart = 0;
     for (size_t i = 0; i < s.size(); ++i) {
-        char c = s[i];
-        switch (c) {
+        switch (s[i]) {
             case kEncodeDiscriminatorsBegin:
             case kEncodeDiscriminatorsEnd:
             case kEncodeChildrenBegin:
@@ -80,14 +83,18 @@ void encodeUserString(StringData s, StringBuilder* keyBuilder) {
             case kEncodeProjectionSection:
             case kEncodeCollationSection:
             case '\\':
-                *keyBuilder << '\\';
-            // Fall through to default case.
+                *keyBuilder << s.substr(runStart, i - runStart) << '\\';
+                runStart = i;
+                break;
             default:
-                *keyBuilder << c;
+                break;
         }
     }
+    *keyBuilder << s.substr(runStart);
 }
 
+AtomicUInt64 nextIndexabilityStateVersion;
+
 /**
  * 2-character encoding of MatchExpression::MatchType.
  */
@@ -249,6 +256,35 @@ void encodeGeoNearMatchExpression(const GeoNearMatchExpression* tree, StringBuil
     }
 }
 
+/**
+ * Adds to 'paths' the field paths that the query predicate 'query' refers to, descending into
+ * logical operators such as $and and $or.
+ */
+void addPathsFromQuery(const BSONObj& query, std::set<std::string>* paths) {
+    for (auto&& elem : query) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (!fieldName.startsWith("$")) {
+            paths->insert(fieldName.toString());
+        } else if (elem.type() == BSONType::Array) {
+            for (auto&& child : elem.Obj()) {
+                if (child.type() == BSONType::Object) {
+                    addPathsFromQuery(child.Obj(), paths);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns true if one of 'lhs' and 'rhs' is the same path as, or a prefix of, the other.
+ */
+bool arePathsRelated(StringData lhs, StringData rhs) {
+    if (lhs.size() > rhs.size()) {
+        std::swap(lhs, rhs);
+    }
+    return rhs.startsWith(lhs) && (rhs.size() == lhs.size() || rhs[lhs.size()] == '.');
+}
+
 }  // namespace
 
 //
@@ -309,19 +345,20 @@ bool PlanCache::shouldCacheQuery(const CanonicalQuery& query) {
 //
 
 CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& entry)
-    : plannerData(entry.plannerData.size()),
-      key(key),
+    : key(key),
       query(entry.query.getOwned()),
       sort(entry.sort.getOwned()),
       projection(entry.projection.getOwned()),
       collation(entry.collation.getOwned()),
-      decisionWorks(entry.decision->stats[0]->common.works) {
+      decisionWorks(entry.decision->stats[0]->common.works),
+      decisionEstimatedCost(entry.decision->estimatedCost) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
-    for (size_t i = 0; i < entry.plannerData.size(); ++i) {
-        verify(entry.plannerData[i]);
-        plannerData[i] = entry.plannerData[i]->clone();
-    }
+    //
+    // Only the winning plan is ever rebuilt from a CachedSolution, so the runners-up are left
+    // in the entry rather than being deep copied on every cache hit.
+    verify(!entry.plannerData.empty() && entry.plannerData[0]);
+    plannerData.push_back(entry.plannerData[0]->clone());
 }
 
 CachedSolution::~CachedSolution() {
@@ -486,6 +523,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -498,9 +539,19 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : _cache(internalQueryCacheSize.load()) {}
+const size_t PlanCache::kNumPartitions = 16;
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
+PlanCache::PlanCache() : PlanCache("") {}
+
+PlanCache::PlanCache(const std::string& ns)
+    : _indexabilityStateVersion(nextIndexabilityStateVersion.fetchAndAdd(1)), _ns(ns) {
+    // Round up so that the partitions hold at least internalQueryCacheSize entries in total.
+    const size_t maxSize = std::max(internalQueryCacheSize.load(), 1);
+    const size_t maxPartitionSize = (maxSize + kNumPartitions - 1) / kNumPartitions;
+    for (size_t i = 0; i < kNumPartitions; ++i) {
+        _partitions.push_back(stdx::make_unique<Partition>(maxPartitionSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -677,8 +728,10 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    const PlanCacheKey key = computeKey(query);
+    Partition& partition = getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, entry);
 
     if (NULL != evictedEntry.get()) {
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
@@ -692,9 +745,10 @@ Status PlanCache::get(const CanonicalQuery& query, CachedSolution** crOut) const
     PlanCacheKey key = computeKey(query);
     verify(crOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -712,9 +766,10 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
     std::unique_ptr<PlanCacheEntryFeedback> autoFeedback(feedback);
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -729,30 +784,84 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const PlanCacheKey key = computeKey(canonicalQuery);
+    Partition& partition = getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
+}
+
+size_t PlanCache::removeEntriesAffectedByIndex(const BSONObj& keyPattern) {
+    size_t numRemoved = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        numRemoved += removeEntriesAffectedByIndexInPartition(keyPattern, &partition->cache);
+    }
+    return numRemoved;
+}
+
+size_t PlanCache::removeEntriesAffectedByIndexInPartition(
+    const BSONObj& keyPattern, LRUKeyValue<PlanCacheKey, PlanCacheEntry>* cache) {
+    std::vector<PlanCacheKey> affectedKeys;
+    for (auto&& keyAndEntry : *cache) {
+        const PlanCacheEntry* entry = keyAndEntry.second;
+        std::set<std::string> paths;
+        addPathsFromQuery(entry->query, &paths);
+        for (auto&& elem : entry->sort) {
+            paths.insert(elem.fieldName());
+        }
+        for (auto&& elem : entry->projection) {
+            paths.insert(elem.fieldName());
+        }
+
+        const bool affected = std::any_of(paths.begin(), paths.end(), [&](const std::string& path) {
+            for (auto&& keyElem : keyPattern) {
+                if (arePathsRelated(path, keyElem.fieldNameStringData())) {
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (affected) {
+            affectedKeys.push_back(keyAndEntry.first);
+        }
+    }
+
+    for (auto&& key : affectedKeys) {
+        cache->remove(key);
+    }
+    return affectedKeys.size();
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
+    const auto version = _indexabilityStateVersion.load();
+    if (const std::string* key = cq.getMemoizedPlanCacheKey(version)) {
+        return *key;
+    }
+
     StringBuilder keyBuilder;
     encodeKeyForMatch(cq.root(), &keyBuilder);
     encodeKeyForSort(cq.getQueryRequest().getSort(), &keyBuilder);
     encodeKeyForProj(cq.getQueryRequest().getProj(), &keyBuilder);
-    return keyBuilder.str();
+    PlanCacheKey key = keyBuilder.str();
+    cq.memoizePlanCacheKey(version, key);
+    return key;
 }
 
 Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOut) const {
     PlanCacheKey key = computeKey(query);
     verify(entryOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -764,29 +873,42 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
 }
 
 std::vector<PlanCacheEntry*> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<PlanCacheEntry*> entries;
     typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
-    for (ConstIterator i = _cache.begin(); i != _cache.end(); i++) {
-        PlanCacheEntry* entry = i->second;
-        entries.push_back(entry->clone());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (ConstIterator i = partition->cache.begin(); i != partition->cache.end(); i++) {
+            PlanCacheEntry* entry = i->second;
+            entries.push_back(entry->clone());
+        }
     }
 
     return entries;
 }
 
 bool PlanCache::contains(const CanonicalQuery& cq) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.hasKey(computeKey(cq));
+    const PlanCacheKey key = computeKey(cq);
+    Partition& partition = getPartition(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.hasKey(key);
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
+}
+
+PlanCache::Partition& PlanCache::getPartition(const PlanCacheKey& key) const {
+    return *_partitions[std::hash<PlanCacheKey>()(key) % kNumPartitions];
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
     _indexabilityState.updateDiscriminators(indexEntries);
+    _indexabilityStateVersion.store(nextIndexabilityStateVersion.fetchAndAdd(1));
 }
 
 }  // namespace mongo
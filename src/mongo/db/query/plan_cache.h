@@ -29,7 +29,9 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
@@ -174,6 +176,11 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The cached plan skips through the index
+        // in 'tree' to the query's bounds on a
+        // field after its unconstrained prefix.
+        SKIP_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -201,7 +208,8 @@ public:
     CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& entry);
     ~CachedSolution();
 
-    // Owned here.
+    // Owned here. Holds the data for the winning solution only. The plan cache commands can
+    // retrieve the runners-up from the PlanCacheEntry.
     std::vector<SolutionCacheData*> plannerData;
 
     // Key used to provide feedback on the entry.
@@ -221,6 +229,10 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     size_t decisionWorks;
+
+    // The estimated cost of the winning plan for the query it was first cached for, or 0 if not
+    // estimated.
+    double decisionEstimatedCost;
 };
 
 /**
@@ -360,6 +372,13 @@ public:
      */
     void clear();
 
+    /**
+     * Removes the cached plans for queries whose predicate, sort or projection refers to a field
+     * of 'keyPattern', or to a prefix or subfield of one. These are the only queries whose plans a
+     * new index with this key pattern could change. Returns the number of plans removed.
+     */
+    size_t removeEntriesAffectedByIndex(const BSONObj& keyPattern);
+
     /**
      * Get the cache key corresponding to the given canonical query.  The query need not already
      * be cached.
@@ -383,7 +402,7 @@ public:
     Status getEntry(const CanonicalQuery& cq, PlanCacheEntry** entryOut) const;
 
     /**
-     * Returns a vector of all cache entries.
+     * Returns a vector of all cache entries, most recently used first within each partition.
      * Caller owns the result vector and is responsible for cleaning up
      * the cache entry copies.
      * Used by planCacheListQueryShapes and index_filter_commands_test.cpp.
@@ -415,10 +434,37 @@ private:
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    /**
+     * A slice of the cache holding the keys which hash to it, with its own lock and LRU order.
+     * Splitting the cache means that lookups of different query shapes rarely wait on each other.
+     */
+    struct Partition {
+        explicit Partition(size_t maxSize) : cache(maxSize) {}
+
+        // Protects 'cache'.
+        stdx::mutex mutex;
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry> cache;
+    };
+
+    static const size_t kNumPartitions;
+
+    Partition& getPartition(const PlanCacheKey& key) const;
+
+    /**
+     * Removes the entries of 'cache' whose plans could be affected by the index 'keyPattern'.
+     * The caller must hold the lock of the partition owning 'cache'.
+     */
+    static size_t removeEntriesAffectedByIndexInPartition(
+        const BSONObj& keyPattern, LRUKeyValue<PlanCacheKey, PlanCacheEntry>* cache);
+
+    // Has kNumPartitions elements. Eviction is least-recently-used within each partition.
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    // Identifies the current '_indexabilityState' to the keys memoized by CanonicalQuery. Taken
+    // from a process-wide counter, so that no two states of any PlanCache share a version.
+    // Changed only with the collection locked exclusively.
+    AtomicUInt64 _indexabilityStateVersion;
 
     // Full namespace of collection.
     std::string _ns;
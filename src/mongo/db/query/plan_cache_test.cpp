@@ -423,6 +423,92 @@ TEST(PlanCacheTest, AddValidSolution) {
     ASSERT_EQUALS(planCache.size(), 1U);
 }
 
+// A cache hit hands out the winning plan only.
+TEST(PlanCacheTest, GetReturnsOnlyWinningSolution) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    QuerySolution winner;
+    winner.cacheData.reset(new SolutionCacheData());
+    winner.cacheData->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
+    winner.cacheData->tree.reset(new PlanCacheIndexTree());
+    QuerySolution runnerUp;
+    runnerUp.cacheData.reset(new SolutionCacheData());
+    runnerUp.cacheData->solnType = SolutionCacheData::COLLSCAN_SOLN;
+    runnerUp.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns{&winner, &runnerUp};
+    ASSERT_OK(planCache.add(*cq, solns, createDecision(2U)));
+
+    CachedSolution* rawCS;
+    ASSERT_OK(planCache.get(*cq, &rawCS));
+    unique_ptr<CachedSolution> cs(rawCS);
+    ASSERT_EQUALS(cs->plannerData.size(), 1U);
+    ASSERT_EQUALS(cs->plannerData[0]->solnType, SolutionCacheData::WHOLE_IXSCAN_SOLN);
+
+    // The entry itself still knows about every candidate.
+    PlanCacheEntry* rawEntry;
+    ASSERT_OK(planCache.getEntry(*cq, &rawEntry));
+    unique_ptr<PlanCacheEntry> entry(rawEntry);
+    ASSERT_EQUALS(entry->plannerData.size(), 2U);
+}
+
+TEST(PlanCacheTest, AddingIndexRemovesOnlyEntriesReferringToItsFields) {
+    PlanCache planCache;
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns{&qs};
+
+    unique_ptr<CanonicalQuery> onA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> onSubfieldOfB(canonicalize("{$or: [{'b.c': 1}, {d: 1}]}"));
+    unique_ptr<CanonicalQuery> sortedOnB(canonicalize("{d: 1}", "{b: 1}", "{}", "{}"));
+    unique_ptr<CanonicalQuery> onBc(canonicalize("{bc: 1}"));
+    for (auto&& cq : {onA.get(), onSubfieldOfB.get(), sortedOnB.get(), onBc.get()}) {
+        ASSERT_OK(planCache.add(*cq, solns, createDecision(1U)));
+    }
+    ASSERT_EQUALS(planCache.size(), 4U);
+
+    ASSERT_EQUALS(planCache.removeEntriesAffectedByIndex(BSON("b" << 1 << "e" << 1)), 2U);
+    ASSERT_TRUE(planCache.contains(*onA));
+    ASSERT_FALSE(planCache.contains(*onSubfieldOfB));
+    ASSERT_FALSE(planCache.contains(*sortedOnB));
+    ASSERT_TRUE(planCache.contains(*onBc));
+}
+
+// Shapes are spread over the cache's partitions; size(), getAllEntries() and clear() see them all.
+TEST(PlanCacheTest, ManyShapesAreVisibleAcrossPartitions) {
+    PlanCache planCache;
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns{&qs};
+
+    const size_t kNumShapes = 50;
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (size_t i = 0; i < kNumShapes; ++i) {
+        const std::string field = str::stream() << "f" << i;
+        queries.push_back(canonicalize(BSON(field << 1)));
+        ASSERT_OK(planCache.add(*queries.back(), solns, createDecision(1U)));
+    }
+    ASSERT_EQUALS(planCache.size(), kNumShapes);
+    for (auto&& cq : queries) {
+        ASSERT_TRUE(planCache.contains(*cq));
+    }
+
+    std::vector<PlanCacheEntry*> entries = planCache.getAllEntries();
+    ASSERT_EQUALS(entries.size(), kNumShapes);
+    for (auto&& entry : entries) {
+        delete entry;
+    }
+
+    ASSERT_OK(planCache.remove(*queries[0]));
+    ASSERT_FALSE(planCache.contains(*queries[0]));
+    ASSERT_EQUALS(planCache.size(), kNumShapes - 1);
+
+    planCache.clear();
+    ASSERT_EQUALS(planCache.size(), 0U);
+    ASSERT_TRUE(planCache.getAllEntries().empty());
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -1455,6 +1541,34 @@ TEST(PlanCacheTest, ComputeKeySparseIndex) {
     ASSERT_NOT_EQUALS(planCache.computeKey(*cqEqNull), planCache.computeKey(*cqEqNumber));
 }
 
+// The key memoized on a CanonicalQuery must not outlive the index state it was computed for.
+TEST(PlanCacheTest, ComputeKeyMemoizedPerIndexState) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cqEqNull(canonicalize("{a: null}"));
+    unique_ptr<CanonicalQuery> cqEqNumber(canonicalize("{a: 0}"));
+
+    const PlanCacheKey keyBeforeIndexes = planCache.computeKey(*cqEqNull);
+    ASSERT_EQ(keyBeforeIndexes, planCache.computeKey(*cqEqNull));
+    ASSERT_EQ(keyBeforeIndexes, planCache.computeKey(*cqEqNumber));
+
+    planCache.notifyOfIndexEntries({IndexEntry(BSON("a" << 1),
+                                               false,    // multikey
+                                               true,     // sparse
+                                               false,    // unique
+                                               "",       // name
+                                               nullptr,  // filterExpr
+                                               BSONObj())});
+
+    // The sparse index can answer 'cqEqNumber' but not 'cqEqNull', so their keys now differ.
+    ASSERT_NOT_EQUALS(planCache.computeKey(*cqEqNull), planCache.computeKey(*cqEqNumber));
+    ASSERT_NOT_EQUALS(keyBeforeIndexes, planCache.computeKey(*cqEqNull));
+
+    // A cache without the sparse index computes its own key.
+    PlanCache otherPlanCache;
+    ASSERT_EQ(keyBeforeIndexes, otherPlanCache.computeKey(*cqEqNull));
+    ASSERT_NOT_EQUALS(otherPlanCache.computeKey(*cqEqNull), planCache.computeKey(*cqEqNull));
+}
+
 // When a partial index is present, computeKey() should generate different keys depending on
 // whether or not the predicates in the given query "match" the predicates in the partial index
 // filter.
@@ -30,6 +30,8 @@
 
 #include "mongo/db/query/plan_executor.h"
 
+#include <algorithm>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -43,6 +45,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
@@ -295,6 +298,11 @@ void PlanExecutor::saveState() {
     // boundaries.
     WorkingSetCommon::prepareForSnapshotChange(_workingSet.get());
 
+    // Results batched up but not returned yet may point into storage engine cursors as well.
+    for (size_t i = _numBatchedResultsReturned; i < _batch.ids.size(); ++i) {
+        _workingSet->get(_batch.ids[i])->makeObjOwnedIfNeeded();
+    }
+
     if (!killed()) {
         _root->saveState();
     }
@@ -348,6 +356,15 @@ void PlanExecutor::invalidate(OperationContext* opCtx, const RecordId& dl, Inval
     if (!killed()) {
         _root->invalidate(opCtx, dl, type);
     }
+
+    // A batched result still has to be returned as it was when the plan produced it, so take a
+    // copy of the document before it changes or goes away.
+    for (size_t i = _numBatchedResultsReturned; i < _batch.ids.size(); ++i) {
+        WorkingSetMember* member = _workingSet->get(_batch.ids[i]);
+        if (member->hasRecordId() && member->recordId == dl && member->hasObj()) {
+            member->obj.setValue(member->obj.value().getOwned());
+        }
+    }
 }
 
 PlanExecutor::ExecState PlanExecutor::getNext(BSONObj* objOut, RecordId* dlOut) {
@@ -432,7 +449,7 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         fetcher.reset();
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code = workRoot(&id);
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -511,9 +528,45 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
     }
 }
 
+PlanStage::StageState PlanExecutor::workRoot(WorkingSetID* out) {
+    if (_numBatchedResultsReturned < _batch.ids.size()) {
+        *out = _batch.ids[_numBatchedResultsReturned++];
+        return PlanStage::ADVANCED;
+    }
+
+    if (_batchEndState) {
+        const PlanStage::StageState state = *_batchEndState;
+        _batchEndState = boost::none;
+        *out = _batch.stateId;
+        return state;
+    }
+
+    // There is no check for yielding between the units of work in a batch, so a batch is never
+    // longer than the number of iterations between yields.
+    const int maxWorks =
+        std::min(internalQueryExecMaxWorksPerBatch.load(), internalQueryExecYieldIterations.load());
+    if (maxWorks <= 1) {
+        return _root->work(out);
+    }
+
+    const PlanStage::StageState state = _root->workBatch(_workingSet.get(), maxWorks, &_batch);
+    _numBatchedResultsReturned = 0;
+    if (_batch.ids.empty()) {
+        *out = _batch.stateId;
+        return state;
+    }
+
+    if (PlanStage::ADVANCED != state && PlanStage::NEED_TIME != state) {
+        _batchEndState = state;
+    }
+    *out = _batch.ids[_numBatchedResultsReturned++];
+    return PlanStage::ADVANCED;
+}
+
 bool PlanExecutor::isEOF() {
     invariant(_currentState == kUsable);
-    return killed() || (_stash.empty() && _root->isEOF());
+    return killed() ||
+        (_stash.empty() && _numBatchedResultsReturned == _batch.ids.size() && _root->isEOF());
 }
 
 void PlanExecutor::registerExec(const Collection* collection) {
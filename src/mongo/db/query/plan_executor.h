@@ -32,6 +32,7 @@
 #include <queue>
 
 #include "mongo/base/status.h"
+#include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/invalidation_type.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/storage/snapshot.h"
@@ -382,6 +383,13 @@ public:
 private:
     ExecState getNextImpl(Snapshotted<BSONObj>* objOut, RecordId* dlOut);
 
+    /**
+     * Returns the next state of the plan, and the out parameter that goes with it, exactly as
+     * _root->work() would. Works the plan in batches when internalQueryExecMaxWorksPerBatch
+     * allows it, handing out the batched results one by one.
+     */
+    PlanStage::StageState workRoot(WorkingSetID* out);
+
     /**
      * RAII approach to ensuring that plan executors are deregistered.
      *
@@ -476,6 +484,16 @@ private:
     // stages.
     std::queue<BSONObj> _stash;
 
+    // The last batch of work done by _root. Its results from index '_numBatchedResultsReturned'
+    // onwards have not been returned by workRoot() yet. Their objects must be kept valid across
+    // yields, as any stage buffering results does.
+    PlanStage::WorkBatch _batch;
+    size_t _numBatchedResultsReturned = 0;
+
+    // The state which ended '_batch' early. workRoot() returns it once the results before it
+    // have all been returned.
+    boost::optional<PlanStage::StageState> _batchEndState;
+
     enum { kUsable, kSaved, kDetached } _currentState = kUsable;
 
     bool _everDetachedFromOperationContext = false;
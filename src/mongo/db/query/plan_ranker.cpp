@@ -57,6 +57,49 @@ bool scoreComparator(const std::pair<double, size_t>& lhs, const std::pair<doubl
     return lhs.first > rhs.first;
 }
 
+// The textbook selectivities of an equality and of a range predicate, used to estimate how much of
+// an index a scan reads.
+const double kPointSelectivity = 0.1;
+const double kRangeSelectivity = 1.0 / 3;
+
+// A blocking sort must read every result before returning the first, so plans with one are
+// estimated to cost this many times as much as the scan beneath them.
+const double kBlockingSortCostFactor = 2.0;
+
+bool isAllValues(const mongo::Interval& interval) {
+    return (interval.start.type() == mongo::MinKey && interval.end.type() == mongo::MaxKey) ||
+        (interval.start.type() == mongo::MaxKey && interval.end.type() == mongo::MinKey);
+}
+
+/**
+ * Estimates the fraction of an index read by a scan over 'bounds'. Each leading field with only
+ * point intervals narrows the scan further. The first field with a range narrows it once more, and
+ * the fields after it only filter the keys read.
+ */
+double estimateScanFraction(const mongo::IndexBounds& bounds) {
+    if (bounds.isSimpleRange) {
+        return kRangeSelectivity;
+    }
+
+    double fraction = 1.0;
+    for (auto&& oil : bounds.fields) {
+        const auto& intervals = oil.intervals;
+        const bool allPoints = std::all_of(intervals.begin(),
+                                           intervals.end(),
+                                           [](const mongo::Interval& i) { return i.isPoint(); });
+        if (allPoints) {
+            fraction *= std::min(1.0, intervals.size() * kPointSelectivity);
+            continue;
+        }
+
+        if (intervals.size() != 1 || !isAllValues(intervals[0])) {
+            fraction *= std::min(1.0, intervals.size() * kRangeSelectivity);
+        }
+        break;
+    }
+    return fraction;
+}
+
 }  // namespace
 
 namespace mongo {
@@ -157,6 +200,9 @@ size_t PlanRanker::pickBestPlan(const vector<CandidatePlan>& candidates, PlanRan
     }
 
     size_t bestChild = scoresAndCandidateindices[0].second;
+    if (const auto& solution = candidates[bestChild].solution) {
+        why->estimatedCost = estimateCost(solution->root.get());
+    }
     return bestChild;
 }
 
@@ -261,4 +307,65 @@ double PlanRanker::scoreTree(const PlanStageStats* stats) {
     return score;
 }
 
+// static
+double PlanRanker::estimateCost(const QuerySolutionNode* node) {
+    switch (node->getType()) {
+        case STAGE_IXSCAN:
+            return estimateScanFraction(static_cast<const IndexScanNode*>(node)->bounds);
+        case STAGE_COLLSCAN:
+            return 1.0;
+        case STAGE_SORT:
+            return kBlockingSortCostFactor * estimateCost(node->children[0]);
+        default:
+            break;
+    }
+
+    // Leaves we cannot estimate, such as text and geo searches, are assumed to read everything.
+    if (node->children.empty()) {
+        return 1.0;
+    }
+
+    // A stage with several children, such as an $or or an index intersection, reads from all of
+    // them.
+    double cost = 0;
+    for (auto&& child : node->children) {
+        cost += estimateCost(child);
+    }
+    return cost;
+}
+
+// static
+void PlanRanker::pruneCandidates(std::vector<QuerySolution*>* solutions, size_t maxCandidates) {
+    if (maxCandidates == 0 || solutions->size() <= maxCandidates) {
+        return;
+    }
+
+    std::vector<double> costs;
+    std::vector<size_t> byCost;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        costs.push_back(estimateCost((*solutions)[i]->root.get()));
+        byCost.push_back(i);
+    }
+    std::stable_sort(byCost.begin(), byCost.end(), [&costs](size_t lhs, size_t rhs) {
+        return costs[lhs] < costs[rhs];
+    });
+
+    std::vector<bool> keep(solutions->size(), false);
+    for (size_t i = 0; i < maxCandidates; ++i) {
+        keep[byCost[i]] = true;
+    }
+
+    std::vector<QuerySolution*> kept;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (keep[i]) {
+            kept.push_back((*solutions)[i]);
+        } else {
+            LOG(5) << "Not working candidate plan with estimated cost " << costs[i]
+                   << ": " << redact((*solutions)[i]->toString());
+            delete (*solutions)[i];
+        }
+    }
+    solutions->swap(kept);
+}
+
 }  // namespace mongo
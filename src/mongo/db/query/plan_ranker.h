@@ -62,6 +62,20 @@ public:
      * the plan. The exact value isn't meaningful except for imposing a ranking.
      */
     static double scoreTree(const PlanStageStats* stats);
+
+    /**
+     * Estimates, without executing it, the relative cost of the plan rooted at 'root' from the
+     * shape of its index bounds. The estimate is roughly the fraction of the collection or its
+     * indexes the plan reads, so lower is cheaper.
+     */
+    static double estimateCost(const QuerySolutionNode* root);
+
+    /**
+     * If there are more than 'maxCandidates' solutions, deletes all but the 'maxCandidates' with
+     * the lowest estimated cost, keeping the remaining solutions in their original order. Does
+     * nothing if 'maxCandidates' is 0.
+     */
+    static void pruneCandidates(std::vector<QuerySolution*>* solutions, size_t maxCandidates);
 };
 
 /**
@@ -101,6 +115,7 @@ struct PlanRankingDecision {
         }
         decision->scores = scores;
         decision->candidateOrder = candidateOrder;
+        decision->estimatedCost = estimatedCost;
         return decision;
     }
 
@@ -125,6 +140,9 @@ struct PlanRankingDecision {
     // Reading this flag is the only reliable way for callers to determine if there was a tie,
     // because the scores kept inside the PlanRankingDecision do not incorporate the EOF bonus.
     bool tieForBest = false;
+
+    // The winning plan's cost as estimated by PlanRanker::estimateCost(), or 0 if not estimated.
+    double estimatedCost = 0;
 };
 
 }  // namespace mongo
@@ -42,33 +42,52 @@
 namespace mongo {
 
 PlanYieldPolicy::PlanYieldPolicy(PlanExecutor* exec, PlanExecutor::YieldPolicy policy)
-    : _policy(policy),
-      _forceYield(false),
-      _elapsedTracker(exec->getOpCtx()->getServiceContext()->getFastClockSource(),
-                      internalQueryExecYieldIterations.load(),
-                      Milliseconds(internalQueryExecYieldPeriodMS.load())),
-      _planYielding(exec) {}
-
+    : PlanYieldPolicy(policy, exec, exec->getOpCtx()->getServiceContext()->getFastClockSource()) {}
 
 PlanYieldPolicy::PlanYieldPolicy(PlanExecutor::YieldPolicy policy, ClockSource* cs)
+    : PlanYieldPolicy(policy, nullptr, cs) {}
+
+PlanYieldPolicy::PlanYieldPolicy(PlanExecutor::YieldPolicy policy,
+                                 PlanExecutor* exec,
+                                 ClockSource* cs)
     : _policy(policy),
       _forceYield(false),
+      _clockSource(cs),
       _elapsedTracker(cs,
                       internalQueryExecYieldIterations.load(),
                       Milliseconds(internalQueryExecYieldPeriodMS.load())),
-      _planYielding(nullptr) {}
+      _lastYieldTime(cs->now()),
+      _planYielding(exec) {}
 
 bool PlanYieldPolicy::shouldYield() {
     if (!allowedToYield())
         return false;
-    invariant(!_planYielding->getOpCtx()->lockState()->inAWriteUnitOfWork());
+    OperationContext* opCtx = _planYielding->getOpCtx();
+    invariant(!opCtx->lockState()->inAWriteUnitOfWork());
     if (_forceYield)
         return true;
-    return _elapsedTracker.intervalHasElapsed();
+    if (!_elapsedTracker.intervalHasElapsed())
+        return false;
+    if (_policy != PlanExecutor::YIELD_AUTO || !internalQueryExecYieldOnlyWhenContended.load())
+        return true;
+
+    // Yielding saves and restores the whole plan and starts a new storage snapshot, which is only
+    // worth it if it lets some other operation make progress or keeps our snapshot from getting
+    // too old.
+    if (opCtx->lockState()->hasLockWaiters() ||
+        _clockSource->now() - _lastYieldTime >=
+            Milliseconds(internalQueryExecYieldMaxSnapshotAgeMS.load())) {
+        return true;
+    }
+
+    // Notice interruption as promptly as yielding would have.
+    opCtx->checkForInterrupt();
+    return false;
 }
 
 void PlanYieldPolicy::resetTimer() {
     _elapsedTracker.resetLastTime();
+    _lastYieldTime = _clockSource->now();
 }
 
 bool PlanYieldPolicy::yield(RecordFetcher* fetcher) {
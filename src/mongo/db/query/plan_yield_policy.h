@@ -56,6 +56,11 @@ public:
      * Used by YIELD_AUTO plan executors in order to check whether it is time to yield.
      * PlanExecutors give up their locks periodically in order to be fair to other
      * threads.
+     *
+     * If internalQueryExecYieldOnlyWhenContended is set, a YIELD_AUTO executor whose yield period
+     * has elapsed only yields if some other operation is waiting for a lock, or if it has held its
+     * storage snapshot for internalQueryExecYieldMaxSnapshotAgeMS. Otherwise it just checks for
+     * interruption, which may throw, and carries on.
      */
     bool shouldYield();
 
@@ -94,11 +99,18 @@ public:
     }
 
 private:
+    PlanYieldPolicy(PlanExecutor::YieldPolicy policy, PlanExecutor* exec, ClockSource* cs);
+
     PlanExecutor::YieldPolicy _policy;
 
     bool _forceYield;
+    ClockSource* const _clockSource;
     ElapsedTracker _elapsedTracker;
 
+    // When the executor last yielded or was reattached to an operation, and so last started a new
+    // storage snapshot.
+    Date_t _lastYieldTime;
+
     // The plan executor which this yield policy is responsible for yielding. Must
     // not outlive the plan executor.
     PlanExecutor* const _planYielding;
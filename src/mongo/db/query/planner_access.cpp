@@ -45,6 +45,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
@@ -1283,6 +1284,79 @@ QuerySolutionNode* QueryPlannerAccess::scanWholeIndex(const IndexEntry& index,
     return solnRoot;
 }
 
+// static
+QuerySolutionNode* QueryPlannerAccess::makeSkipScan(const IndexEntry& index,
+                                                    const CanonicalQuery& query,
+                                                    const QueryPlannerParams& params) {
+    // Sparse and partial indexes may be missing documents which match the query.
+    if (INDEX_BTREE != index.type || index.sparse || index.filterExpr ||
+        index.keyPattern.nFields() < 2) {
+        return NULL;
+    }
+
+    std::vector<const MatchExpression*> preds;
+    const MatchExpression* root = query.root();
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            preds.push_back(root->getChild(i));
+        }
+    } else {
+        preds.push_back(root);
+    }
+
+    // Returns a predicate of the query which can generate bounds for 'keyElt', or NULL.
+    auto findPredicate = [&](const BSONElement& keyElt) -> const MatchExpression* {
+        for (const MatchExpression* pred : preds) {
+            if (Indexability::nodeCanUseIndexOnOwnField(pred) &&
+                pred->path() == keyElt.fieldNameStringData() &&
+                QueryPlannerIXSelect::compatible(
+                    keyElt, index, const_cast<MatchExpression*>(pred), query.getCollator())) {
+                return pred;
+            }
+        }
+        return NULL;
+    };
+
+    unique_ptr<IndexScanNode> isn = make_unique<IndexScanNode>(index);
+    isn->maxScan = query.getQueryRequest().getMaxScan();
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+    isn->bounds.fields.resize(index.keyPattern.nFields());
+
+    // Bound the first constrained field and leave every other field unbounded.
+    bool hasBoundedField = false;
+    BSONObjIterator it(index.keyPattern);
+    for (size_t pos = 0; it.more(); ++pos) {
+        BSONElement keyElt = it.next();
+        OrderedIntervalList* oil = &isn->bounds.fields[pos];
+        const MatchExpression* pred = hasBoundedField ? NULL : findPredicate(keyElt);
+        if (pred && 0 == pos) {
+            // Ordinary planning handles a constrained leading field.
+            return NULL;
+        }
+
+        if (pred) {
+            oil->name = keyElt.fieldName();
+            IndexBoundsBuilder::BoundsTightness tightness;
+            IndexBoundsBuilder::translate(pred, keyElt, index, oil, &tightness);
+            hasBoundedField = true;
+        } else {
+            IndexBoundsBuilder::allValuesForField(keyElt, oil);
+        }
+    }
+
+    if (!hasBoundedField) {
+        return NULL;
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    // Only one predicate contributes to the bounds, so the whole query is applied after fetching.
+    unique_ptr<FetchNode> fetch = make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch.release();
+}
+
 // static
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
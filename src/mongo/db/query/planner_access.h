@@ -197,6 +197,16 @@ public:
                                              const QueryPlannerParams& params,
                                              int direction = 1);
 
+    /**
+     * Return a plan that uses 'index' for a query which constrains some of its fields but not the
+     * leading one. The index scan is bounded on the first constrained field and seeks past each
+     * distinct value of the unconstrained prefix in turn, so it is cheap when the prefix has few
+     * distinct values. Returns NULL if 'index' cannot be used this way.
+     */
+    static QuerySolutionNode* makeSkipScan(const IndexEntry& index,
+                                           const CanonicalQuery& query,
+                                           const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
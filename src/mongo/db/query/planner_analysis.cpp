@@ -30,6 +30,7 @@
 
 #include "mongo/db/query/planner_analysis.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -121,9 +122,15 @@ bool structureOKForExplode(QuerySolutionNode* solnRoot, QuerySolutionNode** toRe
         }
     }
 
+    // Each branch of an OR is either an index scan or a fetch over one which applies the
+    // predicates the scan could not.
     if (STAGE_OR == solnRoot->getType()) {
         for (size_t i = 0; i < solnRoot->children.size(); ++i) {
-            if (STAGE_IXSCAN != solnRoot->children[i]->getType()) {
+            const QuerySolutionNode* child = solnRoot->children[i];
+            if (STAGE_FETCH == child->getType()) {
+                child = child->children[0];
+            }
+            if (STAGE_IXSCAN != child->getType()) {
                 return false;
             }
         }
@@ -134,6 +141,18 @@ bool structureOKForExplode(QuerySolutionNode* solnRoot, QuerySolutionNode** toRe
     return false;
 }
 
+/**
+ * Returns the index scan of a branch accepted by structureOKForExplode: either the branch
+ * itself or the child of a fetch.
+ */
+IndexScanNode* getBranchScan(QuerySolutionNode* branch) {
+    if (STAGE_FETCH == branch->getType()) {
+        branch = branch->children[0];
+    }
+    invariant(STAGE_IXSCAN == branch->getType());
+    return static_cast<IndexScanNode*>(branch);
+}
+
 // vectors of vectors can be > > annoying.
 typedef vector<Interval> PointPrefix;
 
@@ -205,6 +224,12 @@ void explodeScan(const IndexScanNode* isn,
                  const BSONObj& sort,
                  size_t fieldsToExplode,
                  vector<QuerySolutionNode*>* explosionResult) {
+    // A scan which already provides the sort is used as is.
+    if (0 == fieldsToExplode) {
+        explosionResult->push_back(isn->clone());
+        return;
+    }
+
     // Turn the compact bounds in 'isn' into a bunch of points...
     vector<PointPrefix> prefixForScans;
     makeCartesianProduct(isn->bounds, fieldsToExplode, &prefixForScans);
@@ -341,31 +366,37 @@ BSONObj QueryPlannerAnalysis::getSortPattern(const BSONObj& indexKeyPattern) {
 bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
                                           const QueryPlannerParams& params,
                                           QuerySolutionNode** solnRoot) {
-    vector<QuerySolutionNode*> leafNodes;
-
     QuerySolutionNode* toReplace;
     if (!structureOKForExplode(*solnRoot, &toReplace)) {
         return false;
     }
 
-    getLeafNodes(*solnRoot, &leafNodes);
+    // The subtrees which each have to provide the sort once exploded.
+    vector<QuerySolutionNode*> branches;
+    if (STAGE_OR == toReplace->getType()) {
+        branches = toReplace->children;
+    } else {
+        branches.push_back(toReplace);
+    }
 
     const BSONObj& desiredSort = query.getQueryRequest().getSort();
 
     // How many scan leaves will result from our expansion?
     size_t totalNumScans = 0;
 
-    // The value of entry i is how many scans we want to blow up for leafNodes[i].
+    // The value of entry i is how many fields we want to blow up for branches[i].
     // We calculate this in the loop below and might as well reuse it if we blow up
     // that scan.
     vector<size_t> fieldsToExplode;
 
+    // The scans which only provide the sort when run backwards. They are reversed once we know
+    // that every branch can provide the sort.
+    vector<IndexScanNode*> scansToReverse;
+
     // The sort order we're looking for has to possibly be provided by each of the index scans
     // upon explosion.
-    for (size_t i = 0; i < leafNodes.size(); ++i) {
-        // We can do this because structureOKForExplode is only true if the leaves are index
-        // scans.
-        IndexScanNode* isn = static_cast<IndexScanNode*>(leafNodes[i]);
+    for (size_t i = 0; i < branches.size(); ++i) {
+        IndexScanNode* isn = getBranchScan(branches[i]);
         const IndexBounds& bounds = isn->bounds;
 
         // Not a point interval prefix, can't try to rewrite.
@@ -396,10 +427,8 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
             return false;
         }
 
-        // Only explode if there's at least one field to explode for this scan.
-        if (0 == boundsIdx) {
-            return false;
-        }
+        // A scan with no point prefix is not exploded. It can still be merged with the
+        // others if its key pattern provides the sort by itself.
 
         // The rest of the fields define the sort order we could obtain by exploding
         // the bounds.
@@ -420,7 +449,7 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
                 return false;
             } else {
                 // We can get the sort order we need if we reverse the scan.
-                QueryPlannerCommon::reverseScans(isn);
+                scansToReverse.push_back(isn);
             }
         }
 
@@ -431,6 +460,13 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
         fieldsToExplode.push_back(boundsIdx);
     }
 
+    // Nothing is gained unless at least one scan gets exploded.
+    if (std::all_of(fieldsToExplode.begin(), fieldsToExplode.end(), [](size_t numFields) {
+            return 0 == numFields;
+        })) {
+        return false;
+    }
+
     // Too many ixscans spoil the performance.
     if (totalNumScans > (size_t)internalQueryMaxScansToExplode.load()) {
         LOG(5) << "Could expand ixscans to pull out sort order but resulting scan count"
@@ -438,13 +474,34 @@ bool QueryPlannerAnalysis::explodeForSort(const CanonicalQuery& query,
         return false;
     }
 
+    for (auto&& isn : scansToReverse) {
+        QueryPlannerCommon::reverseScans(isn);
+    }
+
     // If we're here, we can (probably?  depends on how restrictive the structure check is)
     // get our sort order via ixscan blow-up.
     MergeSortNode* merge = new MergeSortNode();
     merge->sort = desiredSort;
-    for (size_t i = 0; i < leafNodes.size(); ++i) {
-        IndexScanNode* isn = static_cast<IndexScanNode*>(leafNodes[i]);
-        explodeScan(isn, desiredSort, fieldsToExplode[i], &merge->children);
+    for (size_t i = 0; i < branches.size(); ++i) {
+        QuerySolutionNode* branch = branches[i];
+        IndexScanNode* isn = getBranchScan(branch);
+        if (STAGE_FETCH != branch->getType()) {
+            explodeScan(isn, desiredSort, fieldsToExplode[i], &merge->children);
+            continue;
+        }
+
+        // Every scan exploded from a fetched branch gets its own copy of the fetch, so that the
+        // branch's residual predicate still applies to exactly the documents it came from.
+        vector<QuerySolutionNode*> explodedScans;
+        explodeScan(isn, desiredSort, fieldsToExplode[i], &explodedScans);
+        for (auto&& scan : explodedScans) {
+            FetchNode* fetch = new FetchNode();
+            if (branch->filter) {
+                fetch->filter = branch->filter->shallowClone();
+            }
+            fetch->children.push_back(scan);
+            merge->children.push_back(fetch);
+        }
     }
 
     merge->computeProperties();
@@ -522,6 +579,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         solnRoot = fetch;
     }
 
+    // A top-k sort on the text score alone, directly over the text node, lets the text node return
+    // only the k best scoring documents.
+    TextNode* textNode = nullptr;
+    if (STAGE_TEXT == solnRoot->getType() && 1 == sortObj.nFields() &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        textNode = static_cast<TextNode*>(solnRoot);
+    }
+
     // And build the full sort stage. The sort stage has to have a sort key generating stage
     // as its child, supplying it with the appropriate sort keys.
     SortKeyGeneratorNode* keyGenNode = new SortKeyGeneratorNode();
@@ -599,6 +664,10 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    if (textNode) {
+        textNode->limit = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
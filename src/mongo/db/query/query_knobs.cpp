@@ -27,6 +27,8 @@
  */
 
 #include "mongo/db/query/query_knobs.h"
+
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
 
@@ -38,6 +40,10 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationCollFraction, double, 0
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxResults, int, 101);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxCandidates, int, 0);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheEstimatedCostRatio, double, 4.0);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSize, int, 5000);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheFeedbacksStored, int, 20);
@@ -56,22 +62,69 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableIndexIntersection, bool,
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableHashIntersection, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableSkipScan, bool, false);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanOrChildrenIndependently, bool, true);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxScansToExplode, int, 200);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxCountScanRanges, int, 200);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxBlockingSortBytes, int, 32 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxBatchBytes, int, BSONObjMaxUserSize);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryFirstBatchTargetBytes, int, 0);
+
 // Yield every 128 cycles or 10ms.
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldIterations, int, 128);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldPeriodMS, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldOnlyWhenContended, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldMaxSnapshotAgeMS, int, 1000);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxWorksPerBatch, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecFetchBatchSize, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecEnableIdPointReads, bool, true);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetBufferSizeBytes, int, 100 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceFacetMaxThreads, int, 1);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxBatchSize,
                               int,
                               internalQueryExecYieldIterations.load() / 2);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxParallelism, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalUpdateBatchIdUpserts, bool, true);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorBatchSizeBytes, int, 4 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSampleBlockSize, int, 0);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupPartitions, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupEnableHashJoin, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupMaxMemoryBytes, int, 100 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupForeignKeyFilterBytes,
+                              int,
+                              16 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupCacheMaxMemoryBytes,
+                              int,
+                              16 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGraphLookupFrontierQueryMaxBytes,
+                              int,
+                              4 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalSorterNumThreads, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryShapeStatsMaxEntries, int, 1000);
+
 }  // namespace mongo
@@ -48,6 +48,14 @@ extern AtomicDouble internalQueryPlanEvaluationCollFraction;
 // Stop working plans once a plan returns this many results.
 extern AtomicInt32 internalQueryPlanEvaluationMaxResults;
 
+// The most candidate plans to work before comparing them. When there are more, only those with the
+// lowest estimated cost are worked. A value of 0 works every candidate.
+extern AtomicInt32 internalQueryPlanEvaluationMaxCandidates;
+
+// A cached plan is replanned without a trial period if its estimated cost for a query is at least
+// this many times its estimated cost for the query it was cached for. A value of 0 disables this.
+extern AtomicDouble internalQueryCacheEstimatedCostRatio;
+
 // Do we give a big ranking bonus to intersection plans?
 extern AtomicBool internalQueryForceIntersectionPlans;
 
@@ -57,6 +65,10 @@ extern AtomicBool internalQueryPlannerEnableIndexIntersection;
 // Do we use hash-based intersection for rooted $and queries?
 extern AtomicBool internalQueryPlannerEnableHashIntersection;
 
+// Do we consider skipping through compound indexes whose leading field is unconstrained when no
+// other index applies?
+extern AtomicBool internalQueryPlannerEnableSkipScan;
+
 //
 // plan cache
 //
@@ -92,26 +104,106 @@ extern AtomicBool internalQueryPlanOrChildrenIndependently;
 // during explodeForSort?
 extern AtomicInt32 internalQueryMaxScansToExplode;
 
+// The most disjoint ranges of keys, such as one per value of an $in, that a fast count will scan.
+// Bounds with more ranges are counted by an index scan instead.
+extern AtomicInt32 internalQueryMaxCountScanRanges;
+
 //
 // Query execution.
 //
 
 extern AtomicInt32 internalQueryExecMaxBlockingSortBytes;
 
+// The most bytes of documents in a find or getMore batch. Capped at 16MB.
+extern AtomicInt32 internalQueryMaxBatchBytes;
+
+// If positive, a first batch without a batchSize ends once it holds this many bytes of documents
+// rather than after 101 documents, so the number of documents follows their size.
+extern AtomicInt32 internalQueryFirstBatchTargetBytes;
+
 // Yield after this many "should yield?" checks.
 extern AtomicInt32 internalQueryExecYieldIterations;
 
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// Whether a plan executor whose yield period has elapsed only yields if another operation is
+// waiting for a lock or a global lock ticket, or if it has not yielded for
+// internalQueryExecYieldMaxSnapshotAgeMS.
+extern AtomicBool internalQueryExecYieldOnlyWhenContended;
+extern AtomicInt32 internalQueryExecYieldMaxSnapshotAgeMS;
+
+// The most units of work a PlanExecutor asks of its plan at once. Values of 1 or less work the
+// plan one unit at a time.
+extern AtomicInt32 internalQueryExecMaxWorksPerBatch;
+
+// The number of index scan results a FETCH stage collects before looking up their documents
+// together, in RecordId order. Values of 1 or less fetch each document as soon as it arrives.
+// Only takes effect on storage engines with document-level locking.
+extern AtomicInt32 internalQueryExecFetchBatchSize;
+
+// Whether find commands which read a single document by _id look it up in the _id index directly,
+// without building a CanonicalQuery or a PlanExecutor.
+extern AtomicBool internalQueryExecEnableIdPointReads;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
 // The number of bytes to buffer at once during a $facet stage.
 extern AtomicInt32 internalQueryFacetBufferSizeBytes;
 
+// The number of threads among which a $facet stage may run its sub-pipelines over each buffered
+// batch. A value of 1 runs them all in turn on the thread running the pipeline.
+extern AtomicInt32 internalDocumentSourceFacetMaxThreads;
+
 extern AtomicInt32 internalInsertMaxBatchSize;
 
+// The number of threads, counting the one serving the request, among which the documents of a
+// large unordered insert may be split. A value of 1 inserts them all on the request's thread.
+extern AtomicInt32 internalInsertMaxParallelism;
+
+// Whether runs of upserts by _id in an update batch look their _ids up together, and insert the
+// documents of those which match nothing in batches like an insert would.
+extern AtomicBool internalUpdateBatchIdUpserts;
+
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
+// The number of consecutive records a $sample larger than a random cursor can serve reads from
+// each random starting record, when the storage engine supports such block sampling. A value of 0
+// disables block sampling, falling back to a collection scan and a random sort.
+extern AtomicInt32 internalDocumentSourceSampleBlockSize;
+
+// The number of hash partitions, and so of worker threads, an unsorted $group divides its groups
+// between. A value of 1 accumulates every group on the thread running the pipeline.
+extern AtomicInt32 internalDocumentSourceGroupPartitions;
+
+// Whether $lookup may read the foreign collection once into a hash table, rather than querying it
+// once for every input document.
+extern AtomicBool internalDocumentSourceLookupEnableHashJoin;
+
+// The most memory a $lookup hash table may use before the stage falls back to querying the
+// foreign collection for every input document.
+extern AtomicInt32 internalDocumentSourceLookupMaxMemoryBytes;
+
+// The size of the Bloom filter of foreign join keys a $lookup builds after abandoning its hash
+// table, used to skip querying the foreign collection for input documents that cannot match. A
+// value of 0 disables the filter.
+extern AtomicInt32 internalDocumentSourceLookupForeignKeyFilterBytes;
+
+// The most memory a $lookup may use to cache the foreign documents matching each local value it
+// has queried for, so that repeated values need no further query. A value of 0 disables the cache.
+extern AtomicInt32 internalDocumentSourceLookupCacheMaxMemoryBytes;
+
+// The most bytes of frontier values a $graphLookup puts in the $in of a single query against the
+// 'from' collection. Larger frontiers are expanded with several queries.
+extern AtomicInt32 internalDocumentSourceGraphLookupFrontierQueryMaxBytes;
+
+// The number of threads an external sort without a limit may use to sort and spill its data. A
+// value of 1 sorts only on the calling thread.
+extern AtomicInt32 internalSorterNumThreads;
+
+// How many query shapes the per-query-shape execution statistics keep, forgetting the least
+// recently run shape beyond that. A value of 0 stops collecting the statistics.
+extern AtomicInt32 internalQueryShapeStatsMaxEntries;
+
 }  // namespace mongo
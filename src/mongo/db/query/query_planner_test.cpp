@@ -1915,6 +1915,70 @@ TEST_F(QueryPlannerTest, ExplodeOrForSort2) {
         "pattern: {d:1, c:1}}}]}}}}");
 }
 
+// Exploding an $or whose clause needs a fetch to apply a predicate the index can't answer. Each
+// exploded scan gets its own copy of the fetch.
+TEST_F(QueryPlannerTest, ExplodeOrWithFetchedClauseForSort) {
+    addIndex(BSON("a" << 1 << "c" << 1));
+    addIndex(BSON("b" << 1 << "c" << 1));
+
+    runQuerySortProj(
+        fromjson("{$or: [{a: {$in: [1, 2]}, x: 1}, {b: 2}]}"), BSON("c" << 1), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: "
+        "{cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {mergeSort: {nodes: "
+        "[{fetch: {filter: {x: 1}, node: {ixscan: {bounds: {a: [[1,1,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}, pattern: {a:1, c:1}}}}},"
+        "{fetch: {filter: {x: 1}, node: {ixscan: {bounds: {a: [[2,2,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}, pattern: {a:1, c:1}}}}},"
+        "{ixscan: {bounds: {b: [[2,2,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}, pattern: {b:1, c:1}}}]}}}}");
+}
+
+// An $or clause whose scan is already in sort order is merged with the exploded scans of the
+// other clauses.
+TEST_F(QueryPlannerTest, ExplodeOrForSortWithClauseAlreadySorted) {
+    addIndex(BSON("a" << 1 << "c" << 1));
+    addIndex(BSON("c" << 1));
+
+    runQuerySortProj(
+        fromjson("{$or: [{a: {$in: [1, 2]}}, {c: {$gt: 5}}]}"), BSON("c" << 1), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: "
+        "{cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{fetch: {node: {mergeSort: {nodes: "
+        "[{ixscan: {bounds: {a: [[1,1,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}, pattern: {a:1, c:1}}},"
+        "{ixscan: {bounds: {a: [[2,2,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}, pattern: {a:1, c:1}}},"
+        "{ixscan: {bounds: {c: [[5,Infinity,false,true]]}, pattern: {c:1}}}]}}}}");
+}
+
+// The sorted clause must not be reversed unless the other clauses can provide the sort too.
+TEST_F(QueryPlannerTest, CantExplodeOrForSortWithClauseAlreadySortedDescending) {
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+    addIndex(BSON("c" << -1));
+
+    runQuerySortProj(
+        fromjson("{$or: [{c: {$gt: 5}}, {a: {$in: [1, 2]}}]}"), BSON("c" << 1), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: "
+        "{cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: "
+        "{fetch: {filter: null, node: {or: {nodes: ["
+        "{ixscan: {pattern: {c: -1}, dir: 1}},"
+        "{ixscan: {pattern: {a: 1, b: 1, c: 1}}}]}}}}}}}}");
+}
+
 // SERVER-13754: an $or that can't be exploded, because one clause of the
 // $or does provide the sort, even after explosion.
 TEST_F(QueryPlannerTest, CantExplodeOrForSort) {
@@ -5269,4 +5333,78 @@ TEST_F(QueryPlannerTest, ContainedOrPathLevelMultikeyCannotCompoundTrailingField
     assertSolutionExists("{cscan: {dir: 1}}}}");
 }
 
+//
+// Skip scans
+//
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedByDefault) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedPrefix) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << -1 << "c" << 1));
+
+    runQuery(fromjson("{b: {$gt: 5}, c: 1}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$gt: 5}, c: 1}, node: {ixscan: {pattern: {a: 1, b: -1, c: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[Infinity,5,true,false]], "
+        "c: [['MinKey','MaxKey',true,true]]}}}}}");
+    assertSolutionExists("{cscan: {dir: 1}}");
+
+    internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsOnlySolutionWithoutTableScan) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    internalQueryPlannerEnableSkipScan.store(true);
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+
+    internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedWhenAnotherIndexApplies) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << 1));
+    addIndex(BSON("c" << 1));
+
+    runQuery(fromjson("{b: 5, c: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {c: 1}, "
+        "bounds: {c: [[1,1,true,true]]}}}}}");
+
+    internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedWithSparseIndex) {
+    bool oldEnableSkipScan = internalQueryPlannerEnableSkipScan.load();
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << 1), false /* multikey */, true /* sparse */);
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+
+    internalQueryPlannerEnableSkipScan.store(oldEnableSkipScan);
+}
+
 }  // namespace
@@ -367,7 +367,7 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
 
         return true;
     } else if (STAGE_TEXT == trueSoln->getType()) {
-        // {text: {search: "somestr", language: "something", filter: {blah: 1}}}
+        // {text: {search: "somestr", language: "something", limit: 5, filter: {blah: 1}}}
         const TextNode* node = static_cast<const TextNode*>(trueSoln);
         BSONElement el = testSoln["text"];
         if (el.eoo() || !el.isABSONObj()) {
@@ -414,6 +414,14 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement limitElt = textObj["limit"];
+        if (!limitElt.eoo()) {
+            if (!limitElt.isNumber() ||
+                limitElt.numberLong() != static_cast<long long>(node->limit)) {
+                return false;
+            }
+        }
+
         BSONObj collation;
         if (BSONElement collationElt = textObj["collation"]) {
             if (!collationElt.isABSONObj()) {
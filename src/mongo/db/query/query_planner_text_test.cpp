@@ -472,4 +472,42 @@ TEST_F(QueryPlannerTest, SortKeyMetaProjectionWithTextScoreMetaSort) {
         "{sortKeyGen: {node: {text: {search: 'foo'}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, TextScoreSortWithLimitIsPushedToText) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQuerySortProjSkipNToReturn(fromjson("{$text: {$search: 'foo'}}"),
+                                  fromjson("{a: {$meta: 'textScore'}}"),
+                                  fromjson("{a: {$meta: 'textScore'}}"),
+                                  2,
+                                  3);
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{skip: {n: 2, node: {proj: {spec: {a: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 5, pattern: {a: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', limit: 5}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CompoundTextScoreSortWithLimitIsNotPushedToText) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQuerySortProjSkipNToReturn(fromjson("{$text: {$search: 'foo'}}"),
+                                  fromjson("{a: {$meta: 'textScore'}, b: 1}"),
+                                  fromjson("{a: {$meta: 'textScore'}}"),
+                                  0,
+                                  3);
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 3, pattern: {a: {$meta: 'textScore'}, b: 1}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', limit: 0}}}}}}}}");
+}
+
 }  // namespace
@@ -370,6 +370,17 @@ public:
         _allowPartialResults = allowPartialResults;
     }
 
+    /**
+     * Whether a blocking sort may write temporary files once it exceeds its memory limit.
+     */
+    bool allowDiskUse() const {
+        return _allowDiskUse;
+    }
+
+    void setAllowDiskUse(bool allowDiskUse) {
+        _allowDiskUse = allowDiskUse;
+    }
+
     boost::optional<long long> getReplicationTerm() const {
         return _replicationTerm;
     }
@@ -492,6 +503,8 @@ private:
     bool _exhaust = false;
     bool _allowPartialResults = false;
 
+    bool _allowDiskUse = false;
+
     boost::optional<long long> _replicationTerm;
 };
 
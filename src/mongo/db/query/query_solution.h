@@ -254,6 +254,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, only the 'limit' highest scoring results are needed, because the text node is
+    // directly below a top-k sort on the text score.
+    size_t limit = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -938,6 +942,8 @@ struct CountScanNode : public QuerySolutionNode {
 
     BSONObj endKey;
     bool endKeyInclusive;
+
+    std::vector<IndexKeyRange> additionalRanges;
 };
 
 /**
@@ -33,6 +33,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/time_support.h"
@@ -68,6 +69,9 @@ void QueryYield::yieldAllLocks(OperationContext* opCtx,
         return;
     }
 
+    // The time from releasing the locks up to having reacquired them is reported as a yield.
+    WaitEventScope yieldScope(WaitEvent::kYield);
+
     // Top-level locks are freed, release any potential low-level (storage engine-specific
     // locks). If we are yielding, we are at a safe place to do so.
     opCtx->recoveryUnit()->abandonSnapshot();
@@ -86,6 +90,7 @@ void QueryYield::yieldAllLocks(OperationContext* opCtx,
     CurOp::get(opCtx)->yielded();
 
     if (fetcher) {
+        WaitEventScope fetchScope(WaitEvent::kFetch);
         fetcher->fetch();
     }
 
@@ -57,6 +57,7 @@
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -79,6 +80,7 @@ PlanStage* buildStages(OperationContext* opCtx,
         params.direction =
             (csn->direction == 1) ? CollectionScanParams::FORWARD : CollectionScanParams::BACKWARD;
         params.maxScan = csn->maxScan;
+        params.readAhead = true;
         return new CollectionScan(opCtx, params, ws, csn->filter.get());
     } else if (STAGE_IXSCAN == root->getType()) {
         const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
@@ -115,6 +117,8 @@ PlanStage* buildStages(OperationContext* opCtx,
         params.collection = collection;
         params.pattern = sn->pattern;
         params.limit = sn->limit;
+        params.allowDiskUse = cq.getQueryRequest().allowDiskUse();
+        params.tempDir = storageGlobalParams.dbpath + "/_tmp";
         return new SortStage(opCtx, params, ws, childStage);
     } else if (STAGE_SORT_KEY_GENERATOR == root->getType()) {
         const SortKeyGeneratorNode* keyGenNode = static_cast<const SortKeyGeneratorNode*>(root);
@@ -261,6 +265,7 @@ PlanStage* buildStages(OperationContext* opCtx,
         // planning a query that contains "no-op" expressions. TODO: make StageBuilder::build()
         // fail in this case (this improvement is being tracked by SERVER-21510).
         params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
+        params.limit = node->limit;
         return new TextStage(opCtx, params, ws, node->filter.get());
     } else if (STAGE_SHARDING_FILTER == root->getType()) {
         const ShardingFilterNode* fn = static_cast<const ShardingFilterNode*>(root);
@@ -312,6 +317,7 @@ PlanStage* buildStages(OperationContext* opCtx,
         params.startKeyInclusive = csn->startKeyInclusive;
         params.endKey = csn->endKey;
         params.endKeyInclusive = csn->endKeyInclusive;
+        params.additionalRanges = csn->additionalRanges;
 
         return new CountScan(opCtx, params, ws);
     } else if (STAGE_ENSURE_SORTED == root->getType()) {
@@ -58,9 +58,15 @@ ExportedServerParameter<bool, ServerParameterType::kStartupOnly> TestingSnapshot
     "testingSnapshotBehaviorInIsolation",
     &testingSnapshotBehaviorInIsolation);
 
+// When enabled, reads with local read concern on a secondary are served from the snapshot taken
+// after the last applied batch, so that they do not wait on the PBWM lock for the current batch.
+MONGO_EXPORT_SERVER_PARAMETER(readFromLocalSnapshotOnSecondaries, bool, false);
+
 }  // namespace
 
-Status waitForReadConcern(OperationContext* opCtx, const repl::ReadConcernArgs& readConcernArgs) {
+Status waitForReadConcern(OperationContext* opCtx,
+                          const repl::ReadConcernArgs& readConcernArgs,
+                          bool allowLocalSnapshotReads) {
     repl::ReplicationCoordinator* const replCoord = repl::ReplicationCoordinator::get(opCtx);
 
     if (readConcernArgs.getLevel() == repl::ReadConcernLevel::kLinearizableReadConcern) {
@@ -128,6 +134,21 @@ Status waitForReadConcern(OperationContext* opCtx, const repl::ReadConcernArgs&
         LOG(debugLevel) << "Using 'committed' snapshot: " << CurOp::get(opCtx)->query();
     }
 
+    // Reads that wait for an optime must see the data at that optime, which may not be in a
+    // snapshot yet.
+    if (allowLocalSnapshotReads && readFromLocalSnapshotOnSecondaries.load() &&
+        readConcernArgs.getLevel() == repl::ReadConcernLevel::kLocalReadConcern &&
+        !readConcernArgs.getArgsOpTime() &&
+        replCoord->getReplicationMode() == repl::ReplicationCoordinator::Mode::modeReplSet &&
+        replCoord->getMemberState().secondary()) {
+        // Batches are only applied while holding the PBWM lock in MODE_X, and snapshots are only
+        // taken between batches, so a read from the local snapshot never observes a partially
+        // applied batch and does not need to conflict with batch application.
+        if (opCtx->recoveryUnit()->setReadFromLocalSnapshot().isOK()) {
+            opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+        }
+    }
+
     return Status::OK();
 }
 
@@ -44,8 +44,14 @@ class ReadConcernArgs;
  * Given the specified read concern arguments, performs checks that the read concern can actually be
  * satisfied given the current state of the server and if so calls into the replication subsystem to
  * perform the wait.
+ *
+ * If 'allowLocalSnapshotReads' is true, local read concern reads on a secondary may be served from
+ * the snapshot taken after the last batch of oplog application, rather than waiting for the
+ * current batch to finish.
  */
-Status waitForReadConcern(OperationContext* opCtx, const repl::ReadConcernArgs& readConcernArgs);
+Status waitForReadConcern(OperationContext* opCtx,
+                          const repl::ReadConcernArgs& readConcernArgs,
+                          bool allowLocalSnapshotReads);
 
 /*
  * Given a linearizable read command, confirm that
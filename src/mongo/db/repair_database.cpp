@@ -44,11 +44,13 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_create.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/client.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/mmap_v1/mmap_v1_engine.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/util/log.h"
+#include "mongo/util/progress_meter.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -156,6 +158,10 @@ Status rebuildIndexesOnCollection(OperationContext* opCtx,
         wuow.commit();
     }
 
+    // Nothing else uses the collection during a repair, so the index keys of its records can be
+    // generated while it is being scanned.
+    indexer->generateKeysInParallel();
+
     // Iterate all records in the collection. Delete them if they aren't valid BSON. Index them
     // if they are.
 
@@ -163,6 +169,11 @@ Status rebuildIndexesOnCollection(OperationContext* opCtx,
     long long dataSize = 0;
 
     RecordStore* rs = collection->getRecordStore();
+    stdx::unique_lock<Client> lk(*opCtx->getClient());
+    ProgressMeterHolder progress(*opCtx->setMessage_inlock(
+        "repairDatabase: rebuilding indexes", "Repair Progress", rs->numRecords(opCtx)));
+    lk.unlock();
+
     auto cursor = rs->getCursor(opCtx);
     while (auto record = cursor->next()) {
         RecordId id = record->id;
@@ -193,8 +204,12 @@ Status rebuildIndexesOnCollection(OperationContext* opCtx,
         if (!status.isOK())
             return status;
         wunit.commit();
+
+        progress->hit();
     }
 
+    progress->finished();
+
     Status status = indexer->doneInserting();
     if (!status.isOK())
         return status;
@@ -519,19 +519,30 @@ bool BackgroundSync::peek(OperationContext* opCtx, BSONObj* op) {
     return _oplogBuffer->peek(opCtx, op);
 }
 
+std::size_t BackgroundSync::peekBatch(OperationContext* opCtx,
+                                      std::size_t maxCount,
+                                      OplogBuffer::Batch* ops) {
+    return _oplogBuffer->peekBatch(opCtx, maxCount, ops);
+}
+
 void BackgroundSync::waitForMore() {
     // Block for one second before timing out.
     _oplogBuffer->waitForData(Seconds(1));
 }
 
-void BackgroundSync::consume(OperationContext* opCtx) {
-    // this is just to get the op off the queue, it's been peeked at
+void BackgroundSync::consume(OperationContext* opCtx, std::size_t count) {
+    // this is just to get the ops off the queue, they've been peeked at
     // and queued for application already
-    BSONObj op;
-    if (_oplogBuffer->tryPop(opCtx, &op)) {
-        bufferCountGauge.decrement(1);
-        bufferSizeGauge.decrement(getSize(op));
-    } else {
+    OplogBuffer::Batch ops;
+    const auto numPopped = _oplogBuffer->tryPopBatch(opCtx, count, &ops);
+    std::size_t bytesPopped = 0;
+    for (const auto& op : ops) {
+        bytesPopped += getSize(op);
+    }
+    bufferCountGauge.decrement(numPopped);
+    bufferSizeGauge.decrement(bytesPopped);
+
+    if (numPopped < count) {
         invariant(inShutdown());
         // This means that shutdown() was called between the consumer's calls to peek() and
         // consume(). shutdown() cleared the buffer so there is nothing for us to consume here.
@@ -112,7 +112,8 @@ public:
     // Interface implementation
 
     bool peek(OperationContext* opCtx, BSONObj* op);
-    void consume(OperationContext* opCtx);
+    std::size_t peekBatch(OperationContext* opCtx, std::size_t maxCount, OplogBuffer::Batch* ops);
+    void consume(OperationContext* opCtx, std::size_t count);
     void clearSyncTarget();
     void waitForMore();
 
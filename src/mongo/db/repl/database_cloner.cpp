@@ -64,6 +64,9 @@ const char* kUUIDFieldName = "uuid";
 // The number of attempts for the listCollections commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListCollectionsAttempts, int, 3);
 
+// The number of collections of a database, which are cloned at the same time.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncConcurrentCollectionCloners, int, 1);
+
 /**
  * Default listCollections predicate.
  */
@@ -121,6 +124,8 @@ DatabaseCloner::DatabaseCloner(executor::TaskExecutor* executor,
                                   numInitialSyncListCollectionsAttempts.load(),
                                   executor::RemoteCommandRequest::kNoTimeout,
                                   RemoteCommandRetryScheduler::kAllRetriableErrors)),
+      _maxConcurrentCollectionCloners(
+          std::max(1, numInitialSyncConcurrentCollectionCloners.load())),
       _startCollectionCloner([](CollectionCloner& cloner) { return cloner.startup(); }) {
     // Fetcher throws an exception on null executor.
     invariant(executor);
@@ -245,6 +250,14 @@ void DatabaseCloner::setStartCollectionClonerFn(
     _startCollectionCloner = startCollectionCloner;
 }
 
+void DatabaseCloner::setMaxConcurrentCollectionCloners_forTest(
+    size_t maxConcurrentCollectionCloners) {
+    LockGuard lk(_mutex);
+
+    invariant(maxConcurrentCollectionCloners > 0);
+    _maxConcurrentCollectionCloners = maxConcurrentCollectionCloners;
+}
+
 DatabaseCloner::State DatabaseCloner::getState_forTest() const {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     return _state;
@@ -390,20 +403,36 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
-    _currentCollectionClonerIter = _collectionCloners.begin();
-
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
+    // Start the first collection cloners.
+    _nextCollectionClonerIter = _collectionCloners.begin();
+    _startCollectionCloners_inlock();
 
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
-        _finishCallback_inlock(lk, startStatus);
+    if (_numActiveCollectionCloners == 0) {
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
         return;
     }
 }
 
+void DatabaseCloner::_startCollectionCloners_inlock() {
+    while (_startCollectionClonerStatus.isOK() &&
+           _numActiveCollectionCloners < _maxConcurrentCollectionCloners &&
+           _nextCollectionClonerIter != _collectionCloners.end()) {
+        auto& collectionCloner = *_nextCollectionClonerIter++;
+
+        LOG(1) << "    cloning collection " << collectionCloner.getSourceNamespace();
+
+        Status startStatus = _startCollectionCloner(collectionCloner);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on "
+                   << collectionCloner.getSourceNamespace() << ": " << redact(startStatus);
+            _startCollectionClonerStatus = startStatus;
+            return;
+        }
+
+        ++_numActiveCollectionCloners;
+    }
+}
+
 void DatabaseCloner::_collectionClonerCallback(const Status& status, const NamespaceString& nss) {
     auto newStatus = status;
 
@@ -424,17 +453,17 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     lk.unlock();
     _collectionWork(newStatus, nss);
     lk.lock();
-    _currentCollectionClonerIter++;
+    --_numActiveCollectionCloners;
 
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
-        }
+    _startCollectionCloners_inlock();
+
+    // The database cloner completes once the last active collection cloner does.
+    if (_numActiveCollectionCloners > 0) {
+        return;
+    }
+
+    if (!_startCollectionClonerStatus.isOK()) {
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
         return;
     }
 
@@ -162,6 +162,14 @@ public:
      */
     void setStartCollectionClonerFn(const StartCollectionClonerFn& startCollectionCloner);
 
+    /**
+     * Overrides how many collection cloners may run at the same time, which otherwise comes from
+     * the numInitialSyncConcurrentCollectionCloners server parameter.
+     *
+     * For testing only.
+     */
+    void setMaxConcurrentCollectionCloners_forTest(size_t maxConcurrentCollectionCloners);
+
     // State transitions:
     // PreStart --> Running --> ShuttingDown --> Complete
     // It is possible to skip intermediate states. For example,
@@ -186,6 +194,12 @@ private:
                                   Fetcher::NextAction* nextAction,
                                   BSONObjBuilder* getMoreBob);
 
+    /**
+     * Starts collection cloners in listCollections order until as many as allowed are active.
+     * Stops starting new cloners once one of them failed to start.
+     */
+    void _startCollectionCloners_inlock();
+
     /**
      * Forwards collection cloner result to client.
      * Starts a new cloner on a different collection.
@@ -237,7 +251,10 @@ private:
     std::vector<BSONObj> _collectionInfos;                               // (M)
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
-    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    std::list<CollectionCloner>::iterator _nextCollectionClonerIter;     // (M)
+    size_t _numActiveCollectionCloners = 0;                              // (M)
+    size_t _maxConcurrentCollectionCloners;                              // (M)
+    Status _startCollectionClonerStatus = Status::OK();                  // (M)
     std::vector<std::pair<Status, NamespaceString>> _failedNamespaces;   // (M)
     CollectionCloner::ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
@@ -751,6 +751,51 @@ TEST_F(DatabaseClonerTest, ShutdownCancelsCollectionCloning) {
     ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, getStatus());
 }
 
+TEST_F(DatabaseClonerTest, StartsUpToMaxConcurrentCollectionCloners) {
+    _databaseCloner->setMaxConcurrentCollectionCloners_forTest(2U);
+
+    ASSERT_OK(_databaseCloner->startup());
+
+    auto net = getNet();
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+
+        assertRemoteCommandNameEquals("listCollections",
+                                      net->scheduleSuccessfulResponse(createListCollectionsResponse(
+                                          0,
+                                          BSON_ARRAY(BSON("name"
+                                                          << "a"
+                                                          << "options"
+                                                          << BSONObj())
+                                                     << BSON("name"
+                                                             << "b"
+                                                             << "options"
+                                                             << BSONObj())
+                                                     << BSON("name"
+                                                             << "c"
+                                                             << "options"
+                                                             << BSONObj())))));
+        net->runReadyNetworkOperations();
+
+        // The first two collection cloners both send their count request right away, while the
+        // third one waits for either of them to complete.
+        for (auto collName : {"a", "b"}) {
+            auto noi = net->getNextReadyRequest();
+            assertRemoteCommandNameEquals("count", noi->getRequest());
+            ASSERT_EQUALS(collName, noi->getRequest().cmdObj.firstElement().String());
+            net->blackHole(noi);
+        }
+        ASSERT_FALSE(net->hasReadyRequests());
+    }
+
+    _databaseCloner->shutdown();
+    executor::NetworkInterfaceMock::InNetworkGuard(net)->runReadyNetworkOperations();
+
+    _databaseCloner->join();
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, getStatus());
+}
+
 TEST_F(DatabaseClonerTest, FirstCollectionListIndexesFailed) {
     ASSERT_EQUALS(DatabaseCloner::State::kPreStart, _databaseCloner->getState_forTest());
 
@@ -143,6 +143,14 @@ public:
      */
     virtual bool tryPop(OperationContext* opCtx, Value* value) = 0;
 
+    /**
+     * Removes up to "maxCount" items from the front of the oplog buffer and appends them to
+     * "values", oldest first. Returns the number of items removed.
+     */
+    virtual std::size_t tryPopBatch(OperationContext* opCtx,
+                                    std::size_t maxCount,
+                                    Batch* values) = 0;
+
     /**
      * Waits "waitDuration" for an operation to be pushed into the oplog buffer.
      * Returns false if oplog buffer is still empty after "waitDuration".
@@ -156,6 +164,15 @@ public:
      */
     virtual bool peek(OperationContext* opCtx, Value* value) = 0;
 
+    /**
+     * Appends up to "maxCount" items from the front of the oplog buffer to "values", oldest first,
+     * without removing them. Returns the number of items appended, which is only 0 if the oplog
+     * buffer is empty. Implementations may return fewer items than are buffered.
+     */
+    virtual std::size_t peekBatch(OperationContext* opCtx,
+                                  std::size_t maxCount,
+                                  Batch* values) = 0;
+
     /**
      * Returns the item most recently added to the oplog buffer or nothing if the buffer is empty.
      */
@@ -95,6 +95,12 @@ bool OplogBufferBlockingQueue::tryPop(OperationContext*, Value* value) {
     return _queue.tryPop(*value);
 }
 
+std::size_t OplogBufferBlockingQueue::tryPopBatch(OperationContext*,
+                                                  std::size_t maxCount,
+                                                  Batch* values) {
+    return _queue.tryPopUpTo(maxCount, values);
+}
+
 bool OplogBufferBlockingQueue::waitForData(Seconds waitDuration) {
     Value ignored;
     return _queue.blockingPeek(ignored, static_cast<int>(durationCount<Seconds>(waitDuration)));
@@ -104,6 +110,12 @@ bool OplogBufferBlockingQueue::peek(OperationContext*, Value* value) {
     return _queue.peek(*value);
 }
 
+std::size_t OplogBufferBlockingQueue::peekBatch(OperationContext*,
+                                                std::size_t maxCount,
+                                                Batch* values) {
+    return _queue.peekUpTo(maxCount, values);
+}
+
 boost::optional<OplogBuffer::Value> OplogBufferBlockingQueue::lastObjectPushed(
     OperationContext*) const {
     return _queue.lastObjectPushed();
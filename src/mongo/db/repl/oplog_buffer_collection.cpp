@@ -240,6 +240,19 @@ bool OplogBufferCollection::tryPop(OperationContext* opCtx, Value* value) {
     return _pop_inlock(opCtx, value);
 }
 
+std::size_t OplogBufferCollection::tryPopBatch(OperationContext* opCtx,
+                                               std::size_t maxCount,
+                                               Batch* values) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    std::size_t numPopped = 0;
+    for (; numPopped < maxCount && _count > 0; ++numPopped) {
+        Value value;
+        _pop_inlock(opCtx, &value);
+        values->push_back(std::move(value));
+    }
+    return numPopped;
+}
+
 bool OplogBufferCollection::waitForData(Seconds waitDuration) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     if (!_cvNoLongerEmpty.wait_for(
@@ -258,6 +271,19 @@ bool OplogBufferCollection::peek(OperationContext* opCtx, Value* value) {
     return true;
 }
 
+std::size_t OplogBufferCollection::peekBatch(OperationContext* opCtx,
+                                             std::size_t maxCount,
+                                             Batch* values) {
+    // Only the front document is handed out, since later documents are not in the peek cache
+    // unless it is enabled.
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_count == 0 || maxCount == 0) {
+        return 0;
+    }
+    values->push_back(_peek_inlock(opCtx, PeekMode::kExtractEmbeddedDocument));
+    return 1;
+}
+
 boost::optional<OplogBuffer::Value> OplogBufferCollection::lastObjectPushed(
     OperationContext* opCtx) const {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
@@ -640,6 +640,38 @@ TEST_F(OplogBufferCollectionTest, PopAndPeekReturnDocumentsInOrder) {
     _assertDocumentsInCollectionEquals(_opCtx.get(), nss, oplog);
 }
 
+TEST_F(OplogBufferCollectionTest, PeekBatchAndTryPopBatchReturnDocumentsInOrder) {
+    auto nss = makeNamespace(_agent);
+    OplogBufferCollection oplogBuffer(_storageInterface, nss);
+
+    oplogBuffer.startup(_opCtx.get());
+    const std::vector<BSONObj> oplog = {
+        makeOplogEntry(1), makeOplogEntry(2), makeOplogEntry(3),
+    };
+    oplogBuffer.pushAllNonBlocking(_opCtx.get(), oplog.begin(), oplog.end());
+    ASSERT_EQUALS(oplogBuffer.getCount(), 3UL);
+
+    OplogBuffer::Batch docs;
+    ASSERT_EQUALS(1UL, oplogBuffer.peekBatch(_opCtx.get(), 2U, &docs));
+    ASSERT_EQUALS(1UL, docs.size());
+    ASSERT_BSONOBJ_EQ(docs[0], oplog[0]);
+    ASSERT_EQUALS(oplogBuffer.getCount(), 3UL);
+
+    docs.clear();
+    ASSERT_EQUALS(2UL, oplogBuffer.tryPopBatch(_opCtx.get(), 2U, &docs));
+    ASSERT_EQUALS(2UL, docs.size());
+    ASSERT_BSONOBJ_EQ(docs[0], oplog[0]);
+    ASSERT_BSONOBJ_EQ(docs[1], oplog[1]);
+    ASSERT_EQUALS(oplogBuffer.getCount(), 1UL);
+
+    docs.clear();
+    ASSERT_EQUALS(1UL, oplogBuffer.tryPopBatch(_opCtx.get(), 2U, &docs));
+    ASSERT_BSONOBJ_EQ(docs[0], oplog[2]);
+    ASSERT_EQUALS(oplogBuffer.getCount(), 0UL);
+    ASSERT_EQUALS(0UL, oplogBuffer.peekBatch(_opCtx.get(), 2U, &docs));
+    ASSERT_EQUALS(0UL, oplogBuffer.tryPopBatch(_opCtx.get(), 2U, &docs));
+}
+
 TEST_F(OplogBufferCollectionTest, LastObjectPushedReturnsNewestOplogEntry) {
     auto nss = makeNamespace(_agent);
     OplogBufferCollection oplogBuffer(_storageInterface, nss);
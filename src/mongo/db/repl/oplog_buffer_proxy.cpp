@@ -123,6 +123,23 @@ bool OplogBufferProxy::tryPop(OperationContext* opCtx, Value* value) {
     return true;
 }
 
+std::size_t OplogBufferProxy::tryPopBatch(OperationContext* opCtx,
+                                          std::size_t maxCount,
+                                          Batch* values) {
+    stdx::lock_guard<stdx::mutex> backLock(_lastPushedMutex);
+    stdx::lock_guard<stdx::mutex> frontLock(_lastPeekedMutex);
+    auto numPopped = _target->tryPopBatch(opCtx, maxCount, values);
+    if (numPopped == 0) {
+        return 0;
+    }
+    _lastPeeked.reset();
+    // Reset _lastPushed if underlying buffer is empty.
+    if (_target->isEmpty()) {
+        _lastPushed.reset();
+    }
+    return numPopped;
+}
+
 bool OplogBufferProxy::waitForData(Seconds waitDuration) {
     {
         stdx::unique_lock<stdx::mutex> lk(_lastPushedMutex);
@@ -146,6 +163,17 @@ bool OplogBufferProxy::peek(OperationContext* opCtx, Value* value) {
     return false;
 }
 
+std::size_t OplogBufferProxy::peekBatch(OperationContext* opCtx,
+                                        std::size_t maxCount,
+                                        Batch* values) {
+    stdx::lock_guard<stdx::mutex> lk(_lastPeekedMutex);
+    auto numPeeked = _target->peekBatch(opCtx, maxCount, values);
+    if (numPeeked > 0) {
+        _lastPeeked = *(values->end() - numPeeked);
+    }
+    return numPeeked;
+}
+
 boost::optional<OplogBuffer::Value> OplogBufferProxy::lastObjectPushed(
     OperationContext* opCtx) const {
     stdx::lock_guard<stdx::mutex> lk(_lastPushedMutex);
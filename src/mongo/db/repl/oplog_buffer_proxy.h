@@ -69,8 +69,10 @@ public:
     std::size_t getCount() const override;
     void clear(OperationContext* opCtx) override;
     bool tryPop(OperationContext* opCtx, Value* value) override;
+    std::size_t tryPopBatch(OperationContext* opCtx, std::size_t maxCount, Batch* values) override;
     bool waitForData(Seconds waitDuration) override;
     bool peek(OperationContext* opCtx, Value* value) override;
+    std::size_t peekBatch(OperationContext* opCtx, std::size_t maxCount, Batch* values) override;
     boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
 
     // ---- Testing API ----
@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/optional/optional_io.hpp>
 #include <deque>
 
@@ -100,6 +101,15 @@ public:
         values.pop_front();
         return true;
     }
+    std::size_t tryPopBatch(OperationContext*, std::size_t maxCount, Batch* batch) override {
+        tryPopCalled = true;
+        std::size_t numPopped = 0;
+        for (; numPopped < maxCount && !values.empty(); ++numPopped) {
+            batch->push_back(values.front());
+            values.pop_front();
+        }
+        return numPopped;
+    }
     bool waitForData(Seconds) override {
         // Blocking not supported.
         waitForDataCalled = true;
@@ -113,6 +123,12 @@ public:
         *value = values.front();
         return true;
     }
+    std::size_t peekBatch(OperationContext*, std::size_t maxCount, Batch* batch) override {
+        peekCalled = true;
+        auto numPeeked = std::min(maxCount, values.size());
+        batch->insert(batch->end(), values.begin(), values.begin() + numPeeked);
+        return numPeeked;
+    }
     /**
      * Returns boost::none because this function should never be called by the proxy.
      */
@@ -379,4 +395,33 @@ TEST_F(OplogBufferProxyTest, TryPopClearsCachedFrontValue) {
     ASSERT_EQUALS(boost::none, _proxy->getLastPeeked_forTest());
 }
 
+TEST_F(OplogBufferProxyTest, PeekBatchCachesFrontOfBufferAndTryPopBatchClearsIt) {
+    OplogBuffer::Batch values = {BSON("x" << 1), BSON("x" << 2), BSON("x" << 3)};
+    _proxy->pushAllNonBlocking(_opCtx, values.cbegin(), values.cend());
+
+    OplogBuffer::Batch peeked;
+    ASSERT_EQUALS(2U, _proxy->peekBatch(_opCtx, 2U, &peeked));
+    ASSERT_EQUALS(2U, peeked.size());
+    ASSERT_BSONOBJ_EQ(values[0], peeked[0]);
+    ASSERT_BSONOBJ_EQ(values[1], peeked[1]);
+    ASSERT_NOT_EQUALS(boost::none, _proxy->getLastPeeked_forTest());
+    ASSERT_BSONOBJ_EQ(values[0], *_proxy->getLastPeeked_forTest());
+
+    OplogBuffer::Batch popped;
+    ASSERT_EQUALS(2U, _proxy->tryPopBatch(_opCtx, 2U, &popped));
+    ASSERT_TRUE(_mock->tryPopCalled);
+    ASSERT_EQUALS(2U, popped.size());
+    ASSERT_BSONOBJ_EQ(values[0], popped[0]);
+    ASSERT_BSONOBJ_EQ(values[1], popped[1]);
+    ASSERT_EQUALS(boost::none, _proxy->getLastPeeked_forTest());
+    ASSERT_NOT_EQUALS(boost::none, _proxy->lastObjectPushed(_opCtx));
+
+    // Popping past the end of the buffer returns what is left and resets the last pushed object.
+    popped.clear();
+    ASSERT_EQUALS(1U, _proxy->tryPopBatch(_opCtx, 2U, &popped));
+    ASSERT_BSONOBJ_EQ(values[2], popped[0]);
+    ASSERT_EQUALS(boost::none, _proxy->lastObjectPushed(_opCtx));
+    ASSERT_EQUALS(0U, _proxy->tryPopBatch(_opCtx, 2U, &popped));
+}
+
 }  // namespace
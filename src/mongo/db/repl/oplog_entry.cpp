@@ -54,6 +54,8 @@ OplogEntry::OplogEntry(BSONObj rawInput) : raw(std::move(rawInput)) {
             o2 = elem;
         } else if (name == "ts") {
             ts = elem;
+        } else if (name == "t") {
+            t = elem;
         } else if (name == "v") {
             version = elem;
         } else if (name == "o") {
@@ -97,6 +99,12 @@ BSONElement OplogEntry::getIdElement() const {
 }
 
 OpTime OplogEntry::getOpTime() const {
+    // Use the elements found by the constructor rather than searching the raw BSON again. Anything
+    // unusual is left to the full parser so that malformed entries are reported the same way.
+    if (MONGO_likely(ts.type() == bsonTimestamp &&
+                     (t.eoo() || t.type() == NumberLong || t.type() == NumberInt))) {
+        return OpTime(ts.timestamp(), t.eoo() ? OpTime::kUninitializedTerm : t.numberLong());
+    }
     return fassertStatusOK(34436, OpTime::parseFromOplogEntry(raw));
 }
 
@@ -72,6 +72,7 @@ struct OplogEntry {
     BSONElement o;
     BSONElement o2;
     BSONElement ts;
+    BSONElement t;
 };
 
 std::ostream& operator<<(std::ostream& s, const OplogEntry& o);
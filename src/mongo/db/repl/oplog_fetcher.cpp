@@ -33,9 +33,11 @@
 #include "mongo/db/repl/oplog_fetcher.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -54,6 +56,8 @@ Seconds OplogFetcher::kDefaultProtocolZeroAwaitDataTimeout(2);
 
 MONGO_FP_DECLARE(stopReplProducer);
 
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherEnqueueInBackground, bool, false);
+
 namespace {
 
 Seconds kOplogInitialFindMaxTime{60};
@@ -344,7 +348,8 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _enqueueDocumentsFn(enqueueDocumentsFn),
       _awaitDataTimeout(calculateAwaitDataTimeout(config)),
       _onShutdownCallbackFn(onShutdownCallbackFn),
-      _lastFetched(lastFetched) {
+      _lastFetched(lastFetched),
+      _enqueueInBackground(oplogFetcherEnqueueInBackground.load()) {
     uassert(ErrorCodes::BadValue, "null last optime fetched", !_lastFetched.opTime.isNull());
     uassert(ErrorCodes::InvalidReplicaSetConfig,
             "uninitialized replica set configuration",
@@ -357,7 +362,7 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
 }
 
 OplogFetcher::~OplogFetcher() {
-    DESTRUCTOR_GUARD(shutdown(); join(););
+    DESTRUCTOR_GUARD(shutdown(); join(); _stopEnqueueThread(););
 }
 
 std::string OplogFetcher::toString() const {
@@ -368,7 +373,16 @@ std::string OplogFetcher::toString() const {
 }
 
 Status OplogFetcher::_doStartup_inlock() noexcept {
-    return _scheduleFetcher_inlock();
+    if (_enqueueInBackground) {
+        _enqueueThread = stdx::thread([this] { _enqueueThreadMain(); });
+    }
+
+    auto status = _scheduleFetcher_inlock();
+    if (!status.isOK()) {
+        _stopEnqueueThread();
+    }
+
+    return status;
 }
 
 void OplogFetcher::_doShutdown_inlock() noexcept {
@@ -555,7 +569,9 @@ void OplogFetcher::_callback(const Fetcher::QueryResponseStatus& result,
     getmoreReplStats.recordMillis(durationCount<Milliseconds>(queryResponse.elapsedMillis));
 
     // TODO: back pressure handling will be added in SERVER-23499.
-    auto status = _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
+    auto status = _enqueueInBackground
+        ? _enqueueDocumentsInBackground(firstDocToApply, documents.cend(), info)
+        : _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
     if (!status.isOK()) {
         _finishCallback(status);
         return;
@@ -614,6 +630,12 @@ void OplogFetcher::_finishCallback(Status status) {
 void OplogFetcher::_finishCallback(Status status, OpTimeWithHash opTimeWithHash) {
     invariant(isActive());
 
+    // The caller must only be notified once all fetched operations are enqueued.
+    auto enqueueStatus = _stopEnqueueThread();
+    if (status.isOK()) {
+        status = enqueueStatus;
+    }
+
     _onShutdownCallbackFn(status, opTimeWithHash);
 
     decltype(_onShutdownCallbackFn) onShutdownCallbackFn;
@@ -627,6 +649,64 @@ void OplogFetcher::_finishCallback(Status status, OpTimeWithHash opTimeWithHash)
     std::swap(_onShutdownCallbackFn, onShutdownCallbackFn);
 }
 
+Status OplogFetcher::_enqueueDocumentsInBackground(Fetcher::Documents::const_iterator begin,
+                                                   Fetcher::Documents::const_iterator end,
+                                                   const DocumentsInfo& info) {
+    stdx::unique_lock<stdx::mutex> lk(_enqueueMutex);
+    _enqueueCondition.wait(lk, [this] { return !_pendingBatch && !_enqueueInProgress; });
+
+    if (!_enqueueStatus.isOK()) {
+        return _enqueueStatus;
+    }
+
+    _pendingBatch = PendingBatch{Fetcher::Documents(begin, end), info};
+    _enqueueCondition.notify_all();
+    return Status::OK();
+}
+
+void OplogFetcher::_enqueueThreadMain() {
+    Client::initThread("OplogFetcherEnqueuer");
+
+    stdx::unique_lock<stdx::mutex> lk(_enqueueMutex);
+    while (true) {
+        _enqueueCondition.wait(lk, [this] { return _pendingBatch || _enqueueThreadShouldExit; });
+        if (!_pendingBatch) {
+            return;
+        }
+
+        PendingBatch batch = std::move(*_pendingBatch);
+        _pendingBatch = boost::none;
+        _enqueueInProgress = true;
+        lk.unlock();
+
+        auto status =
+            _enqueueDocumentsFn(batch.documents.cbegin(), batch.documents.cend(), batch.info);
+
+        lk.lock();
+        _enqueueInProgress = false;
+        if (!status.isOK() && _enqueueStatus.isOK()) {
+            _enqueueStatus = status;
+        }
+        _enqueueCondition.notify_all();
+    }
+}
+
+Status OplogFetcher::_stopEnqueueThread() {
+    if (!_enqueueThread.joinable()) {
+        return Status::OK();
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_enqueueMutex);
+        _enqueueThreadShouldExit = true;
+        _enqueueCondition.notify_all();
+    }
+    _enqueueThread.join();
+
+    stdx::lock_guard<stdx::mutex> lk(_enqueueMutex);
+    return _enqueueStatus;
+}
+
 std::unique_ptr<Fetcher> OplogFetcher::_makeFetcher(long long currentTerm,
                                                     OpTime lastFetchedOpTime) {
     return stdx::make_unique<Fetcher>(
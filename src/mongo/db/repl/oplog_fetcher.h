@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <cstddef>
 #include <memory>
 
@@ -40,9 +41,11 @@
 #include "mongo/db/repl/data_replicator_external_state.h"
 #include "mongo/db/repl/optime_with.h"
 #include "mongo/db/repl/repl_set_config.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point_service.h"
 
 namespace mongo {
@@ -50,6 +53,10 @@ namespace repl {
 
 MONGO_FP_FORWARD_DECLARE(stopReplProducer);
 
+// Whether oplog fetchers hand each batch to a background thread for enqueueing, so that the
+// getMore for the next batch is sent while the current one is still being enqueued.
+extern AtomicBool oplogFetcherEnqueueInBackground;
+
 /**
  * Used to keep track of the optime and hash of the last fetched operation.
  */
@@ -71,7 +78,9 @@ using OpTimeWithHash = OpTimeWith<long long>;
  * Pushes operations from each batch of operations onto a buffer using the "enqueueDocumentsFn"
  * function.
  *
- * Issues a getMore command after successfully processing each batch of operations.
+ * Issues a getMore command after successfully processing each batch of operations. If
+ * "oplogFetcherEnqueueInBackground" is set, the batch is pushed onto the buffer by a dedicated
+ * thread instead, while the getMore is in flight. At most one batch waits to be pushed at a time.
  *
  * When there is an error or when it is not possible to issue another getMore request, calls
  * "onShutdownCallbackFn" to signal the end of processing.
@@ -205,6 +214,27 @@ private:
      */
     std::unique_ptr<Fetcher> _makeFetcher(long long currentTerm, OpTime lastFetchedOpTime);
 
+    /**
+     * Waits for the enqueue thread to be done with the previous batch and hands it the specified
+     * one. Returns the error from enqueueing any earlier batch, in which case this batch is not
+     * handed over.
+     */
+    Status _enqueueDocumentsInBackground(Fetcher::Documents::const_iterator begin,
+                                         Fetcher::Documents::const_iterator end,
+                                         const DocumentsInfo& info);
+
+    /**
+     * Body of the enqueue thread. Calls "_enqueueDocumentsFn" on each batch handed over by
+     * _enqueueDocumentsInBackground until told to exit.
+     */
+    void _enqueueThreadMain();
+
+    /**
+     * Waits for the enqueue thread to be done with all batches handed to it, stops it and returns
+     * the first error from enqueueing. Does nothing if the thread is not running.
+     */
+    Status _stopEnqueueThread();
+
     // Protects member data of this OplogFetcher.
     mutable stdx::mutex _mutex;
 
@@ -241,6 +271,30 @@ private:
 
     std::unique_ptr<Fetcher> _fetcher;
     std::unique_ptr<Fetcher> _shuttingDownFetcher;
+
+    // Whether batches are enqueued by '_enqueueThread' rather than by the fetcher callback.
+    const bool _enqueueInBackground;
+
+    /**
+     * A batch of operations waiting for the enqueue thread.
+     */
+    struct PendingBatch {
+        Fetcher::Documents documents;
+        DocumentsInfo info;
+    };
+
+    // Protects the enqueue thread state below. Separate from '_mutex', so that the enqueue thread
+    // can be stopped while '_mutex' is held.
+    stdx::mutex _enqueueMutex;
+    stdx::condition_variable _enqueueCondition;
+
+    stdx::thread _enqueueThread;
+    boost::optional<PendingBatch> _pendingBatch;
+    bool _enqueueInProgress = false;
+    bool _enqueueThreadShouldExit = false;
+
+    // First error returned by '_enqueueDocumentsFn' on the enqueue thread.
+    Status _enqueueStatus = Status::OK();
 };
 
 }  // namespace repl
@@ -41,6 +41,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/scopeguard.h"
 
 namespace {
@@ -1085,6 +1086,99 @@ TEST_F(OplogFetcherTest,
     ASSERT_FALSE(request.cmdObj.hasField("lastKnownCommittedOpTime"));
 }
 
+TEST_F(OplogFetcherTest, GetMoreIsSentWhileBatchIsEnqueuedInBackground) {
+    oplogFetcherEnqueueInBackground.store(true);
+    ON_BLOCK_EXIT([] { oplogFetcherEnqueueInBackground.store(false); });
+
+    Notification<void> firstBatchMayProceed;
+    std::size_t numBatchesEnqueued = 0;
+    enqueueDocumentsFn = [&](Fetcher::Documents::const_iterator begin,
+                             Fetcher::Documents::const_iterator end,
+                             const OplogFetcher::DocumentsInfo& info) -> Status {
+        if (numBatchesEnqueued++ == 0) {
+            firstBatchMayProceed.get();
+        }
+        lastEnqueuedDocuments = {begin, end};
+        lastEnqueuedDocumentsInfo = info;
+        return Status::OK();
+    };
+
+    ShutdownState shutdownState;
+    OplogFetcher oplogFetcher(&getExecutor(),
+                              lastFetched,
+                              source,
+                              nss,
+                              _createConfig(true),
+                              0,
+                              rbid,
+                              true,
+                              dataReplicatorExternalState.get(),
+                              enqueueDocumentsFn,
+                              stdx::ref(shutdownState));
+    ASSERT_OK(oplogFetcher.startup());
+
+    CursorId cursorId = 22LL;
+    auto firstEntry = makeNoopOplogEntry(lastFetched);
+    auto secondEntry = makeNoopOplogEntry({{Seconds(456), 0}, lastFetched.opTime.getTerm()}, 200);
+    auto metadataObj = makeOplogQueryMetadataObject(remoteNewerOpTime, rbid, 2, 2);
+
+    // The getMore is ready to be sent although the first batch is not enqueued yet.
+    processNetworkResponse(
+        {makeCursorResponse(cursorId, {firstEntry, secondEntry}), metadataObj, Milliseconds(0)},
+        true);
+    firstBatchMayProceed.set();
+
+    auto thirdEntry = makeNoopOplogEntry({{Seconds(789), 0}, lastFetched.opTime.getTerm()}, 300);
+    auto request = processNetworkResponse(makeCursorResponse(0, {thirdEntry}, false));
+    ASSERT_EQUALS(std::string("getMore"), request.cmdObj.firstElementFieldName());
+
+    oplogFetcher.join();
+    ASSERT_EQUALS(OplogFetcher::State::kComplete, oplogFetcher.getState_forTest());
+
+    ASSERT_EQUALS(2U, numBatchesEnqueued);
+    ASSERT_EQUALS(1U, lastEnqueuedDocuments.size());
+    ASSERT_BSONOBJ_EQ(thirdEntry, lastEnqueuedDocuments[0]);
+
+    ASSERT_OK(shutdownState.getStatus());
+    ASSERT_EQUALS(OpTimeWithHash(thirdEntry["h"].numberLong(),
+                                 unittest::assertGet(OpTime::parseFromOplogEntry(thirdEntry))),
+                  shutdownState.getLastFetched());
+}
+
+TEST_F(OplogFetcherTest, EnqueueErrorInBackgroundStopsTheOplogFetcher) {
+    oplogFetcherEnqueueInBackground.store(true);
+    ON_BLOCK_EXIT([] { oplogFetcherEnqueueInBackground.store(false); });
+
+    enqueueDocumentsFn = [](Fetcher::Documents::const_iterator,
+                            Fetcher::Documents::const_iterator,
+                            const OplogFetcher::DocumentsInfo&) -> Status {
+        return Status(ErrorCodes::InternalError, "my custom error");
+    };
+
+    ShutdownState shutdownState;
+    OplogFetcher oplogFetcher(&getExecutor(),
+                              lastFetched,
+                              source,
+                              nss,
+                              _createConfig(true),
+                              0,
+                              rbid,
+                              true,
+                              dataReplicatorExternalState.get(),
+                              enqueueDocumentsFn,
+                              stdx::ref(shutdownState));
+    ASSERT_OK(oplogFetcher.startup());
+
+    auto firstEntry = makeNoopOplogEntry(lastFetched);
+    auto secondEntry = makeNoopOplogEntry({{Seconds(456), 0}, lastFetched.opTime.getTerm()}, 200);
+    auto metadataObj = makeOplogQueryMetadataObject(remoteNewerOpTime, rbid, 2, 2);
+    processNetworkResponse(
+        {makeCursorResponse(0, {firstEntry, secondEntry}), metadataObj, Milliseconds(0)});
+
+    oplogFetcher.join();
+    ASSERT_EQUALS(ErrorCodes::InternalError, shutdownState.getStatus());
+}
+
 TEST_F(OplogFetcherTest, ValidateDocumentsReturnsNoSuchKeyIfTimestampIsNotFoundInAnyDocument) {
     auto firstEntry = makeNoopOplogEntry(Seconds(123), 100);
     auto secondEntry = BSON("o" << BSON("msg"
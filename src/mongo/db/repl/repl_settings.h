@@ -38,6 +38,7 @@ namespace mongo {
 namespace repl {
 
 extern int maxSyncSourceLagSecs;
+extern std::string syncSourceRegionTag;
 extern double replElectionTimeoutOffsetLimitFraction;
 
 class ReplSettings {
@@ -36,6 +36,7 @@ namespace mongo {
 namespace repl {
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(maxSyncSourceLagSecs, int, 30);
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(syncSourceRegionTag, std::string, "");
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(replElectionTimeoutOffsetLimitFraction, double, 0.15);
 
 MONGO_INITIALIZER(replSettingsCheck)(InitializerContext*) {
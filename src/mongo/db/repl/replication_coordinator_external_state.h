@@ -269,6 +269,11 @@ public:
      */
     virtual void createSnapshot(OperationContext* opCtx, SnapshotName name) = 0;
 
+    /**
+     * Updates the local snapshot to a consistent point for secondary reads.
+     */
+    virtual void updateLocalSnapshot(SnapshotName name) = 0;
+
     /**
      * Signals the SnapshotThread, if running, to take a forced snapshot even if the global
      * timestamp hasn't changed.
@@ -816,6 +816,12 @@ void ReplicationCoordinatorExternalStateImpl::createSnapshot(OperationContext* o
     manager->createSnapshot(opCtx, name);
 }
 
+void ReplicationCoordinatorExternalStateImpl::updateLocalSnapshot(SnapshotName name) {
+    auto manager = _service->getGlobalStorageEngine()->getSnapshotManager();
+    invariant(manager);  // This should never be called if there is no SnapshotManager.
+    manager->setLocalSnapshot(name);
+}
+
 void ReplicationCoordinatorExternalStateImpl::forceSnapshotCreation() {
     if (_snapshotThread)
         _snapshotThread->forceSnapshot();
@@ -98,6 +98,7 @@ public:
     void dropAllSnapshots() final;
     void updateCommittedSnapshot(SnapshotName newCommitPoint) final;
     void createSnapshot(OperationContext* opCtx, SnapshotName name) final;
+    void updateLocalSnapshot(SnapshotName name) final;
     void forceSnapshotCreation() final;
     virtual bool snapshotsEnabled() const;
     virtual void notifyOplogMetadataWaiters();
@@ -234,6 +234,8 @@ void ReplicationCoordinatorExternalStateMock::updateCommittedSnapshot(SnapshotNa
 void ReplicationCoordinatorExternalStateMock::createSnapshot(OperationContext* opCtx,
                                                              SnapshotName name) {}
 
+void ReplicationCoordinatorExternalStateMock::updateLocalSnapshot(SnapshotName name) {}
+
 void ReplicationCoordinatorExternalStateMock::forceSnapshotCreation() {}
 
 bool ReplicationCoordinatorExternalStateMock::snapshotsEnabled() const {
@@ -90,6 +90,7 @@ public:
     virtual void dropAllSnapshots();
     virtual void updateCommittedSnapshot(SnapshotName newCommitPoint);
     virtual void createSnapshot(OperationContext* opCtx, SnapshotName name);
+    virtual void updateLocalSnapshot(SnapshotName name);
     virtual void forceSnapshotCreation();
     virtual bool snapshotsEnabled() const;
     virtual void notifyOplogMetadataWaiters();
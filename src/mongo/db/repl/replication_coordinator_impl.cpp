@@ -236,37 +236,61 @@ private:
     WaiterList* _list;
 };
 
+ReplicationCoordinatorImpl::WaiterList::WriteConcernKey
+ReplicationCoordinatorImpl::WaiterList::_getWriteConcernKey(WaiterType waiter) {
+    if (!waiter->writeConcern) {
+        return WriteConcernKey(false, "", 0, 0);
+    }
+    const auto& writeConcern = *waiter->writeConcern;
+    return WriteConcernKey(true,
+                           writeConcern.wMode,
+                           writeConcern.wNumNodes,
+                           static_cast<int>(writeConcern.syncMode));
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(WaiterType waiter) {
-    _list.push_back(waiter);
+    _waiters[_getWriteConcernKey(waiter)].emplace(waiter->opTime, waiter);
 }
 
-void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveIf_inlock(
+void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveReady_inlock(
     stdx::function<bool(WaiterType)> func) {
-    std::vector<WaiterType>::iterator it = _list.end();
-    while (true) {
-        it = std::find_if(_list.begin(), _list.end(), func);
-        if (it == _list.end()) {
-            break;
+    for (auto group = _waiters.begin(); group != _waiters.end();) {
+        auto& waiters = group->second;
+        while (!waiters.empty() && func(waiters.begin()->second)) {
+            auto waiter = waiters.begin()->second;
+            waiters.erase(waiters.begin());
+            waiter->notify();
         }
-        (*it)->notify();
-        std::swap(*it, _list.back());
-        _list.pop_back();
+        group = waiters.empty() ? _waiters.erase(group) : std::next(group);
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveAll_inlock() {
-    for (auto& waiter : _list) {
-        waiter->notify();
+    auto waiters = std::move(_waiters);
+    _waiters.clear();
+    for (auto& group : waiters) {
+        for (auto& waiter : group.second) {
+            waiter.second->notify();
+        }
     }
-    _list.clear();
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(WaiterType waiter) {
-    auto it = std::find(_list.begin(), _list.end(), waiter);
-    if (it != _list.end()) {
-        std::swap(*it, _list.back());
-        _list.pop_back();
-        return true;
+    auto group = _waiters.find(_getWriteConcernKey(waiter));
+    if (group == _waiters.end()) {
+        return false;
+    }
+
+    auto& waiters = group->second;
+    auto range = waiters.equal_range(waiter->opTime);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == waiter) {
+            waiters.erase(it);
+            if (waiters.empty()) {
+                _waiters.erase(group);
+            }
+            return true;
+        }
     }
     return false;
 }
@@ -1183,7 +1207,7 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTime_inlock(const OpTime& op
     invariant(isRollbackAllowed || mySlaveInfo->lastAppliedOpTime <= opTime);
     _updateSlaveInfoAppliedOpTime_inlock(mySlaveInfo, opTime);
 
-    _opTimeWaiterList.signalAndRemoveIf_inlock(
+    _opTimeWaiterList.signalAndRemoveReady_inlock(
         [opTime](WaiterInfo* waiter) { return waiter->opTime <= opTime; });
 }
 
@@ -2955,7 +2979,10 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig_inlock(const ReplSetConfig& newC
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters_inlock() {
-    _replicationWaiterList.signalAndRemoveIf_inlock([this](WaiterInfo* waiter) {
+    // Whether a write concern is satisfied only depends on how far the members have replicated,
+    // so once a waiter is not done, neither is any waiter with the same write concern and a later
+    // optime.
+    _replicationWaiterList.signalAndRemoveReady_inlock([this](WaiterInfo* waiter) {
         return _doneWaitingForReplication_inlock(
             waiter->opTime, SnapshotName::min(), *waiter->writeConcern);
     });
@@ -3554,6 +3581,9 @@ void ReplicationCoordinatorImpl::createSnapshot(OperationContext* opCtx,
                                                 SnapshotName name) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _externalState->createSnapshot(opCtx, name);
+    // The SnapshotThread only takes snapshots between batches of oplog application, so every
+    // snapshot is a consistent point that secondary reads may use without the PBWM lock.
+    _externalState->updateLocalSnapshot(name);
     auto snapshotInfo = SnapshotInfo{timeOfSnapshot, name};
 
     if (timeOfSnapshot <= _lastCommittedOpTime) {
@@ -3669,6 +3699,14 @@ CallbackHandle ReplicationCoordinatorImpl::_scheduleWorkAt(Date_t when, const Ca
     return _wrapAndScheduleWork(scheduleFn, work);
 }
 
+CallbackHandle ReplicationCoordinatorImpl::_scheduleHighPriorityWorkAt(Date_t when,
+                                                                      const CallbackFn& work) {
+    auto scheduleFn = [this, when](const CallbackFn& workWrapped) {
+        return _replExecutor.scheduleHighPriorityWorkAt(when, workWrapped);
+    };
+    return _wrapAndScheduleWork(scheduleFn, work);
+}
+
 void ReplicationCoordinatorImpl::_scheduleWorkAndWaitForCompletion(const CallbackFn& work) {
     if (auto handle = _scheduleWork(work)) {
         _replExecutor.wait(handle);
@@ -28,7 +28,10 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -492,13 +495,23 @@ private:
         void add_inlock(WaiterType waiter);
         // Returns whether waiter is found and removed.
         bool remove_inlock(WaiterType waiter);
-        // Signals and removes all waiters that satisfy the condition.
-        void signalAndRemoveIf_inlock(stdx::function<bool(WaiterType)> fun);
+        // Signals and removes waiters that satisfy the condition, visiting the waiters with the
+        // same write concern in increasing optime order and skipping the rest of them at the
+        // first one that does not. Only valid for conditions that hold for a waiter whenever they
+        // hold for a waiter with the same write concern and a later optime.
+        void signalAndRemoveReady_inlock(stdx::function<bool(WaiterType)> fun);
         // Signals and removes all waiters from the list.
         void signalAndRemoveAll_inlock();
 
     private:
-        std::vector<WaiterType> _list;
+        // Identifies the waiters whose write concerns are satisfied under the same conditions:
+        // whether there is a write concern, and its wMode, wNumNodes and syncMode.
+        using WriteConcernKey = std::tuple<bool, std::string, int, int>;
+        using WaitersByOpTime = std::multimap<OpTime, WaiterType>;
+
+        static WriteConcernKey _getWriteConcernKey(WaiterType waiter);
+
+        std::map<WriteConcernKey, WaitersByOpTime> _waiters;
     };
 
     // Struct that holds information about nodes in this replication group, mainly used for
@@ -1105,6 +1118,12 @@ private:
      */
     CallbackHandle _scheduleWorkAt(Date_t when, const CallbackFn& work);
 
+    /**
+     * Like _scheduleWorkAt(), but runs 'work' ahead of normal priority work once it is ready.
+     * Used for timeouts that drive failure detection and elections.
+     */
+    CallbackHandle _scheduleHighPriorityWorkAt(Date_t when, const CallbackFn& work);
+
     /**
      * Schedules work and waits for completion.
      */
@@ -1125,7 +1144,7 @@ private:
 
     /**
      * Does the actual work of scheduling the work with the executor.
-     * Used by _scheduleWork() and _scheduleWorkAt() only.
+     * Used by _scheduleWork(), _scheduleWorkAt() and _scheduleHighPriorityWorkAt() only.
      * Do not call this function directly.
      */
     CallbackHandle _wrapAndScheduleWork(ScheduleFn scheduleFn, const CallbackFn& work);
@@ -122,7 +122,8 @@ void ReplicationCoordinatorImpl::_doMemberHeartbeat(ReplicationExecutor::Callbac
 
     LOG_FOR_HEARTBEATS(2) << "Sending heartbeat (requestId: " << request.id << ") to " << target
                           << ", " << heartbeatObj;
-    _trackHeartbeatHandle_inlock(_replExecutor.scheduleRemoteCommand(request, callback));
+    _trackHeartbeatHandle_inlock(
+        _replExecutor.scheduleHighPriorityRemoteCommand(request, callback));
 }
 
 void ReplicationCoordinatorImpl::_scheduleHeartbeatToTarget_inlock(const HostAndPort& target,
@@ -130,13 +131,13 @@ void ReplicationCoordinatorImpl::_scheduleHeartbeatToTarget_inlock(const HostAnd
                                                                    Date_t when) {
     LOG_FOR_HEARTBEATS(2) << "Scheduling heartbeat to " << target << " at "
                           << dateToISOStringUTC(when);
-    _trackHeartbeatHandle_inlock(
-        _replExecutor.scheduleWorkAt(when,
-                                     stdx::bind(&ReplicationCoordinatorImpl::_doMemberHeartbeat,
-                                                this,
-                                                stdx::placeholders::_1,
-                                                target,
-                                                targetIndex)));
+    _trackHeartbeatHandle_inlock(_replExecutor.scheduleHighPriorityWorkAt(
+        when,
+        stdx::bind(&ReplicationCoordinatorImpl::_doMemberHeartbeat,
+                   this,
+                   stdx::placeholders::_1,
+                   target,
+                   targetIndex)));
 }
 
 void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
@@ -748,10 +749,10 @@ void ReplicationCoordinatorImpl::_scheduleNextLivenessUpdate_inlock() {
     auto nextTimeout = earliestDate + _rsConfig.getElectionTimeoutPeriod();
     if (nextTimeout > _replExecutor.now()) {
         LOG(3) << "scheduling next check at " << nextTimeout;
-        auto cbh = _scheduleWorkAt(nextTimeout,
-                                   stdx::bind(&ReplicationCoordinatorImpl::_handleLivenessTimeout,
-                                              this,
-                                              stdx::placeholders::_1));
+        auto cbh = _scheduleHighPriorityWorkAt(
+            nextTimeout,
+            stdx::bind(
+                &ReplicationCoordinatorImpl::_handleLivenessTimeout, this, stdx::placeholders::_1));
         if (!cbh) {
             return;
         }
@@ -813,11 +814,11 @@ void ReplicationCoordinatorImpl::_cancelAndRescheduleElectionTimeout_inlock() {
     invariant(when > now);
     LOG(4) << "Scheduling election timeout callback at " << when;
     _handleElectionTimeoutWhen = when;
-    _handleElectionTimeoutCbh =
-        _scheduleWorkAt(when,
-                        stdx::bind(&ReplicationCoordinatorImpl::_startElectSelfIfEligibleV1,
-                                   this,
-                                   StartElectionV1Reason::kElectionTimeout));
+    _handleElectionTimeoutCbh = _scheduleHighPriorityWorkAt(
+        when,
+        stdx::bind(&ReplicationCoordinatorImpl::_startElectSelfIfEligibleV1,
+                   this,
+                   StartElectionV1Reason::kElectionTimeout));
 }
 
 void ReplicationCoordinatorImpl::_startElectSelfIfEligibleV1(StartElectionV1Reason reason) {
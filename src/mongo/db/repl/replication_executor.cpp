@@ -35,7 +35,9 @@
 #include <limits>
 
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/repl/database_task.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/executor/network_interface.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
@@ -48,6 +50,15 @@ namespace {
 
 const char kReplicationExecutorThreadName[] = "ReplicationExecutor";
 
+// Time high priority work, such as heartbeat and election callbacks, waits to run once ready, and
+// the time it takes to run.
+TimerStats highPriorityWaitStats;
+ServerStatusMetricField<TimerStats> displayHighPriorityWait("repl.executor.highPriority.wait",
+                                                            &highPriorityWaitStats);
+TimerStats highPriorityRunStats;
+ServerStatusMetricField<TimerStats> displayHighPriorityRun("repl.executor.highPriority.run",
+                                                           &highPriorityRunStats);
+
 stdx::function<void()> makeNoExcept(const stdx::function<void()>& fn);
 
 }  // namespace
@@ -95,6 +106,7 @@ BSONObj ReplicationExecutor::getDiagnosticBSON() const {
     queues.appendIntOrLL("exclusiveInProgress", _exclusiveLockInProgressQueue.size());
     queues.appendIntOrLL("sleepers", _sleepersQueue.size());
     queues.appendIntOrLL("ready", _readyQueue.size());
+    queues.appendIntOrLL("highPriorityReady", _highPriorityReadyQueue.size());
     queues.appendIntOrLL("free", _freeQueue.size());
     queues.done();
 
@@ -118,6 +130,7 @@ std::string ReplicationExecutor::_getDiagnosticString_inlock() const {
     output << " exclusiveInProgress:" << _exclusiveLockInProgressQueue.size();
     output << " sleeperQueue:" << _sleepersQueue.size();
     output << " ready:" << _readyQueue.size();
+    output << " highPriorityReady:" << _highPriorityReadyQueue.size();
     output << " free:" << _freeQueue.size();
     output << " unsignaledEvents:" << _unsignaledEvents.size();
     output << " eventWaiters:" << _totalEventWaiters;
@@ -137,7 +150,13 @@ void ReplicationExecutor::run() {
     _dblockWorkers.startThreads();
     std::pair<WorkItem, CallbackHandle> work;
     while ((work = getWork()).first.callback.isValid()) {
+        const bool isHighPriority = work.first.isHighPriority;
+        if (isHighPriority) {
+            highPriorityWaitStats.recordMillis(
+                durationCount<Milliseconds>(now() - work.first.readySince));
+        }
         {
+            TimerHolder runTimer(isHighPriority ? &highPriorityRunStats : nullptr);
             stdx::lock_guard<stdx::mutex> lk(_terribleExLockSyncMutex);
             const Callback* callback = _getCallbackFromHandle(work.first.callback);
             const Status inStatus = callback->_isCanceled
@@ -170,6 +189,7 @@ void ReplicationExecutor::shutdown() {
         return;
     _inShutdown = true;
 
+    _readyQueue.splice(_readyQueue.begin(), _highPriorityReadyQueue);
     _readyQueue.splice(_readyQueue.end(), _dbWorkInProgressQueue);
     _readyQueue.splice(_readyQueue.end(), _exclusiveLockInProgressQueue);
     _readyQueue.splice(_readyQueue.end(), _networkInProgressQueue);
@@ -177,10 +197,11 @@ void ReplicationExecutor::shutdown() {
     for (auto event : _unsignaledEvents) {
         _readyQueue.splice(_readyQueue.end(), _getEventFromHandle(event)->_waiters);
     }
-    for (auto readyWork : _readyQueue) {
+    for (auto& readyWork : _readyQueue) {
         auto callback = _getCallbackFromHandle(readyWork.callback);
         callback->_isCanceled = true;
         callback->_isSleeper = false;
+        readyWork.isHighPriority = false;
     }
 
     _networkInterface->signalWorkAvailable();
@@ -200,6 +221,7 @@ void ReplicationExecutor::finishShutdown() {
     invariant(_dbWorkInProgressQueue.empty());
     invariant(_exclusiveLockInProgressQueue.empty());
     invariant(_readyQueue.empty());
+    invariant(_highPriorityReadyQueue.empty());
     invariant(_sleepersQueue.empty());
 
     while (!_unsignaledEvents.empty()) {
@@ -214,6 +236,7 @@ void ReplicationExecutor::finishShutdown() {
     invariant(_dbWorkInProgressQueue.empty());
     invariant(_exclusiveLockInProgressQueue.empty());
     invariant(_readyQueue.empty());
+    invariant(_highPriorityReadyQueue.empty());
     invariant(_sleepersQueue.empty());
     invariant(_unsignaledEvents.empty());
 }
@@ -322,11 +345,22 @@ void ReplicationExecutor::_finishRemoteCommand(const RemoteCommandRequest& reque
 
     callback->_callbackFn =
         stdx::bind(remoteCommandFinished, stdx::placeholders::_1, cb, request, response);
-    _readyQueue.splice(_readyQueue.end(), _networkInProgressQueue, iter);
+    _makeReady_inlock(&_networkInProgressQueue, iter);
 }
 
 StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleRemoteCommand(
     const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, false);
+}
+
+StatusWith<ReplicationExecutor::CallbackHandle>
+ReplicationExecutor::scheduleHighPriorityRemoteCommand(const RemoteCommandRequest& request,
+                                                       const RemoteCommandCallbackFn& cb) {
+    return _scheduleRemoteCommand(request, cb, true);
+}
+
+StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::_scheduleRemoteCommand(
+    const RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb, bool isHighPriority) {
     RemoteCommandRequest scheduledRequest = request;
     if (request.timeout == RemoteCommandRequest::kNoTimeout) {
         scheduledRequest.expirationDate = RemoteCommandRequest::kNoExpirationDate;
@@ -339,6 +373,7 @@ StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleRem
         stdx::bind(remoteCommandFailedEarly, stdx::placeholders::_1, cb, scheduledRequest));
     if (handle.isOK()) {
         _getCallbackFromHandle(handle.getValue())->_iter->isNetworkOperation = true;
+        _getCallbackFromHandle(handle.getValue())->_iter->isHighPriority = isHighPriority;
 
         LOG(4) << "Scheduling remote request: " << request.toString();
 
@@ -370,6 +405,16 @@ StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleWor
 
 StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleWorkAt(
     Date_t when, const CallbackFn& work) {
+    return _scheduleWorkAt(when, work, false);
+}
+
+StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleHighPriorityWorkAt(
+    Date_t when, const CallbackFn& work) {
+    return _scheduleWorkAt(when, work, true);
+}
+
+StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::_scheduleWorkAt(
+    Date_t when, const CallbackFn& work, bool isHighPriority) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     WorkQueue temp;
     StatusWith<CallbackHandle> cbHandle = enqueueWork_inlock(&temp, work);
@@ -377,6 +422,7 @@ StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::scheduleWor
         return cbHandle;
     auto callback = _getCallbackFromHandle(cbHandle.getValue());
     callback->_iter->readyDate = when;
+    callback->_iter->isHighPriority = isHighPriority;
     callback->_isSleeper = true;
     WorkQueue::iterator insertBefore = _sleepersQueue.begin();
     while (insertBefore != _sleepersQueue.end() && insertBefore->readyDate <= when)
@@ -474,13 +520,17 @@ void ReplicationExecutor::appendConnectionStats(executor::ConnectionPoolStats* s
     _networkInterface->appendConnectionStats(stats);
 }
 
+void ReplicationExecutor::warmUpConnections(const HostAndPort& hostAndPort) {
+    _networkInterface->warmUpConnections(hostAndPort);
+}
+
 std::pair<ReplicationExecutor::WorkItem, ReplicationExecutor::CallbackHandle>
 ReplicationExecutor::getWork() {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     while (true) {
         const Date_t now = _networkInterface->now();
         Date_t nextWakeupDate = scheduleReadySleepers_inlock(now);
-        if (!_readyQueue.empty()) {
+        if (!_readyQueue.empty() || !_highPriorityReadyQueue.empty()) {
             break;
         } else if (_inShutdown) {
             return std::make_pair(WorkItem(), CallbackHandle());
@@ -493,10 +543,12 @@ ReplicationExecutor::getWork() {
         }
         lk.lock();
     }
-    const WorkItem work = *_readyQueue.begin();
+    WorkQueue* readyQueue =
+        _highPriorityReadyQueue.empty() ? &_readyQueue : &_highPriorityReadyQueue;
+    const WorkItem work = *readyQueue->begin();
     const CallbackHandle cbHandle = work.callback;
-    _readyQueue.begin()->callback = CallbackHandle();
-    _freeQueue.splice(_freeQueue.begin(), _readyQueue, _readyQueue.begin());
+    readyQueue->begin()->callback = CallbackHandle();
+    _freeQueue.splice(_freeQueue.begin(), *readyQueue, readyQueue->begin());
     return std::make_pair(work, cbHandle);
 }
 
@@ -509,9 +561,8 @@ Date_t ReplicationExecutor::scheduleReadySleepers_inlock(const Date_t now) {
     while ((iter != _sleepersQueue.end()) && (iter->readyDate <= now)) {
         auto callback = ReplicationExecutor::_getCallbackFromHandle(iter->callback);
         callback->_isSleeper = false;
-        ++iter;
+        _makeReady_inlock(&_sleepersQueue, iter++);
     }
-    _readyQueue.splice(_readyQueue.end(), _sleepersQueue, _sleepersQueue.begin(), iter);
     if (iter == _sleepersQueue.end()) {
         // indicate no sleeper to wait for
         return Date_t::max();
@@ -539,15 +590,26 @@ StatusWith<ReplicationExecutor::CallbackHandle> ReplicationExecutor::enqueueWork
     work.generation++;
     work.finishedEvent = event.getValue();
     work.readyDate = Date_t();
+    work.isHighPriority = false;
     queue->splice(queue->end(), _freeQueue, iter);
     return StatusWith<CallbackHandle>(work.callback);
 }
 
+void ReplicationExecutor::_makeReady_inlock(WorkQueue* queue, WorkQueue::iterator iter) {
+    if (iter->isHighPriority) {
+        iter->readySince = _networkInterface->now();
+        _highPriorityReadyQueue.splice(_highPriorityReadyQueue.end(), *queue, iter);
+    } else {
+        _readyQueue.splice(_readyQueue.end(), *queue, iter);
+    }
+}
+
 void ReplicationExecutor::waitForDBWork_forTest() {
     _dblockTaskRunner.join();
 }
 
-ReplicationExecutor::WorkItem::WorkItem() : generation(0U), isNetworkOperation(false) {}
+ReplicationExecutor::WorkItem::WorkItem()
+    : generation(0U), isNetworkOperation(false), isHighPriority(false) {}
 
 ReplicationExecutor::Event::Event(ReplicationExecutor* executor, const EventList::iterator& iter)
     : executor::TaskExecutor::EventState(), _executor(executor), _isSignaled(false), _iter(iter) {}
@@ -612,8 +674,7 @@ void ReplicationExecutor::Callback::cancel() {
 
     if (_isSleeper) {
         _isSleeper = false;
-        _executor->_readyQueue.splice(
-            _executor->_readyQueue.end(), _executor->_sleepersQueue, _iter);
+        _executor->_makeReady_inlock(&_executor->_sleepersQueue, _iter);
     }
 
     if (_iter->isNetworkOperation) {
@@ -123,6 +123,18 @@ public:
     void wait(const CallbackHandle& cbHandle) override;
 
     void appendConnectionStats(executor::ConnectionPoolStats* stats) const override;
+    void warmUpConnections(const HostAndPort& hostAndPort) override;
+
+    /**
+     * Like scheduleRemoteCommand() and scheduleWorkAt(), but once ready the callback runs before
+     * any ready normal priority work, in the order high priority work became ready.
+     *
+     * Used for heartbeats and elections, so that failure detection is not delayed by slow
+     * callbacks queued ahead of them.
+     */
+    StatusWith<CallbackHandle> scheduleHighPriorityRemoteCommand(
+        const executor::RemoteCommandRequest& request, const RemoteCommandCallbackFn& cb);
+    StatusWith<CallbackHandle> scheduleHighPriorityWorkAt(Date_t when, const CallbackFn& work);
 
     /**
      * Executes the run loop. May be called up to one time.
@@ -260,6 +272,19 @@ private:
      */
     StatusWith<CallbackHandle> enqueueWork_inlock(WorkQueue* queue, const CallbackFn& callback);
 
+    /**
+     * Moves the work item at "iter" from "queue" to the end of the ready queue matching its
+     * priority.
+     */
+    void _makeReady_inlock(WorkQueue* queue, WorkQueue::iterator iter);
+
+    StatusWith<CallbackHandle> _scheduleRemoteCommand(const executor::RemoteCommandRequest& request,
+                                                      const RemoteCommandCallbackFn& cb,
+                                                      bool isHighPriority);
+    StatusWith<CallbackHandle> _scheduleWorkAt(Date_t when,
+                                               const CallbackFn& work,
+                                               bool isHighPriority);
+
     /**
      * Notifies interested parties that shutdown has completed, if it has.
      */
@@ -319,6 +344,7 @@ private:
     stdx::condition_variable _noMoreWaitingThreads;
     WorkQueue _freeQueue;
     WorkQueue _readyQueue;
+    WorkQueue _highPriorityReadyQueue;
     WorkQueue _dbWorkInProgressQueue;
     WorkQueue _exclusiveLockInProgressQueue;
     WorkQueue _networkInProgressQueue;
@@ -391,6 +417,10 @@ struct ReplicationExecutor::WorkItem {
     EventHandle finishedEvent;
     Date_t readyDate;
     bool isNetworkOperation;
+    bool isHighPriority;
+
+    // When a high priority work item was made ready, for measuring how long it waited to run.
+    Date_t readySince;
 };
 
 /**
@@ -29,6 +29,8 @@
 #include "mongo/platform/basic.h"
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include "mongo/base/init.h"
 #include "mongo/db/bson/dotted_path_support.h"
@@ -271,6 +273,31 @@ TEST_F(ReplicationExecutorTest, ScheduleCallbackAtAFutureTime) {
     executor.waitForEvent(finishEvent);
 }
 
+TEST_F(ReplicationExecutorTest, HighPriorityWorkRunsBeforeReadyWork) {
+    ReplicationExecutor& executor = getReplExecutor();
+    std::vector<std::string> order;
+    auto record = [&order](std::string name) {
+        return [&order, name](const ReplicationExecutor::CallbackArgs& cbData) {
+            ASSERT_OK(cbData.status);
+            order.push_back(name);
+        };
+    };
+
+    // Schedule both callbacks before the executor thread starts so that they are ready together.
+    auto normal = assertGet(executor.scheduleWork(record("normal")));
+    auto highPriority =
+        assertGet(executor.scheduleHighPriorityWorkAt(getNet()->now(), record("highPriority")));
+
+    launchExecutorThread();
+    getNet()->exitNetwork();
+    executor.wait(normal);
+    executor.wait(highPriority);
+
+    ASSERT_EQUALS(2U, order.size());
+    ASSERT_EQUALS("highPriority", order[0]);
+    ASSERT_EQUALS("normal", order[1]);
+}
+
 TEST_F(ReplicationExecutorTest, CallbacksAreInvokedOnClientThreads) {
     launchExecutorThread();
     getNet()->exitNetwork();
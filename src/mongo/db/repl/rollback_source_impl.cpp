@@ -30,6 +30,7 @@
 
 #include "mongo/db/repl/rollback_source_impl.h"
 
+#include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/cloner.h"
 #include "mongo/db/jsobj.h"
@@ -68,6 +69,40 @@ BSONObj RollbackSourceImpl::findOne(const NamespaceString& nss, const BSONObj& f
     return _getConnection()->findOne(nss.toString(), filter, NULL, QueryOption_SlaveOk).getOwned();
 }
 
+std::vector<BSONObj> RollbackSourceImpl::findByIds(const NamespaceString& nss,
+                                                   const std::vector<BSONElement>& ids) const {
+    BSONObjBuilder filter;
+    {
+        BSONObjBuilder idFilter(filter.subobjStart("_id"));
+        BSONArrayBuilder in(idFilter.subarrayStart("$in"));
+        for (auto&& id : ids) {
+            in.append(id);
+        }
+    }
+
+    std::unique_ptr<DBClientCursor> cursor =
+        _getConnection()->query(nss.toString(), filter.obj(), 0, 0, nullptr, QueryOption_SlaveOk);
+    uassert(40409, str::stream() << "failed to query " << nss.ns() << " on " << _source, cursor);
+
+    // Match the results up with the requested _ids the same way rollback keys documents.
+    const StringData::ComparatorInterface* stringComparator = nullptr;
+    BSONElementComparator eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, stringComparator);
+    auto found = eltCmp.makeBSONEltIndexedMap<BSONObj>();
+    while (cursor->more()) {
+        BSONObj doc = cursor->nextSafe().getOwned();
+        BSONElement id = doc["_id"];
+        found.emplace(id, std::move(doc));
+    }
+
+    std::vector<BSONObj> docs;
+    docs.reserve(ids.size());
+    for (auto&& id : ids) {
+        auto it = found.find(id);
+        docs.push_back(it == found.end() ? BSONObj() : it->second);
+    }
+    return docs;
+}
+
 void RollbackSourceImpl::copyCollectionFromRemote(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {
     std::string errmsg;
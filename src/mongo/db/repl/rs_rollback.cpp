@@ -64,6 +64,7 @@
 #include "mongo/db/repl/rslog.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -125,6 +126,9 @@ namespace repl {
 MONGO_FP_DECLARE(rollbackHangBeforeFinish);
 MONGO_FP_DECLARE(rollbackHangThenFailAfterWritingMinValid);
 
+// The maximum number of documents refetched from the sync source with a single query.
+MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchBatchSize, int, 1000);
+
 using namespace rollback_internal;
 
 bool DocID::operator<(const DocID& other) const {
@@ -387,34 +391,52 @@ void syncFixUp(OperationContext* opCtx,
     // namespace -> doc id -> doc
     map<string, map<DocID, BSONObj>> goodVersions;
 
-    // fetch all the goodVersions of each document from current primary
+    // fetch all the goodVersions of each document from current primary. docsToRefetch is ordered
+    // by namespace, so consecutive documents of the same collection are fetched with one query.
+    const size_t maxBatchSize = std::max(1, rollbackRefetchBatchSize.load());
+    const int maxBatchIdBytes = BSONObjMaxUserSize / 2;
     unsigned long long numFetched = 0;
-    for (auto&& doc : fixUpInfo.docsToRefetch) {
-        invariant(!doc._id.eoo());  // This is checked when we insert to the set.
+    auto batchBegin = fixUpInfo.docsToRefetch.begin();
+    while (batchBegin != fixUpInfo.docsToRefetch.end()) {
+        const char* ns = batchBegin->ns;
+        std::vector<BSONElement> ids;
+        int idBytes = 0;
+        auto batchEnd = batchBegin;
+        while (batchEnd != fixUpInfo.docsToRefetch.end() && strcmp(batchEnd->ns, ns) == 0 &&
+               ids.size() < maxBatchSize && idBytes < maxBatchIdBytes) {
+            invariant(!batchEnd->_id.eoo());  // This is checked when we insert to the set.
+            ids.push_back(batchEnd->_id);
+            idBytes += batchEnd->_id.size();
+            ++batchEnd;
+        }
 
         try {
-            // TODO : slow.  lots of round trips.
-            numFetched++;
-            BSONObj good = rollbackSource.findOne(NamespaceString(doc.ns), doc._id.wrap());
-            totalSize += good.objsize();
-            if (totalSize >= 300 * 1024 * 1024) {
-                throw RSFatalException("replSet too much data to roll back");
-            }
+            numFetched += ids.size();
+            std::vector<BSONObj> goodDocs = rollbackSource.findByIds(NamespaceString(ns), ids);
+            invariant(goodDocs.size() == ids.size());
+
+            auto doc = batchBegin;
+            for (auto&& good : goodDocs) {
+                totalSize += good.objsize();
+                if (totalSize >= 300 * 1024 * 1024) {
+                    throw RSFatalException("replSet too much data to roll back");
+                }
 
-            // Note good might be empty, indicating we should delete it.
-            goodVersions[doc.ns][doc] = good;
+                // Note good might be empty, indicating we should delete it.
+                goodVersions[ns][*doc++] = good;
+            }
         } catch (const DBException& ex) {
             // If the collection turned into a view, we might get an error trying to
             // refetch documents, but these errors should be ignored, as we'll be creating
             // the view during oplog replay.
-            if (ex.getCode() == ErrorCodes::CommandNotSupportedOnView)
-                continue;
-
-            log() << "rollback couldn't re-get from ns: " << doc.ns << " _id: " << redact(doc._id)
-                  << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
-                  << redact(ex);
-            throw;
+            if (ex.getCode() != ErrorCodes::CommandNotSupportedOnView) {
+                log() << "rollback couldn't re-get " << ids.size() << " documents from ns: " << ns
+                      << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
+                      << redact(ex);
+                throw;
+            }
         }
+        batchBegin = batchEnd;
     }
 
     log() << "rollback 3.5";
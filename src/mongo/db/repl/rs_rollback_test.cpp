@@ -72,6 +72,8 @@ public:
     const OplogInterface& getOplog() const override;
     BSONObj getLastOperation() const override;
     BSONObj findOne(const NamespaceString& nss, const BSONObj& filter) const override;
+    std::vector<BSONObj> findByIds(const NamespaceString& nss,
+                                   const std::vector<BSONElement>& ids) const override;
     void copyCollectionFromRemote(OperationContext* opCtx,
                                   const NamespaceString& nss) const override;
     StatusWith<BSONObj> getCollectionInfo(const NamespaceString& nss) const override;
@@ -102,6 +104,15 @@ BSONObj RollbackSourceMock::findOne(const NamespaceString& nss, const BSONObj& f
     return BSONObj();
 }
 
+std::vector<BSONObj> RollbackSourceMock::findByIds(const NamespaceString& nss,
+                                                   const std::vector<BSONElement>& ids) const {
+    std::vector<BSONObj> docs;
+    for (auto&& id : ids) {
+        docs.push_back(findOne(nss, id.wrap()));
+    }
+    return docs;
+}
+
 void RollbackSourceMock::copyCollectionFromRemote(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {}
 
@@ -1019,7 +1030,14 @@ TEST_F(RSRollbackTest, RollbackApplyOpsCommand) {
             return {};  // Unreachable; why doesn't compiler know?
         }
 
+        std::vector<BSONObj> findByIds(const NamespaceString& nss,
+                                       const std::vector<BSONElement>& ids) const override {
+            ++numBatches;
+            return RollbackSourceMock::findByIds(nss, ids);
+        }
+
         mutable std::multiset<int> searchedIds;
+        mutable int numBatches = 0;
     } rollbackSource(std::unique_ptr<OplogInterface>(new OplogInterfaceMock({commonOperation})));
 
     _createCollection(_opCtx.get(), "test.t", CollectionOptions());
@@ -1029,6 +1047,7 @@ TEST_F(RSRollbackTest, RollbackApplyOpsCommand) {
                            {},
                            _coordinator,
                            &_storageInterface));
+    ASSERT_EQUALS(1, rollbackSource.numBatches);
     ASSERT_EQUALS(4U, rollbackSource.searchedIds.size());
     ASSERT_EQUALS(1U, rollbackSource.searchedIds.count(1));
     ASSERT_EQUALS(1U, rollbackSource.searchedIds.count(2));
@@ -99,7 +99,7 @@ StatusWith<EventHandle> ScatterGatherRunner::RunnerImpl::start(
     std::vector<RemoteCommandRequest> requests = _algorithm->getRequests();
     for (size_t i = 0; i < requests.size(); ++i) {
         const StatusWith<CallbackHandle> cbh =
-            _executor->scheduleRemoteCommand(requests[i], processResponseCB);
+            _executor->scheduleHighPriorityRemoteCommand(requests[i], processResponseCB);
         if (cbh.getStatus() == ErrorCodes::ShutdownInProgress) {
             return StatusWith<EventHandle>(cbh.getStatus());
         }
@@ -68,12 +68,14 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/concurrency/threadlocal.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -133,6 +135,10 @@ public:
     }
 } exportedBatchLimitOperationsParam;
 
+// Whether batches are prefetched on storage engines with document level locking. Batches are
+// always prefetched on MMAPv1.
+MONGO_EXPORT_SERVER_PARAMETER(replPrefetchWithDocLocking, bool, false);
+
 // The oplog entries applied
 Counter64 opsAppliedStats;
 ServerStatusMetricField<Counter64> displayOpsApplied("repl.apply.ops", &opsAppliedStats);
@@ -145,6 +151,61 @@ ServerStatusMetricField<Counter64> displayAttemptsToBecomeSecondary(
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
+
+/**
+ * Tracks how the work of applying batches is spread across the writer threads, for
+ * serverStatus metrics.repl.apply.writers. A writer is busy while it applies operations, and
+ * idle for the rest of each batch's apply phase.
+ */
+class WriterThreadStats : public ServerStatusMetric {
+public:
+    WriterThreadStats() : ServerStatusMetric("repl.apply.writers") {}
+
+    /**
+     * Records 'micros' of application work done by the calling writer thread.
+     */
+    void recordWork(int64_t micros) {
+        // Writer threads are numbered in the order in which they first apply operations.
+        static MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL int writerSlot;
+        if (writerSlot == 0) {
+            writerSlot = _numWriters.addAndFetch(1);
+        }
+        _busyMicros[(writerSlot - 1) % kMaxWriters].fetchAndAdd(micros);
+    }
+
+    /**
+     * Records that applying a batch took 'micros', from scheduling the first writer vector to
+     * the last one completing.
+     */
+    void recordBatch(int64_t micros) {
+        _applyMicros.fetchAndAdd(micros);
+    }
+
+    virtual void appendAtLeaf(BSONObjBuilder& b) const {
+        BSONObjBuilder writers(b.subobjStart(_leafName));
+        const long long applyMicros = _applyMicros.load();
+        writers.append("applyMicros", applyMicros);
+
+        BSONArrayBuilder perWriter(writers.subarrayStart("perWriter"));
+        const int numWriters = std::min(_numWriters.load(), kMaxWriters);
+        for (int i = 0; i < numWriters; i++) {
+            const long long busyMicros = _busyMicros[i].load();
+            BSONObjBuilder writer(perWriter.subobjStart());
+            writer.append("busyMicros", busyMicros);
+            writer.append("idleMicros", std::max(0LL, applyMicros - busyMicros));
+        }
+        perWriter.done();
+        writers.done();
+    }
+
+private:
+    // The maximum value of replWriterThreadCount.
+    static const int kMaxWriters = 256;
+
+    AtomicInt64 _applyMicros;
+    AtomicInt32 _numWriters;
+    AtomicInt64 _busyMicros[kMaxWriters];
+} writerThreadStats;
 void initializePrefetchThread() {
     if (!Client::getCurrent()) {
         Client::initThreadIfNotAlready();
@@ -290,10 +351,14 @@ Status SyncTail::syncApply(OperationContext* opCtx,
     // Count each log op application as a separate operation, for reporting purposes
     CurOp individualOp(opCtx);
 
-    const char* ns = op.getStringField("ns");
+    // Find both fields in a single pass over the operation.
+    const char* names[] = {"ns", "op"};
+    BSONElement fields[2];
+    op.getFields(2, names, fields);
+    const char* ns = fields[0].type() == String ? fields[0].valuestr() : "";
     verify(ns);
 
-    const char* opType = op["op"].valuestrsafe();
+    const char* opType = fields[1].valuestrsafe();
 
     bool isCommand(opType[0] == 'c');
     bool isNoOp(opType[0] == 'n');
@@ -441,7 +506,8 @@ void prefetchOps(const MultiApplier::Operations& ops, OldThreadPool* prefetcherP
     prefetcherPool->join();
 }
 
-// Doles out all the work to the writer pool threads.
+// Doles out all the work to the writer pool threads. There may be more writer vectors than
+// threads, in which case threads pick up the remaining vectors as they finish their previous ones.
 // Does not modify writerVectors, but passes non-const pointers to inner vectors into func.
 void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
               OldThreadPool* writerPool,
@@ -452,12 +518,31 @@ void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
     for (size_t i = 0; i < writerVectors.size(); i++) {
         if (!writerVectors[i].empty()) {
             writerPool->schedule([&func, &writerVectors, statusVector, i] {
+                Timer t;
                 (*statusVector)[i] = func(&writerVectors[i]);
+                writerThreadStats.recordWork(t.micros());
             });
         }
     }
 }
 
+/**
+ * Returns the number of writer vectors to split a batch of 'numOps' operations into.
+ *
+ * Hashing assigns whole collections (or, for doc-locking engines, documents) to writer vectors,
+ * so with only one vector per thread a skewed batch leaves most threads idle while one works
+ * through the largest vector. Large batches are therefore split into several vectors per
+ * thread, which the pool hands to threads as they free up. Small batches keep one vector per
+ * thread so that there is enough work in each vector to group inserts.
+ */
+size_t numWriterVectors(size_t numOps, size_t numThreads) {
+    const size_t kMinOpsPerWriterVector = 64;
+    const size_t kMaxWriterVectorsPerThread = 8;
+
+    const size_t numVectors = numOps / kMinOpsPerWriterVector;
+    return std::max(numThreads, std::min(numVectors, numThreads * kMaxWriterVectorsPerThread));
+}
+
 void initializeWriterThread() {
     // Only do this once per thread
     if (!Client::getCurrent()) {
@@ -832,25 +917,34 @@ void SyncTail::oplogApplication(ReplicationCoordinator* replCoord) {
 bool SyncTail::tryPopAndWaitForMore(OperationContext* opCtx,
                                     SyncTail::OpQueue* ops,
                                     const BatchLimits& limits) {
-    {
-        BSONObj op;
-        // Check to see if there are ops waiting in the bgsync queue
-        bool peek_success = peek(opCtx, &op);
-        if (!peek_success) {
-            // If we don't have anything in the queue, wait a bit for something to appear.
-            if (ops->empty()) {
-                if (_networkQueue->inShutdown()) {
-                    ops->setMustShutdownFlag();
-                } else {
-                    // Block up to 1 second. We still return true in this case because we want this
-                    // op to be the first in a new batch with a new start time.
-                    _networkQueue->waitForMore();
-                }
+    // Check to see if there are ops waiting in the bgsync queue. Peek at as many as could still
+    // fit in this batch so that the queue is only locked once for all of them.
+    OplogBuffer::Batch peeked;
+    const size_t maxCount = limits.ops > ops->getCount() ? limits.ops - ops->getCount() : 1U;
+    if (_networkQueue->peekBatch(opCtx, maxCount, &peeked) == 0) {
+        // If we don't have anything in the queue, wait a bit for something to appear.
+        if (ops->empty()) {
+            if (_networkQueue->inShutdown()) {
+                ops->setMustShutdownFlag();
+            } else {
+                // Block up to 1 second. We still return true in this case because we want this
+                // op to be the first in a new batch with a new start time.
+                _networkQueue->waitForMore();
             }
+        }
 
-            return true;
+        return true;
+    }
+
+    // The ops added to the batch are taken off the queue together on the way out.
+    size_t numToConsume = 0;
+    ON_BLOCK_EXIT([&] {
+        if (numToConsume > 0) {
+            _networkQueue->consume(opCtx, numToConsume);
         }
+    });
 
+    for (auto&& op : peeked) {
         // If this op would put us over the byte limit don't include it unless the batch is empty.
         // We allow single-op batches to exceed the byte limit so that large ops are able to be
         // processed.
@@ -865,65 +959,70 @@ bool SyncTail::tryPopAndWaitForMore(OperationContext* opCtx,
         }
 
         ops->emplace_back(std::move(op));  // Parses the op in-place.
-    }
-
-    auto& entry = ops->back();
+        auto& entry = ops->back();
+
+        if (!entry.raw.isEmpty()) {
+            // check for oplog version change
+            int curVersion = 0;
+            if (entry.version.eoo()) {
+                // missing version means version 1
+                curVersion = 1;
+            } else {
+                curVersion = entry.version.Int();
+            }
 
-    if (!entry.raw.isEmpty()) {
-        // check for oplog version change
-        int curVersion = 0;
-        if (entry.version.eoo()) {
-            // missing version means version 1
-            curVersion = 1;
-        } else {
-            curVersion = entry.version.Int();
+            if (curVersion != OplogEntry::kOplogVersion) {
+                severe() << "expected oplog version " << OplogEntry::kOplogVersion
+                         << " but found version " << curVersion
+                         << " in oplog entry: " << redact(entry.raw);
+                fassertFailedNoTrace(18820);
+            }
         }
 
-        if (curVersion != OplogEntry::kOplogVersion) {
-            severe() << "expected oplog version " << OplogEntry::kOplogVersion
-                     << " but found version " << curVersion
-                     << " in oplog entry: " << redact(entry.raw);
-            fassertFailedNoTrace(18820);
+        if (limits.slaveDelayLatestTimestamp &&
+            entry.ts.timestampTime() > *limits.slaveDelayLatestTimestamp) {
+
+            ops->pop_back();  // Don't do this op yet.
+            if (ops->empty()) {
+                // Sleep if we've got nothing to do. Only sleep for 1 second at a time to allow
+                // reconfigs and shutdown to occur.
+                sleepsecs(1);
+            }
+            return true;
         }
-    }
 
-    if (limits.slaveDelayLatestTimestamp &&
-        entry.ts.timestampTime() > *limits.slaveDelayLatestTimestamp) {
+        // Check for ops that must be processed one at a time.
+        if (entry.raw.isEmpty() ||       // sentinel that network queue is drained.
+            (entry.opType[0] == 'c') ||  // commands.
+            // Index builds are achieved through the use of an insert op, not a command op.
+            // The following line is the same as what the insert code uses to detect an index
+            // build.
+            (!entry.ns.empty() && nsToCollectionSubstring(entry.ns) == "system.indexes")) {
+            if (ops->getCount() == 1) {
+                // apply commands one-at-a-time
+                ++numToConsume;
+            } else {
+                // This op must be processed alone, but we already had ops in the queue so we
+                // can't include it in this batch. Since we don't consume it, we'll see this again
+                // next time and process it alone.
+                ops->pop_back();
+            }
 
-        ops->pop_back();  // Don't do this op yet.
-        if (ops->empty()) {
-            // Sleep if we've got nothing to do. Only sleep for 1 second at a time to allow
-            // reconfigs and shutdown to occur.
-            sleepsecs(1);
+            // Apply what we have so far.
+            return true;
         }
-        return true;
-    }
 
-    // Check for ops that must be processed one at a time.
-    if (entry.raw.isEmpty() ||       // sentinel that network queue is drained.
-        (entry.opType[0] == 'c') ||  // commands.
-        // Index builds are achieved through the use of an insert op, not a command op.
-        // The following line is the same as what the insert code uses to detect an index build.
-        (!entry.ns.empty() && nsToCollectionSubstring(entry.ns) == "system.indexes")) {
-        if (ops->getCount() == 1) {
-            // apply commands one-at-a-time
-            _networkQueue->consume(opCtx);
-        } else {
-            // This op must be processed alone, but we already had ops in the queue so we can't
-            // include it in this batch. Since we didn't call consume(), we'll see this again next
-            // time and process it alone.
-            ops->pop_back();
-        }
+        // We are going to apply this Op.
+        ++numToConsume;
 
-        // Apply what we have so far.
-        return true;
+        // Stop adding ops once we've hit the limit.
+        if (ops->getCount() >= limits.ops) {
+            return true;
+        }
     }
 
-    // We are going to apply this Op.
-    _networkQueue->consume(opCtx);
-
-    // Go back for more ops, unless we've hit the limit.
-    return ops->getCount() >= limits.ops;
+    // Go back for more ops.
+    return false;
 }
 
 void SyncTail::setHostname(const std::string& hostname) {
@@ -1076,20 +1175,22 @@ Status multiSyncApply_noAbort(OperationContext* opCtx,
     // This function is only called in steady state replication.
     const bool inSteadyStateReplication = true;
 
-    // doNotGroupBeforePoint is used to prevent retrying bad group inserts by marking the final op
-    // of a failed group and not allowing further group inserts until that op has been processed.
-    auto doNotGroupBeforePoint = oplogEntryPointers->begin();
+    // Group inserts into batches of the same size as those used for inserts on primaries.
+    const int64_t maxGroupCount = internalInsertMaxBatchSize.load();
+
+    // groupingAllowedFrom is used to prevent retrying bad group inserts by marking the op after a
+    // failed group and not allowing further group inserts until that op has been reached.
+    auto groupingAllowedFrom = oplogEntryPointers->begin();
 
     for (auto oplogEntriesIterator = oplogEntryPointers->begin();
          oplogEntriesIterator != oplogEntryPointers->end();
          ++oplogEntriesIterator) {
         auto entry = *oplogEntriesIterator;
         if (entry->opType[0] == 'i' && !entry->isForCappedCollection &&
-            oplogEntriesIterator > doNotGroupBeforePoint) {
+            oplogEntriesIterator >= groupingAllowedFrom) {
             // Attempt to group inserts if possible.
-            std::vector<BSONObj> toInsert;
-            int batchSize = 0;
-            int batchCount = 0;
+            int64_t batchSize = entry->o.Obj().objsize();
+            int64_t batchCount = 1;
             auto endOfGroupableOpsIterator = std::find_if(
                 oplogEntriesIterator + 1,
                 oplogEntryPointers->end(),
@@ -1098,7 +1199,7 @@ Status multiSyncApply_noAbort(OperationContext* opCtx,
                         nextEntry->ns != entry->ns ||      // Must be the same namespace.
                         // Must not create too large an object.
                         (batchSize += nextEntry->o.Obj().objsize()) > insertVectorMaxBytes ||
-                        ++batchCount >= 64;  // Or have too many entries.
+                        ++batchCount > maxGroupCount;  // Or have too many entries.
                 });
 
             if (endOfGroupableOpsIterator != oplogEntriesIterator + 1) {
@@ -1137,7 +1238,7 @@ Status multiSyncApply_noAbort(OperationContext* opCtx,
 
                     // Avoid quadratic run time from failed insert by not retrying until we
                     // are beyond this group of ops.
-                    doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+                    groupingAllowedFrom = endOfGroupableOpsIterator;
                 }
             }
         }
@@ -1254,7 +1355,8 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
         return {ErrorCodes::BadValue, "invalid apply operation function"};
     }
 
-    if (getGlobalServiceContext()->getGlobalStorageEngine()->isMmapV1()) {
+    if (getGlobalServiceContext()->getGlobalStorageEngine()->isMmapV1() ||
+        replPrefetchWithDocLocking.load()) {
         // Use a ThreadPool to prefetch all the operations in a batch.
         prefetchOps(ops, workerPool);
     }
@@ -1273,11 +1375,12 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
                 "attempting to replicate ops while primary"};
     }
 
-    std::vector<Status> statusVector(workerPool->getNumThreads(), Status::OK());
+    const size_t numVectors = numWriterVectors(ops.size(), workerPool->getNumThreads());
+    std::vector<Status> statusVector(numVectors, Status::OK());
     {
         // We must wait for the all work we've dispatched to complete before leaving this block
         // because the spawned threads refer to objects on our stack, including writerVectors.
-        std::vector<MultiApplier::OperationPtrs> writerVectors(workerPool->getNumThreads());
+        std::vector<MultiApplier::OperationPtrs> writerVectors(numVectors);
         ON_BLOCK_EXIT([&] { workerPool->join(); });
 
         storage->setOplogDeleteFromPoint(opCtx, ops.front().ts.timestamp());
@@ -1289,7 +1392,10 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
         storage->setOplogDeleteFromPoint(opCtx, Timestamp());
         storage->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
 
+        Timer applyTimer;
         applyOps(writerVectors, workerPool, applyOperation, &statusVector);
+        workerPool->join();
+        writerThreadStats.recordBatch(applyTimer.micros());
     }
 
     // If any of the statuses is not ok, return error.
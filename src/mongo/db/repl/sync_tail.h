@@ -191,7 +191,8 @@ public:
     };
 
     /**
-     * Attempts to pop an OplogEntry off the BGSync queue and add it to ops.
+     * Attempts to pop OplogEntries off the BGSync queue and add them to ops. The queue is peeked
+     * and consumed a run of entries at a time rather than entry by entry.
      *
      * Returns true if the (possibly empty) batch in ops should be ended and a new one started.
      * If ops is empty on entry and nothing can be added yet, will wait up to a second before
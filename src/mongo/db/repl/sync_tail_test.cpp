@@ -29,6 +29,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_interface_local.h"
@@ -59,6 +61,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/old_thread_pool.h"
 #include "mongo/util/md5.hpp"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/string_map.h"
 
 namespace {
@@ -604,6 +607,64 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_BSONOBJ_EQ(op2.raw, operationsWrittenToOplog[1]);
 }
 
+TEST_F(SyncTailTest, MultiApplySplitsLargeBatchesIntoMoreWriterVectorsThanThreads) {
+    OldThreadPool writerPool(2);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn = [&mutex, &operationsApplied](
+        MultiApplier::OperationPtrs* operationsForWriterThreadToApply) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    const int kNumNamespaces = 64;
+    const int kOpsPerNamespace = 16;
+    MultiApplier::Operations ops;
+    for (int i = 0; i < kNumNamespaces * kOpsPerNamespace; i++) {
+        NamespaceString nss(str::stream() << "test.t" << (i % kNumNamespaces));
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(i + 1), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+    _storageInterface->insertDocumentsFn =
+        [](OperationContext*, const NamespaceString&, const std::vector<BSONObj>&) {
+            return Status::OK();
+        };
+
+    auto lastOpTime =
+        unittest::assertGet(multiApply(_opCtx.get(), &writerPool, ops, applyOperationFn));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    ASSERT_GREATER_THAN(operationsApplied.size(), 2U);
+
+    // Every operation is applied once, and the operations for each namespace are applied by a
+    // single writer in their original order.
+    std::map<std::string, size_t> vectorForNamespace;
+    std::map<std::string, Timestamp> lastTimestampForNamespace;
+    size_t numApplied = 0;
+    for (size_t i = 0; i < operationsApplied.size(); i++) {
+        for (auto&& op : operationsApplied[i]) {
+            numApplied++;
+            auto ns = op.ns.toString();
+            auto it = vectorForNamespace.find(ns);
+            if (it == vectorForNamespace.end()) {
+                vectorForNamespace[ns] = i;
+            } else {
+                ASSERT_EQUALS(it->second, i);
+                ASSERT_LESS_THAN(lastTimestampForNamespace[ns], op.getOpTime().getTimestamp());
+            }
+            lastTimestampForNamespace[ns] = op.getOpTime().getTimestamp();
+        }
+    }
+    ASSERT_EQUALS(ops.size(), numApplied);
+    ASSERT_EQUALS(static_cast<size_t>(kNumNamespaces), vectorForNamespace.size());
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -735,6 +796,35 @@ TEST_F(SyncTailTest, MultiSyncApplyGroupsInsertOperationByNamespaceBeforeApplyin
     ASSERT_BSONOBJ_EQ(insertOp2b.o.Obj(), group2[1].Obj());
 }
 
+TEST_F(SyncTailTest, MultiSyncApplyGroupsInsertOperationsAtStartOfWriterVector) {
+    int seconds = 0;
+    auto makeOp = [&seconds](const NamespaceString& nss) {
+        return makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(seconds), 0), 1LL}, nss, BSON("_id" << seconds++));
+    };
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    auto insertOp1 = makeOp(nss);
+    auto insertOp2 = makeOp(nss);
+    auto insertOp3 = makeOp(nss);
+    MultiApplier::Operations operationsApplied;
+    auto syncApply = [&operationsApplied](OperationContext*, const BSONObj& op, bool) {
+        operationsApplied.push_back(OplogEntry(op));
+        return Status::OK();
+    };
+
+    MultiApplier::OperationPtrs ops = {&insertOp1, &insertOp2, &insertOp3};
+    ASSERT_OK(multiSyncApply_noAbort(_opCtx.get(), &ops, syncApply));
+
+    ASSERT_EQUALS(1U, operationsApplied.size());
+    ASSERT_EQUALS(insertOp1.getOpTime(), operationsApplied[0].getOpTime());
+    ASSERT_EQUALS(BSONType::Array, operationsApplied[0].o.type());
+    auto group = operationsApplied[0].o.Array();
+    ASSERT_EQUALS(3U, group.size());
+    ASSERT_BSONOBJ_EQ(insertOp1.o.Obj(), group[0].Obj());
+    ASSERT_BSONOBJ_EQ(insertOp2.o.Obj(), group[1].Obj());
+    ASSERT_BSONOBJ_EQ(insertOp3.o.Obj(), group[2].Obj());
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesLimitWhenGroupingInsertOperation) {
     int seconds = 0;
     auto makeOp = [&seconds](const NamespaceString& nss) {
@@ -746,7 +836,7 @@ TEST_F(SyncTailTest, MultiSyncApplyUsesLimitWhenGroupingInsertOperation) {
 
     // Generate operations to apply:
     // {create}, {insert_1}, {insert_2}, .. {insert_(limit)}, {insert_(limit+1)}
-    std::size_t limit = 64;
+    std::size_t limit = internalInsertMaxBatchSize.load();
     MultiApplier::Operations insertOps;
     for (std::size_t i = 0; i < limit + 1; ++i) {
         insertOps.push_back(makeOp(nss));
@@ -797,7 +887,7 @@ TEST_F(SyncTailTest, MultiSyncApplyFallsBackOnApplyingInsertsIndividuallyWhenGro
 
     // Generate operations to apply:
     // {create}, {insert_1}, {insert_2}, .. {insert_(limit)}, {insert_(limit+1)}
-    std::size_t limit = 64;
+    std::size_t limit = internalInsertMaxBatchSize.load();
     MultiApplier::Operations insertOps;
     for (std::size_t i = 0; i < limit + 1; ++i) {
         insertOps.push_back(makeOp(nss));
@@ -242,15 +242,22 @@ HostAndPort TopologyCoordinatorImpl::chooseNewSyncSource(Date_t now,
 
     int closestIndex = -1;
 
-    // Make two attempts, with less restrictive rules the second time.
+    const int regionalHubIndex = _getRegionalHubIndex(now);
+    const std::string selfRegion = _getRegion(_selfConfig());
+
+    // Make up to three attempts, with less restrictive rules each time.
+    //
+    // The first attempt is only made if we have a regional hub. It only considers the hub, or,
+    // on the hub itself, members outside of our region, so that the oplog crosses into the region
+    // once.
     //
-    // During the first attempt, we ignore those nodes that have a larger slave
+    // During the second attempt, we ignore those nodes that have a larger slave
     // delay, hidden nodes or non-voting, and nodes that are excessively behind.
     //
-    // For the second attempt include those nodes, in case those are the only ones we can reach.
+    // For the last attempt include those nodes, in case those are the only ones we can reach.
     //
     // This loop attempts to set 'closestIndex', to select a viable candidate.
-    for (int attempts = 0; attempts < 2; ++attempts) {
+    for (int attempts = regionalHubIndex == -1 ? 1 : 0; attempts < 3; ++attempts) {
         for (std::vector<MemberHeartbeatData>::const_iterator it = _hbdata.begin();
              it != _hbdata.end();
              ++it) {
@@ -275,8 +282,23 @@ HostAndPort TopologyCoordinatorImpl::chooseNewSyncSource(Date_t now,
                 continue;
             }
 
-            // On the first attempt, we skip candidates that do not match these criteria.
             if (attempts == 0) {
+                // Candidate must be our regional hub, unless we are the hub.
+                if (regionalHubIndex != _selfIndex && itIndex != regionalHubIndex) {
+                    LOG(2) << "Cannot select sync source because it is not our regional hub: "
+                           << itMemberConfig.getHostAndPort();
+                    continue;
+                }
+                // The hub must sync from outside of its region.
+                if (regionalHubIndex == _selfIndex && _getRegion(itMemberConfig) == selfRegion) {
+                    LOG(2) << "Cannot select sync source because we are the hub of its region: "
+                           << itMemberConfig.getHostAndPort();
+                    continue;
+                }
+            }
+
+            // On the first two attempts, we skip candidates that do not match these criteria.
+            if (attempts < 2) {
                 // Candidate must be a voter if we are a voter.
                 if (_selfConfig().isVoter() && !itMemberConfig.isVoter()) {
                     LOG(2) << "Cannot select sync source because we are a voter and it is not: "
@@ -375,6 +397,50 @@ bool TopologyCoordinatorImpl::_memberIsBlacklisted(const MemberConfig& memberCon
     return false;
 }
 
+std::string TopologyCoordinatorImpl::_getRegion(const MemberConfig& memberConfig) const {
+    if (_options.syncSourceRegionTag.empty()) {
+        return std::string();
+    }
+    const ReplSetTagConfig& tagConfig = _rsConfig.getTagConfig();
+    for (MemberConfig::TagIterator tag = memberConfig.tagsBegin(); tag != memberConfig.tagsEnd();
+         ++tag) {
+        if (tagConfig.getTagKey(*tag) == _options.syncSourceRegionTag) {
+            return tagConfig.getTagValue(*tag);
+        }
+    }
+    return std::string();
+}
+
+int TopologyCoordinatorImpl::_getRegionalHubIndex(Date_t now) const {
+    const std::string selfRegion = _getRegion(_selfConfig());
+    if (selfRegion.empty()) {
+        return -1;
+    }
+
+    // Members of the primary's region sync without a hub.
+    if (_currentPrimaryIndex != -1 &&
+        _getRegion(_rsConfig.getMemberAt(_currentPrimaryIndex)) == selfRegion) {
+        return -1;
+    }
+
+    for (int i = 0; i < _rsConfig.getNumMembers(); ++i) {
+        const MemberConfig& memberConfig = _rsConfig.getMemberAt(i);
+        if (memberConfig.isArbiter() || memberConfig.isHidden() ||
+            memberConfig.getSlaveDelay() > Seconds(0) || _getRegion(memberConfig) != selfRegion) {
+            continue;
+        }
+        if (i == _selfIndex) {
+            return i;
+        }
+        const MemberHeartbeatData& hbData = _hbdata.at(i);
+        if (hbData.up() && hbData.getState().readable() &&
+            !_memberIsBlacklisted(memberConfig, now)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void TopologyCoordinatorImpl::blacklistSyncSource(const HostAndPort& host, Date_t until) {
     LOG(2) << "blacklisting " << host << " until " << until.toString();
     _syncSourceBlacklist[host] = until;
@@ -129,6 +129,10 @@ public:
 
         // Whether or not this node is running as a config server.
         ClusterRole clusterRole{ClusterRole::None};
+
+        // The key of the member tag naming each member's region. When set, the members of a
+        // region that does not contain the primary sync through a single hub in that region.
+        std::string syncSourceRegionTag;
     };
 
     /**
@@ -384,6 +388,20 @@ private:
      **/
     bool _memberIsBlacklisted(const MemberConfig& memberConfig, Date_t now) const;
 
+    /**
+     * Returns the value of the member's tag named by Options::syncSourceRegionTag, or an empty
+     * string if that option is unset or the member has no such tag.
+     */
+    std::string _getRegion(const MemberConfig& memberConfig) const;
+
+    /**
+     * Returns the index of the member that fetches the oplog from outside of this node's region
+     * and relays it to the rest of the region, or -1 if this node is not in a region or its region
+     * contains the primary. The hub is the first data bearing member of the region, in config
+     * order, that is not hidden or delayed and, unless it is us, is up and readable.
+     */
+    int _getRegionalHubIndex(Date_t now) const;
+
     // This node's role in the replication protocol.
     Role _role;
 
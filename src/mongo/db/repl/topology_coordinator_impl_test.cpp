@@ -502,6 +502,138 @@ TEST_F(TopoCoordTest, NodeReturnsClosestValidSyncSourceAsSyncSource) {
     ASSERT(getTopoCoord().getSyncSourceAddress().empty());
 }
 
+TEST_F(TopoCoordTest, ChooseRegionalHubAsSyncSourceWhenRegionDoesNotContainPrimary) {
+    TopologyCoordinatorImpl::Options options;
+    options.maxSyncSourceLagSecs = Seconds{100};
+    options.syncSourceRegionTag = "region";
+    setOptions(options);
+
+    updateConfig(BSON("_id"
+                      << "rs0"
+                      << "version"
+                      << 1
+                      << "members"
+                      << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                               << "hhub"
+                                               << "tags"
+                                               << BSON("region"
+                                                       << "east"))
+                                    << BSON("_id" << 1 << "host"
+                                                  << "hself"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "east"))
+                                    << BSON("_id" << 2 << "host"
+                                                  << "hprimary"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "west"))
+                                    << BSON("_id" << 3 << "host"
+                                                  << "hwest"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "west")))),
+                 1);
+
+    setSelfMemberState(MemberState::RS_SECONDARY);
+    OpTime lastOpTimeWeApplied = OpTime(Timestamp(100, 0), 0);
+
+    for (int round = 0; round < 2; ++round) {
+        heartbeatFromMember(HostAndPort("hhub"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(300));
+        heartbeatFromMember(HostAndPort("hprimary"),
+                            "rs0",
+                            MemberState::RS_PRIMARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(100));
+        heartbeatFromMember(HostAndPort("hwest"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(50));
+    }
+
+    // The hub is chosen even though the members of the other region are closer.
+    getTopoCoord().chooseNewSyncSource(
+        now()++, lastOpTimeWeApplied, TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("hhub"), getTopoCoord().getSyncSourceAddress());
+
+    // Once the hub is down we become the hub, and sync from the closest member of the other region.
+    receiveDownHeartbeat(HostAndPort("hhub"), "rs0", OpTime());
+    getTopoCoord().chooseNewSyncSource(
+        now()++, lastOpTimeWeApplied, TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("hwest"), getTopoCoord().getSyncSourceAddress());
+}
+
+TEST_F(TopoCoordTest, RegionalHubChoosesSyncSourceOutsideOfItsRegion) {
+    TopologyCoordinatorImpl::Options options;
+    options.maxSyncSourceLagSecs = Seconds{100};
+    options.syncSourceRegionTag = "region";
+    setOptions(options);
+
+    updateConfig(BSON("_id"
+                      << "rs0"
+                      << "version"
+                      << 1
+                      << "members"
+                      << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                               << "hself"
+                                               << "tags"
+                                               << BSON("region"
+                                                       << "east"))
+                                    << BSON("_id" << 1 << "host"
+                                                  << "heast"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "east"))
+                                    << BSON("_id" << 2 << "host"
+                                                  << "hprimary"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "west"))
+                                    << BSON("_id" << 3 << "host"
+                                                  << "hwest"
+                                                  << "tags"
+                                                  << BSON("region"
+                                                          << "west")))),
+                 0);
+
+    setSelfMemberState(MemberState::RS_SECONDARY);
+    OpTime lastOpTimeWeApplied = OpTime(Timestamp(100, 0), 0);
+
+    for (int round = 0; round < 2; ++round) {
+        heartbeatFromMember(HostAndPort("heast"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(10));
+        heartbeatFromMember(HostAndPort("hprimary"),
+                            "rs0",
+                            MemberState::RS_PRIMARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(100));
+        heartbeatFromMember(HostAndPort("hwest"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(50));
+    }
+
+    getTopoCoord().chooseNewSyncSource(
+        now()++, lastOpTimeWeApplied, TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("hwest"), getTopoCoord().getSyncSourceAddress());
+
+    // Once the primary is in our region, no hub is used and the closest member is chosen.
+    receiveDownHeartbeat(HostAndPort("hprimary"), "rs0", OpTime());
+    heartbeatFromMember(
+        HostAndPort("heast"), "rs0", MemberState::RS_PRIMARY, OpTime(Timestamp(501, 0), 0));
+    getTopoCoord().chooseNewSyncSource(
+        now()++, lastOpTimeWeApplied, TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("heast"), getTopoCoord().getSyncSourceAddress());
+}
 
 TEST_F(TopoCoordTest, ChooseOnlyPrimaryAsSyncSourceWhenChainingIsDisallowed) {
     updateConfig(BSON("_id"
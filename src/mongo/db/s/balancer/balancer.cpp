@@ -628,7 +628,8 @@ void Balancer::_splitOrMarkJumbo(OperationContext* opCtx,
             cm->getShardKeyPattern(),
             ChunkRange(chunk->getMin(), chunk->getMax()),
             Grid::get(opCtx)->getBalancerConfiguration()->getMaxChunkSizeBytes(),
-            boost::none));
+            boost::none,
+            0));
 
         uassert(ErrorCodes::CannotSplit, "No split points found", !splitPoints.empty());
 
@@ -37,6 +37,7 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog/type_collection.h"
@@ -57,6 +58,11 @@ using std::vector;
 
 namespace {
 
+// Ratio between the operation rates of the most and the least loaded shards of a zone, above which
+// the balancer moves chunks off the most loaded one even if the chunk counts are balanced. Zero or
+// less disables load based balancing.
+MONGO_EXPORT_SERVER_PARAMETER(balancerLoadImbalanceRatio, double, 0);
+
 /**
  * Does a linear pass over the information cached in the specified chunk manager and extracts chunk
  * distrubution and chunk placement information which is needed by the balancer policy.
@@ -475,7 +481,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint);
+    return BalancerPolicy::balance(
+        shardStats, distribution, aggressiveBalanceHint, balancerLoadImbalanceRatio.load());
 }
 
 }  // namespace mongo
@@ -293,6 +293,13 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             bool shouldAggressivelyBalance) {
+    return balance(shardStats, distribution, shouldAggressivelyBalance, 0);
+}
+
+vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            bool shouldAggressivelyBalance,
+                                            double loadImbalanceRatio) {
     vector<MigrateInfo> migrations;
 
     // Set of shards, which have already been used for migrations. Used so we don't return multiple
@@ -438,6 +445,18 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                                   &migrations,
                                   &usedShards))
             ;
+
+        // 4) once the chunk counts are balanced, relieve the most loaded shard of the zone
+        if (loadImbalanceRatio > 0) {
+            _singleZoneLoadBalance(shardStats,
+                                   distribution,
+                                   tag,
+                                   idealNumberOfChunksPerShardForTag,
+                                   imbalanceThreshold,
+                                   loadImbalanceRatio,
+                                   &migrations,
+                                   &usedShards);
+        }
     }
 
     return migrations;
@@ -530,6 +549,65 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            const string& tag,
+                                            size_t idealNumberOfChunksPerShardForTag,
+                                            size_t imbalanceThreshold,
+                                            double loadImbalanceRatio,
+                                            vector<MigrateInfo>* migrations,
+                                            set<ShardId>* usedShards) {
+    const ClusterStatistics::ShardStatistics* hottest = nullptr;
+    const ClusterStatistics::ShardStatistics* coldest = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (!tag.empty() && !stat.shardTags.count(tag))
+            continue;
+
+        if (distribution.numberOfChunksInShardWithTag(stat.shardId, tag) > 0 &&
+            (!hottest || stat.opsPerSecond > hottest->opsPerSecond)) {
+            hottest = &stat;
+        }
+
+        if (isShardSuitableReceiver(stat, tag).isOK() &&
+            (!coldest || stat.opsPerSecond < coldest->opsPerSecond)) {
+            coldest = &stat;
+        }
+    }
+
+    if (!hottest || !coldest || hottest == coldest || hottest->opsPerSecond <= 0 ||
+        hottest->opsPerSecond < loadImbalanceRatio * coldest->opsPerSecond)
+        return false;
+
+    // Do not move a chunk, which _singleZoneBalance would move right back
+    const size_t min = distribution.numberOfChunksInShardWithTag(coldest->shardId, tag);
+    if (min + 1 >= idealNumberOfChunksPerShardForTag + imbalanceThreshold)
+        return false;
+
+    LOG(1) << "collection : " << distribution.nss().ns();
+    LOG(1) << "zone       : " << tag;
+    LOG(1) << "donor      : " << hottest->shardId << " ops/sec " << hottest->opsPerSecond;
+    LOG(1) << "receiver   : " << coldest->shardId << " ops/sec " << coldest->opsPerSecond;
+
+    for (const auto& chunk : distribution.getChunks(hottest->shardId)) {
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        if (chunk.getJumbo())
+            continue;
+
+        migrations->emplace_back(coldest->shardId, chunk);
+        invariant(usedShards->insert(chunk.getShard()).second);
+        invariant(usedShards->insert(coldest->shardId).second);
+        return true;
+    }
+
+    return false;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -179,6 +179,19 @@ public:
      *
      * The shouldAggressivelyBalance parameter causes the threshold for chunk could disparity
      * between shards to be lowered.
+     *
+     * If loadImbalanceRatio is positive, once the chunk counts of a zone are balanced, a chunk is
+     * also moved from the shard serving the most operations per second to the one serving the
+     * least, if the former serves at least loadImbalanceRatio times as many. Such a migration is
+     * only suggested if it does not unbalance the chunk counts enough to trigger a migration back.
+     */
+    static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            bool shouldAggressivelyBalance,
+                                            double loadImbalanceRatio);
+
+    /**
+     * Same as above, without the load based balancing.
      */
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
@@ -230,6 +243,24 @@ private:
                                    size_t imbalanceThreshold,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the shard with the
+     * highest operation rate to the one with the lowest, if their rates differ by at least a factor
+     * of 'loadImbalanceRatio'. The receiver must remain below the chunk count, at which
+     * _singleZoneBalance would move a chunk away from it. Takes into account and updates the
+     * shards, which have already been used for migrations.
+     *
+     * Returns true if a migration was suggested, false otherwise.
+     */
+    static bool _singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       const std::string& tag,
+                                       size_t idealNumberOfChunksPerShardForTag,
+                                       size_t imbalanceThreshold,
+                                       double loadImbalanceRatio,
+                                       std::vector<MigrateInfo>* migrations,
+                                       std::set<ShardId>* usedShards);
 };
 
 }  // namespace mongo
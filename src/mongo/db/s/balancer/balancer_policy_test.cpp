@@ -153,6 +153,56 @@ TEST(BalancerPolicy, SingleChunkShouldNotMove) {
                .empty());
 }
 
+TEST(BalancerPolicy, LoadImbalanceMovesChunkOffMostLoadedShard) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId1, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId2, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId3, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6}});
+    cluster.first[0].opsPerSecond = 1000;
+    cluster.first[1].opsPerSecond = 100;
+    cluster.first[2].opsPerSecond = 200;
+    cluster.first[3].opsPerSecond = 300;
+
+    // The chunk counts are balanced, so nothing moves unless load based balancing is enabled
+    ASSERT(BalancerPolicy::balance(
+               cluster.first, DistributionStatus(kNamespace, cluster.second), false)
+               .empty());
+    ASSERT(BalancerPolicy::balance(
+               cluster.first, DistributionStatus(kNamespace, cluster.second), false, 0)
+               .empty());
+
+    const auto migrations(BalancerPolicy::balance(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), false, 2.0));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+
+    // Below the ratio nothing moves
+    ASSERT(BalancerPolicy::balance(
+               cluster.first, DistributionStatus(kNamespace, cluster.second), false, 20.0)
+               .empty());
+}
+
+TEST(BalancerPolicy, LoadImbalanceDoesNotUnbalanceChunkCounts) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId1, kNoMaxSize, 7, false, emptyTagSet, emptyShardVersion), 7},
+         {ShardStatistics(kShardId2, kNoMaxSize, 6, false, emptyTagSet, emptyShardVersion), 6},
+         {ShardStatistics(kShardId3, kNoMaxSize, 5, false, emptyTagSet, emptyShardVersion), 5}});
+    cluster.first[0].opsPerSecond = 1000;
+    cluster.first[1].opsPerSecond = 10;
+    cluster.first[2].opsPerSecond = 500;
+    cluster.first[3].opsPerSecond = 500;
+
+    // Another chunk on the least loaded shard would make it a donor for the chunk count balancing
+    ASSERT(BalancerPolicy::balance(
+               cluster.first, DistributionStatus(kNamespace, cluster.second), false, 2.0)
+               .empty());
+}
+
 TEST(BalancerPolicy, BalanceThresholdObeyed) {
     auto cluster = generateCluster(
         {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
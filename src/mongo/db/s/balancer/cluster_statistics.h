@@ -98,6 +98,10 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Rate of the operations (queries, getMores, inserts, updates and deletes) served by this
+        // shard's primary since the previous statistics snapshot, or zero if it is not known
+        double opsPerSecond{0};
     };
 
     virtual ~ClusterStatistics();
@@ -51,16 +51,23 @@ using std::vector;
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpCountersField[] = "opcounters";
+
+// The operation counters from the serverStatus 'opcounters' section, which make up a shard's load
+const char* const kLoadOpCounters[] = {"query", "getmore", "insert", "update", "delete"};
 
 /**
  * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * running MongoD service. Also returns in 'totalOps' the sum of the operation counters, which make
+ * up the shard's load, if they are present.
  *
  * Returns the MongoD version in strig format or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
  *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx,
+                                              ShardId shardId,
+                                              boost::optional<long long>* totalOps) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -83,6 +90,15 @@ StatusWith<string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId s
 
     BSONObj serverStatus = std::move(commandResponse.getValue().response);
 
+    BSONElement opCountersElem = serverStatus[kOpCountersField];
+    if (opCountersElem.type() == Object) {
+        long long total = 0;
+        for (const char* opCounter : kLoadOpCounters) {
+            total += opCountersElem.embeddedObject()[opCounter].safeNumberLong();
+        }
+        *totalOps = total;
+    }
+
     string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -129,8 +145,9 @@ StatusWith<vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationCon
         }
 
         string mongoDVersion;
+        boost::optional<long long> totalOps;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
+        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName(), &totalOps);
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
@@ -152,9 +169,36 @@ StatusWith<vector<ShardStatistics>> ClusterStatisticsImpl::getStats(OperationCon
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        if (totalOps) {
+            stats.back().opsPerSecond =
+                _updateOpsPerSecond(shard.getName(), {*totalOps, Date_t::now()});
+        }
     }
 
     return stats;
 }
 
+double ClusterStatisticsImpl::_updateOpsPerSecond(const ShardId& shardId,
+                                                  OpCountersSample sample) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _lastOpCounters.find(shardId);
+    if (it == _lastOpCounters.end()) {
+        _lastOpCounters.emplace(shardId, sample);
+        return 0;
+    }
+
+    const OpCountersSample previous = it->second;
+    it->second = sample;
+
+    const long long elapsedMillis =
+        durationCount<Milliseconds>(sample.sampledAt - previous.sampledAt);
+    if (elapsedMillis <= 0 || sample.totalOps < previous.totalOps) {
+        return 0;
+    }
+
+    return (sample.totalOps - previous.totalOps) * 1000.0 / elapsedMillis;
+}
+
 }  // namespace mongo
@@ -28,7 +28,11 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -36,6 +40,9 @@ namespace mongo {
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
  * fetch the statistics and does not perform any caching. If any of the shards fails to report
  * statistics fails the entire refresh.
+ *
+ * The operation rate of each shard is computed from the difference between its operation counters
+ * in the current and the previous call to getStats.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -43,6 +50,27 @@ public:
     ~ClusterStatisticsImpl();
 
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
+
+private:
+    /**
+     * Total of the operation counters of a shard, as of the time it was retrieved.
+     */
+    struct OpCountersSample {
+        long long totalOps;
+        Date_t sampledAt;
+    };
+
+    /**
+     * Records 'sample' as the latest for the specified shard and returns the rate of operations
+     * since the previous sample, or zero if there is none or the shard was restarted meanwhile.
+     */
+    double _updateOpsPerSecond(const ShardId& shardId, OpCountersSample sample);
+
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // The operation counters of each shard, as of the previous call to getStats
+    std::map<ShardId, OpCountersSample> _lastOpCounters;
 };
 
 }  // namespace mongo
@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/chunk_splitter.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/collection_metadata.h"
+#include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/sharding_state.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/balancer_configuration.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/shard_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// Splits beyond this many queued or running ones are refused, since the chunks they are for will
+// be offered for splitting again by their next writes.
+const int kMaxConcurrentSplits = 4;
+
+const auto getChunkSplitter = ServiceContext::declareDecoration<ChunkSplitter>();
+
+ThreadPool::Options makeDefaultThreadPoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "ChunkSplitter";
+    options.minThreads = 0;
+    options.maxThreads = kMaxConcurrentSplits;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    return options;
+}
+
+}  // namespace
+
+ChunkSplitter::ChunkSplitter()
+    : _splitTickets(kMaxConcurrentSplits), _threadPool(makeDefaultThreadPoolOptions()) {
+    _threadPool.startup();
+}
+
+ChunkSplitter::~ChunkSplitter() {
+    _threadPool.shutdown();
+    _threadPool.join();
+}
+
+ChunkSplitter* ChunkSplitter::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+ChunkSplitter* ChunkSplitter::get(ServiceContext* serviceContext) {
+    return &getChunkSplitter(serviceContext);
+}
+
+bool ChunkSplitter::trySplitting(const NamespaceString& nss,
+                                 const BSONObj& min,
+                                 const BSONObj& max) {
+    if (!_splitTickets.tryAcquire()) {
+        LOG(1) << "won't auto split because not enough tickets: " << nss;
+        return false;
+    }
+
+    auto status = _threadPool.schedule(
+        [ this, nss, min = min.getOwned(), max = max.getOwned() ]() {
+            TicketHolderReleaser releaser(&_splitTickets);
+            _runAutosplit(nss, min, max);
+        });
+    if (!status.isOK()) {
+        _splitTickets.release();
+        return false;
+    }
+
+    return true;
+}
+
+void ChunkSplitter::_runAutosplit(const NamespaceString& nss,
+                                  const BSONObj& min,
+                                  const BSONObj& max) {
+    auto opCtx = cc().makeOperationContext();
+    const ChunkRange chunkRange(min, max);
+
+    try {
+        const auto balancerConfig = Grid::get(opCtx.get())->getBalancerConfiguration();
+
+        // Ensure we have the most up-to-date balancer configuration
+        uassertStatusOK(balancerConfig->refreshAndCheck(opCtx.get()));
+
+        if (!balancerConfig->getShouldAutoSplit()) {
+            return;
+        }
+
+        boost::optional<ShardKeyPattern> shardKeyPattern;
+        ChunkVersion collectionVersion;
+
+        {
+            AutoGetCollection autoColl(opCtx.get(), nss, MODE_IS);
+
+            auto metadata = CollectionShardingState::get(opCtx.get(), nss)->getMetadata();
+            ChunkType chunk;
+            uassert(ErrorCodes::StaleShardVersion,
+                    str::stream() << "chunk " << chunkRange.toString()
+                                  << " is no longer owned by this shard",
+                    metadata && metadata->getNextChunk(min, &chunk) &&
+                        !chunk.getMin().woCompare(min) && !chunk.getMax().woCompare(max));
+
+            shardKeyPattern.emplace(metadata->getKeyPattern());
+            collectionVersion = metadata->getCollVersion();
+        }
+
+        const ShardId shardId(ShardingState::get(opCtx.get())->getShardName());
+        const uint64_t maxChunkSizeBytes = balancerConfig->getMaxChunkSizeBytes();
+
+        LOG(1) << "about to initiate autosplit of " << nss << " chunk "
+               << redact(chunkRange.toString());
+
+        auto splitPoints =
+            uassertStatusOK(shardutil::selectChunkSplitPoints(opCtx.get(),
+                                                              shardId,
+                                                              nss,
+                                                              *shardKeyPattern,
+                                                              chunkRange,
+                                                              maxChunkSizeBytes,
+                                                              boost::none,
+                                                              0));
+
+        // No split points means there isn't enough data to split on; 1 split point means we have
+        // between half the chunk size to full chunk size so there is no need to split yet
+        if (splitPoints.size() <= 1) {
+            return;
+        }
+
+        uassertStatusOK(shardutil::splitChunkAtMultiplePoints(opCtx.get(),
+                                                              shardId,
+                                                              nss,
+                                                              *shardKeyPattern,
+                                                              collectionVersion,
+                                                              chunkRange,
+                                                              splitPoints));
+
+        log() << "autosplitted " << nss << " chunk: " << redact(chunkRange.toString()) << " into "
+              << (splitPoints.size() + 1) << " parts";
+    } catch (const DBException& ex) {
+        log() << "Unable to auto-split chunk " << redact(chunkRange.toString()) << " of " << nss
+              << causedBy(redact(ex));
+    }
+}
+
+}  // namespace mongo
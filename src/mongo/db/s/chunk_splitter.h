@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+
+class BSONObj;
+class NamespaceString;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Splits the chunks of this shard which have grown past the maximum chunk size. The writes to each
+ * chunk are counted by its CollectionShardingState, which calls trySplitting once enough bytes
+ * have been written to the chunk to warrant looking for split points. The split itself runs on a
+ * background thread, so that it does not hold up the write which triggered it.
+ */
+class ChunkSplitter {
+    MONGO_DISALLOW_COPYING(ChunkSplitter);
+
+public:
+    ChunkSplitter();
+    ~ChunkSplitter();
+
+    /**
+     * Retrieves the ChunkSplitter associated with the specified service context.
+     */
+    static ChunkSplitter* get(OperationContext* opCtx);
+    static ChunkSplitter* get(ServiceContext* serviceContext);
+
+    /**
+     * Schedules a split of the chunk [min, max) of the collection 'nss' at the points chosen by
+     * splitVector. Returns false without scheduling anything if the maximum number of splits is
+     * already queued or running, in which case the caller should try again later.
+     */
+    bool trySplitting(const NamespaceString& nss, const BSONObj& min, const BSONObj& max);
+
+private:
+    /**
+     * Looks for split points in the chunk [min, max) and splits it at them, if it is still owned
+     * by this shard and the balancer settings allow auto-splits.
+     */
+    void _runAutosplit(const NamespaceString& nss, const BSONObj& min, const BSONObj& max);
+
+    // Bounds the number of splits which are queued or running at any time.
+    TicketHolder _splitTickets;
+
+    // Runs the splits.
+    ThreadPool _threadPool;
+};
+
+}  // namespace mongo
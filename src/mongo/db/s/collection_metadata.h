@@ -150,6 +150,10 @@ public:
         return _shardKeyPattern.toBSON();
     }
 
+    const ShardKeyPattern& getShardKeyPattern() const {
+        return _shardKeyPattern;
+    }
+
     const std::vector<std::unique_ptr<FieldRef>>& getKeyPatternFields() const {
         return _shardKeyPattern.getKeyPatternFields();
     }
@@ -34,10 +34,13 @@
 
 #include <algorithm>
 
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
+#include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
@@ -48,6 +51,7 @@
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/util/log.h"
@@ -68,6 +72,42 @@ const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::SyncMode::UNSET,
                                                 Seconds(60));
 
+// Limits on the rate at which each collection's range deleter removes orphaned documents, so that
+// the cleanup after a migration does not compete with user writes. Zero means no limit.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxDocumentsPerSecond, int, 0);
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxBytesPerSecond, long long, 0);
+
+Counter64 rangeDeleterDeletedDocuments;
+Counter64 rangeDeleterDeletedBytes;
+Counter64 rangeDeleterRangesCleaned;
+
+ServerStatusMetricField<Counter64> rangeDeleterDeletedDocumentsDisplay(
+    "rangeDeleter.deletedDocuments", &rangeDeleterDeletedDocuments);
+ServerStatusMetricField<Counter64> rangeDeleterDeletedBytesDisplay("rangeDeleter.deletedBytes",
+                                                                   &rangeDeleterDeletedBytes);
+ServerStatusMetricField<Counter64> rangeDeleterRangesCleanedDisplay("rangeDeleter.rangesCleaned",
+                                                                    &rangeDeleterRangesCleaned);
+
+/**
+ * Returns how long to wait before deleting more documents, after a batch of 'numDocs' documents
+ * of 'numBytes' bytes in total, for the deletion rate to stay within the configured limits.
+ */
+Milliseconds throttleDelay(int numDocs, long long numBytes) {
+    Milliseconds delay(0);
+
+    const int maxDocsPerSecond = rangeDeleterMaxDocumentsPerSecond.load();
+    if (maxDocsPerSecond > 0) {
+        delay = std::max(delay, Milliseconds(numDocs * 1000LL / maxDocsPerSecond));
+    }
+
+    const long long maxBytesPerSecond = rangeDeleterMaxBytesPerSecond.load();
+    if (maxBytesPerSecond > 0) {
+        delay = std::max(delay, Milliseconds(numBytes * 1000 / maxBytesPerSecond));
+    }
+
+    return delay;
+}
+
 }  // unnamed namespace
 
 CollectionRangeDeleter::CollectionRangeDeleter(NamespaceString nss) : _nss(std::move(nss)) {}
@@ -80,16 +120,25 @@ void CollectionRangeDeleter::run() {
     const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
     bool hasNextRangeToClean = cleanupNextRange(opCtx, maxToDelete);
 
-    // If there are more ranges to run, we add <this> back onto the task executor to run again.
+    // If there are more ranges to run, we add <this> back onto the task executor to run again,
+    // after a pause if the deletion rate is limited.
     if (hasNextRangeToClean) {
         auto executor = ShardingState::get(opCtx)->getRangeDeleterTaskExecutor();
-        executor->scheduleWork([this](const CallbackArgs& cbArgs) { run(); });
+        const Milliseconds delay = throttleDelay(_lastBatchDocs, _lastBatchBytes);
+        if (delay > Milliseconds(0)) {
+            executor->scheduleWorkAt(executor->now() + delay,
+                                     [this](const CallbackArgs& cbArgs) { run(); });
+        } else {
+            executor->scheduleWork([this](const CallbackArgs& cbArgs) { run(); });
+        }
     } else {
         delete this;
     }
 }
 
 bool CollectionRangeDeleter::cleanupNextRange(OperationContext* opCtx, int maxToDelete) {
+    _lastBatchDocs = 0;
+    _lastBatchBytes = 0;
 
     {
         AutoGetCollection autoColl(opCtx, _nss, MODE_IX);
@@ -119,6 +168,9 @@ bool CollectionRangeDeleter::cleanupNextRange(OperationContext* opCtx, int maxTo
         int numDocumentsDeleted =
             _doDeletion(opCtx, collection, scopedCollectionMetadata->getKeyPattern(), maxToDelete);
         if (numDocumentsDeleted <= 0) {
+            if (numDocumentsDeleted == 0) {
+                rangeDeleterRangesCleaned.increment();
+            }
             metadataManager.removeRangeToClean(_rangeInProgress.get());
             _rangeInProgress = boost::none;
             return metadataManager.hasRangesToClean();
@@ -173,42 +225,58 @@ int CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
         return -1;
     }
 
+    // Checking once is enough, since the collection lock held through the batch keeps this node
+    // from stepping down.
+    if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(opCtx, _nss)) {
+        warning() << "stepped down from primary while deleting chunk; orphaning data in " << _nss
+                  << " in range [" << min << ", " << max << ")";
+        return -1;
+    }
+
+    // A single scan deletes the whole batch, instead of seeking the index again from the start of
+    // the range for every document.
+    DeleteStageParams params;
+    params.isMulti = true;
+    params.fromMigrate = true;
+    params.returnDeleted = true;
+
+    auto exec = InternalPlanner::deleteWithIndexScan(opCtx,
+                                                     collection,
+                                                     params,
+                                                     desc,
+                                                     min,
+                                                     max,
+                                                     BoundInclusion::kIncludeStartKeyOnly,
+                                                     PlanExecutor::YIELD_MANUAL,
+                                                     InternalPlanner::FORWARD);
+
     int numDeleted = 0;
-    do {
-        auto exec = InternalPlanner::indexScan(opCtx,
-                                               collection,
-                                               desc,
-                                               min,
-                                               max,
-                                               BoundInclusion::kIncludeStartKeyOnly,
-                                               PlanExecutor::YIELD_MANUAL,
-                                               InternalPlanner::FORWARD,
-                                               InternalPlanner::IXSCAN_FETCH);
-        RecordId rloc;
-        BSONObj obj;
-        PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
+    long long bytesDeleted = 0;
+    while (numDeleted < maxToDelete) {
+        BSONObj deletedObj;
+        PlanExecutor::ExecState state = exec->getNext(&deletedObj, nullptr);
         if (state == PlanExecutor::IS_EOF) {
             break;
         }
         if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
             warning(LogComponent::kSharding)
                 << PlanExecutor::statestr(state) << " - cursor error while trying to delete " << min
-                << " to " << max << " in " << _nss << ": " << WorkingSetCommon::toStatusString(obj)
+                << " to " << max << " in " << _nss << ": "
+                << WorkingSetCommon::toStatusString(deletedObj)
                 << ", stats: " << Explain::getWinningPlanStats(exec.get());
             break;
         }
 
         invariant(PlanExecutor::ADVANCED == state);
-        WriteUnitOfWork wuow(opCtx);
-        if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(opCtx, _nss)) {
-            warning() << "stepped down from primary while deleting chunk; orphaning data in "
-                      << _nss << " in range [" << min << ", " << max << ")";
-            break;
-        }
-        OpDebug* const nullOpDebug = nullptr;
-        collection->deleteDocument(opCtx, rloc, nullOpDebug, true);
-        wuow.commit();
-    } while (++numDeleted < maxToDelete);
+        ++numDeleted;
+        bytesDeleted += deletedObj.objsize();
+    }
+
+    _lastBatchDocs = numDeleted;
+    _lastBatchBytes = bytesDeleted;
+    rangeDeleterDeletedDocuments.increment(numDeleted);
+    rangeDeleterDeletedBytes.increment(bytesDeleted);
+
     return numDeleted;
 }
 
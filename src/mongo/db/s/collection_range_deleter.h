@@ -75,6 +75,11 @@ private:
     // Holds a range for which deletion has begun. If empty, then a new range
     // must be requested from rangesToClean
     boost::optional<ChunkRange> _rangeInProgress;
+
+    // The number of documents and bytes deleted by the last call to cleanupNextRange(), which
+    // determine how long to pause before the next one when the deletion rate is limited.
+    int _lastBatchDocs = 0;
+    long long _lastBatchBytes = 0;
 };
 
 }  // namespace mongo
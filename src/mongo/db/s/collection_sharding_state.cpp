@@ -36,6 +36,7 @@
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
+#include "mongo/db/s/chunk_splitter.h"
 #include "mongo/db/s/collection_metadata.h"
 #include "mongo/db/s/migration_chunk_cloner_source.h"
 #include "mongo/db/s/migration_source_manager.h"
@@ -45,10 +46,13 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/type_shard_identity.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/sharding_catalog_manager.h"
+#include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog/type_config_version.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/balancer_configuration.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/cluster_identity_loader.h"
 #include "mongo/s/grid.h"
@@ -61,6 +65,15 @@ namespace {
 
 using std::string;
 
+// If true, the primary of this shard counts the bytes written to each of its chunks and splits the
+// chunks itself once they have grown large enough, rather than relying on the estimates of the
+// writes each mongos routed to them. Mongos should then be started with autoSplitOnShards.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitOnShard, bool, false);
+
+// Chunks are offered for splitting once this fraction of the maximum chunk size has been written
+// to them. The split then checks the size of the data actually in the chunk.
+const uint64_t kSplitTestFactor = 5;
+
 /**
  * Used to perform shard identity initialization once it is certain that the document is committed.
  */
@@ -84,7 +97,10 @@ private:
 }  // unnamed namespace
 
 CollectionShardingState::CollectionShardingState(ServiceContext* sc, NamespaceString nss)
-    : _nss(std::move(nss)), _metadataManager{sc, _nss} {}
+    : _nss(std::move(nss)),
+      _metadataManager{sc, _nss},
+      _chunkWriteStats(
+          SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ChunkWriteStats>()) {}
 
 CollectionShardingState::~CollectionShardingState() {
     invariant(!_sourceMgr);
@@ -113,10 +129,12 @@ void CollectionShardingState::refreshMetadata(OperationContext* opCtx,
     invariant(opCtx->lockState()->isCollectionLockedForMode(_nss.ns(), MODE_X));
 
     _metadataManager.refreshActiveMetadata(std::move(newMetadata));
+    _pruneBytesWritten();
 }
 
 void CollectionShardingState::markNotShardedAtStepdown() {
     _metadataManager.refreshActiveMetadata(nullptr);
+    _pruneBytesWritten();
 }
 
 void CollectionShardingState::beginReceive(const ChunkRange& range) {
@@ -203,6 +221,8 @@ void CollectionShardingState::onInsertOp(OperationContext* opCtx, const BSONObj&
     if (_sourceMgr) {
         _sourceMgr->getCloner()->onInsertOp(opCtx, insertedDoc);
     }
+
+    _trackBytesWritten(opCtx, insertedDoc);
 }
 
 void CollectionShardingState::onUpdateOp(OperationContext* opCtx, const BSONObj& updatedDoc) {
@@ -213,6 +233,8 @@ void CollectionShardingState::onUpdateOp(OperationContext* opCtx, const BSONObj&
     if (_sourceMgr) {
         _sourceMgr->getCloner()->onUpdateOp(opCtx, updatedDoc);
     }
+
+    _trackBytesWritten(opCtx, updatedDoc);
 }
 
 void CollectionShardingState::onDeleteOp(OperationContext* opCtx,
@@ -383,4 +405,61 @@ bool CollectionShardingState::_checkShardVersionOk(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+void CollectionShardingState::_trackBytesWritten(OperationContext* opCtx, const BSONObj& doc) {
+    if (!autoSplitOnShard.load() || serverGlobalParams.clusterRole != ClusterRole::ShardServer) {
+        return;
+    }
+
+    auto metadata = getMetadata();
+    if (!metadata) {
+        return;
+    }
+
+    const BSONObj shardKey = metadata->getShardKeyPattern().extractShardKeyFromDoc(doc);
+    ChunkType chunk;
+    if (shardKey.isEmpty() || !metadata->getNextChunk(shardKey, &chunk) ||
+        !rangeContains(chunk.getMin(), chunk.getMax(), shardKey)) {
+        return;
+    }
+
+    const uint64_t splitThreshold =
+        Grid::get(opCtx)->getBalancerConfiguration()->getMaxChunkSizeBytes() / kSplitTestFactor;
+
+    stdx::lock_guard<stdx::mutex> lk(_chunkWriteStatsMutex);
+
+    auto it = _chunkWriteStats.find(chunk.getMin());
+    if (it == _chunkWriteStats.end()) {
+        it = _chunkWriteStats
+                 .emplace(chunk.getMin().getOwned(), ChunkWriteStats{chunk.getMax().getOwned(), 0})
+                 .first;
+    }
+
+    it->second.bytesWritten += doc.objsize();
+    if (it->second.bytesWritten < splitThreshold) {
+        return;
+    }
+
+    // If the split could not be scheduled the bytes are kept, so the next write offers the chunk
+    // again.
+    if (ChunkSplitter::get(opCtx)->trySplitting(_nss, chunk.getMin(), chunk.getMax())) {
+        it->second.bytesWritten = 0;
+    }
+}
+
+void CollectionShardingState::_pruneBytesWritten() {
+    auto metadata = getMetadata();
+
+    stdx::lock_guard<stdx::mutex> lk(_chunkWriteStatsMutex);
+
+    for (auto it = _chunkWriteStats.begin(); it != _chunkWriteStats.end();) {
+        ChunkType chunk;
+        if (metadata && metadata->getNextChunk(it->first, &chunk) &&
+            !chunk.getMin().woCompare(it->first) && !chunk.getMax().woCompare(it->second.max)) {
+            ++it;
+        } else {
+            it = _chunkWriteStats.erase(it);
+        }
+    }
+}
+
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/metadata_manager.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
@@ -191,6 +192,19 @@ private:
                               ChunkVersion* expectedShardVersion,
                               ChunkVersion* actualShardVersion);
 
+    /**
+     * Adds the size of a document which was inserted or updated to the bytes written to the chunk
+     * which owns it and hands the chunk to the ChunkSplitter once enough bytes have been written to
+     * it that it may need to be split. Does nothing unless the autoSplitOnShard parameter is set.
+     */
+    void _trackBytesWritten(OperationContext* opCtx, const BSONObj& doc);
+
+    /**
+     * Forgets the bytes written to the chunks which are not owned by this shard any more, or whose
+     * bounds have changed, after the metadata has been refreshed.
+     */
+    void _pruneBytesWritten();
+
     // Namespace to which this state belongs.
     const NamespaceString _nss;
 
@@ -204,6 +218,18 @@ private:
     // NOTE: The value is not owned by this class.
     MigrationSourceManager* _sourceMgr{nullptr};
 
+    struct ChunkWriteStats {
+        BSONObj max;
+        uint64_t bytesWritten;
+    };
+
+    // Protects _chunkWriteStats, which is updated by concurrent writers.
+    stdx::mutex _chunkWriteStatsMutex;
+
+    // Bytes written to this shard's chunks since they came into existence or were last offered for
+    // splitting, keyed by the chunks' min keys. Only maintained when autoSplitOnShard is set.
+    BSONObjIndexedMap<ChunkWriteStats> _chunkWriteStats;
+
     friend class CollectionRangeDeleter;
 };
 
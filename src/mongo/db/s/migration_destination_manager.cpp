@@ -33,6 +33,7 @@
 #include "mongo/db/s/migration_destination_manager.h"
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "mongo/client/connpool.h"
@@ -62,6 +63,7 @@
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/stdx/chrono.h"
+#include "mongo/stdx/future.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -633,21 +635,34 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
 
         const BSONObj migrateCloneRequest = createMigrateCloneRequest(_nss, *_sessionId);
 
-        while (true) {
+        // Gets the next array of objects to copy, in disk order
+        const auto fetchBatch = [&conn, &migrateCloneRequest] {
             BSONObj res;
-            if (!conn->runCommand("admin",
-                                  migrateCloneRequest,
-                                  res)) {  // gets array of objects to copy, in disk order
+            const bool ok = conn->runCommand("admin", migrateCloneRequest, res);
+            return std::make_pair(ok, res);
+        };
+
+        // The next batch is requested from the donor while the current one is being inserted, so
+        // that the round trip overlaps with the local writes. The donor hands out each document
+        // only once, so the order in which the batches are applied does not change.
+        auto nextBatch = stdx::async(stdx::launch::async, fetchBatch);
+
+        while (true) {
+            auto fetched = nextBatch.get();
+            if (!fetched.first) {
                 setState(FAIL);
                 _errmsg = "_migrateClone failed: ";
-                _errmsg += redact(res.toString());
+                _errmsg += redact(fetched.second.toString());
                 log() << _errmsg;
                 conn.done();
                 return;
             }
 
-            BSONObj arr = res["objects"].Obj();
-            int thisTime = 0;
+            BSONObj arr = fetched.second["objects"].Obj();
+            if (arr.isEmpty())
+                break;
+
+            nextBatch = stdx::async(stdx::launch::async, fetchBatch);
 
             BSONObjIterator i(arr);
             while (i.more()) {
@@ -684,31 +699,29 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
 
                     Helpers::upsert(opCtx, _nss.ns(), docToClone, true);
                 }
-                thisTime++;
 
                 {
                     stdx::lock_guard<stdx::mutex> statsLock(_mutex);
                     _numCloned++;
                     _clonedBytes += docToClone.objsize();
                 }
+            }
 
-                if (writeConcern.shouldWaitForOtherNodes()) {
-                    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-                        repl::getGlobalReplicationCoordinator()->awaitReplication(
-                            opCtx,
-                            repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp(),
-                            writeConcern);
-                    if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
-                        warning() << "secondaryThrottle on, but doc insert timed out; "
-                                     "continuing";
-                    } else {
-                        massertStatusOK(replStatus.status);
-                    }
+            // Waiting once per batch rather than after every document lets the secondaries
+            // apply the batch as a whole.
+            if (writeConcern.shouldWaitForOtherNodes()) {
+                repl::ReplicationCoordinator::StatusAndDuration replStatus =
+                    repl::getGlobalReplicationCoordinator()->awaitReplication(
+                        opCtx,
+                        repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp(),
+                        writeConcern);
+                if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
+                    warning() << "secondaryThrottle on, but doc insert timed out; "
+                                 "continuing";
+                } else {
+                    massertStatusOK(replStatus.status);
                 }
             }
-
-            if (thisTime == 0)
-                break;
         }
 
         timing.done(3);
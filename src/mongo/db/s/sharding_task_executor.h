@@ -70,6 +70,7 @@ public:
     void wait(const CallbackHandle& cbHandle) override;
 
     void appendConnectionStats(ConnectionPoolStats* stats) const override;
+    void warmUpConnections(const HostAndPort& hostAndPort) override;
 
 private:
     std::unique_ptr<ThreadPoolTaskExecutor> _executor;
@@ -46,6 +46,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/query/internal_plans.h"
@@ -65,10 +66,93 @@ namespace {
 
 const int kMaxObjectPerChunk{250000};
 
+// A sample is only used if it has at least this many keys in the chunk for every chunk it would
+// split the chunk into.
+const long long kMinSampledKeysPerChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
 
+/**
+ * Picks a split point every 'keyCount' keys of 'idx' in ['min', 'max') by drawing 'sampleSize'
+ * entries from a random cursor over the index, rather than scanning the range. The number of keys
+ * in the range is estimated from the share of the sample that falls in it, and the split points
+ * are the sampled keys at the matching quantiles.
+ *
+ * Returns false, leaving 'splitKeys' untouched, if the index has no random cursor or too few of
+ * the sampled keys are in the range to place the split points.
+ */
+bool sampleSplitKeys(OperationContext* opCtx,
+                     Collection* collection,
+                     IndexDescriptor* idx,
+                     const BSONObj& keyPattern,
+                     const BSONObj& min,
+                     const BSONObj& max,
+                     long long keyCount,
+                     long long maxSplitPoints,
+                     long long sampleSize,
+                     long long recCount,
+                     vector<BSONObj>* splitKeys) {
+    auto cursor = collection->getIndexCatalog()->getIndex(idx)->newRandomCursor(opCtx);
+    if (!cursor) {
+        return false;
+    }
+
+    const Ordering ordering = Ordering::make(idx->keyPattern());
+    vector<BSONObj> sampledKeys;
+    long long numSampled = 0;
+    for (; numSampled < sampleSize; ++numSampled) {
+        auto entry = cursor->next();
+        if (!entry) {
+            break;
+        }
+        if (entry->key.woCompare(min, ordering, false) >= 0 &&
+            entry->key.woCompare(max, ordering, false) < 0) {
+            sampledKeys.push_back(entry->key.getOwned());
+        }
+    }
+    if (sampledKeys.empty()) {
+        return false;
+    }
+
+    // The full scan splits after every 'keyCount' + 1 keys.
+    const long long numKeysInRange = recCount * sampledKeys.size() / numSampled;
+    long long numSplits = numKeysInRange / (keyCount + 1);
+    if (maxSplitPoints) {
+        numSplits = std::min(numSplits, maxSplitPoints);
+    }
+    if (static_cast<long long>(sampledKeys.size()) < kMinSampledKeysPerChunk * (numSplits + 1)) {
+        return false;
+    }
+
+    std::sort(sampledKeys.begin(), sampledKeys.end(), [&](const BSONObj& a, const BSONObj& b) {
+        return a.woCompare(b, ordering, false) < 0;
+    });
+
+    // As with the full scan, a split point must differ from the lowest key and from the previous
+    // split point.
+    BSONObj lastKey = dotted_path_support::extractElementsBasedOnTemplate(
+        prettyKey(idx->keyPattern(), sampledKeys.front()), keyPattern);
+    vector<BSONObj> sampledSplitKeys;
+    for (long long i = 1; i <= numSplits; ++i) {
+        const size_t pos = i * sampledKeys.size() / (numSplits + 1);
+        BSONObj key = dotted_path_support::extractElementsBasedOnTemplate(
+            prettyKey(idx->keyPattern(), sampledKeys[pos]), keyPattern);
+        if (key.woCompare(lastKey) == 0) {
+            continue;
+        }
+        sampledSplitKeys.push_back(key.getOwned());
+        lastKey = sampledSplitKeys.back();
+    }
+
+    LOG(1) << "picked " << sampledSplitKeys.size() << " split points for an estimated "
+           << numKeysInRange << " keys from " << sampledKeys.size() << " of " << numSampled
+           << " sampled keys";
+    *splitKeys = std::move(sampledSplitKeys);
+    return true;
+}
+
 class SplitVector : public Command {
 public:
     SplitVector() : Command("splitVector", false) {}
@@ -93,6 +177,8 @@ public:
                 "  { splitVector : \"blog.post\" , keyPattern:{x:1} , min:{x:10} , max:{x:20}, "
                 "force: true }\n"
                 "  'force' will produce one split point even if data is small; defaults to false\n"
+                "  'sampleSize' will estimate the split points from that many randomly sampled "
+                "index keys instead of scanning the chunk, if the index can be sampled\n"
                 "NOTE: This command may take a while to run";
     }
 
@@ -146,6 +232,12 @@ public:
             maxSplitPoints = maxSplitPointsElem.numberLong();
         }
 
+        long long sampleSize = 0;
+        BSONElement sampleSizeElem = jsobj["sampleSize"];
+        if (sampleSizeElem.isNumber()) {
+            sampleSize = sampleSizeElem.numberLong();
+        }
+
         long long maxChunkObjects = kMaxObjectPerChunk;
         BSONElement MaxChunkObjectsElem = jsobj["maxChunkObjects"];
         if (MaxChunkObjectsElem.isNumber()) {
@@ -248,13 +340,32 @@ public:
                 keyCount = maxChunkObjects;
             }
 
+            Timer timer;
+
+            // Forcing a median split needs an exact count of the keys, so it always scans.
+            if (sampleSize > 0 && !forceMedianSplit &&
+                sampleSplitKeys(opCtx,
+                                collection,
+                                idx,
+                                keyPattern,
+                                min,
+                                max,
+                                keyCount,
+                                maxSplitPoints,
+                                sampleSize,
+                                recCount,
+                                &splitKeys)) {
+                result.append("timeMillis", timer.millis());
+                result.append("splitKeys", splitKeys);
+                return true;
+            }
+
             //
             // 2. Traverse the index and add the keyCount-th key to the result vector. If that key
             //    appeared in the vector before, we omit it. The invariant here is that all the
             //    instances of a given key value live in the same chunk.
             //
 
-            Timer timer;
             long long currCount = 0;
             long long numChunks = 0;
 
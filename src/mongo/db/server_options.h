@@ -75,6 +75,9 @@ struct ServerGlobalParams {
 
     int maxConns = DEFAULT_MAX_CONN;  // Maximum number of simultaneous open connections.
 
+    std::string transportLayer = "legacy";  // --transportLayer (legacy|asio)
+    int transportLayerIOThreads = 0;        // --transportLayerIOThreads, 0 means one per core
+
     int unixSocketPermissions = DEFAULT_UNIX_PERMS;  // permissions for the UNIX domain socket
 
     std::string keyFile;  // Path to keyfile, or empty if none.
@@ -196,6 +196,19 @@ Status addGeneralServerOptions(moe::OptionSection* options) {
     options->addOptionChaining(
         "net.maxIncomingConnections", "maxConns", moe::Int, maxConnInfoBuilder.str().c_str());
 
+    options
+        ->addOptionChaining("net.transportLayer",
+                            "transportLayer",
+                            moe::String,
+                            "networking layer to use for client connections (legacy|asio)")
+        .format("(:?legacy)|(:?asio)", "(legacy/asio)");
+
+    options->addOptionChaining(
+        "net.transportLayerIOThreads",
+        "transportLayerIOThreads",
+        moe::Int,
+        "number of network I/O threads for the asio transport layer - one per core by default");
+
     options
         ->addOptionChaining(
             "logpath",
@@ -879,6 +892,19 @@ Status storeServerOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.transportLayer")) {
+        serverGlobalParams.transportLayer = params["net.transportLayer"].as<std::string>();
+    }
+
+    if (params.count("net.transportLayerIOThreads")) {
+        serverGlobalParams.transportLayerIOThreads =
+            params["net.transportLayerIOThreads"].as<int>();
+
+        if (serverGlobalParams.transportLayerIOThreads < 0) {
+            return Status(ErrorCodes::BadValue, "transportLayerIOThreads must not be negative");
+        }
+    }
+
     if (params.count("net.wireObjectCheck")) {
         serverGlobalParams.objcheck = params["net.wireObjectCheck"].as<bool>();
     }
@@ -37,6 +37,8 @@
 #include "mongo/db/assemble_response.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/traffic_recorder.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_entry_point_utils.h"
 #include "mongo/transport/session.h"
@@ -93,6 +95,19 @@ using transport::TransportLayer;
 ServiceEntryPointMongod::ServiceEntryPointMongod(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongod::startSession(transport::SessionHandle session) {
+    if (session->getTransportLayer()->supportsAsyncWait()) {
+        // Only occupy a worker thread while a request is being run.
+        launchAsyncServiceEntrySession(
+            std::move(session), [this](const transport::SessionHandle& session, Message* message) {
+                _nWorkers.fetchAndAdd(1);
+                auto guard = MakeGuard([&] { _nWorkers.fetchAndSubtract(1); });
+
+                _processMessage(session, message);
+                return true;
+            });
+        return;
+    }
+
     // Pass ownership of the transport::SessionHandle into our worker thread. When this
     // thread exits, the session will end.
     launchWrappedServiceEntryWorkerThread(
@@ -106,33 +121,45 @@ void ServiceEntryPointMongod::startSession(transport::SessionHandle session) {
 
 void ServiceEntryPointMongod::_sessionLoop(const transport::SessionHandle& session) {
     Message inMessage;
-    bool inExhaust = false;
     int64_t counter = 0;
 
     while (true) {
-        // 1. Source a Message from the client (unless we are exhausting)
-        if (!inExhaust) {
-            inMessage.reset();
-            auto status = session->sourceMessage(&inMessage).wait();
-
-            if (ErrorCodes::isInterruption(status.code()) ||
-                ErrorCodes::isNetworkError(status.code())) {
-                break;
-            }
-
-            // Our session may have been closed internally.
-            if (status == TransportLayer::TicketSessionClosedStatus) {
-                break;
-            }
-
-            uassertStatusOK(status);
+        // 1. Source a Message from the client
+        inMessage.reset();
+        auto status = session->sourceMessage(&inMessage).wait();
+
+        if (ErrorCodes::isInterruption(status.code()) ||
+            ErrorCodes::isNetworkError(status.code())) {
+            break;
+        }
+
+        // Our session may have been closed internally.
+        if (status == TransportLayer::TicketSessionClosedStatus) {
+            break;
         }
 
+        uassertStatusOK(status);
+
+        _processMessage(session, &inMessage);
+
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
+        }
+    }
+}
+
+void ServiceEntryPointMongod::_processMessage(const transport::SessionHandle& session,
+                                              Message* inMessage) {
+    TrafficRecorder::get(getGlobalServiceContext()).observe(session, *inMessage);
+
+    bool inExhaust = false;
+
+    do {
         // 2. Pass sourced Message up to mongod
         DbResponse dbresponse;
         {
             auto opCtx = cc().makeOperationContext();
-            assembleResponse(opCtx.get(), inMessage, dbresponse, session->remote());
+            assembleResponse(opCtx.get(), *inMessage, dbresponse, session->remote());
 
             // opCtx must go out of scope here so that the operation cannot show
             // up in currentOp results after the response reaches the client
@@ -140,27 +167,19 @@ void ServiceEntryPointMongod::_sessionLoop(const transport::SessionHandle& sessi
 
         // 3. Format our response, if we have one
         Message& toSink = dbresponse.response;
-        if (!toSink.empty()) {
-            toSink.header().setId(nextMessageId());
-            toSink.header().setResponseToMsgId(inMessage.header().getId());
-
-            // If this is an exhaust cursor, don't source more Messages
-            if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&inMessage, dbresponse)) {
-                inExhaust = true;
-            } else {
-                inExhaust = false;
-            }
-
-            // 4. Sink our response to the client
-            uassertStatusOK(session->sinkMessage(toSink).wait());
-        } else {
-            inExhaust = false;
+        if (toSink.empty()) {
+            return;
         }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
-        }
-    }
+        toSink.header().setId(nextMessageId());
+        toSink.header().setResponseToMsgId(inMessage->header().getId());
+
+        // If this is an exhaust cursor, don't source more Messages
+        inExhaust = dbresponse.exhaustNS.size() > 0 && setExhaustMessage(inMessage, dbresponse);
+
+        // 4. Sink our response to the client
+        uassertStatusOK(session->sinkMessage(toSink).wait());
+    } while (inExhaust);
 }
 
 }  // namespace mongo
@@ -36,6 +36,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -43,7 +45,9 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongod. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the Session's
+ * TransportLayer supports asynchronous waits, in which case requests are run on a shared pool of
+ * worker threads.
  */
 class ServiceEntryPointMongod final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongod);
@@ -62,6 +66,12 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs the request in 'inMessage' and sinks its response, if there is one. For exhaust
+     * cursors, keeps running and sinking getMores until the cursor is exhausted.
+     */
+    void _processMessage(const transport::SessionHandle& session, Message* inMessage);
+
     transport::TransportLayer* _tl;
     AtomicWord<std::size_t> _nWorkers;
 };
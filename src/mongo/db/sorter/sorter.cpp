@@ -47,6 +47,7 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <snappy.h>
 #include <vector>
@@ -59,6 +60,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/future.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -102,6 +104,27 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * Replaces the top of the heap [first, last), as built by std::make_heap() with 'comp', with
+ * 'value' and restores the heap property. This has the same effect as a std::pop_heap(),
+ * overwriting the last element and a std::push_heap(), but sifts down once instead of sifting
+ * down and then back up.
+ */
+template <typename RandomIt, typename T, typename Compare>
+void replaceHeapTop(RandomIt first, RandomIt last, T&& value, Compare comp) {
+    const std::ptrdiff_t size = last - first;
+    std::ptrdiff_t hole = 0;
+    for (std::ptrdiff_t child = 1; child < size; child = 2 * hole + 1) {
+        if (child + 1 < size && comp(first[child], first[child + 1]))
+            ++child;
+        if (!comp(value, first[child]))
+            break;
+        first[hole] = std::move(first[child]);
+        hole = child;
+    }
+    first[hole] = std::forward<T>(value);
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -333,9 +356,9 @@ public:
             _current = _heap.back();
             _heap.pop_back();
         } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+            std::shared_ptr<Stream> top = std::move(_heap.front());
+            replaceHeapTop(_heap.begin(), _heap.end(), std::move(_current), _greater);
+            _current = std::move(top);
         }
 
         return _current->current();
@@ -407,7 +430,14 @@ public:
     NoLimitSorter(const SortOptions& opts,
                   const Comparator& comp,
                   const Settings& settings = Settings())
-        : _comp(comp), _settings(settings), _opts(opts), _memUsed(0) {
+        : _comp(comp),
+          _settings(settings),
+          _opts(opts),
+          _numThreads(std::max(opts.numThreads, size_t(1))),
+          _spillThresholdBytes(_numThreads > 1 && opts.extSortAllowed
+                                   ? opts.maxMemoryUsageBytes / _numThreads
+                                   : opts.maxMemoryUsageBytes),
+          _memUsed(0) {
         verify(_opts.limit == 0);
     }
 
@@ -417,23 +447,26 @@ public:
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _spillThresholdBytes)
             spill();
     }
 
     Iterator* done() {
-        if (_iters.empty()) {
-            sort();
+        if (_iters.empty() && _pendingRuns.empty()) {
+            sort(&_data, _numThreads);
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        while (!_pendingRuns.empty()) {
+            collectOldestRun();
+        }
         return Iterator::merge(_iters, _opts, _comp);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
     int numFiles() const {
-        return _iters.size();
+        return _iters.size() + _pendingRuns.size();
     }
     size_t memUsed() const {
         return _memUsed;
@@ -452,13 +485,85 @@ private:
         const Comparator& _comp;
     };
 
-    void sort() {
+    // Below this many items per thread, sorting in memory uses only the calling thread.
+    static const size_t kMinItemsPerSortThread = 16 * 1024;
+
+    /**
+     * Stably sorts 'data' using up to 'numThreads' threads. Equal slices are sorted concurrently
+     * and then neighbouring slices are merged, also concurrently, until one remains. Both steps
+     * are stable, so the result is the same as that of a single stable_sort.
+     */
+    void sort(std::deque<Data>* data, size_t numThreads) const {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        const size_t numSlices = std::min(numThreads, data->size() / kMinItemsPerSortThread);
+        if (numSlices <= 1) {
+            std::stable_sort(data->begin(), data->end(), less);
+
+            // Does 2x more compares than stable_sort
+            // TODO test on windows
+            // std::sort(_data.begin(), _data.end(), comp);
+            return;
+        }
+
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= numSlices; i++) {
+            bounds.push_back(data->size() * i / numSlices);
+        }
+
+        const auto begin = data->begin();
+        {
+            std::vector<stdx::future<void>> sorts;
+            for (size_t i = 0; i + 1 < bounds.size(); i++) {
+                sorts.push_back(stdx::async(stdx::launch::async, [&, i] {
+                    std::stable_sort(begin + bounds[i], begin + bounds[i + 1], less);
+                }));
+            }
+            for (auto&& sorted : sorts) {
+                sorted.get();
+            }
+        }
+
+        while (bounds.size() > 2) {
+            std::vector<size_t> mergedBounds{bounds.front()};
+            std::vector<stdx::future<void>> merges;
+            for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+                merges.push_back(stdx::async(stdx::launch::async, [&, i] {
+                    std::inplace_merge(
+                        begin + bounds[i], begin + bounds[i + 1], begin + bounds[i + 2], less);
+                }));
+                mergedBounds.push_back(bounds[i + 2]);
+            }
+            if (mergedBounds.back() != bounds.back()) {
+                // An odd slice out waits for the next round.
+                mergedBounds.push_back(bounds.back());
+            }
+            for (auto&& merged : merges) {
+                merged.get();
+            }
+            bounds.swap(mergedBounds);
+        }
+    }
+
+    /**
+     * Sorts 'data' on the calling thread and writes it to a new file, emptying it.
+     */
+    std::shared_ptr<Iterator> writeRun(std::deque<Data>* data) const {
+        sort(data, 1);
+
+        SortedFileWriter<Key, Value> writer(_opts, _settings);
+        for (; !data->empty(); data->pop_front()) {
+            writer.addAlreadySorted(data->front().first, data->front().second);
+        }
+        return std::shared_ptr<Iterator>(writer.done());
+    }
 
-        // Does 2x more compares than stable_sort
-        // TODO test on windows
-        // std::sort(_data.begin(), _data.end(), comp);
+    /**
+     * Waits for the oldest run being spilled in the background, keeping runs in the order they
+     * were added so that the final merge remains stable.
+     */
+    void collectOldestRun() {
+        _iters.push_back(_pendingRuns.front().get());
+        _pendingRuns.pop_front();
     }
 
     void spill() {
@@ -478,24 +583,35 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
-
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+        if (_numThreads > 1) {
+            // Hand the run to a background thread, keeping at most one run per thread in memory,
+            // including the one being added to.
+            while (_pendingRuns.size() >= _numThreads - 1) {
+                collectOldestRun();
+            }
+            auto run = std::make_shared<std::deque<Data>>();
+            run->swap(_data);
+            _pendingRuns.push_back(
+                stdx::async(stdx::launch::async, [this, run] { return writeRun(run.get()); }));
+        } else {
+            _iters.push_back(writeRun(&_data));
         }
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
-
         _memUsed = 0;
     }
 
     const Comparator _comp;
     const Settings _settings;
     SortOptions _opts;
+    const size_t _numThreads;
+    const size_t _spillThresholdBytes;
     size_t _memUsed;
     std::deque<Data> _data;                         // the "current" data
     std::vector<std::shared_ptr<Iterator>> _iters;  // data that has already been spilled
+
+    // Runs being sorted and spilled in the background, oldest first. Declared last, so that
+    // destruction waits for them before anything they use is destroyed.
+    std::deque<stdx::future<std::shared_ptr<Iterator>>> _pendingRuns;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -612,9 +728,7 @@ public:
         _memUsed -= _data.front().first.memUsageForSorter();
         _memUsed -= _data.front().second.memUsageForSorter();
 
-        std::pop_heap(_data.begin(), _data.end(), less);
-        _data.back() = contender;
-        std::push_heap(_data.begin(), _data.end(), less);
+        replaceHeapTop(_data.begin(), _data.end(), contender, less);
 
         if (_memUsed > _opts.maxMemoryUsageBytes)
             spill();
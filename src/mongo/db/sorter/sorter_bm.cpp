@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+using KeyAndRecordId = std::pair<BSONObj, RecordId>;
+
+class KeyComparator {
+public:
+    int operator()(const KeyAndRecordId& lhs, const KeyAndRecordId& rhs) const {
+        const int cmp = lhs.first.woCompare(rhs.first, BSONObj(), false);
+        if (cmp != 0) {
+            return cmp;
+        }
+        return lhs.second.compare(rhs.second);
+    }
+};
+
+using KeySorter = Sorter<BSONObj, RecordId>;
+
+/**
+ * Returns index keys of the form {"": <int>, "": <string>} in random order, as an index build
+ * would give the sorter.
+ */
+std::vector<KeyAndRecordId> makeKeys(int count) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(0, count);
+
+    std::vector<KeyAndRecordId> keys;
+    for (int i = 0; i < count; ++i) {
+        const int value = dist(gen);
+        keys.emplace_back(BSON("" << value << ""
+                                  << "value"),
+                          RecordId(i + 1));
+    }
+    return keys;
+}
+
+void sortKeys(unittest::BenchmarkState& state, const SortOptions& opts) {
+    const auto keys = makeKeys(10000);
+
+    while (state.keepRunning()) {
+        std::unique_ptr<KeySorter> sorter(KeySorter::make(opts, KeyComparator()));
+        for (const auto& key : keys) {
+            sorter->add(key.first, key.second);
+        }
+
+        std::unique_ptr<KeySorter::Iterator> it(sorter->done());
+        while (it->more()) {
+            benchmarkDoNotOptimize(it->next());
+        }
+    }
+}
+
+BENCHMARK(Sorter, SortTenThousandKeysInMemory) {
+    sortKeys(state, SortOptions());
+}
+
+BENCHMARK(Sorter, TopHundredOfTenThousandKeys) {
+    sortKeys(state, SortOptions().Limit(100));
+}
+
+}  // namespace
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
@@ -43,6 +43,7 @@
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/timer.h"
 
 // Need access to internal classes
 #include "mongo/db/sorter/sorter.cpp"
@@ -541,6 +542,110 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+class ParallelDupes : public Dupes {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return opts.NumThreads(4);
+    }
+};
+
+// Spills runs from background threads, each with a quarter of the memory limit.
+template <bool Random = true>
+class ParallelLotsOfDataLittleMemory : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return Parent::adjustSortOptions(opts).NumThreads(4);
+    }
+};
+
+// Fits in memory, so is sorted on several threads by done() instead.
+template <bool Random = true>
+class ParallelLotsOfDataInMemory : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return opts.MaxMemoryUsageBytes(64 * 1024 * 1024).NumThreads(4);
+    }
+};
+
+// Sorting on several threads must keep equal keys in the order they were added, like a single
+// stable sort.
+class ParallelSortIsStable {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterTests");
+        const SortOptions opts = SortOptions().TempDir(tempDir.path()).NumThreads(4);
+
+        // in memory
+        assertStable(SortOptions(opts).MaxMemoryUsageBytes(64 * 1024 * 1024));
+        // spilled
+        assertStable(SortOptions(opts).MaxMemoryUsageBytes(64 * 1024).ExtSortAllowed());
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+
+private:
+    enum { NUM_ITEMS = 200 * 1000, NUM_KEYS = 100 };
+
+    void assertStable(const SortOptions& opts) {
+        std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+        for (int i = 0; i < NUM_ITEMS; i++)
+            sorter->add(i % NUM_KEYS, i);
+
+        std::unique_ptr<IWIterator> it(sorter->done());
+        for (int key = 0; key < NUM_KEYS; key++) {
+            for (int val = key; val < NUM_ITEMS; val += NUM_KEYS) {
+                ASSERT(it->more());
+                IWPair pair = it->next();
+                ASSERT_EQUALS(pair.first, key);
+                ASSERT_EQUALS(pair.second, val);
+            }
+        }
+        ASSERT(!it->more());
+    }
+};
+
+// Not a correctness test: logs how long spilling sorts of the same data take with different
+// numbers of threads.
+class ParallelScaling {
+public:
+    void run() {
+// The debug builds are too slow to give meaningful timings.
+#if !defined(MONGO_CONFIG_DEBUG_BUILD)
+        std::vector<int> data(NUM_ITEMS);
+        for (int i = 0; i < NUM_ITEMS; i++)
+            data[i] = i;
+        std::random_shuffle(data.begin(), data.end());
+
+        unittest::TempDir tempDir("sorterTests");
+        for (size_t numThreads : {1, 2, 4, 8}) {
+            const SortOptions opts = SortOptions()
+                                         .TempDir(tempDir.path())
+                                         .ExtSortAllowed()
+                                         .MaxMemoryUsageBytes(MEM_LIMIT)
+                                         .NumThreads(numThreads);
+
+            Timer timer;
+            std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+            for (int i : data)
+                sorter->add(i, -i);
+            const int numFiles = sorter->numFiles();
+
+            std::unique_ptr<IWIterator> it(sorter->done());
+            for (int i = 0; i < NUM_ITEMS; i++) {
+                ASSERT(it->more());
+                ASSERT_EQUALS(it->next().first, i);
+            }
+            ASSERT(!it->more());
+
+            mongo::unittest::log() << "sorted " << int(NUM_ITEMS) << " items using "
+                                   << numThreads << " threads and " << numFiles << " files in "
+                                   << timer.millis() << "ms";
+        }
+#endif
+    }
+
+private:
+    enum { NUM_ITEMS = 4 * 1000 * 1000, MEM_LIMIT = 4 * 1024 * 1024 };
+};
 }
 
 class SorterSuite : public mongo::unittest::Suite {
@@ -558,10 +663,19 @@ public:
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
+        add<SorterTests::LotsOfDataWithLimit<2, /*random=*/true>>();      // smallest heap
+        add<SorterTests::LotsOfDataWithLimit<3, /*random=*/true>>();      // root has two children
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::ParallelDupes>();
+        add<SorterTests::ParallelLotsOfDataLittleMemory</*random=*/false>>();
+        add<SorterTests::ParallelLotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::ParallelLotsOfDataInMemory</*random=*/false>>();
+        add<SorterTests::ParallelLotsOfDataInMemory</*random=*/true>>();
+        add<SorterTests::ParallelSortIsStable>();
+        add<SorterTests::ParallelScaling>();
     }
 };
 
@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+size_t HdrLatencyHistogram::bucketFor(uint64_t latency) {
+    if (latency < kSubBuckets) {
+        return latency;
+    }
+
+    // The power of two 'latency' falls in, counted from the first one divided into sub-buckets.
+    const int magnitude = 63 - countLeadingZeros64(latency) - kSubBucketBits;
+    const uint64_t subBucket = (latency >> magnitude) - kSubBuckets;
+    return kSubBuckets + magnitude * kSubBuckets + subBucket;
+}
+
+uint64_t HdrLatencyHistogram::bucketLowerBound(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    const uint64_t magnitude = (bucket - kSubBuckets) / kSubBuckets;
+    const uint64_t subBucket = (bucket - kSubBuckets) % kSubBuckets;
+    return (kSubBuckets + subBucket) << magnitude;
+}
+
+void HdrLatencyHistogram::increment(uint64_t latency) {
+    const size_t bucket = bucketFor(latency);
+    if (bucket >= _buckets.size()) {
+        _buckets.resize(bucket + 1);
+    }
+    ++_buckets[bucket];
+    ++_count;
+    _max = std::max(_max, latency);
+}
+
+void HdrLatencyHistogram::merge(const HdrLatencyHistogram& other) {
+    if (other._buckets.size() > _buckets.size()) {
+        _buckets.resize(other._buckets.size());
+    }
+    for (size_t i = 0; i < other._buckets.size(); ++i) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _max = std::max(_max, other._max);
+}
+
+uint64_t HdrLatencyHistogram::percentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    const uint64_t rank =
+        std::max(uint64_t(1), static_cast<uint64_t>(std::ceil(_count * percentile / 100)));
+    if (rank >= _count) {
+        return _max;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            // Estimate the latency as the middle of its bucket.
+            const uint64_t lower = bucketLowerBound(i);
+            const uint64_t upper = bucketLowerBound(i + 1);
+            return std::min(lower + (upper - lower - 1) / 2, _max);
+        }
+    }
+    return _max;
+}
+
+void HdrLatencyHistogram::appendPercentiles(BSONObjBuilder* builder) const {
+    builder->append("p50", static_cast<long long>(percentile(50)));
+    builder->append("p90", static_cast<long long>(percentile(90)));
+    builder->append("p99", static_cast<long long>(percentile(99)));
+    builder->append("p999", static_cast<long long>(percentile(99.9)));
+    builder->append("max", static_cast<long long>(_max));
+}
+
+void ShardedHdrLatencyHistogram::increment(uint64_t latency) {
+    const size_t hash = std::hash<stdx::thread::id>()(stdx::this_thread::get_id());
+    Shard& shard = _shards[hash % kNumShards];
+    stdx::lock_guard<SpinLock> lk(shard.lock);
+    shard.histogram.increment(latency);
+}
+
+HdrLatencyHistogram ShardedHdrLatencyHistogram::snapshot() const {
+    HdrLatencyHistogram merged;
+    for (const auto& shard : _shards) {
+        stdx::lock_guard<SpinLock> lk(shard.lock);
+        merged.merge(shard.histogram);
+    }
+    return merged;
+}
+
+}  // namespace mongo
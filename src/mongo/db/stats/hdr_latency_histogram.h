@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/util/concurrency/spin_lock.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A log-linear histogram of latencies in microseconds, in the manner of HdrHistogram. Latencies
+ * below kSubBuckets each have a bucket of their own, and every power of two above is divided into
+ * kSubBuckets buckets of equal width. A bucket is thus at most 1/64th as wide as the latencies it
+ * holds, and the percentiles estimated from the buckets are within 1% of the actual ones.
+ *
+ * Only the buckets up to the highest latency recorded take memory.
+ *
+ * Note: This class is not thread-safe.
+ */
+class HdrLatencyHistogram {
+public:
+    static const int kSubBucketBits = 6;
+    static const uint64_t kSubBuckets = 1ULL << kSubBucketBits;
+
+    /**
+     * Returns the index of the bucket holding 'latency'.
+     */
+    static size_t bucketFor(uint64_t latency);
+
+    /**
+     * Returns the smallest latency held by bucket 'bucket'.
+     */
+    static uint64_t bucketLowerBound(size_t bucket);
+
+    void increment(uint64_t latency);
+
+    /**
+     * Adds the latencies recorded in 'other' to this histogram.
+     */
+    void merge(const HdrLatencyHistogram& other);
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    /**
+     * Returns an estimate of the latency which 'percentile' percent of the recorded latencies do
+     * not exceed, or 0 if no latency was recorded.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * Appends the 50th, 90th, 99th and 99.9th percentile and the maximum latency.
+     */
+    void appendPercentiles(BSONObjBuilder* builder) const;
+
+private:
+    std::vector<uint64_t> _buckets;
+    uint64_t _count = 0;
+    uint64_t _max = 0;
+};
+
+/**
+ * An HdrLatencyHistogram which many threads may increment at once. Threads are spread over a fixed
+ * number of shards, each a histogram with a lock of its own, so that they seldom contend.
+ */
+class ShardedHdrLatencyHistogram {
+public:
+    void increment(uint64_t latency);
+
+    /**
+     * Returns the latencies recorded in all of the shards.
+     */
+    HdrLatencyHistogram snapshot() const;
+
+private:
+    static const size_t kNumShards = 16;
+
+    struct Shard {
+        mutable SpinLock lock;
+        HdrLatencyHistogram histogram;
+    };
+
+    std::array<Shard, kNumShards> _shards;
+};
+
+}  // namespace mongo
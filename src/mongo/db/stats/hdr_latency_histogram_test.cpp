@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include <cstdlib>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(HdrLatencyHistogram, SmallLatenciesHaveBucketsOfTheirOwn) {
+    for (uint64_t latency = 0; latency < HdrLatencyHistogram::kSubBuckets; ++latency) {
+        ASSERT_EQUALS(latency, HdrLatencyHistogram::bucketFor(latency));
+        ASSERT_EQUALS(latency, HdrLatencyHistogram::bucketLowerBound(latency));
+    }
+}
+
+TEST(HdrLatencyHistogram, BucketsAreContiguousAndNarrow) {
+    for (size_t bucket = 1; bucket < 40 * HdrLatencyHistogram::kSubBuckets; ++bucket) {
+        const uint64_t lower = HdrLatencyHistogram::bucketLowerBound(bucket);
+        const uint64_t upper = HdrLatencyHistogram::bucketLowerBound(bucket + 1);
+        ASSERT_GREATER_THAN(upper, lower);
+        ASSERT_EQUALS(bucket, HdrLatencyHistogram::bucketFor(lower));
+        ASSERT_EQUALS(bucket, HdrLatencyHistogram::bucketFor(upper - 1));
+        ASSERT_EQUALS(bucket - 1, HdrLatencyHistogram::bucketFor(lower - 1));
+
+        // A bucket is at most 1/64th as wide as the latencies it holds.
+        if (bucket >= HdrLatencyHistogram::kSubBuckets) {
+            ASSERT_LESS_THAN_OR_EQUALS((upper - lower) * HdrLatencyHistogram::kSubBuckets, lower);
+        }
+    }
+}
+
+TEST(HdrLatencyHistogram, EmptyHistogramHasNoPercentiles) {
+    HdrLatencyHistogram hist;
+    ASSERT_EQUALS(0U, hist.count());
+    ASSERT_EQUALS(0U, hist.percentile(99));
+}
+
+TEST(HdrLatencyHistogram, PercentilesAreWithinOnePercent) {
+    HdrLatencyHistogram hist;
+    for (uint64_t latency = 1; latency <= 100000; ++latency) {
+        hist.increment(latency * 10);
+    }
+    ASSERT_EQUALS(100000U, hist.count());
+
+    auto assertNear = [&](double percentile, uint64_t expected) {
+        const uint64_t actual = hist.percentile(percentile);
+        const long long error =
+            std::llabs(static_cast<long long>(actual) - static_cast<long long>(expected));
+        ASSERT_LESS_THAN_OR_EQUALS(error * 100, static_cast<long long>(expected))
+            << "percentile " << percentile << " was " << actual << ", expected " << expected;
+    };
+    assertNear(50, 500000);
+    assertNear(90, 900000);
+    assertNear(99, 990000);
+    assertNear(99.9, 999000);
+    ASSERT_EQUALS(1000000U, hist.percentile(100));
+}
+
+TEST(HdrLatencyHistogram, AppendsPercentiles) {
+    HdrLatencyHistogram hist;
+    hist.increment(5);
+    hist.increment(7);
+    BSONObjBuilder builder;
+    hist.appendPercentiles(&builder);
+    BSONObj out = builder.obj();
+    ASSERT_EQUALS(5, out["p50"].Long());
+    ASSERT_EQUALS(7, out["p90"].Long());
+    ASSERT_EQUALS(7, out["p999"].Long());
+    ASSERT_EQUALS(7, out["max"].Long());
+}
+
+TEST(HdrLatencyHistogram, MergeAddsLatencies) {
+    HdrLatencyHistogram small;
+    HdrLatencyHistogram large;
+    small.increment(10);
+    large.increment(1000000);
+    small.merge(large);
+    ASSERT_EQUALS(2U, small.count());
+    ASSERT_EQUALS(1000000U, small.percentile(100));
+    ASSERT_EQUALS(10U, small.percentile(50));
+}
+
+TEST(ShardedHdrLatencyHistogram, SnapshotHasTheLatenciesOfEveryThread) {
+    ShardedHdrLatencyHistogram hist;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&hist, i] {
+            for (int j = 0; j < 1000; ++j) {
+                hist.increment(i * 1000 + j);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    HdrLatencyHistogram snapshot = hist.snapshot();
+    ASSERT_EQUALS(8000U, snapshot.count());
+    ASSERT_EQUALS(7999U, snapshot.percentile(100));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -28,6 +28,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <map>
+
+#include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -57,5 +60,36 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the latency percentiles of each command which has run to the server status.
+ */
+class CommandLatenciesServerStatusSection final : public ServerStatusSection {
+public:
+    CommandLatenciesServerStatusSection() : ServerStatusSection("commandLatencies") {}
+
+    bool includeByDefault() const {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const {
+        // Sorted by name, so that the section keeps its layout from one call to the next.
+        const std::map<std::string, Command*> commands(Command::commandsByBestName()->begin(),
+                                                       Command::commandsByBestName()->end());
+
+        BSONObjBuilder latencyBuilder;
+        for (const auto& entry : commands) {
+            const HdrLatencyHistogram latencies = entry.second->getLatencies();
+            if (latencies.count() == 0) {
+                continue;
+            }
+
+            BSONObjBuilder commandBuilder(latencyBuilder.subobjStart(entry.first));
+            commandBuilder.append("ops", static_cast<long long>(latencies.count()));
+            latencies.appendPercentiles(&commandBuilder);
+        }
+        return latencyBuilder.obj();
+    }
+} commandLatenciesServerStatusSection;
 }  // namespace
 }  // namespace mongo
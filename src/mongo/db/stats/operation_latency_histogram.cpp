@@ -111,6 +111,10 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
     }
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
     histogramBuilder.append("ops", static_cast<long long>(data.entryCount));
+    {
+        BSONObjBuilder percentilesBuilder(histogramBuilder.subobjStart("percentiles"));
+        data.percentiles.appendPercentiles(&percentilesBuilder);
+    }
     histogramBuilder.doneFast();
 }
 
@@ -151,6 +155,7 @@ void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, His
     data->buckets[bucket]++;
     data->entryCount++;
     data->sum += latency;
+    data->percentiles.increment(latency);
 }
 
 void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteType type) {
@@ -30,6 +30,7 @@
 #include <array>
 
 #include "mongo/db/commands.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
 
 namespace mongo {
 
@@ -53,7 +54,7 @@ public:
     void increment(uint64_t latency, Command::ReadWriteType type);
 
     /**
-     * Appends the three histograms with latency totals and operation counts.
+     * Appends the three histograms with latency totals, operation counts and latency percentiles.
      */
     void append(bool includeHistograms, BSONObjBuilder* builder) const;
 
@@ -62,6 +63,9 @@ private:
         std::array<uint64_t, kMaxBuckets> buckets{};
         uint64_t entryCount = 0;
         uint64_t sum = 0;
+
+        // The same latencies in finer buckets, from which the percentiles are estimated.
+        HdrLatencyHistogram percentiles;
     };
 
     static int _getBucket(uint64_t latency);
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+
+std::string makeKey(StringData ns, StringData queryShape) {
+    std::string key;
+    key.reserve(ns.size() + 1 + queryShape.size());
+    key.append(ns.rawData(), ns.size());
+    key.push_back('\0');
+    key.append(queryShape.rawData(), queryShape.size());
+    return key;
+}
+
+// The statistics of OpDebug are -1 when the operation did not set them.
+long long countOf(long long stat) {
+    return std::max(stat, 0LL);
+}
+
+}  // namespace
+
+// static
+QueryShapeStats& QueryShapeStats::get(ServiceContext* service) {
+    return getQueryShapeStats(service);
+}
+
+void QueryShapeStats::record(const CurOp& curOp, Date_t now) {
+    const OpDebug& debug = curOp.debug();
+    if (debug.queryShape.empty()) {
+        return;
+    }
+
+    const int maxEntries = internalQueryShapeStatsMaxEntries.load();
+    if (maxEntries <= 0) {
+        return;
+    }
+
+    const long long micros = debug.executionTimeMicros;
+    const auto& bounds = OperationLatencyHistogram::kLowerBounds;
+    const size_t bucket =
+        std::upper_bound(bounds.begin(), bounds.end(), static_cast<uint64_t>(micros)) -
+        bounds.begin() - 1;
+    std::string key = makeKey(debug.queryShapeNs, debug.queryShape);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _shapesByKey.find(key);
+    if (it == _shapesByKey.end()) {
+        while (_shapes.size() >= static_cast<size_t>(maxEntries)) {
+            const auto& evicted = _shapes.back();
+            _shapesByKey.erase(makeKey(evicted.ns, evicted.queryShape));
+            _shapes.pop_back();
+        }
+
+        _shapes.emplace_front();
+        _shapes.front().ns = debug.queryShapeNs;
+        _shapes.front().queryShape = debug.queryShape;
+        _shapes.front().firstRun = now;
+        it = _shapesByKey.emplace(std::move(key), _shapes.begin()).first;
+    } else if (it->second != _shapes.begin()) {
+        _shapes.splice(_shapes.begin(), _shapes, it->second);
+    }
+
+    ShapeData& shape = *it->second;
+    shape.lastRun = now;
+    ++shape.count;
+    shape.totalMicros += micros;
+    shape.maxMicros = std::max(shape.maxMicros, micros);
+    shape.keysExamined += countOf(debug.keysExamined);
+    shape.docsExamined += countOf(debug.docsExamined);
+    shape.nreturned += countOf(debug.nreturned);
+    shape.responseBytes += countOf(debug.responseLength);
+    shape.numYields += curOp.numYields();
+    shape.hasSortStage += debug.hasSortStage ? 1 : 0;
+    ++shape.latencyBuckets[bucket];
+}
+
+std::vector<BSONObj> QueryShapeStats::getStats(const NamespaceString& nss) const {
+    std::vector<BSONObj> stats;
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (const auto& shape : _shapes) {
+        if (shape.ns == nss.ns()) {
+            stats.push_back(shape.toBSON());
+        }
+    }
+    return stats;
+}
+
+void QueryShapeStats::collectionDropped(StringData ns) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (auto it = _shapes.begin(); it != _shapes.end();) {
+        if (it->ns == ns) {
+            _shapesByKey.erase(makeKey(it->ns, it->queryShape));
+            it = _shapes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+BSONObj QueryShapeStats::ShapeData::toBSON() const {
+    // The 99th percentile latency is reported as the upper bound of the bucket it falls in, which
+    // is at most twice the actual latency.
+    const auto& bounds = OperationLatencyHistogram::kLowerBounds;
+    const uint64_t p99Rank = (count * 99 + 99) / 100;
+    long long p99Micros = maxMicros;
+    uint64_t seen = 0;
+    for (size_t i = 0; i + 1 < latencyBuckets.size(); ++i) {
+        seen += latencyBuckets[i];
+        if (seen >= p99Rank) {
+            p99Micros = std::min(static_cast<long long>(bounds[i + 1]), maxMicros);
+            break;
+        }
+    }
+
+    BSONObjBuilder builder;
+    builder.append("ns", ns);
+    builder.append("queryShape", queryShape);
+    builder.append("count", count);
+    builder.append("totalTimeMicros", totalMicros);
+    builder.append("maxTimeMicros", maxMicros);
+    builder.append("p99TimeMicros", p99Micros);
+    builder.append("keysExamined", keysExamined);
+    builder.append("docsExamined", docsExamined);
+    builder.append("nreturned", nreturned);
+    builder.append("responseBytes", responseBytes);
+    builder.append("numYields", numYields);
+    builder.append("inMemorySorts", hasSortStage);
+    builder.append("firstRun", firstRun);
+    builder.append("lastRun", lastRun);
+    return builder.obj();
+}
+
+}  // namespace mongo
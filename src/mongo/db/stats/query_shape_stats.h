@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CurOp;
+class NamespaceString;
+class ServiceContext;
+
+/**
+ * Accumulates execution statistics per query shape, as identified by the plan cache key of a query
+ * and the collection it ran against. Every operation which plans a query adds its statistics to
+ * the shape of that query when it finishes.
+ *
+ * At most internalQueryShapeStatsMaxEntries shapes are kept. Beyond that the least recently run
+ * shape is forgotten.
+ */
+class QueryShapeStats {
+    MONGO_DISALLOW_COPYING(QueryShapeStats);
+
+public:
+    static QueryShapeStats& get(ServiceContext* service);
+
+    QueryShapeStats() = default;
+
+    /**
+     * Adds the statistics of the finished operation 'curOp' to the shape of the query it planned,
+     * if any. 'now' becomes the shape's last run time, so the service's fast clock is precise
+     * enough for it.
+     */
+    void record(const CurOp& curOp, Date_t now);
+
+    /**
+     * Returns one document of statistics for each query shape run against 'nss'.
+     */
+    std::vector<BSONObj> getStats(const NamespaceString& nss) const;
+
+    /**
+     * Forgets the query shapes run against 'ns'.
+     */
+    void collectionDropped(StringData ns);
+
+private:
+    struct ShapeData {
+        std::string ns;
+        std::string queryShape;
+
+        Date_t firstRun;
+        Date_t lastRun;
+
+        long long count = 0;
+        long long totalMicros = 0;
+        long long maxMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long responseBytes = 0;
+        long long numYields = 0;
+        long long hasSortStage = 0;
+
+        // Operation counts by latency, with the bucket bounds of OperationLatencyHistogram.
+        std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets> latencyBuckets{};
+
+        BSONObj toBSON() const;
+    };
+
+    using ShapeList = std::list<ShapeData>;
+
+    // Guards the members below.
+    mutable stdx::mutex _mutex;
+
+    // Most recently run shape first.
+    ShapeList _shapes;
+
+    // Keyed by the namespace and the plan cache key of the shape, separated by a NUL byte.
+    stdx::unordered_map<std::string, ShapeList::iterator> _shapesByKey;
+};
+
+}  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/resource_usage.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getResourceUsage = ServiceContext::declareDecoration<ResourceUsage>();
+
+// The statistics of OpDebug are -1 when the operation did not set them.
+long long countOf(long long stat) {
+    return std::max(stat, 0LL);
+}
+
+}  // namespace
+
+const size_t ResourceUsage::kMaxEntries;
+
+// static
+ResourceUsage& ResourceUsage::get(ServiceContext* service) {
+    return getResourceUsage(service);
+}
+
+ResourceUsage::UsageCounters& ResourceUsage::UsageCounters::operator+=(
+    const UsageCounters& other) {
+    ops += other.ops;
+    executionMicros += other.executionMicros;
+    cpuMicros += other.cpuMicros;
+    keysExamined += other.keysExamined;
+    docsExamined += other.docsExamined;
+    storageBytesRead += other.storageBytesRead;
+    storageBytesWritten += other.storageBytesWritten;
+    networkBytesIn += other.networkBytesIn;
+    networkBytesOut += other.networkBytesOut;
+    return *this;
+}
+
+void ResourceUsage::UsageCounters::append(BSONObjBuilder* builder) const {
+    builder->appendNumber("ops", ops);
+    builder->appendNumber("executionMicros", executionMicros);
+    builder->appendNumber("cpuMicros", cpuMicros);
+    builder->appendNumber("keysExamined", keysExamined);
+    builder->appendNumber("docsExamined", docsExamined);
+    builder->appendNumber("storageBytesRead", storageBytesRead);
+    builder->appendNumber("storageBytesWritten", storageBytesWritten);
+    builder->appendNumber("networkBytesIn", networkBytesIn);
+    builder->appendNumber("networkBytesOut", networkBytesOut);
+}
+
+void ResourceUsage::record(const CurOp& curOp, UserNameIterator users) {
+    const OpDebug& debug = curOp.debug();
+
+    UsageCounters usage;
+    usage.ops = 1;
+    usage.executionMicros = debug.executionTimeMicros;
+    usage.cpuMicros = countOf(debug.cpuMicros);
+    usage.keysExamined = countOf(debug.keysExamined);
+    usage.docsExamined = countOf(debug.docsExamined);
+    usage.storageBytesRead = debug.storageStats.bytesRead;
+    usage.storageBytesWritten = debug.storageStats.bytesWritten;
+    usage.networkBytesIn = countOf(debug.requestLength);
+    usage.networkBytesOut = countOf(debug.responseLength);
+
+    const std::string ns = curOp.getNS();
+    const StringData db = nsToDatabaseSubstring(ns);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    bool tracked = db.empty() || _add(&_databases, db, usage);
+    while (users.more()) {
+        tracked = _add(&_users, users.next().getFullName(), usage) && tracked;
+    }
+
+    if (!tracked) {
+        ++_untrackedOps;
+    }
+}
+
+// static
+bool ResourceUsage::_add(StringMap<UsageCounters>* map,
+                         StringData key,
+                         const UsageCounters& usage) {
+    auto it = map->find(key);
+    if (it == map->end()) {
+        if (map->size() >= kMaxEntries) {
+            return false;
+        }
+        (*map)[key] = usage;
+        return true;
+    }
+
+    it->second += usage;
+    return true;
+}
+
+void ResourceUsage::append(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    {
+        BSONArrayBuilder databasesBuilder(builder->subarrayStart("databases"));
+        for (const auto& entry : _databases) {
+            BSONObjBuilder dbBuilder(databasesBuilder.subobjStart());
+            dbBuilder.append("db", entry.first);
+            entry.second.append(&dbBuilder);
+        }
+    }
+
+    {
+        BSONArrayBuilder usersBuilder(builder->subarrayStart("users"));
+        for (const auto& entry : _users) {
+            BSONObjBuilder userBuilder(usersBuilder.subobjStart());
+            userBuilder.append("user", entry.first);
+            entry.second.append(&userBuilder);
+        }
+    }
+
+    builder->appendNumber("untrackedOps", _untrackedOps);
+}
+
+}  // namespace mongo
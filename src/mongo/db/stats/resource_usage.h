@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/auth/user_name.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class CurOp;
+class ServiceContext;
+
+/**
+ * Accumulates the resources used by operations per database and per authenticated user, for
+ * chargeback of shared deployments and to find the tenants which load a server the most. Every
+ * operation received from a client adds its counters to the database it ran against and to each
+ * user authenticated on its connection when it finishes.
+ *
+ * At most kMaxEntries databases and kMaxEntries users are kept. The operations of any others are
+ * only counted as untracked.
+ */
+class ResourceUsage {
+    MONGO_DISALLOW_COPYING(ResourceUsage);
+
+public:
+    static const size_t kMaxEntries = 10000;
+
+    static ResourceUsage& get(ServiceContext* service);
+
+    ResourceUsage() = default;
+
+    /**
+     * Adds the resources used by the finished operation 'curOp' to its database and to 'users'.
+     */
+    void record(const CurOp& curOp, UserNameIterator users);
+
+    /**
+     * Appends the counters of each database, under "databases", and of each user, under "users".
+     */
+    void append(BSONObjBuilder* builder) const;
+
+private:
+    struct UsageCounters {
+        long long ops = 0;
+        long long executionMicros = 0;
+        long long cpuMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long storageBytesRead = 0;
+        long long storageBytesWritten = 0;
+        long long networkBytesIn = 0;
+        long long networkBytesOut = 0;
+
+        UsageCounters& operator+=(const UsageCounters& other);
+
+        void append(BSONObjBuilder* builder) const;
+    };
+
+    /**
+     * Adds 'usage' to the counters of 'key' in 'map', unless the map is full. Returns false if
+     * the usage could not be tracked.
+     */
+    static bool _add(StringMap<UsageCounters>* map, StringData key, const UsageCounters& usage);
+
+    // Guards the members below.
+    mutable stdx::mutex _mutex;
+
+    StringMap<UsageCounters> _databases;
+    StringMap<UsageCounters> _users;
+
+    // The number of operations which could not be counted against their database or a user,
+    // because the number of entries reached kMaxEntries.
+    long long _untrackedOps = 0;
+};
+
+}  // namespace mongo
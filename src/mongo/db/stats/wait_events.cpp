@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/threadlocal.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+TSP_DECLARE(ThreadWaitState, threadWaitState);
+TSP_DEFINE(ThreadWaitState, threadWaitState);
+
+namespace {
+
+std::array<AtomicInt64, WaitEventCounters::kNumWaitEvents> globalCount;
+std::array<AtomicInt64, WaitEventCounters::kNumWaitEvents> globalMicros;
+
+size_t toIndex(WaitEvent event) {
+    return static_cast<size_t>(event);
+}
+
+}  // namespace
+
+StringData waitEventName(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicket:
+            return "ticket"_sd;
+        case WaitEvent::kJournal:
+            return "journal"_sd;
+        case WaitEvent::kReplication:
+            return "replication"_sd;
+        case WaitEvent::kYield:
+            return "yield"_sd;
+        case WaitEvent::kFetch:
+            return "fetch"_sd;
+        case WaitEvent::kNetwork:
+            return "network"_sd;
+        case WaitEvent::kNumWaitEvents:
+            break;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void WaitEventCounters::append(BSONObjBuilder* builder) const {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        if (count[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder eventBuilder(builder->subobjStart(waitEventName(static_cast<WaitEvent>(i))));
+        eventBuilder.appendNumber("count", count[i]);
+        eventBuilder.appendNumber("micros", micros[i]);
+    }
+}
+
+bool WaitEventCounters::empty() const {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        if (count[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WaitEventCounters& WaitEventCounters::operator-=(const WaitEventCounters& other) {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        count[i] -= other.count[i];
+        micros[i] -= other.micros[i];
+    }
+    return *this;
+}
+
+ThreadWaitState* ThreadWaitState::get() {
+    return threadWaitState.getMake();
+}
+
+WaitEventCounters ThreadWaitState::totals() const {
+    WaitEventCounters totals;
+    for (size_t i = 0; i < WaitEventCounters::kNumWaitEvents; ++i) {
+        totals.count[i] = _count[i].load();
+        totals.micros[i] = _micros[i].load();
+    }
+    return totals;
+}
+
+void ThreadWaitState::appendCurrentWait(StringData fieldName, BSONObjBuilder* builder) const {
+    const int event = _currentEvent.load();
+    if (event == kNoWait) {
+        return;
+    }
+
+    // The start time is published before the event, but the wait may have ended and a new one
+    // started since the event was read. A negative duration is reported as zero.
+    const long long waitedMicros = curTimeMicros64() - _currentStartMicros.load();
+
+    BSONObjBuilder waitBuilder(builder->subobjStart(fieldName));
+    waitBuilder.append("event", waitEventName(static_cast<WaitEvent>(event)));
+    waitBuilder.appendNumber("micros", std::max(waitedMicros, 0LL));
+}
+
+WaitEventCounters ThreadWaitState::globalTotals() {
+    WaitEventCounters totals;
+    for (size_t i = 0; i < WaitEventCounters::kNumWaitEvents; ++i) {
+        totals.count[i] = globalCount[i].load();
+        totals.micros[i] = globalMicros[i].load();
+    }
+    return totals;
+}
+
+void ThreadWaitState::_begin(WaitEvent event, long long startMicros) {
+    _currentStartMicros.store(startMicros);
+    _currentEvent.store(static_cast<int>(event));
+}
+
+void ThreadWaitState::_end(WaitEvent event, long long startMicros, long long endMicros) {
+    const size_t i = toIndex(event);
+    const long long waitedMicros = std::max(endMicros - startMicros, 0LL);
+
+    // Only this thread updates its own counters, so they need not be incremented atomically.
+    _count[i].store(_count[i].load() + 1);
+    _micros[i].store(_micros[i].load() + waitedMicros);
+
+    globalCount[i].fetchAndAdd(1);
+    globalMicros[i].fetchAndAdd(waitedMicros);
+}
+
+WaitEventScope::WaitEventScope(WaitEvent event)
+    : _state(ThreadWaitState::get()),
+      _event(event),
+      _startMicros(curTimeMicros64()),
+      _previousEvent(_state->_currentEvent.load()),
+      _previousStartMicros(_state->_currentStartMicros.load()) {
+    _state->_begin(_event, _startMicros);
+}
+
+WaitEventScope::~WaitEventScope() {
+    _state->_end(_event, _startMicros, curTimeMicros64());
+
+    _state->_currentStartMicros.store(_previousStartMicros);
+    _state->_currentEvent.store(_previousEvent);
+}
+
+}  // namespace mongo
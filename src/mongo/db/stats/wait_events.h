@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The kinds of blocking an operation can spend its time in, besides waiting for locks, which the
+ * lock statistics of its Locker already account for.
+ */
+enum class WaitEvent {
+    kTicket,       // Waiting for a storage engine read or write ticket.
+    kJournal,      // Waiting for the journal or the data files to be flushed to disk.
+    kReplication,  // Waiting for a write concern to be satisfied by the replica set.
+    kYield,        // Yielded by a plan executor, up to having reacquired its locks.
+    kFetch,        // Paging in a record from disk while a plan executor has yielded.
+    kNetwork,      // Waiting for the response of a remote command.
+    kNumWaitEvents
+};
+
+StringData waitEventName(WaitEvent event);
+
+/**
+ * The number of waits and the total microseconds waited for each WaitEvent.
+ */
+struct WaitEventCounters {
+    static constexpr size_t kNumWaitEvents = static_cast<size_t>(WaitEvent::kNumWaitEvents);
+
+    /**
+     * Appends {<event>: {count: <n>, micros: <n>}} for every event which was waited for.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    /**
+     * Returns true if no event was waited for.
+     */
+    bool empty() const;
+
+    WaitEventCounters& operator-=(const WaitEventCounters& other);
+
+    std::array<long long, kNumWaitEvents> count{};
+    std::array<long long, kNumWaitEvents> micros{};
+};
+
+/**
+ * The waits of a single thread. As an operation runs on a single thread, the waits of an
+ * operation are the difference between the totals of its thread at its end and at its start.
+ *
+ * The thread which owns the ThreadWaitState is the only one which updates it, but any thread may
+ * read it for as long as the owning thread is alive.
+ */
+class ThreadWaitState {
+    MONGO_DISALLOW_COPYING(ThreadWaitState);
+
+public:
+    ThreadWaitState() = default;
+
+    /**
+     * Returns the ThreadWaitState of the calling thread, creating it if necessary.
+     */
+    static ThreadWaitState* get();
+
+    /**
+     * Returns the totals of all of the waits of this thread which have finished.
+     */
+    WaitEventCounters totals() const;
+
+    /**
+     * Appends {event: <event>, micros: <n>} under 'fieldName' if this thread is currently waiting.
+     */
+    void appendCurrentWait(StringData fieldName, BSONObjBuilder* builder) const;
+
+    /**
+     * Returns the totals of the waits of all threads of this process, for serverStatus.
+     */
+    static WaitEventCounters globalTotals();
+
+private:
+    friend class WaitEventScope;
+
+    static constexpr int kNoWait = -1;
+
+    void _begin(WaitEvent event, long long startMicros);
+    void _end(WaitEvent event, long long startMicros, long long endMicros);
+
+    std::array<AtomicInt64, WaitEventCounters::kNumWaitEvents> _count;
+    std::array<AtomicInt64, WaitEventCounters::kNumWaitEvents> _micros;
+
+    AtomicInt32 _currentEvent{kNoWait};
+    AtomicInt64 _currentStartMicros;
+};
+
+/**
+ * Marks the calling thread as waiting for 'event' for the lifetime of this object, after which
+ * the time waited is added to the totals of the thread and of the process. Scopes of the same
+ * thread may nest, in which case the time waited counts towards each of them.
+ */
+class WaitEventScope {
+    MONGO_DISALLOW_COPYING(WaitEventScope);
+
+public:
+    explicit WaitEventScope(WaitEvent event);
+    ~WaitEventScope();
+
+private:
+    ThreadWaitState* const _state;
+    const WaitEvent _event;
+    const long long _startMicros;
+    const int _previousEvent;
+    const long long _previousStartMicros;
+};
+
+}  // namespace mongo
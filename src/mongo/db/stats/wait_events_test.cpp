@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/stats/wait_events.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace {
+
+using namespace mongo;
+
+size_t toIndex(WaitEvent event) {
+    return static_cast<size_t>(event);
+}
+
+TEST(WaitEventsTest, ScopeAddsToThreadAndGlobalTotals) {
+    const auto threadBefore = ThreadWaitState::get()->totals();
+    const auto globalBefore = ThreadWaitState::globalTotals();
+    {
+        WaitEventScope scope(WaitEvent::kTicket);
+        sleepmillis(2);
+    }
+
+    auto threadWaits = ThreadWaitState::get()->totals();
+    threadWaits -= threadBefore;
+    ASSERT_EQ(1, threadWaits.count[toIndex(WaitEvent::kTicket)]);
+    ASSERT_GTE(threadWaits.micros[toIndex(WaitEvent::kTicket)], 1000);
+    ASSERT_EQ(0, threadWaits.count[toIndex(WaitEvent::kJournal)]);
+
+    auto globalWaits = ThreadWaitState::globalTotals();
+    globalWaits -= globalBefore;
+    ASSERT_GTE(globalWaits.count[toIndex(WaitEvent::kTicket)], 1);
+}
+
+TEST(WaitEventsTest, WaitsOfOtherThreadsAreNotCounted) {
+    const auto before = ThreadWaitState::get()->totals();
+    stdx::thread([] { WaitEventScope scope(WaitEvent::kNetwork); }).join();
+
+    auto waits = ThreadWaitState::get()->totals();
+    waits -= before;
+    ASSERT_TRUE(waits.empty());
+}
+
+TEST(WaitEventsTest, CurrentWaitRestoredAfterNestedScope) {
+    auto state = ThreadWaitState::get();
+    {
+        BSONObjBuilder builder;
+        state->appendCurrentWait("waitingFor", &builder);
+        ASSERT_BSONOBJ_EQ(BSONObj(), builder.obj());
+    }
+
+    WaitEventScope yieldScope(WaitEvent::kYield);
+    {
+        WaitEventScope ticketScope(WaitEvent::kTicket);
+        BSONObjBuilder builder;
+        state->appendCurrentWait("waitingFor", &builder);
+        ASSERT_EQ("ticket", builder.obj()["waitingFor"]["event"].str());
+    }
+
+    BSONObjBuilder builder;
+    state->appendCurrentWait("waitingFor", &builder);
+    ASSERT_EQ("yield", builder.obj()["waitingFor"]["event"].str());
+}
+
+TEST(WaitEventsTest, AppendOnlyReportsEventsWaitedFor) {
+    WaitEventCounters counters;
+    counters.count[toIndex(WaitEvent::kReplication)] = 2;
+    counters.micros[toIndex(WaitEvent::kReplication)] = 150;
+
+    BSONObjBuilder builder;
+    counters.append(&builder);
+    ASSERT_BSONOBJ_EQ(BSON("replication" << BSON("count" << 2LL << "micros" << 150LL)),
+                      builder.obj());
+}
+
+}  // namespace
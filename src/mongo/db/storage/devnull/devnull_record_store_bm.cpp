@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/storage/devnull/devnull_kv_engine.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Runs the RecordStore benchmarks against devnull, as a baseline of the cost of the benchmark and
+ * the RecordStore interface themselves. devnull has no equivalent unit test, as it stores nothing.
+ */
+class DevNullHarnessHelper final : public RecordStoreHarnessHelper {
+public:
+    std::unique_ptr<RecordStore> newNonCappedRecordStore() final {
+        return _engine.getRecordStore(nullptr, "a.b", "ident", CollectionOptions());
+    }
+
+    std::unique_ptr<RecordStore> newCappedRecordStore(int64_t cappedSizeBytes,
+                                                      int64_t cappedMaxDocs) final {
+        CollectionOptions options;
+        options.capped = true;
+        options.cappedSize = cappedSizeBytes;
+        options.cappedMaxDocs = cappedMaxDocs;
+        return _engine.getRecordStore(nullptr, "a.b", "ident", options);
+    }
+
+    std::unique_ptr<RecoveryUnit> newRecoveryUnit() final {
+        return std::unique_ptr<RecoveryUnit>(_engine.newRecoveryUnit());
+    }
+
+    bool supportsDocLocking() final {
+        return true;
+    }
+
+private:
+    DevNullKVEngine _engine;
+};
+
+std::unique_ptr<HarnessHelper> makeHarnessHelper() {
+    return stdx::make_unique<DevNullHarnessHelper>();
+}
+
+MONGO_INITIALIZER(RegisterHarnessFactory)(InitializerContext* const) {
+    mongo::registerHarnessHelperFactory(makeHarnessHelper);
+    return Status::OK();
+}
+}  // namespace
+}  // namespace mongo
@@ -160,12 +160,28 @@ public:
             return Status(ErrorCodes::KeyTooLong, msg);
         }
 
-        // TODO optimization: save the iterator from the dup-check to speed up insert
-        if (!dupsAllowed && isDup(*_data, key, loc))
-            return dupKeyError(key);
-
+        bool inserted;
         IndexKeyEntry entry(key.getOwned(), loc);
-        if (_data->insert(entry).second) {
+        if (dupsAllowed) {
+            inserted = _data->insert(entry).second;
+        } else {
+            // A null RecordId compares equal to every entry with the same key, so this finds the
+            // only entry that may exist for 'key' in a unique index. When there is none, it is
+            // also exactly where the new entry belongs, so the insert below needs no second
+            // search of the tree.
+            const IndexKeyEntry anyLoc(key, RecordId());
+            const auto it = _data->lower_bound(anyLoc);
+            if (it != _data->end() && _data->key_comp().compare(*it, anyLoc) == 0) {
+                if (it->loc != loc)
+                    return dupKeyError(key);
+                inserted = false;
+            } else {
+                _data->insert(it, entry);
+                inserted = true;
+            }
+        }
+
+        if (inserted) {
             _currentKeySize += key.objsize();
             opCtx->recoveryUnit()->registerChange(new IndexChange(_data, entry, true));
         }
@@ -179,13 +195,15 @@ public:
         invariant(loc.isNormal());
         invariant(!hasFieldNames(key));
 
-        IndexKeyEntry entry(key.getOwned(), loc);
-        const size_t numDeleted = _data->erase(entry);
-        invariant(numDeleted <= 1);
-        if (numDeleted == 1) {
-            _currentKeySize -= key.objsize();
-            opCtx->recoveryUnit()->registerChange(new IndexChange(_data, entry, false));
-        }
+        const auto it = _data->find(IndexKeyEntry(key, loc));
+        if (it == _data->end())
+            return;
+
+        // The stored entry already owns its key, so keeping it for rollback requires no copy.
+        IndexKeyEntry entry = *it;
+        _data->erase(it);
+        _currentKeySize -= key.objsize();
+        opCtx->recoveryUnit()->registerChange(new IndexChange(_data, entry, false));
     }
 
     virtual void fullValidate(OperationContext* opCtx,
@@ -233,6 +233,18 @@ void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+
+    // Flip a word at a time. This loop is simple enough for the compiler to widen it further
+    // where vector instructions are available.
+    while (static_cast<size_t>(end - input) >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, input, sizeof(word));
+        word = ~word;
+        memcpy(output, &word, sizeof(word));
+        input += sizeof(word);
+        output += sizeof(word);
+    }
+
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -284,10 +296,8 @@ string readInvertedCString(BufReader* reader) {
     const char* end = static_cast<const char*>(memchr(start, 0xFF, reader->remaining()));
     invariant(end);
     size_t actualBytes = end - start;
-    string s(start, actualBytes);
-    for (size_t i = 0; i < s.size(); i++) {
-        s[i] = ~s[i];
-    }
+    string s(actualBytes, '\0');
+    memcpy_flipBits(&s[0], start, actualBytes);
     reader->skip(1 + actualBytes);
     return s;
 }
@@ -314,9 +324,7 @@ string readInvertedCStringWithNuls(BufReader* reader) {
         reader->skip(1 + actualBytes);
     } while (reader->peek<unsigned char>() == 0x00);
 
-    for (size_t i = 0; i < out.size(); i++) {
-        out[i] = ~out[i];
-    }
+    memcpy_flipBits(&out[0], out.data(), out.size());
 
     return out;
 }
@@ -857,10 +865,11 @@ void KeyString::_appendBsonValue(const BSONElement& elem, bool invert, const Str
 
 void KeyString::_appendStringLike(StringData str, bool invert) {
     while (true) {
-        size_t firstNul = strnlen(str.rawData(), str.size());
+        const char* nul = static_cast<const char*>(memchr(str.rawData(), 0, str.size()));
+        size_t firstNul = nul ? nul - str.rawData() : str.size();
         // No NULs in string.
         _appendBytes(str.rawData(), firstNul, invert);
-        if (firstNul == str.size() || firstNul == std::string::npos) {
+        if (!nul) {
             _append(int8_t(0), invert);
             break;
         }
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+const BSONObj kCompoundKey = BSON("" << 12345 << ""
+                                     << "some string"
+                                     << ""
+                                     << 3.25);
+const Ordering kOrdering = Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1));
+
+BENCHMARK(KeyString, EncodeCompoundKey) {
+    KeyString ks(KeyString::Version::V1);
+    while (state.keepRunning()) {
+        ks.resetToKey(kCompoundKey, kOrdering, RecordId(42));
+        benchmarkDoNotOptimize(ks.getSize());
+    }
+}
+
+BENCHMARK(KeyString, RoundTripCompoundKey) {
+    KeyString ks(KeyString::Version::V1);
+    while (state.keepRunning()) {
+        ks.resetToKey(kCompoundKey, kOrdering);
+        benchmarkDoNotOptimize(
+            KeyString::toBson(ks.getBuffer(), ks.getSize(), kOrdering, ks.getTypeBits()));
+    }
+}
+
+BENCHMARK(KeyString, RoundTripInt) {
+    const BSONObj key = BSON("" << 7);
+    const Ordering ordering = Ordering::make(BSON("a" << 1));
+
+    KeyString ks(KeyString::Version::V1);
+    while (state.keepRunning()) {
+        ks.resetToKey(key, ordering);
+        benchmarkDoNotOptimize(
+            KeyString::toBson(ks.getBuffer(), ks.getSize(), ordering, ks.getTypeBits()));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
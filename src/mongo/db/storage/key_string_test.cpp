@@ -522,6 +522,27 @@ TEST_F(KeyStringTest, Timestamp) {
     }
 }
 
+TEST_F(KeyStringTest, LongStringsWithNuls) {
+    // Lengths around multiples of the word size exercise both the wide and the tail loops of the
+    // bit flipping done for descending keys.
+    for (size_t len : {1, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1000}) {
+        std::string str;
+        for (size_t i = 0; i < len; ++i) {
+            str += static_cast<char>('a' + i % 26);
+        }
+        ROUNDTRIP(version, BSON("" << str));
+
+        str[len / 2] = '\0';
+        str[len - 1] = '\0';
+        ROUNDTRIP(version, BSON("" << str));
+        ROUNDTRIP(version, BSON("" << BSONSymbol(str)));
+    }
+
+    const std::string prefix(100, 'x');
+    COMPARES_SAME(version, BSON("" << prefix + 'a'), BSON("" << prefix + 'b'));
+    COMPARES_SAME(version, BSON("" << prefix), BSON("" << prefix + '\0'));
+}
+
 TEST_F(KeyStringTest, AllTypesRoundtrip) {
     for (int i = 1; i <= JSTypeMax; i++) {
         {
@@ -1108,7 +1129,9 @@ unsigned newSeed() {
  * Evaluates ROUNDTRIP on all items in Numbers a sufficient number of times to take at least
  * kMinPerfMicros microseconds. Logs the elapsed time per ROUNDTRIP evaluation.
  */
-void perfTest(KeyString::Version version, const Numbers& numbers) {
+void perfTest(KeyString::Version version,
+              const Numbers& numbers,
+              Ordering order = ALL_ASCENDING) {
     uint64_t micros = 0;
     uint64_t iters;
     // Ensure at least 16 iterations are done and at least 50 milliseconds is timed
@@ -1120,8 +1143,8 @@ void perfTest(KeyString::Version version, const Numbers& numbers) {
             for (auto item : numbers) {
                 // Assuming there are sufficient invariants in the to/from KeyString methods
                 // that calls will not be optimized away.
-                const KeyString ks(version, item, ALL_ASCENDING);
-                const BSONObj& converted = toBson(ks, ALL_ASCENDING);
+                const KeyString ks(version, item, order);
+                const BSONObj& converted = toBson(ks, order);
                 invariant(converted.binaryEqual(item));
             }
 
@@ -1251,3 +1274,21 @@ TEST_F(KeyStringTest, DecimalFromUniformDoublePerf) {
     }
     perfTest(version, numbers);
 }
+
+TEST_F(KeyStringTest, StringPerf) {
+    std::vector<BSONObj> strings;
+    std::mt19937 gen(newSeed());
+    std::uniform_int_distribution<int> length(0, 64);
+    std::uniform_int_distribution<int> character('a', 'z');
+
+    for (uint64_t x = 0; x < kMinPerfSamples; x++) {
+        std::string str(length(gen), '\0');
+        for (auto& c : str) {
+            c = character(gen);
+        }
+        strings.push_back(BSON("" << str));
+    }
+
+    perfTest(version, strings);
+    perfTest(version, strings, ONE_DESCENDING);
+}
@@ -38,6 +38,7 @@
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/kv_storage_engine.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/storage/storage_options.h"
 
 namespace mongo {
 
@@ -137,6 +138,29 @@ bool KVDatabaseCatalogEntryBase::hasUserData() const {
 }
 
 int64_t KVDatabaseCatalogEntryBase::sizeOnDisk(OperationContext* opCtx) const {
+    const auto maxAge = Milliseconds(storageGlobalParams.storageStatsCacheMillis.load());
+    if (maxAge <= Milliseconds(0)) {
+        return _computeSizeOnDisk(opCtx);
+    }
+
+    const Date_t now = Date_t::now();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sizeOnDiskMutex);
+        if (_sizeOnDiskComputedAt != Date_t() && now - _sizeOnDiskComputedAt < maxAge) {
+            return _cachedSizeOnDisk;
+        }
+    }
+
+    // Computed outside of the mutex, since it opens a statistics cursor per collection and index.
+    const int64_t size = _computeSizeOnDisk(opCtx);
+
+    stdx::lock_guard<stdx::mutex> lk(_sizeOnDiskMutex);
+    _cachedSizeOnDisk = size;
+    _sizeOnDiskComputedAt = now;
+    return size;
+}
+
+int64_t KVDatabaseCatalogEntryBase::_computeSizeOnDisk(OperationContext* opCtx) const {
     int64_t size = 0;
 
     for (CollectionMap::const_iterator it = _collections.begin(); it != _collections.end(); ++it) {
@@ -33,6 +33,8 @@
 #include <string>
 
 #include "mongo/db/catalog/database_catalog_entry.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -48,6 +50,10 @@ public:
     bool isEmpty() const override;
     bool hasUserData() const override;
 
+    /**
+     * Returns the sum of the on-disk sizes of the database's collections and indexes. The result
+     * is served from a cache while it is younger than the 'storageStatsCacheMillis' parameter.
+     */
     int64_t sizeOnDisk(OperationContext* opCtx) const override;
 
     void appendExtraStats(OperationContext* opCtx,
@@ -96,8 +102,15 @@ protected:
 
     typedef std::map<std::string, KVCollectionCatalogEntry*> CollectionMap;
 
+    int64_t _computeSizeOnDisk(OperationContext* opCtx) const;
 
     KVStorageEngine* const _engine;  // not owned here
     CollectionMap _collections;
+
+    // Last result of _computeSizeOnDisk() and when it was taken. Readers share the database lock,
+    // so the cache has its own mutex.
+    mutable stdx::mutex _sizeOnDiskMutex;
+    mutable int64_t _cachedSizeOnDisk = 0;
+    mutable Date_t _sizeOnDiskComputedAt;
 };
 }  // namespace mongo
@@ -138,9 +138,9 @@ enum {
     NumCommitsBeforeRemap = 10,
 
     // How many outstanding journal flushes should be allowed before applying writer back
-    // pressure. Size of 1 allows two journal blocks to be in the process of being written -
-    // one on the journal writer's buffer and one blocked waiting to be picked up.
-    NumAsyncJournalWrites = 1,
+    // pressure. Size of 2 lets a commit be prepared and compressed while the one before it is
+    // still being written to the journal.
+    NumAsyncJournalWrites = 2,
 };
 
 // Remap loop state
@@ -726,6 +726,11 @@ static void durThread(ClockSource* cs, int64_t serverStartMs) {
 
             Timer t;
 
+            // Get the buffer before the flush lock, as this waits for an earlier commit's journal
+            // write to complete if all of the buffers are in use, and writers cannot proceed
+            // while the lock is held.
+            JournalWriter::Buffer* const buffer = journalWriter.newBuffer();
+
             const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
             OperationContext& opCtx = *opCtxPtr;
             AutoAcquireFlushLockForMMAPV1Commit autoFlushLock(opCtx.lockState());
@@ -744,14 +749,12 @@ static void durThread(ClockSource* cs, int64_t serverStartMs) {
                 // getlasterror request could have came after the data was already committed.
                 // No need to call committingReset though, because we have not done any
                 // writes (hasWritten == false).
-                JournalWriter::Buffer* const buffer = journalWriter.newBuffer();
                 buffer->setNoop();
                 buffer->journalListenerToken = getJournalListener()->getToken();
 
                 journalWriter.writeBuffer(buffer, commitNumber);
             } else {
                 // This copies all the in-memory changes into the journal writer's buffer.
-                JournalWriter::Buffer* const buffer = journalWriter.newBuffer();
                 PREPLOGBUFFER(buffer->getHeader(), buffer->getBuilder(), cs, serverStartMs);
 
                 estimatedPrivateMapSize += commitJob.bytes();
@@ -752,19 +752,10 @@ void Journal::_rotate(unsigned long long lsnOfCurrentJournalEntry) {
     }
 }
 
-/** write (append) the buffer we have built to the journal and fsync it.
-    outside of dbMutex lock as this could be slow.
-    @param uncompressed - a buffer that will be written to the journal after compression
-    will not return until on disk
-*/
-void WRITETOJOURNAL(const JSectHeader& h, const AlignedBuilder& uncompressed) {
-    Timer t;
-    j.journal(h, uncompressed);
-    stats.curr()->_writeToJournalMicros += t.micros();
-}
-
-void Journal::journal(const JSectHeader& h, const AlignedBuilder& uncompressed) {
-    static AlignedBuilder b(32 * 1024 * 1024);
+void COMPRESSFORJOURNAL(const JSectHeader& h,
+                        const AlignedBuilder& uncompressed,
+                        AlignedBuilder* compressed) {
+    AlignedBuilder& b = *compressed;
     /* buffer to journal will be
        JSectHeader
        compressed operations
@@ -784,6 +775,35 @@ void Journal::journal(const JSectHeader& h, const AlignedBuilder& uncompressed)
     verify(compressedLength < 0xffffffff);
     verify(compressedLength < max);
     b.skip(compressedLength);
+}
+
+/** write (append) a section we have built to the journal and fsync it.
+    outside of dbMutex lock as this could be slow.
+    @param compressed - a section started by COMPRESSFORJOURNAL
+    will not return until on disk
+*/
+void WRITETOJOURNAL(const JSectHeader& h,
+                    AlignedBuilder& compressed,
+                    unsigned uncompressedLen) {
+    Timer t;
+    j.journal(h, compressed, uncompressedLen);
+    stats.curr()->_writeToJournalMicros += t.micros();
+}
+
+void Journal::journal(const JSectHeader& h, AlignedBuilder& b, unsigned uncompressedLen) {
+    unsigned long long fileId;
+    {
+        stdx::lock_guard<SimpleMutex> lk(_curLogFileMutex);
+
+        // must already be open -- so that _curFileId is correct for previous buffer building
+        verify(_curLogFile);
+        fileId = _curFileId;
+    }
+
+    // The section may have been compressed before the previous one rotated to a new file, so its
+    // file id is only filled in now, as recovery stops at a section of another file. Only this
+    // thread rotates the file, so the id stays current until the section is written.
+    ((JSectHeader*)b.atOfs(0))->fileId = fileId;
 
     // footer
     unsigned L = 0xffffffff;
@@ -806,14 +826,10 @@ void Journal::journal(const JSectHeader& h, const AlignedBuilder& uncompressed)
 
     try {
         stdx::lock_guard<SimpleMutex> lk(_curLogFileMutex);
-
-        // must already be open -- so that _curFileId is correct for previous buffer building
         verify(_curLogFile);
 
-        stats.curr()->_uncompressedBytes += uncompressed.len();
-        unsigned w = b.len();
-        _written += w;
-        verify(w <= L);
+        stats.curr()->_uncompressedBytes += uncompressedLen;
+        _written += L;
         stats.curr()->_journaledBytes += L;
         _curLogFile->synchronousAppend((const void*)b.buf(), L);
         _rotate(h.seqNumber);
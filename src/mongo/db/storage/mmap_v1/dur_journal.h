@@ -83,9 +83,22 @@ unsigned long long journalReadLSN();
 bool haveJournalFiles(bool anyFiles = false);
 
 /**
- * Writes the specified uncompressed buffer to the journal.
+ * Starts in 'compressed' the journal section for the specified uncompressed buffer: its header
+ * followed by the compressed buffer. Does no I/O and can be done ahead of the WRITETOJOURNAL of
+ * earlier sections.
  */
-void WRITETOJOURNAL(const JSectHeader& h, const AlignedBuilder& uncompressed);
+void COMPRESSFORJOURNAL(const JSectHeader& h,
+                        const AlignedBuilder& uncompressed,
+                        AlignedBuilder* compressed);
+
+/**
+ * Completes the specified section started by COMPRESSFORJOURNAL with the current journal file's
+ * id and its footer, and writes it to the journal. 'uncompressedLen' is only used for the
+ * statistics.
+ */
+void WRITETOJOURNAL(const JSectHeader& h,
+                    AlignedBuilder& compressed,
+                    unsigned uncompressedLen);
 
 // in case disk controller buffers writes
 const long long ExtraKeepTimeMs = 10000;
@@ -119,13 +119,16 @@ JournalWriter::JournalWriter(CommitNotifier* commitNotify,
       _shutdownRequested(false),
       _journalQueue(numBuffers),
       _lastCommitNumber(0),
+      _compressedQueue(numBuffers),
       _readyQueue(numBuffers) {
     invariant(_journalQueue.maxSize() == _readyQueue.maxSize());
+    invariant(_compressedQueue.maxSize() == _readyQueue.maxSize());
 }
 
 JournalWriter::~JournalWriter() {
     // Never close the journal writer with outstanding or unaccounted writes
     invariant(_journalQueue.empty());
+    invariant(_compressedQueue.empty());
     invariant(_readyQueue.empty());
 }
 
@@ -138,9 +141,12 @@ void JournalWriter::start() {
         _readyQueue.push(new Buffer(InitialBufferSizeBytes));
     }
 
-    // Start the thread
-    stdx::thread t(stdx::bind(&JournalWriter::_journalWriterThread, this));
-    _journalWriterThreadHandle.swap(t);
+    // Start the threads
+    stdx::thread compressor(stdx::bind(&JournalWriter::_journalCompressorThread, this));
+    _journalCompressorThreadHandle.swap(compressor);
+
+    stdx::thread writer(stdx::bind(&JournalWriter::_journalWriterThread, this));
+    _journalWriterThreadHandle.swap(writer);
 }
 
 void JournalWriter::shutdown() {
@@ -154,11 +160,12 @@ void JournalWriter::shutdown() {
     Buffer* const shutdownBuffer = newBuffer();
     shutdownBuffer->_setShutdown();
 
-    // This will terminate the journal thread. No need to specify commit number, since we are
+    // This will terminate the journal threads. No need to specify commit number, since we are
     // shutting down and nothing will be notified anyways.
     writeBuffer(shutdownBuffer, 0);
 
-    // Ensure the journal thread has stopped and everything accounted for.
+    // Ensure the journal threads have stopped and everything accounted for.
+    _journalCompressorThreadHandle.join();
     _journalWriterThreadHandle.join();
     assertIdle();
 
@@ -172,6 +179,7 @@ void JournalWriter::shutdown() {
 void JournalWriter::assertIdle() {
     // All buffers are in the ready queue means there is nothing pending.
     invariant(_journalQueue.empty());
+    invariant(_compressedQueue.empty());
     invariant(_readyQueue.count() == _readyQueue.maxSize());
 }
 
@@ -206,6 +214,37 @@ void JournalWriter::flush() {
     }
 }
 
+void JournalWriter::_journalCompressorThread() {
+    Client::initThread("journal compressor");
+
+    try {
+        while (true) {
+            Buffer* const buffer = _journalQueue.blockingPop();
+
+            if (!buffer->_isShutdown && !buffer->_isNoop) {
+                COMPRESSFORJOURNAL(buffer->_header, buffer->_builder, &buffer->_compressed);
+            }
+
+            // Buffers go on to the writer thread in the order they were submitted. There are no
+            // more buffers than the queue holds, so this never blocks.
+            invariant(_compressedQueue.count() < _compressedQueue.maxSize());
+            _compressedQueue.push(buffer);
+
+            if (buffer->_isShutdown) {
+                // The writer thread terminates on the same buffer.
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        severe() << "exception in journalCompressorThread causing immediate shutdown: "
+                 << redact(e.what());
+        invariant(false);
+    } catch (...) {
+        severe() << "unhandled exception in journalCompressorThread causing immediate shutdown";
+        invariant(false);
+    }
+}
+
 void JournalWriter::_journalWriterThread() {
     Client::initThread("journal writer");
 
@@ -213,7 +252,7 @@ void JournalWriter::_journalWriterThread() {
 
     try {
         while (true) {
-            Buffer* const buffer = _journalQueue.blockingPop();
+            Buffer* const buffer = _compressedQueue.blockingPop();
             BufferGuard bufferGuard(buffer, &_readyQueue);
 
             if (buffer->_isShutdown) {
@@ -237,7 +276,7 @@ void JournalWriter::_journalWriterThread() {
                    << ", size " << buffer->_builder.len() << " bytes)";
 
             // This performs synchronous I/O to the journal file and will block.
-            WRITETOJOURNAL(buffer->_header, buffer->_builder);
+            WRITETOJOURNAL(buffer->_header, buffer->_compressed, buffer->_builder.len());
 
             // Data is now persisted in the journal, which is sufficient for acknowledging
             // durability.
@@ -281,7 +320,12 @@ void JournalWriter::_journalWriterThread() {
 //
 
 JournalWriter::Buffer::Buffer(size_t initialSize)
-    : _commitNumber(0), _isNoop(false), _isShutdown(false), _header(), _builder(initialSize) {}
+    : _commitNumber(0),
+      _isNoop(false),
+      _isShutdown(false),
+      _header(),
+      _builder(initialSize),
+      _compressed(initialSize) {}
 
 JournalWriter::Buffer::~Buffer() {
     _assertEmpty();
@@ -296,6 +340,7 @@ void JournalWriter::Buffer::_reset() {
     _commitNumber = 0;
     _isNoop = false;
     _builder.reset();
+    _compressed.reset();
 }
 
 }  // namespace dur
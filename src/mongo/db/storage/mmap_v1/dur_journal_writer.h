@@ -40,8 +40,9 @@ namespace mongo {
 namespace dur {
 
 /**
- * Manages the thread and queues used for writing the journal to disk and notify parties with
- * are waiting on the write concern.
+ * Manages the threads and queues used for writing the journal to disk and notify parties with
+ * are waiting on the write concern. Buffers are compressed on one thread and written on another,
+ * so that a buffer can be compressed while the one before it is being written.
  *
  * NOTE: Not thread-safe and must not be used from more than one thread.
  */
@@ -97,6 +98,9 @@ public:
 
         JSectHeader _header;
         AlignedBuilder _builder;
+
+        // The journal section built from _builder by the compressor thread
+        AlignedBuilder _compressed;
     };
 
 
@@ -172,6 +176,7 @@ private:
     enum { InitialBufferSizeBytes = 4 * 1024 * 1024 };
 
 
+    void _journalCompressorThread();
     void _journalWriterThread();
 
 
@@ -182,16 +187,20 @@ private:
     // This gets notified as journal buffers are done being applied to the shared view
     CommitNotifier* const _applyToDataFilesNotify;
 
-    // Wraps and controls the journal writer thread
+    // Wrap and control the journal compressor and writer threads
+    stdx::thread _journalCompressorThreadHandle;
     stdx::thread _journalWriterThreadHandle;
 
     // Indicates that shutdown has been requested. Used for idempotency of the shutdown call.
     bool _shutdownRequested;
 
-    // Queue of buffers, which need to be written by the journal writer thread
+    // Queue of buffers, which need to be compressed by the journal compressor thread
     BufferQueue _journalQueue;
     CommitNotifier::When _lastCommitNumber;
 
+    // Queue of compressed buffers, which need to be written by the journal writer thread
+    BufferQueue _compressedQueue;
+
     // Queue of buffers, whose write has been completed by the journal writer thread.
     BufferQueue _readyQueue;
 };
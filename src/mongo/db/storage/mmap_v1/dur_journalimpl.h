@@ -62,9 +62,9 @@ public:
      */
     void rotate();
 
-    /** append to the journal file
+    /** complete a section started by COMPRESSFORJOURNAL and append it to the journal file
     */
-    void journal(const JSectHeader& h, const AlignedBuilder& b);
+    void journal(const JSectHeader& h, AlignedBuilder& b, unsigned uncompressedLen);
 
     boost::filesystem::path getFilePathFor(int filenumber) const;
 
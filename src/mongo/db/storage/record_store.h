@@ -30,14 +30,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
+#include "mongo/base/status_with.h"
 #include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/record_data.h"
 #include "mongo/db/storage/record_fetcher.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
@@ -248,6 +253,41 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Looks up every Record in 'ids', setting (*out)[i] to the Record with id ids[i], or to
+     * boost::none if there is no such Record. Unlike with seekExact(), the returned Records own
+     * their data, so they all remain valid however the cursor is used afterwards. The resulting
+     * position of the cursor is unspecified.
+     *
+     * The lookups are done in RecordId order rather than in the order of 'ids', so that a batch
+     * of ids produced by an index scan visits the collection's storage roughly sequentially.
+     */
+    virtual void seekExactBatch(const std::vector<RecordId>& ids,
+                                std::vector<boost::optional<Record>>* out) {
+        std::vector<size_t> order(ids.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return ids[lhs] < ids[rhs];
+        });
+
+        out->clear();
+        out->resize(ids.size());
+        for (size_t i : order) {
+            if (auto record = seekExact(ids[i])) {
+                (*out)[i] = Record{record->id, record->data.getOwned()};
+            }
+        }
+    }
+
+    /**
+     * Hints that the caller is going to read a long run of records from this cursor with next(),
+     * as a collection scan does, so the storage engine may start reading the records ahead of the
+     * cursor in the background. The default implementation ignores the hint.
+     */
+    virtual void hintSequentialScan() {}
+
     /**
      * Prepares for state changes in underlying data without necessarily saving the current
      * state.
@@ -488,6 +528,21 @@ public:
         return {};
     }
 
+    /**
+     * Constructs a cursor for a block sample of about 'sampleSize' records of the record store,
+     * which returns runs of up to 'blockSize' consecutive records, each starting at a random
+     * record. Reading a run is much cheaper than finding as many random records, at the cost of
+     * the records of a run being correlated in whatever way neighbouring records are (such as by
+     * insertion time). The cursor does not return a record more than once, unless it fails to
+     * find a record it has not yet returned after many attempts. Returns {} if the record store
+     * does not support block sampling.
+     */
+    virtual std::unique_ptr<RecordCursor> getBlockSampleCursor(OperationContext* opCtx,
+                                                               long long sampleSize,
+                                                               long long blockSize) const {
+        return {};
+    }
+
     /**
      * Returns many RecordCursors that partition the RecordStore into many disjoint sets.
      * Iterating all returned RecordCursors is equivalent to iterating the full store.
@@ -546,6 +601,18 @@ public:
         invariant(false);
     }
 
+    /**
+     * Does up to 'timeLimit' of the work of an in-place compaction while other operations keep
+     * using this RecordStore, and returns whether the compaction is complete. Calling it again
+     * after it returned false continues the compaction.
+     *
+     * Only called if compactsInPlace() returns true.
+     */
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds timeLimit) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      str::stream() << "online compact is not supported by " << name());
+    }
+
     /**
      * @return OK if the validate run successfully
      *         OK will be returned even if corruption is found
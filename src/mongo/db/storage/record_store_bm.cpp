@@ -0,0 +1,275 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+const int kNumPreloadedRecords = 10000;
+
+/**
+ * Work done by one thread of a benchmark: 'iterations' operations, using 'opCtx'.
+ */
+using ThreadWork = stdx::function<void(OperationContext* opCtx, int thread, long long iterations)>;
+
+/**
+ * Runs the iterations of the benchmark spread over 'numThreads' threads, each with a Client and
+ * an OperationContext of its own.
+ */
+void runOnThreads(BenchmarkState& state,
+                  RecordStoreHarnessHelper* harness,
+                  int numThreads,
+                  const ThreadWork& work) {
+    while (state.keepRunning()) {
+        std::vector<stdx::thread> threads;
+        for (int thread = 0; thread < numThreads; ++thread) {
+            // The first threads take what is left over from an even split.
+            long long iterations = state.iterations() / numThreads +
+                (thread < state.iterations() % numThreads ? 1 : 0);
+            threads.emplace_back([&, thread, iterations] {
+                auto client = harness->serviceContext()->makeClient(
+                    str::stream() << "benchmark" << thread);
+                auto opCtx = harness->newOperationContext(client.get());
+                work(opCtx.get(), thread, iterations);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        state.skipRemainingIterations();
+    }
+}
+
+/**
+ * Serializes the writes of threads to a record store without document-level locking, as the
+ * collection lock would in the server.
+ */
+class WriteSerializer {
+public:
+    explicit WriteSerializer(RecordStoreHarnessHelper* harness)
+        : _serialize(!harness->supportsDocLocking()) {}
+
+    stdx::unique_lock<stdx::mutex> lock() {
+        return _serialize ? stdx::unique_lock<stdx::mutex>(_mutex)
+                          : stdx::unique_lock<stdx::mutex>();
+    }
+
+private:
+    const bool _serialize;
+    stdx::mutex _mutex;
+};
+
+std::vector<RecordId> preloadRecords(RecordStoreHarnessHelper* harness,
+                                     RecordStore* rs,
+                                     int valueSize) {
+    const std::string value(valueSize, 'x');
+    auto opCtx = harness->newOperationContext();
+
+    std::vector<RecordId> ids;
+    for (int i = 0; i < kNumPreloadedRecords; ++i) {
+        WriteUnitOfWork wuow(opCtx.get());
+        ids.push_back(
+            uassertStatusOK(rs->insertRecord(opCtx.get(), value.data(), value.size(), false)));
+        wuow.commit();
+    }
+    return ids;
+}
+
+void benchmarkInsert(BenchmarkState& state, int valueSize, int numThreads) {
+    auto harness = newRecordStoreHarnessHelper();
+    auto rs = harness->newNonCappedRecordStore();
+    const std::string value(valueSize, 'x');
+    WriteSerializer serializer(harness.get());
+
+    runOnThreads(state,
+                 harness.get(),
+                 numThreads,
+                 [&](OperationContext* opCtx, int thread, long long iterations) {
+                     for (long long i = 0; i < iterations; ++i) {
+                         auto lk = serializer.lock();
+                         WriteUnitOfWork wuow(opCtx);
+                         uassertStatusOK(
+                             rs->insertRecord(opCtx, value.data(), value.size(), false));
+                         wuow.commit();
+                     }
+                 });
+}
+
+void benchmarkUpdate(BenchmarkState& state, int valueSize, int numThreads) {
+    auto harness = newRecordStoreHarnessHelper();
+    auto rs = harness->newNonCappedRecordStore();
+    const auto ids = preloadRecords(harness.get(), rs.get(), valueSize);
+    const std::string value(valueSize, 'y');
+    WriteSerializer serializer(harness.get());
+
+    runOnThreads(state,
+                 harness.get(),
+                 numThreads,
+                 [&](OperationContext* opCtx, int thread, long long iterations) {
+                     // Each thread updates records of its own, so that they never conflict.
+                     size_t index = thread;
+                     for (long long i = 0; i < iterations; ++i) {
+                         auto lk = serializer.lock();
+                         WriteUnitOfWork wuow(opCtx);
+                         uassertStatusOK(rs->updateRecord(
+                             opCtx, ids[index], value.data(), value.size(), false, nullptr));
+                         wuow.commit();
+                         index = (index + numThreads) % ids.size();
+                     }
+                 });
+}
+
+void benchmarkSeek(BenchmarkState& state, int valueSize, int numThreads) {
+    auto harness = newRecordStoreHarnessHelper();
+    auto rs = harness->newNonCappedRecordStore();
+    const auto ids = preloadRecords(harness.get(), rs.get(), valueSize);
+
+    runOnThreads(state,
+                 harness.get(),
+                 numThreads,
+                 [&](OperationContext* opCtx, int thread, long long iterations) {
+                     PseudoRandom random(thread);
+                     auto cursor = rs->getCursor(opCtx);
+                     for (long long i = 0; i < iterations; ++i) {
+                         benchmarkDoNotOptimize(
+                             cursor->seekExact(ids[random.nextInt32(ids.size())]));
+                     }
+                 });
+}
+
+void benchmarkScan(BenchmarkState& state, int valueSize) {
+    auto harness = newRecordStoreHarnessHelper();
+    auto rs = harness->newNonCappedRecordStore();
+    preloadRecords(harness.get(), rs.get(), valueSize);
+    auto opCtx = harness->newOperationContext();
+
+    auto cursor = rs->getCursor(opCtx.get());
+    while (state.keepRunning()) {
+        auto record = cursor->next();
+        if (!record) {
+            cursor = rs->getCursor(opCtx.get());
+        }
+        benchmarkDoNotOptimize(record);
+    }
+}
+
+void benchmarkSaveRestore(BenchmarkState& state) {
+    auto harness = newRecordStoreHarnessHelper();
+    auto rs = harness->newNonCappedRecordStore();
+    preloadRecords(harness.get(), rs.get(), 100);
+    auto opCtx = harness->newOperationContext();
+
+    auto cursor = rs->getCursor(opCtx.get());
+    while (state.keepRunning()) {
+        if (!cursor->next()) {
+            cursor = rs->getCursor(opCtx.get());
+        }
+        cursor->save();
+        cursor->restore();
+    }
+}
+
+BENCHMARK(RecordStore, Insert16B) {
+    benchmarkInsert(state, 16, 1);
+}
+
+BENCHMARK(RecordStore, Insert1KB) {
+    benchmarkInsert(state, 1024, 1);
+}
+
+BENCHMARK(RecordStore, Insert16KB) {
+    benchmarkInsert(state, 16 * 1024, 1);
+}
+
+BENCHMARK(RecordStore, Insert1KB4Threads) {
+    benchmarkInsert(state, 1024, 4);
+}
+
+BENCHMARK(RecordStore, Insert1KB16Threads) {
+    benchmarkInsert(state, 1024, 16);
+}
+
+BENCHMARK(RecordStore, Update16B) {
+    benchmarkUpdate(state, 16, 1);
+}
+
+BENCHMARK(RecordStore, Update1KB) {
+    benchmarkUpdate(state, 1024, 1);
+}
+
+BENCHMARK(RecordStore, Update1KB4Threads) {
+    benchmarkUpdate(state, 1024, 4);
+}
+
+BENCHMARK(RecordStore, Seek1KB) {
+    benchmarkSeek(state, 1024, 1);
+}
+
+BENCHMARK(RecordStore, Seek1KB4Threads) {
+    benchmarkSeek(state, 1024, 4);
+}
+
+BENCHMARK(RecordStore, Seek1KB16Threads) {
+    benchmarkSeek(state, 1024, 16);
+}
+
+BENCHMARK(RecordStore, Scan16B) {
+    benchmarkScan(state, 16);
+}
+
+BENCHMARK(RecordStore, Scan1KB) {
+    benchmarkScan(state, 1024);
+}
+
+BENCHMARK(RecordStore, SaveRestore) {
+    benchmarkSaveRestore(state);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/base/status.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/db/storage/snapshot_name.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 
 namespace mongo {
 
@@ -123,6 +124,41 @@ public:
         return {};
     }
 
+    /**
+     * Informs this RecoveryUnit that all future reads through it should be from the local
+     * snapshot, the newest snapshot taken at a consistent point in replication, such as between
+     * two batches of oplog application on a secondary. Newer local snapshots should be used if
+     * available whenever implementations would normally change snapshots.
+     *
+     * If there is no local snapshot, returns a status with error code LocalSnapshotNotAvailable.
+     * If the local snapshot is dropped afterwards, a UserException with the same code should be
+     * thrown when implementations attempt to acquire it.
+     *
+     * StorageEngines that don't support a SnapshotManager should use the default
+     * implementation.
+     */
+    virtual Status setReadFromLocalSnapshot() {
+        return {ErrorCodes::CommandNotSupported,
+                "Current storage engine does not support local snapshot reads"};
+    }
+
+    /**
+     * Makes future reads through this RecoveryUnit see the latest data again after
+     * setReadFromLocalSnapshot(). The current snapshot must have been abandoned.
+     */
+    virtual void clearReadFromLocalSnapshot() {}
+
+    /**
+     * Returns the SnapshotName being used by this recovery unit or boost::none if not reading from
+     * the local snapshot.
+     *
+     * It is possible for reads to occur from later snapshots, but they may not occur from earlier
+     * snapshots.
+     */
+    virtual boost::optional<SnapshotName> getLocalSnapshot() const {
+        return {};
+    }
+
     /**
      * Gets the local SnapshotId.
      *
@@ -250,8 +286,22 @@ public:
      */
     virtual void setRollbackWritesDisabled() = 0;
 
+    /**
+     * Returns the counts of the storage engine work done through this RecoveryUnit so far. They
+     * stay at zero for storage engines which don't keep them.
+     */
+    StorageOperationStats& storageStats() {
+        return _storageStats;
+    }
+    const StorageOperationStats& storageStats() const {
+        return _storageStats;
+    }
+
 protected:
     RecoveryUnit() {}
+
+private:
+    StorageOperationStats _storageStats;
 };
 
 }  // namespace mongo
@@ -82,6 +82,15 @@ public:
      */
     virtual void setCommittedSnapshot(const SnapshotName& name) = 0;
 
+    /**
+     * Sets the snapshot to be used for local snapshot reads. This is the newest snapshot taken at
+     * a consistent point in replication, which need not be majority committed yet.
+     *
+     * Implementations are allowed to assume that the passed in name compares greater than or
+     * equal to the committed snapshot and all local snapshots set before.
+     */
+    virtual void setLocalSnapshot(const SnapshotName& name) = 0;
+
     /**
      * Cleans up all snapshots older than the current committed snapshot.
      *
@@ -92,7 +101,7 @@ public:
     virtual void cleanupUnneededSnapshots() = 0;
 
     /**
-     * Drops all snapshots and clears the "committed" snapshot.
+     * Drops all snapshots and clears the "committed" and "local" snapshots.
      */
     virtual void dropAllSnapshots() = 0;
 
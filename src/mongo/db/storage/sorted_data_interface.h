@@ -133,6 +133,15 @@ public:
         return Status::OK();
     }
 
+    /**
+     * Does up to 'timeLimit' of the work of compact() while other operations keep using this
+     * index, and returns whether the compaction is complete. Calling it again after it returned
+     * false continues the compaction.
+     */
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds timeLimit) {
+        return true;
+    }
+
     //
     // Information about the tree
     //
@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/db/storage/sorted_data_interface_test_harness.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+using unittest::benchmarkDoNotOptimize;
+
+const int kNumPreloadedKeys = 10000;
+
+/**
+ * Returns the index key numbered 'i'. Keys of a 'keySize' of 0 are numbers, and the others are
+ * strings of that size, ordered like their numbers.
+ */
+BSONObj makeKey(long long i, int keySize) {
+    if (keySize == 0) {
+        return BSON("" << i);
+    }
+
+    std::string number = std::to_string(i);
+    invariant(static_cast<int>(number.size()) <= keySize);
+    return BSON("" << (std::string(keySize - number.size(), '0') + number));
+}
+
+std::vector<BSONObj> preloadKeys(SortedDataInterfaceHarnessHelper* harness,
+                                 SortedDataInterface* sorted,
+                                 int keySize) {
+    auto opCtx = harness->newOperationContext();
+
+    std::vector<BSONObj> keys;
+    for (int i = 0; i < kNumPreloadedKeys; ++i) {
+        keys.push_back(makeKey(i, keySize));
+        WriteUnitOfWork wuow(opCtx.get());
+        uassertStatusOK(sorted->insert(opCtx.get(), keys.back(), RecordId(i + 1), true));
+        wuow.commit();
+    }
+    return keys;
+}
+
+void benchmarkInsert(BenchmarkState& state, int keySize, bool randomOrder) {
+    auto harness = newSortedDataInterfaceHarnessHelper();
+    auto sorted = harness->newSortedDataInterface(false);
+    auto opCtx = harness->newOperationContext();
+
+    // The keys are made before the clock starts, so that only the inserts are timed.
+    PseudoRandom random(1);
+    std::vector<BSONObj> keys;
+    for (long long i = 0; i < state.iterations(); ++i) {
+        keys.push_back(makeKey(randomOrder ? random.nextInt32() & 0x7fffffff : i, keySize));
+    }
+
+    long long i = 0;
+    while (state.keepRunning()) {
+        WriteUnitOfWork wuow(opCtx.get());
+        uassertStatusOK(sorted->insert(opCtx.get(), keys[i], RecordId(i + 1), true));
+        wuow.commit();
+        ++i;
+    }
+}
+
+void benchmarkSeek(BenchmarkState& state, int keySize) {
+    auto harness = newSortedDataInterfaceHarnessHelper();
+    auto sorted = harness->newSortedDataInterface(false);
+    const auto keys = preloadKeys(harness.get(), sorted.get(), keySize);
+    auto opCtx = harness->newOperationContext();
+
+    PseudoRandom random(1);
+    auto cursor = sorted->newCursor(opCtx.get());
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(cursor->seek(keys[random.nextInt32(keys.size())], true));
+    }
+}
+
+void benchmarkScan(BenchmarkState& state, int keySize) {
+    auto harness = newSortedDataInterfaceHarnessHelper();
+    auto sorted = harness->newSortedDataInterface(false);
+    const auto keys = preloadKeys(harness.get(), sorted.get(), keySize);
+    auto opCtx = harness->newOperationContext();
+
+    auto cursor = sorted->newCursor(opCtx.get());
+    benchmarkDoNotOptimize(cursor->seek(keys.front(), true));
+    while (state.keepRunning()) {
+        auto entry = cursor->next();
+        if (!entry) {
+            entry = cursor->seek(keys.front(), true);
+        }
+        benchmarkDoNotOptimize(entry);
+    }
+}
+
+void benchmarkSaveRestore(BenchmarkState& state) {
+    auto harness = newSortedDataInterfaceHarnessHelper();
+    auto sorted = harness->newSortedDataInterface(false);
+    const auto keys = preloadKeys(harness.get(), sorted.get(), 0);
+    auto opCtx = harness->newOperationContext();
+
+    auto cursor = sorted->newCursor(opCtx.get());
+    benchmarkDoNotOptimize(cursor->seek(keys.front(), true));
+    while (state.keepRunning()) {
+        if (!cursor->next()) {
+            cursor->seek(keys.front(), true);
+        }
+        cursor->save();
+        cursor->restore();
+    }
+}
+
+BENCHMARK(SortedDataInterface, InsertNumber) {
+    benchmarkInsert(state, 0, false);
+}
+
+BENCHMARK(SortedDataInterface, InsertNumberRandomOrder) {
+    benchmarkInsert(state, 0, true);
+}
+
+BENCHMARK(SortedDataInterface, InsertString100B) {
+    benchmarkInsert(state, 100, false);
+}
+
+BENCHMARK(SortedDataInterface, InsertString800B) {
+    benchmarkInsert(state, 800, false);
+}
+
+BENCHMARK(SortedDataInterface, SeekNumber) {
+    benchmarkSeek(state, 0);
+}
+
+BENCHMARK(SortedDataInterface, SeekString100B) {
+    benchmarkSeek(state, 100);
+}
+
+BENCHMARK(SortedDataInterface, SeekString800B) {
+    benchmarkSeek(state, 800);
+}
+
+BENCHMARK(SortedDataInterface, ScanNumber) {
+    benchmarkScan(state, 0);
+}
+
+BENCHMARK(SortedDataInterface, ScanString800B) {
+    benchmarkScan(state, 800);
+}
+
+BENCHMARK(SortedDataInterface, SaveRestore) {
+    benchmarkSaveRestore(state);
+}
+
+}  // namespace
+}  // namespace mongo
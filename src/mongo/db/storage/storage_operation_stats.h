@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+/**
+ * Counts of the storage engine work done through a RecoveryUnit. Storage engines which keep these
+ * counters update them from their record store and index cursors, so they can be attributed to the
+ * operation, and to the plan stage, which did the work.
+ */
+struct StorageOperationStats {
+    // Positionings of a cursor on a key or record id.
+    long long cursorSeeks = 0;
+    // Advances of a positioned cursor to the following key or record.
+    long long cursorNexts = 0;
+    // Bytes of the keys and records returned by cursors.
+    long long bytesRead = 0;
+    // Inserts, updates and removals of keys and records.
+    long long cursorWrites = 0;
+    // Bytes of the records inserted or updated.
+    long long bytesWritten = 0;
+
+    StorageOperationStats& operator+=(const StorageOperationStats& other) {
+        cursorSeeks += other.cursorSeeks;
+        cursorNexts += other.cursorNexts;
+        bytesRead += other.bytesRead;
+        cursorWrites += other.cursorWrites;
+        bytesWritten += other.bytesWritten;
+        return *this;
+    }
+
+    StorageOperationStats& operator-=(const StorageOperationStats& other) {
+        cursorSeeks -= other.cursorSeeks;
+        cursorNexts -= other.cursorNexts;
+        bytesRead -= other.bytesRead;
+        cursorWrites -= other.cursorWrites;
+        bytesWritten -= other.bytesWritten;
+        return *this;
+    }
+
+    bool empty() const {
+        return !cursorSeeks && !cursorNexts && !cursorWrites;
+    }
+
+    void append(BSONObjBuilder* builder) const {
+        builder->appendNumber("cursorSeeks", cursorSeeks);
+        builder->appendNumber("cursorNexts", cursorNexts);
+        builder->appendNumber("bytesRead", bytesRead);
+        builder->appendNumber("cursorWrites", cursorWrites);
+        builder->appendNumber("bytesWritten", bytesWritten);
+    }
+};
+
+}  // namespace mongo
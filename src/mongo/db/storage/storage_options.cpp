@@ -59,6 +59,16 @@ const double StorageGlobalParams::kMaxSyncdelaySecs = 9.0 * 1000.0 * 1000.0;
 ExportedServerParameter<bool, ServerParameterType::kStartupAndRuntime> NoTableScanSetting(
     ServerParameterSet::getGlobal(), "notablescan", &storageGlobalParams.noTableScan);
 
+/**
+ * Specify how long the storage sizes reported by listDatabases and dbStats may be cached. Each
+ * recomputation opens a statistics cursor per collection and index, which is costly on instances
+ * with many collections.
+ */
+ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> StorageStatsCacheMillis(
+    ServerParameterSet::getGlobal(),
+    "storageStatsCacheMillis",
+    &storageGlobalParams.storageStatsCacheMillis);
+
 /**
  * Specify the interval in seconds between fsync operations where mongod flushes its
  * working memory to disk. By default, mongod flushes memory to disk every 60 seconds.
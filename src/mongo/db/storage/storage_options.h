@@ -88,6 +88,11 @@ struct StorageGlobalParams {
     // no table scans allowed
     AtomicBool noTableScan{false};
 
+    // --setParameter storageStatsCacheMillis
+    // How long, in milliseconds, the on-disk sizes reported by listDatabases and dbStats may be
+    // served from a cache before they are recomputed from the storage engine. 0 disables caching.
+    AtomicInt32 storageStatsCacheMillis{0};
+
     // --directoryperdb
     // Stores each database’s files in its own folder in the data directory.
     // When applied to an existing system, the directoryPerDB option alters
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_checkpoint_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+const char kReasonInterval[] = "interval";
+const char kReasonDirtyCache[] = "dirtyCache";
+const char kReasonJournalSize[] = "journalSize";
+}  // namespace
+
+const char* WiredTigerCheckpointScheduler::checkpointReason(const Sample& sample,
+                                                            const Triggers& triggers) {
+    if (triggers.maxIntervalMillis > 0 &&
+        sample.millisSinceCheckpoint >= triggers.maxIntervalMillis) {
+        return kReasonInterval;
+    }
+
+    if (sample.millisSinceCheckpoint < triggers.minIntervalMillis) {
+        return nullptr;
+    }
+
+    if (triggers.cacheDirtyRatio > 0 && sample.cacheDirtyRatio >= triggers.cacheDirtyRatio) {
+        return kReasonDirtyCache;
+    }
+
+    if (triggers.journalBytes > 0 &&
+        sample.journalBytesSinceCheckpoint >= triggers.journalBytes) {
+        return kReasonJournalSize;
+    }
+
+    return nullptr;
+}
+
+void WiredTigerCheckpointScheduler::onCheckpointStart(const char* reason) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(!_inProgress);
+    _inProgress = true;
+    _lastReason = reason;
+
+    if (std::strcmp(reason, kReasonInterval) == 0) {
+        ++_checkpointsForInterval;
+    } else if (std::strcmp(reason, kReasonDirtyCache) == 0) {
+        ++_checkpointsForDirtyCache;
+    } else if (std::strcmp(reason, kReasonJournalSize) == 0) {
+        ++_checkpointsForJournalSize;
+    }
+}
+
+void WiredTigerCheckpointScheduler::onCheckpointEnd(int64_t durationMillis) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(_inProgress);
+    _inProgress = false;
+    ++_checkpoints;
+    _lastDurationMillis = durationMillis;
+    _maxDurationMillis = std::max(_maxDurationMillis, durationMillis);
+    _totalDurationMillis += durationMillis;
+}
+
+void WiredTigerCheckpointScheduler::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    builder->append("inProgress", _inProgress);
+    builder->append("checkpoints", static_cast<long long>(_checkpoints));
+    {
+        BSONObjBuilder reasons(builder->subobjStart("reasons"));
+        reasons.append(kReasonInterval, static_cast<long long>(_checkpointsForInterval));
+        reasons.append(kReasonDirtyCache, static_cast<long long>(_checkpointsForDirtyCache));
+        reasons.append(kReasonJournalSize, static_cast<long long>(_checkpointsForJournalSize));
+        reasons.done();
+    }
+    builder->append("lastReason", _lastReason);
+    builder->append("lastDurationMillis", static_cast<long long>(_lastDurationMillis));
+    builder->append("maxDurationMillis", static_cast<long long>(_maxDurationMillis));
+    builder->append("totalDurationMillis", static_cast<long long>(_totalDurationMillis));
+}
+
+}  // namespace mongo
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Decides when to take a WiredTiger checkpoint, instead of leaving it to WiredTiger's fixed
+ * timer.
+ *
+ * A checkpoint is due once the maximum interval has passed, or earlier once dirty data in the
+ * cache or the journal written since the previous checkpoint passes its trigger. Checkpointing
+ * early while there is less dirty data to write spreads checkpoint I/O out over more, smaller
+ * checkpoints. Early checkpoints are never taken less than the minimum interval apart.
+ *
+ * This class only makes decisions and keeps statistics; taking checkpoints is up to the caller.
+ */
+class WiredTigerCheckpointScheduler {
+    MONGO_DISALLOW_COPYING(WiredTigerCheckpointScheduler);
+
+public:
+    struct Sample {
+        int64_t millisSinceCheckpoint = 0;        // time since the previous checkpoint started
+        double cacheDirtyRatio = 0;               // dirty bytes in cache / maximum cache bytes
+        int64_t journalBytesSinceCheckpoint = 0;  // log bytes written since then
+    };
+
+    struct Triggers {
+        int64_t maxIntervalMillis = 0;  // zero disables the periodic checkpoint
+        int64_t minIntervalMillis = 0;
+        double cacheDirtyRatio = 0;     // zero disables the dirty cache trigger
+        int64_t journalBytes = 0;       // zero disables the journal size trigger
+    };
+
+    WiredTigerCheckpointScheduler() = default;
+
+    /**
+     * Returns the reason a checkpoint is due given 'sample', or nullptr if none is.
+     */
+    static const char* checkpointReason(const Sample& sample, const Triggers& triggers);
+
+    void onCheckpointStart(const char* reason);
+    void onCheckpointEnd(int64_t durationMillis);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    mutable stdx::mutex _mutex;
+
+    bool _inProgress = false;
+    int64_t _checkpoints = 0;
+    int64_t _checkpointsForInterval = 0;
+    int64_t _checkpointsForDirtyCache = 0;
+    int64_t _checkpointsForJournalSize = 0;
+    std::string _lastReason = "none";
+    int64_t _lastDurationMillis = 0;
+    int64_t _maxDurationMillis = 0;
+    int64_t _totalDurationMillis = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_checkpoint_scheduler.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Sample = WiredTigerCheckpointScheduler::Sample;
+using Triggers = WiredTigerCheckpointScheduler::Triggers;
+
+Triggers defaultTriggers() {
+    Triggers triggers;
+    triggers.maxIntervalMillis = 60 * 1000;
+    triggers.minIntervalMillis = 5 * 1000;
+    triggers.cacheDirtyRatio = 0.05;
+    triggers.journalBytes = 1024 * 1024;
+    return triggers;
+}
+
+Sample sample(int64_t millis, double dirty, int64_t journalBytes) {
+    Sample s;
+    s.millisSinceCheckpoint = millis;
+    s.cacheDirtyRatio = dirty;
+    s.journalBytesSinceCheckpoint = journalBytes;
+    return s;
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, NothingDueWhenIdle) {
+    ASSERT(!WiredTigerCheckpointScheduler::checkpointReason(sample(10 * 1000, 0.01, 1024),
+                                                            defaultTriggers()));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, IntervalElapsed) {
+    ASSERT_EQ(std::string("interval"),
+              WiredTigerCheckpointScheduler::checkpointReason(sample(60 * 1000, 0, 0),
+                                                              defaultTriggers()));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, DirtyCacheTrigger) {
+    ASSERT_EQ(std::string("dirtyCache"),
+              WiredTigerCheckpointScheduler::checkpointReason(sample(10 * 1000, 0.06, 0),
+                                                              defaultTriggers()));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, JournalSizeTrigger) {
+    ASSERT_EQ(std::string("journalSize"),
+              WiredTigerCheckpointScheduler::checkpointReason(sample(10 * 1000, 0, 2 << 20),
+                                                              defaultTriggers()));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, EarlyTriggersRespectMinInterval) {
+    ASSERT(!WiredTigerCheckpointScheduler::checkpointReason(sample(1000, 0.5, 4 << 20),
+                                                            defaultTriggers()));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, ZeroDisablesTriggers) {
+    Triggers triggers;
+    ASSERT(!WiredTigerCheckpointScheduler::checkpointReason(sample(3600 * 1000, 1.0, 1 << 30),
+                                                            triggers));
+}
+
+TEST(WiredTigerCheckpointSchedulerTest, Stats) {
+    WiredTigerCheckpointScheduler scheduler;
+    scheduler.onCheckpointStart("dirtyCache");
+    scheduler.onCheckpointEnd(300);
+    scheduler.onCheckpointStart("interval");
+    scheduler.onCheckpointEnd(100);
+
+    BSONObjBuilder b;
+    scheduler.appendStats(&b);
+    BSONObj stats = b.obj();
+    ASSERT_FALSE(stats["inProgress"].Bool());
+    ASSERT_EQ(2, stats["checkpoints"].numberLong());
+    ASSERT_EQ(1, stats["reasons"]["interval"].numberLong());
+    ASSERT_EQ(1, stats["reasons"]["dirtyCache"].numberLong());
+    ASSERT_EQ(0, stats["reasons"]["journalSize"].numberLong());
+    ASSERT_EQ("interval", stats["lastReason"].String());
+    ASSERT_EQ(100, stats["lastDurationMillis"].numberLong());
+    ASSERT_EQ(300, stats["maxDurationMillis"].numberLong());
+    ASSERT_EQ(400, stats["totalDurationMillis"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/kv/kv_storage_engine.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const long long kDefaultSampleSize = 1000;
+
+/**
+ * Builds a compression dictionary from a sample of the documents of a collection, for the block
+ * compressor of collections with documents like them.
+ *
+ * { createCompressionDictionary: <collection>, name: <dictionary name>, [sampleSize: <n>] }
+ */
+class CreateCompressionDictionaryCmd : public Command {
+public:
+    CreateCompressionDictionaryCmd() : Command("createCompressionDictionary") {}
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    void help(std::stringstream& help) const override {
+        help << "builds a compression dictionary from a sample of the documents of a collection\n"
+                "{ createCompressionDictionary: <collection>, name: <dictionary name>,\n"
+                "  [sampleSize: <number of documents, default 1000>] }\n"
+                "collections created with storageEngine: {wiredTiger: {configString:\n"
+                "'block_compressor=<compressor>'}}, where <compressor> is the compressor\n"
+                "returned, compress their data with the dictionary. dictionaries are not\n"
+                "replicated, so run this on every member before creating such collections.";
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) override {
+        ActionSet actions;
+        actions.addAction(ActionType::compact);
+        out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss = parseNsCollectionRequired(db, cmdObj);
+
+        std::string name;
+        Status status = bsonExtractStringField(cmdObj, "name", &name);
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
+
+        long long sampleSize;
+        status = bsonExtractIntegerFieldWithDefault(
+            cmdObj, "sampleSize", kDefaultSampleSize, &sampleSize);
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
+        if (sampleSize <= 0) {
+            return appendCommandStatus(
+                result, {ErrorCodes::BadValue, "sampleSize must be a positive number"});
+        }
+
+        if (storageGlobalParams.readOnly) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::IllegalOperation,
+                 "cannot create a compression dictionary in read-only mode"});
+        }
+
+        auto storageEngine = opCtx->getServiceContext()->getGlobalStorageEngine();
+        auto kvStorageEngine = dynamic_cast<KVStorageEngine*>(storageEngine);
+        auto engine =
+            kvStorageEngine ? dynamic_cast<WiredTigerKVEngine*>(kvStorageEngine->getEngine())
+                            : nullptr;
+        if (!engine) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::CommandNotSupported,
+                 "compression dictionaries are only supported by the WiredTiger storage engine"});
+        }
+
+        std::string dictionary;
+        long long numSampled = 0;
+        {
+            AutoGetCollectionForRead autoColl(opCtx, nss);
+            Collection* const collection = autoColl.getCollection();
+            if (!collection) {
+                return appendCommandStatus(
+                    result,
+                    {ErrorCodes::NamespaceNotFound,
+                     str::stream() << "collection " << nss.ns() << " does not exist"});
+            }
+
+            // zlib finds what it compresses in the dictionary as if the dictionary preceded the
+            // data, so the sampled documents are appended as they are until it is full.
+            auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+            if (!cursor) {
+                cursor = collection->getRecordStore()->getCursor(opCtx);
+            }
+
+            while (numSampled < sampleSize &&
+                   dictionary.size() < WiredTigerDictionaryCompressors::kMaxDictionarySize) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+
+                const size_t room =
+                    WiredTigerDictionaryCompressors::kMaxDictionarySize - dictionary.size();
+                dictionary.append(record->data.data(),
+                                  std::min(room, static_cast<size_t>(record->data.size())));
+                ++numSampled;
+            }
+        }
+
+        if (dictionary.empty()) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::BadValue,
+                 str::stream() << "collection " << nss.ns()
+                               << " has no documents to build a dictionary from"});
+        }
+
+        status = WiredTigerDictionaryCompressors::addDictionary(
+            engine->getConnection(), storageGlobalParams.dbpath, name, dictionary);
+        if (!status.isOK()) {
+            return appendCommandStatus(result, status);
+        }
+
+        log() << "Created compression dictionary " << name << " of " << dictionary.size()
+              << " bytes from " << numSampled << " documents of " << nss;
+
+        result.append("compressor", WiredTigerDictionaryCompressors::compressorName(name));
+        result.appendNumber("dictionarySize", static_cast<long long>(dictionary.size()));
+        result.appendNumber("sampledDocuments", numSampled);
+        return true;
+    }
+} createCompressionDictionaryCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,357 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <zlib.h>
+
+#include "mongo/base/init.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/compiler.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const char kDictionaryDirectory[] = "compressionDictionaries";
+const char kDictionaryFileExtension[] = ".dict";
+const size_t kMaxDictionaryNameLength = 64;
+
+struct DictionaryCompressor {
+    // Must come first, as WiredTiger passes its address to the callbacks.
+    WT_COMPRESSOR compressor;
+
+    std::string name;
+    std::string dictionary;
+};
+
+const DictionaryCompressor& getDictionaryCompressor(WT_COMPRESSOR* compressor) {
+    return *reinterpret_cast<DictionaryCompressor*>(compressor);
+}
+
+int zlibError(const DictionaryCompressor& compressor, const char* call, int ret) {
+    error() << "zlib error in " << call << " for compression dictionary " << compressor.name
+            << ": " << zError(ret);
+    return WT_ERROR;
+}
+
+int dictionaryCompress(WT_COMPRESSOR* compressor,
+                       WT_SESSION* session,
+                       uint8_t* src,
+                       size_t srcLen,
+                       uint8_t* dst,
+                       size_t dstLen,
+                       size_t* resultLen,
+                       int* compressionFailed) {
+    const auto& dictCompressor = getDictionaryCompressor(compressor);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+
+    int ret = deflateInit(&zs, Z_DEFAULT_COMPRESSION);
+    if (ret != Z_OK) {
+        return zlibError(dictCompressor, "deflateInit", ret);
+    }
+
+    ret = deflateSetDictionary(&zs,
+                               reinterpret_cast<const Bytef*>(dictCompressor.dictionary.data()),
+                               dictCompressor.dictionary.size());
+    if (ret != Z_OK) {
+        deflateEnd(&zs);
+        return zlibError(dictCompressor, "deflateSetDictionary", ret);
+    }
+
+    zs.next_in = src;
+    zs.avail_in = srcLen;
+    zs.next_out = dst;
+    zs.avail_out = dstLen;
+    if (deflate(&zs, Z_FINISH) == Z_STREAM_END) {
+        *compressionFailed = 0;
+        *resultLen = zs.total_out;
+    } else {
+        *compressionFailed = 1;
+    }
+
+    // Z_DATA_ERROR only means that the output did not fit, which was reported above.
+    ret = deflateEnd(&zs);
+    if (ret != Z_OK && ret != Z_DATA_ERROR) {
+        return zlibError(dictCompressor, "deflateEnd", ret);
+    }
+
+    return 0;
+}
+
+int dictionaryDecompress(WT_COMPRESSOR* compressor,
+                         WT_SESSION* session,
+                         uint8_t* src,
+                         size_t srcLen,
+                         uint8_t* dst,
+                         size_t dstLen,
+                         size_t* resultLen) {
+    const auto& dictCompressor = getDictionaryCompressor(compressor);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+
+    int ret = inflateInit(&zs);
+    if (ret != Z_OK) {
+        return zlibError(dictCompressor, "inflateInit", ret);
+    }
+
+    zs.next_in = src;
+    zs.avail_in = srcLen;
+    zs.next_out = dst;
+    zs.avail_out = dstLen;
+
+    // inflate asks for the dictionary once it has read the stream header.
+    while ((ret = inflate(&zs, Z_FINISH)) == Z_OK || ret == Z_NEED_DICT) {
+        if (ret == Z_NEED_DICT &&
+            (ret = inflateSetDictionary(
+                 &zs,
+                 reinterpret_cast<const Bytef*>(dictCompressor.dictionary.data()),
+                 dictCompressor.dictionary.size())) != Z_OK) {
+            break;
+        }
+    }
+
+    if (ret == Z_STREAM_END) {
+        *resultLen = zs.total_out;
+        ret = Z_OK;
+    }
+
+    const int endRet = inflateEnd(&zs);
+    if (ret == Z_OK) {
+        ret = endRet;
+    }
+
+    return ret == Z_OK ? 0 : zlibError(dictCompressor, "inflate", ret);
+}
+
+/**
+ * The compressors of all dictionaries which have been loaded or added. They are never freed, since
+ * a connection which registered them may use them until it is closed.
+ */
+stdx::mutex registryMutex;
+std::map<std::string, std::unique_ptr<DictionaryCompressor>> registry;
+
+Status validateDictionaryName(StringData name) {
+    if (name.empty() || name.size() > kMaxDictionaryNameLength) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "compression dictionary names must have between 1 and "
+                              << kMaxDictionaryNameLength
+                              << " characters"};
+    }
+
+    for (char c : name) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "invalid compression dictionary name '" << name
+                                  << "': only letters, digits and '_' are allowed"};
+        }
+    }
+
+    return Status::OK();
+}
+
+DictionaryCompressor* addToRegistry_inlock(const std::string& name, const std::string& dictionary) {
+    auto compressor = stdx::make_unique<DictionaryCompressor>();
+    memset(&compressor->compressor, 0, sizeof(compressor->compressor));
+    compressor->compressor.compress = dictionaryCompress;
+    compressor->compressor.decompress = dictionaryDecompress;
+    compressor->name = name;
+    compressor->dictionary = dictionary;
+
+    auto* const compressorPtr = compressor.get();
+    registry[name] = std::move(compressor);
+    return compressorPtr;
+}
+
+Status registerCompressor(WT_CONNECTION* conn, DictionaryCompressor* compressor) {
+    const std::string compressorName =
+        WiredTigerDictionaryCompressors::compressorName(compressor->name);
+    return wtRCToStatus(
+        conn->add_compressor(conn, compressorName.c_str(), &compressor->compressor, nullptr));
+}
+
+boost::filesystem::path dictionaryDirectory(const std::string& dbpath) {
+    return boost::filesystem::path(dbpath) / kDictionaryDirectory;
+}
+
+}  // namespace
+
+/**
+ * Registers the compressors of the loaded dictionaries with a connection which is being opened.
+ * Loaded by WiredTiger as a local extension, so that it runs before recovery.
+ */
+extern "C" MONGO_COMPILER_API_EXPORT int mongo_dictionary_compressors_extension(
+    WT_CONNECTION* conn, WT_CONFIG_ARG* cfg) {
+    stdx::lock_guard<stdx::mutex> lk(registryMutex);
+    for (const auto& entry : registry) {
+        Status status = registerCompressor(conn, entry.second.get());
+        if (!status.isOK()) {
+            error() << "Failed to register the compressor of compression dictionary "
+                    << entry.first << ": " << status;
+            return WT_ERROR;
+        }
+    }
+    return 0;
+}
+
+MONGO_INITIALIZER_WITH_PREREQUISITES(WiredTigerDictionaryCompressors, ("SetWiredTigerExtensions"))
+(InitializerContext* context) {
+    WiredTigerExtensions::get(getGlobalServiceContext())
+        ->addExtension("local=(entry=mongo_dictionary_compressors_extension)");
+    return Status::OK();
+}
+
+std::string WiredTigerDictionaryCompressors::compressorName(StringData name) {
+    return str::stream() << "mongo_dict_" << name;
+}
+
+Status WiredTigerDictionaryCompressors::loadDictionaries(const std::string& dbpath) {
+    const auto directory = dictionaryDirectory(dbpath);
+
+    try {
+        if (!boost::filesystem::exists(directory)) {
+            return Status::OK();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(registryMutex);
+        for (boost::filesystem::directory_iterator it(directory), end; it != end; ++it) {
+            const auto& path = it->path();
+            if (path.extension().string() != kDictionaryFileExtension) {
+                continue;
+            }
+
+            const std::string name = path.stem().string();
+            Status status = validateDictionaryName(name);
+            if (!status.isOK()) {
+                warning() << "Ignoring compression dictionary file " << path.string() << ": "
+                          << status;
+                continue;
+            }
+
+            std::ifstream ifs(path.string().c_str(), std::ios_base::in | std::ios_base::binary);
+            std::string dictionary((std::istreambuf_iterator<char>(ifs)),
+                                   std::istreambuf_iterator<char>());
+            if (!ifs) {
+                return {ErrorCodes::FileStreamFailed,
+                        str::stream() << "Failed to read compression dictionary "
+                                      << path.string()};
+            }
+
+            auto registered = registry.find(name);
+            if (registered == registry.end()) {
+                addToRegistry_inlock(name, dictionary);
+            } else if (registered->second->dictionary != dictionary) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Compression dictionary " << path.string()
+                                      << " differs from the dictionary "
+                                      << name
+                                      << " which is already in use"};
+            }
+        }
+    } catch (const boost::filesystem::filesystem_error& ex) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to read the compression dictionaries in "
+                              << directory.string()
+                              << ": "
+                              << ex.what()};
+    }
+
+    return Status::OK();
+}
+
+Status WiredTigerDictionaryCompressors::addDictionary(WT_CONNECTION* conn,
+                                                      const std::string& dbpath,
+                                                      const std::string& name,
+                                                      const std::string& dictionary) {
+    Status status = validateDictionaryName(name);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (dictionary.empty() || dictionary.size() > kMaxDictionarySize) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "compression dictionaries must have between 1 and "
+                              << kMaxDictionarySize
+                              << " bytes"};
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(registryMutex);
+
+    if (registry.count(name)) {
+        return {ErrorCodes::NamespaceExists,
+                str::stream() << "compression dictionary " << name << " already exists"};
+    }
+
+    const auto directory = dictionaryDirectory(dbpath);
+    const auto path = directory / (name + kDictionaryFileExtension);
+    const auto tempPath = directory / (name + kDictionaryFileExtension + ".tmp");
+    try {
+        boost::filesystem::create_directories(directory);
+
+        {
+            std::ofstream ofs(tempPath.string().c_str(),
+                              std::ios_base::out | std::ios_base::binary);
+            ofs.write(dictionary.data(), dictionary.size());
+            if (!ofs) {
+                return {ErrorCodes::FileStreamFailed,
+                        str::stream() << "Failed to write compression dictionary "
+                                      << tempPath.string()
+                                      << ": "
+                                      << errnoWithDescription()};
+            }
+        }
+
+        boost::filesystem::rename(tempPath, path);
+    } catch (const boost::filesystem::filesystem_error& ex) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to write compression dictionary " << path.string()
+                              << ": "
+                              << ex.what()};
+    }
+
+    return registerCompressor(conn, addToRegistry_inlock(name, dictionary));
+}
+
+}  // namespace mongo
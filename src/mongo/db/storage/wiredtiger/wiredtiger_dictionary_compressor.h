@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <wiredtiger.h>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * Block compressors which prime zlib with a preset dictionary, so that the small documents of a
+ * page compress well even though each page is compressed on its own. Each dictionary is registered
+ * with WiredTiger as its own compressor, named by compressorName(), which a collection uses when it
+ * is created with that name as its block_compressor.
+ *
+ * The dictionaries are kept in files under <dbpath>/compressionDictionaries rather than in the
+ * catalog, because their compressors have to be registered while wiredtiger_open runs recovery,
+ * before any catalog can be read. They are not replicated.
+ */
+class WiredTigerDictionaryCompressors {
+public:
+    // zlib only uses the last 32KB of a preset dictionary.
+    static const size_t kMaxDictionarySize = 32 * 1024;
+
+    /**
+     * Returns the name of the block compressor which uses the dictionary 'name'.
+     */
+    static std::string compressorName(StringData name);
+
+    /**
+     * Reads the dictionaries which were added to the database at 'dbpath'. Must be called before
+     * the database is opened, so that the compressors are registered with the connection.
+     */
+    static Status loadDictionaries(const std::string& dbpath);
+
+    /**
+     * Saves 'dictionary' as the dictionary 'name' of the database at 'dbpath' and registers its
+     * compressor with 'conn'. A dictionary cannot be replaced, since the collections which were
+     * created with its compressor need it to read their data.
+     */
+    static Status addDictionary(WT_CONNECTION* conn,
+                                const std::string& dbpath,
+                                const std::string& name,
+                                const std::string& dictionary);
+};
+
+}  // namespace mongo
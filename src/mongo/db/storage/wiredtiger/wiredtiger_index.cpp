@@ -258,6 +258,7 @@ Status WiredTigerIndex::insert(OperationContext* opCtx,
     WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
+    ++curwrap.storageStats().cursorWrites;
 
     return _insert(c, key, id, dupsAllowed);
 }
@@ -273,6 +274,7 @@ void WiredTigerIndex::unindex(OperationContext* opCtx,
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
     invariant(c);
+    ++curwrap.storageStats().cursorWrites;
 
     _unindex(c, key, id, dupsAllowed);
 }
@@ -471,6 +473,11 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
     return Status::OK();
 }
 
+StatusWith<bool> WiredTigerIndex::compactIncrementally(OperationContext* opCtx,
+                                                       Seconds timeLimit) {
+    return WiredTigerUtil::compactIncrementally(opCtx, uri(), timeLimit);
+}
+
 /**
  * Base class for WiredTigerIndex bulk builders.
  *
@@ -726,6 +733,16 @@ public:
     }
 
     void save() override {
+        // The WT_CURSOR keeps its position for as long as the transaction it was saved in stays
+        // open, and WiredTiger resets it when that transaction ends, so it is left as is. If the
+        // snapshot changes before restore(), we re-seek to our saved position, which is wherever
+        // we were when we last called updatePosition(). Any partially completed repositions
+        // should not effect our saved position.
+        auto ru = WiredTigerRecoveryUnit::get(_opCtx);
+        _savedSnapshotId = (_cursor && ru->inActiveTxn()) ? ru->getSnapshotId() : SnapshotId();
+    }
+
+    void saveUnpositioned() override {
         try {
             if (_cursor)
                 _cursor->reset();
@@ -733,13 +750,7 @@ public:
             // Ignore since this is only called when we are about to kill our transaction
             // anyway.
         }
-
-        // Our saved position is wherever we were when we last called updatePosition().
-        // Any partially completed repositions should not effect our saved position.
-    }
-
-    void saveUnpositioned() override {
-        save();
+        _savedSnapshotId = SnapshotId();
         _eof = true;
     }
 
@@ -749,9 +760,16 @@ public:
         }
 
         // Ensure an active session exists, so any restored cursors will bind to it
-        invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession(_opCtx) == _cursor->getSession());
+        auto ru = WiredTigerRecoveryUnit::get(_opCtx);
+        invariant(ru->getSession(_opCtx) == _cursor->getSession());
 
-        if (!_eof) {
+        // Still in the transaction we were saved in, so the WT_CURSOR is where we left it and
+        // _lastMoveWasRestore is still accurate.
+        const bool sameSnapshot =
+            !_savedSnapshotId.isNull() && _savedSnapshotId == ru->getSnapshotId();
+        _savedSnapshotId = SnapshotId();
+
+        if (!_eof && !sameSnapshot) {
             // Unique indices *don't* include the record id in their KeyStrings. If we seek to the
             // same key with a new record id, seeking will successfully find the key and will return
             // true. This will cause us to skip the key with the new record id, since we set
@@ -768,6 +786,7 @@ public:
     void detachFromOperationContext() final {
         _opCtx = nullptr;
         _cursor = boost::none;
+        _savedSnapshotId = SnapshotId();
     }
 
     void reattachToOperationContext(OperationContext* opCtx) final {
@@ -819,6 +838,7 @@ protected:
     }
 
     void advanceWTCursor() {
+        ++_cursor->storageStats().cursorNexts;
         WT_CURSOR* c = _cursor->get();
         int ret = WT_OP_CHECK(_forward ? c->next(c) : c->prev(c));
         if (ret == WT_NOTFOUND) {
@@ -831,6 +851,7 @@ protected:
 
     // Seeks to query. Returns true on exact match.
     bool seekWTCursor(const KeyString& query) {
+        ++_cursor->storageStats().cursorSeeks;
         WT_CURSOR* c = _cursor->get();
 
         int cmp = -1;
@@ -879,6 +900,7 @@ protected:
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
         invariantWTOK(c->get_key(c, &item));
+        _cursor->storageStats().bytesRead += item.size;
 
         const auto isForwardNextCall = _forward && inNext && !_key.isEmpty();
         if (isForwardNextCall) {
@@ -936,6 +958,9 @@ protected:
     // false by any operation that moves the cursor, other than subsequent save/restore pairs.
     bool _lastMoveWasRestore = false;
 
+    // The snapshot that was open when save() was called, if the WT_CURSOR was left positioned.
+    SnapshotId _savedSnapshotId;
+
     KeyString _query;
 
     std::unique_ptr<KeyString> _endPosition;
@@ -987,6 +1012,7 @@ public:
 
         WT_CURSOR* c = _cursor->get();
         c->set_key(c, keyItem.Get());
+        ++_cursor->storageStats().cursorSeeks;
 
         // Using search rather than search_near.
         int ret = WT_OP_CHECK(c->search(c));
@@ -104,6 +104,8 @@ public:
 
     virtual Status compact(OperationContext* opCtx);
 
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds timeLimit);
+
     const std::string& uri() const {
         return _uri;
     }
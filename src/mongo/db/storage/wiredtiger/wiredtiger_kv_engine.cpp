@@ -58,7 +58,9 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_checkpoint_scheduler.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
@@ -66,6 +68,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/background.h"
@@ -178,8 +181,253 @@ TicketServerParameter openReadTransactionParam(&openReadTransaction,
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
+
+stdx::function<bool(StringData)> requestCappedDeleteCallback = [](StringData) { return false; };
+
+// When enabled, the number of read and write tickets is adjusted periodically by a
+// WiredTigerTicketController instead of staying at the configured values.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerConcurrentTransactionsAdaptive, bool, false);
+
+const int kAdaptiveMinTickets = 5;
+const int kAdaptiveMaxTickets = 512;
+const int kAdaptiveIntervalMillis = 1000;
+
+WiredTigerTicketController openWriteTransactionController(kAdaptiveMinTickets,
+                                                          kAdaptiveMaxTickets);
+WiredTigerTicketController openReadTransactionController(kAdaptiveMinTickets,
+                                                         kAdaptiveMaxTickets);
+
+// When set, checkpoints are taken by a WiredTigerCheckpointThread as decided by the
+// WiredTigerCheckpointScheduler, instead of by WiredTiger every 'syncdelay' seconds. The triggers
+// below may be changed at runtime.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerAdaptiveCheckpoints, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCheckpointMinIntervalSecs, int, 5);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCheckpointDirtyTriggerPercent, double, 5.0);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCheckpointJournalTriggerMB, int, 2048);
+
+const int kCheckpointSampleIntervalMillis = 1000;
+
+WiredTigerCheckpointScheduler checkpointScheduler;
+
+void appendAdaptiveStats(const WiredTigerTicketController& controller, BSONObjBuilder* b) {
+    BSONObjBuilder adaptive(b->subobjStart("adaptive"));
+    adaptive.append("enabled", wiredTigerConcurrentTransactionsAdaptive.load());
+    controller.appendStats(&adaptive);
+    adaptive.done();
+}
 }  // namespace
 
+/**
+ * Periodically samples the read and write TicketHolders and the WiredTiger cache, and resizes
+ * the TicketHolders as decided by a WiredTigerTicketController for each of them. Does nothing
+ * unless wiredTigerConcurrentTransactionsAdaptive is set.
+ */
+class WiredTigerKVEngine::WiredTigerTicketAdjuster : public BackgroundJob {
+public:
+    explicit WiredTigerTicketAdjuster(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTTicketAdjuster";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        WiredTigerSession session(_conn);
+        bool wasEnabled = false;
+        Date_t lastSample;
+        while (!_shuttingDown.load()) {
+            // Sleep in short steps so that shutdown is not held up by a full interval.
+            sleepmillis(100);
+
+            const bool enabled = wiredTigerConcurrentTransactionsAdaptive.load();
+            if (!enabled) {
+                wasEnabled = false;
+                continue;
+            }
+
+            const Date_t now = Date_t::now();
+            if (wasEnabled && now - lastSample < Milliseconds(kAdaptiveIntervalMillis)) {
+                continue;
+            }
+
+            WiredTigerTicketController::Sample sample;
+            if (!_sampleCache(session.getSession(), &sample)) {
+                continue;
+            }
+
+            // The first sample after (re)enabling only establishes a baseline, so that
+            // throughput is never computed across an interval in which the controller was off.
+            sample.elapsedMicros = wasEnabled ? durationCount<Microseconds>(now - lastSample) : 0;
+            lastSample = now;
+            if (!wasEnabled) {
+                openReadTransactionController.reset();
+                openWriteTransactionController.reset();
+                wasEnabled = true;
+            }
+
+            _adjust(&openReadTransactionController, &openReadTransaction, sample, "read");
+            _adjust(&openWriteTransactionController, &openWriteTransaction, sample, "write");
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    static void _adjust(WiredTigerTicketController* controller,
+                        TicketHolder* holder,
+                        WiredTigerTicketController::Sample sample,
+                        const char* which) {
+        sample.totalAcquired = holder->totalAcquired();
+        sample.totalQueuedMicros = holder->totalQueuedMicros();
+        sample.queued = holder->queued();
+
+        const int current = holder->outof();
+        const int target = controller->update(sample, current);
+        if (target == current) {
+            return;
+        }
+
+        Status status = holder->resize(target);
+        if (!status.isOK()) {
+            warning() << "failed to resize " << which << " tickets to " << target << ": "
+                      << status;
+            return;
+        }
+        LOG(1) << "adjusted concurrent " << which << " transactions from " << current << " to "
+               << target;
+    }
+
+    /**
+     * Fills in the cache fields of 'sample'. Returns false if the statistics are unavailable.
+     */
+    static bool _sampleCache(WT_SESSION* session, WiredTigerTicketController::Sample* sample) {
+        auto stat = [session](int key) {
+            return WiredTigerUtil::getStatisticsValueAs<int64_t>(
+                session, "statistics:", "statistics=(fast)", key);
+        };
+
+        auto inUse = stat(WT_STAT_CONN_CACHE_BYTES_INUSE);
+        auto max = stat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        auto dirty = stat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        auto appEvictions = stat(WT_STAT_CONN_CACHE_EVICTION_APP);
+        if (!inUse.isOK() || !max.isOK() || !dirty.isOK() || !appEvictions.isOK() ||
+            max.getValue() <= 0) {
+            return false;
+        }
+
+        sample->cacheFillRatio = static_cast<double>(inUse.getValue()) / max.getValue();
+        sample->cacheDirtyRatio = static_cast<double>(dirty.getValue()) / max.getValue();
+        sample->appEvictions = appEvictions.getValue();
+        return true;
+    }
+
+    WT_CONNECTION* const _conn;
+    AtomicBool _shuttingDown{false};
+};
+
+/**
+ * Periodically samples the WiredTiger cache and journal, and takes a checkpoint whenever the
+ * WiredTigerCheckpointScheduler says one is due. Only runs if wiredTigerAdaptiveCheckpoints is set.
+ */
+class WiredTigerKVEngine::WiredTigerCheckpointThread : public BackgroundJob {
+public:
+    explicit WiredTigerCheckpointThread(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTCheckpointThread";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        WiredTigerSession session(_conn);
+        WT_SESSION* s = session.getSession();
+        Date_t lastCheckpoint = Date_t::now();
+        Date_t lastSample = lastCheckpoint;
+        int64_t journalBytesAtCheckpoint = _stat(s, WT_STAT_CONN_LOG_BYTES_WRITTEN);
+        while (!_shuttingDown.load()) {
+            // Sleep in short steps so that shutdown is not held up by a full interval.
+            sleepmillis(100);
+
+            const Date_t now = Date_t::now();
+            if (now - lastSample < Milliseconds(kCheckpointSampleIntervalMillis)) {
+                continue;
+            }
+            lastSample = now;
+
+            const int64_t journalBytes = _stat(s, WT_STAT_CONN_LOG_BYTES_WRITTEN);
+            const int64_t cacheMax = _stat(s, WT_STAT_CONN_CACHE_BYTES_MAX);
+
+            WiredTigerCheckpointScheduler::Sample sample;
+            sample.millisSinceCheckpoint = durationCount<Milliseconds>(now - lastCheckpoint);
+            sample.journalBytesSinceCheckpoint = journalBytes - journalBytesAtCheckpoint;
+            if (cacheMax > 0) {
+                sample.cacheDirtyRatio =
+                    static_cast<double>(_stat(s, WT_STAT_CONN_CACHE_BYTES_DIRTY)) / cacheMax;
+            }
+
+            const char* reason =
+                WiredTigerCheckpointScheduler::checkpointReason(sample, _triggers());
+            if (!reason) {
+                continue;
+            }
+
+            LOG(1) << "taking a checkpoint, reason: " << reason;
+            checkpointScheduler.onCheckpointStart(reason);
+            int ret = s->checkpoint(s, NULL);
+            checkpointScheduler.onCheckpointEnd(durationCount<Milliseconds>(Date_t::now() - now));
+            if (ret != 0) {
+                warning() << "failed to take a checkpoint: " << wtRCToStatus(ret);
+            }
+
+            lastCheckpoint = now;
+            journalBytesAtCheckpoint = journalBytes;
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    static WiredTigerCheckpointScheduler::Triggers _triggers() {
+        WiredTigerCheckpointScheduler::Triggers triggers;
+        triggers.maxIntervalMillis =
+            static_cast<int64_t>(storageGlobalParams.syncdelay.load() * 1000);
+        triggers.minIntervalMillis =
+            static_cast<int64_t>(wiredTigerCheckpointMinIntervalSecs.load()) * 1000;
+        triggers.cacheDirtyRatio = wiredTigerCheckpointDirtyTriggerPercent.load() / 100;
+        triggers.journalBytes =
+            static_cast<int64_t>(wiredTigerCheckpointJournalTriggerMB.load()) * 1024 * 1024;
+        return triggers;
+    }
+
+    /**
+     * Returns the connection statistic 'key', or 0 if it is unavailable.
+     */
+    static int64_t _stat(WT_SESSION* session, int key) {
+        auto value = WiredTigerUtil::getStatisticsValueAs<int64_t>(
+            session, "statistics:", "statistics=(fast)", key);
+        return value.isOK() ? value.getValue() : 0;
+    }
+
+    WT_CONNECTION* const _conn;
+    AtomicBool _shuttingDown{false};
+};
+
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
                                        const std::string& path,
                                        ClockSource* cs,
@@ -211,6 +459,9 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _previousCheckedDropsQueued = Date_t::now();
 
+    // The compressors of the dictionaries are registered while the connection is being opened.
+    fassertNoTrace(40412, WiredTigerDictionaryCompressors::loadDictionaries(path));
+
     std::stringstream ss;
     ss << "create,";
     ss << "cache_size=" << cacheSizeMB << "M,";
@@ -226,8 +477,13 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
         ss << "log=(enabled=true,archive=true,path=journal,compressor=";
         ss << wiredTigerGlobalOptions.journalCompressor << "),";
         ss << "file_manager=(close_idle_time=100000),";  //~28 hours, will put better fix in 3.1.x
-        ss << "checkpoint=(wait=" << wiredTigerGlobalOptions.checkpointDelaySecs;
-        ss << ",log_size=2GB),";
+        if (wiredTigerAdaptiveCheckpoints && !_ephemeral) {
+            // Checkpoints are scheduled by the WiredTigerCheckpointThread.
+            ss << "checkpoint=(wait=0,log_size=0),";
+        } else {
+            ss << "checkpoint=(wait=" << wiredTigerGlobalOptions.checkpointDelaySecs;
+            ss << ",log_size=2GB),";
+        }
         ss << "statistics_log=(wait=" << wiredTigerGlobalOptions.statisticsLogDelaySecs << "),";
         ss << "verbose=(recovery_progress),";
     }
@@ -288,6 +544,16 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer->fillCache();
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+
+    if (!_readOnly && !_ephemeral) {
+        _ticketAdjuster = stdx::make_unique<WiredTigerTicketAdjuster>(_conn);
+        _ticketAdjuster->go();
+
+        if (wiredTigerAdaptiveCheckpoints) {
+            _checkpointThread = stdx::make_unique<WiredTigerCheckpointThread>(_conn);
+            _checkpointThread->go();
+        }
+    }
 }
 
 
@@ -306,6 +572,8 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        bbb.append("queued", openWriteTransaction.queued());
+        appendAdaptiveStats(openWriteTransactionController, &bbb);
         bbb.done();
     }
     {
@@ -313,9 +581,16 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        bbb.append("queued", openReadTransaction.queued());
+        appendAdaptiveStats(openReadTransactionController, &bbb);
         bbb.done();
     }
     bb.done();
+
+    BSONObjBuilder checkpoints(b.subobjStart("checkpointScheduler"));
+    checkpoints.append("enabled", wiredTigerAdaptiveCheckpoints);
+    checkpointScheduler.appendStats(&checkpoints);
+    checkpoints.done();
 }
 
 void WiredTigerKVEngine::cleanShutdown() {
@@ -326,6 +601,10 @@ void WiredTigerKVEngine::cleanShutdown() {
         // these must be the last things we do before _conn->close();
         if (_journalFlusher)
             _journalFlusher->shutdown();
+        if (_ticketAdjuster)
+            _ticketAdjuster->shutdown();
+        if (_checkpointThread)
+            _checkpointThread->shutdown();
         _sizeStorer.reset();
         _sessionCache->shuttingDown();
 
@@ -736,4 +1015,12 @@ void WiredTigerKVEngine::setInitRsOplogBackgroundThreadCallback(
 bool WiredTigerKVEngine::initRsOplogBackgroundThread(StringData ns) {
     return initRsOplogBackgroundThreadCallback(ns);
 }
+
+void WiredTigerKVEngine::setRequestCappedDeleteCallback(stdx::function<bool(StringData)> cb) {
+    requestCappedDeleteCallback = std::move(cb);
+}
+
+bool WiredTigerKVEngine::requestCappedDelete(StringData ns) {
+    return requestCappedDeleteCallback(ns);
+}
 }
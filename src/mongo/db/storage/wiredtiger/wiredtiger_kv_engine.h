@@ -158,10 +158,24 @@ public:
      */
     static bool initRsOplogBackgroundThread(StringData ns);
 
+    /**
+     * Sets the implementation for `requestCappedDelete`. Intended to be called from a
+     * MONGO_INITIALIZER and therefore in a single threaded context.
+     */
+    static void setRequestCappedDeleteCallback(stdx::function<bool(StringData)> cb);
+
+    /**
+     * Asks a background job to remove the documents in excess of the cap of the capped collection
+     * 'ns'. Returns false if there is no such job, in which case the caller has to remove them.
+     */
+    static bool requestCappedDelete(StringData ns);
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
 private:
     class WiredTigerJournalFlusher;
+    class WiredTigerTicketAdjuster;
+    class WiredTigerCheckpointThread;
 
     Status _salvageIfNeeded(const char* uri);
     void _checkIdentPath(StringData ident);
@@ -185,6 +199,8 @@ private:
     bool _ephemeral;
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
+    std::unique_ptr<WiredTigerTicketAdjuster> _ticketAdjuster;
+    std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
 
     std::string _rsOptions;
     std::string _indexOptions;
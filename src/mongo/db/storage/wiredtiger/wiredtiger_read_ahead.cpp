@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include "mongo/base/status.h"
+
+namespace mongo {
+
+namespace {
+
+// Reads beyond this many outstanding ones are dropped rather than queued, so that a burst of
+// scans cannot build up a backlog of reads the scans have already passed.
+const uint32_t kMaxOutstandingReads = 16;
+
+ThreadPool::Options makePoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "WiredTigerReadAhead";
+    options.minThreads = 0;
+    options.maxThreads = 4;
+    return options;
+}
+
+}  // namespace
+
+WiredTigerReadAhead::WiredTigerReadAhead(WT_CONNECTION* conn)
+    : _conn(conn), _pool(makePoolOptions()) {
+    _pool.startup();
+}
+
+WiredTigerReadAhead::~WiredTigerReadAhead() {
+    shutdown();
+}
+
+bool WiredTigerReadAhead::schedule(const std::string& uri,
+                                   int64_t key,
+                                   bool forward,
+                                   int numRecords,
+                                   std::shared_ptr<AtomicBool> inFlight) {
+    if (_shuttingDown.load() || inFlight->load())
+        return false;
+
+    if (_outstanding.fetchAndAdd(1) >= kMaxOutstandingReads) {
+        _outstanding.fetchAndSubtract(1);
+        return false;
+    }
+
+    inFlight->store(true);
+    Status status = _pool.schedule([this, uri, key, forward, numRecords, inFlight] {
+        _read(uri, key, forward, numRecords);
+        inFlight->store(false);
+        _outstanding.fetchAndSubtract(1);
+    });
+
+    if (!status.isOK()) {
+        // The pool has been shut down.
+        inFlight->store(false);
+        _outstanding.fetchAndSubtract(1);
+        return false;
+    }
+    return true;
+}
+
+void WiredTigerReadAhead::shutdown() {
+    if (_shuttingDown.swap(true))
+        return;
+
+    _pool.shutdown();
+    _pool.join();
+}
+
+void WiredTigerReadAhead::_read(const std::string& uri,
+                                int64_t key,
+                                bool forward,
+                                int numRecords) {
+    // Nothing is written, and the point is only to bring pages into cache, so skip taking a
+    // snapshot.
+    WT_SESSION* session;
+    if (_conn->open_session(_conn, NULL, "isolation=read-uncommitted", &session) != 0)
+        return;
+
+    WT_CURSOR* c;
+    if (session->open_cursor(session, uri.c_str(), NULL, NULL, &c) == 0) {
+        c->set_key(c, key);
+        int cmp;
+        int ret = c->search_near(c, &cmp);
+        for (int i = 0; ret == 0 && i < numRecords && !_shuttingDown.load(); ++i) {
+            WT_ITEM value;
+            ret = c->get_value(c, &value);
+            if (ret == 0)
+                ret = forward ? c->next(c) : c->prev(c);
+        }
+    }
+
+    // Closing the session also closes its cursor.
+    session->close(session, NULL);
+}
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <wiredtiger.h>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+/**
+ * Warms the WiredTiger cache ahead of sequential record store scans. A scan reports the key it
+ * has reached, and a background thread reads the records that follow it with a session of its
+ * own, so that their pages are already in cache by the time the scan gets there.
+ *
+ * Reads are best-effort: they are dropped when too many are outstanding, and any error simply
+ * ends the read early.
+ */
+class WiredTigerReadAhead {
+    MONGO_DISALLOW_COPYING(WiredTigerReadAhead);
+
+public:
+    explicit WiredTigerReadAhead(WT_CONNECTION* conn);
+    ~WiredTigerReadAhead();
+
+    /**
+     * Schedules a read of up to 'numRecords' records of the table 'uri', starting at 'key' and
+     * moving forward or backward. 'inFlight' is set while the read is outstanding, and no new read
+     * is scheduled for a caller whose previous read has not yet finished.
+     *
+     * Returns whether a read was scheduled.
+     */
+    bool schedule(const std::string& uri,
+                  int64_t key,
+                  bool forward,
+                  int numRecords,
+                  std::shared_ptr<AtomicBool> inFlight);
+
+    /**
+     * Waits for outstanding reads to finish and rejects new ones. Must be called before the
+     * connection is closed.
+     */
+    void shutdown();
+
+private:
+    void _read(const std::string& uri, int64_t key, bool forward, int numRecords);
+
+    WT_CONNECTION* const _conn;  // not owned
+    ThreadPool _pool;
+    AtomicUInt32 _outstanding;
+    AtomicBool _shuttingDown{false};
+};
+
+}  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
@@ -55,12 +56,14 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 //#define RS_ITERATOR_TRACE(x) log() << "WTRS::Iterator " << x
 #define RS_ITERATOR_TRACE(x)
@@ -75,6 +78,12 @@ namespace {
 static const int kMinimumRecordStoreVersion = 1;
 static const int kCurrentRecordStoreVersion = 1;  // New record stores use this by default.
 static const int kMaximumRecordStoreVersion = 1;
+
+// getManyCursors() splits a table into at most this many ranges, each of which should hold at least
+// kMinRecordsPerScanRange records.
+const int64_t kMaxScanRanges = 16;
+const int64_t kMinRecordsPerScanRange = 10000;
+const int64_t kRandomSamplesPerScanRange = 10;
 MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion >= kMinimumRecordStoreVersion);
 MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
@@ -92,6 +101,12 @@ bool shouldUseOplogHack(OperationContext* opCtx, const std::string& uri) {
 MONGO_FP_DECLARE(WTWriteConflictException);
 MONGO_FP_DECLARE(WTPausePrimaryOplogDurabilityLoop);
 
+MONGO_EXPORT_SERVER_PARAMETER(oplogMinRetentionHours, double, 0.0);
+
+// How many records ahead of a sequential scan to read into cache in the background. Zero disables
+// read-ahead.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerReadAheadRecords, int, 0);
+
 const std::string kWiredTigerEngineName = "wiredTiger";
 
 class WiredTigerRecordStore::OplogStones::InsertChange final : public RecoveryUnit::Change {
@@ -179,8 +194,14 @@ void WiredTigerRecordStore::OplogStones::kill() {
 void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     // Wait until kill() is called or there are too many oplog stones.
     stdx::unique_lock<stdx::mutex> lock(_oplogReclaimMutex);
-    while (!_isDead && !hasExcessStones()) {
-        _oplogReclaimCv.wait(lock);
+    while (!_isDead && !peekOldestStoneIfNeeded()) {
+        if (hasExcessStones()) {
+            // The oldest stone is still within the minimum retention period. Nothing signals when
+            // it ages out of it, so check again periodically.
+            _oplogReclaimCv.wait_for(lock, Seconds(1).toSystemDuration());
+        } else {
+            _oplogReclaimCv.wait(lock);
+        }
     }
 }
 
@@ -192,6 +213,10 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
         return {};
     }
 
+    if (_isWithinRetentionPeriod(_stones.front())) {
+        return {};
+    }
+
     return _stones.front();
 }
 
@@ -425,6 +450,17 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_isWithinRetentionPeriod(const Stone& stone) {
+    const double minRetentionHours = oplogMinRetentionHours.load();
+    if (minRetentionHours <= 0) {
+        return false;
+    }
+
+    // The RecordId of an oplog entry is its optime, whose seconds are wall clock time.
+    const double stoneSecs = Timestamp(stone.lastRecord.repr()).getSecs();
+    return stoneSecs + minRetentionHours * 3600 > double(Date_t::now().toTimeT());
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     if (hasExcessStones()) {
         _oplogReclaimCv.notify_one();
@@ -434,12 +470,17 @@ void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
 class WiredTigerRecordStore::Cursor final : public SeekableRecordCursor {
 public:
     Cursor(OperationContext* opCtx, const WiredTigerRecordStore& rs, bool forward = true)
-        : _rs(rs),
-          _opCtx(opCtx),
-          _forward(forward),
-          _readUntilForOplog(WiredTigerRecoveryUnit::get(opCtx)->getOplogReadTill()) {
-        _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
-    }
+        : Cursor(opCtx, rs, forward, RecordId(), RecordId()) {}
+
+    /**
+     * Creates a forward cursor over the records with ids in ['rangeStart', 'rangeEnd'). A null
+     * bound leaves that side of the range open.
+     */
+    Cursor(OperationContext* opCtx,
+           const WiredTigerRecordStore& rs,
+           const RecordId& rangeStart,
+           const RecordId& rangeEnd)
+        : Cursor(opCtx, rs, /*forward=*/true, rangeStart, rangeEnd) {}
 
     boost::optional<Record> next() final {
         if (_eof)
@@ -448,10 +489,15 @@ public:
         WT_CURSOR* c = _cursor->get();
 
         if (!_skipNextAdvance) {
+            auto& storageStats = _cursor->storageStats();
+            const bool seekToRangeStart = _lastReturnedId.isNull() && !_rangeStart.isNull();
+            ++(seekToRangeStart ? storageStats.cursorSeeks : storageStats.cursorNexts);
+
             // Nothing after the next line can throw WCEs.
             // Note that an unpositioned (or eof) WT_CURSOR returns the first/last entry in the
             // table when you call next/prev.
-            int advanceRet = WT_OP_CHECK(_forward ? c->next(c) : c->prev(c));
+            int advanceRet = seekToRangeStart ? _seekToRangeStart(c)
+                                              : WT_OP_CHECK(_forward ? c->next(c) : c->prev(c));
             if (advanceRet == WT_NOTFOUND) {
                 _eof = true;
                 return {};
@@ -473,13 +519,23 @@ public:
             throw WriteConflictException();
         }
 
+        if (!_rangeEnd.isNull() && id >= _rangeEnd) {
+            _eof = true;
+            return {};
+        }
+
         if (!isVisible(id)) {
             _eof = true;
             return {};
         }
 
+        if (_readAhead && ++_recordsSinceReadAhead >= _readAheadRecords) {
+            _scheduleReadAhead(key);
+        }
+
         WT_ITEM value;
         invariantWTOK(c->get_value(c, &value));
+        _cursor->storageStats().bytesRead += value.size;
 
         _lastReturnedId = id;
         return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
@@ -487,6 +543,8 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id) final {
         _skipNextAdvance = false;
+        auto& storageStats = _cursor->storageStats();
+        ++storageStats.cursorSeeks;
         WT_CURSOR* c = _cursor->get();
         c->set_key(c, _makeKey(id));
         // Nothing after the next line can throw WCEs.
@@ -499,6 +557,7 @@ public:
 
         WT_ITEM value;
         invariantWTOK(c->get_value(c, &value));
+        storageStats.bytesRead += value.size;
 
         _lastReturnedId = id;
         _eof = false;
@@ -506,6 +565,14 @@ public:
     }
 
     void save() final {
+        // The WT_CURSOR keeps its position for as long as the transaction it was saved in stays
+        // open, and WiredTiger resets it when that transaction ends, so there is no need to reset
+        // it here. restore() only re-seeks if the snapshot has changed in between.
+        auto ru = WiredTigerRecoveryUnit::get(_opCtx);
+        _savedSnapshotId = (_cursor && ru->inActiveTxn()) ? ru->getSnapshotId() : SnapshotId();
+    }
+
+    void saveUnpositioned() final {
         try {
             if (_cursor)
                 _cursor->reset();
@@ -513,10 +580,7 @@ public:
             // Ignore since this is only called when we are about to kill our transaction
             // anyway.
         }
-    }
-
-    void saveUnpositioned() final {
-        save();
+        _savedSnapshotId = SnapshotId();
         _lastReturnedId = RecordId();
     }
 
@@ -525,7 +589,16 @@ public:
             _cursor.emplace(_rs.getURI(), _rs.tableId(), true, _opCtx);
 
         // This will ensure an active session exists, so any restored cursors will bind to it
-        invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession(_opCtx) == _cursor->getSession());
+        auto ru = WiredTigerRecoveryUnit::get(_opCtx);
+        invariant(ru->getSession(_opCtx) == _cursor->getSession());
+
+        // Still in the transaction we were saved in, so the WT_CURSOR is where we left it.
+        const bool sameSnapshot =
+            !_savedSnapshotId.isNull() && _savedSnapshotId == ru->getSnapshotId();
+        _savedSnapshotId = SnapshotId();
+        if (sameSnapshot)
+            return true;
+
         _skipNextAdvance = false;
 
         // If we've hit EOF, then this iterator is done and need not be restored.
@@ -535,6 +608,7 @@ public:
         if (_lastReturnedId.isNull())
             return true;
 
+        ++_cursor->storageStats().cursorSeeks;
         WT_CURSOR* c = _cursor->get();
         c->set_key(c, _makeKey(_lastReturnedId));
 
@@ -571,6 +645,7 @@ public:
     void detachFromOperationContext() final {
         _opCtx = nullptr;
         _cursor = boost::none;
+        _savedSnapshotId = SnapshotId();
     }
 
     void reattachToOperationContext(OperationContext* opCtx) final {
@@ -578,7 +653,62 @@ public:
         // _cursor recreated in restore() to avoid risk of WT_ROLLBACK issues.
     }
 
+    void hintSequentialScan() final {
+        const int numRecords = wiredTigerReadAheadRecords.load();
+        if (numRecords <= 0)
+            return;
+
+        WiredTigerSessionCache* sessionCache =
+            WiredTigerRecoveryUnit::get(_opCtx)->getSessionCache();
+        if (sessionCache->isEphemeral())
+            return;  // Everything is already in memory.
+
+        _readAhead = &sessionCache->readAhead();
+        _readAheadRecords = numRecords;
+        _readAheadInFlight = std::make_shared<AtomicBool>(false);
+
+        // Start reading ahead as soon as the first record is returned.
+        _recordsSinceReadAhead = numRecords;
+    }
+
 private:
+    Cursor(OperationContext* opCtx,
+           const WiredTigerRecordStore& rs,
+           bool forward,
+           const RecordId& rangeStart,
+           const RecordId& rangeEnd)
+        : _rs(rs),
+          _opCtx(opCtx),
+          _forward(forward),
+          _readUntilForOplog(WiredTigerRecoveryUnit::get(opCtx)->getOplogReadTill()),
+          _rangeStart(rangeStart),
+          _rangeEnd(rangeEnd) {
+        invariant(_forward || (_rangeStart.isNull() && _rangeEnd.isNull()));
+        _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
+    }
+
+    /**
+     * Positions 'c' on the first record at or after the start of this cursor's range.
+     */
+    int _seekToRangeStart(WT_CURSOR* c) {
+        c->set_key(c, _makeKey(_rangeStart));
+        int cmp;
+        int ret = WT_OP_CHECK(c->search_near(c, &cmp));
+        if (ret == 0 && cmp < 0)
+            ret = WT_OP_CHECK(c->next(c));
+        return ret;
+    }
+
+    void _scheduleReadAhead(int64_t key) {
+        // Read two windows' worth, so that the scan still finds warm pages ahead of it while the
+        // next read is being scheduled. If the previous read is still running, try again on the
+        // next record.
+        if (_readAhead->schedule(
+                _rs.getURI(), key, _forward, 2 * _readAheadRecords, _readAheadInFlight)) {
+            _recordsSinceReadAhead = 0;
+        }
+    }
+
     bool isVisible(const RecordId& id) {
         if (!_rs._isCapped)
             return true;
@@ -608,6 +738,19 @@ private:
     bool _eof = false;
     RecordId _lastReturnedId;  // If null, need to seek to first/last record.
     const RecordId _readUntilForOplog;
+
+    // The snapshot that was open when save() was called, if the WT_CURSOR was left positioned.
+    SnapshotId _savedSnapshotId;
+
+    // Bounds of the records this cursor returns, if it only covers part of the table.
+    const RecordId _rangeStart;
+    const RecordId _rangeEnd;
+
+    // Only set once hintSequentialScan() has enabled read-ahead.
+    WiredTigerReadAhead* _readAhead = nullptr;
+    std::shared_ptr<AtomicBool> _readAheadInFlight;
+    int _readAheadRecords = 0;
+    int _recordsSinceReadAhead = 0;
 };
 
 StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj options) {
@@ -655,6 +798,10 @@ public:
         WT_ITEM value;
         invariantWTOK(_cursor->get_value(_cursor, &value));
 
+        auto& storageStats = _opCtx->recoveryUnit()->storageStats();
+        ++storageStats.cursorNexts;
+        storageStats.bytesRead += value.size;
+
         return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
     }
 
@@ -700,6 +847,85 @@ private:
     const std::string _config;
 };
 
+/**
+ * Returns runs of consecutive records, each starting at a record from a random cursor. The random
+ * cursor is told how many runs are wanted, so that WiredTiger spreads their starting records over
+ * that many leaf pages rather than over neighbouring records of a few pages. A run ends early at
+ * the end of the table or at a record this cursor has already returned, which usually means the
+ * rest of the run has already been returned by an earlier run as well.
+ */
+class WiredTigerRecordStore::BlockSampleCursor final : public RecordCursor {
+public:
+    BlockSampleCursor(OperationContext* opCtx,
+                      const WiredTigerRecordStore& rs,
+                      long long numBlocks,
+                      long long blockSize)
+        : _random(rs.getRandomCursorWithOptions(
+              opCtx, str::stream() << "next_random_sample_size=" << numBlocks)),
+          _forward(rs.getCursor(opCtx, /*forward=*/true)),
+          _blockSize(blockSize) {}
+
+    boost::optional<Record> next() final {
+        if (_remainingInBlock > 0) {
+            --_remainingInBlock;
+            auto record = _forward->next();
+            if (record && _returned.insert(record->id).second) {
+                return record;
+            }
+            _remainingInBlock = 0;
+        }
+
+        // Give up on avoiding duplicates after this many random records which were all returned
+        // already, which only happens once most of the table has been returned.
+        const int kMaxAttempts = 100;
+        boost::optional<Record> start;
+        for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+            start = _random->next();
+            if (!start) {
+                return {};
+            }
+            if (_returned.insert(start->id).second) {
+                break;
+            }
+        }
+
+        // Position the forward cursor on the starting record for the rest of the run. The record
+        // may have been deleted since the random cursor returned it, in which case the run is
+        // just that one record.
+        if (_forward->seekExact(start->id)) {
+            _remainingInBlock = _blockSize - 1;
+        }
+        return start;
+    }
+
+    void save() final {
+        _random->save();
+        _forward->save();
+    }
+
+    bool restore() final {
+        // A run continues from the next closest record if its position was deleted.
+        return _random->restore() && _forward->restore();
+    }
+
+    void detachFromOperationContext() final {
+        _random->detachFromOperationContext();
+        _forward->detachFromOperationContext();
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) final {
+        _random->reattachToOperationContext(opCtx);
+        _forward->reattachToOperationContext(opCtx);
+    }
+
+private:
+    const std::unique_ptr<RecordCursor> _random;
+    const std::unique_ptr<SeekableRecordCursor> _forward;
+    const long long _blockSize;
+    long long _remainingInBlock = 0;
+    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+};
+
 
 // static
 StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
@@ -784,7 +1010,6 @@ WiredTigerRecordStore::WiredTigerRecordStore(OperationContext* ctx,
       _cappedDeleteCheckCount(0),
       _useOplogHack(shouldUseOplogHack(ctx, _uri)),
       _sizeStorer(sizeStorer),
-      _sizeStorerCounter(0),
       _shuttingDown(false) {
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
                                ctx, uri, kMinimumRecordStoreVersion, kMaximumRecordStoreVersion)
@@ -805,38 +1030,47 @@ WiredTigerRecordStore::WiredTigerRecordStore(OperationContext* ctx,
         invariant(_cappedMaxDocs == -1);
     }
 
-    // Find the largest RecordId currently in use and estimate the number of records.
-    Cursor cursor(ctx, *this, /*forward=*/false);
-    if (auto record = cursor.next()) {
-        int64_t max = _makeKey(record->id);
-        _oplog_highestSeen = record->id;
-        _nextIdNum.store(1 + max);
-
-        if (_sizeStorer) {
-            long long numRecords;
-            long long dataSize;
-            _sizeStorer->loadFromCache(uri, &numRecords, &dataSize);
-            _numRecords.store(numRecords);
-            _dataSize.store(dataSize);
-            _sizeStorer->onCreate(this, numRecords, dataSize);
-        } else {
-            LOG(1) << "Doing scan of collection " << ns << " to get size and count info";
+    long long numRecords;
+    long long dataSize;
+    if (_sizeStorer && !_isCapped && _sizeStorer->loadFromCache(uri, &numRecords, &dataSize)) {
+        // Only inserts need the largest RecordId, which is looked up by the first of them.
+        _numRecords.store(numRecords);
+        _dataSize.store(dataSize);
+        _sizeStorer->onCreate(this, numRecords, dataSize);
+    } else {
+        // Find the largest RecordId currently in use and estimate the number of records.
+        Cursor cursor(ctx, *this, /*forward=*/false);
+        if (auto record = cursor.next()) {
+            int64_t max = _makeKey(record->id);
+            _oplog_highestSeen = record->id;
+            _oplogReadTillRepr.store(record->id.repr());
+            _nextIdNum.store(1 + max);
+
+            if (_sizeStorer) {
+                _sizeStorer->loadFromCache(uri, &numRecords, &dataSize);
+                _numRecords.store(numRecords);
+                _dataSize.store(dataSize);
+                _sizeStorer->onCreate(this, numRecords, dataSize);
+            } else {
+                LOG(1) << "Doing scan of collection " << ns << " to get size and count info";
 
-            _numRecords.store(0);
-            _dataSize.store(0);
+                _numRecords.store(0);
+                _dataSize.store(0);
 
-            do {
-                _numRecords.fetchAndAdd(1);
-                _dataSize.fetchAndAdd(record->data.size());
-            } while ((record = cursor.next()));
+                do {
+                    _numRecords.fetchAndAdd(1);
+                    _dataSize.fetchAndAdd(record->data.size());
+                } while ((record = cursor.next()));
+            }
+        } else {
+            _dataSize.store(0);
+            _numRecords.store(0);
+            // Need to start at 1 so we are always higher than RecordId::min()
+            _nextIdNum.store(1);
+            if (sizeStorer)
+                _sizeStorer->onCreate(this, 0, 0);
         }
-    } else {
-        _dataSize.store(0);
-        _numRecords.store(0);
-        // Need to start at 1 so we are always higher than RecordId::min()
-        _nextIdNum.store(1);
-        if (sizeStorer)
-            _sizeStorer->onCreate(this, 0, 0);
+        _nextIdNumInitialized.store(true);
     }
 
     if (WiredTigerKVEngine::initRsOplogBackgroundThread(ns)) {
@@ -931,6 +1165,7 @@ RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const
     WT_ITEM value;
     int ret = cursor->get_value(cursor.get(), &value);
     invariantWTOK(ret);
+    cursor.storageStats().bytesRead += value.size;
 
     SharedBuffer data = SharedBuffer::allocate(value.size);
     memcpy(data.get(), value.data, value.size);
@@ -943,6 +1178,7 @@ RecordData WiredTigerRecordStore::dataFor(OperationContext* opCtx, const RecordI
     WT_CURSOR* c = curwrap.get();
     invariant(c);
     c->set_key(c, _makeKey(id));
+    ++curwrap.storageStats().cursorSeeks;
     int ret = WT_OP_CHECK(c->search(c));
     massert(28556, "Didn't find RecordId in WiredTigerRecordStore", ret != WT_NOTFOUND);
     invariantWTOK(ret);
@@ -956,6 +1192,7 @@ bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
     WT_CURSOR* c = curwrap.get();
     invariant(c);
     c->set_key(c, _makeKey(id));
+    ++curwrap.storageStats().cursorSeeks;
     int ret = WT_OP_CHECK(c->search(c));
     if (ret == WT_NOTFOUND) {
         return false;
@@ -986,10 +1223,27 @@ void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId
     ret = WT_OP_CHECK(c->remove(c));
     invariantWTOK(ret);
 
+    auto& storageStats = cursor.storageStats();
+    ++storageStats.cursorSeeks;
+    ++storageStats.cursorWrites;
+
     _changeNumRecords(opCtx, -1);
     _increaseDataSize(opCtx, -old_length);
 }
 
+void WiredTigerRecordStore::CappedDeleteLatencies::record(Milliseconds latency) {
+    const auto millis = durationCount<Milliseconds>(latency);
+    const size_t bucket = millis < 1 ? 0 : millis < 10 ? 1 : millis < 100 ? 2 : 3;
+    _counts[bucket].fetchAndAdd(1);
+}
+
+void WiredTigerRecordStore::CappedDeleteLatencies::append(BSONObjBuilder* builder) const {
+    builder->appendNumber("lessThan1ms", _counts[0].load());
+    builder->appendNumber("lessThan10ms", _counts[1].load());
+    builder->appendNumber("lessThan100ms", _counts[2].load());
+    builder->appendNumber("atLeast100ms", _counts[3].load());
+}
+
 bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     if (!_isCapped)
         return false;
@@ -1014,6 +1268,15 @@ int64_t WiredTigerRecordStore::cappedDeleteAsNeeded(OperationContext* opCtx,
     if (!cappedAndNeedDelete())
         return 0;
 
+    // A collection capped by size alone may overshoot its size by the slack, so the excess
+    // documents can be left to a background job and the insert doesn't have to wait for them to be
+    // deleted. Past the slack, inserts delete them as well to bound the overshoot.
+    if (_cappedMaxDocs == -1 && !_isOplog &&
+        (_dataSize.load() - _cappedMaxSize) < _cappedMaxSizeSlack &&
+        WiredTigerKVEngine::requestCappedDelete(ns())) {
+        return 0;
+    }
+
     // ensure only one thread at a time can do deletes, otherwise they'll conflict.
     boost::unique_lock<boost::timed_mutex> lock(_cappedDeleterMutex, boost::defer_lock);  // NOLINT
 
@@ -1043,7 +1306,29 @@ int64_t WiredTigerRecordStore::cappedDeleteAsNeeded(OperationContext* opCtx,
         }
     }
 
-    return cappedDeleteAsNeeded_inlock(opCtx, justInserted);
+    Timer timer;
+    const int64_t docsRemoved = cappedDeleteAsNeeded_inlock(opCtx, justInserted);
+    _insertCappedDeleteLatencies.record(Milliseconds(timer.millis()));
+    return docsRemoved;
+}
+
+int64_t WiredTigerRecordStore::cappedDeleteInBackground(OperationContext* opCtx) {
+    invariant(!_oplogStones);
+
+    boost::unique_lock<boost::timed_mutex> lock(_cappedDeleterMutex);  // NOLINT
+    int64_t docsRemoved = 0;
+    while (!_shuttingDown && cappedAndNeedDelete()) {
+        // Spare the newest record, as an insert spares the one it just inserted.
+        const RecordId newestRecord(_nextIdNum.load() - 1);
+
+        Timer timer;
+        const int64_t removed = cappedDeleteAsNeeded_inlock(opCtx, newestRecord);
+        _backgroundCappedDeleteLatencies.record(Milliseconds(timer.millis()));
+        if (removed == 0)
+            break;
+        docsRemoved += removed;
+    }
+    return docsRemoved;
 }
 
 int64_t WiredTigerRecordStore::cappedDeleteAsNeeded_inlock(OperationContext* opCtx,
@@ -1283,10 +1568,10 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             record.id = status.getValue();
         } else if (_isCapped) {
             stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-            record.id = _nextId();
+            record.id = _nextId(opCtx);
             _addUncommittedRecordId_inlock(opCtx, record.id);
         } else {
-            record.id = _nextId();
+            record.id = _nextId(opCtx);
         }
         dassert(record.id > highestId);
         highestId = record.id;
@@ -1294,8 +1579,10 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
 
     if (_useOplogHack && (highestId > _oplog_highestSeen)) {
         stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-        if (highestId > _oplog_highestSeen)
+        if (highestId > _oplog_highestSeen) {
             _oplog_highestSeen = highestId;
+            _publishCappedVisibility_inlock();
+        }
     }
 
     for (size_t i = 0; i < nRecords; i++) {
@@ -1308,6 +1595,10 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
     }
 
+    auto& storageStats = curwrap.storageStats();
+    storageStats.cursorWrites += nRecords;
+    storageStats.bytesWritten += totalLength;
+
     _changeNumRecords(opCtx, nRecords);
     _increaseDataSize(opCtx, totalLength);
 
@@ -1332,7 +1623,7 @@ StatusWith<RecordId> WiredTigerRecordStore::insertRecord(OperationContext* opCtx
     return StatusWith<RecordId>(record.id);
 }
 
-void WiredTigerRecordStore::_dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit) {
+bool WiredTigerRecordStore::_dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit) {
     invariant(it->isNormal());
     stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
     if (didCommit && _isOplog && *it != _oplog_highestSeen) {
@@ -1347,23 +1638,31 @@ void WiredTigerRecordStore::_dealtWithCappedId(SortedRecordIds::iterator it, boo
         if (wasEmpty) {
             _opsWaitingForJournalCV.notify_one();
         }
-    } else {
-        _uncommittedRecordIds.erase(it);
-        _opsBecameVisibleCV.notify_all();
+        return false;
     }
+
+    _uncommittedRecordIds.erase(it);
+    _opsBecameVisibleCV.notify_all();
+    return _publishCappedVisibility_inlock();
+}
+
+bool WiredTigerRecordStore::_publishCappedVisibility_inlock() {
+    const auto lowestHidden =
+        _uncommittedRecordIds.empty() ? RecordId() : _uncommittedRecordIds.front();
+    const auto readTill = lowestHidden.isNull() ? _oplog_highestSeen : lowestHidden;
+    _oplogReadTillRepr.store(readTill.repr());
+
+    const RecordId previous(_lowestHiddenRecordRepr.swap(lowestHidden.repr()));
+    return !previous.isNull() && (lowestHidden.isNull() || lowestHidden > previous);
 }
 
 bool WiredTigerRecordStore::isCappedHidden(const RecordId& id) const {
-    stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-    if (_uncommittedRecordIds.empty()) {
-        return false;
-    }
-    return _uncommittedRecordIds.front() <= id;
+    const RecordId lowestHidden(_lowestHiddenRecordRepr.load());
+    return !lowestHidden.isNull() && lowestHidden <= id;
 }
 
 RecordId WiredTigerRecordStore::lowestCappedHiddenRecord() const {
-    stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-    return _uncommittedRecordIds.empty() ? RecordId() : _uncommittedRecordIds.front();
+    return RecordId(_lowestHiddenRecordRepr.load());
 }
 
 Status WiredTigerRecordStore::insertRecordsWithDocWriter(OperationContext* opCtx,
@@ -1435,6 +1734,11 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     ret = WT_OP_CHECK(c->insert(c));
     invariantWTOK(ret);
 
+    auto& storageStats = curwrap.storageStats();
+    ++storageStats.cursorSeeks;
+    ++storageStats.cursorWrites;
+    storageStats.bytesWritten += len;
+
     _increaseDataSize(opCtx, len - old_length);
     if (!_oplogStones) {
         cappedDeleteAsNeeded(opCtx, id);
@@ -1444,7 +1748,7 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return false;
+    return true;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1453,16 +1757,37 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
-    MONGO_UNREACHABLE;
+    // WiredTiger has no partial value updates, so the whole value is still written. Patching
+    // a copy of the old record spares the caller from rebuilding the document, and since the
+    // size cannot change there is no need to look up the old value or adjust the data size.
+    const int len = oldRec.size();
+    auto buffer = SharedBuffer::allocate(len);
+    char* root = buffer.get();
+    std::memcpy(root, oldRec.data(), len);
+    for (const auto& damage : damages) {
+        invariant(damage.targetOffset + damage.size <= static_cast<size_t>(len));
+        std::memcpy(root + damage.targetOffset, damageSource + damage.sourceOffset, damage.size);
+    }
+
+    WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+    invariant(c);
+    c->set_key(c, _makeKey(id));
+    WiredTigerItem value(root, len);
+    c->set_value(c, value.Get());
+    int ret = WT_OP_CHECK(c->insert(c));
+    invariantWTOK(ret);
+
+    auto& storageStats = curwrap.storageStats();
+    ++storageStats.cursorWrites;
+    storageStats.bytesWritten += len;
+
+    return RecordData(std::move(buffer), len);
 }
 
 void WiredTigerRecordStore::_oplogSetStartHack(WiredTigerRecoveryUnit* wru) const {
-    stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-    if (_uncommittedRecordIds.empty()) {
-        wru->setOplogReadTill(_oplog_highestSeen);
-    } else {
-        wru->setOplogReadTill(_uncommittedRecordIds.front());
-    }
+    wru->setOplogReadTill(RecordId(_oplogReadTillRepr.load()));
 }
 
 std::unique_ptr<SeekableRecordCursor> WiredTigerRecordStore::getCursor(OperationContext* opCtx,
@@ -1492,10 +1817,56 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursorWithOptions(
     return stdx::make_unique<RandomCursor>(opCtx, *this, extraConfig);
 }
 
+std::unique_ptr<RecordCursor> WiredTigerRecordStore::getBlockSampleCursor(
+    OperationContext* opCtx, long long sampleSize, long long blockSize) const {
+    invariant(blockSize > 0);
+    const long long numBlocks = std::max(1LL, (sampleSize + blockSize - 1) / blockSize);
+    return stdx::make_unique<BlockSampleCursor>(opCtx, *this, numBlocks, blockSize);
+}
+
 std::vector<std::unique_ptr<RecordCursor>> WiredTigerRecordStore::getManyCursors(
     OperationContext* opCtx) const {
-    std::vector<std::unique_ptr<RecordCursor>> cursors(1);
-    cursors[0] = stdx::make_unique<Cursor>(opCtx, *this, /*forward=*/true);
+    std::vector<std::unique_ptr<RecordCursor>> cursors;
+
+    // Capped collections hide uncommitted records from forward cursors based on the position of
+    // the scan, so they are always scanned in one piece.
+    const int64_t numRanges = _isCapped
+        ? 1
+        : std::min<int64_t>(kMaxScanRanges, numRecords(opCtx) / kMinRecordsPerScanRange);
+    if (numRanges <= 1) {
+        cursors.push_back(stdx::make_unique<Cursor>(opCtx, *this, /*forward=*/true));
+        return cursors;
+    }
+
+    // Split the table into ranges holding roughly the same number of records, by oversampling
+    // random records and using every (kRandomSamplesPerScanRange)th sample as a boundary.
+    const int64_t numSamples = kRandomSamplesPerScanRange * numRanges;
+    const std::string extraConfig = str::stream() << "next_random_sample_size=" << numSamples;
+    auto sampler = getRandomCursorWithOptions(opCtx, extraConfig);
+    std::vector<RecordId> samples;
+    for (int64_t i = 0; i < numSamples; ++i) {
+        auto record = sampler->next();
+        if (!record)
+            break;
+        samples.push_back(record->id);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    std::vector<RecordId> boundaries;
+    for (int64_t i = 1; i < numRanges; ++i) {
+        const size_t sampleIndex = kRandomSamplesPerScanRange * i;
+        if (sampleIndex >= samples.size())
+            break;
+        if (boundaries.empty() || boundaries.back() < samples[sampleIndex])
+            boundaries.push_back(samples[sampleIndex]);
+    }
+
+    RecordId rangeStart;
+    for (auto&& rangeEnd : boundaries) {
+        cursors.push_back(stdx::make_unique<Cursor>(opCtx, *this, rangeStart, rangeEnd));
+        rangeStart = rangeEnd;
+    }
+    cursors.push_back(stdx::make_unique<Cursor>(opCtx, *this, rangeStart, RecordId()));
     return cursors;
 }
 
@@ -1535,6 +1906,11 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx,
     return Status::OK();
 }
 
+StatusWith<bool> WiredTigerRecordStore::compactIncrementally(OperationContext* opCtx,
+                                                             Seconds timeLimit) {
+    return WiredTigerUtil::compactIncrementally(opCtx, getURI(), timeLimit);
+}
+
 Status WiredTigerRecordStore::validate(OperationContext* opCtx,
                                        ValidateCmdLevel level,
                                        ValidateAdaptor* adaptor,
@@ -1624,6 +2000,17 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
         result->appendIntOrLL("maxSize", static_cast<long long>(_cappedMaxSize / scale));
         result->appendIntOrLL("sleepCount", _cappedSleep.load());
         result->appendIntOrLL("sleepMS", _cappedSleepMS.load());
+        {
+            BSONObjBuilder latencies(result->subobjStart("cappedDeleteLatencies"));
+            {
+                BSONObjBuilder insert(latencies.subobjStart("insert"));
+                _insertCappedDeleteLatencies.append(&insert);
+            }
+            {
+                BSONObjBuilder background(latencies.subobjStart("background"));
+                _backgroundCappedDeleteLatencies.append(&background);
+            }
+        }
     }
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession(opCtx);
     WT_SESSION* s = session->getSession();
@@ -1692,8 +2079,9 @@ public:
     }
 
     virtual void rollback() {
-        // Notify on rollback since it might make later commits visible.
-        _rs->_dealtWithCappedId(_it, false);
+        // Notify on rollback if it made later commits visible.
+        if (!_rs->_dealtWithCappedId(_it, false))
+            return;
         stdx::lock_guard<stdx::mutex> lk(_rs->_cappedCallbackMutex);
         if (_rs->_cappedCallback)
             _rs->_cappedCallback->notifyCappedWaitersIfNeeded();
@@ -1732,8 +2120,12 @@ void WiredTigerRecordStore::_oplogJournalThreadLoop(WiredTigerSessionCache* sess
         }
 
         _opsBecameVisibleCV.notify_all();
+        const bool becameVisible = _publishCappedVisibility_inlock();
         lk.unlock();
 
+        if (!becameVisible)
+            continue;
+
         stdx::lock_guard<stdx::mutex> cappedCallbackLock(_cappedCallbackMutex);
         if (_cappedCallback) {
             _cappedCallback->notifyCappedWaitersIfNeeded();
@@ -1762,6 +2154,7 @@ void WiredTigerRecordStore::_addUncommittedRecordId_inlock(OperationContext* opC
     invariant(it->isNormal());
     opCtx->recoveryUnit()->registerChange(new CappedInsertChange(this, it));
     _oplog_highestSeen = id;
+    _publishCappedVisibility_inlock();
 }
 
 boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
@@ -1803,13 +2196,31 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     }
 }
 
-RecordId WiredTigerRecordStore::_nextId() {
+RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
     invariant(!_useOplogHack);
+    if (!_nextIdNumInitialized.load())
+        _initNextIdNum(opCtx);
     RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
     invariant(out.isNormal());
     return out;
 }
 
+void WiredTigerRecordStore::_initNextIdNum(OperationContext* opCtx) {
+    stdx::lock_guard<stdx::mutex> lk(_nextIdNumMutex);
+    if (_nextIdNumInitialized.load())
+        return;
+
+    // No RecordId has been handed out since startup, so every record is visible to any snapshot.
+    Cursor cursor(opCtx, *this, /*forward=*/false);
+    if (auto record = cursor.next()) {
+        _nextIdNum.store(1 + _makeKey(record->id));
+    } else {
+        // Need to start at 1 so we are always higher than RecordId::min()
+        _nextIdNum.store(1);
+    }
+    _nextIdNumInitialized.store(true);
+}
+
 WiredTigerRecoveryUnit* WiredTigerRecordStore::_getRecoveryUnit(OperationContext* opCtx) {
     return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
 }
@@ -1820,6 +2231,7 @@ public:
     virtual void commit() {}
     virtual void rollback() {
         _rs->_numRecords.fetchAndAdd(-_diff);
+        _rs->_markSizeStorerDirty();
     }
 
 private:
@@ -1831,6 +2243,8 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     opCtx->recoveryUnit()->registerChange(new NumRecordsChange(this, diff));
     if (_numRecords.fetchAndAdd(diff) < 0)
         _numRecords.store(std::max(diff, int64_t(0)));
+
+    _markSizeStorerDirty();
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -1853,8 +2267,14 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
     if (_dataSize.fetchAndAdd(amount) < 0)
         _dataSize.store(std::max(amount, int64_t(0)));
 
-    if (_sizeStorer && _sizeStorerCounter++ % 1000 == 0) {
-        _sizeStorer->storeToCache(_uri, _numRecords.load(), _dataSize.load());
+    _markSizeStorerDirty();
+}
+
+void WiredTigerRecordStore::_markSizeStorerDirty() {
+    // Only the first change since the last sync needs to tell the size storer, which reads the
+    // current sizes when it syncs.
+    if (_sizeStorer && !_sizeStorerDirty.load() && !_sizeStorerDirty.swap(true)) {
+        _sizeStorer->markDirty(this);
     }
 }
 
@@ -1926,7 +2346,9 @@ void WiredTigerRecordStore::cappedTruncateAfter(OperationContext* opCtx,
 
     if (_useOplogHack) {
         // Forget that we've ever seen a higher timestamp than we now have.
+        stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
         _oplog_highestSeen = lastKeptId;
+        _publishCappedVisibility_inlock();
     }
 
     if (_oplogStones) {
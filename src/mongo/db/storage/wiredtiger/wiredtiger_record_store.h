@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/thread/mutex.hpp>
 #include <set>
 #include <string>
@@ -156,6 +157,10 @@ public:
     std::unique_ptr<RecordCursor> getRandomCursorWithOptions(OperationContext* opCtx,
                                                              StringData extraConfig) const;
 
+    std::unique_ptr<RecordCursor> getBlockSampleCursor(OperationContext* opCtx,
+                                                       long long sampleSize,
+                                                       long long blockSize) const final;
+
     std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* opCtx) const final;
 
     virtual Status truncate(OperationContext* opCtx);
@@ -172,6 +177,8 @@ public:
                            const CompactOptions* options,
                            CompactStats* stats);
 
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds timeLimit);
+
     virtual Status validate(OperationContext* opCtx,
                             ValidateCmdLevel level,
                             ValidateAdaptor* adaptor,
@@ -224,6 +231,14 @@ public:
         _sizeStorer = ss;
     }
 
+    /**
+     * Called by the size storer before it reads the sizes of this record store to persist them,
+     * so that any later change marks this record store dirty again.
+     */
+    void onSizeStorerSync() {
+        _sizeStorerDirty.store(false);
+    }
+
     bool isCappedHidden(const RecordId& id) const;
     RecordId lowestCappedHiddenRecord() const;
 
@@ -235,6 +250,12 @@ public:
 
     int64_t cappedDeleteAsNeeded_inlock(OperationContext* opCtx, const RecordId& justInserted);
 
+    /**
+     * Removes the documents in excess of the cap which inserts left to a background job, sparing
+     * the newest one. Returns the number of documents removed.
+     */
+    int64_t cappedDeleteInBackground(OperationContext* opCtx);
+
     boost::timed_mutex& cappedDeleterMutex() {  // NOLINT
         return _cappedDeleterMutex;
     }
@@ -252,26 +273,55 @@ public:
 private:
     class Cursor;
     class RandomCursor;
+    class BlockSampleCursor;
 
     class CappedInsertChange;
     class NumRecordsChange;
     class DataSizeChange;
 
+    /**
+     * Counts capped deletes by how long they took.
+     */
+    class CappedDeleteLatencies {
+    public:
+        void record(Milliseconds latency);
+        void append(BSONObjBuilder* builder) const;
+
+    private:
+        // Under 1ms, under 10ms, under 100ms and longer.
+        std::array<AtomicInt64, 4> _counts;
+    };
+
     static WiredTigerRecoveryUnit* _getRecoveryUnit(OperationContext* opCtx);
 
     static int64_t _makeKey(const RecordId& id);
     static RecordId _fromKey(int64_t k);
 
-    void _dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit);
+    /**
+     * Returns true if committing or rolling back 'it' made more records visible.
+     */
+    bool _dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit);
     void _addUncommittedRecordId_inlock(OperationContext* opCtx, RecordId id);
 
+    /**
+     * Publishes the lowest hidden record and the oplog read point after _uncommittedRecordIds or
+     * _oplog_highestSeen changed. Returns true if records that were hidden became visible.
+     */
+    bool _publishCappedVisibility_inlock();
+
     Status _insertRecords(OperationContext* opCtx, Record* records, size_t nRecords);
 
-    RecordId _nextId();
+    RecordId _nextId(OperationContext* opCtx);
+
+    /**
+     * Sets _nextIdNum to one past the highest RecordId in the table, unless that is already done.
+     */
+    void _initNextIdNum(OperationContext* opCtx);
     void _setId(RecordId id);
     bool cappedAndNeedDelete() const;
     void _changeNumRecords(OperationContext* opCtx, int64_t diff);
     void _increaseDataSize(OperationContext* opCtx, int64_t amount);
+    void _markSizeStorerDirty();
     RecordData _getData(const WiredTigerCursor& cursor) const;
     void _oplogSetStartHack(WiredTigerRecoveryUnit* wru) const;
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache);
@@ -293,6 +343,8 @@ private:
     RecordId _cappedFirstRecord;
     AtomicInt64 _cappedSleep;
     AtomicInt64 _cappedSleepMS;
+    CappedDeleteLatencies _insertCappedDeleteLatencies;
+    CappedDeleteLatencies _backgroundCappedDeleteLatencies;
     CappedCallback* _cappedCallback;
     stdx::mutex _cappedCallbackMutex;  // guards _cappedCallback.
 
@@ -306,12 +358,25 @@ private:
     RecordId _oplog_highestSeen;
     mutable stdx::mutex _uncommittedRecordIdsMutex;
 
+    // Copies of the front of _uncommittedRecordIds (null if it is empty) and of what an oplog
+    // reader may read up to, so that readers check visibility without taking the mutex. Only
+    // stored to under _uncommittedRecordIdsMutex, by _publishCappedVisibility_inlock().
+    AtomicInt64 _lowestHiddenRecordRepr{RecordId().repr()};
+    AtomicInt64 _oplogReadTillRepr{RecordId().repr()};
+
     AtomicInt64 _nextIdNum;
+    // Whether _nextIdNum is set. When the size storer knows the size of a collection which is not
+    // capped its table is not read on startup to find the highest RecordId, but on the first
+    // insert, so that starting up with many collections does not open every one of them.
+    AtomicWord<bool> _nextIdNumInitialized;
+    stdx::mutex _nextIdNumMutex;  // serializes _initNextIdNum
     AtomicInt64 _dataSize;
     AtomicInt64 _numRecords;
 
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
-    int _sizeStorerCounter;
+
+    // True if the sizes changed since the size storer last synced them.
+    AtomicBool _sizeStorerDirty{false};
 
     bool _shuttingDown;
 
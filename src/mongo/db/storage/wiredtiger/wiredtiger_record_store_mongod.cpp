@@ -41,10 +41,12 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/exit.h"
@@ -54,6 +56,10 @@ namespace mongo {
 
 namespace {
 
+// Whether the documents in excess of the cap of a collection capped by size alone are deleted by a
+// background job rather than by the inserts which went over the cap.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerCappedDeletesInBackground, bool, true);
+
 std::set<NamespaceString> _backgroundThreadNamespaces;
 stdx::mutex _backgroundThreadMutex;
 
@@ -156,5 +162,100 @@ MONGO_INITIALIZER(SetInitRsOplogBackgroundThreadCallback)(InitializerContext* co
     return Status::OK();
 }
 
+/**
+ * Deletes the documents in excess of the cap of the capped collections which inserts went over the
+ * cap of, so that the inserts don't have to.
+ */
+class WiredTigerCappedDeleterThread : public BackgroundJob {
+public:
+    WiredTigerCappedDeleterThread() : BackgroundJob(false /* deleteSelf */) {}
+
+    virtual std::string name() const {
+        return "WTCappedDeleter";
+    }
+
+    void request(const NamespaceString& nss) {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        if (_pending.insert(nss).second) {
+            _pendingCV.notify_one();
+        }
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        while (!globalInShutdownDeprecated()) {
+            std::set<NamespaceString> pending;
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                if (_pending.empty()) {
+                    // Wake up periodically to notice shutdown.
+                    _pendingCV.wait_for(lock, Seconds(1).toSystemDuration());
+                }
+                pending.swap(_pending);
+            }
+
+            for (const auto& nss : pending) {
+                if (globalInShutdownDeprecated())
+                    break;
+                _deleteExcessDocuments(nss);
+            }
+        }
+    }
+
+private:
+    void _deleteExcessDocuments(const NamespaceString& nss) {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+
+        try {
+            AutoGetDb autoDb(&opCtx, nss.db(), MODE_IX);
+            Database* db = autoDb.getDb();
+            if (!db) {
+                return;
+            }
+
+            Lock::CollectionLock collectionLock(opCtx.lockState(), nss.ns(), MODE_IX);
+            Collection* collection = db->getCollection(nss);
+            if (!collection || !collection->isCapped()) {
+                return;  // Dropped or converted since the request.
+            }
+
+            OldClientContext ctx(&opCtx, nss.ns(), false);
+            WiredTigerRecordStore* rs =
+                checked_cast<WiredTigerRecordStore*>(collection->getRecordStore());
+            const int64_t docsRemoved = rs->cappedDeleteInBackground(&opCtx);
+            LOG(3) << "deleted " << docsRemoved << " documents in excess of the cap of " << nss;
+        } catch (const DBException& e) {
+            warning() << "error deleting the documents in excess of the cap of " << nss << ": "
+                      << redact(e);
+        }
+    }
+
+    stdx::mutex _mutex;  // guards _pending
+    stdx::condition_variable _pendingCV;
+    std::set<NamespaceString> _pending;
+};
+
+bool requestCappedDelete(StringData ns) {
+    if (!wiredTigerCappedDeletesInBackground || storageGlobalParams.repair) {
+        return false;
+    }
+
+    // Started by the first request and never destroyed, like the oplog's thread.
+    static WiredTigerCappedDeleterThread* const cappedDeleter = [] {
+        auto thread = new WiredTigerCappedDeleterThread();
+        thread->go();
+        return thread;
+    }();
+    cappedDeleter->request(NamespaceString(ns));
+    return true;
+}
+
+MONGO_INITIALIZER(SetRequestCappedDeleteCallback)(InitializerContext* context) {
+    WiredTigerKVEngine::setRequestCappedDeleteCallback(requestCappedDelete);
+    return Status::OK();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/platform/atomic_proxy.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
@@ -41,6 +42,10 @@ namespace mongo {
 class OperationContext;
 class RecordId;
 
+// Oplog entries newer than this many hours are kept even if the oplog grows beyond its maximum
+// size. Zero or less disables the minimum retention period.
+extern AtomicDouble oplogMinRetentionHours;
+
 // Keep "milestones" against the oplog to efficiently remove the old records when the collection
 // grows beyond its desired maximum size.
 class WiredTigerRecordStore::OplogStones {
@@ -61,8 +66,15 @@ public:
         return _stones.size() > _numStonesToKeep;
     }
 
+    /**
+     * Waits until kill() is called or there is an excess stone which is old enough to reclaim.
+     */
     void awaitHasExcessStonesOrDead();
 
+    /**
+     * Returns the oldest stone if there are excess stones and it is older than the minimum
+     * retention period, and boost::none otherwise.
+     */
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
     void popOldestStone();
@@ -118,6 +130,9 @@ private:
 
     void _pokeReclaimThreadIfNeeded();
 
+    // Returns true if 'stone' contains entries within the minimum retention period.
+    static bool _isWithinRetentionPeriod(const Stone& stone);
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
     WiredTigerRecordStore* _rs;
@@ -29,6 +29,7 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -317,6 +318,87 @@ TEST(WiredTigerRecordStoreTest, Isolation2) {
     }
 }
 
+// A large collection is split into several ranges, which together return every record once.
+TEST(WiredTigerRecordStoreTest, GetManyCursorsSplitsLargeCollections) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 40000;
+    std::set<RecordId> remain;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, false);
+            ASSERT_OK(res.getStatus());
+            remain.insert(res.getValue());
+        }
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursors = rs->getManyCursors(opCtx.get());
+    ASSERT_GT(cursors.size(), 1U);
+
+    RecordId lastRangeEnd;
+    for (auto&& cursor : cursors) {
+        // Every range follows the previous one, and returns its records in order.
+        RecordId last;
+        while (auto record = cursor->next()) {
+            ASSERT_GT(record->id, last);
+            ASSERT_GT(record->id, lastRangeEnd);
+            ASSERT_EQ(remain.erase(record->id), size_t(1));
+            last = record->id;
+        }
+        ASSERT(!cursor->next());
+        if (!last.isNull())
+            lastRangeEnd = last;
+    }
+    ASSERT(remain.empty());
+}
+
+TEST(WiredTigerRecordStoreTest, BlockSampleCursorReturnsRunsOfDistinctRecords) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10000;
+    std::set<RecordId> inserted;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, false);
+            ASSERT_OK(res.getStatus());
+            inserted.insert(res.getValue());
+        }
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    const int sampleSize = 1000;
+    const int blockSize = 10;
+    auto cursor = rs->getBlockSampleCursor(opCtx.get(), sampleSize, blockSize);
+    ASSERT(cursor);
+
+    std::set<RecordId> returned;
+    int runLength = 0;
+    int longestRun = 0;
+    RecordId last;
+    for (int i = 0; i < sampleSize; i++) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(inserted.count(record->id), size_t(1));
+        ASSERT(returned.insert(record->id).second) << "returned " << record->id << " twice";
+
+        // Records follow each other within a run.
+        auto next = last.isNull() ? inserted.end() : inserted.upper_bound(last);
+        runLength = (next != inserted.end() && *next == record->id) ? runLength + 1 : 1;
+        longestRun = std::max(longestRun, runLength);
+        last = record->id;
+    }
+    ASSERT_GTE(longestRun, blockSize);
+}
+
 TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -393,6 +475,98 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(NULL);  // this has to be deleted before ss
 }
 
+// A record store opened with its size known to the size storer looks up its highest RecordId on
+// the first insert instead.
+TEST(WiredTigerRecordStoreTest, ReopenedWithKnownSizeInsertsAfterExistingRecords) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    string uri = checked_cast<WiredTigerRecordStore*>(rs.get())->getURI();
+
+    string sizeStorerUri = "table:reopenedWithKnownSize";
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri);
+    checked_cast<WiredTigerRecordStore*>(rs.get())->setSizeStorer(&ss);
+
+    RecordId last;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < 5; i++) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, false);
+            ASSERT_OK(res.getStatus());
+            last = res.getValue();
+        }
+        uow.commit();
+    }
+
+    rs.reset(NULL);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        rs.reset(new WiredTigerRecordStore(
+            opCtx.get(), "a.b", uri, kWiredTigerEngineName, false, false, -1, -1, NULL, &ss));
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(5, rs->numRecords(opCtx.get()));
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "b", 2, false);
+        ASSERT_OK(res.getStatus());
+        ASSERT_GT(res.getValue(), last);
+        uow.commit();
+        ASSERT_EQUALS(6, rs->numRecords(opCtx.get()));
+    }
+
+    rs.reset(NULL);  // this has to be deleted before ss
+}
+
+// Changes made after a sync are persisted by the next one.
+TEST(WiredTigerRecordStoreTest, SizeStorerSyncsLaterChanges) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    string uri = checked_cast<WiredTigerRecordStore*>(rs.get())->getURI();
+
+    string sizeStorerUri = "table:sizeStorerSyncsLaterChanges";
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri);
+    checked_cast<WiredTigerRecordStore*>(rs.get())->setSizeStorer(&ss);
+
+    auto insertAndSync = [&](int numRecords) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            for (int i = 0; i < numRecords; i++) {
+                ASSERT_OK(rs->insertRecord(opCtx.get(), "a", 2, false).getStatus());
+            }
+            uow.commit();
+        }
+        ss.syncCache(true);
+    };
+
+    auto loadPersisted = [&] {
+        WiredTigerSizeStorer reloaded(harnessHelper->conn(), sizeStorerUri);
+        reloaded.fillCache();
+        long long numRecords;
+        long long dataSize;
+        reloaded.loadFromCache(uri, &numRecords, &dataSize);
+        return numRecords;
+    };
+
+    insertAndSync(5);
+    ASSERT_EQUALS(5, loadPersisted());
+
+    insertAndSync(7);
+    ASSERT_EQUALS(12, loadPersisted());
+
+    // A sync with no changes since the last one leaves the persisted sizes alone.
+    ss.syncCache(true);
+    ASSERT_EQUALS(12, loadPersisted());
+
+    rs.reset(NULL);  // this has to be deleted before ss
+}
+
 namespace {
 
 class GoodValidateAdaptor : public ValidateAdaptor {
@@ -1016,6 +1190,42 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityOutOfOrder) {
     ASSERT(!wtrs->isCappedHidden(id2));
 }
 
+// Test that the lowest hidden oplog entry follows the oldest uncommitted insert as inserts commit
+// and roll back.
+TEST(WiredTigerRecordStoreTest, OplogLowestHiddenRecordAfterRollback) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("local.oplog.foo", 100000, -1));
+    auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+    ASSERT(wtrs->lowestCappedHiddenRecord().isNull());
+
+    RecordId id1;
+    {
+        ServiceContext::UniqueOperationContext longLivedOp(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(longLivedOp.get());
+        id1 = _oplogOrderInsertOplog(longLivedOp.get(), rs, 1);
+        ASSERT_EQ(id1, wtrs->lowestCappedHiddenRecord());
+
+        RecordId id2;
+        {
+            auto innerClient = harnessHelper->serviceContext()->makeClient("inner");
+            ServiceContext::UniqueOperationContext opCtx(
+                harnessHelper->newOperationContext(innerClient.get()));
+            WriteUnitOfWork innerUow(opCtx.get());
+            id2 = _oplogOrderInsertOplog(opCtx.get(), rs, 2);
+            ASSERT_EQ(id1, wtrs->lowestCappedHiddenRecord());
+            innerUow.commit();
+        }
+
+        // The later insert committed, but stays hidden behind the earlier one.
+        ASSERT_EQ(id1, wtrs->lowestCappedHiddenRecord());
+        ASSERT(wtrs->isCappedHidden(id2));
+
+        // Rolling back the earlier insert makes the later one visible.
+    }
+    ASSERT(wtrs->lowestCappedHiddenRecord().isNull());
+    ASSERT(!wtrs->isCappedHidden(id1));
+}
+
 TEST(WiredTigerRecordStoreTest, StorageSizeStatisticsDisabled) {
     WiredTigerHarnessHelper harnessHelper("statistics=(none)");
     unique_ptr<RecordStore> rs(harnessHelper.newNonCappedRecordStore("a.b"));
@@ -1076,6 +1286,49 @@ TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     ASSERT(!cursor->next());
 }
 
+TEST(WiredTigerRecordStoreTest, RestoreInSameSnapshotDoesNotSeek) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        for (int i = 0; i < 3; ++i) {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, false);
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+            uow.commit();
+        }
+    }
+
+    ServiceContext::UniqueOperationContext cursorCtx(harnessHelper->newOperationContext());
+    auto& storageStats = cursorCtx->recoveryUnit()->storageStats();
+    auto cursor = rs->getCursor(cursorCtx.get());
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(ids[0], record->id);
+
+    // The cursor is still positioned when restored in the snapshot it was saved in.
+    const auto seeksBefore = storageStats.cursorSeeks;
+    cursor->save();
+    ASSERT_TRUE(cursor->restore());
+    ASSERT_EQ(seeksBefore, storageStats.cursorSeeks);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(ids[1], record->id);
+
+    // Once the snapshot has been abandoned it seeks back to its last record.
+    cursor->save();
+    cursorCtx->recoveryUnit()->abandonSnapshot();
+    ASSERT_TRUE(cursor->restore());
+    ASSERT_EQ(seeksBefore + 1, storageStats.cursorSeeks);
+    record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(ids[2], record->id);
+    ASSERT(!cursor->next());
+}
+
 BSONObj makeBSONObjWithSize(const Timestamp& opTime, int size, char fill = 'x') {
     BSONObj objTemplate = BSON("ts" << opTime << "str"
                                     << "");
@@ -1472,6 +1725,70 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
     }
 }
 
+// Verify that oplog stones within the minimum retention period are not reclaimed.
+TEST(WiredTigerRecordStoreTest, OplogStones_MinRetentionPeriod) {
+    WiredTigerHarnessHelper harnessHelper;
+
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper.newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    oplogStones->setMinBytesPerStone(100);
+    oplogStones->setNumStonesToKeep(2U);
+
+    const double oldMinRetentionHours = oplogMinRetentionHours.load();
+    ON_BLOCK_EXIT([&] { oplogMinRetentionHours.store(oldMinRetentionHours); });
+    oplogMinRetentionHours.store(1);
+
+    // The first two entries are older than the retention period and the third is current.
+    const unsigned now = Date_t::now().toTimeT();
+    const unsigned twoHoursAgo = now - 2 * 3600;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(twoHoursAgo, 1), 100),
+                  RecordId(twoHoursAgo, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(twoHoursAgo, 2), 110),
+                  RecordId(twoHoursAgo, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(now, 1), 120),
+                  RecordId(now, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(now, 2), 130),
+                  RecordId(now, 2));
+
+        ASSERT_EQ(4U, oplogStones->numStones());
+    }
+
+    // Only the stones which have aged out of the retention period are truncated.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get());
+
+        ASSERT_EQ(2, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(250, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(2U, oplogStones->numStones());
+    }
+
+    // Once the retention period is disabled, stones are reclaimed based on size alone.
+    oplogMinRetentionHours.store(0);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(now, 3), 140),
+                  RecordId(now, 3));
+        ASSERT_EQ(3U, oplogStones->numStones());
+
+        wtrs->reclaimOplog(opCtx.get());
+
+        ASSERT_EQ(2, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(270, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(2U, oplogStones->numStones());
+    }
+}
+
 // Verify that oplog stones are not reclaimed even if the size of the record store exceeds
 // 'cappedMaxSize'.
 TEST(WiredTigerRecordStoreTest, OplogStones_ExceedCappedMaxSize) {
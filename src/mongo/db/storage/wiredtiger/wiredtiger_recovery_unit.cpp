@@ -71,6 +71,7 @@ void WiredTigerRecoveryUnit::prepareForCreateSnapshot(OperationContext* opCtx) {
     invariant(!_active);  // Can't already be in a WT transaction.
     invariant(!_inUnitOfWork);
     invariant(!_readFromMajorityCommittedSnapshot);
+    invariant(!_readFromLocalSnapshot);
 
     // Starts the WT transaction that will be the basis for creating a named snapshot.
     getSession(opCtx);
@@ -197,6 +198,10 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
     }
 
     if (commit) {
+        // Commits are not combined here. WiredTiger already copies the log records of concurrent
+        // commits into a shared log slot which is written out at once, and commits are not synced
+        // to disk. Waits for durability are combined into shared flushes by
+        // WiredTigerSessionCache::waitUntilDurable.
         invariantWTOK(s->commit_transaction(s, NULL));
         LOG(3) << "WT commit_transaction for snapshot id " << _mySnapshotId;
     } else {
@@ -231,6 +236,29 @@ boost::optional<SnapshotName> WiredTigerRecoveryUnit::getMajorityCommittedSnapsh
     return _majorityCommittedSnapshot;
 }
 
+Status WiredTigerRecoveryUnit::setReadFromLocalSnapshot() {
+    invariant(!_readFromMajorityCommittedSnapshot);
+    auto snapshotName = _sessionCache->snapshotManager().getMinSnapshotForNextLocalRead();
+    if (!snapshotName) {
+        return {ErrorCodes::LocalSnapshotNotAvailable, "Local snapshot reads are not possible."};
+    }
+
+    _localSnapshot = *snapshotName;
+    _readFromLocalSnapshot = true;
+    return Status::OK();
+}
+
+void WiredTigerRecoveryUnit::clearReadFromLocalSnapshot() {
+    invariant(!_active);
+    _readFromLocalSnapshot = false;
+}
+
+boost::optional<SnapshotName> WiredTigerRecoveryUnit::getLocalSnapshot() const {
+    if (!_readFromLocalSnapshot)
+        return {};
+    return _localSnapshot;
+}
+
 void WiredTigerRecoveryUnit::_txnOpen(OperationContext* opCtx) {
     invariant(!_active);
     _ensureSession();
@@ -244,6 +272,8 @@ void WiredTigerRecoveryUnit::_txnOpen(OperationContext* opCtx) {
     if (_readFromMajorityCommittedSnapshot) {
         _majorityCommittedSnapshot =
             _sessionCache->snapshotManager().beginTransactionOnCommittedSnapshot(s);
+    } else if (_readFromLocalSnapshot) {
+        _localSnapshot = _sessionCache->snapshotManager().beginTransactionOnLocalSnapshot(s);
     } else {
         invariantWTOK(s->begin_transaction(s, NULL));
     }
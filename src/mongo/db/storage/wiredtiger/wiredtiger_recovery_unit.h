@@ -80,6 +80,10 @@ public:
 
     boost::optional<SnapshotName> getMajorityCommittedSnapshot() const final;
 
+    Status setReadFromLocalSnapshot() final;
+    void clearReadFromLocalSnapshot() final;
+    boost::optional<SnapshotName> getLocalSnapshot() const final;
+
     // ---- WT STUFF
 
     WiredTigerSession* getSession(OperationContext* opCtx);
@@ -135,6 +139,8 @@ private:
     RecordId _oplogReadTill;
     bool _readFromMajorityCommittedSnapshot = false;
     SnapshotName _majorityCommittedSnapshot = SnapshotName::min();
+    bool _readFromLocalSnapshot = false;
+    SnapshotName _localSnapshot = SnapshotName::min();
     std::unique_ptr<Timer> _timer;
 
     typedef std::vector<std::unique_ptr<Change>> Changes;
@@ -173,6 +179,14 @@ public:
         _ru->assertInActiveTxn();
     }
 
+    /**
+     * Returns the counters of the recovery unit this cursor uses, which its users update with the
+     * work they do through it.
+     */
+    StorageOperationStats& storageStats() const {
+        return _ru->storageStats();
+    }
+
 private:
     uint64_t _tableID;
     WiredTigerRecoveryUnit* _ru;  // not owned
@@ -35,7 +35,13 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -43,9 +49,18 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+namespace {
+
+// How long the waiter running a journal flush waits for others to join it before flushing. Zero
+// flushes immediately, which still shares the flush with anyone already waiting.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerJournalCommitWindowMicros, int, 0);
+
+}  // namespace
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
       _cursorEpoch(cursorEpoch),
@@ -78,16 +93,24 @@ WiredTigerSession::~WiredTigerSession() {
 
 WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, bool forRecordStore) {
     // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        if (i->_id == id) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            _cursorsCached--;
-            return c;
+    auto indexed = _cursorIndex.find(id);
+    if (indexed != _cursorIndex.end()) {
+        auto& entries = indexed->second;
+        invariant(!entries.empty());
+        CursorCache::iterator i = entries.back();
+        WT_CURSOR* c = i->_cursor;
+        entries.pop_back();
+        if (entries.empty()) {
+            _cursorIndex.erase(indexed);
         }
+        _cursors.erase(i);
+        _cursorsOut++;
+        _cursorsCached--;
+        _cursorCacheHits++;
+        return c;
     }
 
+    _cursorCacheMisses++;
     WT_CURSOR* c = NULL;
     int ret = _session->open_cursor(
         _session, uri.c_str(), NULL, forRecordStore ? "" : "overwrite=false", &c);
@@ -107,6 +130,7 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
 
     // Cursors are pushed to the front of the list and removed from the back
     _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
+    _cursorIndex[id].push_back(_cursors.begin());
     _cursorsCached++;
 
     // "Old" is defined as not used in the last N**2 operations, if we have N cursors cached.
@@ -115,6 +139,16 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     // would like to cache N cursors in that case, so any given cursor could go N**2 operations
     // in between use.
     while (_cursorGen - _cursors.back()._gen > 10000) {
+        // The oldest cached cursor is also the oldest one cached for its table.
+        auto indexed = _cursorIndex.find(_cursors.back()._id);
+        invariant(indexed != _cursorIndex.end());
+        auto& entries = indexed->second;
+        invariant(entries.front() == std::prev(_cursors.end()));
+        entries.erase(entries.begin());
+        if (entries.empty()) {
+            _cursorIndex.erase(indexed);
+        }
+
         cursor = _cursors.back()._cursor;
         _cursors.pop_back();
         _cursorsCached--;
@@ -131,6 +165,7 @@ void WiredTigerSession::closeAllCursors() {
         }
     }
     _cursors.clear();
+    _cursorIndex.clear();
     _cursorEpoch = _cache->getCursorEpoch();
 }
 
@@ -144,11 +179,21 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+// static
+size_t WiredTigerSessionCache::_partitionForThisThread() {
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) %
+        kNumSessionCachePartitions;
+}
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
-    : _engine(engine), _conn(engine->getConnection()), _snapshotManager(_conn), _shuttingDown(0) {}
+    : _engine(engine),
+      _conn(engine->getConnection()),
+      _snapshotManager(_conn),
+      _readAhead(_conn),
+      _shuttingDown(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn)
-    : _engine(NULL), _conn(conn), _snapshotManager(_conn), _shuttingDown(0) {}
+    : _engine(NULL), _conn(conn), _snapshotManager(_conn), _readAhead(_conn), _shuttingDown(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -171,6 +216,7 @@ void WiredTigerSessionCache::shuttingDown() {
         sleepmillis(1);
     }
 
+    _readAhead.shutdown();
     closeAll();
     _snapshotManager.shutdown();
 }
@@ -204,18 +250,55 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint) {
         return;
     }
 
-    uint32_t start = _lastSyncTime.load();
-    // Do the remainder in a critical section that ensures only a single thread at a time
-    // will attempt to synchronize.
-    stdx::unique_lock<stdx::mutex> lk(_lastSyncMutex);
-    uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
-    if (current != start) {
-        // Someone else synced already since we read lastSyncTime, so we're done!
-        return;
+    stdx::unique_lock<stdx::mutex> lk(_flushMutex);
+
+    // Any flush which starts from now on covers everything committed before this call.
+    const uint64_t neededFlush = _flushesStarted + 1;
+    ++_waitersForNextFlush;
+
+    while (_flushesCompleted < neededFlush) {
+        if (_flushInProgress) {
+            _flushCV.wait(lk);
+            continue;
+        }
+
+        // Nobody is flushing, so flush on behalf of everyone waiting.
+        _flushInProgress = true;
+        const int windowMicros = wiredTigerJournalCommitWindowMicros.load();
+        if (windowMicros > 0) {
+            lk.unlock();
+            sleepmicros(windowMicros);
+            lk.lock();
+        }
+
+        const uint64_t flush = ++_flushesStarted;
+        const size_t batchSize = std::max(_waitersForNextFlush, size_t(1));
+        _waitersForNextFlush = 0;
+        lk.unlock();
+
+        size_t bucket = 0;
+        while (bucket + 1 < kNumFlushBatchSizeBuckets && (size_t(2) << bucket) <= batchSize) {
+            ++bucket;
+        }
+        _flushBatchSizes[bucket].fetchAndAdd(1);
+
+        try {
+            _flushForDurability();
+        } catch (...) {
+            lk.lock();
+            _flushInProgress = false;
+            _flushCV.notify_all();
+            throw;
+        }
+
+        lk.lock();
+        _flushInProgress = false;
+        _flushesCompleted = flush;
+        _flushCV.notify_all();
     }
-    _lastSyncTime.store(current + 1);
+}
 
-    // Nobody has synched yet, so we have to sync ourselves.
+void WiredTigerSessionCache::_flushForDurability() {
     auto session = getSession();
     WT_SESSION* s = session->getSession();
 
@@ -239,20 +322,25 @@ void WiredTigerSessionCache::closeAllCursors() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors();
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors();
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This must happen
+    // before emptying the partitions, since releaseSession() rechecks the epoch under the
+    // partition's lock before caching a session.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -269,18 +357,35 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    const size_t home = _partitionForThisThread();
     {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+        auto& partition = _partitions[home];
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            partition.sessionsReused++;
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
+    // Opening a session is much more expensive than taking one cached by another thread, but
+    // don't wait for partitions that are in use.
+    for (size_t i = 1; i < kNumSessionCachePartitions; ++i) {
+        auto& partition = _partitions[(home + i) % kNumSessionCachePartitions];
+        stdx::unique_lock<stdx::mutex> lock(partition.lock, stdx::try_to_lock);
+        if (lock.owns_lock() && !partition.sessions.empty()) {
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            partition.sessionsStolen++;
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionsCreated.fetchAndAdd(1);
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -324,10 +429,16 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     uint64_t currentEpoch = _epoch.load();
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        auto& partition = _partitions[_partitionForThisThread()];
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        partition.cursorCacheHits += session->_cursorCacheHits;
+        partition.cursorCacheMisses += session->_cursorCacheMisses;
+        session->_cursorCacheHits = 0;
+        session->_cursorCacheMisses = 0;
+
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -345,6 +456,40 @@ void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     _journalListener = jl;
 }
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) {
+    long long sessionsCached = 0;
+    long long sessionsReused = 0;
+    long long sessionsStolen = 0;
+    long long cursorCacheHits = 0;
+    long long cursorCacheMisses = 0;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        sessionsCached += partition.sessions.size();
+        sessionsReused += partition.sessionsReused;
+        sessionsStolen += partition.sessionsStolen;
+        cursorCacheHits += partition.cursorCacheHits;
+        cursorCacheMisses += partition.cursorCacheMisses;
+    }
+
+    BSONObjBuilder bob(builder->subobjStart("sessionCache"));
+    bob.append("cached", sessionsCached);
+    bob.append("reused", sessionsReused);
+    bob.append("stolen", sessionsStolen);
+    bob.append("created", static_cast<long long>(_sessionsCreated.load()));
+    bob.append("cursorCacheHits", cursorCacheHits);
+    bob.append("cursorCacheMisses", cursorCacheMisses);
+    bob.done();
+
+    static const char* const kBatchSizeBucketNames[kNumFlushBatchSizeBuckets] = {
+        "1", "2-3", "4-7", "8-15", "16-31", "32+"};
+    BSONObjBuilder flushes(builder->subobjStart("journalFlushBatchSizes"));
+    for (size_t i = 0; i < kNumFlushBatchSizeBuckets; ++i) {
+        flushes.append(kBatchSizeBucketNames[i],
+                       static_cast<long long>(_flushBatchSizes[i].load()));
+    }
+    flushes.done();
+}
+
 void WiredTigerSessionCache::WiredTigerSessionDeleter::operator()(
     WiredTigerSession* session) const {
     session->_cache->releaseSession(session);
@@ -31,20 +31,26 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -113,9 +119,14 @@ public:
 private:
     friend class WiredTigerSessionCache;
 
-    // The cursor cache is a list of pairs that contain an ID and cursor
+    // The cursor cache is a list of pairs that contain an ID and cursor, most recently released
+    // first.
     typedef std::list<WiredTigerCachedCursor> CursorCache;
 
+    // Indexes the cursor cache by table id, so that lookups don't have to scan every cached
+    // cursor. The entries for each id are ordered from least to most recently released.
+    typedef stdx::unordered_map<uint64_t, std::vector<CursorCache::iterator>> CursorIndex;
+
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
         return _epoch;
@@ -131,8 +142,13 @@ private:
     WiredTigerSessionCache* _cache;  // not owned
     WT_SESSION* _session;            // owned
     CursorCache _cursors;            // owned
+    CursorIndex _cursorIndex;
     uint64_t _cursorGen;
     int _cursorsCached, _cursorsOut;
+
+    // Cursor cache lookups since this session was last returned to the session cache.
+    long long _cursorCacheHits = 0;
+    long long _cursorCacheMisses = 0;
 };
 
 /**
@@ -184,6 +200,9 @@ public:
      * Waits until all commits that happened before this call are durable, either by flushing
      * the log or forcing a checkpoint if forceCheckpoint is true or the journal is disabled.
      * Uses a temporary session. Safe to call without any locks, even during shutdown.
+     *
+     * Concurrent callers which do not force a checkpoint share flushes: one of them flushes on
+     * behalf of all the callers waiting when the flush starts, and wakes them when it is done.
      */
     void waitUntilDurable(bool forceCheckpoint);
 
@@ -200,6 +219,16 @@ public:
 
     void setJournalListener(JournalListener* jl);
 
+    WiredTigerReadAhead& readAhead() {
+        return _readAhead;
+    }
+
+    /**
+     * Appends the session and cursor cache counters, and the sizes of the groups of durability
+     * waiters sharing each flush, to 'builder'.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
     uint64_t getCursorEpoch() const {
         return _cursorEpoch.load();
     }
@@ -208,6 +237,7 @@ private:
     WiredTigerKVEngine* _engine;  // not owned, might be NULL
     WT_CONNECTION* _conn;         // not owned
     WiredTigerSnapshotManager _snapshotManager;
+    WiredTigerReadAhead _readAhead;
 
     // Used as follows:
     //   The low 31 bits are a count of active calls to releaseSession.
@@ -215,9 +245,36 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    /**
+     * Released sessions are cached in one of several partitions, chosen by the releasing thread,
+     * so that concurrent operations rarely contend on the same lock and a thread tends to get
+     * back a session whose cursors it has already opened. A thread whose partition is empty
+     * takes a session from another partition before opening a new one.
+     */
+    struct SessionCachePartition {
+        stdx::mutex lock;
+        SessionCache sessions;
+
+        // Counters, protected by 'lock'.
+        long long sessionsReused = 0;
+        long long sessionsStolen = 0;
+        long long cursorCacheHits = 0;
+        long long cursorCacheMisses = 0;
+    };
+
+    static const size_t kNumSessionCachePartitions = 16;
+
+    /**
+     * Returns the index of the partition the calling thread caches its sessions in.
+     */
+    static size_t _partitionForThisThread();
+
+    std::array<SessionCachePartition, kNumSessionCachePartitions> _partitions;
+
+    // Number of sessions opened because no cached session was available.
+    AtomicUInt64 _sessionsCreated;
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -225,9 +282,23 @@ private:
     // Bumped when all open cursors need to be closed
     AtomicUInt64 _cursorEpoch;  // atomic so we can check it outside of the lock
 
-    // Counter and critical section mutex for waitUntilDurable
-    AtomicUInt32 _lastSyncTime;
-    stdx::mutex _lastSyncMutex;
+    // Group commit state for waitUntilDurable. A waiter is satisfied by any flush which starts
+    // after it arrives. The first waiter to find no flush in progress runs the next one.
+    stdx::mutex _flushMutex;
+    stdx::condition_variable _flushCV;
+    uint64_t _flushesStarted = 0;     // Protected by _flushMutex.
+    uint64_t _flushesCompleted = 0;   // Protected by _flushMutex.
+    bool _flushInProgress = false;    // Protected by _flushMutex.
+    size_t _waitersForNextFlush = 0;  // Protected by _flushMutex.
+
+    // Number of flushes shared by 1, 2-3, 4-7, ... and then 32 or more waiters.
+    static const size_t kNumFlushBatchSizeBuckets = 6;
+    std::array<AtomicUInt64, kNumFlushBatchSizeBuckets> _flushBatchSizes;
+
+    /**
+     * Makes all commits so far durable, by flushing the log or taking a checkpoint.
+     */
+    void _flushForDurability();
 
     // Notified when we commit to the journal.
     JournalListener* _journalListener = &NoOpJournalListener::instance;
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerSessionCacheTest : public unittest::Test {
+public:
+    WiredTigerSessionCacheTest() : _dbpath("wt_session_cache_test") {
+        int ret = wiredtiger_open(_dbpath.path().c_str(), NULL, "create", &_conn);
+        ASSERT_OK(wtRCToStatus(ret));
+        _sessionCache = stdx::make_unique<WiredTigerSessionCache>(_conn);
+    }
+
+    ~WiredTigerSessionCacheTest() {
+        _sessionCache.reset();
+        _conn->close(_conn, NULL);
+    }
+
+protected:
+    BSONObj getStats() {
+        BSONObjBuilder bob;
+        _sessionCache->appendStats(&bob);
+        return bob.obj().getObjectField("sessionCache").getOwned();
+    }
+
+    unittest::TempDir _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+    std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+};
+
+TEST_F(WiredTigerSessionCacheTest, ReleasedSessionIsReused) {
+    WiredTigerSession* first = nullptr;
+    {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        first = session.get();
+    }
+
+    UniqueWiredTigerSession session = _sessionCache->getSession();
+    ASSERT_EQ(first, session.get());
+
+    BSONObj stats = getStats();
+    ASSERT_EQ(1, stats["created"].numberLong());
+    ASSERT_EQ(1, stats["reused"].numberLong());
+    ASSERT_EQ(0, stats["cached"].numberLong());
+}
+
+TEST_F(WiredTigerSessionCacheTest, CursorCacheReturnsMostRecentlyReleasedCursor) {
+    const std::string uri = "table:session_cache_test";
+    const uint64_t tableId = WiredTigerSession::genTableId();
+    const uint64_t otherTableId = WiredTigerSession::genTableId();
+    {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+        ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, uri.c_str(), NULL)));
+
+        WT_CURSOR* first = session->getCursor(uri, tableId, true);
+        WT_CURSOR* second = session->getCursor(uri, tableId, true);
+        ASSERT_NE(first, second);
+        session->releaseCursor(tableId, first);
+        session->releaseCursor(tableId, second);
+
+        // Cursors cached for another table are never handed out.
+        WT_CURSOR* other = session->getCursor(uri, otherTableId, true);
+        ASSERT_NE(first, other);
+        ASSERT_NE(second, other);
+        session->releaseCursor(otherTableId, other);
+
+        ASSERT_EQ(second, session->getCursor(uri, tableId, true));
+        ASSERT_EQ(first, session->getCursor(uri, tableId, true));
+        ASSERT_EQ(2, session->cursorsOut());
+        session->releaseCursor(tableId, first);
+        session->releaseCursor(tableId, second);
+    }
+
+    BSONObj stats = getStats();
+    ASSERT_EQ(2, stats["cursorCacheHits"].numberLong());
+    ASSERT_EQ(3, stats["cursorCacheMisses"].numberLong());
+    ASSERT_EQ(1, stats["cached"].numberLong());
+}
+
+TEST_F(WiredTigerSessionCacheTest, ConcurrentDurabilityWaitersShareFlushes) {
+    auto countFlushes = [&] {
+        BSONObjBuilder bob;
+        _sessionCache->appendStats(&bob);
+        long long flushes = 0;
+        for (auto&& bucket : bob.obj().getObjectField("journalFlushBatchSizes")) {
+            flushes += bucket.numberLong();
+        }
+        return flushes;
+    };
+
+    // A lone waiter flushes by itself.
+    _sessionCache->waitUntilDurable(false);
+    ASSERT_EQ(1, countFlushes());
+
+    const int kNumThreads = 8;
+    const int kWaitsPerThread = 20;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kWaitsPerThread; ++j) {
+                _sessionCache->waitUntilDurable(false);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // Waits may share flushes, but never need more than one each.
+    const long long flushes = countFlushes();
+    ASSERT_GT(flushes, 1);
+    ASSERT_LTE(flushes, 1 + kNumThreads * kWaitsPerThread);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <utility>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -86,58 +88,87 @@ void WiredTigerSizeStorer::_checkMagic() const {
     invariant(_magic == MAGIC);
 }
 
+WiredTigerSizeStorer::Partition& WiredTigerSizeStorer::_partitionFor(StringData uri) {
+    // FNV-1a.
+    uint32_t hash = 2166136261U;
+    for (char c : uri) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+    }
+    return _partitions[hash % kNumPartitions];
+}
+
+const WiredTigerSizeStorer::Partition& WiredTigerSizeStorer::_partitionFor(StringData uri) const {
+    return const_cast<WiredTigerSizeStorer*>(this)->_partitionFor(uri);
+}
+
 void WiredTigerSizeStorer::onCreate(WiredTigerRecordStore* rs,
                                     long long numRecords,
                                     long long dataSize) {
     _checkMagic();
-    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-    Entry& entry = _entries[rs->getURI()];
+    const std::string& uri = rs->getURI();
+    Partition& partition = _partitionFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    Entry& entry = partition.entries[uri];
     entry.rs = rs;
     entry.numRecords = numRecords;
     entry.dataSize = dataSize;
-    entry.dirty = true;
+    partition.dirty.insert(uri);
 }
 
 void WiredTigerSizeStorer::onDestroy(WiredTigerRecordStore* rs) {
     _checkMagic();
-    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-    Entry& entry = _entries[rs->getURI()];
+    const std::string& uri = rs->getURI();
+    Partition& partition = _partitionFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    Entry& entry = partition.entries[uri];
     entry.numRecords = rs->numRecords(NULL);
     entry.dataSize = rs->dataSize(NULL);
-    entry.dirty = true;
     entry.rs = NULL;
+    partition.dirty.insert(uri);
 }
 
+void WiredTigerSizeStorer::markDirty(WiredTigerRecordStore* rs) {
+    _checkMagic();
+    const std::string& uri = rs->getURI();
+    Partition& partition = _partitionFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    partition.entries[uri].rs = rs;
+    partition.dirty.insert(uri);
+}
 
 void WiredTigerSizeStorer::storeToCache(StringData uri, long long numRecords, long long dataSize) {
     _checkMagic();
-    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-    Entry& entry = _entries[uri.toString()];
+    Partition& partition = _partitionFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    std::string uriKey = uri.toString();
+    Entry& entry = partition.entries[uriKey];
     entry.numRecords = numRecords;
     entry.dataSize = dataSize;
-    entry.dirty = true;
+    partition.dirty.insert(std::move(uriKey));
 }
 
-void WiredTigerSizeStorer::loadFromCache(StringData uri,
+bool WiredTigerSizeStorer::loadFromCache(StringData uri,
                                          long long* numRecords,
                                          long long* dataSize) const {
     _checkMagic();
-    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-    Map::const_iterator it = _entries.find(uri.toString());
-    if (it == _entries.end()) {
+    const Partition& partition = _partitionFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    Map::const_iterator it = partition.entries.find(uri.toString());
+    if (it == partition.entries.end()) {
         *numRecords = 0;
         *dataSize = 0;
-        return;
+        return false;
     }
     *numRecords = it->second.numRecords;
     *dataSize = it->second.dataSize;
+    return true;
 }
 
 void WiredTigerSizeStorer::fillCache() {
     stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
     _checkMagic();
 
-    Map m;
+    std::array<Map, kNumPartitions> maps;
     {
         // Seek to beginning if needed.
         invariantWTOK(_cursor->reset(_cursor));
@@ -158,55 +189,56 @@ void WiredTigerSizeStorer::fillCache() {
 
             LOG(2) << "WiredTigerSizeStorer::loadFrom " << uriKey << " -> " << redact(data);
 
-            Entry& e = m[uriKey];
+            const size_t index = &_partitionFor(uriKey) - &_partitions[0];
+            Entry& e = maps[index][uriKey];
             e.numRecords = data["numRecords"].safeNumberLong();
             e.dataSize = data["dataSize"].safeNumberLong();
-            e.dirty = false;
             e.rs = NULL;
         }
     }
 
-    stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-    _entries.swap(m);
+    for (size_t i = 0; i < kNumPartitions; ++i) {
+        stdx::lock_guard<stdx::mutex> lk(_partitions[i].mutex);
+        _partitions[i].entries.swap(maps[i]);
+        _partitions[i].dirty.clear();
+    }
 }
 
 void WiredTigerSizeStorer::syncCache(bool syncToDisk) {
     stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
     _checkMagic();
 
-    Map myMap;
-    {
-        stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-        for (Map::iterator it = _entries.begin(); it != _entries.end(); ++it) {
-            std::string uriKey = it->first;
+    // Collect the entries which changed since the last sync. A record store which changes again
+    // after this point marks itself dirty for the next sync.
+    std::vector<std::pair<std::string, Entry>> changed;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        for (auto&& uriKey : partition.dirty) {
+            Map::iterator it = partition.entries.find(uriKey);
+            if (it == partition.entries.end())
+                continue;
+
             Entry& entry = it->second;
             if (entry.rs) {
-                if (entry.dataSize != entry.rs->dataSize(NULL)) {
-                    entry.dataSize = entry.rs->dataSize(NULL);
-                    entry.dirty = true;
-                }
-                if (entry.numRecords != entry.rs->numRecords(NULL)) {
-                    entry.numRecords = entry.rs->numRecords(NULL);
-                    entry.dirty = true;
-                }
+                entry.rs->onSizeStorerSync();
+                entry.dataSize = entry.rs->dataSize(NULL);
+                entry.numRecords = entry.rs->numRecords(NULL);
             }
-
-            if (!entry.dirty)
-                continue;
-            myMap[uriKey] = entry;
+            changed.emplace_back(uriKey, entry);
         }
+        partition.dirty.clear();
     }
 
-    if (myMap.empty())
+    if (changed.empty())
         return;  // Nothing to do.
 
     WT_SESSION* session = _session.getSession();
     invariantWTOK(session->begin_transaction(session, syncToDisk ? "sync=true" : ""));
     ScopeGuard rollbacker = MakeGuard(session->rollback_transaction, session, "");
 
-    for (Map::iterator it = myMap.begin(); it != myMap.end(); ++it) {
-        string uriKey = it->first;
-        Entry& entry = it->second;
+    for (auto&& change : changed) {
+        const string& uriKey = change.first;
+        const Entry& entry = change.second;
 
         BSONObj data;
         {
@@ -229,12 +261,5 @@ void WiredTigerSizeStorer::syncCache(bool syncToDisk) {
 
     rollbacker.Dismiss();
     invariantWTOK(session->commit_transaction(session, NULL));
-
-    {
-        stdx::lock_guard<stdx::mutex> lk(_entriesMutex);
-        for (Map::iterator it = _entries.begin(); it != _entries.end(); ++it) {
-            it->second.dirty = false;
-        }
-    }
 }
 }
@@ -31,19 +31,26 @@
 
 #pragma once
 
-#include <map>
+#include <array>
 #include <string>
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
 class WiredTigerRecordStore;
 class WiredTigerSession;
 
+/**
+ * Caches the number of records and data size of every record store, and persists them to a
+ * table. Entries are spread over several independently locked partitions, and syncCache() only
+ * visits the entries which changed since the previous sync.
+ */
 class WiredTigerSizeStorer {
 public:
     WiredTigerSizeStorer(WT_CONNECTION* conn, const std::string& storageUri);
@@ -52,9 +59,18 @@ public:
     void onCreate(WiredTigerRecordStore* rs, long long nr, long long ds);
     void onDestroy(WiredTigerRecordStore* rs);
 
+    /**
+     * Records that the sizes of 'rs' have changed, so that the next syncCache() persists them.
+     * Called by a record store on its first change after each sync.
+     */
+    void markDirty(WiredTigerRecordStore* rs);
+
     void storeToCache(StringData uri, long long numRecords, long long dataSize);
 
-    void loadFromCache(StringData uri, long long* numRecords, long long* dataSize) const;
+    /**
+     * Returns false, and sets both sizes to 0, if there is no entry for 'uri'.
+     */
+    bool loadFromCache(StringData uri, long long* numRecords, long long* dataSize) const;
 
     /**
      * Loads from the underlying table.
@@ -70,22 +86,34 @@ private:
     void _checkMagic() const;
 
     struct Entry {
-        Entry() : numRecords(0), dataSize(0), dirty(false), rs(NULL) {}
+        Entry() : numRecords(0), dataSize(0), rs(NULL) {}
         long long numRecords;
         long long dataSize;
-        bool dirty;
         WiredTigerRecordStore* rs;  // not owned
     };
 
+    typedef stdx::unordered_map<std::string, Entry> Map;
+
+    struct Partition {
+        mutable stdx::mutex mutex;
+        Map entries;
+
+        // URIs of the entries which changed since the last sync.
+        stdx::unordered_set<std::string> dirty;
+    };
+
+    static const size_t kNumPartitions = 16;
+
+    Partition& _partitionFor(StringData uri);
+    const Partition& _partitionFor(StringData uri) const;
+
     int _magic;
 
-    // Guards _cursor. Acquire *before* _entriesMutex.
+    // Guards _cursor. Acquire *before* any partition mutex.
     mutable stdx::mutex _cursorMutex;
     const WiredTigerSession _session;
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    typedef std::map<std::string, Entry> Map;
-    Map _entries;
-    mutable stdx::mutex _entriesMutex;
+    std::array<Partition, kNumPartitions> _partitions;
 };
 }
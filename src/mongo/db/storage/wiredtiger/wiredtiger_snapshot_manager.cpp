@@ -60,6 +60,13 @@ void WiredTigerSnapshotManager::setCommittedSnapshot(const SnapshotName& name) {
     _committedSnapshot = name;
 }
 
+void WiredTigerSnapshotManager::setLocalSnapshot(const SnapshotName& name) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    invariant(!_localSnapshot || *_localSnapshot <= name);
+    _localSnapshot = name;
+}
+
 void WiredTigerSnapshotManager::cleanupUnneededSnapshots() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
 
@@ -74,6 +81,7 @@ void WiredTigerSnapshotManager::cleanupUnneededSnapshots() {
 void WiredTigerSnapshotManager::dropAllSnapshots() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _committedSnapshot = boost::none;
+    _localSnapshot = boost::none;
     invariantWTOK(_session->snapshot(_session, "drop=(all)"));
 }
 
@@ -106,4 +114,23 @@ SnapshotName WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
     return *_committedSnapshot;
 }
 
+boost::optional<SnapshotName> WiredTigerSnapshotManager::getMinSnapshotForNextLocalRead() const {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    return _localSnapshot;
+}
+
+SnapshotName WiredTigerSnapshotManager::beginTransactionOnLocalSnapshot(WT_SESSION* session) const {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    uassert(ErrorCodes::LocalSnapshotNotAvailable,
+            "Local snapshot disappeared while running operation",
+            _localSnapshot);
+
+    StringBuilder config;
+    config << "snapshot=" << _localSnapshot->asU64();
+    invariantWTOK(session->begin_transaction(session, config.str().c_str()));
+
+    return *_localSnapshot;
+}
+
 }  // namespace mongo
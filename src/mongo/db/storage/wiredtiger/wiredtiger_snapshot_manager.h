@@ -54,6 +54,7 @@ public:
     Status prepareForCreateSnapshot(OperationContext* opCtx) final;
     Status createSnapshot(OperationContext* ru, const SnapshotName& name) final;
     void setCommittedSnapshot(const SnapshotName& name) final;
+    void setLocalSnapshot(const SnapshotName& name) final;
     void cleanupUnneededSnapshots() final;
     void dropAllSnapshots() final;
 
@@ -83,9 +84,22 @@ public:
      */
     boost::optional<SnapshotName> getMinSnapshotForNextCommittedRead() const;
 
+    /**
+     * Starts a transaction on the local snapshot and returns the SnapshotName used.
+     *
+     * Throws if there is currently no local snapshot.
+     */
+    SnapshotName beginTransactionOnLocalSnapshot(WT_SESSION* session) const;
+
+    /**
+     * Like getMinSnapshotForNextCommittedRead(), but for beginTransactionOnLocalSnapshot.
+     */
+    boost::optional<SnapshotName> getMinSnapshotForNextLocalRead() const;
+
 private:
     mutable stdx::mutex _mutex;  // Guards all members.
     boost::optional<SnapshotName> _committedSnapshot;
+    boost::optional<SnapshotName> _localSnapshot;
     WT_SESSION* _session;  // only used for dropping snapshots.
 };
 }
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+constexpr double WiredTigerTicketController::kCacheFillPressureRatio;
+constexpr double WiredTigerTicketController::kCacheDirtyPressureRatio;
+constexpr double WiredTigerTicketController::kThroughputDropTolerance;
+
+WiredTigerTicketController::WiredTigerTicketController(int minTickets, int maxTickets)
+    : _minTickets(minTickets), _maxTickets(maxTickets) {
+    invariant(_minTickets > 0);
+    invariant(_minTickets <= _maxTickets);
+}
+
+int WiredTigerTicketController::update(const Sample& sample, int currentTickets) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    if (!_haveBaseline) {
+        _haveBaseline = true;
+        _last = sample;
+        _lastTickets = currentTickets;
+        _lastReason = "baseline";
+        return currentTickets;
+    }
+
+    const int64_t acquired = sample.totalAcquired - _last.totalAcquired;
+    const int64_t queuedMicros = sample.totalQueuedMicros - _last.totalQueuedMicros;
+    const int64_t appEvictions = sample.appEvictions - _last.appEvictions;
+    const int64_t elapsedMicros = std::max<int64_t>(1, sample.elapsedMicros);
+    _last = sample;
+
+    const double throughput = acquired * 1000000.0 / elapsedMicros;
+    const bool cachePressure = sample.cacheFillRatio >= kCacheFillPressureRatio ||
+        sample.cacheDirtyRatio >= kCacheDirtyPressureRatio || appEvictions > 0;
+
+    int target = currentTickets;
+    const char* reason;
+    if (cachePressure) {
+        // Fewer concurrent transactions means fewer pinned pages and less dirty data, giving
+        // eviction a chance to catch up.
+        target = currentTickets - std::max(1, currentTickets / 4);
+        reason = "cachePressure";
+        _probing = false;
+    } else if (_probing && throughput < _throughputBeforeProbe * (1 - kThroughputDropTolerance)) {
+        target = _ticketsBeforeProbe;
+        reason = "throughputDropped";
+        _probing = false;
+    } else if (sample.queued > 0) {
+        _probing = true;
+        _ticketsBeforeProbe = currentTickets;
+        _throughputBeforeProbe = throughput;
+        target = currentTickets + std::max(1, currentTickets / 8);
+        reason = "queueing";
+    } else {
+        reason = "steady";
+        _probing = false;
+    }
+
+    target = std::max(_minTickets, std::min(_maxTickets, target));
+    if (target == currentTickets) {
+        _probing = false;
+    }
+
+    ++_decisions;
+    _lastTickets = target;
+    _lastReason = reason;
+    _lastThroughput = throughput;
+    _lastQueued = sample.queued;
+    _lastAvgQueuedMicros = acquired > 0 ? static_cast<double>(queuedMicros) / acquired : 0;
+    _lastCacheFillRatio = sample.cacheFillRatio;
+    _lastCacheDirtyRatio = sample.cacheDirtyRatio;
+
+    return target;
+}
+
+void WiredTigerTicketController::reset() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _haveBaseline = false;
+    _probing = false;
+}
+
+void WiredTigerTicketController::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    builder->append("minTickets", _minTickets);
+    builder->append("maxTickets", _maxTickets);
+    builder->append("decisions", static_cast<long long>(_decisions));
+    builder->append("lastTickets", _lastTickets);
+    builder->append("lastReason", _lastReason);
+    builder->append("lastThroughput", _lastThroughput);
+    builder->append("lastQueued", _lastQueued);
+    builder->append("lastAvgQueuedMicros", _lastAvgQueuedMicros);
+    builder->append("lastCacheFillRatio", _lastCacheFillRatio);
+    builder->append("lastCacheDirtyRatio", _lastCacheDirtyRatio);
+}
+
+}  // namespace mongo
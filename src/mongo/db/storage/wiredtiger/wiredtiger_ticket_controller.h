@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Decides how many tickets a TicketHolder guarding WiredTiger transactions should hand out.
+ *
+ * The controller is fed one Sample per adjustment interval and performs a simple hill-climb:
+ * while operations are queueing for tickets it grows the ticket count additively, keeping the
+ * change only if throughput did not get worse; when the WiredTiger cache shows eviction pressure
+ * it backs off multiplicatively. The ticket count always stays within [minTickets, maxTickets].
+ *
+ * This class only makes decisions; applying them to a TicketHolder is up to the caller.
+ */
+class WiredTigerTicketController {
+    MONGO_DISALLOW_COPYING(WiredTigerTicketController);
+
+public:
+    /**
+     * A snapshot of cumulative counters. Deltas are computed between consecutive samples.
+     */
+    struct Sample {
+        int64_t elapsedMicros = 0;      // time since the previous sample
+        int64_t totalAcquired = 0;      // TicketHolder::totalAcquired()
+        int64_t totalQueuedMicros = 0;  // TicketHolder::totalQueuedMicros()
+        int queued = 0;                 // TicketHolder::queued()
+        double cacheFillRatio = 0;      // bytes in cache / maximum cache bytes
+        double cacheDirtyRatio = 0;     // dirty bytes in cache / maximum cache bytes
+        int64_t appEvictions = 0;       // pages evicted by application threads
+    };
+
+    // Cache usage above which the controller treats the cache as under pressure. These mirror
+    // WiredTiger's default eviction_trigger and eviction_dirty_trigger settings.
+    static constexpr double kCacheFillPressureRatio = 0.95;
+    static constexpr double kCacheDirtyPressureRatio = 0.20;
+
+    // A grow is reverted if throughput falls by more than this fraction afterwards.
+    static constexpr double kThroughputDropTolerance = 0.05;
+
+    WiredTigerTicketController(int minTickets, int maxTickets);
+
+    /**
+     * Records 'sample' and returns the number of tickets that should be in use, given that
+     * 'currentTickets' are configured now. The first sample only establishes a baseline.
+     */
+    int update(const Sample& sample, int currentTickets);
+
+    /**
+     * Discards the baseline, so that the next call to update() establishes a new one.
+     */
+    void reset();
+
+    /**
+     * Appends the controller's most recent decision and the measurements behind it.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    const int _minTickets;
+    const int _maxTickets;
+
+    mutable stdx::mutex _mutex;
+
+    bool _haveBaseline = false;
+    Sample _last;
+
+    // Set after a grow, so the next interval can tell whether the grow paid off.
+    bool _probing = false;
+    int _ticketsBeforeProbe = 0;
+    double _throughputBeforeProbe = 0;
+
+    // The most recent decision, for serverStatus.
+    int64_t _decisions = 0;
+    int _lastTickets = 0;
+    std::string _lastReason = "none";
+    double _lastThroughput = 0;
+    int _lastQueued = 0;
+    double _lastAvgQueuedMicros = 0;
+    double _lastCacheFillRatio = 0;
+    double _lastCacheDirtyRatio = 0;
+};
+
+}  // namespace mongo
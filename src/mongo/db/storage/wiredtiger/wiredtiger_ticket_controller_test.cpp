@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Sample = WiredTigerTicketController::Sample;
+
+// Returns a sample one second after 'prev' in which 'acquired' more tickets were handed out.
+Sample next(const Sample& prev, int64_t acquired, int queued) {
+    Sample s = prev;
+    s.elapsedMicros = 1000 * 1000;
+    s.totalAcquired += acquired;
+    s.totalQueuedMicros += queued * 100;
+    s.queued = queued;
+    return s;
+}
+
+TEST(WiredTigerTicketControllerTest, FirstSampleIsBaseline) {
+    WiredTigerTicketController controller(5, 256);
+    ASSERT_EQ(128, controller.update(next(Sample(), 1000, 10), 128));
+}
+
+TEST(WiredTigerTicketControllerTest, SteadyWithoutQueueing) {
+    WiredTigerTicketController controller(5, 256);
+    Sample s;
+    controller.update(s, 128);
+    s = next(s, 1000, 0);
+    ASSERT_EQ(128, controller.update(s, 128));
+}
+
+TEST(WiredTigerTicketControllerTest, GrowsWhileQueueingAndThroughputHolds) {
+    WiredTigerTicketController controller(5, 256);
+    Sample s;
+    controller.update(s, 128);
+    s = next(s, 1000, 10);
+    ASSERT_EQ(144, controller.update(s, 128));
+    s = next(s, 1100, 10);
+    ASSERT_EQ(162, controller.update(s, 144));
+}
+
+TEST(WiredTigerTicketControllerTest, RevertsGrowWhenThroughputDrops) {
+    WiredTigerTicketController controller(5, 256);
+    Sample s;
+    controller.update(s, 128);
+    s = next(s, 1000, 10);
+    ASSERT_EQ(144, controller.update(s, 128));
+    s = next(s, 800, 10);
+    ASSERT_EQ(128, controller.update(s, 144));
+}
+
+TEST(WiredTigerTicketControllerTest, ShrinksUnderCachePressure) {
+    WiredTigerTicketController controller(5, 256);
+    Sample s;
+    controller.update(s, 128);
+
+    s = next(s, 1000, 10);
+    s.cacheDirtyRatio = 0.25;
+    ASSERT_EQ(96, controller.update(s, 128));
+
+    s = next(s, 1000, 10);
+    s.cacheDirtyRatio = 0;
+    s.appEvictions += 50;
+    ASSERT_EQ(72, controller.update(s, 96));
+}
+
+TEST(WiredTigerTicketControllerTest, StaysWithinBounds) {
+    WiredTigerTicketController controller(5, 130);
+    Sample s;
+    controller.update(s, 128);
+    s = next(s, 1000, 10);
+    ASSERT_EQ(130, controller.update(s, 128));
+
+    s = next(s, 1000, 10);
+    s.cacheFillRatio = 0.99;
+    ASSERT_EQ(5, controller.update(s, 6));
+}
+
+TEST(WiredTigerTicketControllerTest, AppendStats) {
+    WiredTigerTicketController controller(5, 256);
+    Sample s;
+    controller.update(s, 128);
+    controller.update(next(s, 1000, 10), 128);
+
+    BSONObjBuilder builder;
+    controller.appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQ(1, stats["decisions"].numberLong());
+    ASSERT_EQ(144, stats["lastTickets"].numberInt());
+    ASSERT_EQ("queueing", stats["lastReason"].str());
+    ASSERT_EQ(10, stats["lastQueued"].numberInt());
+    ASSERT_EQ(1000.0, stats["lastThroughput"].numberDouble());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -331,6 +331,29 @@ int64_t WiredTigerUtil::getIdentSize(WT_SESSION* s, const std::string& uri) {
     return result.getValue();
 }
 
+StatusWith<bool> WiredTigerUtil::compactIncrementally(OperationContext* opCtx,
+                                                      const std::string& uri,
+                                                      Seconds timeLimit) {
+    WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    if (cache->isEphemeral()) {
+        return true;
+    }
+
+    // A timeout of 0 means no timeout to WiredTiger.
+    const long long timeoutSecs = std::max<long long>(durationCount<Seconds>(timeLimit), 1);
+    const std::string config = str::stream() << "timeout=" << timeoutSecs;
+    UniqueWiredTigerSession session = cache->getSession();
+    WT_SESSION* s = session->getSession();
+    int ret = s->compact(s, uri.c_str(), config.c_str());
+    if (ret == ETIMEDOUT || ret == EBUSY) {
+        return false;
+    }
+    if (ret != 0) {
+        return wtRCToStatus(ret);
+    }
+    return true;
+}
+
 size_t WiredTigerUtil::getCacheSizeMB(double requestedCacheSizeGB) {
     double cacheSizeMB;
     const double kMaxSizeCacheMB = 10 * 1000 * 1000;
@@ -38,6 +38,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -175,6 +176,15 @@ public:
 
     static int64_t getIdentSize(WT_SESSION* s, const std::string& uri);
 
+    /**
+     * Compacts the table 'uri' for at most 'timeLimit' and returns whether the compaction is
+     * complete. A compaction that times out or conflicts with a checkpoint keeps the space it
+     * reclaimed so far and is continued by the next call.
+     */
+    static StatusWith<bool> compactIncrementally(OperationContext* opCtx,
+                                                 const std::string& uri,
+                                                 Seconds timeLimit);
+
 
     /**
      * Return amount of memory to use for the WiredTiger cache based on either the startup
@@ -30,11 +30,25 @@
 
 #include "mongo/db/time_proof_service.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/base/status.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/logical_time.h"
 #include "mongo/platform/random.h"
 
 namespace mongo {
+namespace {
+
+Counter64 proofCacheHits;
+Counter64 proofCacheMisses;
+
+ServerStatusMetricField<Counter64> displayProofCacheHits("timeProofCache.hits", &proofCacheHits);
+ServerStatusMetricField<Counter64> displayProofCacheMisses("timeProofCache.misses",
+                                                           &proofCacheMisses);
+
+}  // namespace
+
+const uint64_t TimeProofService::kRangeMask;
 
 TimeProofService::Key TimeProofService::generateRandomKey() {
     // SecureRandom only produces 64-bit numbers, so 3 is the minimum for 20 random bytes.
@@ -49,9 +63,26 @@ TimeProofService::Key TimeProofService::generateRandomKey() {
 }
 
 TimeProofService::TimeProof TimeProofService::getProof(const LogicalTime& time) const {
-    auto unsignedTimeArray = time.toUnsignedArray();
-    return SHA1Block::computeHmac(
+    const LogicalTime timeCeiling(Timestamp(time.asTimestamp().asULL() | kRangeMask));
+    {
+        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+        if (_cache && _cache->time == timeCeiling) {
+            proofCacheHits.increment();
+            return _cache->proof;
+        }
+    }
+    proofCacheMisses.increment();
+
+    auto unsignedTimeArray = timeCeiling.toUnsignedArray();
+    auto proof = SHA1Block::computeHmac(
         _key.data(), _key.size(), unsignedTimeArray.data(), unsignedTimeArray.size());
+
+    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+    // Keep the latest range, so that an old time being checked does not evict the current one.
+    if (!_cache || _cache->time < timeCeiling) {
+        _cache.emplace(proof, timeCeiling);
+    }
+    return proof;
 }
 
 Status TimeProofService::checkProof(const LogicalTime& time, const TimeProof& proof) const {
@@ -28,9 +28,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/db/logical_time.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
@@ -39,13 +43,22 @@ namespace mongo {
  *
  * The TimeProofService holds the key used by mongod and mongos processes to verify logical times
  * and contains the logic to generate this key, but not to store or retrieve it.
+ *
+ * A proof covers a range of times: it signs the time with the bits of kRangeMask set, so every
+ * time sharing the other bits has the same proof. The most recent proof is cached, which lets
+ * the many requests and responses carrying a slowly advancing cluster time skip the HMAC.
  */
 class TimeProofService {
+    MONGO_DISALLOW_COPYING(TimeProofService);
+
 public:
     // This type must be synchronized with the library that generates SHA1 or other proof.
     using TimeProof = SHA1Block;
     using Key = SHA1Block;
 
+    // Bits of a time's Timestamp that are ignored when signing it.
+    static const uint64_t kRangeMask = 0xFFFF;
+
     TimeProofService(Key key) : _key(std::move(key)) {}
 
     /**
@@ -64,7 +77,18 @@ public:
     Status checkProof(const LogicalTime& time, const TimeProof& proof) const;
 
 private:
+    struct CacheEntry {
+        CacheEntry(TimeProof proof, LogicalTime time) : proof(std::move(proof)), time(time) {}
+
+        TimeProof proof;
+        LogicalTime time;  // The upper bound of the range signed by 'proof'.
+    };
+
     Key _key;
+
+    // Protects _cache.
+    mutable stdx::mutex _cacheMutex;
+    mutable boost::optional<CacheEntry> _cache;
 };
 
 }  // namespace mongo
@@ -62,5 +62,26 @@ TEST(TimeProofService, LogicalTimeWithMismatchingProofShouldFail) {
     ASSERT_EQUALS(ErrorCodes::TimeProofMismatch, timeProofService.checkProof(time, invalidProof));
 }
 
+// Times within the same range share a proof, and a proof does not verify times in other ranges.
+TEST(TimeProofService, ProofCoversRangeOfTimes) {
+    std::array<std::uint8_t, 20> tempKey = {};
+    TimeProofService::Key key(std::move(tempKey));
+    TimeProofService timeProofService(std::move(key));
+
+    LogicalTime time(Timestamp(10, 1));
+    TimeProof proof = timeProofService.getProof(time);
+
+    LogicalTime sameRangeTime(Timestamp(10, 2));
+    ASSERT_TRUE(proof == timeProofService.getProof(sameRangeTime));
+    ASSERT_OK(timeProofService.checkProof(sameRangeTime, proof));
+
+    LogicalTime nextRangeTime(Timestamp(10, TimeProofService::kRangeMask + 1));
+    ASSERT_EQUALS(ErrorCodes::TimeProofMismatch,
+                  timeProofService.checkProof(nextRangeTime, proof));
+
+    // Checking an older time again still works after a newer range was signed.
+    ASSERT_OK(timeProofService.checkProof(time, proof));
+}
+
 }  // unnamed namespace
 }  // namespace mongo
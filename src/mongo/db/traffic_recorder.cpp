@@ -0,0 +1,370 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/traffic_recorder.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <deque>
+#include <fstream>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getTrafficRecorder = ServiceContext::declareDecoration<TrafficRecorder>();
+
+}  // namespace
+
+class TrafficRecorder::Recording {
+    MONGO_DISALLOW_COPYING(Recording);
+
+public:
+    explicit Recording(const Options& options) : _options(options) {}
+
+    /**
+     * Creates the file and starts the writer thread.
+     */
+    Status open() {
+        if (boost::filesystem::exists(_options.filename)) {
+            return {ErrorCodes::FileAlreadyOpen,
+                    str::stream() << "Traffic recording file " << _options.filename
+                                  << " already exists"};
+        }
+
+        _out.open(_options.filename, std::ios_base::out | std::ios_base::binary);
+        if (!_out.is_open()) {
+            return {ErrorCodes::FileOpenFailed,
+                    str::stream() << "Unable to create traffic recording file "
+                                  << _options.filename};
+        }
+
+        _startDate = Date_t::now();
+        _timer.reset();
+        _thread = stdx::thread([this] { _writeLoop(); });
+        return Status::OK();
+    }
+
+    /**
+     * Queues a message for the writer. Returns false once the recording has stopped by itself, in
+     * which case there is no use in offering it more messages.
+     */
+    bool push(const transport::SessionHandle& session, const Message& message) {
+        // Take the time before the lock so that waiting on it does not skew the recorded timings.
+        const long long offsetMicros = _timer.micros();
+        const Date_t now = Date_t::now();
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_inShutdown || !_writerStatus.isOK()) {
+            return false;
+        }
+
+        const long long order = _nextOrder++;
+        if (_queuedBytes + message.size() > _options.maxBufferedBytes) {
+            ++_droppedMessages;
+            return true;
+        }
+
+        // The message is not copied: its buffer is shared with the queue until it is written out.
+        _queue.push_back({order, session->id(), session->remote(), offsetMicros, now, message});
+        _queuedBytes += message.size();
+        _queuedCondvar.notify_one();
+        return true;
+    }
+
+    /**
+     * Waits for the queued messages to be written out and closes the file.
+     */
+    void shutdown() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _inShutdown = true;
+            _queuedCondvar.notify_one();
+        }
+
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    const std::string& filename() const {
+        return _options.filename;
+    }
+
+    void appendStats(BSONObjBuilder* builder) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        builder->append("running", !_inShutdown && _writerStatus.isOK());
+        builder->append("filename", _options.filename);
+        builder->append("startTime", _startDate);
+        builder->append("maxFileSizeBytes", _options.maxFileSizeBytes);
+        builder->append("messagesReceived", _nextOrder);
+        builder->append("messagesRecorded", _recordedMessages);
+        builder->append("messagesDropped", _droppedMessages);
+        builder->append("bytesWritten", _bytesWritten);
+        builder->append("bufferedBytes", _queuedBytes);
+        if (!_writerStatus.isOK()) {
+            builder->append("stoppedReason", _writerStatus.reason());
+        }
+    }
+
+private:
+    struct Entry {
+        long long order;
+        transport::SessionId session;
+        HostAndPort remote;
+        long long offsetMicros;
+        Date_t date;
+        Message message;
+    };
+
+    void _writeLoop() {
+        std::deque<Entry> entries;
+
+        while (true) {
+            {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                _queuedCondvar.wait(lk, [&] { return _inShutdown || !_queue.empty(); });
+
+                if (_queue.empty()) {
+                    break;
+                }
+
+                entries.swap(_queue);
+                _queuedBytes = 0;
+            }
+
+            Status status = _write(entries);
+            entries.clear();
+
+            if (!status.isOK()) {
+                log() << "Stopping traffic recording to " << _options.filename << ": " << status;
+
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                _writerStatus = std::move(status);
+                _queue.clear();
+                _queuedBytes = 0;
+                break;
+            }
+        }
+
+        _out.close();
+    }
+
+    /**
+     * Appends 'entries' to the file. Fails once the file is full or cannot be written to.
+     */
+    Status _write(const std::deque<Entry>& entries) {
+        long long written = 0;
+        long long recorded = 0;
+        Status status = Status::OK();
+
+        for (const auto& entry : entries) {
+            BSONObjBuilder builder;
+            builder.append("order", entry.order);
+            builder.append("session", static_cast<long long>(entry.session));
+            builder.append("remote", entry.remote.toString());
+            builder.append("offsetMicros", entry.offsetMicros);
+            builder.append("ts", entry.date);
+            builder.appendBinData(
+                "message", entry.message.size(), BinDataGeneral, entry.message.buf());
+            BSONObj obj = builder.done();
+
+            if (_bytesWritten + written + obj.objsize() > _options.maxFileSizeBytes) {
+                status = {ErrorCodes::ExceededMemoryLimit,
+                          str::stream() << "The recording reached its maximum size of "
+                                        << _options.maxFileSizeBytes
+                                        << " bytes"};
+                break;
+            }
+
+            _out.write(obj.objdata(), obj.objsize());
+            if (!_out) {
+                status = {ErrorCodes::FileStreamFailed,
+                          str::stream() << "Failed to write to traffic recording file "
+                                        << _options.filename};
+                break;
+            }
+
+            written += obj.objsize();
+            ++recorded;
+        }
+
+        if (status.isOK()) {
+            _out.flush();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _bytesWritten += written;
+        _recordedMessages += recorded;
+        return status;
+    }
+
+    const Options _options;
+
+    Date_t _startDate;
+    Timer _timer;
+
+    // Only used by the writer thread once it is started.
+    std::ofstream _out;
+
+    stdx::thread _thread;
+
+    // Guards all of the state below
+    stdx::mutex _mutex;
+
+    // Signalled when a message is queued or shutdown() is called
+    stdx::condition_variable _queuedCondvar;
+
+    std::deque<Entry> _queue;
+    long long _queuedBytes = 0;
+
+    bool _inShutdown = false;
+
+    // Set by the writer when it stops by itself
+    Status _writerStatus = Status::OK();
+
+    long long _nextOrder = 0;
+    long long _recordedMessages = 0;
+    long long _droppedMessages = 0;
+    long long _bytesWritten = 0;
+};
+
+TrafficRecorder& TrafficRecorder::get(ServiceContext* serviceContext) {
+    return getTrafficRecorder(serviceContext);
+}
+
+TrafficRecorder::TrafficRecorder() = default;
+
+TrafficRecorder::~TrafficRecorder() {
+    if (_running) {
+        _recording->shutdown();
+    }
+}
+
+Status TrafficRecorder::start(const Options& options) {
+    if (options.filename.empty()) {
+        return {ErrorCodes::BadValue, "A traffic recording needs a file name"};
+    }
+
+    if (options.maxFileSizeBytes <= 0 || options.maxBufferedBytes <= 0) {
+        return {ErrorCodes::BadValue, "The sizes of a traffic recording must be positive"};
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_running) {
+        return {ErrorCodes::IllegalOperation, "Traffic recording is already in progress"};
+    }
+
+    auto recording = std::make_shared<Recording>(options);
+    Status status = recording->open();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    log() << "Started traffic recording to " << options.filename;
+
+    _recording = std::move(recording);
+    _running = true;
+    _shouldRecord.store(true);
+    return Status::OK();
+}
+
+Status TrafficRecorder::stop(BSONObjBuilder* builder) {
+    std::shared_ptr<Recording> recording;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (!_running) {
+            return {ErrorCodes::IllegalOperation, "Traffic recording is not in progress"};
+        }
+
+        _shouldRecord.store(false);
+        _running = false;
+        recording = _recording;
+    }
+
+    // Messages being observed concurrently may still be handed to the recording until it is shut
+    // down, so that it is only safe to read its statistics afterwards.
+    recording->shutdown();
+    recording->appendStats(builder);
+
+    log() << "Stopped traffic recording to " << recording->filename();
+    return Status::OK();
+}
+
+void TrafficRecorder::appendStats(BSONObjBuilder* builder) {
+    std::shared_ptr<Recording> recording;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        recording = _recording;
+    }
+
+    if (!recording) {
+        builder->append("running", false);
+        return;
+    }
+
+    recording->appendStats(builder);
+}
+
+void TrafficRecorder::observe(const transport::SessionHandle& session, const Message& message) {
+    if (!_shouldRecord.load()) {
+        return;
+    }
+
+    std::shared_ptr<Recording> recording;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        recording = _recording;
+    }
+
+    if (recording && !recording->push(session, message)) {
+        // The recording stopped by itself. It stays around until stop() is called so that its
+        // statistics, including why it stopped, can still be read. A recording which was stopped
+        // and replaced in the meantime must not turn off the new one.
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_recording == recording) {
+            _shouldRecord.store(false);
+        }
+    }
+}
+
+}  // namespace mongo
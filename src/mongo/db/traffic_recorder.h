@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/transport/session.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class Message;
+class ServiceContext;
+
+/**
+ * Records the messages received from clients, with the time they arrived and the connection they
+ * arrived on, so that the workload can later be replayed against another deployment by the
+ * mongotrafficreplay tool.
+ *
+ * The recording is a file of concatenated BSON documents, one per message, of the form:
+ *
+ * {
+ *     order: <number of the message in the recording, from 0>,
+ *     session: <id of the session the message was received on>,
+ *     remote: <"host:port" of the client>,
+ *     offsetMicros: <microseconds since the recording was started>,
+ *     ts: <date the message was received>,
+ *     message: <BinData of the whole message, header included>
+ * }
+ *
+ * Messages are queued in memory and written out by a separate thread, so that recording adds little
+ * more than a reference to the message's buffer to the time spent receiving it. If the writer
+ * falls behind, messages which would grow the queue over its limit are dropped and counted rather
+ * than slowing down the server. Recording stops by itself once the file reaches its maximum size.
+ */
+class TrafficRecorder {
+    MONGO_DISALLOW_COPYING(TrafficRecorder);
+
+public:
+    struct Options {
+        // Path of the file to write the recording to. It must not already exist.
+        std::string filename;
+
+        // Size at which the file is closed and recording stops.
+        long long maxFileSizeBytes = 1024LL * 1024 * 1024;
+
+        // Total size of the messages which may be queued for the writer at any time.
+        long long maxBufferedBytes = 64LL * 1024 * 1024;
+    };
+
+    static TrafficRecorder& get(ServiceContext* serviceContext);
+
+    TrafficRecorder();
+    ~TrafficRecorder();
+
+    /**
+     * Starts recording to a new file. Fails if the last recording started was not stopped yet or
+     * the file cannot be created.
+     */
+    Status start(const Options& options);
+
+    /**
+     * Stops the recording started last, even if it already stopped writing by itself, waits for
+     * the queued messages to be written out, and appends its statistics to 'builder'.
+     */
+    Status stop(BSONObjBuilder* builder);
+
+    /**
+     * Appends the state and statistics of the recording in progress or the last one stopped.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
+    /**
+     * Records a message received on 'session' if a recording is in progress. Cheap when none is.
+     */
+    void observe(const transport::SessionHandle& session, const Message& message);
+
+private:
+    class Recording;
+
+    // Set while a recording is in progress, so that observe() does not take _mutex otherwise.
+    AtomicBool _shouldRecord{false};
+
+    stdx::mutex _mutex;
+
+    // The recording in progress, or the last one stopped.
+    std::shared_ptr<Recording> _recording;
+
+    // Whether _recording was started and not yet stopped, even if it stopped writing by itself.
+    bool _running = false;
+};
+
+}  // namespace mongo
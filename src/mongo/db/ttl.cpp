@@ -34,6 +34,8 @@
 
 #include "mongo/db/ttl.h"
 
+#include <algorithm>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -45,8 +47,10 @@
 #include "mongo/db/commands/fsync.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/delete.h"
+#include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
@@ -56,6 +60,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 
@@ -71,6 +76,17 @@ ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocume
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorEnabled, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60);  // used for testing
 
+// The number of collections a pass processes at the same time.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorWorkerThreads, int, 1);
+
+// The most expired documents deleted in one WriteUnitOfWork. A value of 0 or less deletes each
+// document in its own WriteUnitOfWork through a delete plan instead.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorDeleteBatchSize, int, 100);
+
+// If positive, a batch of deletes is only started once the majority commit point trails the last
+// operation applied on this node by no more than this many seconds.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxReplicationLagSecs, int, 0);
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -113,9 +129,6 @@ public:
 
 private:
     void doTTLPass() {
-        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
-        OperationContext& opCtx = *opCtxPtr;
-
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::getGlobalReplicationCoordinator()->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
@@ -124,34 +137,80 @@ private:
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::string> ttlCollections = ttlCollectionCache.getCollections();
-        std::vector<BSONObj> ttlIndexes;
+
+        // The TTL indexes of each collection.
+        std::vector<std::vector<BSONObj>> ttlIndexes;
 
         ttlPasses.increment();
 
         // Get all TTL indexes from every collection.
-        for (const std::string& collectionNS : ttlCollections) {
-            NamespaceString collectionNSS(collectionNS);
-            AutoGetCollection autoGetCollection(&opCtx, collectionNSS, MODE_IS);
-            Collection* coll = autoGetCollection.getCollection();
-            if (!coll) {
-                // Skip since collection has been dropped.
-                continue;
-            }
+        {
+            const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+            OperationContext& opCtx = *opCtxPtr;
+
+            for (const std::string& collectionNS : ttlCollections) {
+                NamespaceString collectionNSS(collectionNS);
+                AutoGetCollection autoGetCollection(&opCtx, collectionNSS, MODE_IS);
+                Collection* coll = autoGetCollection.getCollection();
+                if (!coll) {
+                    // Skip since collection has been dropped.
+                    continue;
+                }
 
-            CollectionCatalogEntry* collEntry = coll->getCatalogEntry();
-            std::vector<std::string> indexNames;
-            collEntry->getAllIndexes(&opCtx, &indexNames);
-            for (const std::string& name : indexNames) {
-                BSONObj spec = collEntry->getIndexSpec(&opCtx, name);
-                if (spec.hasField(secondsExpireField)) {
-                    ttlIndexes.push_back(spec.getOwned());
+                CollectionCatalogEntry* collEntry = coll->getCatalogEntry();
+                std::vector<std::string> indexNames;
+                collEntry->getAllIndexes(&opCtx, &indexNames);
+                std::vector<BSONObj> collIndexes;
+                for (const std::string& name : indexNames) {
+                    BSONObj spec = collEntry->getIndexSpec(&opCtx, name);
+                    if (spec.hasField(secondsExpireField)) {
+                        collIndexes.push_back(spec.getOwned());
+                    }
+                }
+                if (!collIndexes.empty()) {
+                    ttlIndexes.push_back(std::move(collIndexes));
                 }
             }
         }
 
-        for (const BSONObj& idx : ttlIndexes) {
+        const int numWorkers = ttlMonitorWorkerThreads.load();
+        if (numWorkers <= 1 || ttlIndexes.size() <= 1) {
+            const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+            for (const auto& collIndexes : ttlIndexes) {
+                doTTLForCollection(opCtx.get(), collIndexes);
+            }
+            return;
+        }
+
+        // The collections are handed out to the workers whole, so that the indexes of a collection
+        // never compete for its documents.
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorWorkers";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(numWorkers);
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+            AuthorizationSession::get(cc())->grantInternalAuthorization();
+        };
+        ThreadPool pool(std::move(options));
+        pool.startup();
+        for (const auto& collIndexes : ttlIndexes) {
+            auto task = [this, &collIndexes] {
+                const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+                doTTLForCollection(opCtx.get(), collIndexes);
+            };
+            if (!pool.schedule(task).isOK()) {
+                task();
+            }
+        }
+        pool.shutdown();
+        pool.join();
+    }
+
+    void doTTLForCollection(OperationContext* opCtx, const std::vector<BSONObj>& indexes) {
+        for (const BSONObj& idx : indexes) {
             try {
-                doTTLForIndex(&opCtx, idx);
+                doTTLForIndex(opCtx, idx);
             } catch (const DBException& dbex) {
                 error() << "Error processing ttl index: " << idx << " -- " << dbex.toString();
                 // Continue on to the next index.
@@ -181,67 +240,127 @@ private:
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
 
-        AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
-        Collection* collection = autoGetCollection.getCollection();
-        if (!collection) {
-            // Collection was dropped.
-            return;
-        }
+        // Fixed by the first batch, so that documents expiring during the pass are left to the
+        // next one and the pass comes to an end.
+        boost::optional<Date_t> expirationTime;
+        long long numDeleted = 0;
+        while (true) {
+            opCtx->checkForInterrupt();
+
+            long long numDeletedInBatch = 0;
+            {
+                AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
+                Collection* collection = autoGetCollection.getCollection();
+                if (!collection) {
+                    // Collection was dropped.
+                    break;
+                }
 
-        if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
-        }
+                if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(opCtx,
+                                                                                 collectionNSS)) {
+                    break;
+                }
 
-        IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
-        if (!desc) {
-            LOG(1) << "index not found (index build in progress? index dropped?), skipping "
-                   << "ttl job for: " << idx;
-            return;
-        }
+                IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
+                if (!desc) {
+                    LOG(1) << "index not found (index build in progress? index dropped?), skipping "
+                           << "ttl job for: " << idx;
+                    break;
+                }
 
-        // Re-read 'idx' from the descriptor, in case the collection or index definition changed
-        // before we re-acquired the collection lock.
-        idx = desc->infoObj();
+                // Re-read 'idx' from the descriptor, in case the collection or index definition
+                // changed before we re-acquired the collection lock.
+                idx = desc->infoObj();
 
-        if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
-            error() << "special index can't be used as a ttl index, skipping ttl job for: " << idx;
-            return;
-        }
+                if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
+                    error() << "special index can't be used as a ttl index, skipping ttl job for: "
+                            << idx;
+                    break;
+                }
 
-        BSONElement secondsExpireElt = idx[secondsExpireField];
-        if (!secondsExpireElt.isNumber()) {
-            error() << "ttl indexes require the " << secondsExpireField << " field to be "
-                    << "numeric but received a type of " << typeName(secondsExpireElt.type())
-                    << ", skipping ttl job for: " << idx;
-            return;
+                BSONElement secondsExpireElt = idx[secondsExpireField];
+                if (!secondsExpireElt.isNumber()) {
+                    error() << "ttl indexes require the " << secondsExpireField << " field to be "
+                            << "numeric but received a type of "
+                            << typeName(secondsExpireElt.type()) << ", skipping ttl job for: "
+                            << idx;
+                    break;
+                }
+
+                if (!expirationTime) {
+                    expirationTime = Date_t::now() - Seconds(secondsExpireElt.numberLong());
+                }
+
+                const Date_t kDawnOfTime =
+                    Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
+                const BSONObj startKey = BSON("" << kDawnOfTime);
+                const BSONObj endKey = BSON("" << *expirationTime);
+                // The canonical check as to whether a key pattern element is "ascending" or
+                // "descending" is (elt.number() >= 0).  This is defined by the Ordering class.
+                const InternalPlanner::Direction direction = (key.firstElement().number() >= 0)
+                    ? InternalPlanner::Direction::FORWARD
+                    : InternalPlanner::Direction::BACKWARD;
+
+                // We need a CanonicalQuery with a BSONObj that queries for the expired documents
+                // correctly so that we do not delete documents that are not actually expired when
+                // our snapshot changes during deletion.
+                const char* keyFieldName = key.firstElement().fieldName();
+                BSONObj query = BSON(keyFieldName
+                                     << BSON("$gte" << kDawnOfTime << "$lte" << *expirationTime));
+                auto qr = stdx::make_unique<QueryRequest>(collectionNSS);
+                qr->setFilter(query);
+                auto canonicalQuery = CanonicalQuery::canonicalize(
+                    opCtx, std::move(qr), ExtensionsCallbackDisallowExtensions());
+                invariantOK(canonicalQuery.getStatus());
+
+                const long long batchSize = ttlMonitorDeleteBatchSize.load();
+                if (batchSize <= 0) {
+                    deleteExpiredWithPlan(opCtx,
+                                          collection,
+                                          desc,
+                                          startKey,
+                                          endKey,
+                                          direction,
+                                          canonicalQuery.getValue().get());
+                    return;
+                }
+
+                numDeletedInBatch = deleteExpiredBatch(opCtx,
+                                                       collection,
+                                                       desc,
+                                                       startKey,
+                                                       endKey,
+                                                       direction,
+                                                       canonicalQuery.getValue()->root(),
+                                                       batchSize);
+            }
+
+            ttlDeletedDocuments.increment(numDeletedInBatch);
+            numDeleted += numDeletedInBatch;
+            if (numDeletedInBatch == 0)
+                break;
+
+            // The locks are released between batches, so that other operations can get in.
+            waitForReplicationToCatchUp(opCtx);
         }
 
-        const Date_t kDawnOfTime =
-            Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
-        const Date_t expirationTime = Date_t::now() - Seconds(secondsExpireElt.numberLong());
-        const BSONObj startKey = BSON("" << kDawnOfTime);
-        const BSONObj endKey = BSON("" << expirationTime);
-        // The canonical check as to whether a key pattern element is "ascending" or
-        // "descending" is (elt.number() >= 0).  This is defined by the Ordering class.
-        const InternalPlanner::Direction direction = (key.firstElement().number() >= 0)
-            ? InternalPlanner::Direction::FORWARD
-            : InternalPlanner::Direction::BACKWARD;
-
-        // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
-        // queries for the expired documents correctly so that we do not delete documents that are
-        // not actually expired when our snapshot changes during deletion.
-        const char* keyFieldName = key.firstElement().fieldName();
-        BSONObj query =
-            BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationTime));
-        auto qr = stdx::make_unique<QueryRequest>(collectionNSS);
-        qr->setFilter(query);
-        auto canonicalQuery = CanonicalQuery::canonicalize(
-            opCtx, std::move(qr), ExtensionsCallbackDisallowExtensions());
-        invariantOK(canonicalQuery.getStatus());
+        LOG(1) << "deleted: " << numDeleted;
+    }
 
+    /**
+     * Deletes every document found through 'desc' between 'startKey' and 'endKey' which matches
+     * 'canonicalQuery', with a delete plan which yields as it goes.
+     */
+    void deleteExpiredWithPlan(OperationContext* opCtx,
+                               Collection* collection,
+                               IndexDescriptor* desc,
+                               const BSONObj& startKey,
+                               const BSONObj& endKey,
+                               InternalPlanner::Direction direction,
+                               CanonicalQuery* canonicalQuery) {
         DeleteStageParams params;
         params.isMulti = true;
-        params.canonicalQuery = canonicalQuery.getValue().get();
+        params.canonicalQuery = canonicalQuery;
 
         std::unique_ptr<PlanExecutor> exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -256,7 +375,7 @@ private:
 
         Status result = exec->executePlan();
         if (!result.isOK()) {
-            error() << "ttl query execution for index " << idx
+            error() << "ttl query execution for index " << desc->infoObj()
                     << " failed with status: " << redact(result);
             return;
         }
@@ -265,6 +384,93 @@ private:
         ttlDeletedDocuments.increment(numDeleted);
         LOG(1) << "deleted: " << numDeleted;
     }
+
+    /**
+     * Deletes up to 'batchSize' of the documents found through 'desc' between 'startKey' and
+     * 'endKey', in RecordId order and in a single WriteUnitOfWork. Each document is matched
+     * against 'expired' before it is deleted, as it may have changed since its key was read.
+     * Returns the number of documents deleted.
+     */
+    long long deleteExpiredBatch(OperationContext* opCtx,
+                                 Collection* collection,
+                                 IndexDescriptor* desc,
+                                 const BSONObj& startKey,
+                                 const BSONObj& endKey,
+                                 InternalPlanner::Direction direction,
+                                 const MatchExpression* expired,
+                                 long long batchSize) {
+        std::vector<RecordId> recordIds;
+        {
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   desc,
+                                                   startKey,
+                                                   endKey,
+                                                   BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                   PlanExecutor::YIELD_MANUAL,
+                                                   direction);
+            BSONObj obj;
+            RecordId recordId;
+            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+            while (static_cast<long long>(recordIds.size()) < batchSize &&
+                   PlanExecutor::ADVANCED == (state = exec->getNext(&obj, &recordId))) {
+                recordIds.push_back(recordId);
+            }
+            if (PlanExecutor::FAILURE == state || PlanExecutor::DEAD == state) {
+                uasserted(ErrorCodes::OperationFailed,
+                          str::stream() << "ttl index scan failed: "
+                                        << WorkingSetCommon::toStatusString(obj));
+            }
+        }
+
+        // A document can show up more than once in a multikey index.
+        std::sort(recordIds.begin(), recordIds.end());
+        recordIds.erase(std::unique(recordIds.begin(), recordIds.end()), recordIds.end());
+
+        long long numDeleted = 0;
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
+            numDeleted = 0;
+            WriteUnitOfWork wunit(opCtx);
+            for (const RecordId& recordId : recordIds) {
+                Snapshotted<BSONObj> doc;
+                if (!collection->findDoc(opCtx, recordId, &doc) ||
+                    !expired->matchesBSON(doc.value())) {
+                    continue;
+                }
+                collection->deleteDocument(opCtx, recordId, nullptr);
+                ++numDeleted;
+            }
+            wunit.commit();
+        }
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_END(opCtx, "ttl batch delete", collection->ns().ns());
+        return numDeleted;
+    }
+
+    /**
+     * Waits, holding no locks, until the majority commit point trails the last operation applied
+     * on this node by at most ttlMonitorMaxReplicationLagSecs, so that deleting expired documents
+     * doesn't make the secondaries fall further behind.
+     */
+    void waitForReplicationToCatchUp(OperationContext* opCtx) {
+        auto replCoord = repl::getGlobalReplicationCoordinator();
+        if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet)
+            return;
+
+        while (true) {
+            const int maxLagSecs = ttlMonitorMaxReplicationLagSecs.load();
+            if (maxLagSecs <= 0)
+                return;
+
+            const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+            const auto lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp();
+            if (lastApplied.getSecs() <= lastCommitted.getSecs() + maxLagSecs)
+                return;
+
+            LOG(2) << "waiting for the majority commit point to catch up, last applied: "
+                   << lastApplied.toString() << " last committed: " << lastCommitted.toString();
+            opCtx->sleepFor(Milliseconds(100));
+        }
+    }
 };
 
 namespace {
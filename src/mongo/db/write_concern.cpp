@@ -42,6 +42,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/rpc/protocol.h"
@@ -197,6 +198,7 @@ Status waitForWriteConcern(OperationContext* opCtx,
         case WriteConcernOptions::SyncMode::NONE:
             break;
         case WriteConcernOptions::SyncMode::FSYNC: {
+            WaitEventScope waitForFlush(WaitEvent::kJournal);
             StorageEngine* storageEngine = getGlobalServiceContext()->getGlobalStorageEngine();
             if (!storageEngine->isDurable()) {
                 result->fsyncFiles = storageEngine->flushAllFiles(opCtx, true);
@@ -206,7 +208,8 @@ Status waitForWriteConcern(OperationContext* opCtx,
             }
             break;
         }
-        case WriteConcernOptions::SyncMode::JOURNAL:
+        case WriteConcernOptions::SyncMode::JOURNAL: {
+            WaitEventScope waitForJournal(WaitEvent::kJournal);
             if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::Mode::modeNone) {
                 // Wait for ops to become durable then update replication system's
                 // knowledge of this.
@@ -217,6 +220,7 @@ Status waitForWriteConcern(OperationContext* opCtx,
                 opCtx->recoveryUnit()->waitUntilDurable();
             }
             break;
+        }
     }
 
     result->syncMillis = syncTimer.millis();
@@ -236,8 +240,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
-    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-        replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    repl::ReplicationCoordinator::StatusAndDuration replStatus = [&] {
+        WaitEventScope waitForReplication(WaitEvent::kReplication);
+        return replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    }();
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         result->err = "timeout";
@@ -20,10 +20,12 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/collection_info_cache.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/dbtests/dbtests.h"
@@ -174,12 +176,74 @@ private:
     Database* _db;
 };
 
+/**
+ * Test for the planner index entries cached by CollectionInfoCache.
+ */
+class PlannerIndexEntries {
+public:
+    PlannerIndexEntries() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        Lock::DBLock lk(&opCtx, nsToDatabaseSubstring(_ns), MODE_X);
+        OldClientContext ctx(&opCtx, _ns);
+        WriteUnitOfWork wuow(&opCtx);
+
+        _db = ctx.db();
+        _coll = _db->createCollection(&opCtx, _ns);
+        wuow.commit();
+    }
+
+    ~PlannerIndexEntries() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        Lock::DBLock lk(&opCtx, nsToDatabaseSubstring(_ns), MODE_X);
+        OldClientContext ctx(&opCtx, _ns);
+        WriteUnitOfWork wuow(&opCtx);
+
+        _db->dropCollection(&opCtx, _ns);
+        wuow.commit();
+    }
+
+    void run() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        OldClientWriteContext ctx(&opCtx, _ns);
+        CollectionInfoCache* infoCache = _coll->infoCache();
+
+        auto entries = infoCache->getIndexEntries(&opCtx);
+        ASSERT_EQUALS(1U, entries->size());
+
+        // The snapshot is shared until the indexes change.
+        ASSERT_EQUALS(entries, infoCache->getIndexEntries(&opCtx));
+        ASSERT_OK(dbtests::createIndex(&opCtx, _ns, BSON("x" << 1)));
+        auto withIndex = infoCache->getIndexEntries(&opCtx);
+        ASSERT_NOT_EQUALS(entries, withIndex);
+        ASSERT_EQUALS(2U, withIndex->size());
+        const IndexEntry& xEntry = withIndex->back();
+        ASSERT_EQUALS("x_1", xEntry.name);
+        ASSERT_FALSE(xEntry.multikey);
+
+        // Making the index multikey replaces the snapshot.
+        DBDirectClient client(&opCtx);
+        client.insert(_ns, BSON("x" << BSON_ARRAY(1 << 2)));
+        auto multikey = infoCache->getIndexEntries(&opCtx);
+        ASSERT_NOT_EQUALS(withIndex, multikey);
+        ASSERT_TRUE(multikey->back().multikey);
+        ASSERT_EQUALS(multikey, infoCache->getIndexEntries(&opCtx));
+    }
+
+private:
+    Collection* _coll;
+    Database* _db;
+};
+
 class IndexCatalogTests : public Suite {
 public:
     IndexCatalogTests() : Suite("indexcatalogtests") {}
     void setupTests() {
         add<IndexIteratorTests>();
         add<RefreshEntry>();
+        add<PlannerIndexEntries>();
     }
 };
 
@@ -269,6 +269,238 @@ public:
     }
 };
 
+/** Sets the number of threads foreground builds generate keys on, for as long as it lives. */
+class KeyGenerationThreadsSetter {
+public:
+    explicit KeyGenerationThreadsSetter(int numThreads)
+        : _oldNumThreads(internalIndexBuildKeyGenerationThreads.load()) {
+        internalIndexBuildKeyGenerationThreads.store(numThreads);
+    }
+    ~KeyGenerationThreadsSetter() {
+        internalIndexBuildKeyGenerationThreads.store(_oldNumThreads);
+    }
+
+private:
+    const int _oldNumThreads;
+};
+
+/** A foreground build generating keys on several threads indexes every document in order. */
+class InsertBuildParallelKeyGeneration : public IndexBuildBase {
+public:
+    void run() {
+        const int nDocs = 5000;
+
+        // Create a new collection.
+        Database* db = _ctx.db();
+        Collection* coll;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            db->dropCollection(&_opCtx, _ns);
+            coll = db->createCollection(&_opCtx, _ns);
+
+            OpDebug* const nullOpDebug = nullptr;
+            for (int i = 0; i < nDocs; ++i) {
+                ASSERT_OK(coll->insertDocument(
+                    &_opCtx,
+                    BSON("_id" << i << "a" << (i * 7919) % nDocs << "b" << BSON_ARRAY(i << -i)),
+                    nullOpDebug,
+                    true));
+            }
+            wunit.commit();
+        }
+
+        KeyGenerationThreadsSetter setter(4);
+
+        MultiIndexBlock indexer(&_opCtx, coll);
+        const std::vector<BSONObj> specs = {makeSpec("a_1", BSON("a" << 1)),
+                                            makeSpec("b_1", BSON("b" << 1))};
+        ASSERT_OK(indexer.init(specs).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection());
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        IndexCatalog* catalog = coll->getIndexCatalog();
+        ASSERT_FALSE(catalog->isMultikey(&_opCtx, catalog->findIndexByName(&_opCtx, "a_1")));
+        ASSERT_TRUE(catalog->isMultikey(&_opCtx, catalog->findIndexByName(&_opCtx, "b_1")));
+
+        // Every document is found through the index, in index order.
+        unique_ptr<DBClientCursor> cursor = _client.query(_ns, Query().hint(BSON("a" << 1)));
+        for (int i = 0; i < nDocs; ++i) {
+            ASSERT_TRUE(cursor->more());
+            ASSERT_EQUALS(cursor->next()["a"].numberInt(), i);
+        }
+        ASSERT_FALSE(cursor->more());
+
+        ASSERT_EQUALS(_client.count(_ns, BSON("b" << BSON("$lt" << 0)), 0, 0, 0),
+                      static_cast<unsigned long long>(nDocs - 1));
+    }
+
+private:
+    BSONObj makeSpec(const std::string& name, const BSONObj& key) {
+        return BSON("name" << name << "ns" << _ns << "key" << key << "v"
+                           << static_cast<int>(kIndexVersion));
+    }
+};
+
+/** A foreground build generating keys on several threads still enforces unique constraints. */
+class InsertBuildParallelKeyGenerationEnforceUnique : public IndexBuildBase {
+public:
+    void run() {
+        // Create a new collection.
+        Database* db = _ctx.db();
+        Collection* coll;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            db->dropCollection(&_opCtx, _ns);
+            coll = db->createCollection(&_opCtx, _ns);
+
+            OpDebug* const nullOpDebug = nullptr;
+            for (int i = 0; i < 1000; ++i) {
+                ASSERT_OK(coll->insertDocument(
+                    &_opCtx, BSON("_id" << i << "a" << (i == 999 ? 0 : i)), nullOpDebug, true));
+            }
+            wunit.commit();
+        }
+
+        KeyGenerationThreadsSetter setter(4);
+
+        MultiIndexBlock indexer(&_opCtx, coll);
+        const BSONObj spec = BSON("name"
+                                  << "a"
+                                  << "ns"
+                                  << coll->ns().ns()
+                                  << "key"
+                                  << BSON("a" << 1)
+                                  << "v"
+                                  << static_cast<int>(kIndexVersion)
+                                  << "unique"
+                                  << true);
+
+        ASSERT_OK(indexer.init(spec).getStatus());
+        const Status status = indexer.insertAllDocumentsInCollection();
+        ASSERT_EQUALS(status.code(), ErrorCodes::DuplicateKey);
+    }
+};
+
+/** Makes background builds bulk load their keys, for as long as it lives. */
+class HybridBackgroundBuildEnabler {
+public:
+    HybridBackgroundBuildEnabler() : _wasEnabled(internalIndexBuildHybridBackground.load()) {
+        internalIndexBuildHybridBackground.store(true);
+    }
+    ~HybridBackgroundBuildEnabler() {
+        internalIndexBuildHybridBackground.store(_wasEnabled);
+    }
+
+private:
+    const bool _wasEnabled;
+};
+
+/** A hybrid background build applies the writes made while it scans and after it has scanned. */
+class InsertBuildHybridBackground : public IndexBuildBase {
+public:
+    void run() {
+        for (int i = 0; i < 1000; ++i) {
+            _client.insert(_ns, BSON("_id" << i << "a" << i));
+        }
+
+        HybridBackgroundBuildEnabler enabler;
+
+        MultiIndexBlock indexer(&_opCtx, collection());
+        indexer.allowBackgroundBuilding();
+        indexer.allowInterruption();
+        ASSERT_OK(indexer.init(makeSpec()).getStatus());
+
+        // Written once the key changes are being diverted, but before the collection scan.
+        _client.insert(_ns, BSON("_id" << 1000 << "a" << 1000));
+        _client.remove(_ns, BSON("_id" << 0));
+
+        ASSERT_OK(indexer.insertAllDocumentsInCollection());
+
+        // Written after the bulk load, so only applied by commit().
+        _client.insert(_ns, BSON("_id" << 1001 << "a" << 1001));
+        _client.remove(_ns, BSON("_id" << 1));
+        _client.update(_ns, BSON("_id" << 2), BSON("$set" << BSON("a" << -2)));
+
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        std::vector<int> expected{-2};
+        for (int i = 3; i <= 1001; ++i) {
+            expected.push_back(i);
+        }
+        ASSERT(indexedValues() == expected);
+
+        // Once the index is ready, writes go straight into it.
+        _client.remove(_ns, BSON("_id" << 1001));
+        expected.pop_back();
+        ASSERT(indexedValues() == expected);
+    }
+
+private:
+    BSONObj makeSpec() {
+        return BSON("name"
+                    << "a_1"
+                    << "ns"
+                    << _ns
+                    << "key"
+                    << BSON("a" << 1)
+                    << "v"
+                    << static_cast<int>(kIndexVersion)
+                    << "background"
+                    << true);
+    }
+
+    std::vector<int> indexedValues() {
+        std::vector<int> values;
+        unique_ptr<DBClientCursor> cursor = _client.query(_ns, Query().hint(BSON("a" << 1)));
+        while (cursor->more()) {
+            values.push_back(cursor->next()["a"].numberInt());
+        }
+        return values;
+    }
+};
+
+/** A hybrid background build fails if a write made during it violates a unique constraint. */
+class InsertBuildHybridBackgroundEnforceUnique : public IndexBuildBase {
+public:
+    void run() {
+        for (int i = 0; i < 100; ++i) {
+            _client.insert(_ns, BSON("_id" << i << "a" << i));
+        }
+
+        HybridBackgroundBuildEnabler enabler;
+
+        MultiIndexBlock indexer(&_opCtx, collection());
+        indexer.allowBackgroundBuilding();
+        const BSONObj spec = BSON("name"
+                                  << "a"
+                                  << "ns"
+                                  << _ns
+                                  << "key"
+                                  << BSON("a" << 1)
+                                  << "v"
+                                  << static_cast<int>(kIndexVersion)
+                                  << "unique"
+                                  << true
+                                  << "background"
+                                  << true);
+        ASSERT_OK(indexer.init(spec).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection());
+
+        _client.insert(_ns, BSON("_id" << 100 << "a" << 0));
+
+        WriteUnitOfWork wunit(&_opCtx);
+        ASSERT_THROWS_CODE(indexer.commit(), DBException, ErrorCodes::DuplicateKey);
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -830,6 +1062,10 @@ public:
         add<InsertBuildEnforceUnique<false>>();
         add<InsertBuildFillDups<true>>();
         add<InsertBuildFillDups<false>>();
+        add<InsertBuildParallelKeyGeneration>();
+        add<InsertBuildParallelKeyGenerationEnforceUnique>();
+        add<InsertBuildHybridBackground>();
+        add<InsertBuildHybridBackgroundEnforceUnique>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIndexInterruptDisallowed>();
         add<InsertBuildIdIndexInterrupt>();
@@ -2595,6 +2595,80 @@ public:
     }
 };
 
+// Integers of up to 18 digits are converted without strtod(). Checks the types chosen around
+// that and around the limits of a 32 bit int.
+class IntegerConversionBoundaries : public Base {
+public:
+    void run() {
+        Base::run();
+
+        BSONObj o = fromjson(json());
+        ASSERT_EQUALS(NumberInt, o["intMax"].type());
+        ASSERT_EQUALS(NumberLong, o["intMaxPlusOne"].type());
+        ASSERT_EQUALS(NumberInt, o["intMin"].type());
+        ASSERT_EQUALS(NumberLong, o["intMinMinusOne"].type());
+        ASSERT_EQUALS(NumberLong, o["digits18"].type());
+        ASSERT_EQUALS(NumberLong, o["digits19"].type());
+        ASSERT_EQUALS(NumberInt, o["leadingZeros"].type());
+        ASSERT_EQUALS(NumberInt, o["negativeZero"].type());
+        ASSERT_EQUALS(NumberDouble, o["exponent"].type());
+        ASSERT_EQUALS(NumberDouble, o["fraction"].type());
+        ASSERT_EQUALS(NumberDouble, o["hex"].type());
+    }
+
+    virtual BSONObj bson() const {
+        BSONObjBuilder b;
+        b.append("intMax", 2147483647);
+        b.append("intMaxPlusOne", 2147483648LL);
+        b.append("intMin", std::numeric_limits<int>::min());
+        b.append("intMinMinusOne", -2147483649LL);
+        b.append("digits18", 999999999999999999LL);
+        b.append("digits19", -1000000000000000000LL);
+        b.append("leadingZeros", 7);
+        b.append("negativeZero", 0);
+        b.append("exponent", 100.0);
+        b.append("fraction", 12.5);
+        b.append("hex", 16.0);
+        return b.obj();
+    }
+    virtual string json() const {
+        return "{ intMax: 2147483647, intMaxPlusOne: 2147483648, intMin: -2147483648, "
+               "intMinMinusOne: -2147483649, digits18: 999999999999999999, "
+               "digits19: -1000000000000000000, leadingZeros: 007, negativeZero: -0, "
+               "exponent: 1e2, fraction: 12.5, hex: 0x10 }";
+    }
+};
+
+// Quoted strings are copied in runs between the characters which need escaping or checks, so
+// these have escapes and quotes at various offsets from the start of the string.
+class LongStringsWithEscapes : public Base {
+    virtual BSONObj bson() const {
+        BSONObjBuilder b;
+        b.append("a", std::string(40, 'x') + "\"" + std::string(15, 'y') + "\n");
+        b.append("b", std::string(16, 'x') + "'" + std::string(16, 'y'));
+        b.append("c", "\t" + std::string(31, 'z') + "\\" + std::string(17, 'z') + "\xc3\xa9");
+        return b.obj();
+    }
+    virtual string json() const {
+        return "{ a: \"" + std::string(40, 'x') + "\\\"" + std::string(15, 'y') +
+            "\\n\", b: '" + std::string(16, 'x') + "\\'" + std::string(16, 'y') +
+            "', c: \"\\t" + std::string(31, 'z') + "\\\\" + std::string(17, 'z') +
+            "\\u00e9\" }";
+    }
+};
+
+class LongStringInvalidControlCharacter : public Bad {
+    virtual string json() const {
+        return "{ a: \"" + std::string(37, 'x') + "\x01" + std::string(20, 'x') + "\" }";
+    }
+};
+
+class LongStringUnterminated : public Bad {
+    virtual string json() const {
+        return "{ a: \"" + std::string(50, 'x');
+    }
+};
+
 class EmbeddedDatesBase : public Base {
 public:
     virtual void run() {
@@ -2944,6 +3018,10 @@ public:
         add<FromJsonTests::NumericLimitsBad>();
         add<FromJsonTests::NumericLimitsBad1>();
         add<FromJsonTests::NegativeNumericTypes>();
+        add<FromJsonTests::IntegerConversionBoundaries>();
+        add<FromJsonTests::LongStringsWithEscapes>();
+        add<FromJsonTests::LongStringInvalidControlCharacter>();
+        add<FromJsonTests::LongStringUnterminated>();
         add<FromJsonTests::EmbeddedDatesFormat1>();
         add<FromJsonTests::EmbeddedDatesFormat2>();
         add<FromJsonTests::EmbeddedDatesFormat3>();
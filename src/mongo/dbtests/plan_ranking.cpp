@@ -46,6 +46,7 @@
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_lib.h"
@@ -625,6 +626,46 @@ public:
     }
 };
 
+/**
+ * When limited to fewer candidates than the planner produces, only the candidates with the
+ * narrowest index bounds are kept. Here that is the equality on 'a', rather than the range on 'b'
+ * or an intersection of the two.
+ */
+class PlanRankingPruneByEstimatedCost : public PlanRankingTestBase {
+public:
+    void run() {
+        addIndex(BSON("a" << 1));
+        addIndex(BSON("b" << 1));
+
+        auto qr = stdx::make_unique<QueryRequest>(nss);
+        qr->setFilter(fromjson("{a: 5, b: {$gt: 0}}"));
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            opCtx(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+        ASSERT_OK(statusWithCQ.getStatus());
+        unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+        AutoGetCollectionForReadCommand ctx(opCtx(), nss);
+        QueryPlannerParams plannerParams;
+        fillOutPlannerParams(opCtx(), ctx.getCollection(), cq.get(), &plannerParams);
+        plannerParams.options &= ~QueryPlannerParams::KEEP_MUTATIONS;
+
+        vector<QuerySolution*> solutions;
+        ASSERT_OK(QueryPlanner::plan(*cq, plannerParams, &solutions));
+        ASSERT_GREATER_THAN(solutions.size(), 1U);
+
+        // A limit of zero keeps every candidate.
+        const size_t numSolutions = solutions.size();
+        PlanRanker::pruneCandidates(&solutions, 0);
+        ASSERT_EQUALS(solutions.size(), numSolutions);
+
+        PlanRanker::pruneCandidates(&solutions, 1);
+        ASSERT_EQUALS(solutions.size(), 1U);
+        unique_ptr<QuerySolution> soln(solutions[0]);
+        ASSERT(QueryPlannerTestLib::solutionMatches("{fetch: {node: {ixscan: {pattern: {a: 1}}}}}",
+                                                    soln->root.get()));
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_plan_ranking") {}
@@ -642,6 +683,7 @@ public:
         add<PlanRankingAvoidBlockingSort>();
         add<PlanRankingWorkPlansLongEnough>();
         add<PlanRankingAccountForKeySkips>();
+        add<PlanRankingPruneByEstimatedCost>();
     }
 };
 
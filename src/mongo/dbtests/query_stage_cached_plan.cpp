@@ -249,6 +249,49 @@ public:
     }
 };
 
+/**
+ * Test that a cached plan whose estimated cost for a query is much higher than when it was cached
+ * is replanned up front, without working the cached plan.
+ */
+class QueryStageCachedPlanReplanWhenEstimatedCostlier : public QueryStageCachedPlanBase {
+public:
+    void run() {
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+        Collection* collection = ctx.getCollection();
+        ASSERT(collection);
+
+        auto getRootStageType = [&](const char* filter) {
+            auto qr = stdx::make_unique<QueryRequest>(nss);
+            qr->setFilter(fromjson(filter));
+            auto statusWithCQ = CanonicalQuery::canonicalize(
+                opCtx(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+            ASSERT_OK(statusWithCQ.getStatus());
+            auto exec = uassertStatusOK(getExecutor(&_opCtx,
+                                                    collection,
+                                                    std::move(statusWithCQ.getValue()),
+                                                    PlanExecutor::YIELD_MANUAL));
+            ASSERT_OK(exec->executePlan());
+            return exec->getRootStage()->stageType();
+        };
+
+        // The index on "a" wins and is cached.
+        ASSERT_EQ(STAGE_MULTI_PLAN, getRootStageType("{a: {$in: [1, 2]}, b: {$in: [1, 2]}}"));
+
+        // A query of the same shape and a similar estimated cost uses the cached plan.
+        ASSERT_EQ(STAGE_CACHED_PLAN, getRootStageType("{a: {$in: [3, 4]}, b: {$in: [1, 2]}}"));
+
+        // Many more values for "a" make the cached plan's estimated cost much higher.
+        ASSERT_EQ(STAGE_MULTI_PLAN,
+                  getRootStageType("{a: {$in: [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, "
+                                   "15, 16, 17, 18, 19]}, b: {$in: [1, 2]}}"));
+
+        // The replanned query replaced the cache entry, so is now run from the cache.
+        ASSERT_EQ(STAGE_CACHED_PLAN,
+                  getRootStageType("{a: {$in: [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, "
+                                   "15, 16, 17, 18, 19]}, b: {$in: [1, 2]}}"));
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_cached_plan") {}
@@ -256,6 +299,7 @@ public:
     void setupTests() {
         add<QueryStageCachedPlanFailure>();
         add<QueryStageCachedPlanHitMaxWorks>();
+        add<QueryStageCachedPlanReplanWhenEstimatedCostlier>();
     }
 };
 
@@ -640,6 +640,66 @@ public:
     }
 };
 
+//
+// Check that each of several ranges of keys is counted
+//
+class QueryStageCountScanMultipleRanges : public CountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_opCtx, ns());
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("a" << i));
+        }
+        addIndex(BSON("a" << 1));
+
+        // Count [1, 2], (4, 6) and [8, 8].
+        CountScanParams params;
+        params.descriptor = getIndex(ctx.db(), BSON("a" << 1));
+        params.startKey = BSON("" << 1);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("" << 2);
+        params.endKeyInclusive = true;
+        params.additionalRanges.push_back(
+            IndexKeyRange{BSON("" << 4), false, BSON("" << 6), false});
+        params.additionalRanges.push_back(IndexKeyRange{BSON("" << 8), true, BSON("" << 8), true});
+
+        WorkingSet ws;
+        CountScan count(&_opCtx, params, &ws);
+
+        int numCounted = runCount(&count);
+        ASSERT_EQUALS(4, numCounted);
+    }
+};
+
+//
+// Check that a document whose keys fall in several ranges is only counted once
+//
+class QueryStageCountScanMultipleRangesDups : public CountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_opCtx, ns());
+
+        insert(BSON("a" << BSON_ARRAY(1 << 8)));
+        insert(BSON("a" << BSON_ARRAY(2 << 3)));
+        addIndex(BSON("a" << 1));
+
+        CountScanParams params;
+        params.descriptor = getIndex(ctx.db(), BSON("a" << 1));
+        params.startKey = BSON("" << 1);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("" << 1);
+        params.endKeyInclusive = true;
+        params.additionalRanges.push_back(IndexKeyRange{BSON("" << 8), true, BSON("" << 8), true});
+
+        WorkingSet ws;
+        CountScan count(&_opCtx, params, &ws);
+
+        int numCounted = runCount(&count);
+        ASSERT_EQUALS(1, numCounted);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_count_scan") {}
@@ -656,6 +716,8 @@ public:
         add<QueryStageCountScanInsertNewDocsDuringYield>();
         add<QueryStageCountScanBecomesMultiKeyDuringYield>();
         add<QueryStageCountScanUnusedKeys>();
+        add<QueryStageCountScanMultipleRanges>();
+        add<QueryStageCountScanMultipleRangesDups>();
     }
 };
 
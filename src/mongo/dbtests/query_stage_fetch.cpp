@@ -44,6 +44,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 
@@ -218,6 +219,80 @@ public:
     }
 };
 
+//
+// Test that batched fetching returns results in the order the child produced them, even though
+// the documents are looked up in RecordId order.
+//
+class FetchStageBatched : public QueryStageFetchBase {
+public:
+    FetchStageBatched() : _oldBatchSize(internalQueryExecFetchBatchSize.load()) {
+        internalQueryExecFetchBatchSize.store(4);
+    }
+
+    ~FetchStageBatched() {
+        internalQueryExecFetchBatchSize.store(_oldBatchSize);
+    }
+
+    void run() {
+        OldClientWriteContext ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        WorkingSet ws;
+
+        const int numDocs = 10;
+        for (int i = 0; i < numDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(numDocs), recordIds.size());
+
+        // Hand the fetch stage RecordIds in descending order.
+        auto mockStage = make_unique<QueuedDataStage>(&_opCtx, &ws);
+        std::vector<RecordId> expected(recordIds.rbegin(), recordIds.rend());
+        for (auto&& recordId : expected) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* mockMember = ws.get(id);
+            mockMember->recordId = recordId;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        unique_ptr<FetchStage> fetchStage(
+            new FetchStage(&_opCtx, &ws, mockStage.release(), NULL, coll));
+
+        std::vector<RecordId> results;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (PlanStage::IS_EOF != state) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            state = fetchStage->work(&id);
+            if (PlanStage::ADVANCED == state) {
+                WorkingSetMember* member = ws.get(id);
+                ASSERT_TRUE(member->hasObj());
+                ASSERT_BSONOBJ_EQ(coll->docFor(&_opCtx, member->recordId).value(),
+                                  member->obj.value());
+                results.push_back(member->recordId);
+            } else {
+                ASSERT_TRUE(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+            }
+        }
+
+        ASSERT_EQUALS(expected.size(), results.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQUALS(expected[i], results[i]);
+        }
+    }
+
+private:
+    const int _oldBatchSize;
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_fetch") {}
@@ -225,6 +300,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageBatched>();
     }
 };
 
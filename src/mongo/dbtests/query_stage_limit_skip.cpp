@@ -33,6 +33,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
 #include "mongo/client/dbclientcursor.h"
 #include "mongo/db/client.h"
 #include "mongo/db/exec/limit.h"
@@ -87,6 +89,30 @@ int countResults(PlanStage* stage) {
     return count;
 }
 
+std::vector<int> getResults(PlanStage* stage, WorkingSet* ws) {
+    std::vector<int> results;
+    while (!stage->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        if (PlanStage::ADVANCED == stage->work(&id)) {
+            results.push_back(ws->get(id)->obj.value()["x"].numberInt());
+        }
+    }
+    return results;
+}
+
+std::vector<int> getResultsInBatches(PlanStage* stage, WorkingSet* ws, size_t batchSize) {
+    std::vector<int> results;
+    PlanStage::WorkBatch batch;
+    while (!stage->isEOF()) {
+        stage->workBatch(ws, batchSize, &batch);
+        ASSERT_LTE(batch.ids.size(), batchSize);
+        for (auto id : batch.ids) {
+            results.push_back(ws->get(id)->obj.value()["x"].numberInt());
+        }
+    }
+    return results;
+}
+
 //
 // Insert 50 objects.  Filter/skip 0, 1, 2, ..., 100 objects and expect the right # of results.
 //
@@ -110,12 +136,45 @@ protected:
     OperationContext* const _opCtx = _uniqOpCtx.get();
 };
 
+//
+// Skip and limit the same way, once working a unit at a time and once in batches of various
+// sizes, and expect the same results.
+//
+class QueryStageLimitSkipBatchedTest {
+public:
+    void run() {
+        for (size_t batchSize : {1, 2, 7, 1000}) {
+            for (int i = 0; i < 2 * N; i += 3) {
+                WorkingSet ws;
+                unique_ptr<PlanStage> limit = make_unique<LimitStage>(
+                    _opCtx, N / 2, &ws, new SkipStage(_opCtx, i, &ws, getMS(_opCtx, &ws)));
+                const auto expected = getResults(limit.get(), &ws);
+                ASSERT_EQUALS(static_cast<size_t>(min(N / 2, max(0, N - i))), expected.size());
+
+                WorkingSet batchedWs;
+                unique_ptr<PlanStage> batchedLimit = make_unique<LimitStage>(
+                    _opCtx,
+                    N / 2,
+                    &batchedWs,
+                    new SkipStage(_opCtx, i, &batchedWs, getMS(_opCtx, &batchedWs)));
+                ASSERT(expected == getResultsInBatches(batchedLimit.get(), &batchedWs, batchSize));
+                ASSERT_EQUALS(expected.size(), batchedLimit->getCommonStats()->advanced);
+            }
+        }
+    }
+
+protected:
+    const ServiceContext::UniqueOperationContext _uniqOpCtx = cc().makeOperationContext();
+    OperationContext* const _opCtx = _uniqOpCtx.get();
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_limit_skip") {}
 
     void setupTests() {
         add<QueryStageLimitSkipBasicTest>();
+        add<QueryStageLimitSkipBatchedTest>();
     }
 };
 
@@ -41,8 +41,11 @@
 #include "mongo/db/exec/sort.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/scopeguard.h"
 
 /**
  * This file tests db/exec/sort.cpp
@@ -156,6 +159,8 @@ public:
         params.collection = coll;
         params.pattern = BSON("foo" << direction);
         params.limit = limit();
+        params.allowDiskUse = allowDiskUse();
+        params.tempDir = storageGlobalParams.dbpath + "/_tmp";
 
         auto keyGenStage = make_unique<SortKeyGeneratorStage>(
             &_opCtx, queuedDataStage.release(), ws.get(), params.pattern, BSONObj(), nullptr);
@@ -215,6 +220,10 @@ public:
         return 0;
     };
 
+    // Whether the sort stage may spill to disk.
+    virtual bool allowDiskUse() const {
+        return false;
+    }
 
     static const char* ns() {
         return "unittests.QueryStageSort";
@@ -302,6 +311,26 @@ public:
     }
 };
 
+// Sort with a memory limit small enough that the results must be spilled to disk.
+template <int LIMIT>
+class QueryStageSortSpillToDisk : public QueryStageSortDecWithLimit<LIMIT> {
+public:
+    virtual int numObj() {
+        return 2000;
+    }
+
+    virtual bool allowDiskUse() const {
+        return true;
+    }
+
+    void run() {
+        const int oldMaxBytes = internalQueryExecMaxBlockingSortBytes.load();
+        internalQueryExecMaxBlockingSortBytes.store(10 * 1024);
+        ON_BLOCK_EXIT([&] { internalQueryExecMaxBlockingSortBytes.store(oldMaxBytes); });
+        QueryStageSortDec::run();
+    }
+};
+
 // Mutation invalidation of docs fed to sort.
 class QueryStageSortMutationInvalidation : public QueryStageSortTestBase {
 public:
@@ -586,6 +615,8 @@ public:
         // and a special case for limit == 1
         add<QueryStageSortDecWithLimit<1>>();
         add<QueryStageSortExt>();
+        add<QueryStageSortSpillToDisk<0>>();
+        add<QueryStageSortSpillToDisk<1000>>();
         add<QueryStageSortMutationInvalidation>();
         add<QueryStageSortDeletionInvalidation>();
         add<QueryStageSortDeletionInvalidationWithLimit<10>>();
@@ -37,6 +37,7 @@
 #include "mongo/executor/async_stream_common.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/timer.h"
 
 #ifdef MONGO_CONFIG_SSL
 
@@ -88,11 +89,20 @@ void AsyncSecureStream::read(asio::mutable_buffer buffer, StreamHandler&& stream
 }
 
 void AsyncSecureStream::_handleConnect(asio::ip::tcp::resolver::iterator iter) {
+    const auto remoteHost = iter->host_name() + ":" + iter->service_name();
+    getSSLManager()->prepareClientSession(_stream.native_handle(), remoteHost);
+
+    Timer timer;
     _stream.async_handshake(decltype(_stream)::client,
-                            _strand->wrap([this, iter](std::error_code ec) {
+                            _strand->wrap([this, iter, remoteHost, timer](std::error_code ec) {
                                 if (ec) {
                                     return _userHandler(ec);
                                 }
+                                getSSLManager()->recordHandshake(
+                                    _stream.native_handle(),
+                                    SSLManagerInterface::ConnectionDirection::kOutgoing,
+                                    remoteHost,
+                                    Microseconds(timer.micros()));
                                 return _handleHandshake(ec, iter->host_name());
                             }));
 }
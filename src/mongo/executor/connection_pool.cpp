@@ -34,6 +34,8 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/remote_command_request.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/hash_namespace.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
@@ -41,11 +43,18 @@
 #include "mongo/util/scopeguard.h"
 
 // One interesting implementation note herein concerns how setup() and
-// refresh() are invoked outside of the global lock, but setTimeout is not.
+// refresh() are invoked outside of the specific pool's lock, but setTimeout is not.
 // This implementation detail simplifies mocks, allowing them to return
 // synchronously sometimes, whereas having timeouts fire instantly adds little
 // value. In practice, dumping the locks is always safe (because we restrict
 // ourselves to operations over the connection).
+//
+// Locking is split in two levels. The specific pools are spread over a fixed
+// number of stripes by host, and a stripe's mutex only guards its map of
+// pools. Each specific pool has its own mutex guarding its connections and
+// requests, so traffic to different hosts never contends on the same lock.
+// When both are needed (only to remove an expired pool) the stripe's mutex is
+// taken first.
 
 namespace mongo {
 namespace executor {
@@ -63,8 +72,19 @@ public:
     ~SpecificPool();
 
     /**
-     * Gets a connection from the specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Returns a lock on this pool's mutex, to be sunk into one of the methods below.
+     */
+    stdx::unique_lock<stdx::mutex> lock();
+
+    /**
+     * Returns true once shutdown() has removed this pool from its stripe. A caller which found
+     * the pool before that must look it up again rather than queue new requests on it.
+     */
+    bool isRemoved(const stdx::unique_lock<stdx::mutex>& lk) const;
+
+    /**
+     * Gets a connection from the specific pool. Sinks a unique_lock from
+     * lock() to preserve the lock on _mutex
      */
     void getConnection(const HostAndPort& hostAndPort,
                        Milliseconds timeout,
@@ -79,30 +99,41 @@ public:
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
     /**
-     * Returns a connection to a specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Opens connections up to minConnections and restarts the host timeout, as a request would.
+     * Sinks a unique_lock from lock() to preserve the lock on _mutex
+     */
+    void warmUp(stdx::unique_lock<stdx::mutex> lk);
+
+    /**
+     * Returns a connection to a specific pool. Sinks a unique_lock from
+     * lock() to preserve the lock on _mutex
      */
     void returnConnection(ConnectionInterface* connection, stdx::unique_lock<stdx::mutex> lk);
 
+    /**
+     * The statistics accessors below read counters kept up to date under _mutex, so they can be
+     * called without taking it. The values may be slightly stale.
+     */
+
     /**
      * Returns the number of connections currently checked out of the pool.
      */
-    size_t inUseConnections(const stdx::unique_lock<stdx::mutex>& lk);
+    size_t inUseConnections() const;
 
     /**
      * Returns the number of available connections in the pool.
      */
-    size_t availableConnections(const stdx::unique_lock<stdx::mutex>& lk);
+    size_t availableConnections() const;
 
     /**
      * Returns the number of in progress connections in the pool.
      */
-    size_t refreshingConnections(const stdx::unique_lock<stdx::mutex>& lk);
+    size_t refreshingConnections() const;
 
     /**
      * Returns the total number of connections ever created in this pool.
      */
-    size_t createdConnections(const stdx::unique_lock<stdx::mutex>& lk);
+    size_t createdConnections() const;
 
 private:
     using OwnedConnection = std::unique_ptr<ConnectionInterface>;
@@ -122,16 +153,22 @@ private:
 
     void shutdown();
 
+    void putInPool(OwnershipPool& pool, OwnedConnection conn);
     OwnedConnection takeFromPool(OwnershipPool& pool, ConnectionInterface* connection);
     OwnedConnection takeFromProcessingPool(ConnectionInterface* connection);
 
     void updateStateInLock();
 
+    void updateStatsInLock();
+
 private:
     ConnectionPool* const _parent;
 
     const HostAndPort _hostAndPort;
 
+    // Guards all of the state below, apart from the statistics counters
+    stdx::mutex _mutex;
+
     OwnershipPool _readyPool;
     OwnershipPool _processingPool;
     OwnershipPool _droppedProcessingPool;
@@ -144,9 +181,16 @@ private:
     size_t _generation;
     bool _inFulfillRequests;
     bool _inSpawnConnections;
+    bool _removed;
 
     size_t _created;
 
+    // Copies of the pool sizes for the statistics accessors
+    AtomicWord<size_t> _inUseCount;
+    AtomicWord<size_t> _availableCount;
+    AtomicWord<size_t> _refreshingCount;
+    AtomicWord<size_t> _createdCount;
+
     /**
      * The current state of the pool
      *
@@ -176,8 +220,10 @@ private:
 constexpr Milliseconds ConnectionPool::kDefaultHostTimeout;
 size_t const ConnectionPool::kDefaultMaxConns = std::numeric_limits<size_t>::max();
 size_t const ConnectionPool::kDefaultMinConns = 1;
+size_t const ConnectionPool::kDefaultMaxConnecting = std::numeric_limits<size_t>::max();
 constexpr Milliseconds ConnectionPool::kDefaultRefreshRequirement;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshTimeout;
+constexpr size_t ConnectionPool::kNumPoolStripes;
 
 const Status ConnectionPool::kConnectionStateUnknown =
     Status(ErrorCodes::InternalError, "Connection is in an unknown state");
@@ -190,62 +236,100 @@ ConnectionPool::ConnectionPool(std::unique_ptr<DependentTypeFactoryInterface> im
 ConnectionPool::~ConnectionPool() = default;
 
 void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    std::shared_ptr<SpecificPool> pool;
+    {
+        auto& stripe = _getStripe(hostAndPort);
+        stdx::lock_guard<stdx::mutex> stripeLk(stripe.mutex);
 
-    auto iter = _pools.find(hostAndPort);
+        auto iter = stripe.pools.find(hostAndPort);
 
-    if (iter == _pools.end())
-        return;
+        if (iter == stripe.pools.end())
+            return;
+
+        pool = iter->second;
+    }
 
-    iter->second.get()->processFailure(
-        Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"), std::move(lk));
+    pool->processFailure(
+        Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"), pool->lock());
 }
 
 void ConnectionPool::get(const HostAndPort& hostAndPort,
                          Milliseconds timeout,
                          GetConnectionCallback cb) {
-    SpecificPool* pool;
-
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    std::shared_ptr<SpecificPool> pool;
+    auto lk = _lockPool(hostAndPort, &pool);
 
-    auto iter = _pools.find(hostAndPort);
-
-    if (iter == _pools.end()) {
-        auto handle = stdx::make_unique<SpecificPool>(this, hostAndPort);
-        pool = handle.get();
-        _pools[hostAndPort] = std::move(handle);
-    } else {
-        pool = iter->second.get();
-    }
+    pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
+}
 
-    invariant(pool);
+void ConnectionPool::warmUp(const HostAndPort& hostAndPort) {
+    std::shared_ptr<SpecificPool> pool;
+    auto lk = _lockPool(hostAndPort, &pool);
 
-    pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
+    pool->warmUp(std::move(lk));
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    for (const auto& stripe : _stripes) {
+        stdx::lock_guard<stdx::mutex> stripeLk(stripe.mutex);
+
+        for (const auto& kv : stripe.pools) {
+            HostAndPort host = kv.first;
+
+            auto& pool = kv.second;
+            ConnectionStatsPer hostStats{pool->inUseConnections(),
+                                         pool->availableConnections(),
+                                         pool->createdConnections(),
+                                         pool->refreshingConnections()};
+            stats->updateStatsForHost(_name, host, hostStats);
+        }
+    }
+}
 
-    for (const auto& kv : _pools) {
-        HostAndPort host = kv.first;
+void ConnectionPool::returnConnection(ConnectionInterface* conn) {
+    std::shared_ptr<SpecificPool> pool;
+    {
+        auto& stripe = _getStripe(conn->getHostAndPort());
+        stdx::lock_guard<stdx::mutex> stripeLk(stripe.mutex);
 
-        auto& pool = kv.second;
-        ConnectionStatsPer hostStats{pool->inUseConnections(lk),
-                                     pool->availableConnections(lk),
-                                     pool->createdConnections(lk),
-                                     pool->refreshingConnections(lk)};
-        stats->updateStatsForHost(_name, host, hostStats);
+        auto iter = stripe.pools.find(conn->getHostAndPort());
+
+        invariant(iter != stripe.pools.end());
+
+        pool = iter->second;
     }
+
+    pool->returnConnection(conn, pool->lock());
 }
 
-void ConnectionPool::returnConnection(ConnectionInterface* conn) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+ConnectionPool::PoolStripe& ConnectionPool::_getStripe(const HostAndPort& hostAndPort) {
+    return _stripes[MONGO_HASH_NAMESPACE::hash<HostAndPort>()(hostAndPort) % kNumPoolStripes];
+}
+
+stdx::unique_lock<stdx::mutex> ConnectionPool::_lockPool(const HostAndPort& hostAndPort,
+                                                         std::shared_ptr<SpecificPool>* pool) {
+    auto& stripe = _getStripe(hostAndPort);
 
-    auto iter = _pools.find(conn->getHostAndPort());
+    while (true) {
+        {
+            stdx::lock_guard<stdx::mutex> stripeLk(stripe.mutex);
 
-    invariant(iter != _pools.end());
+            auto& slot = stripe.pools[hostAndPort];
+            if (!slot) {
+                slot = std::make_shared<SpecificPool>(this, hostAndPort);
+            }
+            *pool = slot;
+        }
 
-    iter->second.get()->returnConnection(conn, std::move(lk));
+        invariant(*pool);
+
+        auto lk = (*pool)->lock();
+
+        // The pool may have expired between the lookup and taking its lock, in which case a new
+        // one has to be made.
+        if (!(*pool)->isRemoved(lk))
+            return lk;
+    }
 }
 
 ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAndPort& hostAndPort)
@@ -255,6 +339,7 @@ ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAnd
       _generation(0),
       _inFulfillRequests(false),
       _inSpawnConnections(false),
+      _removed(false),
       _created(0),
       _state(State::kRunning) {}
 
@@ -262,22 +347,28 @@ ConnectionPool::SpecificPool::~SpecificPool() {
     DESTRUCTOR_GUARD(_requestTimer->cancelTimeout();)
 }
 
-size_t ConnectionPool::SpecificPool::inUseConnections(const stdx::unique_lock<stdx::mutex>& lk) {
-    return _checkedOutPool.size();
+stdx::unique_lock<stdx::mutex> ConnectionPool::SpecificPool::lock() {
+    return stdx::unique_lock<stdx::mutex>(_mutex);
+}
+
+bool ConnectionPool::SpecificPool::isRemoved(const stdx::unique_lock<stdx::mutex>& lk) const {
+    return _removed;
+}
+
+size_t ConnectionPool::SpecificPool::inUseConnections() const {
+    return _inUseCount.load();
 }
 
-size_t ConnectionPool::SpecificPool::availableConnections(
-    const stdx::unique_lock<stdx::mutex>& lk) {
-    return _readyPool.size();
+size_t ConnectionPool::SpecificPool::availableConnections() const {
+    return _availableCount.load();
 }
 
-size_t ConnectionPool::SpecificPool::refreshingConnections(
-    const stdx::unique_lock<stdx::mutex>& lk) {
-    return _processingPool.size();
+size_t ConnectionPool::SpecificPool::refreshingConnections() const {
+    return _refreshingCount.load();
 }
 
-size_t ConnectionPool::SpecificPool::createdConnections(const stdx::unique_lock<stdx::mutex>& lk) {
-    return _created;
+size_t ConnectionPool::SpecificPool::createdConnections() const {
+    return _createdCount.load();
 }
 
 void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
@@ -298,6 +389,15 @@ void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
     fulfillRequests(lk);
 }
 
+void ConnectionPool::SpecificPool::warmUp(stdx::unique_lock<stdx::mutex> lk) {
+    // Count as activity, so that an idle pool's host timeout starts over
+    _state = State::kRunning;
+
+    spawnConnections(lk);
+
+    updateStateInLock();
+}
+
 void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr,
                                                     stdx::unique_lock<stdx::mutex> lk) {
     auto needsRefreshTP = connPtr->getLastUsed() + _parent->_options.refreshRequirement;
@@ -330,7 +430,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
             return;
         }
 
-        _processingPool[connPtr] = std::move(conn);
+        putInPool(_processingPool, std::move(conn));
 
         // Unlock in case refresh can occur immediately
         lk.unlock();
@@ -338,7 +438,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
                          [this](ConnectionInterface* connPtr, Status status) {
                              connPtr->indicateUsed();
 
-                             stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                             stdx::unique_lock<stdx::mutex> lk(_mutex);
 
                              auto conn = takeFromProcessingPool(connPtr);
 
@@ -354,6 +454,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
                              // pool
                              if (status.isOK()) {
                                  addToReady(lk, std::move(conn));
+                                 spawnConnections(lk);
                                  return;
                              }
 
@@ -382,7 +483,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
                                               OwnedConnection conn) {
     auto connPtr = conn.get();
 
-    _readyPool[connPtr] = std::move(conn);
+    putInPool(_readyPool, std::move(conn));
 
     // Our strategy for refreshing connections is to check them out and
     // immediately check them back in (which kicks off the refresh logic in
@@ -390,7 +491,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
     connPtr->setTimeout(_parent->_options.refreshRequirement, [this, connPtr]() {
         OwnedConnection conn;
 
-        stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
         if (!_readyPool.count(connPtr)) {
             // We've already been checked out. We don't need to refresh
@@ -404,7 +505,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
         if (_state == State::kInShutdown)
             return;
 
-        _checkedOutPool[connPtr] = std::move(conn);
+        putInPool(_checkedOutPool, std::move(conn));
 
         connPtr->indicateSuccess();
 
@@ -430,6 +531,8 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     }
     _processingPool.clear();
 
+    updateStatsInLock();
+
     // Move the requests out so they aren't visible
     // in other threads
     decltype(_requests) requestsToFail;
@@ -468,8 +571,7 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
             break;
 
         // Grab the connection and cancel its timeout
-        auto conn = std::move(iter->second);
-        _readyPool.erase(iter);
+        auto conn = takeFromPool(_readyPool, iter->first);
         conn->cancelTimeout();
 
         if (!conn->isHealthy()) {
@@ -494,7 +596,7 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         auto connPtr = conn.get();
 
         // check out the connection
-        _checkedOutPool[connPtr] = std::move(conn);
+        putInPool(_checkedOutPool, std::move(conn));
 
         updateStateInLock();
 
@@ -524,8 +626,10 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
             std::min(_requests.size() + _checkedOutPool.size(), _parent->_options.maxConnections));
     };
 
-    // While all of our inflight connections are less than our target
-    while (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() < target()) {
+    // While all of our inflight connections are less than our target, and no more than
+    // maxConnecting are being set up or refreshed
+    while (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() < target() &&
+           _processingPool.size() < _parent->_options.maxConnecting) {
         std::unique_ptr<ConnectionPool::ConnectionInterface> handle;
         try {
             // make a new connection and put it in processing
@@ -536,9 +640,9 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
         }
 
         auto connPtr = handle.get();
-        _processingPool[connPtr] = std::move(handle);
 
         ++_created;
+        putInPool(_processingPool, std::move(handle));
 
         // Run the setup callback
         lk.unlock();
@@ -546,7 +650,7 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
             _parent->_options.refreshTimeout, [this](ConnectionInterface* connPtr, Status status) {
                 connPtr->indicateUsed();
 
-                stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
 
                 auto conn = takeFromProcessingPool(connPtr);
 
@@ -555,6 +659,8 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
                     // connection lapse
                 } else if (status.isOK()) {
                     addToReady(lk, std::move(conn));
+                    // Continue with any connections held back by maxConnecting
+                    spawnConnections(lk);
                 } else if (status.code() == ErrorCodes::NetworkInterfaceExceededTimeLimit) {
                     // If we've exceeded the time limit, restart the connect, rather than
                     // failing all operations.  We do this because the various callers
@@ -574,7 +680,14 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
 
 // Called every second after hostTimeout until all processing connections reap
 void ConnectionPool::SpecificPool::shutdown() {
-    stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+    auto& stripe = _parent->_getStripe(_hostAndPort);
+
+    // Takes over the stripe's reference to this pool when removing it, so that the pool outlives
+    // the locks below.
+    std::shared_ptr<SpecificPool> self;
+
+    stdx::lock_guard<stdx::mutex> stripeLk(stripe.mutex);
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
 
     // We're racing:
     //
@@ -608,7 +721,18 @@ void ConnectionPool::SpecificPool::shutdown() {
     invariant(_requests.empty());
     invariant(_checkedOutPool.empty());
 
-    _parent->_pools.erase(_hostAndPort);
+    _removed = true;
+
+    auto iter = stripe.pools.find(_hostAndPort);
+    invariant(iter != stripe.pools.end());
+    self = std::move(iter->second);
+    stripe.pools.erase(iter);
+}
+
+void ConnectionPool::SpecificPool::putInPool(OwnershipPool& pool, OwnedConnection conn) {
+    auto connPtr = conn.get();
+    pool[connPtr] = std::move(conn);
+    updateStatsInLock();
 }
 
 ConnectionPool::SpecificPool::OwnedConnection ConnectionPool::SpecificPool::takeFromPool(
@@ -618,6 +742,7 @@ ConnectionPool::SpecificPool::OwnedConnection ConnectionPool::SpecificPool::take
 
     auto conn = std::move(iter->second);
     pool.erase(iter);
+    updateStatsInLock();
     return conn;
 }
 
@@ -651,7 +776,7 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
         // We set a timer for the most recent request, then invoke each timed
         // out request we couldn't service
         _requestTimer->setTimeout(timeout, [this]() {
-            stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
 
             auto now = _parent->_factory->now();
 
@@ -700,5 +825,12 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
     }
 }
 
+void ConnectionPool::SpecificPool::updateStatsInLock() {
+    _inUseCount.store(_checkedOutPool.size());
+    _availableCount.store(_readyPool.size());
+    _refreshingCount.store(_processingPool.size());
+    _createdCount.store(_created);
+}
+
 }  // namespace executor
 }  // namespace mongo
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <queue>
 
@@ -71,6 +72,7 @@ public:
     static constexpr Milliseconds kDefaultHostTimeout = Milliseconds(300000);  // 5mins
     static const size_t kDefaultMaxConns;
     static const size_t kDefaultMinConns;
+    static const size_t kDefaultMaxConnecting;
     static constexpr Milliseconds kDefaultRefreshRequirement = Milliseconds(60000);  // 1min
     static constexpr Milliseconds kDefaultRefreshTimeout = Milliseconds(20000);      // 20secs
 
@@ -92,6 +94,13 @@ public:
          */
         size_t maxConnections = kDefaultMaxConns;
 
+        /**
+         * The maximum number of connections to a host which may be in setup or
+         * refresh at once. This rate limits the connections opened to a host
+         * which has just become known or has just lost its connections.
+         */
+        size_t maxConnecting = kDefaultMaxConnecting;
+
         /**
          * Amount of time to wait before timing out a refresh attempt
          */
@@ -121,6 +130,13 @@ public:
 
     void get(const HostAndPort& hostAndPort, Milliseconds timeout, GetConnectionCallback cb);
 
+    /**
+     * Starts opening connections to the host, up to minConnections, without waiting for a
+     * request. The pool for the host is kept alive for another hostTimeout, so calling this
+     * periodically keeps the host's connections open while it is idle.
+     */
+    void warmUp(const HostAndPort& hostAndPort);
+
     void appendConnectionStats(ConnectionPoolStats* stats) const;
 
 private:
@@ -134,9 +150,25 @@ private:
 
     const std::unique_ptr<DependentTypeFactoryInterface> _factory;
 
-    // The global mutex for specific pool access and the generation counter
-    mutable stdx::mutex _mutex;
-    stdx::unordered_map<HostAndPort, std::unique_ptr<SpecificPool>> _pools;
+    // Specific pools are spread by host over a fixed number of stripes. A stripe's mutex only
+    // guards its map, each specific pool has its own mutex for its connections and requests.
+    struct PoolStripe {
+        mutable stdx::mutex mutex;
+        stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> pools;
+    };
+
+    static constexpr size_t kNumPoolStripes = 16;
+
+    PoolStripe& _getStripe(const HostAndPort& hostAndPort);
+
+    /**
+     * Finds the specific pool for the host, creating it if needed, and returns it in 'pool'
+     * together with a lock on its mutex.
+     */
+    stdx::unique_lock<stdx::mutex> _lockPool(const HostAndPort& hostAndPort,
+                                             std::shared_ptr<SpecificPool>* pool);
+
+    std::array<PoolStripe, kNumPoolStripes> _stripes;
 };
 
 class ConnectionPool::ConnectionHandleDeleter {
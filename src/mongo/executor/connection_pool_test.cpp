@@ -29,10 +29,16 @@
 
 #include "mongo/executor/connection_pool_test_fixture.h"
 
+#include <string>
+#include <vector>
+
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace executor {
@@ -925,6 +931,114 @@ TEST_F(ConnectionPoolTest, RefreshTimeoutsDontTimeoutRequests) {
     ASSERT(!conn2);
 }
 
+/**
+ * Verify that warmUp() opens minConnections without a request, no more than maxConnecting at a
+ * time, and that a later request is served from them.
+ */
+TEST_F(ConnectionPoolTest, WarmUpOpensMinConnections) {
+    ConnectionPool::Options options;
+    options.minConnections = 3;
+    options.maxConnecting = 2;
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    PoolImpl::setNow(Date_t::now());
+
+    auto checkStats = [&](size_t available, size_t refreshing, size_t created) {
+        ConnectionPoolStats stats;
+        pool.appendConnectionStats(&stats);
+        ASSERT_EQ(0U, stats.totalInUse);
+        ASSERT_EQ(available, stats.totalAvailable);
+        ASSERT_EQ(refreshing, stats.totalRefreshing);
+        ASSERT_EQ(created, stats.totalCreated);
+    };
+
+    pool.warmUp(HostAndPort());
+    checkStats(0, 2, 2);
+
+    // Finishing one setup lets the third connection start
+    ConnectionImpl::pushSetup(Status::OK());
+    checkStats(1, 2, 3);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    checkStats(3, 0, 3);
+
+    bool reachedA = false;
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 doneWith(swConn.getValue());
+                 reachedA = true;
+             });
+    ASSERT(reachedA);
+    checkStats(3, 0, 3);
+}
+
+/**
+ * Verify that threads using connections to different hosts can check them out and back in
+ * concurrently, and report the throughput. Each thread has a host to itself so that every request
+ * is served from the ready pool.
+ */
+TEST_F(ConnectionPoolTest, ConcurrentGetAndReturnAcrossHosts) {
+    const size_t kNumHosts = 8;
+    const size_t kIterations = 20000;
+
+    // Freeze the clock so that no connection needs a refresh while the threads are running.
+    PoolImpl::setNow(Date_t::now());
+
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool");
+
+    std::vector<HostAndPort> hosts;
+    for (size_t i = 0; i < kNumHosts; ++i) {
+        hosts.emplace_back("localhost", 30000 + i);
+
+        ConnectionImpl::pushSetup(Status::OK());
+        pool.get(hosts.back(),
+                 Milliseconds(5000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+                     doneWith(swConn.getValue());
+                 });
+    }
+
+    std::vector<size_t> served(kNumHosts, 0);
+    std::vector<stdx::thread> threads;
+
+    Timer timer;
+    for (size_t i = 0; i < kNumHosts; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < kIterations; ++j) {
+                pool.get(hosts[i],
+                         Milliseconds(5000),
+                         [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                             if (swConn.isOK()) {
+                                 doneWith(swConn.getValue());
+                                 ++served[i];
+                             }
+                         });
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    auto micros = timer.micros();
+    unittest::log() << "connection pool get/return across " << kNumHosts << " hosts: "
+                    << kNumHosts * kIterations << " operations in " << micros << " micros";
+
+    for (size_t i = 0; i < kNumHosts; ++i) {
+        ASSERT_EQ(kIterations, served[i]);
+    }
+
+    ConnectionPoolStats stats;
+    pool.appendConnectionStats(&stats);
+    ASSERT_EQ(0U, stats.totalInUse);
+    ASSERT_EQ(kNumHosts, stats.totalAvailable);
+    ASSERT_EQ(kNumHosts, stats.totalCreated);
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #include <set>
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 namespace executor {
@@ -57,6 +58,8 @@ public:
     static void clear();
 
 private:
+    // Guards _timers, which pools for different hosts may arm concurrently
+    static stdx::mutex _timersMutex;
     static std::set<TimerImpl*> _timers;
 
     TimeoutCallback _cb;
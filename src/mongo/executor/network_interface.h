@@ -166,6 +166,11 @@ public:
      */
     virtual void dropConnections(const HostAndPort& hostAndPort) = 0;
 
+    /**
+     * Starts opening connections to the given host in the connection pool ahead of any request.
+     */
+    virtual void warmUpConnections(const HostAndPort& hostAndPort) = 0;
+
 protected:
     NetworkInterface();
 };
@@ -138,6 +138,8 @@ public:
 
     void dropConnections(const HostAndPort& hostAndPort) override;
 
+    void warmUpConnections(const HostAndPort& hostAndPort) override;
+
 private:
     using ResponseStatus = TaskExecutor::ResponseStatus;
     using NetworkInterface::RemoteCommandCompletionFn;
@@ -34,6 +34,9 @@
 #include "mongo/platform/atomic_word.h"
 
 namespace mongo {
+
+class HostAndPort;
+
 namespace executor {
 
 struct ConnectionPoolStats;
@@ -111,6 +114,11 @@ public:
      */
     void appendConnectionStats(ConnectionPoolStats* stats) const;
 
+    /**
+     * Starts opening connections to the given host from all of the executors in the pool.
+     */
+    void warmUpConnections(const HostAndPort& hostAndPort);
+
 private:
     AtomicUInt32 _counter;
 
@@ -91,6 +91,11 @@ public:
     WorkQueue::iterator iter;
     Date_t readyDate;
     bool isNetworkOperation = false;
+    // Set while the callback is in _sleepersQueue, so that cancel() need not search it.
+    bool isSleeping = false;
+    // For remote commands, the time by which the command expires. Orders the remote lane.
+    Date_t deadline = Date_t::max();
+    uint64_t readySequence = 0;
     AtomicWord<bool> isFinished{false};
     boost::optional<stdx::condition_variable> finishedCondition;
 };
@@ -173,16 +178,15 @@ void ThreadPoolTaskExecutor::join() {
     _net->shutdown();
 
     stdx::unique_lock<stdx::mutex> lk(_mutex);
-    // The _poolInProgressQueue may not be empty if the network interface attempted to schedule work
-    // into _pool after _pool->shutdown(). Because _pool->join() has returned, we know that any
-    // items left in _poolInProgressQueue will never be processed by another thread, so we process
-    // them now.
-    while (!_poolInProgressQueue.empty()) {
-        auto cbState = _poolInProgressQueue.front();
+    // The ready lanes may not be empty if the network interface attempted to schedule work into
+    // _pool after _pool->shutdown(). Because _pool->join() has returned, we know that any items
+    // left in them will never be processed by another thread, so we process them now.
+    while (auto cbState = takeNextReady_inlock()) {
         lk.unlock();
         runCallback(std::move(cbState));
         lk.lock();
     }
+    invariant(_poolInProgressQueue.empty());
     invariant(_networkInProgressQueue.empty());
     invariant(_sleepersQueue.empty());
     invariant(_unsignaledEvents.empty());
@@ -200,6 +204,8 @@ BSONObj ThreadPoolTaskExecutor::_getDiagnosticBSON() const {
 
     // Queues
     BSONObjBuilder queues(builder.subobjStart("queues"));
+    queues.appendIntOrLL("readyWork", _readyWork.size());
+    queues.appendIntOrLL("readyRemoteWork", _readyRemoteWork.size());
     queues.appendIntOrLL("networkInProgress", _networkInProgressQueue.size());
     queues.appendIntOrLL("sleepers", _sleepersQueue.size());
     queues.done();
@@ -286,6 +292,7 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleWorkAt(
     if (!cbHandle.isOK()) {
         return cbHandle;
     }
+    _sleepersQueue.back()->isSleeping = true;
     lk.unlock();
     _net->setAlarm(when, [this, when, cbHandle] {
         auto cbState = checked_cast<CallbackState*>(getCallbackFromHandle(cbHandle.getValue()));
@@ -345,6 +352,7 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
         remoteCommandFailedEarly(cbData, cb, scheduledRequest);
     });
     wq.front()->isNetworkOperation = true;
+    wq.front()->deadline = scheduledRequest.expirationDate;
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     auto cbHandle = enqueueCallbackState_inlock(&_networkInProgressQueue, &wq);
     if (!cbHandle.isOK())
@@ -382,18 +390,10 @@ void ThreadPoolTaskExecutor::cancel(const CallbackHandle& cbHandle) {
         _net->cancelCommand(cbHandle);
         return;
     }
-    if (cbState->readyDate != Date_t{}) {
-        // This callback might still be in the sleeper queue; if it is, schedule it now
-        // rather than when the alarm fires.
-        auto iter = std::find_if(_sleepersQueue.begin(),
-                                 _sleepersQueue.end(),
-                                 [cbState](const std::shared_ptr<CallbackState>& other) {
-                                     return cbState == other.get();
-                                 });
-        if (iter != _sleepersQueue.end()) {
-            invariant(iter == cbState->iter);
-            scheduleIntoPool_inlock(&_sleepersQueue, cbState->iter, std::move(lk));
-        }
+    if (cbState->isSleeping) {
+        // This callback is still in the sleeper queue, so schedule it now rather than when the
+        // alarm fires.
+        scheduleIntoPool_inlock(&_sleepersQueue, cbState->iter, std::move(lk));
     }
 }
 
@@ -416,6 +416,10 @@ void ThreadPoolTaskExecutor::appendConnectionStats(ConnectionPoolStats* stats) c
     _net->appendConnectionStats(stats);
 }
 
+void ThreadPoolTaskExecutor::warmUpConnections(const HostAndPort& hostAndPort) {
+    _net->warmUpConnections(hostAndPort);
+}
+
 StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::enqueueCallbackState_inlock(
     WorkQueue* queue, WorkQueue* wq) {
     if (_inShutdown) {
@@ -471,7 +475,18 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<stdx::mutex> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
-    std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    size_t numTasks = 0;
+    for (auto iter = begin; iter != end; ++iter) {
+        const auto& cbState = *iter;
+        cbState->isSleeping = false;
+        cbState->readySequence = _nextReadySequence++;
+        if (cbState->isNetworkOperation) {
+            _readyRemoteWork.push(cbState);
+        } else {
+            _readyWork.push_back(cbState);
+        }
+        ++numTasks;
+    }
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
@@ -483,8 +498,8 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
         }
     }
 
-    for (const auto& cbState : todo) {
-        const auto status = _pool->schedule([this, cbState] { runCallback(std::move(cbState)); });
+    for (size_t i = 0; i < numTasks; ++i) {
+        const auto status = _pool->schedule([this] { runNextReadyCallback(); });
         if (status == ErrorCodes::ShutdownInProgress)
             break;
         fassert(28735, status);
@@ -492,6 +507,39 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
     _net->signalWorkAvailable();
 }
 
+bool ThreadPoolTaskExecutor::RunsAfter::operator()(
+    const std::shared_ptr<CallbackState>& lhs, const std::shared_ptr<CallbackState>& rhs) const {
+    if (lhs->deadline != rhs->deadline) {
+        return lhs->deadline > rhs->deadline;
+    }
+    return lhs->readySequence > rhs->readySequence;
+}
+
+std::shared_ptr<ThreadPoolTaskExecutor::CallbackState>
+ThreadPoolTaskExecutor::takeNextReady_inlock() {
+    std::shared_ptr<CallbackState> cbState;
+    if (!_readyRemoteWork.empty() && (_readyWork.empty() || !_remoteLaneRanLast)) {
+        cbState = _readyRemoteWork.top();
+        _readyRemoteWork.pop();
+        _remoteLaneRanLast = true;
+    } else if (!_readyWork.empty()) {
+        cbState = std::move(_readyWork.front());
+        _readyWork.pop_front();
+        _remoteLaneRanLast = false;
+    }
+    return cbState;
+}
+
+void ThreadPoolTaskExecutor::runNextReadyCallback() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    auto cbState = takeNextReady_inlock();
+    lk.unlock();
+    // Every item put in the lanes is paired with exactly one pool task, and join() only drains
+    // the lanes once the pool has no more tasks to run.
+    invariant(cbState);
+    runCallback(std::move(cbState));
+}
+
 void ThreadPoolTaskExecutor::runCallback(std::shared_ptr<CallbackState> cbStateArg) {
     CallbackHandle cbHandle;
     setCallbackForHandle(&cbHandle, cbStateArg);
@@ -28,7 +28,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/executor/task_executor.h"
@@ -82,6 +86,7 @@ public:
     void wait(const CallbackHandle& cbHandle) override;
 
     void appendConnectionStats(ConnectionPoolStats* stats) const override;
+    void warmUpConnections(const HostAndPort& hostAndPort) override;
 
     /**
      * Drops all connections to the given host on the network interface.
@@ -94,6 +99,19 @@ private:
     using WorkQueue = stdx::list<std::shared_ptr<CallbackState>>;
     using EventList = stdx::list<std::shared_ptr<EventState>>;
 
+    /**
+     * Orders ready remote command callbacks so that the one with the earliest deadline is at the
+     * top of a priority_queue, ties being broken by the order in which they became ready.
+     */
+    struct RunsAfter {
+        bool operator()(const std::shared_ptr<CallbackState>& lhs,
+                        const std::shared_ptr<CallbackState>& rhs) const;
+    };
+    using RemoteWorkQueue =
+        std::priority_queue<std::shared_ptr<CallbackState>,
+                            std::vector<std::shared_ptr<CallbackState>>,
+                            RunsAfter>;
+
     /**
      * Returns an EventList containing one unsignaled EventState. This is a helper function for
      * performing allocations outside of _mutex, and should only be called by makeSingletonWork and
@@ -122,6 +140,10 @@ private:
     /**
      * Schedules all items from "fromQueue" into the thread pool and moves them into
      * _poolInProgressQueue.
+     *
+     * Each item is put in one of the ready lanes, and one task is scheduled into the thread pool
+     * for it. That task runs whichever item runNextReadyCallback() picks, which is not
+     * necessarily the same one.
      */
     void scheduleIntoPool_inlock(WorkQueue* fromQueue, stdx::unique_lock<stdx::mutex> lk);
 
@@ -142,6 +164,19 @@ private:
                                  const WorkQueue::iterator& end,
                                  stdx::unique_lock<stdx::mutex> lk);
 
+    /**
+     * Removes and returns the next item to run from the ready lanes, or nullptr if both are
+     * empty. When both lanes have items they take turns, so that a burst of remote command
+     * completions cannot hold back plain work items and vice versa.
+     */
+    std::shared_ptr<CallbackState> takeNextReady_inlock();
+
+    /**
+     * Body of the tasks scheduled into the thread pool. Runs the item chosen by
+     * takeNextReady_inlock().
+     */
+    void runNextReadyCallback();
+
     /**
      * Executes the callback specified by "cbState".
      */
@@ -164,6 +199,16 @@ private:
     // Queue containing all items currently scheduled into the thread pool but not yet completed.
     WorkQueue _poolInProgressQueue;
 
+    // Items in _poolInProgressQueue which no pool thread has picked up yet, split in two lanes.
+    // Completions of remote commands run earliest deadline first, everything else in FIFO order.
+    std::deque<std::shared_ptr<CallbackState>> _readyWork;
+    RemoteWorkQueue _readyRemoteWork;
+
+    // Which lane takeNextReady_inlock() took from last, and the counter used to order items
+    // with the same deadline.
+    bool _remoteLaneRanLast = false;
+    uint64_t _nextReadySequence = 0;
+
     // Queue containing all items currently scheduled into the network interface.
     WorkQueue _networkInProgressQueue;
 
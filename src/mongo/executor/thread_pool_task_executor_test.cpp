@@ -79,6 +79,53 @@ TEST_F(ThreadPoolExecutorTest, TimelyCancelationOfScheduleWorkAt) {
     joinExecutorThread();
 }
 
+TEST_F(ThreadPoolExecutorTest, RemoteCommandCompletionsRunEarliestDeadlineFirst) {
+    auto net = getNet();
+    auto& executor = getExecutor();
+    launchExecutorThread();
+
+    // Keep the only pool thread busy while both responses arrive, so that the executor has to
+    // choose which completion to run first.
+    unittest::Barrier barrier{2};
+    ASSERT_OK(executor
+                  .scheduleWork([&barrier](const TaskExecutor::CallbackArgs&) {
+                      barrier.countDownAndWait();
+                      barrier.countDownAndWait();
+                  })
+                  .getStatus());
+    barrier.countDownAndWait();
+
+    std::vector<std::string> completed;
+    auto scheduleCommand = [&](const std::string& name, Milliseconds timeout) {
+        const RemoteCommandRequest request(
+            HostAndPort("localhost", 27017), "mydb", BSON("ping" << 1), nullptr, timeout);
+        ASSERT_OK(executor
+                      .scheduleRemoteCommand(
+                          request,
+                          [&completed, name](const TaskExecutor::RemoteCommandCallbackArgs&) {
+                              completed.push_back(name);
+                          })
+                      .getStatus());
+    };
+    scheduleCommand("late", Seconds(30));
+    scheduleCommand("early", Seconds(10));
+
+    net->enterNetwork();
+    while (net->hasReadyRequests()) {
+        net->scheduleResponse(
+            net->getNextReadyRequest(), net->now(), {ErrorCodes::NoSuchKey, "I'm missing"});
+    }
+    net->runReadyNetworkOperations();
+    net->exitNetwork();
+
+    barrier.countDownAndWait();
+    executor.shutdown();
+    joinExecutorThread();
+    ASSERT_EQUALS(2U, completed.size());
+    ASSERT_EQUALS("early", completed[0]);
+    ASSERT_EQUALS("late", completed[1]);
+}
+
 bool sharedCallbackStateDestroyed = false;
 class SharedCallbackState {
     MONGO_DISALLOW_COPYING(SharedCallbackState);
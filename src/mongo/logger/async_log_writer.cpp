@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logger/async_log_writer.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+namespace logger {
+
+AsyncLogWriter::AsyncLogWriter(RotatableFileWriter* writer,
+                               size_t maxQueuedBytes,
+                               OverflowPolicy overflowPolicy,
+                               Counter64* droppedMessages)
+    : _writer(writer),
+      _maxQueuedBytes(maxQueuedBytes),
+      _overflowPolicy(overflowPolicy),
+      _droppedMessages(droppedMessages),
+      _thread([this] { _writerLoop(); }) {}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    stopAsync();
+}
+
+Status AsyncLogWriter::write(std::string message, bool waitUntilWritten) {
+    const size_t size = message.size();
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    // A message larger than the whole queue is still queued on its own.
+    const auto hasRoom = [&] { return _queue.empty() || _queuedBytes + size <= _maxQueuedBytes; };
+    if (_async && !hasRoom()) {
+        if (_overflowPolicy == OverflowPolicy::kDrop && !waitUntilWritten) {
+            if (_droppedMessages) {
+                _droppedMessages->increment();
+            }
+            return Status::OK();
+        }
+        _writtenCV.wait(lk, [&] { return !_async || hasRoom(); });
+    }
+
+    if (!_async) {
+        // Stay behind the messages the writer thread has yet to write.
+        _writtenCV.wait(lk, [&] { return _numWritten == _numQueued; });
+        lk.unlock();
+        return _writeSync(message);
+    }
+
+    const uint64_t ticket = ++_numQueued;
+    _queuedBytes += size;
+    _queue.push_back(std::move(message));
+    _queuedCV.notify_one();
+
+    if (!waitUntilWritten) {
+        return Status::OK();
+    }
+    _writtenCV.wait(lk, [&] { return _numWritten >= ticket; });
+    return _lastWriteStatus;
+}
+
+void AsyncLogWriter::stopAsync() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (!_async) {
+            return;
+        }
+        _async = false;
+    }
+    _queuedCV.notify_one();
+    _writtenCV.notify_all();
+    _thread.join();
+}
+
+void AsyncLogWriter::_writerLoop() {
+    setThreadName("AsyncLogWriter");
+
+    std::vector<std::string> batch;
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (true) {
+        _queuedCV.wait(lk, [&] { return !_queue.empty() || !_async; });
+        if (_queue.empty()) {
+            // Stopped, and everything queued before has been written.
+            return;
+        }
+
+        batch.swap(_queue);
+        _queuedBytes = 0;
+        lk.unlock();
+
+        Status status = Status::OK();
+        {
+            RotatableFileWriter::Use useWriter(_writer);
+            status = useWriter.status();
+            if (status.isOK()) {
+                for (const auto& message : batch) {
+                    useWriter.stream() << message;
+                }
+                useWriter.stream().flush();
+                status = useWriter.status();
+            }
+        }
+
+        const size_t numWritten = batch.size();
+        batch.clear();
+
+        lk.lock();
+        _numWritten += numWritten;
+        _lastWriteStatus = status;
+        _writtenCV.notify_all();
+    }
+}
+
+Status AsyncLogWriter::_writeSync(const std::string& message) {
+    RotatableFileWriter::Use useWriter(_writer);
+    Status status = useWriter.status();
+    if (!status.isOK()) {
+        return status;
+    }
+    useWriter.stream() << message;
+    useWriter.stream().flush();
+    return useWriter.status();
+}
+
+}  // namespace logger
+}  // namespace mongo
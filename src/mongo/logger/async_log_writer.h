@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+class Counter64;
+
+namespace logger {
+
+class RotatableFileWriter;
+
+/**
+ * Writes log messages to a RotatableFileWriter from a background thread, so that the threads
+ * which log only queue formatted messages and never wait on the file.
+ *
+ * Messages are written in the order they were queued, in batches of everything queued while the
+ * previous batch was being written. Once stopAsync() has been called, or the object destroyed,
+ * messages are written synchronously by the thread that logs them.
+ */
+class AsyncLogWriter {
+    MONGO_DISALLOW_COPYING(AsyncLogWriter);
+
+public:
+    /**
+     * What write() does with a message that does not fit in the queue.
+     */
+    enum class OverflowPolicy {
+        // Drop the message and count it in 'droppedMessages'.
+        kDrop,
+        // Wait until the writer thread has made room for it.
+        kBlock,
+    };
+
+    /**
+     * Starts the writer thread. Does not own "writer", which must outlive this object, nor
+     * "droppedMessages", which may be null.
+     */
+    AsyncLogWriter(RotatableFileWriter* writer,
+                   size_t maxQueuedBytes,
+                   OverflowPolicy overflowPolicy,
+                   Counter64* droppedMessages);
+
+    ~AsyncLogWriter();
+
+    /**
+     * Queues "message" to be written. If "waitUntilWritten" is true, the message is never dropped
+     * and this does not return until it is in the file, and returns the status of writing it.
+     * Otherwise returns Status::OK(), as errors writing the file surface only to later waiters.
+     */
+    Status write(std::string message, bool waitUntilWritten);
+
+    /**
+     * Writes out all queued messages and stops the writer thread.
+     */
+    void stopAsync();
+
+private:
+    void _writerLoop();
+
+    Status _writeSync(const std::string& message);
+
+    RotatableFileWriter* const _writer;
+    const size_t _maxQueuedBytes;
+    const OverflowPolicy _overflowPolicy;
+    Counter64* const _droppedMessages;
+
+    stdx::mutex _mutex;
+    // Signaled when messages are queued or the writer thread should stop.
+    stdx::condition_variable _queuedCV;
+    // Signaled when a batch has been written or the writer thread was told to stop.
+    stdx::condition_variable _writtenCV;
+
+    // Guarded by _mutex.
+    std::vector<std::string> _queue;
+    size_t _queuedBytes = 0;
+    uint64_t _numQueued = 0;   // Messages ever queued.
+    uint64_t _numWritten = 0;  // Messages ever taken off the queue and written.
+    Status _lastWriteStatus = Status::OK();
+    bool _async = true;
+
+    stdx::thread _thread;
+};
+
+}  // namespace logger
+}  // namespace mongo
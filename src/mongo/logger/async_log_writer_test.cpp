@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+using namespace mongo;
+using namespace mongo::logger;
+
+const std::string logFileName("LogTest_AsyncLogWriter.txt");
+
+class AsyncLogWriterTest : public mongo::unittest::Test {
+public:
+    AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+        RotatableFileWriter::Use writerUse(&_fileWriter);
+        ASSERT_OK(writerUse.setFileName(logFileName, false));
+    }
+
+    virtual ~AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+    }
+
+    std::vector<std::string> readLines() {
+        std::vector<std::string> lines;
+        std::ifstream ifs(logFileName.c_str());
+        ASSERT_TRUE(ifs.is_open());
+        std::string line;
+        while (std::getline(ifs, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+protected:
+    RotatableFileWriter _fileWriter;
+    Counter64 _droppedMessages;
+};
+
+TEST_F(AsyncLogWriterTest, WritesMessagesInOrder) {
+    AsyncLogWriter writer(
+        &_fileWriter, 1024 * 1024, AsyncLogWriter::OverflowPolicy::kDrop, &_droppedMessages);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_OK(writer.write(std::to_string(i) + "\n", false));
+    }
+    writer.stopAsync();
+
+    auto lines = readLines();
+    ASSERT_EQ(1000U, lines.size());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(std::to_string(i), lines[i]);
+    }
+    ASSERT_EQ(0, _droppedMessages.get());
+}
+
+TEST_F(AsyncLogWriterTest, MessageWaitedForIsInFileOnReturn) {
+    AsyncLogWriter writer(
+        &_fileWriter, 1024 * 1024, AsyncLogWriter::OverflowPolicy::kDrop, &_droppedMessages);
+    ASSERT_OK(writer.write("first\n", false));
+    ASSERT_OK(writer.write("second\n", true));
+
+    auto lines = readLines();
+    ASSERT_EQ(2U, lines.size());
+    ASSERT_EQ("first", lines[0]);
+    ASSERT_EQ("second", lines[1]);
+}
+
+TEST_F(AsyncLogWriterTest, WritesSynchronouslyOnceStopped) {
+    AsyncLogWriter writer(
+        &_fileWriter, 1024 * 1024, AsyncLogWriter::OverflowPolicy::kDrop, &_droppedMessages);
+    ASSERT_OK(writer.write("queued\n", false));
+    writer.stopAsync();
+    ASSERT_OK(writer.write("synchronous\n", false));
+
+    auto lines = readLines();
+    ASSERT_EQ(2U, lines.size());
+    ASSERT_EQ("queued", lines[0]);
+    ASSERT_EQ("synchronous", lines[1]);
+}
+
+TEST_F(AsyncLogWriterTest, DropsMessagesThatDoNotFitWithDropPolicy) {
+    AsyncLogWriter writer(
+        &_fileWriter, 10, AsyncLogWriter::OverflowPolicy::kDrop, &_droppedMessages);
+    {
+        // Holding the file keeps the writer thread from emptying the queue more than once.
+        RotatableFileWriter::Use writerUse(&_fileWriter);
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_OK(writer.write("message " + std::to_string(i) + "\n", false));
+        }
+    }
+    writer.stopAsync();
+
+    auto lines = readLines();
+    ASSERT_GTE(_droppedMessages.get(), 1);
+    ASSERT_EQ(3U, lines.size() + _droppedMessages.get());
+    ASSERT_EQ("message 0", lines[0]);
+}
+
+TEST_F(AsyncLogWriterTest, WaitsForRoomWithBlockPolicy) {
+    AsyncLogWriter writer(
+        &_fileWriter, 10, AsyncLogWriter::OverflowPolicy::kBlock, &_droppedMessages);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_OK(writer.write(std::to_string(i) + "\n", false));
+    }
+    writer.stopAsync();
+
+    ASSERT_EQ(100U, readLines().size());
+    ASSERT_EQ(0, _droppedMessages.get());
+}
+
+}  // namespace
@@ -565,12 +565,14 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    Decimal128 result;
+    if (_addSmallCoefficients(other, false, roundMode, &result))
+        return result;
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
-    Decimal128::Value value = libraryTypeToValue(current);
-    Decimal128 result(value);
-    return result;
+    return Decimal128(libraryTypeToValue(current));
 }
 
 Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode) const {
@@ -581,12 +583,47 @@ Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::subtract(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    Decimal128 result;
+    if (_addSmallCoefficients(other, true, roundMode, &result))
+        return result;
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 sub = decimal128ToLibraryType(other.getValue());
     current = bid128_sub(current, sub, roundMode, signalingFlags);
-    Decimal128::Value value = libraryTypeToValue(current);
-    Decimal128 result(value);
-    return result;
+    return Decimal128(libraryTypeToValue(current));
+}
+
+bool Decimal128::_addSmallCoefficients(const Decimal128& other,
+                                       bool negateOther,
+                                       RoundingMode roundMode,
+                                       Decimal128* result) const {
+    // Equal canonical combination fields mean equal exponents, and a zero high coefficient means
+    // the coefficient is entirely in the low 64 bits.
+    const uint64_t combination = _getCombinationField();
+    if (combination >= kCombinationNonCanonical || combination != other._getCombinationField() ||
+        getCoefficientHigh() != 0 || other.getCoefficientHigh() != 0)
+        return false;
+
+    const uint64_t exponent = getBiasedExponent();
+    const uint64_t sign = _value.high64 >> kSignFieldPos;
+    const uint64_t otherSign = (other._value.high64 >> kSignFieldPos) ^ (negateOther ? 1 : 0);
+    const uint64_t lhs = _value.low64;
+    const uint64_t rhs = other._value.low64;
+
+    if (sign == otherSign) {
+        // The sum of the magnitudes is below 2^65, far less than 34 digits, so it is exact.
+        const uint64_t low = lhs + rhs;
+        *result = Decimal128(sign, exponent, low < lhs ? 1 : 0, low);
+    } else if (lhs > rhs) {
+        *result = Decimal128(sign, exponent, 0, lhs - rhs);
+    } else if (lhs < rhs) {
+        *result = Decimal128(otherSign, exponent, 0, rhs - lhs);
+    } else {
+        // IEEE 754-2008 gives an exact zero sum of operands of opposite signs a positive sign in
+        // every rounding mode but rounding toward negative.
+        *result = Decimal128(roundMode == kRoundTowardNegative ? 1 : 0, exponent, 0, 0);
+    }
+    return true;
 }
 
 Decimal128 Decimal128::multiply(const Decimal128& other, RoundingMode roundMode) const {
@@ -426,6 +426,18 @@ private:
         return (_value.high64 >> kCombinationFieldPos) & kCombinationFieldMask;
     }
 
+    /**
+     * Adds 'other', or subtracts it if 'negateOther' is true, as integer arithmetic when both
+     * operands are finite, share their exponent and have coefficients that fit in 64 bits, as the
+     * values of ledgers with a fixed number of decimal places do. Such a result is always exact,
+     * so 'roundMode' only decides the sign of a zero result. Returns false, leaving 'result'
+     * alone, for operands of any other form.
+     */
+    bool _addSmallCoefficients(const Decimal128& other,
+                               bool negateOther,
+                               RoundingMode roundMode,
+                               Decimal128* result) const;
+
     Value _value;
 };
 }  // namespace mongo
@@ -1027,6 +1027,54 @@ TEST(Decimal128Test, TestDecimal128SubtractionCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+TEST(Decimal128Test, TestDecimal128AdditionSameExponent) {
+    Decimal128 d1("12.34");
+    Decimal128 d2("-0.35");
+    ASSERT_TRUE(d1.add(d2).isBinaryEqual(Decimal128("11.99")));
+    ASSERT_TRUE(d2.add(d1).isBinaryEqual(Decimal128("11.99")));
+    ASSERT_TRUE(d1.add(d1).isBinaryEqual(Decimal128("24.68")));
+    ASSERT_TRUE(d2.add(d2).isBinaryEqual(Decimal128("-0.70")));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionSameExponentCarriesPast64Bits) {
+    Decimal128 d1("18446744073709551615");  // 2^64 - 1
+    Decimal128 d2("1");
+    std::uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = d1.add(d2, &sigFlags);
+    ASSERT_TRUE(result.isBinaryEqual(Decimal128("18446744073709551616")));
+    ASSERT_EQUALS(1u, result.getCoefficientHigh());
+    ASSERT_EQUALS(0u, result.getCoefficientLow());
+    ASSERT_EQUALS(sigFlags, Decimal128::SignalingFlag::kNoFlag);
+}
+
+TEST(Decimal128Test, TestDecimal128SubtractionSameExponent) {
+    Decimal128 d1("12.34");
+    Decimal128 d2("0.35");
+    ASSERT_TRUE(d1.subtract(d2).isBinaryEqual(Decimal128("11.99")));
+    ASSERT_TRUE(d2.subtract(d1).isBinaryEqual(Decimal128("-11.99")));
+    ASSERT_TRUE(d1.negate().subtract(d2).isBinaryEqual(Decimal128("-12.69")));
+}
+
+TEST(Decimal128Test, TestDecimal128ExactZeroSumSign) {
+    Decimal128 d1("1.25");
+    Decimal128 d2("-1.25");
+    ASSERT_TRUE(d1.add(d2).isBinaryEqual(Decimal128("0.00")));
+    ASSERT_TRUE(d1.subtract(d1).isBinaryEqual(Decimal128("0.00")));
+    ASSERT_TRUE(d1.add(d2, Decimal128::kRoundTowardNegative).isBinaryEqual(Decimal128("-0.00")));
+    ASSERT_TRUE(d2.subtract(d2, Decimal128::kRoundTowardNegative)
+                    .isBinaryEqual(Decimal128("-0.00")));
+    ASSERT_TRUE(
+        Decimal128("-0.00").add(Decimal128("-0.00")).isBinaryEqual(Decimal128("-0.00")));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionSameExponentSpecialValues) {
+    Decimal128 d1("1");
+    ASSERT_TRUE(d1.add(Decimal128::kPositiveInfinity).isInfinite());
+    ASSERT_TRUE(Decimal128::kNegativeInfinity.add(d1).isInfinite());
+    ASSERT_TRUE(d1.add(Decimal128::kPositiveNaN).isNaN());
+    ASSERT_TRUE(Decimal128::kPositiveInfinity.subtract(Decimal128::kPositiveInfinity).isNaN());
+}
+
 TEST(Decimal128Test, TestDecimal128MultiplicationCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
@@ -33,6 +33,8 @@
 #include "mongo/s/async_requests_sender.h"
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -49,6 +51,15 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// The targeter picks randomly among the hosts which match the read preference, so this is how
+// many times to ask it for a host other than the one running the request before giving up on
+// hedging.
+const int kMaxHedgeHostSelectionAttempts = 3;
+
+// If positive, a request with a read preference which allows secondaries is also sent to a second
+// host of its shard when it has not received a response after this many milliseconds.
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryHedgedReadDelayMS, int, 0);
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
@@ -61,6 +72,10 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
         _remotes.emplace_back(request.shardId, request.cmdObj);
     }
 
+    if (_readPreference.pref != ReadPreference::PrimaryOnly) {
+        _hedgeDelay = Milliseconds(std::max(0, internalQueryHedgedReadDelayMS.load()));
+    }
+
     // Initialize command metadata to handle the read preference.
     BSONObjBuilder metadataBuilder;
     rpc::ServerSelectionMetadata metadata(_readPreference.pref != ReadPreference::PrimaryOnly,
@@ -86,6 +101,24 @@ AsyncRequestsSender::~AsyncRequestsSender() {
     while (!done()) {
         next();
     }
+
+    // Every remote has its response, but the request which lost a hedge race and the hedge timers
+    // may still have callbacks to run.
+    std::vector<executor::TaskExecutor::CallbackHandle> outstanding;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (const auto& remote : _remotes) {
+            for (const auto& cbHandle :
+                 {remote.cbHandle, remote.hedgeCbHandle, remote.hedgeTimerCbHandle}) {
+                if (cbHandle.isValid()) {
+                    outstanding.push_back(cbHandle);
+                }
+            }
+        }
+    }
+    for (const auto& cbHandle : outstanding) {
+        _executor->wait(cbHandle);
+    }
 }
 
 AsyncRequestsSender::Response AsyncRequestsSender::next() {
@@ -96,6 +129,7 @@ AsyncRequestsSender::Response AsyncRequestsSender::next() {
     boost::optional<Response> readyResponse;
     while (!(readyResponse = _ready())) {
         // Otherwise, wait for some response to be received.
+        WaitEventScope waitForResponse(WaitEvent::kNetwork);
         if (_checkForInterrupt) {
             try {
                 _notification->get(_opCtx);
@@ -131,8 +165,11 @@ void AsyncRequestsSender::_cancelPendingRequests() {
 
     // Cancel all outstanding requests so they return immediately.
     for (auto& remote : _remotes) {
-        if (remote.cbHandle.isValid()) {
-            _executor->cancel(remote.cbHandle);
+        for (const auto& cbHandle :
+             {remote.cbHandle, remote.hedgeCbHandle, remote.hedgeTimerCbHandle}) {
+            if (cbHandle.isValid()) {
+                _executor->cancel(cbHandle);
+            }
         }
     }
 }
@@ -236,42 +273,170 @@ Status AsyncRequestsSender::_scheduleRequest_inlock(size_t remoteIndex) {
     executor::RemoteCommandRequest request(
         *remote.shardHostAndPort, _db.toString(), remote.cmdObj, _metadataObj, _opCtx);
 
-    auto callbackStatus = _executor->scheduleRemoteCommand(
-        request,
-        stdx::bind(
-            &AsyncRequestsSender::_handleResponse, this, stdx::placeholders::_1, remoteIndex));
+    const auto shard = remote.getShard();
+    auto callbackStatus =
+        _scheduleRemoteCommand_inlock(request,
+                                      shard ? shard->getTargeter() : nullptr,
+                                      remoteIndex,
+                                      remote.retryCount,
+                                      false);
     if (!callbackStatus.isOK()) {
         return callbackStatus.getStatus();
     }
 
     remote.cbHandle = callbackStatus.getValue();
+
+    // Only one hedged request and timer may be outstanding per remote, so a retry sent while
+    // those of an earlier attempt are still being canceled is not hedged.
+    if (_hedgeDelay > Milliseconds(0) && !remote.hedgeCbHandle.isValid() &&
+        !remote.hedgeTimerCbHandle.isValid()) {
+        auto timerStatus =
+            _executor->scheduleWorkAt(_executor->now() + _hedgeDelay,
+                                      stdx::bind(&AsyncRequestsSender::_handleHedgeTimer,
+                                                 this,
+                                                 stdx::placeholders::_1,
+                                                 remoteIndex,
+                                                 remote.retryCount));
+        if (timerStatus.isOK()) {
+            remote.hedgeTimerCbHandle = timerStatus.getValue();
+        }
+    }
+
     return Status::OK();
 }
 
+StatusWith<executor::TaskExecutor::CallbackHandle>
+AsyncRequestsSender::_scheduleRemoteCommand_inlock(const executor::RemoteCommandRequest& request,
+                                                   std::shared_ptr<RemoteCommandTargeter> targeter,
+                                                   size_t remoteIndex,
+                                                   int attempt,
+                                                   bool isHedge) {
+    if (targeter) {
+        targeter->markRequestStarted(request.target);
+    }
+
+    // The executor runs the callback for every scheduled request, including canceled ones, so
+    // each started request is reported as finished exactly once.
+    auto callbackStatus = _executor->scheduleRemoteCommand(
+        request,
+        [this, targeter, remoteIndex, attempt, isHedge](
+            const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+            if (targeter) {
+                targeter->markRequestFinished(cbData.request.target);
+            }
+            _handleResponse(cbData, remoteIndex, attempt, isHedge);
+        });
+    if (!callbackStatus.isOK() && targeter) {
+        targeter->markRequestFinished(request.target);
+    }
+
+    return callbackStatus;
+}
+
 void AsyncRequestsSender::_handleResponse(
-    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData, size_t remoteIndex) {
+    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
+    size_t remoteIndex,
+    int attempt,
+    bool isHedge) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     auto& remote = _remotes[remoteIndex];
-    invariant(!remote.swResponse);
-
-    // Clear the callback handle. This indicates that we are no longer waiting on a response from
-    // 'remote'.
-    remote.cbHandle = executor::TaskExecutor::CallbackHandle();
 
-    // Store the response or error.
-    if (cbData.response.status.isOK()) {
-        remote.swResponse = std::move(cbData.response);
+    // Clear the callback handle. This indicates that we are no longer waiting on this response
+    // from 'remote'.
+    if (isHedge) {
+        remote.hedgeCbHandle = executor::TaskExecutor::CallbackHandle();
     } else {
-        remote.swResponse = std::move(cbData.response.status);
+        remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+    }
+
+    // Only the first response of the latest attempt is kept. Any other is from the request which
+    // lost a hedge race, and was most likely canceled.
+    if (!remote.swResponse && attempt == remote.retryCount) {
+        if (cbData.response.status.isOK()) {
+            remote.swResponse = std::move(cbData.response);
+        } else {
+            remote.swResponse = std::move(cbData.response.status);
+        }
+
+        if (isHedge) {
+            remote.shardHostAndPort = remote.hedgeHostAndPort;
+        }
+
+        for (const auto& cbHandle :
+             {remote.cbHandle, remote.hedgeCbHandle, remote.hedgeTimerCbHandle}) {
+            if (cbHandle.isValid()) {
+                _executor->cancel(cbHandle);
+            }
+        }
     }
 
-    // Signal the notification indicating that a remote received a response.
+    // Signal the notification indicating that a remote received a response. This is also done for
+    // a dropped response, because a retry of the remote may be waiting for it to be able to send.
     if (!*_notification) {
         _notification->set();
     }
 }
 
+void AsyncRequestsSender::_handleHedgeTimer(const executor::TaskExecutor::CallbackArgs& cbData,
+                                            size_t remoteIndex,
+                                            int attempt) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    auto& remote = _remotes[remoteIndex];
+    remote.hedgeTimerCbHandle = executor::TaskExecutor::CallbackHandle();
+
+    const auto stillWaiting = [&] {
+        return !_stopRetrying && !remote.swResponse && remote.cbHandle.isValid() &&
+            !remote.hedgeCbHandle.isValid() && attempt == remote.retryCount;
+    };
+
+    if (!cbData.status.isOK() || !stillWaiting()) {
+        return;
+    }
+
+    const auto shard = remote.getShard();
+    if (!shard) {
+        return;
+    }
+    const HostAndPort host = *remote.shardHostAndPort;
+
+    // Selecting a host may contact the replica set, so do it without holding the mutex.
+    lk.unlock();
+
+    boost::optional<HostAndPort> hedgeHost;
+    for (int i = 0; i < kMaxHedgeHostSelectionAttempts && !hedgeHost; ++i) {
+        auto findHostStatus = shard->getTargeter()->findHostNoWait(_readPreference);
+        if (!findHostStatus.isOK()) {
+            break;
+        }
+        if (findHostStatus.getValue() != host) {
+            hedgeHost = std::move(findHostStatus.getValue());
+        }
+    }
+
+    lk.lock();
+
+    if (!hedgeHost || !stillWaiting()) {
+        return;
+    }
+
+    executor::RemoteCommandRequest request(
+        *hedgeHost, _db.toString(), remote.cmdObj, _metadataObj, _opCtx);
+
+    auto callbackStatus =
+        _scheduleRemoteCommand_inlock(request, shard->getTargeter(), remoteIndex, attempt, true);
+    if (!callbackStatus.isOK()) {
+        return;
+    }
+
+    LOG(1) << "Command to remote " << remote.shardId << " at host " << host
+           << " has not responded after " << _hedgeDelay << ", also sending it to " << *hedgeHost;
+
+    remote.hedgeHostAndPort = std::move(hedgeHost);
+    remote.hedgeCbHandle = callbackStatus.getValue();
+}
+
 AsyncRequestsSender::Request::Request(ShardId shardId, BSONObj cmdObj)
     : shardId(shardId), cmdObj(cmdObj) {}
 
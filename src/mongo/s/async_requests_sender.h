@@ -77,6 +77,11 @@ namespace mongo {
  *     }
  * }
  *
+ * If the read preference allows secondaries and internalQueryHedgedReadDelayMS is positive, a
+ * request which has not received a response after that delay is also sent to a second eligible
+ * host of its shard. The first of the two responses is the one returned and the other request is
+ * canceled, so that a single slow host does not hold up the whole scatter-gather.
+ *
  * Does not throw exceptions.
  */
 class AsyncRequestsSender {
@@ -198,6 +203,14 @@ private:
         // The callback handle to an outstanding request for this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
+        // The host and callback handle of the hedged copy of the outstanding request, if one has
+        // been sent.
+        boost::optional<HostAndPort> hedgeHostAndPort;
+        executor::TaskExecutor::CallbackHandle hedgeCbHandle;
+
+        // The callback handle of the timer which sends the hedged request.
+        executor::TaskExecutor::CallbackHandle hedgeTimerCbHandle;
+
         // Whether this remote's result has been returned.
         bool done = false;
     };
@@ -238,16 +251,41 @@ private:
      */
     Status _scheduleRequest_inlock(size_t remoteIndex);
 
+    /**
+     * Schedules 'request' with _handleResponse as its callback. The request is reported to
+     * 'targeter', if there is one, as in flight until the callback runs.
+     */
+    StatusWith<executor::TaskExecutor::CallbackHandle> _scheduleRemoteCommand_inlock(
+        const executor::RemoteCommandRequest& request,
+        std::shared_ptr<RemoteCommandTargeter> targeter,
+        size_t remoteIndex,
+        int attempt,
+        bool isHedge);
+
     /**
      * The callback for a remote command.
      *
      * 'remoteIndex' is the position of the relevant remote node in '_remotes', and therefore
      * indicates which node the response came from and where the response should be buffered.
+     * 'attempt' is the retry count of the remote when the command was sent and 'isHedge' tells
+     * whether it was the hedged copy of the request.
      *
-     * Stores the response or error in the remote and signals the notification.
+     * Stores the response or error in the remote, unless the remote already has a response or
+     * has since been retried, and signals the notification. The first response of an attempt
+     * cancels the other request of that attempt.
      */
     void _handleResponse(const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
-                         size_t remoteIndex);
+                         size_t remoteIndex,
+                         int attempt,
+                         bool isHedge);
+
+    /**
+     * The callback for the hedge timer of a remote. If the request sent on attempt 'attempt' is
+     * still waiting for its response, sends a copy of it to another host of the shard.
+     */
+    void _handleHedgeTimer(const executor::TaskExecutor::CallbackArgs& cbData,
+                           size_t remoteIndex,
+                           int attempt);
 
     // Not owned here.
     OperationContext* _opCtx;
@@ -265,6 +303,9 @@ private:
     // The readPreference to use for all requests.
     ReadPreferenceSetting _readPreference;
 
+    // How long to wait for a response before hedging a request. Zero if requests are not hedged.
+    Milliseconds _hedgeDelay{0};
+
     // Used to determine whether to check for interrupt when waiting for a remote to be ready.
     // Set to false if we are interrupted, so that we can still wait for callbacks to complete.
     // This is only accessed by the thread in next().
@@ -157,6 +157,7 @@ StatusWith<ChunkVersion> createFirstChunks(OperationContext* opCtx,
                 shardKeyPattern,
                 ChunkRange(keyPattern.globalMin(), keyPattern.globalMax()),
                 Grid::get(opCtx)->getBalancerConfiguration()->getMaxChunkSizeBytes(),
+                0,
                 0));
         }
 
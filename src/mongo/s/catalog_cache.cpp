@@ -53,41 +53,6 @@ namespace {
 // server is found to be inconsistent.
 const int kMaxInconsistentRoutingInfoRefreshAttempts = 3;
 
-/**
- * This is an adapter so we can use config diffs - mongos and mongod do them slightly differently.
- *
- * The mongos adapter here tracks all shards, and stores ranges by (max, Chunk) in the map.
- */
-class CMConfigDiffTracker : public ConfigDiffTracker<std::shared_ptr<Chunk>> {
-public:
-    CMConfigDiffTracker(const NamespaceString& nss,
-                        RangeMap* currMap,
-                        ChunkVersion* maxVersion,
-                        MaxChunkVersionMap* maxShardVersions)
-        : ConfigDiffTracker<std::shared_ptr<Chunk>>(
-              nss.ns(), currMap, maxVersion, maxShardVersions) {}
-
-    bool isTracked(const ChunkType& chunk) const final {
-        // Mongos tracks all shards
-        return true;
-    }
-
-    bool isMinKeyIndexed() const final {
-        return false;
-    }
-
-    std::pair<BSONObj, std::shared_ptr<Chunk>> rangeFor(OperationContext* opCtx,
-                                                        const ChunkType& chunk) const final {
-        return std::make_pair(chunk.getMax(), std::make_shared<Chunk>(chunk));
-    }
-
-    ShardId shardFor(OperationContext* opCtx, const ShardId& shardId) const final {
-        const auto shard =
-            uassertStatusOK(Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId));
-        return shard->getId();
-    }
-};
-
 }  // namespace
 
 CatalogCache::CatalogCache() = default;
@@ -251,6 +216,25 @@ void CatalogCache::invalidateShardedCollection(StringData ns) {
     invalidateShardedCollection(NamespaceString(ns));
 }
 
+bool CatalogCache::invalidateShardedCollectionIfCached(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lg(_mutex);
+
+    auto it = _databases.find(nss.db());
+    if (it == _databases.end()) {
+        return false;
+    }
+
+    auto& collections = it->second->collections;
+
+    auto itColl = collections.find(nss.ns());
+    if (itColl == collections.end()) {
+        return false;
+    }
+
+    itColl->second.needsRefresh = true;
+    return true;
+}
+
 void CatalogCache::purgeDatabase(StringData dbName) {
     stdx::lock_guard<stdx::mutex> lg(_mutex);
 
@@ -287,8 +271,6 @@ std::shared_ptr<ChunkManager> CatalogCache::refreshCollectionRoutingInfo(
     }
 
     ChunkVersion startingCollectionVersion;
-    ChunkMap chunkMap =
-        SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<std::shared_ptr<Chunk>>();
 
     if (!existingRoutingInfo) {
         // If we don't have a basis chunk manager, do a full refresh
@@ -296,18 +278,18 @@ std::shared_ptr<ChunkManager> CatalogCache::refreshCollectionRoutingInfo(
     } else if (existingRoutingInfo->getVersion().epoch() != coll.getEpoch()) {
         // If the collection's epoch has changed, do a full refresh
         startingCollectionVersion = ChunkVersion(0, 0, coll.getEpoch());
+        existingRoutingInfo = nullptr;
     } else {
         // Otherwise do a partial refresh
         startingCollectionVersion = existingRoutingInfo->getVersion();
-        chunkMap = existingRoutingInfo->chunkMap();
     }
 
     log() << "Refreshing chunks for collection " << nss << " based on version "
           << startingCollectionVersion;
 
-    // Diff tracker should *always* find at least one chunk if collection exists
-    const auto diffQuery =
-        CMConfigDiffTracker::createConfigDiffQuery(nss, startingCollectionVersion);
+    // The query should *always* find at least one chunk if collection exists
+    const auto diffQuery = ConfigDiffTracker<std::shared_ptr<Chunk>>::createConfigDiffQuery(
+        nss, startingCollectionVersion);
 
     // Query the chunks which have changed
     std::vector<ChunkType> newChunks;
@@ -321,14 +303,7 @@ std::shared_ptr<ChunkManager> CatalogCache::refreshCollectionRoutingInfo(
         &opTime,
         repl::ReadConcernLevel::kMajorityReadConcern));
 
-    ChunkVersion collectionVersion = startingCollectionVersion;
-
-    ShardVersionMap unusedShardVersions;
-    CMConfigDiffTracker differ(nss, &chunkMap, &collectionVersion, &unusedShardVersions);
-
-    const int diffsApplied = differ.calculateConfigDiff(opCtx, newChunks);
-
-    if (diffsApplied < 1) {
+    const auto failRefresh = [&] {
         log() << "Refresh for collection " << nss << " took " << t.millis()
               << " ms and failed because the collection's "
                  "sharding metadata either changed in between or "
@@ -336,9 +311,40 @@ std::shared_ptr<ChunkManager> CatalogCache::refreshCollectionRoutingInfo(
 
         uasserted(ErrorCodes::ConflictingOperationInProgress,
                   "Collection sharding status changed during refresh or became corrupted");
+    };
+
+    if (newChunks.empty()) {
+        failRefresh();
+    }
+
+    ChunkVersion collectionVersion = startingCollectionVersion;
+
+    std::vector<std::shared_ptr<Chunk>> changedChunks;
+    changedChunks.reserve(newChunks.size());
+
+    for (const auto& chunk : newChunks) {
+        const ChunkVersion& chunkVersion = chunk.getVersion();
+
+        if (!chunkVersion.hasEqualEpoch(startingCollectionVersion.epoch())) {
+            warning() << "got invalid chunk version " << chunkVersion << " in document "
+                      << redact(chunk.toString())
+                      << " when trying to load differing chunks at version "
+                      << startingCollectionVersion;
+
+            failRefresh();
+        }
+
+        if (chunkVersion > collectionVersion) {
+            collectionVersion = chunkVersion;
+        }
+
+        // Make sure the shard is known, which reloads the shard registry if it is not
+        uassertStatusOK(Grid::get(opCtx)->shardRegistry()->getShard(opCtx, chunk.getShard()));
+
+        changedChunks.push_back(std::make_shared<Chunk>(chunk));
     }
 
-    // If at least one diff was applied, the metadata is correct, but it might not have changed so
+    // If at least one chunk was found, the metadata is correct, but it might not have changed so
     // in this case there is no need to recreate the chunk manager.
     //
     // NOTE: In addition to the above statement, it is also important that we return the same chunk
@@ -352,22 +358,34 @@ std::shared_ptr<ChunkManager> CatalogCache::refreshCollectionRoutingInfo(
         return existingRoutingInfo;
     }
 
-    std::unique_ptr<CollatorInterface> defaultCollator;
-    if (!coll.getDefaultCollation().isEmpty()) {
-        // The collation should have been validated upon collection creation
-        defaultCollator = uassertStatusOK(CollatorFactoryInterface::get(opCtx->getServiceContext())
-                                              ->makeFromBSON(coll.getDefaultCollation()));
+    std::unique_ptr<ChunkManager> chunkManager;
+
+    if (existingRoutingInfo) {
+        // Only the segments of the chunk map which hold changed chunks are copied
+        chunkManager = existingRoutingInfo->makeUpdated(changedChunks, collectionVersion);
+    } else {
+        std::unique_ptr<CollatorInterface> defaultCollator;
+        if (!coll.getDefaultCollation().isEmpty()) {
+            // The collation should have been validated upon collection creation
+            defaultCollator =
+                uassertStatusOK(CollatorFactoryInterface::get(opCtx->getServiceContext())
+                                    ->makeFromBSON(coll.getDefaultCollation()));
+        }
+
+        std::vector<std::shared_ptr<Chunk>> unusedRemovedChunks;
+        chunkManager = stdx::make_unique<ChunkManager>(
+            nss,
+            coll.getKeyPattern(),
+            std::move(defaultCollator),
+            coll.getUnique(),
+            ChunkMap().makeUpdated(std::move(changedChunks), &unusedRemovedChunks),
+            collectionVersion);
     }
 
     log() << "Refresh for collection " << nss << " took " << t.millis() << " ms and found version "
           << collectionVersion;
 
-    return stdx::make_unique<ChunkManager>(nss,
-                                           coll.getKeyPattern(),
-                                           std::move(defaultCollator),
-                                           coll.getUnique(),
-                                           std::move(chunkMap),
-                                           collectionVersion);
+    return std::move(chunkManager);
 }
 
 std::shared_ptr<CatalogCache::DatabaseInfoEntry> CatalogCache::_getDatabase_inlock(
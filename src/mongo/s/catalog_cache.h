@@ -101,6 +101,13 @@ public:
     void invalidateShardedCollection(const NamespaceString& nss);
     void invalidateShardedCollection(StringData ns);
 
+    /**
+     * Non-blocking method, which causes the routing table for the specified namespace to be
+     * refreshed the next time getCollectionRoutingInfo is called, but only if the cache already
+     * has an entry for it. Returns whether it did.
+     */
+    bool invalidateShardedCollectionIfCached(const NamespaceString& nss);
+
     /**
      * Blocking method, which removes the entire specified database (including its collections) from
      * the cache.
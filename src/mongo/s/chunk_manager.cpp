@@ -36,6 +36,7 @@
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/index_bounds_builder.h"
@@ -75,8 +76,44 @@ ChunkManager::ChunkManager(NamespaceString nss,
       _chunkMapViews(_constructChunkMapViews(collectionVersion.epoch(), _chunkMap)),
       _collectionVersion(collectionVersion) {}
 
+ChunkManager::ChunkManager(NamespaceString nss,
+                           KeyPattern shardKeyPattern,
+                           std::unique_ptr<CollatorInterface> defaultCollator,
+                           bool unique,
+                           ChunkMap chunkMap,
+                           ChunkMapViews chunkMapViews,
+                           ChunkVersion collectionVersion)
+    : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
+      _nss(std::move(nss)),
+      _shardKeyPattern(shardKeyPattern),
+      _defaultCollator(std::move(defaultCollator)),
+      _unique(unique),
+      _chunkMap(std::move(chunkMap)),
+      _chunkMapViews(std::move(chunkMapViews)),
+      _collectionVersion(collectionVersion) {}
+
 ChunkManager::~ChunkManager() = default;
 
+std::unique_ptr<ChunkManager> ChunkManager::makeUpdated(
+    const std::vector<std::shared_ptr<Chunk>>& changedChunks,
+    ChunkVersion collectionVersion) const {
+    invariant(collectionVersion.epoch() == _collectionVersion.epoch());
+
+    std::vector<std::shared_ptr<Chunk>> removedChunks;
+    ChunkMap chunkMap = _chunkMap.makeUpdated(changedChunks, &removedChunks);
+    ChunkMapViews chunkMapViews =
+        _updateChunkMapViews(chunkMap, changedChunks, removedChunks, collectionVersion.epoch());
+
+    return std::unique_ptr<ChunkManager>(
+        new ChunkManager(_nss,
+                         _shardKeyPattern.getKeyPattern(),
+                         _defaultCollator ? _defaultCollator->clone() : nullptr,
+                         _unique,
+                         std::move(chunkMap),
+                         std::move(chunkMapViews),
+                         collectionVersion));
+}
+
 std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardKey,
                                                            const BSONObj& collation) const {
     const bool hasSimpleCollation = (collation.isEmpty() && !_defaultCollator) ||
@@ -164,26 +201,105 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     // For now, we satisfy that assumption by adding a shard with no matches rather than returning
     // an empty set of shards.
     if (shardIds->empty()) {
-        shardIds->insert(_chunkMapViews.chunkRangeMap.begin()->second.shardId);
+        shardIds->insert(_chunkMap.begin()->second->getShardId());
+    }
+}
+
+std::map<ShardId, BSONObj> ChunkManager::splitShardKeyInQueryByShard(
+    const BSONObj& query, const BSONObj& collation) const {
+    const BSONObj& keyPattern = _shardKeyPattern.toBSON();
+    if (keyPattern.nFields() != 1) {
+        return {};
+    }
+
+    const BSONElement patternEl = keyPattern.firstElement();
+
+    // Only a predicate of the form {<shard key>: {$in: [...]}} at the top level of the query can
+    // be split, because the other top-level predicates are ANDed with it
+    BSONElement inElt;
+    for (const auto& elt : query) {
+        if (elt.fieldNameStringData() != patternEl.fieldNameStringData()) {
+            continue;
+        }
+
+        if (!inElt.eoo() || elt.type() != Object || elt.embeddedObject().nFields() != 1 ||
+            elt.embeddedObject().firstElementFieldName() != StringData("$in") ||
+            elt.embeddedObject().firstElement().type() != Array) {
+            return {};
+        }
+
+        inElt = elt.embeddedObject().firstElement();
+    }
+
+    if (inElt.eoo()) {
+        return {};
+    }
+
+    std::map<ShardId, BSONArrayBuilder> valuesByShard;
+
+    for (const auto& value : inElt.embeddedObject()) {
+        // Regular expressions and arrays do not match by equality on the shard key value
+        if (value.type() == RegEx || value.type() == Array || value.type() == Undefined ||
+            (value.type() == Object && !value.embeddedObject().okForStorage())) {
+            return {};
+        }
+
+        BSONObjBuilder shardKeyBuilder;
+        if (_shardKeyPattern.isHashedPattern()) {
+            shardKeyBuilder.append(
+                patternEl.fieldName(),
+                BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+        } else {
+            shardKeyBuilder.appendAs(value, patternEl.fieldName());
+        }
+
+        std::shared_ptr<Chunk> chunk;
+        try {
+            chunk = findIntersectingChunk(shardKeyBuilder.obj(), collation);
+        } catch (const DBException&) {
+            // The value cannot be targeted by equality, for example because of the collation
+            return {};
+        }
+
+        valuesByShard[chunk->getShardId()].append(value);
+    }
+
+    std::map<ShardId, BSONObj> queriesByShard;
+
+    for (auto& shardValues : valuesByShard) {
+        const BSONArray values = shardValues.second.arr();
+
+        BSONObjBuilder queryBuilder;
+        for (const auto& elt : query) {
+            if (elt.fieldNameStringData() == patternEl.fieldNameStringData()) {
+                queryBuilder.append(elt.fieldName(), BSON("$in" << values));
+            } else {
+                queryBuilder.append(elt);
+            }
+        }
+
+        queriesByShard.emplace(shardValues.first, queryBuilder.obj());
     }
+
+    return queriesByShard;
 }
 
 void ChunkManager::getShardIdsForRange(const BSONObj& min,
                                        const BSONObj& max,
                                        std::set<ShardId>* shardIds) const {
-    auto it = _chunkMapViews.chunkRangeMap.upper_bound(min);
-    auto end = _chunkMapViews.chunkRangeMap.upper_bound(max);
+    auto it = _chunkMap.upper_bound(min);
+    auto end = _chunkMap.upper_bound(max);
 
-    // The chunk range map must always cover the entire key space
-    invariant(it != _chunkMapViews.chunkRangeMap.end());
+    // The chunk map must always cover the entire key space
+    invariant(it != _chunkMap.end());
 
     // We need to include the last chunk
-    if (end != _chunkMapViews.chunkRangeMap.cend()) {
+    if (end != _chunkMap.cend()) {
         ++end;
     }
 
     for (; it != end; ++it) {
-        shardIds->insert(it->second.shardId);
+        shardIds->insert(it->second->getShardId());
 
         // No need to iterate through the rest of the ranges, because we already know we need to use
         // all shards.
@@ -344,78 +460,147 @@ ChunkManager::ChunkMapViews ChunkManager::_constructChunkMapViews(const OID& epo
                                                                   const ChunkMap& chunkMap) {
     invariant(!chunkMap.empty());
 
-    ChunkRangeMap chunkRangeMap =
-        SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ShardAndChunkRange>();
+    ChunkMapViews views;
 
-    ShardVersionMap shardVersions;
+    const Chunk* prevChunk = nullptr;
+    for (const auto& entry : chunkMap) {
+        const auto& chunk = entry.second;
 
-    ChunkMap::const_iterator current = chunkMap.cbegin();
-
-    while (current != chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+        if (prevChunk) {
+            // Make sure there are no gaps in the ranges
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << ChunkRange(prevChunk->getMin(), prevChunk->getMax())
+                                         .toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(prevChunk->getMax() ==
+                                                                chunk->getMin()));
+        }
+        prevChunk = chunk.get();
 
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(firstChunkInRange->getShardId());
-        if (shardVersionIt == shardVersions.end()) {
+        // Tracks the max shard version for the shard on which the chunk resides
+        auto shardVersionIt = views.shardVersions.find(chunk->getShardId());
+        if (shardVersionIt == views.shardVersions.end()) {
             shardVersionIt =
-                shardVersions.emplace(firstChunkInRange->getShardId(), ChunkVersion(0, 0, epoch))
-                    .first;
+                views.shardVersions.emplace(chunk->getShardId(), ChunkVersion(0, 0, epoch)).first;
         }
 
-        auto& maxShardVersion = shardVersionIt->second;
-
-        current = std::find_if(
-            current,
-            chunkMap.cend(),
-            [&firstChunkInRange, &maxShardVersion](const ChunkMap::value_type& chunkMapEntry) {
-                const auto& currentChunk = chunkMapEntry.second;
-
-                if (currentChunk->getShardId() != firstChunkInRange->getShardId())
-                    return true;
+        if (chunk->getLastmod() > shardVersionIt->second) {
+            shardVersionIt->second = chunk->getLastmod();
+        }
 
-                if (currentChunk->getLastmod() > maxShardVersion)
-                    maxShardVersion = currentChunk->getLastmod();
+        ++views.numChunksPerShard[chunk->getShardId()];
 
-                return false;
-            });
+        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
+        // somewhere, which should have been caught at chunk load time
+        invariant(shardVersionIt->second.isSet());
+    }
 
-        const auto rangeLast = std::prev(current);
+    invariant(!views.shardVersions.empty());
 
-        const BSONObj rangeMin = firstChunkInRange->getMin();
-        const BSONObj rangeMax = rangeLast->second->getMax();
+    checkAllElementsAreOfType(MinKey, chunkMap.begin()->second->getMin());
+    checkAllElementsAreOfType(MaxKey, std::prev(chunkMap.end())->first);
 
-        const auto insertResult = chunkRangeMap.insert(std::make_pair(
-            rangeMax, ShardAndChunkRange{{rangeMin, rangeMax}, firstChunkInRange->getShardId()}));
-        uassert(ErrorCodes::ConflictingOperationInProgress,
-                str::stream() << "Metadata contains two chunks with the same max value "
-                              << rangeMax,
-                insertResult.second);
+    return views;
+}
 
-        const auto& insertIterator = insertResult.first;
+ChunkManager::ChunkMapViews ChunkManager::_updateChunkMapViews(
+    const ChunkMap& chunkMap,
+    const std::vector<std::shared_ptr<Chunk>>& changedChunks,
+    const std::vector<std::shared_ptr<Chunk>>& removedChunks,
+    const OID& epoch) const {
+    // The rest of the key space is covered exactly as before, so it is enough to check that each
+    // changed chunk is in the map and adjoins its neighbours.
+    for (const auto& chunk : changedChunks) {
+        const auto it = chunkMap.upper_bound(chunk->getMin());
+        invariant(it != chunkMap.end() && it->second == chunk);
+
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            const auto& prevChunk = std::prev(it)->second;
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << ChunkRange(prevChunk->getMin(), prevChunk->getMax())
+                                         .toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(prevChunk->getMax() ==
+                                                                chunk->getMin()));
+        }
 
-        if (insertIterator != chunkRangeMap.begin()) {
-            // Make sure there are no gaps in the ranges
+        const auto nextIt = std::next(it);
+        if (nextIt == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            const auto& nextChunk = nextIt->second;
             uassert(ErrorCodes::ConflictingOperationInProgress,
                     str::stream() << "Gap or an overlap between ranges "
-                                  << insertIterator->second.range.toString()
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
                                   << " and "
-                                  << std::prev(insertIterator)->second.range.toString(),
-                    SimpleBSONObjComparator::kInstance.evaluate(std::prev(insertIterator)->first ==
-                                                                rangeMin));
+                                  << ChunkRange(nextChunk->getMin(), nextChunk->getMax())
+                                         .toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(nextChunk->getMin() ==
+                                                                chunk->getMax()));
         }
+    }
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+    ChunkMapViews views = _chunkMapViews;
+
+    // Shards whose max version may have been held by a removed chunk only.
+    std::set<ShardId> shardsToRecompute;
+
+    for (const auto& chunk : removedChunks) {
+        const ShardId& shardId = chunk->getShardId();
+        auto numChunksIt = views.numChunksPerShard.find(shardId);
+        invariant(numChunksIt != views.numChunksPerShard.end() && numChunksIt->second > 0);
+
+        if (--numChunksIt->second == 0) {
+            views.numChunksPerShard.erase(numChunksIt);
+            views.shardVersions.erase(shardId);
+            shardsToRecompute.erase(shardId);
+        } else if (chunk->getLastmod() == views.shardVersions[shardId]) {
+            shardsToRecompute.insert(shardId);
+        }
     }
 
-    invariant(!chunkRangeMap.empty());
-    invariant(!shardVersions.empty());
+    for (const auto& chunk : changedChunks) {
+        const ShardId& shardId = chunk->getShardId();
+        ++views.numChunksPerShard[shardId];
 
-    checkAllElementsAreOfType(MinKey, chunkRangeMap.begin()->second.min());
-    checkAllElementsAreOfType(MaxKey, chunkRangeMap.rbegin()->first);
+        auto shardVersionIt =
+            views.shardVersions.emplace(shardId, ChunkVersion(0, 0, epoch)).first;
+        if (chunk->getLastmod() > shardVersionIt->second) {
+            shardVersionIt->second = chunk->getLastmod();
+        }
+
+        // No chunk is newer than the changed ones, so this is the max for the shard.
+        if (chunk->getLastmod() == shardVersionIt->second) {
+            shardsToRecompute.erase(shardId);
+        }
+    }
+
+    // Changes normally bump the version of every shard they touch, so this takes a pass over the
+    // chunks only in unusual cases.
+    if (!shardsToRecompute.empty()) {
+        for (const auto& shardId : shardsToRecompute) {
+            views.shardVersions[shardId] = ChunkVersion(0, 0, epoch);
+        }
+        for (const auto& entry : chunkMap) {
+            const auto& chunk = entry.second;
+            if (!shardsToRecompute.count(chunk->getShardId())) {
+                continue;
+            }
+            auto& shardVersion = views.shardVersions[chunk->getShardId()];
+            if (chunk->getLastmod() > shardVersion) {
+                shardVersion = chunk->getLastmod();
+            }
+        }
+    }
 
-    return {std::move(chunkRangeMap), std::move(shardVersions)};
+    invariant(!views.shardVersions.empty());
+    return views;
 }
 
 }  // namespace mongo
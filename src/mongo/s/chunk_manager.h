@@ -31,11 +31,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/s/chunk.h"
+#include "mongo/s/chunk_map.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -47,9 +49,6 @@ class CanonicalQuery;
 struct QuerySolutionNode;
 class OperationContext;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkMap = BSONObjIndexedMap<std::shared_ptr<Chunk>>;
-
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
 
@@ -66,6 +65,19 @@ public:
 
     ~ChunkManager();
 
+    /**
+     * Returns a chunk manager for the same collection in which 'changedChunks', which must have
+     * been read from the config server since this chunk manager's version, replace the chunks
+     * they overlap. 'collectionVersion' is the max version across both.
+     *
+     * The new chunk manager shares the storage of every chunk which didn't change with this one,
+     * so the cost is proportional to the number of changed chunks. Throws
+     * ConflictingOperationInProgress if the resulting chunks don't cover the key space exactly.
+     */
+    std::unique_ptr<ChunkManager> makeUpdated(
+        const std::vector<std::shared_ptr<Chunk>>& changedChunks,
+        ChunkVersion collectionVersion) const;
+
     /**
      * Returns an increasing number of the reload sequence number of this chunk manager.
      */
@@ -136,6 +148,18 @@ public:
                              const BSONObj& collation,
                              std::set<ShardId>* shardIds) const;
 
+    /**
+     * If 'query' restricts a single field shard key with a top-level $in, returns a copy of 'query'
+     * for each shard owning any of the listed values, in which the $in only lists the values owned
+     * by that shard. The shards, which own none of the values are not included.
+     *
+     * Returns an empty map if the query cannot be split this way, in which case the query must be
+     * sent as is to the shards returned by getShardIdsForQuery. If collation is empty, we use the
+     * collection default collation for targeting.
+     */
+    std::map<ShardId, BSONObj> splitShardKeyInQueryByShard(const BSONObj& query,
+                                                           const BSONObj& collation) const;
+
     /**
      * Returns all shard ids which contain chunks overlapping the range [min, max]. Please note the
      * inclusive bounds on both sides (SERVER-20768).
@@ -178,44 +202,43 @@ public:
 private:
     friend class CollectionRoutingDataLoader;
 
-    /**
-     * Represents a range of chunk keys [getMin(), getMax()) and the id of the shard on which they
-     * reside according to the metadata.
-     */
-    struct ShardAndChunkRange {
-        const BSONObj& min() const {
-            return range.getMin();
-        }
-
-        const BSONObj& max() const {
-            return range.getMax();
-        }
-
-        ChunkRange range;
-        ShardId shardId;
-    };
-
-    using ChunkRangeMap = BSONObjIndexedMap<ShardAndChunkRange>;
-
     /**
      * Contains different transformations of the chunk map for efficient querying
      */
     struct ChunkMapViews {
-        // Transformation of the chunk map containing what range of keys reside on which shard. The
-        // index is the max key of the respective range and the union of all ranges in a such
-        // constructed map must cover the complete space from [MinKey, MaxKey).
-        const ChunkRangeMap chunkRangeMap;
-
         // Map from shard id to the maximum chunk version for that shard. If a shard contains no
         // chunks, it won't be present in this map.
-        const ShardVersionMap shardVersions;
+        ShardVersionMap shardVersions;
+
+        // Map from shard id to the number of chunks on that shard, which tells an incremental
+        // update when a shard no longer has any chunks.
+        std::map<ShardId, size_t> numChunksPerShard;
     };
 
+    ChunkManager(NamespaceString nss,
+                 KeyPattern shardKeyPattern,
+                 std::unique_ptr<CollatorInterface> defaultCollator,
+                 bool unique,
+                 ChunkMap chunkMap,
+                 ChunkMapViews chunkMapViews,
+                 ChunkVersion collectionVersion);
+
     /**
-     * Does a single pass over the chunkMap and constructs the ChunkMapViews object.
+     * Does a single pass over the chunkMap, checking that the chunks cover the whole key space,
+     * and constructs the ChunkMapViews object.
      */
     static ChunkMapViews _constructChunkMapViews(const OID& epoch, const ChunkMap& chunkMap);
 
+    /**
+     * Derives the views of 'chunkMap', which was made from this chunk manager's chunk map by
+     * replacing 'removedChunks' with 'changedChunks'. Only checks the key space coverage
+     * around the changed chunks, since the rest of the map didn't change.
+     */
+    ChunkMapViews _updateChunkMapViews(const ChunkMap& chunkMap,
+                                       const std::vector<std::shared_ptr<Chunk>>& changedChunks,
+                                       const std::vector<std::shared_ptr<Chunk>>& removedChunks,
+                                       const OID& epoch) const;
+
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
     // ChunkManagers.
     const unsigned long long _sequenceNumber;
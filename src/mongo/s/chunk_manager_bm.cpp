@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/keypattern.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/chunk_manager.h"
+#include "mongo/s/chunk_map.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using unittest::benchmarkDoNotOptimize;
+
+const NamespaceString kNss("TestDB", "TestColl");
+
+/**
+ * Returns a chunk manager for {a: 1} with 'numChunks' chunks spread over 'numShards' shards, with
+ * boundaries at 0, 10, ..., 10 * (numChunks - 2).
+ */
+std::unique_ptr<ChunkManager> makeChunkManager(int numChunks, int numShards) {
+    ChunkVersion version(1, 0, OID::gen());
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        const BSONObj min = (i == 0) ? BSON("a" << MINKEY) : BSON("a" << (i - 1) * 10);
+        const BSONObj max = (i == numChunks - 1) ? BSON("a" << MAXKEY) : BSON("a" << i * 10);
+        chunks.push_back(std::make_shared<Chunk>(
+            ChunkType(kNss, {min, max}, version, ShardId(str::stream() << (i % numShards)))));
+        version.incMinor();
+    }
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+
+    return stdx::make_unique<ChunkManager>(
+        kNss, KeyPattern(BSON("a" << 1)), nullptr, false, std::move(chunkMap), version);
+}
+
+void findIntersectingChunks(unittest::BenchmarkState& state, int numChunks) {
+    const auto cm = makeChunkManager(numChunks, 10);
+
+    // Look up keys spread across the chunks, in an order the CPU cannot predict
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(-10, numChunks * 10);
+    std::vector<BSONObj> keys;
+    for (int i = 0; i < 1024; ++i) {
+        keys.push_back(BSON("a" << dist(gen)));
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        benchmarkDoNotOptimize(cm->findIntersectingChunkWithSimpleCollation(keys[i++ % 1024]));
+    }
+}
+
+BENCHMARK(ChunkManager, FindIntersectingChunk10Chunks) {
+    findIntersectingChunks(state, 10);
+}
+
+BENCHMARK(ChunkManager, FindIntersectingChunk10000Chunks) {
+    findIntersectingChunks(state, 10000);
+}
+
+BENCHMARK(ChunkManager, FindIntersectingChunk100000Chunks) {
+    findIntersectingChunks(state, 100000);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -436,5 +436,49 @@ TEST_F(ChunkManagerQueryTest, SimpleCollationNumbersMultiShard) {
         {ShardId("0")});
 }
 
+TEST_F(ChunkManagerQueryTest, SplitShardKeyInByShard) {
+    auto chunkManager = makeChunkManager(
+        ShardKeyPattern(BSON("a" << 1)), nullptr, false, {BSON("a" << 10), BSON("a" << 20)});
+
+    auto queriesByShard = chunkManager->splitShardKeyInQueryByShard(
+        fromjson("{b: 1, a: {$in: [25, 1, 21, 2]}, c: {$gt: 0}}"), BSONObj());
+    ASSERT_EQ(2U, queriesByShard.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{b: 1, a: {$in: [1, 2]}, c: {$gt: 0}}"),
+                      queriesByShard[ShardId("0")]);
+    ASSERT_BSONOBJ_EQ(fromjson("{b: 1, a: {$in: [25, 21]}, c: {$gt: 0}}"),
+                      queriesByShard[ShardId("2")]);
+}
+
+TEST_F(ChunkManagerQueryTest, SplitShardKeyInByShardUnsplittable) {
+    auto chunkManager = makeChunkManager(
+        ShardKeyPattern(BSON("a" << 1)), nullptr, false, {BSON("a" << 10), BSON("a" << 20)});
+
+    ASSERT(chunkManager->splitShardKeyInQueryByShard(fromjson("{a: 1}"), BSONObj()).empty());
+    ASSERT(chunkManager->splitShardKeyInQueryByShard(fromjson("{b: {$in: [1, 2]}}"), BSONObj())
+               .empty());
+    ASSERT(chunkManager
+               ->splitShardKeyInQueryByShard(fromjson("{a: {$in: [1, 2], $ne: 3}}"), BSONObj())
+               .empty());
+    ASSERT(chunkManager->splitShardKeyInQueryByShard(fromjson("{a: {$in: [1, /x/]}}"), BSONObj())
+               .empty());
+    ASSERT(chunkManager->splitShardKeyInQueryByShard(fromjson("{a: {$in: [1, [2]]}}"), BSONObj())
+               .empty());
+}
+
+TEST_F(ChunkManagerQueryTest, SplitShardKeyInByShardNonSimpleCollation) {
+    auto chunkManager = makeChunkManager(
+        ShardKeyPattern(BSON("a" << 1)),
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString),
+        false,
+        {BSON("a" << 10), BSON("a" << 20)});
+
+    // Numbers are not affected by the collation, but strings are
+    ASSERT_EQ(2U,
+              chunkManager->splitShardKeyInQueryByShard(fromjson("{a: {$in: [1, 15]}}"), BSONObj())
+                  .size());
+    ASSERT(chunkManager->splitShardKeyInQueryByShard(fromjson("{a: {$in: [1, 'x']}}"), BSONObj())
+               .empty());
+}
+
 }  // namespace
 }  // namespace mongo
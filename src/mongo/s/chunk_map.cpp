@@ -0,0 +1,243 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_map.h"
+
+#include <algorithm>
+#include <set>
+
+#include "mongo/bson/ordering.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+bool keyLess(const BSONObj& lhs, const BSONObj& rhs) {
+    return SimpleBSONObjComparator::kInstance.evaluate(lhs < rhs);
+}
+
+}  // namespace
+
+const size_t ChunkMap::kMaxSegmentSize = 256;
+
+template <typename InputIt>
+ChunkMap::Segment::Segment(InputIt first, InputIt last) : entries(first, last) {
+    keyEnds.reserve(entries.size());
+    for (const auto& entry : entries) {
+        const KeyString ks(KeyString::Version::V1, entry.first, kAllAscending);
+        keyData.append(ks.getBuffer(), ks.getSize());
+        keyEnds.push_back(keyData.size());
+    }
+}
+
+ChunkMap::const_iterator& ChunkMap::const_iterator::operator++() {
+    if (++_pos == (*_segments)[_segment]->entries.size()) {
+        ++_segment;
+        _pos = 0;
+    }
+    return *this;
+}
+
+ChunkMap::const_iterator& ChunkMap::const_iterator::operator--() {
+    if (_pos == 0) {
+        --_segment;
+        _pos = (*_segments)[_segment]->entries.size();
+    }
+    --_pos;
+    return *this;
+}
+
+ChunkMap::const_iterator ChunkMap::upper_bound(const BSONObj& key) const {
+    const auto position = _upperBound(key);
+    return const_iterator(&_segments, position.first, position.second);
+}
+
+std::pair<size_t, size_t> ChunkMap::_upperBound(const BSONObj& key) const {
+    const KeyString ks(KeyString::Version::V1, key, kAllAscending);
+    const StringData encodedKey(ks.getBuffer(), ks.getSize());
+
+    // The first segment whose last key is greater than 'key' holds the entry.
+    size_t low = 0;
+    size_t high = _segments.size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const Segment& segment = *_segments[mid];
+        if (encodedKey.compare(segment.key(segment.entries.size() - 1)) < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    if (low == _segments.size()) {
+        return {_segments.size(), 0};
+    }
+
+    const size_t segmentIndex = low;
+    const Segment& segment = *_segments[segmentIndex];
+    low = 0;
+    high = segment.entries.size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (encodedKey.compare(segment.key(mid)) < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return {segmentIndex, low};
+}
+
+ChunkMap ChunkMap::makeUpdated(std::vector<std::shared_ptr<Chunk>> changedChunks,
+                               std::vector<std::shared_ptr<Chunk>>* removedChunks) const {
+    std::sort(changedChunks.begin(),
+              changedChunks.end(),
+              [](const std::shared_ptr<Chunk>& lhs, const std::shared_ptr<Chunk>& rhs) {
+                  return keyLess(lhs->getMin(), rhs->getMin());
+              });
+
+    for (size_t i = 1; i < changedChunks.size(); ++i) {
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                str::stream() << "Changed chunks " << changedChunks[i - 1]->toString() << " and "
+                              << changedChunks[i]->toString()
+                              << " overlap",
+                !keyLess(changedChunks[i]->getMin(), changedChunks[i - 1]->getMax()));
+    }
+
+    ChunkMap updated;
+
+    // Replacing a chunk copies up to a couple of segments, so once there are enough changes it is
+    // cheaper to rebuild the whole map in a single merge of the old entries with the changes.
+    if (changedChunks.size() * kMaxSegmentSize < _size) {
+        updated = *this;
+        for (const auto& chunk : changedChunks) {
+            updated._replace(chunk, removedChunks);
+        }
+        return updated;
+    }
+
+    std::vector<value_type> entries;
+    entries.reserve(_size + changedChunks.size());
+
+    auto oldIt = begin();
+    for (const auto& chunk : changedChunks) {
+        // Keep the old entries which end before the changed chunk starts...
+        for (; oldIt != end() && !keyLess(chunk->getMin(), oldIt->first); ++oldIt) {
+            entries.push_back(*oldIt);
+        }
+
+        // ... and remove the ones which end inside it.
+        for (; oldIt != end() && !keyLess(chunk->getMax(), oldIt->first); ++oldIt) {
+            removedChunks->push_back(oldIt->second);
+        }
+
+        entries.emplace_back(chunk->getMax(), chunk);
+    }
+    for (; oldIt != end(); ++oldIt) {
+        entries.push_back(*oldIt);
+    }
+
+    for (size_t i = 0; i < entries.size(); i += kMaxSegmentSize) {
+        const size_t segmentEnd = std::min(entries.size(), i + kMaxSegmentSize);
+        updated._segments.push_back(
+            std::make_shared<Segment>(entries.begin() + i, entries.begin() + segmentEnd));
+    }
+    updated._size = entries.size();
+    return updated;
+}
+
+void ChunkMap::_replace(const std::shared_ptr<Chunk>& chunk,
+                        std::vector<std::shared_ptr<Chunk>>* removedChunks) {
+    invariant(!_segments.empty());
+
+    // The entries to replace are [first, last), which may span several segments. A chunk past the
+    // last entry goes at the end of the last segment.
+    auto first = _upperBound(chunk->getMin());
+    auto last = _upperBound(chunk->getMax());
+    if (first.first == _segments.size()) {
+        first = {_segments.size() - 1, _segments.back()->entries.size()};
+    }
+    if (last.first == _segments.size()) {
+        last = {_segments.size() - 1, _segments.back()->entries.size()};
+    }
+
+    // Gather the affected segments into a single, private copy.
+    std::vector<value_type> merged;
+    size_t mergedLast = last.second;
+    for (size_t i = first.first; i <= last.first; ++i) {
+        const auto& entries = _segments[i]->entries;
+        if (i < last.first) {
+            mergedLast += entries.size();
+        }
+        merged.insert(merged.end(), entries.begin(), entries.end());
+    }
+
+    const auto eraseBegin = merged.begin() + first.second;
+    const auto eraseEnd = merged.begin() + mergedLast;
+    for (auto it = eraseBegin; it != eraseEnd; ++it) {
+        removedChunks->push_back(it->second);
+    }
+    _size -= eraseEnd - eraseBegin;
+    const auto insertIt = merged.erase(eraseBegin, eraseEnd);
+    merged.emplace(insertIt, chunk->getMax(), chunk);
+    ++_size;
+
+    // Split the result into evenly sized segments of at most kMaxSegmentSize entries.
+    const size_t numPieces = (merged.size() + kMaxSegmentSize - 1) / kMaxSegmentSize;
+    std::vector<std::shared_ptr<const Segment>> pieces;
+    for (size_t i = 0, begin = 0; i < numPieces; ++i) {
+        const size_t end = merged.size() * (i + 1) / numPieces;
+        pieces.push_back(
+            std::make_shared<Segment>(merged.begin() + begin, merged.begin() + end));
+        begin = end;
+    }
+
+    const auto replacedIt = _segments.erase(_segments.begin() + first.first,
+                                            _segments.begin() + last.first + 1);
+    _segments.insert(replacedIt, pieces.begin(), pieces.end());
+}
+
+size_t ChunkMap::numSharedSegments(const ChunkMap& other) const {
+    std::set<const Segment*> otherSegments;
+    for (const auto& segment : other._segments) {
+        otherSegments.insert(segment.get());
+    }
+
+    return std::count_if(
+        _segments.begin(), _segments.end(), [&](const std::shared_ptr<const Segment>& segment) {
+            return otherSegments.count(segment.get()) > 0;
+        });
+}
+
+}  // namespace mongo
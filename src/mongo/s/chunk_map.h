@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/s/chunk.h"
+
+namespace mongo {
+
+/**
+ * Ordered map from the max key of each chunk to the chunk. Copies of a map and the maps derived
+ * from it through makeUpdated() share their storage: the entries are kept in sorted segments of
+ * bounded size, and an update only copies the segments whose chunks it changes. Once built, a map
+ * is never modified, so it can be read by any number of threads.
+ *
+ * Lookups compare KeyString encodings of the keys, which each segment keeps back to back in a
+ * single buffer, so a search is a binary search over byte strings rather than a BSONObj
+ * comparison per probe. All keys must have the fields of the shard key, in order, for this to
+ * agree with the simple BSONObj comparator.
+ */
+class ChunkMap {
+    struct Segment;
+
+public:
+    using value_type = std::pair<BSONObj, std::shared_ptr<Chunk>>;
+
+    class const_iterator : public std::iterator<std::bidirectional_iterator_tag, const value_type> {
+    public:
+        const_iterator() = default;
+
+        const ChunkMap::value_type& operator*() const {
+            return (*_segments)[_segment]->entries[_pos];
+        }
+
+        const ChunkMap::value_type* operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        const_iterator& operator--();
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _segment == other._segment && _pos == other._pos;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkMap;
+
+        using Segments = std::vector<std::shared_ptr<const Segment>>;
+
+        const_iterator(const Segments* segments, size_t segment, size_t pos)
+            : _segments(segments), _segment(segment), _pos(pos) {}
+
+        const Segments* _segments = nullptr;
+
+        // The end iterator is at position 0 of the segment after the last one.
+        size_t _segment = 0;
+        size_t _pos = 0;
+    };
+
+    using iterator = const_iterator;
+
+    // The most entries a segment holds. Updates split larger segments in two.
+    static const size_t kMaxSegmentSize;
+
+    ChunkMap() = default;
+
+    const_iterator begin() const {
+        return const_iterator(&_segments, 0, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(&_segments, _segments.size(), 0);
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    /**
+     * Returns the first entry whose key is greater than 'key', that is the chunk containing 'key'
+     * if the chunks cover the whole key space.
+     */
+    const_iterator upper_bound(const BSONObj& key) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns a map in which the entries whose max falls in (min, max] of each chunk in
+     * 'changedChunks' are replaced by that chunk. The replaced chunks are appended to
+     * 'removedChunks'. Throws ConflictingOperationInProgress if two of the changed chunks
+     * overlap.
+     *
+     * The cost is proportional to the number of changed chunks rather than to the size of the
+     * map, as every segment without a changed chunk is shared with this map.
+     */
+    ChunkMap makeUpdated(std::vector<std::shared_ptr<Chunk>> changedChunks,
+                         std::vector<std::shared_ptr<Chunk>>* removedChunks) const;
+
+    /**
+     * Returns the number of segments which this map shares with 'other'. Used for testing.
+     */
+    size_t numSharedSegments(const ChunkMap& other) const;
+
+private:
+    /**
+     * Sorted run of entries, along with the KeyString encoding of each entry's key.
+     */
+    struct Segment {
+        template <typename InputIt>
+        Segment(InputIt first, InputIt last);
+
+        /**
+         * Returns the KeyString encoding of the key of entry 'i'.
+         */
+        StringData key(size_t i) const {
+            const uint32_t begin = (i == 0) ? 0 : keyEnds[i - 1];
+            return StringData(keyData.data() + begin, keyEnds[i] - begin);
+        }
+
+        const std::vector<value_type> entries;
+
+        // The encoded keys, laid out back to back. The encoding of entry i ends at keyEnds[i].
+        std::string keyData;
+        std::vector<uint32_t> keyEnds;
+    };
+
+    /**
+     * Returns the segment and position of the first entry whose key is greater than 'key'.
+     */
+    std::pair<size_t, size_t> _upperBound(const BSONObj& key) const;
+
+    /**
+     * Replaces the entries whose max falls in (min, max] of 'chunk' with 'chunk'. Copies only
+     * the segments which hold these entries.
+     */
+    void _replace(const std::shared_ptr<Chunk>& chunk,
+                  std::vector<std::shared_ptr<Chunk>>* removedChunks);
+
+    const_iterator::Segments _segments;
+
+    // Total number of entries over all segments.
+    size_t _size = 0;
+};
+
+}  // namespace mongo
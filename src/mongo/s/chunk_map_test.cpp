@@ -0,0 +1,250 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_map.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("TestDB", "TestColl");
+
+BSONObj keyFor(int value) {
+    if (value == std::numeric_limits<int>::min()) {
+        return BSON("a" << MINKEY);
+    }
+    if (value == std::numeric_limits<int>::max()) {
+        return BSON("a" << MAXKEY);
+    }
+    return BSON("a" << value);
+}
+
+std::shared_ptr<Chunk> makeChunk(int min, int max, const ChunkVersion& version) {
+    return std::make_shared<Chunk>(ChunkType(kNss, {keyFor(min), keyFor(max)}, version, {"0"}));
+}
+
+/**
+ * Returns chunks covering the key space with boundaries at 0, 10, ..., 10 * (numChunks - 2).
+ */
+std::vector<std::shared_ptr<Chunk>> makeChunks(int numChunks, ChunkVersion* version) {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        const int min = (i == 0) ? std::numeric_limits<int>::min() : (i - 1) * 10;
+        const int max = (i == numChunks - 1) ? std::numeric_limits<int>::max() : i * 10;
+        chunks.push_back(makeChunk(min, max, *version));
+        version->incMinor();
+    }
+    return chunks;
+}
+
+/**
+ * Checks that 'chunkMap' iterates, in both directions, over exactly 'expected' in order.
+ */
+void assertMapHolds(const ChunkMap& chunkMap,
+                    const std::vector<std::shared_ptr<Chunk>>& expected) {
+    ASSERT_EQ(expected.size(), chunkMap.size());
+
+    auto it = chunkMap.begin();
+    for (const auto& chunk : expected) {
+        ASSERT(it != chunkMap.end());
+        ASSERT_BSONOBJ_EQ(chunk->getMax(), it->first);
+        ASSERT_EQ(chunk, it->second);
+        ++it;
+    }
+    ASSERT(it == chunkMap.end());
+
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+        --it;
+        ASSERT_EQ(*rit, it->second);
+    }
+    ASSERT(it == chunkMap.begin());
+}
+
+TEST(ChunkMapTest, EmptyMap) {
+    ChunkMap chunkMap;
+    ASSERT(chunkMap.empty());
+    ASSERT_EQ(0U, chunkMap.size());
+    ASSERT(chunkMap.begin() == chunkMap.end());
+    ASSERT(chunkMap.upper_bound(keyFor(0)) == chunkMap.end());
+}
+
+TEST(ChunkMapTest, FullLoadSpanningManySegments) {
+    ChunkVersion version(1, 0, OID::gen());
+    const auto chunks = makeChunks(3 * ChunkMap::kMaxSegmentSize + 7, &version);
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+    ASSERT(removed.empty());
+    assertMapHolds(chunkMap, chunks);
+
+    // Every key is found in the chunk which contains it.
+    for (const auto& chunk : chunks) {
+        ASSERT_EQ(chunk, chunkMap.upper_bound(chunk->getMin())->second);
+    }
+    ASSERT_EQ(chunks[1], chunkMap.upper_bound(keyFor(5))->second);
+    ASSERT(chunkMap.upper_bound(keyFor(std::numeric_limits<int>::max())) == chunkMap.end());
+}
+
+TEST(ChunkMapTest, LookupAgreesWithSimpleComparator) {
+    ChunkVersion version(1, 0, OID::gen());
+    const std::vector<BSONObj> bounds{BSON("a" << MINKEY << "b" << MINKEY),
+                                      BSON("a" << -1.5 << "b" << MINKEY),
+                                      BSON("a" << 3 << "b" << "abc"),
+                                      BSON("a" << 3 << "b" << "abd"),
+                                      BSON("a" << (1LL << 40) << "b" << MINKEY),
+                                      BSON("a"
+                                           << "str"
+                                           << "b"
+                                           << 0),
+                                      BSON("a" << OID() << "b" << 0),
+                                      BSON("a" << MAXKEY << "b" << MAXKEY)};
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    for (size_t i = 1; i < bounds.size(); ++i) {
+        chunks.push_back(
+            std::make_shared<Chunk>(ChunkType(kNss, {bounds[i - 1], bounds[i]}, version, {"0"})));
+    }
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+
+    const std::vector<BSONObj> keys{BSON("a" << -2 << "b" << 0),
+                                    BSON("a" << -1.5 << "b" << MINKEY),
+                                    BSON("a" << 3.0 << "b" << "abc"),
+                                    BSON("a" << 3LL << "b" << "abcd"),
+                                    BSON("a" << Decimal128(7) << "b" << 1),
+                                    BSON("a"
+                                         << "st"
+                                         << "b"
+                                         << 0),
+                                    BSON("a" << OID::gen() << "b" << 0)};
+    for (const auto& key : keys) {
+        const auto it = chunkMap.upper_bound(key);
+        ASSERT(it != chunkMap.end());
+        ASSERT(it->second->containsKey(key)) << "key " << key << " found chunk "
+                                             << it->second->toString();
+    }
+}
+
+TEST(ChunkMapTest, SplitCopiesOnlyTheAffectedSegment) {
+    ChunkVersion version(1, 0, OID::gen());
+    auto chunks = makeChunks(4 * ChunkMap::kMaxSegmentSize, &version);
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+    ASSERT_EQ(4U, chunkMap.numSharedSegments(chunkMap));
+
+    // Split the chunk [0, 10) in two
+    const auto left = makeChunk(0, 5, version);
+    version.incMinor();
+    const auto right = makeChunk(5, 10, version);
+
+    const auto updated = chunkMap.makeUpdated({right, left}, &removed);
+    ASSERT_EQ(1U, removed.size());
+    ASSERT_EQ(chunks[1], removed.front());
+
+    chunks.erase(chunks.begin() + 1);
+    chunks.insert(chunks.begin() + 1, {left, right});
+    assertMapHolds(updated, chunks);
+
+    // The original map is left unchanged and shares all but the first segment.
+    ASSERT_EQ(chunks.size() - 1, chunkMap.size());
+    ASSERT_EQ(3U, updated.numSharedSegments(chunkMap));
+}
+
+TEST(ChunkMapTest, MergeReplacesChunksAcrossSegments) {
+    ChunkVersion version(1, 0, OID::gen());
+    auto chunks = makeChunks(4 * ChunkMap::kMaxSegmentSize, &version);
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+
+    // A chunk which covers the end of the first segment and the start of the second
+    const size_t firstIndex = ChunkMap::kMaxSegmentSize - 2;
+    const size_t lastIndex = ChunkMap::kMaxSegmentSize + 2;
+    const auto merged = makeChunk((firstIndex - 1) * 10, lastIndex * 10, version);
+
+    const auto updated = chunkMap.makeUpdated({merged}, &removed);
+    ASSERT_EQ(lastIndex - firstIndex + 1, removed.size());
+    for (size_t i = 0; i < removed.size(); ++i) {
+        ASSERT_EQ(chunks[firstIndex + i], removed[i]);
+    }
+
+    chunks.erase(chunks.begin() + firstIndex, chunks.begin() + lastIndex + 1);
+    chunks.insert(chunks.begin() + firstIndex, merged);
+    assertMapHolds(updated, chunks);
+    ASSERT_EQ(2U, updated.numSharedSegments(chunkMap));
+}
+
+TEST(ChunkMapTest, ManyChangesRebuildTheMap) {
+    ChunkVersion version(1, 0, OID::gen());
+    const auto originalChunks = makeChunks(10, &version);
+    auto chunks = originalChunks;
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+
+    // Move every other chunk, keeping its range
+    std::vector<std::shared_ptr<Chunk>> changed;
+    for (size_t i = 0; i < chunks.size(); i += 2) {
+        chunks[i] = std::make_shared<Chunk>(
+            ChunkType(kNss, {chunks[i]->getMin(), chunks[i]->getMax()}, version, {"1"}));
+        changed.push_back(chunks[i]);
+    }
+
+    const auto updated = chunkMap.makeUpdated(changed, &removed);
+    ASSERT_EQ(changed.size(), removed.size());
+    assertMapHolds(updated, chunks);
+    assertMapHolds(chunkMap, originalChunks);
+}
+
+TEST(ChunkMapTest, OverlappingChangesAreRejected) {
+    ChunkVersion version(1, 0, OID::gen());
+    const auto chunks = makeChunks(3, &version);
+
+    std::vector<std::shared_ptr<Chunk>> removed;
+    const auto chunkMap = ChunkMap().makeUpdated(chunks, &removed);
+
+    ASSERT_THROWS_CODE(
+        chunkMap.makeUpdated({makeChunk(0, 7, version), makeChunk(5, 10, version)}, &removed),
+        UserException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -81,6 +81,24 @@ using CallbackHandle = TaskExecutor::CallbackHandle;
 
 namespace {
 const Seconds kRefreshPeriod(30);
+
+/**
+ * Starts opening connections to every host of 'connString' from the sharding executors, so that
+ * the first requests after a host becomes known (or after a restart) don't pay for connection setup
+ * and authentication. Called again on each periodic reload, this also keeps the pools for idle
+ * hosts from expiring.
+ */
+void warmUpConnections(const ConnectionString& connString) {
+    auto executorPool = grid.getExecutorPool();
+    if (!executorPool) {
+        return;
+    }
+
+    for (const auto& host : connString.getServers()) {
+        executorPool->warmUpConnections(host);
+    }
+}
+
 }  // namespace
 
 ShardRegistry::ShardRegistry(std::unique_ptr<ShardFactory> shardFactory,
@@ -175,9 +193,15 @@ void ShardRegistry::updateReplSetHosts(const ConnectionString& newConnString) {
     invariant(newConnString.type() == ConnectionString::SET ||
               newConnString.type() == ConnectionString::CUSTOM);  // For dbtests
 
-    // to prevent update config shard connection string during init
-    stdx::unique_lock<stdx::mutex> lock(_reloadMutex);
-    _data.rebuildShardIfExists(newConnString, _shardFactory.get());
+    {
+        // to prevent update config shard connection string during init
+        stdx::unique_lock<stdx::mutex> lock(_reloadMutex);
+        _data.rebuildShardIfExists(newConnString, _shardFactory.get());
+    }
+
+    if (_data.findByRSName(newConnString.getSetName())) {
+        warmUpConnections(newConnString);
+    }
 }
 
 void ShardRegistry::init() {
@@ -308,6 +332,15 @@ bool ShardRegistry::reload(OperationContext* opCtx) {
         ReplicaSetMonitor::remove(name);
     }
 
+    std::set<ShardId> shardIds;
+    _data.getAllShardIds(shardIds);
+    for (const auto& shardId : shardIds) {
+        auto shard = _data.findByShardId(shardId);
+        if (shard) {
+            warmUpConnections(shard->getConnString());
+        }
+    }
+
     nextReloadState = ReloadState::Idle;
     // first successful reload means that registry is up
     _isUp = true;
@@ -44,6 +44,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
@@ -52,6 +53,7 @@
 #include "mongo/s/grid.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -205,15 +207,21 @@ Shard::HostWithResponse ShardRemote::_runCommand(OperationContext* opCtx,
         Status(ErrorCodes::InternalError, "Internal error running command");
 
     TaskExecutor* executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    auto callStatus = executor->scheduleRemoteCommand(
-        request,
-        [&swResponse](const RemoteCommandCallbackArgs& args) { swResponse = args.response; });
-    if (!callStatus.isOK()) {
-        return Shard::HostWithResponse(host.getValue(), callStatus.getStatus());
-    }
+    {
+        _targeter->markRequestStarted(host.getValue());
+        ON_BLOCK_EXIT([&] { _targeter->markRequestFinished(host.getValue()); });
+
+        auto callStatus = executor->scheduleRemoteCommand(
+            request,
+            [&swResponse](const RemoteCommandCallbackArgs& args) { swResponse = args.response; });
+        if (!callStatus.isOK()) {
+            return Shard::HostWithResponse(host.getValue(), callStatus.getStatus());
+        }
 
-    // Block until the command is carried out
-    executor->wait(callStatus.getValue());
+        // Block until the command is carried out
+        WaitEventScope waitForResponse(WaitEvent::kNetwork);
+        executor->wait(callStatus.getValue());
+    }
 
     updateReplSetMonitor(host.getValue(), swResponse.status);
 
@@ -265,6 +265,7 @@ Status ChunkManagerTargeter::init(OperationContext* opCtx) {
     }
 
     _routingInfo = std::move(routingInfoStatus.getValue());
+    _lastInsertTarget = boost::none;
 
     return Status::OK();
 }
@@ -303,7 +304,7 @@ Status ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
 
     // Target the shard key or database primary
     if (!shardKey.isEmpty()) {
-        *endpoint = targetShardKey(shardKey, CollationSpec::kSimpleSpec, doc.objsize()).release();
+        *endpoint = targetInsertShardKey(shardKey, doc.objsize()).release();
     } else {
         if (!_routingInfo->primary()) {
             return Status(ErrorCodes::NamespaceNotFound,
@@ -568,6 +569,28 @@ std::unique_ptr<ShardEndpoint> ChunkManagerTargeter::targetShardKey(const BSONOb
                                             _routingInfo->cm()->getVersion(chunk->getShardId()));
 }
 
+std::unique_ptr<ShardEndpoint> ChunkManagerTargeter::targetInsertShardKey(
+    const BSONObj& shardKey, long long estDataSize) const {
+    // Large insert batches usually come in shard key order, so the chunk which received the
+    // previous document is checked before looking the key up in the chunk map.
+    if (!_lastInsertTarget || !_lastInsertTarget->chunk->containsKey(shardKey)) {
+        auto chunk = _routingInfo->cm()->findIntersectingChunkWithSimpleCollation(shardKey);
+        const auto shardVersion = _routingInfo->cm()->getVersion(chunk->getShardId());
+        const auto sizeDeltaIt = _stats->chunkSizeDelta.emplace(chunk->getMin(), 0).first;
+
+        _lastInsertTarget = InsertTarget{std::move(chunk), shardVersion, &sizeDeltaIt->second};
+    }
+
+    // Track autosplit stats for sharded collections
+    // Note: this is only best effort accounting and is not accurate.
+    if (estDataSize > 0) {
+        *_lastInsertTarget->sizeDelta += estDataSize;
+    }
+
+    return stdx::make_unique<ShardEndpoint>(_lastInsertTarget->chunk->getShardId(),
+                                            _lastInsertTarget->shardVersion);
+}
+
 Status ChunkManagerTargeter::targetCollection(
     std::vector<std::unique_ptr<ShardEndpoint>>* endpoints) const {
     if (!_routingInfo->primary() && !_routingInfo->cm()) {
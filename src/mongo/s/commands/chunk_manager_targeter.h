@@ -152,6 +152,25 @@ private:
                                                   const BSONObj& collation,
                                                   long long estDataSize) const;
 
+    /**
+     * Same as targetShardKey() with the simple collation, for the shard key of an inserted
+     * document. Reuses the chunk of the previous insert when it also contains 'shardKey'.
+     */
+    std::unique_ptr<ShardEndpoint> targetInsertShardKey(const BSONObj& shardKey,
+                                                        long long estDataSize) const;
+
+    /**
+     * The chunk which received the last targeted insert, along with the version of its shard and
+     * its entry in the autosplit stats.
+     */
+    struct InsertTarget {
+        std::shared_ptr<Chunk> chunk;
+        ChunkVersion shardVersion;
+
+        // Points into _stats->chunkSizeDelta, which is never erased from.
+        int* sizeDelta;
+    };
+
     // Full namespace of the collection for this targeter
     const NamespaceString _nss;
 
@@ -166,6 +185,9 @@ private:
 
     // Map of shard->remote shard version reported from stale errors
     ShardVersionMap _remoteShardVersions;
+
+    // Target of the last insert under the current routing info. Reset whenever it is reloaded.
+    mutable boost::optional<InsertTarget> _lastInsertTarget;
 };
 
 }  // namespace mongo
@@ -47,6 +47,7 @@
 #include "mongo/s/commands/sharded_command_processing.h"
 #include "mongo/s/commands/strategy.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_result_cache.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/timer.h"
 
@@ -237,6 +238,8 @@ private:
         bool ok = conn->runCommand(nss.db().toString(), cmdObj, res);
         conn.done();
 
+        ClusterResultCache::get(opCtx)->invalidate(nss);
+
         // ErrorCodes::RecvStaleConfig is the code for RecvStaleConfigException.
         if (!ok && res.getIntField("code") == ErrorCodes::RecvStaleConfig) {
             // Command code traps this exception and re-runs
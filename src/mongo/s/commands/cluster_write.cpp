@@ -35,6 +35,7 @@
 #include "mongo/base/status.h"
 #include "mongo/client/connpool.h"
 #include "mongo/db/lasterror.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
@@ -44,6 +45,7 @@
 #include "mongo/s/commands/chunk_manager_targeter.h"
 #include "mongo/s/config_server_client.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_result_cache.h"
 #include "mongo/s/shard_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -56,6 +58,15 @@ const uint64_t splitTestFactor = 5;
 
 const uint64_t kTooManySplitPoints = 4;
 
+// If positive, auto-splits ask the shard to pick split points from this many randomly sampled
+// shard key index entries rather than to scan the whole chunk.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitVectorSampleSize, int, 0);
+
+// If true, the shards count the bytes written to their chunks and split them (see the shards'
+// autoSplitOnShard parameter), so this mongos does not estimate the chunk sizes from the writes it
+// routes.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitOnShards, bool, false);
+
 void toBatchError(const Status& status, BatchedCommandResponse* response) {
     response->clear();
     response->setErrCode(status.code());
@@ -312,7 +323,9 @@ void ClusterWriter::write(OperationContext* opCtx,
             exec.executeBatch(opCtx, *request, response, &_stats);
         }
 
-        if (_autoSplit) {
+        ClusterResultCache::get(opCtx)->invalidate(request->getTargetingNSS());
+
+        if (_autoSplit && !autoSplitOnShards.load()) {
             splitIfNeeded(opCtx, request->getNS(), targeterStats);
         }
     }
@@ -395,7 +408,8 @@ void updateChunkWriteStatsAndSplitIfNeeded(OperationContext* opCtx,
                                                               manager->getShardKeyPattern(),
                                                               chunkRange,
                                                               chunkSizeToUse,
-                                                              boost::none));
+                                                              boost::none,
+                                                              autoSplitVectorSampleSize.load()));
 
         if (splitPoints.size() <= 1) {
             // No split points means there isn't enough data to split on; 1 split point means we
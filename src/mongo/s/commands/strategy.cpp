@@ -665,7 +665,7 @@ void execCommandClient(OperationContext* opCtx,
 
     ON_BLOCK_EXIT([opCtx, &result] { appendRequiredFieldsToResponse(opCtx, &result); });
 
-    StringMap<int> topLevelFields;
+    CommandFieldNameSet topLevelFields;
     for (auto&& element : cmdObj) {
         StringData fieldName = element.fieldNameStringData();
         if (fieldName == "help" && element.type() == Bool && element.Bool()) {
@@ -680,7 +680,7 @@ void execCommandClient(OperationContext* opCtx,
         uassert(ErrorCodes::FailedToParse,
                 str::stream() << "Parsed command object contains duplicate top level key: "
                               << fieldName,
-                topLevelFields[fieldName]++ == 0);
+                topLevelFields.insert(fieldName));
     }
 
     Status status = Command::checkAuthorization(c, opCtx, dbname, cmdObj);
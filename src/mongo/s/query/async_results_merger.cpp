@@ -32,6 +32,8 @@
 
 #include "mongo/s/query/async_results_merger.h"
 
+#include <limits>
+
 #include "mongo/client/remote_command_targeter.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
@@ -55,9 +57,7 @@ const int kMaxNumFailedHostRetryAttempts = 3;
 
 AsyncResultsMerger::AsyncResultsMerger(executor::TaskExecutor* executor,
                                        ClusterClientCursorParams* params)
-    : _executor(executor),
-      _params(params),
-      _mergeQueue(MergingComparator(_remotes, _params->sort)) {
+    : _executor(executor), _params(params) {
     for (const auto& remote : _params->remotes) {
         if (remote.shardId) {
             invariant(remote.cmdObj);
@@ -72,6 +72,10 @@ AsyncResultsMerger::AsyncResultsMerger(executor::TaskExecutor* executor,
         }
     }
 
+    if (!_params->sort.isEmpty()) {
+        _mergeTree.emplace(_remotes, _params->sort);
+    }
+
     // Initialize command metadata to handle the read preference.
     if (_params->readPreference) {
         BSONObjBuilder metadataBuilder;
@@ -201,24 +205,21 @@ ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
     // Tailable cursors cannot have a sort.
     invariant(!_params->isTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_mergeTree->empty()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree->top();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].bufferedBytes -= front.getResult()->objsize();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
-    }
+    // Replay the matches of 'smallestRemote' with its next result, if it has one.
+    _mergeTree->update(smallestRemote);
 
     return front;
 }
@@ -232,6 +233,9 @@ ClusterQueryResult AsyncResultsMerger::nextReadyUnsorted() {
         if (_remotes[_gettingFromRemote].hasNext()) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
             _remotes[_gettingFromRemote].docBuffer.pop();
+            if (front.getResult()) {
+                _remotes[_gettingFromRemote].bufferedBytes -= front.getResult()->objsize();
+            }
 
             if (_params->isTailable && !_remotes[_gettingFromRemote].hasNext()) {
                 // The cursor is tailable and we're about to return the last buffered result. This
@@ -525,7 +529,12 @@ void AsyncResultsMerger::handleBatchResponse(
             // Clear the results buffer and cursor id.
             std::queue<ClusterQueryResult> emptyBuffer;
             std::swap(remote.docBuffer, emptyBuffer);
+            remote.bufferedBytes = 0;
             remote.cursorId = 0;
+
+            if (_mergeTree) {
+                _mergeTree->update(remoteIndex);
+            }
         }
 
         return;
@@ -536,6 +545,9 @@ void AsyncResultsMerger::handleBatchResponse(
     remote.cursorId = cursorResponse.getCursorId();
     remote.initialCmdObj = boost::none;
 
+    // Results may still be buffered from the previous batch if this one was prefetched.
+    const bool hadBufferedResults = remote.hasNext();
+
     for (const auto& obj : cursorResponse.getBatch()) {
         // If there's a sort, we're expecting the remote node to give us back a sort key.
         if (!_params->sort.isEmpty() &&
@@ -550,13 +562,14 @@ void AsyncResultsMerger::handleBatchResponse(
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the
-    // merge queue.
-    if (!_params->sort.isEmpty() && !cursorResponse.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+    // If we're doing a sorted merge, then we have to make sure to enter this remote in the merge
+    // tree, unless it is already there because of results left over from its previous batch.
+    if (_mergeTree && !cursorResponse.getBatch().empty() && !hadBufferedResults) {
+        _mergeTree->update(remoteIndex);
     }
 
     // If the cursor is tailable and we just received an empty batch, the next return value should
@@ -575,6 +588,16 @@ void AsyncResultsMerger::handleBatchResponse(
         if (!remote.status.isOK()) {
             return;
         }
+    } else if (shouldPrefetch_inlock() && !hadBufferedResults && !remote.exhausted() &&
+               remote.bufferedBytes < _params->prefetchMaxBufferedBytes) {
+        // Overlap the round trip for the next batch with the consumption of this one. Only a
+        // batch which arrived into an empty buffer triggers a prefetch, so at most two batches
+        // are ever buffered per remote. A batch at least as large as the memory cap is consumed
+        // before the next is requested.
+        remote.status = askForNextBatch_inlock(opCtx, remoteIndex);
+        if (!remote.status.isOK()) {
+            return;
+        }
     }
 
     // ScopeGuard requires dismiss on success, but we want waiter to be signalled on success as
@@ -583,6 +606,12 @@ void AsyncResultsMerger::handleBatchResponse(
     signalCurrentEventIfReady_inlock();
 }
 
+bool AsyncResultsMerger::shouldPrefetch_inlock() const {
+    // Partial results mode discards the buffer of a remote whose request fails, which would drop
+    // results already received if the failed request was a prefetch.
+    return _params->prefetchNextBatch && !_params->isTailable && !_params->isAllowPartialResults;
+}
+
 void AsyncResultsMerger::signalCurrentEventIfReady_inlock() {
     if (ready_inlock() && _currentEvent.isValid()) {
         // To prevent ourselves from signalling the event twice, we set '_currentEvent' as
@@ -717,19 +746,50 @@ std::shared_ptr<Shard> AsyncResultsMerger::RemoteCursorData::getShard() {
 }
 
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::MergingTree
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+const size_t AsyncResultsMerger::MergingTree::kNoRemote = std::numeric_limits<size_t>::max();
+
+AsyncResultsMerger::MergingTree::MergingTree(const std::vector<RemoteCursorData>& remotes,
+                                             const BSONObj& sort)
+    : _remotes(remotes), _sort(sort), _numLeaves(1), _sortKeys(remotes.size()) {
+    while (_numLeaves < _remotes.size()) {
+        _numLeaves *= 2;
+    }
+    _nodes.assign(2 * _numLeaves, kNoRemote);
+}
 
-    BSONObj leftDocKey = (*leftDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
-    BSONObj rightDocKey = (*rightDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
+void AsyncResultsMerger::MergingTree::update(size_t remoteIndex) {
+    const auto& docBuffer = _remotes[remoteIndex].docBuffer;
+
+    size_t node = _numLeaves + remoteIndex;
+    if (docBuffer.empty()) {
+        _sortKeys[remoteIndex] = BSONObj();
+        _nodes[node] = kNoRemote;
+    } else {
+        _sortKeys[remoteIndex] =
+            (*docBuffer.front().getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
+        _nodes[node] = remoteIndex;
+    }
+
+    for (node /= 2; node > 0; node /= 2) {
+        _nodes[node] = _winner(_nodes[2 * node], _nodes[2 * node + 1]);
+    }
+}
+
+size_t AsyncResultsMerger::MergingTree::_winner(size_t lhs, size_t rhs) const {
+    if (lhs == kNoRemote) {
+        return rhs;
+    }
+    if (rhs == kNoRemote) {
+        return lhs;
+    }
 
     // This does not need to sort with a collator, since mongod has already mapped strings to their
     // ICU comparison keys as part of the $sortKey meta projection.
-    return leftDocKey.woCompare(rightDocKey, _sort, false /*considerFieldName*/) > 0;
+    return _sortKeys[rhs].woCompare(_sortKeys[lhs], _sort, false /*considerFieldName*/) < 0 ? rhs
+                                                                                            : lhs;
 }
 
 }  // namespace mongo
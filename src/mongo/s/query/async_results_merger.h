@@ -248,23 +248,69 @@ private:
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
 
+        // Total size of the documents in 'docBuffer'. Bounds how much a remote may buffer ahead
+        // of the merge when prefetching.
+        long long bufferedBytes = 0;
+
     private:
         // For a cursor, which has shard id associated contains the exact host on which the remote
         // cursor resides.
         boost::optional<HostAndPort> _shardHostAndPort;
     };
 
-    class MergingComparator {
+    /**
+     * Tournament tree over the remotes, which tells the remote whose next buffered document comes
+     * first in the sort order. Every internal node holds the winner of the match between its two
+     * children, so a remote whose front document changed only replays the matches on its path to
+     * the root, at one comparison per level. The sort key of each remote's front document is
+     * extracted once per document rather than at every comparison.
+     */
+    class MergingTree {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort)
-            : _remotes(remotes), _sort(sort) {}
+        MergingTree(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort);
+
+        /**
+         * Takes into account a change of the front document of remote 'remoteIndex', which may
+         * also have run out of buffered documents.
+         */
+        void update(size_t remoteIndex);
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        /**
+         * Returns whether no remote has a buffered document.
+         */
+        bool empty() const {
+            return _nodes[1] == kNoRemote;
+        }
+
+        /**
+         * Returns the remote with the first document in sort order. Invalid if empty().
+         */
+        size_t top() const {
+            return _nodes[1];
+        }
 
     private:
+        static const size_t kNoRemote;
+
+        /**
+         * Returns the remote with the first front document of 'lhs' and 'rhs', preferring 'lhs'
+         * on ties. Either may be kNoRemote, which loses every match.
+         */
+        size_t _winner(size_t lhs, size_t rhs) const;
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj& _sort;
+
+        // The number of leaves, a power of two at least as large as the number of remotes.
+        size_t _numLeaves;
+
+        // Implicit binary tree with the root at index 1 and the leaf of remote i at index
+        // _numLeaves + i. Each node holds the index of the winning remote of its subtree.
+        std::vector<size_t> _nodes;
+
+        // The sort key of the front document of each remote which has one.
+        std::vector<BSONObj> _sortKeys;
     };
 
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
@@ -325,6 +371,12 @@ private:
                              OperationContext* opCtx,
                              size_t remoteIndex);
 
+    /**
+     * Returns whether the next batch should be requested from a remote as soon as its current
+     * batch arrives. See ClusterClientCursorParams::prefetchNextBatch.
+     */
+    bool shouldPrefetch_inlock() const;
+
     /**
      * If there is a valid unsignaled event that has been requested via nextReady() and there are
      * buffered results that are ready to return, signals that event.
@@ -361,9 +413,9 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // Tells the index into '_remotes' for the remote host that has the next document to return,
+    // according to the sort order. Set only if there is a sort.
+    boost::optional<MergingTree> _mergeTree;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
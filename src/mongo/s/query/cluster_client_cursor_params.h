@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -145,6 +146,16 @@ struct ClusterClientCursorParams {
     // unreachable host.
     bool isAllowPartialResults = false;
 
+    // Whether to request the next batch from a remote as soon as a batch from it arrives, rather
+    // than once that batch has been consumed. This overlaps the round trip to each shard with the
+    // merging of its previous batch, at the cost of buffering up to two batches per remote. Has no
+    // effect on tailable cursors.
+    bool prefetchNextBatch = false;
+
+    // When prefetching, the next batch is not requested from a remote which already buffers at
+    // least this many bytes of results.
+    long long prefetchMaxBufferedBytes = std::numeric_limits<long long>::max();
+
     // If the read is done against a view, an error is returned along with the view definition in
     // the first response from the primary shard for the base collection. Calling code can re-run
     // the read against the base collection by using this returned view definition.
@@ -32,6 +32,7 @@
 
 #include "mongo/s/query/cluster_find.h"
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -44,6 +45,8 @@
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -52,9 +55,12 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_query_knobs.h"
+#include "mongo/s/query/cluster_result_cache.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 
@@ -149,6 +155,33 @@ StatusWith<std::unique_ptr<QueryRequest>> transformQueryForShards(const QueryReq
     return std::move(newQR);
 }
 
+/**
+ * Returns the key under which the results of 'query' are kept in the ClusterResultCache, or
+ * boost::none if they must not be cached. Tailable cursors never end, and reads which wait for an
+ * optime or are linearizable must be answered by the shards.
+ */
+boost::optional<std::string> makeResultCacheKey(const CanonicalQuery& query,
+                                                const ReadPreferenceSetting& readPref) {
+    const auto& qr = query.getQueryRequest();
+    if (!ClusterResultCache::isEnabledFor(query.nss()) || qr.isTailable() || qr.isAwaitData()) {
+        return boost::none;
+    }
+
+    const auto& readConcern = qr.getReadConcern();
+    if (!readConcern.isEmpty()) {
+        const auto level = readConcern[repl::ReadConcernArgs::kLevelFieldName];
+        if (readConcern.nFields() != 1 || level.type() != String || level.str() == "linearizable") {
+            return boost::none;
+        }
+    }
+
+    BSONObjBuilder keyBuilder;
+    qr.asFindCommand(&keyBuilder);
+    keyBuilder.append("$readPreference", readPref.toBSON());
+    const BSONObj key = keyBuilder.obj();
+    return std::string(key.objdata(), key.objsize());
+}
+
 StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
                                              const CanonicalQuery& query,
                                              const ReadPreferenceSetting& readPref,
@@ -158,18 +191,28 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
                                              BSONObj* viewDefinition) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
 
-    // Get the set of shards on which we will run the query.
+    // Get the set of shards on which we will run the query. A $in on the shard key is split, so
+    // that each shard is only sent the values it owns.
     std::vector<std::shared_ptr<Shard>> shards;
+    std::map<ShardId, BSONObj> filtersByShard;
     if (primary) {
         shards.emplace_back(std::move(primary));
     } else {
         invariant(chunkManager);
 
         std::set<ShardId> shardIds;
-        chunkManager->getShardIdsForQuery(opCtx,
-                                          query.getQueryRequest().getFilter(),
-                                          query.getQueryRequest().getCollation(),
-                                          &shardIds);
+        filtersByShard = chunkManager->splitShardKeyInQueryByShard(
+            query.getQueryRequest().getFilter(), query.getQueryRequest().getCollation());
+        if (!filtersByShard.empty()) {
+            for (const auto& shardFilter : filtersByShard) {
+                shardIds.insert(shardFilter.first);
+            }
+        } else {
+            chunkManager->getShardIdsForQuery(opCtx,
+                                              query.getQueryRequest().getFilter(),
+                                              query.getQueryRequest().getCollation(),
+                                              &shardIds);
+        }
 
         for (auto id : shardIds) {
             auto shardStatus = shardRegistry->getShard(opCtx, id);
@@ -190,6 +233,8 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
     params.isTailable = query.getQueryRequest().isTailable();
     params.isAwaitData = query.getQueryRequest().isAwaitData();
     params.isAllowPartialResults = query.getQueryRequest().isAllowPartialResults();
+    params.prefetchNextBatch = internalQueryPrefetchShardBatches.load();
+    params.prefetchMaxBufferedBytes = internalQueryPrefetchShardBatchesMaxBytes.load();
 
     // This is the batchSize passed to each subsequent getMore command issued by the cursor. We
     // usually use the batchSize associated with the initial find, but as it is illegal to send a
@@ -218,6 +263,11 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
     for (const auto& shard : shards) {
         invariant(!shard->isConfig() || shard->getConnString().type() != ConnectionString::INVALID);
 
+        auto shardFilterIt = filtersByShard.find(shard->getId());
+        if (shardFilterIt != filtersByShard.end()) {
+            qrToForward.getValue()->setFilter(shardFilterIt->second);
+        }
+
         // Build the find command, and attach shard version if necessary.
         BSONObjBuilder cmdBuilder;
         qrToForward.getValue()->asFindCommand(&cmdBuilder);
@@ -238,7 +288,8 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
 
     auto cursorState = ClusterCursorManager::CursorState::NotExhausted;
     int bytesBuffered = 0;
-    while (!FindCommon::enoughForFirstBatch(query.getQueryRequest(), results->size())) {
+    while (!FindCommon::enoughForFirstBatch(
+        query.getQueryRequest(), results->size(), bytesBuffered)) {
         auto next = ccc->next(opCtx);
 
         if (!next.isOK()) {
@@ -323,6 +374,8 @@ StatusWith<CursorId> ClusterFind::runQuery(OperationContext* opCtx,
     }
 
     auto const catalogCache = Grid::get(opCtx)->catalogCache();
+    auto const resultCache = ClusterResultCache::get(opCtx);
+    const auto cacheKey = makeResultCacheKey(query, readPref);
 
     // Re-target and re-send the initial find command to the shards until we have established the
     // shard version.
@@ -338,6 +391,17 @@ StatusWith<CursorId> ClusterFind::runQuery(OperationContext* opCtx,
 
         auto& routingInfo = routingInfoStatus.getValue();
 
+        const auto collectionVersion =
+            routingInfo.cm() ? routingInfo.cm()->getVersion() : ChunkVersion::UNSHARDED();
+        uint64_t writeGeneration = 0;
+        if (cacheKey) {
+            const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+            if (resultCache->lookup(query.nss(), *cacheKey, collectionVersion, now, results)) {
+                return CursorId(0);
+            }
+            writeGeneration = resultCache->getWriteGeneration(query.nss());
+        }
+
         auto cursorId = runQueryWithoutRetrying(opCtx,
                                                 query,
                                                 readPref,
@@ -346,6 +410,15 @@ StatusWith<CursorId> ClusterFind::runQuery(OperationContext* opCtx,
                                                 results,
                                                 viewDefinition);
         if (cursorId.isOK()) {
+            // Only complete result sets are cached.
+            if (cacheKey && cursorId.getValue() == 0) {
+                resultCache->insert(query.nss(),
+                                    *cacheKey,
+                                    collectionVersion,
+                                    writeGeneration,
+                                    opCtx->getServiceContext()->getFastClockSource()->now(),
+                                    *results);
+            }
             return cursorId;
         }
 
@@ -36,4 +36,18 @@ namespace mongo {
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryAlwaysMergeOnPrimaryShard, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPrefetchShardBatches, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPrefetchShardBatchesMaxBytes,
+                              long long,
+                              16 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryRouterResultCacheTTLMillis, int, 1000);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryRouterResultCacheMaxResultBytes,
+                              long long,
+                              1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryRouterResultCacheMaxEntriesPerNamespace, int, 100);
+
 }  // namespace mongo
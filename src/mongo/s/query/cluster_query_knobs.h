@@ -37,4 +37,24 @@ namespace mongo {
 // will be selected randomly amongst the shards participating in the query.
 extern AtomicBool internalQueryAlwaysMergeOnPrimaryShard;
 
+// If set to true on mongos, a non-tailable cursor over the shards asks each shard for its next
+// batch as soon as the previous one arrives, so that the round trip overlaps with returning the
+// buffered results to the client.
+extern AtomicBool internalQueryPrefetchShardBatches;
+
+// When prefetching shard batches, the next batch is not requested from a shard whose results
+// already buffered on mongos take up at least this many bytes.
+extern AtomicInt64 internalQueryPrefetchShardBatchesMaxBytes;
+
+// For how long mongos serves the results of a query against a namespace listed in
+// routerResultCacheNamespaces from its result cache. Writes routed through other mongoses may go
+// unseen for this long.
+extern AtomicInt32 internalQueryRouterResultCacheTTLMillis;
+
+// The largest result set, in bytes, which mongos keeps in its result cache.
+extern AtomicInt64 internalQueryRouterResultCacheMaxResultBytes;
+
+// The largest number of result sets which mongos keeps in its result cache for one namespace.
+extern AtomicInt32 internalQueryRouterResultCacheMaxEntriesPerNamespace;
+
 }  // namespace mongo
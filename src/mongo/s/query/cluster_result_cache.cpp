@@ -0,0 +1,258 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_result_cache.h"
+
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/query/cluster_query_knobs.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/stringutils.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterResultCache = ServiceContext::declareDecoration<ClusterResultCache>();
+
+/**
+ * The namespaces whose query results may be cached, given as an array of namespace strings to
+ * setParameter or as a comma-separated list at startup.
+ */
+class RouterResultCacheNamespacesParameter final : public ServerParameter {
+    MONGO_DISALLOW_COPYING(RouterResultCacheNamespacesParameter);
+
+public:
+    RouterResultCacheNamespacesParameter()
+        : ServerParameter(
+              ServerParameterSet::getGlobal(), "routerResultCacheNamespaces", true, true) {}
+
+    void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) final {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        BSONArrayBuilder arr(b.subarrayStart(name));
+        for (const auto& ns : _namespaces) {
+            arr.append(ns);
+        }
+    }
+
+    Status set(const BSONElement& newValueElement) final {
+        if (newValueElement.type() == String) {
+            return setFromString(newValueElement.str());
+        }
+
+        if (newValueElement.type() != Array) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << name() << " must be an array of namespace strings"};
+        }
+
+        std::vector<std::string> namespaces;
+        for (const auto& elem : newValueElement.Obj()) {
+            if (elem.type() != String) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << name() << " must be an array of namespace strings"};
+            }
+            namespaces.push_back(elem.str());
+        }
+
+        return _set(namespaces);
+    }
+
+    Status setFromString(const std::string& str) final {
+        std::vector<std::string> namespaces;
+        splitStringDelim(str, &namespaces, ',');
+        return _set(namespaces);
+    }
+
+    bool contains(const NamespaceString& nss) {
+        if (!_anyNamespaces.load()) {
+            return false;
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _namespaces.count(nss.ns()) > 0;
+    }
+
+private:
+    Status _set(const std::vector<std::string>& namespaces) {
+        std::set<std::string> newNamespaces;
+        for (const auto& ns : namespaces) {
+            if (ns.empty()) {
+                continue;
+            }
+
+            if (!NamespaceString(ns).isValid()) {
+                return {ErrorCodes::InvalidNamespace,
+                        str::stream() << "invalid namespace '" << ns << "' in " << name()};
+            }
+            newNamespaces.insert(ns);
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _namespaces = std::move(newNamespaces);
+        _anyNamespaces.store(!_namespaces.empty());
+        return Status::OK();
+    }
+
+    // Lets queries skip the mutex when no namespace is cached, which is the default.
+    AtomicBool _anyNamespaces{false};
+
+    stdx::mutex _mutex;
+    std::set<std::string> _namespaces;
+} routerResultCacheNamespaces;
+
+size_t resultsSize(const std::vector<BSONObj>& results) {
+    size_t bytes = 0;
+    for (const auto& obj : results) {
+        bytes += obj.objsize();
+    }
+    return bytes;
+}
+
+}  // namespace
+
+ClusterResultCache::ClusterResultCache() = default;
+
+ClusterResultCache* ClusterResultCache::get(ServiceContext* serviceContext) {
+    return &getClusterResultCache(serviceContext);
+}
+
+ClusterResultCache* ClusterResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool ClusterResultCache::isEnabledFor(const NamespaceString& nss) {
+    return routerResultCacheNamespaces.contains(nss);
+}
+
+uint64_t ClusterResultCache::getWriteGeneration(const NamespaceString& nss) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _namespaces.find(nss.ns());
+    return it == _namespaces.end() ? 0 : it->second.writeGeneration;
+}
+
+bool ClusterResultCache::lookup(const NamespaceString& nss,
+                                const std::string& key,
+                                const ChunkVersion& version,
+                                Date_t now,
+                                std::vector<BSONObj>* results) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto nsIt = _namespaces.find(nss.ns());
+    if (nsIt == _namespaces.end()) {
+        return false;
+    }
+
+    auto& entries = nsIt->second.entries;
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    if (it->second.expireAt <= now || !it->second.version.isStrictlyEqualTo(version)) {
+        entries.erase(it);
+        return false;
+    }
+
+    *results = it->second.results;
+    return true;
+}
+
+void ClusterResultCache::insert(const NamespaceString& nss,
+                                std::string key,
+                                const ChunkVersion& version,
+                                uint64_t writeGeneration,
+                                Date_t now,
+                                const std::vector<BSONObj>& results) {
+    const auto maxEntries = internalQueryRouterResultCacheMaxEntriesPerNamespace.load();
+    if (maxEntries <= 0 ||
+        resultsSize(results) >
+            static_cast<size_t>(internalQueryRouterResultCacheMaxResultBytes.load())) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto& nsEntries = _namespaces[nss.ns()];
+    if (nsEntries.writeGeneration != writeGeneration) {
+        return;
+    }
+
+    auto& entries = nsEntries.entries;
+    if (entries.size() >= static_cast<size_t>(maxEntries) && !entries.count(key)) {
+        // Make room by dropping the expired entries first, and some other entry if there are none.
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second.expireAt <= now) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (entries.size() >= static_cast<size_t>(maxEntries)) {
+            entries.erase(entries.begin());
+        }
+    }
+
+    Entry entry;
+    entry.version = version;
+    entry.expireAt = now + Milliseconds(internalQueryRouterResultCacheTTLMillis.load());
+    for (const auto& obj : results) {
+        entry.results.push_back(obj.getOwned());
+    }
+    entries[std::move(key)] = std::move(entry);
+}
+
+void ClusterResultCache::invalidate(const NamespaceString& nss) {
+    if (!isEnabledFor(nss)) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // The namespace is added if it is not known yet, so that the results of a query which was
+    // already running when the write happened are not cached.
+    auto& nsEntries = _namespaces[nss.ns()];
+    ++nsEntries.writeGeneration;
+    nsEntries.entries.clear();
+}
+
+size_t ClusterResultCache::numEntries(const NamespaceString& nss) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _namespaces.find(nss.ns());
+    return it == _namespaces.end() ? 0 : it->second.entries.size();
+}
+
+}  // namespace mongo
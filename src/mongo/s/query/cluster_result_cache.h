@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/s/chunk_version.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class NamespaceString;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Holds the complete, small result sets of recent queries which mongos ran against the namespaces
+ * listed in the routerResultCacheNamespaces server parameter, so that a repeated query can be
+ * answered without contacting the shards.
+ *
+ * A cached result set is only served while the collection's version in the routing table is the one
+ * the query ran at, no write to the namespace has been routed through this mongos since, and it is
+ * younger than internalQueryRouterResultCacheTTLMillis. The last bound is the only one on writes
+ * routed through other mongoses or made directly against the shards.
+ *
+ * This class is thread-safe.
+ */
+class ClusterResultCache {
+    MONGO_DISALLOW_COPYING(ClusterResultCache);
+
+public:
+    ClusterResultCache();
+
+    /**
+     * Retrieves the ClusterResultCache associated with the specified service context.
+     */
+    static ClusterResultCache* get(ServiceContext* serviceContext);
+    static ClusterResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns whether the results of queries against 'nss' may be cached.
+     */
+    static bool isEnabledFor(const NamespaceString& nss);
+
+    /**
+     * Returns the count of the invalidations of 'nss'. It must be read before running a query,
+     * whose results are then only cached if no invalidation happened in the meantime.
+     */
+    uint64_t getWriteGeneration(const NamespaceString& nss) const;
+
+    /**
+     * Fills 'results' with the cached results of the query 'key' against 'nss' and returns true,
+     * if there are any which are still valid for the collection version 'version' at time 'now'.
+     */
+    bool lookup(const NamespaceString& nss,
+                const std::string& key,
+                const ChunkVersion& version,
+                Date_t now,
+                std::vector<BSONObj>* results);
+
+    /**
+     * Caches the complete results of the query 'key' against 'nss', which ran at collection version
+     * 'version' and time 'now', unless 'nss' has been invalidated since 'writeGeneration' was read
+     * or the results are too large to cache.
+     */
+    void insert(const NamespaceString& nss,
+                std::string key,
+                const ChunkVersion& version,
+                uint64_t writeGeneration,
+                Date_t now,
+                const std::vector<BSONObj>& results);
+
+    /**
+     * Drops the cached results of the queries against 'nss', after a write was routed to it. Does
+     * nothing if the results of queries against 'nss' are not cached.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Returns the number of result sets cached for 'nss'.
+     */
+    size_t numEntries(const NamespaceString& nss) const;
+
+private:
+    struct Entry {
+        ChunkVersion version;
+        Date_t expireAt;
+        std::vector<BSONObj> results;
+    };
+
+    struct NamespaceEntries {
+        uint64_t writeGeneration = 0;
+        stdx::unordered_map<std::string, Entry> entries;
+    };
+
+    mutable stdx::mutex _mutex;
+
+    StringMap<NamespaceEntries> _namespaces;
+};
+
+}  // namespace mongo
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/s/query/cluster_query_knobs.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.reference");
+const NamespaceString kOtherNss("test.other");
+
+class ClusterResultCacheTest : public unittest::Test {
+protected:
+    void setUp() final {
+        setCachedNamespaces(BSON_ARRAY(kNss.ns()));
+    }
+
+    void tearDown() final {
+        setCachedNamespaces(BSONArray());
+    }
+
+    void setCachedNamespaces(const BSONArray& namespaces) {
+        auto param = ServerParameterSet::getGlobal()->getMap().find("routerResultCacheNamespaces");
+        ASSERT(param != ServerParameterSet::getGlobal()->getMap().end());
+        ASSERT_OK(param->second->set(BSON("" << namespaces).firstElement()));
+    }
+
+    ClusterResultCache _cache;
+    const ChunkVersion _version{1, 0, OID::gen()};
+    const Date_t _now = Date_t::fromMillisSinceEpoch(1000000);
+    const std::vector<BSONObj> _results{BSON("_id" << 1), BSON("_id" << 2)};
+};
+
+TEST_F(ClusterResultCacheTest, OnlyListedNamespacesAreEnabled) {
+    ASSERT(ClusterResultCache::isEnabledFor(kNss));
+    ASSERT(!ClusterResultCache::isEnabledFor(kOtherNss));
+}
+
+TEST_F(ClusterResultCacheTest, LookupReturnsInsertedResults) {
+    _cache.insert(kNss, "q", _version, _cache.getWriteGeneration(kNss), _now, _results);
+
+    std::vector<BSONObj> results;
+    ASSERT(_cache.lookup(kNss, "q", _version, _now, &results));
+    ASSERT_EQ(2U, results.size());
+    ASSERT_BSONOBJ_EQ(_results[1], results[1]);
+
+    ASSERT(!_cache.lookup(kNss, "other query", _version, _now, &results));
+}
+
+TEST_F(ClusterResultCacheTest, EntriesExpire) {
+    _cache.insert(kNss, "q", _version, _cache.getWriteGeneration(kNss), _now, _results);
+
+    std::vector<BSONObj> results;
+    const auto ttl = Milliseconds(internalQueryRouterResultCacheTTLMillis.load());
+    ASSERT(_cache.lookup(kNss, "q", _version, _now + ttl - Milliseconds(1), &results));
+    ASSERT(!_cache.lookup(kNss, "q", _version, _now + ttl, &results));
+    ASSERT_EQ(0U, _cache.numEntries(kNss));
+}
+
+TEST_F(ClusterResultCacheTest, NewCollectionVersionMisses) {
+    _cache.insert(kNss, "q", _version, _cache.getWriteGeneration(kNss), _now, _results);
+
+    std::vector<BSONObj> results;
+    ASSERT(!_cache.lookup(kNss, "q", ChunkVersion(2, 0, _version.epoch()), _now, &results));
+    ASSERT_EQ(0U, _cache.numEntries(kNss));
+}
+
+TEST_F(ClusterResultCacheTest, InvalidateDropsEntries) {
+    _cache.insert(kNss, "q", _version, _cache.getWriteGeneration(kNss), _now, _results);
+    _cache.invalidate(kNss);
+
+    std::vector<BSONObj> results;
+    ASSERT(!_cache.lookup(kNss, "q", _version, _now, &results));
+}
+
+TEST_F(ClusterResultCacheTest, ResultsOfQueryConcurrentWithWriteAreNotCached) {
+    const auto writeGeneration = _cache.getWriteGeneration(kNss);
+    _cache.invalidate(kNss);
+    _cache.insert(kNss, "q", _version, writeGeneration, _now, _results);
+
+    ASSERT_EQ(0U, _cache.numEntries(kNss));
+}
+
+TEST_F(ClusterResultCacheTest, LargeResultsAreNotCached) {
+    const std::string bigString(internalQueryRouterResultCacheMaxResultBytes.load(), 'x');
+    _cache.insert(kNss,
+                  "q",
+                  _version,
+                  _cache.getWriteGeneration(kNss),
+                  _now,
+                  {BSON("_id" << 1 << "s" << bigString)});
+
+    ASSERT_EQ(0U, _cache.numEntries(kNss));
+}
+
+TEST_F(ClusterResultCacheTest, NumberOfEntriesIsBounded) {
+    const auto maxEntries = internalQueryRouterResultCacheMaxEntriesPerNamespace.load();
+    for (int i = 0; i < maxEntries + 10; i++) {
+        _cache.insert(kNss,
+                      std::to_string(i),
+                      _version,
+                      _cache.getWriteGeneration(kNss),
+                      _now,
+                      _results);
+    }
+
+    ASSERT_EQ(static_cast<size_t>(maxEntries), _cache.numEntries(kNss));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_change_watcher.h"
+
+#include <set>
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/s/catalog/type_changelog.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+// How often to look for routing table changes in the changelog. Zero or less disables the polling.
+MONGO_EXPORT_SERVER_PARAMETER(routingTableChangePollIntervalMS, int, 1000);
+
+const Milliseconds kDisabledRecheckInterval(10 * 1000);
+
+const NamespaceString kChangeLogNamespace("config.changelog");
+
+const ReadPreferenceSetting kConfigReadSelector(ReadPreference::Nearest, TagSet{});
+
+// The changelog entries recorded by the operations, which change the routing table of a collection
+const BSONArray kRoutingTableChanges(BSON_ARRAY("moveChunk.commit"
+                                                << "split"
+                                                << "multi-split"
+                                                << "merge"
+                                                << "shardCollection.end"
+                                                << "dropCollection"));
+
+/**
+ * Returns the time of the most recent entry in the changelog, or the epoch if there is none.
+ */
+StatusWith<Date_t> findLatestChangeTime(OperationContext* opCtx) {
+    auto findStatus = Grid::get(opCtx)->shardRegistry()->getConfigShard()->exhaustiveFindOnConfig(
+        opCtx,
+        kConfigReadSelector,
+        repl::ReadConcernLevel::kMajorityReadConcern,
+        kChangeLogNamespace,
+        BSONObj(),
+        BSON(ChangeLogType::time() << -1),
+        1);
+    if (!findStatus.isOK()) {
+        return findStatus.getStatus();
+    }
+
+    const auto& docs = findStatus.getValue().docs;
+    if (docs.empty()) {
+        return Date_t();
+    }
+
+    return docs.front()[ChangeLogType::time.name()].Date();
+}
+
+/**
+ * Refreshes the cached routing tables of the collections, whose routing table changed after
+ * 'lastChangeTime' and advances it to the time of the most recent such change. Only collections,
+ * which are already in the cache are refreshed. The refresh is incremental, since the cache entry
+ * retains its current routing table.
+ *
+ * Changes recorded within the same millisecond as 'lastChangeTime', but after the previous poll,
+ * are missed. Routing in that case falls back to the stale config errors.
+ */
+Status refreshChangedRoutingTables(OperationContext* opCtx, Date_t* lastChangeTime) {
+    auto findStatus = Grid::get(opCtx)->shardRegistry()->getConfigShard()->exhaustiveFindOnConfig(
+        opCtx,
+        kConfigReadSelector,
+        repl::ReadConcernLevel::kMajorityReadConcern,
+        kChangeLogNamespace,
+        BSON(ChangeLogType::time() << BSON("$gt" << *lastChangeTime) << ChangeLogType::what()
+                                   << BSON("$in" << kRoutingTableChanges)),
+        BSON(ChangeLogType::time() << 1),
+        boost::none);
+    if (!findStatus.isOK()) {
+        return findStatus.getStatus();
+    }
+
+    std::set<std::string> changedNamespaces;
+    for (const auto& doc : findStatus.getValue().docs) {
+        changedNamespaces.insert(doc[ChangeLogType::ns.name()].str());
+        *lastChangeTime = std::max(*lastChangeTime, doc[ChangeLogType::time.name()].Date());
+    }
+
+    const auto catalogCache = Grid::get(opCtx)->catalogCache();
+
+    for (const auto& ns : changedNamespaces) {
+        const NamespaceString nss(ns);
+        if (!nss.isValid() || !catalogCache->invalidateShardedCollectionIfCached(nss)) {
+            continue;
+        }
+
+        auto routingInfoStatus = catalogCache->getCollectionRoutingInfo(opCtx, nss);
+        if (!routingInfoStatus.isOK()) {
+            // The next request for the collection retries the refresh
+            warning() << "Failed to refresh the routing table for " << nss
+                      << " after a change was recorded in the changelog"
+                      << causedBy(routingInfoStatus.getStatus());
+        }
+    }
+
+    return Status::OK();
+}
+
+}  // namespace
+
+RoutingTableChangeWatcher::RoutingTableChangeWatcher() = default;
+
+RoutingTableChangeWatcher::~RoutingTableChangeWatcher() {
+    // The thread must not be running when this object is destroyed
+    invariant(!_thread.joinable());
+}
+
+void RoutingTableChangeWatcher::startPeriodicThread() {
+    invariant(!_thread.joinable());
+
+    _thread = stdx::thread([] {
+        Client::initThread("RoutingTableChangeWatcher");
+
+        // Only the changes recorded after the watcher started are of interest, because the
+        // routing tables cached before then are loaded on demand anyways
+        boost::optional<Date_t> lastChangeTime;
+
+        while (!globalInShutdownDeprecated()) {
+            const int pollIntervalMS = routingTableChangePollIntervalMS.load();
+            if (pollIntervalMS <= 0) {
+                lastChangeTime = boost::none;
+                sleepFor(kDisabledRecheckInterval);
+                continue;
+            }
+
+            {
+                auto opCtx = cc().makeOperationContext();
+
+                Status status = Status::OK();
+                if (!lastChangeTime) {
+                    auto latestStatus = findLatestChangeTime(opCtx.get());
+                    if (latestStatus.isOK()) {
+                        lastChangeTime = latestStatus.getValue();
+                    } else {
+                        status = latestStatus.getStatus();
+                    }
+                } else {
+                    status = refreshChangedRoutingTables(opCtx.get(), lastChangeTime.get_ptr());
+                }
+
+                if (!status.isOK()) {
+                    LOG(1) << "Failed to look for routing table changes in the changelog"
+                           << causedBy(status);
+                }
+            }
+
+            sleepFor(Milliseconds(pollIntervalMS));
+        }
+    });
+}
+
+}  // namespace mongo
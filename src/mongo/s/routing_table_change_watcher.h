@@ -0,0 +1,61 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+
+/**
+ * Utility class, which is used on mongos to periodically look for routing table changes recorded
+ * in the config server's changelog (chunk migrations, splits, merges and collection drops) and to
+ * refresh the affected cached routing tables ahead of the requests, which would otherwise only
+ * find out about them through stale config errors.
+ *
+ * NOTE: Not thread-safe, so it should not be used from more than one thread at a time.
+ */
+class RoutingTableChangeWatcher {
+    MONGO_DISALLOW_COPYING(RoutingTableChangeWatcher);
+
+public:
+    RoutingTableChangeWatcher();
+    ~RoutingTableChangeWatcher();
+
+    /**
+     * Starts the thread, which periodically polls the changelog.
+     */
+    void startPeriodicThread();
+
+private:
+    // The background watcher thread (if started)
+    stdx::thread _thread;
+};
+
+}  // namespace mongo
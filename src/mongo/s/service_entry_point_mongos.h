@@ -35,6 +35,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -42,7 +44,9 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongos. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the Session's
+ * TransportLayer supports asynchronous waits, in which case requests are run on a shared pool of
+ * worker threads.
  */
 class ServiceEntryPointMongos final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongos);
@@ -57,6 +61,11 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs the request in 'message', replying to the client as the request requires.
+     */
+    void _processMessage(const transport::SessionHandle& session, Message* message);
+
     transport::TransportLayer* _tl;
 };
 
@@ -86,7 +86,8 @@ StatusWith<std::vector<BSONObj>> selectChunkSplitPoints(OperationContext* opCtx,
                                                         const ShardKeyPattern& shardKeyPattern,
                                                         const ChunkRange& chunkRange,
                                                         long long chunkSizeBytes,
-                                                        boost::optional<int> maxObjs) {
+                                                        boost::optional<int> maxObjs,
+                                                        int sampleSize) {
     BSONObjBuilder cmd;
     cmd.append("splitVector", nss.ns());
     cmd.append("keyPattern", shardKeyPattern.toBSON());
@@ -95,6 +96,9 @@ StatusWith<std::vector<BSONObj>> selectChunkSplitPoints(OperationContext* opCtx,
     if (maxObjs) {
         cmd.append("maxChunkObjects", *maxObjs);
     }
+    if (sampleSize > 0) {
+        cmd.append("sampleSize", sampleSize);
+    }
 
     auto shardStatus = Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -70,6 +70,8 @@ StatusWith<long long> retrieveTotalShardSize(OperationContext* opCtx, const Shar
  * chunkSize Chunk size to target in bytes.
  * maxObjs Limits the number of objects in each chunk. Zero means max, unspecified means use the
  *         server default.
+ * sampleSize If positive, the shard estimates the split points from this many randomly sampled
+ *            shard key index entries instead of scanning the whole chunk.
  */
 StatusWith<std::vector<BSONObj>> selectChunkSplitPoints(OperationContext* opCtx,
                                                         const ShardId& shardId,
@@ -77,7 +79,8 @@ StatusWith<std::vector<BSONObj>> selectChunkSplitPoints(OperationContext* opCtx,
                                                         const ShardKeyPattern& shardKeyPattern,
                                                         const ChunkRange& chunkRange,
                                                         long long chunkSizeBytes,
-                                                        boost::optional<int> maxObjs);
+                                                        boost::optional<int> maxObjs,
+                                                        int sampleSize);
 
 /**
  * Asks the specified shard to split the chunk described by min/maxKey into the respective split
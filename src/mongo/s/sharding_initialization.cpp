@@ -32,6 +32,7 @@
 
 #include "mongo/s/sharding_initialization.h"
 
+#include <algorithm>
 #include <string>
 
 #include "mongo/base/status.h"
@@ -74,9 +75,13 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolHostTimeoutMS,
                                       int,
                                       ConnectionPool::kDefaultHostTimeout.count());
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxSize, int, -1);
+// If positive, caps the connections to each host across all of the executors in the
+// TaskExecutorPool, by splitting it evenly between their connection pools.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxTotalSizePerHost, int, -1);
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMinSize,
                                       int,
                                       static_cast<int>(ConnectionPool::kDefaultMinConns));
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxConnecting, int, 2);
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolRefreshRequirementMS,
                                       int,
                                       ConnectionPool::kDefaultRefreshRequirement.count());
@@ -121,7 +126,19 @@ std::unique_ptr<TaskExecutorPool> makeTaskExecutorPool(
     ConnectionPool::Options connPoolOptions) {
     std::vector<std::unique_ptr<executor::TaskExecutor>> executors;
 
-    for (size_t i = 0; i < TaskExecutorPool::getSuggestedPoolSize(); ++i) {
+    const auto poolSize = TaskExecutorPool::getSuggestedPoolSize();
+
+    // Each executor has its own network interface and connection pool, so without a total cap the
+    // number of connections to a host grows with the number of executors.
+    if (ShardingTaskExecutorPoolMaxTotalSizePerHost > 0) {
+        const size_t perPoolMax =
+            std::max<size_t>(1, ShardingTaskExecutorPoolMaxTotalSizePerHost / poolSize);
+        connPoolOptions.maxConnections = std::min(connPoolOptions.maxConnections, perPoolMax);
+        connPoolOptions.minConnections =
+            std::min(connPoolOptions.minConnections, connPoolOptions.maxConnections);
+    }
+
+    for (size_t i = 0; i < poolSize; ++i) {
         auto exec = makeTaskExecutor(executor::makeNetworkInterface(
             "NetworkInterfaceASIO-TaskExecutorPool-" + std::to_string(i),
             stdx::make_unique<ShardingNetworkConnectionHook>(),
@@ -172,6 +189,9 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
         ? ShardingTaskExecutorPoolMaxSize
         : ConnectionPool::kDefaultMaxConns;
     connPoolOptions.minConnections = ShardingTaskExecutorPoolMinSize;
+    connPoolOptions.maxConnecting = (ShardingTaskExecutorPoolMaxConnecting > 0)
+        ? ShardingTaskExecutorPoolMaxConnecting
+        : ConnectionPool::kDefaultMaxConnecting;
     connPoolOptions.refreshRequirement = Milliseconds(ShardingTaskExecutorPoolRefreshRequirementMS);
     connPoolOptions.refreshTimeout = Milliseconds(ShardingTaskExecutorPoolRefreshTimeoutMS);
 
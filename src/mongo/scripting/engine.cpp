@@ -33,18 +33,23 @@
 
 #include "mongo/scripting/engine.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <cctype>
 
+#include "mongo/base/counter.h"
 #include "mongo/client/dbclientcursor.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/scripting/dbdirectclient_factory.h"
 #include "mongo/util/file.h"
 #include "mongo/util/log.h"
 #include "mongo/util/text.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -55,10 +60,32 @@ using std::unique_ptr;
 
 AtomicInt64 Scope::_lastVersion(1);
 
+// The most idle scopes kept for reuse across all pools, and the most times a scope is reused
+// before it is discarded rather than returned to its pool.
+MONGO_EXPORT_SERVER_PARAMETER(scriptingEngineScopePoolSize, int, 10);
+MONGO_EXPORT_SERVER_PARAMETER(scriptingEngineMaxScopeReuse, int, 10);
+
 namespace {
 // 2 GB is the largest support Javascript file size.
 const fileofs kMaxJsFileLength = fileofs(2) * 1024 * 1024 * 1024;
 
+Counter64 scopePoolHits;
+Counter64 scopePoolMisses;
+ServerStatusMetricField<Counter64> displayScopePoolHits("scripting.scopePool.hits",
+                                                        &scopePoolHits);
+ServerStatusMetricField<Counter64> displayScopePoolMisses("scripting.scopePool.misses",
+                                                          &scopePoolMisses);
+
+Counter64 functionCacheHits;
+Counter64 functionCacheMisses;
+Counter64 functionCompileMicros;
+ServerStatusMetricField<Counter64> displayFunctionCacheHits("scripting.functionCache.hits",
+                                                            &functionCacheHits);
+ServerStatusMetricField<Counter64> displayFunctionCacheMisses("scripting.functionCache.misses",
+                                                              &functionCacheMisses);
+ServerStatusMetricField<Counter64> displayFunctionCompileMicros(
+    "scripting.functionCache.compileMicros", &functionCompileMicros);
+
 const ServiceContext::Decoration<std::unique_ptr<ScriptEngine>> forService =
     ServiceContext::declareDecoration<std::unique_ptr<ScriptEngine>>();
 static std::unique_ptr<ScriptEngine> globalScriptEngine;
@@ -270,14 +297,20 @@ ScriptingFunction Scope::createFunction(const char* code) {
     }
 
     FunctionCacheMap::iterator i = _cachedFunctions.find(code);
-    if (i != _cachedFunctions.end())
+    if (i != _cachedFunctions.end()) {
+        functionCacheHits.increment();
         return i->second;
+    }
+    functionCacheMisses.increment();
+
     // NB: we calculate the function number for v8 so the cache can be utilized to
     //     lookup the source on an exception, but SpiderMonkey uses the value
     //     returned by JS_CompileFunction.
+    Timer compileTimer;
     ScriptingFunction defaultFunctionNumber = getFunctionCache().size() + 1;
     ScriptingFunction actualFunctionNumber = _createFunction(code, defaultFunctionNumber);
     _cachedFunctions[code] = actualFunctionNumber;
+    functionCompileMicros.increment(compileTimer.micros());
     return actualFunctionNumber;
 }
 
@@ -328,13 +361,18 @@ public:
             return;
         }
 
-        if (scope->getTimesUsed() > kMaxScopeReuse)
+        if (scope->getTimesUsed() > scriptingEngineMaxScopeReuse.load())
             return;  // used too many times to save
 
         if (!scope->getError().empty())
             return;  // not saving errored scopes
 
-        if (_pools.size() >= kMaxPoolSize) {
+        const size_t maxPoolSize = std::max(scriptingEngineScopePoolSize.load(), 0);
+        if (maxPoolSize == 0) {
+            _pools.clear();
+            return;
+        }
+        while (_pools.size() >= maxPoolSize) {
             // prefer to keep recently-used scopes
             _pools.pop_back();
         }
@@ -373,10 +411,8 @@ private:
         string poolName;
     };
 
-    // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
-    static const int kMaxScopeReuse = 10;
-
+    // Note: if 'scriptingEngineScopePoolSize' is raised far, reconsider choice of datastructure
+    // for _pools
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
     stdx::mutex _mutex;
@@ -537,7 +573,10 @@ unique_ptr<Scope> ScriptEngine::getPooledScope(OperationContext* opCtx,
                                                const string& scopeType) {
     const string fullPoolName = db + scopeType;
     std::shared_ptr<Scope> s = scopeCache.tryAcquire(opCtx, fullPoolName);
-    if (!s) {
+    if (s) {
+        scopePoolHits.increment();
+    } else {
+        scopePoolMisses.increment();
         s.reset(newScope());
         s->registerOperation(opCtx);
     }
@@ -318,6 +318,12 @@ BenchRunOp opFromBson(const BSONObj& op) {
                                   << opType,
                     (opType == "command") || (opType == "query") || (opType == "find"));
             myOp.options = arg.numberInt();
+        } else if (name == "prefetch") {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Field 'prefetch' is only valid for find op types. Type is "
+                                  << opType,
+                    (opType == "find") || (opType == "query"));
+            myOp.prefetch = arg.trueValue();
         } else if (name == "query") {
             uassert(34389,
                     str::stream() << "Field 'query' is only valid for findOne, find, update, and "
@@ -847,6 +853,9 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                                                      &op.projection,
                                                      op.options,
                                                      op.batchSize);
+                                if (op.prefetch) {
+                                    cursor->enablePrefetch();
+                                }
                                 count = cursor->itcount();
                             }
                         }
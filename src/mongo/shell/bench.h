@@ -77,6 +77,7 @@ public:
     std::string ns;
     OpType op = OpType::NONE;
     int options = 0;
+    bool prefetch = false;
     BSONObj projection;
     BSONObj query;
     bool safe = false;
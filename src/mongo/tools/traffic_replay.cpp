@@ -0,0 +1,429 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/base/data_view.h"
+#include "mongo/base/init.h"
+#include "mongo/base/initializer.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclientinterface.h"
+#include "mongo/db/dbmessage.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/service_context_noop.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
+#include "mongo/rpc/factory.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/reply_interface.h"
+#include "mongo/rpc/request_interface.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/tools/mongotrafficreplay_options.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/quick_exit.h"
+#include "mongo/util/signal_handlers.h"
+#include "mongo/util/text.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+namespace {
+
+struct RecordedMessage {
+    long long offsetMicros;
+    Message message;
+};
+
+/**
+ * The messages a client sent on one connection, in the order they were received.
+ */
+struct RecordedSession {
+    long long id;
+    std::string remote;
+    std::vector<RecordedMessage> messages;
+};
+
+/**
+ * Reads a recording written by the startRecordingTraffic command into memory, grouping its
+ * messages by the connection they were received on. See TrafficRecorder for the format.
+ */
+StatusWith<std::vector<RecordedSession>> readRecording(const std::string& filename) {
+    std::ifstream in(filename, std::ios_base::in | std::ios_base::binary);
+    if (!in.is_open()) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "Unable to open recording " << filename};
+    }
+
+    std::vector<RecordedSession> sessions;
+    std::map<long long, size_t> sessionIndexes;
+
+    while (true) {
+        char sizeBytes[sizeof(int32_t)];
+        in.read(sizeBytes, sizeof(sizeBytes));
+        if (in.gcount() == 0 && in.eof()) {
+            break;
+        }
+
+        const int32_t size = ConstDataView(sizeBytes).read<LittleEndian<int32_t>>();
+        if (!in || size < BSONObj::kMinBSONLength || size > BSONObjMaxInternalSize) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Recording " << filename << " is truncated or corrupt"};
+        }
+
+        auto buffer = SharedBuffer::allocate(size);
+        std::copy(sizeBytes, sizeBytes + sizeof(sizeBytes), buffer.get());
+        in.read(buffer.get() + sizeof(sizeBytes), size - sizeof(sizeBytes));
+        if (!in) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Recording " << filename << " is truncated"};
+        }
+
+        Status status = validateBSON(buffer.get(), size, BSONVersion::kLatest);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        BSONObj entry(buffer);
+        BSONElement messageElem = entry["message"];
+        int messageSize = 0;
+        const char* messageData = nullptr;
+        if (messageElem.type() == BinData) {
+            messageData = messageElem.binData(messageSize);
+        }
+
+        if (!messageData || messageSize < static_cast<int>(sizeof(MSGHEADER::Value)) ||
+            MsgData::ConstView(messageData).getLen() != messageSize) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Invalid message in recording entry " << entry["order"]};
+        }
+
+        auto messageBuffer = SharedBuffer::allocate(messageSize);
+        std::copy(messageData, messageData + messageSize, messageBuffer.get());
+
+        const long long sessionId = entry["session"].safeNumberLong();
+        auto inserted = sessionIndexes.insert(std::make_pair(sessionId, sessions.size()));
+        if (inserted.second) {
+            sessions.push_back({sessionId, entry["remote"].str(), {}});
+        }
+
+        sessions[inserted.first->second].messages.push_back(
+            {entry["offsetMicros"].safeNumberLong(), Message(std::move(messageBuffer))});
+    }
+
+    return {std::move(sessions)};
+}
+
+/**
+ * Returns whether the server replies to messages of type 'op'.
+ */
+bool expectsReply(NetworkOp op) {
+    return op == dbQuery || op == dbGetMore || op == dbCommand;
+}
+
+/**
+ * Returns the name to report the latency of 'message' under: the name of the command it runs, or
+ * else the name of its operation. Sets 'isCommand' accordingly.
+ */
+std::string describeMessage(const Message& message, bool* isCommand) {
+    const NetworkOp op = message.operation();
+    *isCommand = false;
+
+    if (op == dbQuery) {
+        DbMessage dbMessage(message);
+        QueryMessage query(dbMessage);
+        if (!NamespaceString(query.ns).isCommand()) {
+            return networkOpToString(op);
+        }
+    } else if (op != dbCommand) {
+        return networkOpToString(op);
+    }
+
+    try {
+        auto request = rpc::makeRequest(&message);
+        *isCommand = true;
+        return request->getCommandName().toString();
+    } catch (const DBException&) {
+        return networkOpToString(op);
+    }
+}
+
+/**
+ * Returns whether 'response' reports that the request failed.
+ */
+bool isErrorResponse(const Message& response, bool isCommand) {
+    if (isCommand) {
+        try {
+            auto reply = rpc::makeReply(&response);
+            return !getStatusFromCommandResult(reply->getCommandReply()).isOK();
+        } catch (const DBException&) {
+            return true;
+        }
+    }
+
+    QueryResult::View queryResult(const_cast<char*>(response.buf()));
+    return queryResult.getResultFlags() & (ResultFlag_ErrSet | ResultFlag_CursorNotFound);
+}
+
+struct OpStats {
+    HdrLatencyHistogram latencies;
+    long long errors = 0;
+};
+
+/**
+ * The outcome of the replay, merged from the connections as they finish.
+ */
+class ReplayStats {
+public:
+    void merge(const std::map<std::string, OpStats>& opStats,
+               const HdrLatencyHistogram& lag,
+               bool failed) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (const auto& kv : opStats) {
+            auto& stats = _opStats[kv.first];
+            stats.latencies.merge(kv.second.latencies);
+            stats.errors += kv.second.errors;
+        }
+        _lag.merge(lag);
+        if (failed) {
+            ++_failedConnections;
+        }
+    }
+
+    /**
+     * Appends the latency distributions, in microseconds, of every kind of operation replayed,
+     * and how late the messages were sent relative to the recording.
+     */
+    void append(BSONObjBuilder* builder) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        builder->append("failedConnections", _failedConnections);
+
+        BSONObjBuilder lagBuilder(builder->subobjStart("scheduleLagMicros"));
+        _lag.appendPercentiles(&lagBuilder);
+        lagBuilder.doneFast();
+
+        BSONObjBuilder opsBuilder(builder->subobjStart("latencyMicros"));
+        for (const auto& kv : _opStats) {
+            BSONObjBuilder opBuilder(opsBuilder.subobjStart(kv.first));
+            opBuilder.append("count", static_cast<long long>(kv.second.latencies.count()));
+            opBuilder.append("errors", kv.second.errors);
+            kv.second.latencies.appendPercentiles(&opBuilder);
+        }
+        opsBuilder.doneFast();
+    }
+
+private:
+    stdx::mutex _mutex;
+    std::map<std::string, OpStats> _opStats;
+    HdrLatencyHistogram _lag;
+    long long _failedConnections = 0;
+};
+
+/**
+ * Replays the messages of one recorded connection over a connection of its own, each at the same
+ * time relative to the start of the replay as it was received relative to the first message of
+ * the recording, scaled by the --speed option.
+ */
+void replaySession(const RecordedSession& session,
+                   const HostAndPort& dest,
+                   const Timer& replayTimer,
+                   long long firstOffsetMicros,
+                   ReplayStats* replayStats) {
+    const double speed = mongoTrafficReplayGlobalParams.speed;
+
+    std::map<std::string, OpStats> opStats;
+    HdrLatencyHistogram lag;
+    bool failed = false;
+
+    // Connect without sending an isMaster, as the client's own handshake is part of the recording.
+    DBClientConnection conn;
+    Status status = conn.connectSocketOnly(dest);
+    if (!status.isOK()) {
+        warning() << "Unable to connect to " << dest << " to replay the connection from "
+                  << session.remote << ": " << status;
+        replayStats->merge(opStats, lag, true);
+        return;
+    }
+
+    for (const auto& recorded : session.messages) {
+        if (speed > 0) {
+            const long long dueMicros =
+                static_cast<long long>((recorded.offsetMicros - firstOffsetMicros) / speed);
+            const long long nowMicros = replayTimer.micros();
+            if (dueMicros > nowMicros) {
+                sleepmicros(dueMicros - nowMicros);
+            } else {
+                lag.increment(nowMicros - dueMicros);
+            }
+        }
+
+        Message request = recorded.message;
+        const NetworkOp op = request.operation();
+        bool isCommand;
+        auto& stats = opStats[describeMessage(request, &isCommand)];
+
+        // An exhaust query would have the server stream replies which this connection does not
+        // read, so that it is replayed as a plain query.
+        if (op == dbQuery) {
+            DataView flags(request.singleData().data());
+            flags.write(tagLittleEndian(flags.read<LittleEndian<int32_t>>() &
+                                        ~static_cast<int32_t>(QueryOption_Exhaust)));
+        }
+
+        try {
+            Timer timer;
+            if (expectsReply(op)) {
+                Message response;
+                conn.port().call(request, response);
+                stats.latencies.increment(timer.micros());
+
+                if (response.empty()) {
+                    warning() << "Received an empty response replaying the connection from "
+                              << session.remote;
+                    failed = true;
+                    break;
+                }
+
+                if (isErrorResponse(response, isCommand)) {
+                    ++stats.errors;
+                }
+            } else {
+                // The server does not reply to legacy writes, so only the time to send them is
+                // known.
+                conn.port().say(request);
+                stats.latencies.increment(timer.micros());
+            }
+        } catch (const DBException& ex) {
+            warning() << "Error replaying the connection from " << session.remote << ": "
+                      << redact(ex);
+            ++stats.errors;
+            failed = true;
+            break;
+        }
+    }
+
+    replayStats->merge(opStats, lag, failed);
+}
+
+MONGO_INITIALIZER(SetGlobalEnvironment)(InitializerContext* context) {
+    setGlobalServiceContext(stdx::make_unique<ServiceContextNoop>());
+    return Status::OK();
+}
+
+}  // namespace
+
+int trafficReplayMain(int argc, char** argv, char** envp) {
+    setupSignalHandlers();
+    runGlobalInitializersOrDie(argc, argv, envp);
+    startSignalProcessingThread(LogFileStatus::kNoLogFileToRotate);
+
+    auto swSessions = readRecording(mongoTrafficReplayGlobalParams.recording);
+    if (!swSessions.isOK()) {
+        error() << swSessions.getStatus();
+        return EXIT_FAILURE;
+    }
+    const auto& sessions = swSessions.getValue();
+
+    long long firstOffsetMicros = std::numeric_limits<long long>::max();
+    long long numMessages = 0;
+    for (const auto& session : sessions) {
+        for (const auto& recorded : session.messages) {
+            firstOffsetMicros = std::min(firstOffsetMicros, recorded.offsetMicros);
+        }
+        numMessages += session.messages.size();
+    }
+
+    log() << "Replaying " << numMessages << " messages from " << sessions.size()
+          << " connections against " << mongoTrafficReplayGlobalParams.destUri;
+
+    const HostAndPort dest(mongoTrafficReplayGlobalParams.destUri);
+    ReplayStats replayStats;
+    Timer replayTimer;
+
+    std::vector<stdx::thread> threads;
+    threads.reserve(sessions.size());
+    for (const auto& session : sessions) {
+        threads.emplace_back(replaySession,
+                             std::cref(session),
+                             std::cref(dest),
+                             std::cref(replayTimer),
+                             firstOffsetMicros,
+                             &replayStats);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder report;
+    report.append("connections", static_cast<long long>(sessions.size()));
+    report.append("messages", numMessages);
+    report.append("elapsedMicros", replayTimer.micros());
+    replayStats.append(&report);
+    std::cout << report.obj().jsonString(Strict, 1) << std::endl;
+
+    return EXIT_CLEAN;
+}
+
+}  // namespace mongo
+
+#if defined(_WIN32)
+// In Windows, wmain() is an alternate entry point for main(), and receives the same parameters
+// as main() but encoded in Windows Unicode (UTF-16); "wide" 16-bit wchar_t characters.  The
+// WindowsCommandLine object converts these wide character strings to a UTF-8 coded equivalent
+// and makes them available through the argv() and envp() members.  This enables
+// trafficReplayMain() to process UTF-8 encoded arguments and environment variables without regard
+// to platform.
+int wmain(int argc, wchar_t* argvW[], wchar_t* envpW[]) {
+    mongo::WindowsCommandLine wcl(argc, argvW, envpW);
+    int exitCode = mongo::trafficReplayMain(argc, wcl.argv(), wcl.envp());
+    mongo::quickExit(exitCode);
+}
+#else
+int main(int argc, char* argv[], char** envp) {
+    int exitCode = mongo::trafficReplayMain(argc, argv, envp);
+    mongo::quickExit(exitCode);
+}
+#endif
@@ -34,16 +34,22 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_exception.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/quick_exit.h"
 
 #ifdef __linux__  // TODO: consider making this ifndef _WIN32
+#include <sched.h>
 #include <sys/resource.h>
 #endif
 
@@ -55,6 +61,11 @@ namespace mongo {
 
 namespace {
 
+// When set, each per-connection thread is bound to the CPUs of one NUMA node, round robin by
+// session id. The memory such a thread first touches (its stack, the buffers of its requests) is
+// then allocated on that node by the kernel's default local allocation policy.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(serviceWorkerNumaPinning, bool, false);
+
 /**
  * This object takes ownership of transport::SessionHandle.
  */
@@ -101,6 +112,111 @@ void* runFunc(void* ptr) {
 
     return nullptr;
 }
+
+/**
+ * State for a Session that is run by launchAsyncServiceEntrySession(). It is shared between the
+ * TransportLayer's completion handlers and the service worker that runs the next request.
+ */
+struct AsyncContext {
+    AsyncContext(transport::SessionHandle session,
+                 stdx::function<bool(const transport::SessionHandle&, Message*)> handler)
+        : session(std::move(session)), handler(std::move(handler)) {}
+
+    transport::SessionHandle session;
+    stdx::function<bool(const transport::SessionHandle&, Message*)> handler;
+
+    // The Client for this Session, while it is not attached to a worker thread.
+    ServiceContext::UniqueClient client;
+    std::string threadName;
+
+    Message message;
+};
+
+ThreadPool* getServiceWorkerPool() {
+    // Intentionally leaked, like the per-connection threads which it replaces, since there is no
+    // point during shutdown at which all Sessions are guaranteed to have ended.
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "ServiceWorkers";
+        options.threadNamePrefix = "worker-";
+        options.minThreads = 1;
+        // Each Session runs at most one request at a time, so there is never a need for more
+        // workers than there may be open connections.
+        options.maxThreads = static_cast<size_t>(serverGlobalParams.maxConns);
+        auto pool = new ThreadPool(options);
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+void endAsyncSession(const std::shared_ptr<AsyncContext>& ctx) {
+    auto tl = ctx->session->getTransportLayer();
+    tl->end(ctx->session);
+
+    if (!serverGlobalParams.quiet.load()) {
+        auto conns = tl->sessionStats().numOpenSessions;
+        const char* word = (conns == 1 ? " connection" : " connections");
+        log() << "end connection " << ctx->session->remote() << " (" << conns << word
+              << " now open)";
+    }
+
+    ctx->client.reset();
+}
+
+void sourceNextMessage(const std::shared_ptr<AsyncContext>& ctx);
+
+void runAsyncRequest(const std::shared_ptr<AsyncContext>& ctx) {
+    Client::setCurrent(std::move(ctx->client));
+    setThreadName(ctx->threadName);
+
+    bool keepRunning = false;
+    try {
+        keepRunning = ctx->handler(ctx->session, &ctx->message);
+    } catch (const AssertionException& e) {
+        log() << "AssertionException handling request, closing client connection: " << e;
+    } catch (const SocketException& e) {
+        log() << "SocketException handling request, closing client connection: " << e;
+    } catch (const DBException& e) {
+        // must be right above std::exception to avoid catching subclasses
+        log() << "DBException handling request, closing client connection: " << e;
+    } catch (const std::exception& e) {
+        error() << "Uncaught std::exception: " << e.what() << ", terminating";
+        quickExit(EXIT_UNCAUGHT);
+    }
+
+    ctx->client = Client::releaseCurrent();
+
+    if (keepRunning) {
+        sourceNextMessage(ctx);
+    } else {
+        endAsyncSession(ctx);
+    }
+}
+
+void sourceNextMessage(const std::shared_ptr<AsyncContext>& ctx) {
+    ctx->message.reset();
+    ctx->session->sourceMessage(&ctx->message).asyncWait([ctx](Status status) {
+        if (!status.isOK()) {
+            if (!ErrorCodes::isInterruption(status.code()) &&
+                !ErrorCodes::isNetworkError(status.code()) &&
+                status != transport::TransportLayer::TicketSessionClosedStatus) {
+                log() << "Error receiving request from client, closing client connection: "
+                      << status;
+            }
+            endAsyncSession(ctx);
+            return;
+        }
+
+        auto scheduled = getServiceWorkerPool()->schedule([ctx] { runAsyncRequest(ctx); });
+        if (!scheduled.isOK()) {
+            log() << "failed to schedule request for " << ctx->session->remote() << ": "
+                  << scheduled;
+            endAsyncSession(ctx);
+        }
+    });
+}
+
 }  // namespace
 
 void launchWrappedServiceEntryWorkerThread(
@@ -136,6 +252,22 @@ void launchWrappedServiceEntryWorkerThread(
             warning() << "Stack size set to " << (limits.rlim_cur / 1024) << "KB. We suggest 1MB";
         }
 
+        if (serviceWorkerNumaPinning) {
+            const auto& nodeCpus = ProcessInfo().getNumaNodeCpus();
+            if (nodeCpus.size() > 1) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                for (unsigned cpu : nodeCpus[ctx->session->id() % nodeCpus.size()]) {
+                    if (cpu < CPU_SETSIZE)
+                        CPU_SET(cpu, &cpus);
+                }
+                int failed = pthread_attr_setaffinity_np(&attrs, sizeof(cpus), &cpus);
+                if (failed) {
+                    const auto ewd = errnoWithDescription(failed);
+                    warning() << "pthread_attr_setaffinity_np failed: " << ewd;
+                }
+            }
+        }
 
         pthread_t thread;
         int failed = pthread_create(&thread, &attrs, runFunc, ctx.get());
@@ -155,4 +287,16 @@ void launchWrappedServiceEntryWorkerThread(
     }
 }
 
+void launchAsyncServiceEntrySession(
+    transport::SessionHandle session,
+    stdx::function<bool(const transport::SessionHandle&, Message*)> handler) {
+    invariant(session->getTransportLayer()->supportsAsyncWait());
+
+    auto ctx = std::make_shared<AsyncContext>(std::move(session), std::move(handler));
+    ctx->threadName = str::stream() << "conn" << ctx->session->id();
+    ctx->client = getGlobalServiceContext()->makeClient(ctx->threadName, ctx->session);
+
+    sourceNextMessage(ctx);
+}
+
 }  // namespace mongo
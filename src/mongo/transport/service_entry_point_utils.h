@@ -30,10 +30,24 @@
 
 #include "mongo/stdx/functional.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/net/message.h"
 
 namespace mongo {
 
 void launchWrappedServiceEntryWorkerThread(
     transport::SessionHandle session, stdx::function<void(const transport::SessionHandle&)> task);
 
+/**
+ * Runs a Session without dedicating a thread to it. This may only be used for Sessions whose
+ * TransportLayer supportsAsyncWait().
+ *
+ * Each incoming Message is sourced asynchronously by the TransportLayer. Once a Message has
+ * arrived, 'handler' is run on a thread from a shared pool of service workers, with the Session's
+ * Client attached to that thread for the duration of the call. 'handler' returns true to source
+ * the next Message, or false to end the Session.
+ */
+void launchAsyncServiceEntrySession(
+    transport::SessionHandle session,
+    stdx::function<bool(const transport::SessionHandle&, Message*)> handler);
+
 }  // namespace mongo
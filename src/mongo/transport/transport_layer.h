@@ -147,6 +147,15 @@ public:
      */
     virtual void asyncWait(Ticket&& ticket, TicketCallback callback) = 0;
 
+    /**
+     * Returns true if this TransportLayer implements asyncWait(). ServiceEntryPoints use this to
+     * decide whether a Session needs a thread of its own, or whether it can be driven by
+     * asynchronous waits and only occupy a worker thread while a request is being run.
+     */
+    virtual bool supportsAsyncWait() const {
+        return false;
+    }
+
     /**
      * Returns the number of sessions currently open in the transport layer.
      */
@@ -0,0 +1,597 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/config.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/listen.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/net/ssl_options.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+const size_t kHeaderSize = sizeof(MSGHEADER::Value);
+
+Status errorCodeToStatus(const asio::error_code& ec) {
+    if (!ec) {
+        return Status::OK();
+    }
+
+    if (ec == asio::error::eof || ec == asio::error::operation_aborted ||
+        ec == asio::error::connection_reset || ec == asio::error::broken_pipe) {
+        return {ErrorCodes::HostUnreachable, ec.message()};
+    }
+
+    return {ErrorCodes::SocketException, ec.message()};
+}
+
+HostAndPort endpointToHostAndPort(const asio::generic::stream_protocol::endpoint& endpoint) {
+    SockAddr addr;
+    invariant(endpoint.size() <= sizeof(sockaddr_storage));
+    memcpy(addr.raw(), endpoint.data(), endpoint.size());
+    addr.addressSize = endpoint.size();
+    if (addr.getType() == AF_UNIX) {
+        return HostAndPort(addr.getAddr(), 0);
+    }
+    return HostAndPort(addr.getAddr(), addr.getPort());
+}
+
+}  // namespace
+
+TransportLayerASIO::ASIOSession::ASIOSession(TransportLayerASIO* tl,
+                                             GenericSocket socket,
+                                             long long connectionId)
+    : _tl(tl), _socket(std::move(socket)), _connectionId(connectionId) {
+    asio::error_code ec;
+    auto remoteEndpoint = _socket.remote_endpoint(ec);
+    if (!ec) {
+        _remote = endpointToHostAndPort(remoteEndpoint);
+    }
+    auto localEndpoint = _socket.local_endpoint(ec);
+    if (!ec) {
+        _local = endpointToHostAndPort(localEndpoint);
+    }
+}
+
+TransportLayerASIO::ASIOSession::~ASIOSession() {
+    _tl->_destroy(*this);
+}
+
+bool TransportLayerASIO::ASIOSession::close() {
+    if (_closed.swap(true)) {
+        return false;
+    }
+
+    // Only shut the socket down here; outstanding operations on other threads may still refer to
+    // it. The descriptor itself is released when the session is destroyed.
+    asio::error_code ec;
+    _socket.shutdown(GenericSocket::shutdown_both, ec);
+    return true;
+}
+
+TransportLayerASIO::ASIOTicket::ASIOTicket(const ASIOSessionHandle& session, Date_t expiration)
+    : _session(session),
+      _sessionId(session->id()),
+      _expiration(expiration),
+      _compressorMgr(&MessageCompressorManager::forSession(session)) {}
+
+TransportLayerASIO::ASIOSessionHandle TransportLayerASIO::ASIOTicket::getSession() {
+    return _session.lock();
+}
+
+SessionId TransportLayerASIO::ASIOTicket::sessionId() const {
+    return _sessionId;
+}
+
+Date_t TransportLayerASIO::ASIOTicket::expiration() const {
+    return _expiration;
+}
+
+TransportLayerASIO::ASIOSourceTicket::ASIOSourceTicket(const ASIOSessionHandle& session,
+                                                       Date_t expiration,
+                                                       Message* target)
+    : ASIOTicket(session, expiration), _target(target) {}
+
+StatusWith<size_t> TransportLayerASIO::ASIOSourceTicket::_processHeader() {
+    MsgData::View headerView(_buffer.get());
+    const size_t msgLen = static_cast<size_t>(headerView.getLen());
+    if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+        return Status(ErrorCodes::ProtocolError,
+                      str::stream() << "recv(): message len " << msgLen << " is invalid. "
+                                    << "Min: "
+                                    << kHeaderSize
+                                    << ", Max: "
+                                    << MaxMessageSizeBytes);
+    }
+
+    _buffer.realloc(msgLen);
+    return msgLen - kHeaderSize;
+}
+
+Status TransportLayerASIO::ASIOSourceTicket::_finish() {
+    _target->setData(std::move(_buffer));
+    networkCounter.hitPhysical(_target->size(), 0);
+    if (_target->operation() == dbCompressed) {
+        auto swm = compressorManager().decompressMessage(*_target);
+        if (!swm.isOK())
+            return swm.getStatus();
+        *_target = std::move(swm.getValue());
+    }
+    networkCounter.hitLogical(_target->size(), 0);
+    return Status::OK();
+}
+
+Status TransportLayerASIO::ASIOSourceTicket::fillSync(ASIOSession* session) {
+    _buffer = SharedBuffer::allocate(kHeaderSize);
+
+    asio::error_code ec;
+    asio::read(session->socket(), asio::buffer(_buffer.get(), kHeaderSize), ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    auto swRemaining = _processHeader();
+    if (!swRemaining.isOK()) {
+        return swRemaining.getStatus();
+    }
+
+    asio::read(
+        session->socket(), asio::buffer(_buffer.get() + kHeaderSize, swRemaining.getValue()), ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    return _finish();
+}
+
+void TransportLayerASIO::ASIOSourceTicket::fillAsync(ASIOSessionHandle session,
+                                                     TicketCallback callback) {
+    _buffer = SharedBuffer::allocate(kHeaderSize);
+    auto& socket = session->socket();
+    asio::async_read(
+        socket,
+        asio::buffer(_buffer.get(), kHeaderSize),
+        [ this, session = std::move(session), callback = std::move(callback) ](
+            const asio::error_code& ec, size_t) mutable {
+            if (ec) {
+                return callback(errorCodeToStatus(ec));
+            }
+
+            auto swRemaining = _processHeader();
+            if (!swRemaining.isOK()) {
+                return callback(swRemaining.getStatus());
+            }
+
+            auto& socket = session->socket();
+            asio::async_read(
+                socket,
+                asio::buffer(_buffer.get() + kHeaderSize, swRemaining.getValue()),
+                [ this, session = std::move(session), callback = std::move(callback) ](
+                    const asio::error_code& ec, size_t) {
+                    if (ec) {
+                        return callback(errorCodeToStatus(ec));
+                    }
+                    callback(_finish());
+                });
+        });
+}
+
+TransportLayerASIO::ASIOSinkTicket::ASIOSinkTicket(const ASIOSessionHandle& session,
+                                                   Date_t expiration,
+                                                   const Message& msg)
+    : ASIOTicket(session, expiration), _msgToSend(msg) {}
+
+Status TransportLayerASIO::ASIOSinkTicket::_prepare() {
+    networkCounter.hitLogical(0, _msgToSend.size());
+    auto swm = compressorManager().compressMessage(_msgToSend);
+    if (!swm.isOK())
+        return swm.getStatus();
+    _toSend = std::move(swm.getValue());
+    return Status::OK();
+}
+
+Status TransportLayerASIO::ASIOSinkTicket::fillSync(ASIOSession* session) {
+    auto status = _prepare();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    asio::error_code ec;
+    asio::write(session->socket(), asio::buffer(_toSend.buf(), _toSend.size()), ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    networkCounter.hitPhysical(0, _toSend.size());
+    return Status::OK();
+}
+
+void TransportLayerASIO::ASIOSinkTicket::fillAsync(ASIOSessionHandle session,
+                                                   TicketCallback callback) {
+    auto status = _prepare();
+    if (!status.isOK()) {
+        return callback(status);
+    }
+
+    auto& socket = session->socket();
+    asio::async_write(socket,
+                      asio::buffer(_toSend.buf(), _toSend.size()),
+                      [ this, session = std::move(session), callback = std::move(callback) ](
+                          const asio::error_code& ec, size_t) {
+                          if (ec) {
+                              return callback(errorCodeToStatus(ec));
+                          }
+                          networkCounter.hitPhysical(0, _toSend.size());
+                          callback(Status::OK());
+                      });
+}
+
+TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
+                                       ServiceEntryPoint* sep)
+    : _sep(sep), _options(opts) {}
+
+TransportLayerASIO::~TransportLayerASIO() = default;
+
+Status TransportLayerASIO::setup() {
+#ifdef MONGO_CONFIG_SSL
+    if (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled) {
+        return {ErrorCodes::InvalidOptions,
+                "The asio transport layer does not support SSL yet, use the legacy transport "
+                "layer instead"};
+    }
+#endif
+
+    Listener::checkTicketNumbers();
+
+#ifndef _WIN32
+    const bool useUnixSockets = !serverGlobalParams.noUnixSocket;
+#else
+    const bool useUnixSockets = false;
+#endif
+
+    for (auto&& addr : ipToAddrs(_options.ipList.c_str(), _options.port, useUnixSockets)) {
+        if (!addr.isValid()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Invalid address to listen on: " << addr.toString()};
+        }
+
+        asio::generic::stream_protocol protocol(addr.getType(), 0);
+        asio::generic::stream_protocol::endpoint endpoint(addr.raw(), addr.addressSize, 0);
+
+        GenericAcceptor acceptor(_ioService);
+        asio::error_code ec;
+        acceptor.open(protocol, ec);
+        if (ec) {
+            return {ErrorCodes::SocketException,
+                    str::stream() << "Failed to open socket for " << addr.toString() << ": "
+                                  << ec.message()};
+        }
+
+#ifndef _WIN32
+        if (addr.getType() == AF_UNIX) {
+            if (::unlink(addr.getAddr().c_str()) == -1 && errno != ENOENT) {
+                return {ErrorCodes::SocketException,
+                        str::stream() << "Failed to unlink socket file " << addr.toString() << " "
+                                      << errnoWithDescription(errno)};
+            }
+        } else {
+            acceptor.set_option(GenericAcceptor::reuse_address(true), ec);
+        }
+#endif
+
+        if (addr.getType() == AF_INET6) {
+            // IPv6 sockets would otherwise also claim the IPv4 port via mapped addresses.
+            acceptor.set_option(asio::ip::v6_only(true), ec);
+        }
+
+        acceptor.bind(endpoint, ec);
+        if (ec) {
+            return {ErrorCodes::SocketException,
+                    str::stream() << "listen(): bind() failed " << ec.message()
+                                  << " for socket: "
+                                  << addr.toString()};
+        }
+
+#ifndef _WIN32
+        if (addr.getType() == AF_UNIX) {
+            if (::chmod(addr.getAddr().c_str(), serverGlobalParams.unixSocketPermissions) == -1) {
+                return {ErrorCodes::SocketException,
+                        str::stream() << "Failed to chmod socket file " << addr.toString() << " "
+                                      << errnoWithDescription(errno)};
+            }
+            ListeningSockets::get()->addPath(addr.getAddr());
+        }
+#endif
+
+        _acceptors.emplace_back(std::move(addr), std::move(acceptor));
+    }
+
+    return Status::OK();
+}
+
+Status TransportLayerASIO::start() {
+    if (_running.swap(true)) {
+        return {ErrorCodes::InternalError, "TransportLayer is already running"};
+    }
+
+    for (auto&& acceptor : _acceptors) {
+        asio::error_code ec;
+        acceptor.second.listen(SOMAXCONN, ec);
+        if (ec) {
+            return {ErrorCodes::SocketException,
+                    str::stream() << "listen(): listen() failed for " << acceptor.first.toString()
+                                  << ": "
+                                  << ec.message()};
+        }
+
+        log() << "waiting for connections on port " << _options.port;
+        _acceptConnection(acceptor.second);
+    }
+
+    size_t numThreads = _options.ioThreads;
+    if (numThreads == 0) {
+        ProcessInfo p;
+        numThreads = std::max(2U, p.getNumCores());
+    }
+
+    _ioWork = stdx::make_unique<asio::io_service::work>(_ioService);
+    for (size_t i = 0; i < numThreads; i++) {
+        _ioThreads.emplace_back([this, i] {
+            setThreadName(str::stream() << "transport-io-" << i);
+            _ioService.run();
+        });
+    }
+
+    return Status::OK();
+}
+
+void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
+    auto socket = std::make_shared<GenericSocket>(_ioService);
+    acceptor.async_accept(*socket, [this, socket, &acceptor](const asio::error_code& ec) {
+        if (!_running.load()) {
+            return;
+        }
+
+        if (ec) {
+            log() << "Error accepting new connection on port " << _options.port << ": "
+                  << ec.message();
+        } else {
+            _handleNewConnection(std::move(*socket));
+        }
+
+        _acceptConnection(acceptor);
+    });
+}
+
+void TransportLayerASIO::_handleNewConnection(GenericSocket socket) {
+    if (!Listener::globalTicketHolder.tryAcquire()) {
+        log() << "connection refused because too many open connections: "
+              << Listener::globalTicketHolder.used();
+        asio::error_code ec;
+        socket.shutdown(GenericSocket::shutdown_both, ec);
+        return;
+    }
+
+    const auto family = socket.local_endpoint().protocol().family();
+    if (family != AF_UNIX) {
+        disableNagle(socket.native_handle());
+    }
+
+    long long connectionId = Listener::globalConnectionNumber.addAndFetch(1);
+    auto session = std::make_shared<ASIOSession>(this, std::move(socket), connectionId);
+
+    if (!serverGlobalParams.quiet.load()) {
+        int conns = Listener::globalTicketHolder.used();
+        const char* word = (conns == 1 ? " connection" : " connections");
+        log() << "connection accepted from " << session->remote() << " #" << connectionId << " ("
+              << conns << word << " now open)";
+    }
+
+    stdx::list<std::weak_ptr<ASIOSession>> list;
+    auto it = list.emplace(list.begin(), session);
+
+    {
+        // Add the new session to our list
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        session->setIter(it);
+        _sessions.splice(_sessions.begin(), list, it);
+    }
+
+    invariant(_sep);
+    _sep->startSession(std::move(session));
+}
+
+Ticket TransportLayerASIO::sourceMessage(const SessionHandle& session,
+                                         Message* message,
+                                         Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this, stdx::make_unique<ASIOSourceTicket>(asioSession, expiration, message));
+}
+
+Ticket TransportLayerASIO::sinkMessage(const SessionHandle& session,
+                                       const Message& message,
+                                       Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this, stdx::make_unique<ASIOSinkTicket>(asioSession, expiration, message));
+}
+
+StatusWith<TransportLayerASIO::ASIOSessionHandle> TransportLayerASIO::_validateTicket(
+    const Ticket& ticket) {
+    if (!_running.load()) {
+        return TransportLayer::ShutdownStatus;
+    }
+
+    const Date_t expiration = ticket.expiration();
+    if (expiration != Ticket::kNoExpirationDate && expiration < Date_t::now()) {
+        return Ticket::ExpiredStatus;
+    }
+
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+    auto session = asioTicket->getSession();
+    if (!session || session->isClosed()) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+
+    return std::move(session);
+}
+
+Status TransportLayerASIO::wait(Ticket&& ticket) {
+    auto swSession = _validateTicket(ticket);
+    if (!swSession.isOK()) {
+        return swSession.getStatus();
+    }
+
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+    try {
+        return asioTicket->fillSync(swSession.getValue().get());
+    } catch (...) {
+        return exceptionToStatus();
+    }
+}
+
+void TransportLayerASIO::asyncWait(Ticket&& ticket, TicketCallback callback) {
+    auto swSession = _validateTicket(ticket);
+    if (!swSession.isOK()) {
+        return callback(swSession.getStatus());
+    }
+
+    // The Ticket must outlive the asynchronous operations it starts, so it is kept alive by the
+    // completion handler.
+    auto ownedTicket = std::make_shared<Ticket>(std::move(ticket));
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(*ownedTicket));
+    asioTicket->fillAsync(std::move(swSession.getValue()),
+                          [ ownedTicket, callback = std::move(callback) ](Status status) {
+                              callback(std::move(status));
+                          });
+}
+
+TransportLayer::Stats TransportLayerASIO::sessionStats() {
+    Stats stats;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        stats.numOpenSessions = _sessions.size();
+    }
+
+    stats.numAvailableSessions = Listener::globalTicketHolder.available();
+    stats.numCreatedSessions = Listener::globalConnectionNumber.load();
+
+    return stats;
+}
+
+void TransportLayerASIO::end(const SessionHandle& session) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    _closeSession(asioSession.get());
+}
+
+void TransportLayerASIO::_closeSession(ASIOSession* session) {
+    if (session->close()) {
+        Listener::globalTicketHolder.release();
+    }
+}
+
+void TransportLayerASIO::endAllSessions(Session::TagMask tags) {
+    log() << "asio transport layer closing all connections";
+
+    std::vector<ASIOSessionHandle> sessions;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        for (auto&& weakSession : _sessions) {
+            if (auto session = weakSession.lock()) {
+                sessions.emplace_back(std::move(session));
+            }
+        }
+    }
+
+    // The sessions are ended and released outside of the lock, since destroying the last
+    // reference to a session removes it from _sessions.
+    for (auto&& session : sessions) {
+        if (session->getTags() & tags) {
+            log() << "Skip closing connection for connection # " << session->connectionId();
+        } else {
+            _closeSession(session.get());
+        }
+    }
+}
+
+void TransportLayerASIO::shutdown() {
+    if (!_running.swap(false)) {
+        return;
+    }
+
+    // Acceptors may only be touched from the io_service, where their accept handlers run.
+    _ioService.post([this] {
+        for (auto&& acceptor : _acceptors) {
+            asio::error_code ec;
+            acceptor.second.close(ec);
+        }
+    });
+
+    endAllSessions(Session::kEmptyTagMask);
+
+    _ioWork.reset();
+    _ioService.stop();
+    for (auto&& thread : _ioThreads) {
+        thread.join();
+    }
+    _ioThreads.clear();
+}
+
+void TransportLayerASIO::_destroy(ASIOSession& session) {
+    _closeSession(&session);
+
+    stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+    _sessions.erase(session.getIter());
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,298 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <asio.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/list.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/ticket_impl.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/net/sockaddr.h"
+
+namespace mongo {
+
+class MessageCompressorManager;
+class ServiceEntryPoint;
+
+namespace transport {
+
+/**
+ * A TransportLayer implementation built on ASIO.
+ *
+ * Connections are accepted and Messages are read and written by a fixed pool of I/O threads
+ * running the TransportLayer's io_service, rather than by a thread per connection. Tickets may be
+ * completed either synchronously via wait(), which performs blocking socket I/O on the calling
+ * thread, or asynchronously via asyncWait(), in which case the callback runs on an I/O thread.
+ *
+ * SSL is not yet supported by this TransportLayer; TransportLayerLegacy remains the default.
+ */
+class TransportLayerASIO final : public TransportLayer {
+    MONGO_DISALLOW_COPYING(TransportLayerASIO);
+
+public:
+    struct Options {
+        int port = 0;        // port to bind to
+        std::string ipList;  // addresses to bind to
+
+        // Number of threads servicing the io_service. If 0, one thread per core is used.
+        size_t ioThreads = 0;
+    };
+
+    TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
+
+    ~TransportLayerASIO();
+
+    Status setup();
+    Status start() override;
+
+    Ticket sourceMessage(const SessionHandle& session,
+                         Message* message,
+                         Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Ticket sinkMessage(const SessionHandle& session,
+                       const Message& message,
+                       Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Status wait(Ticket&& ticket) override;
+    void asyncWait(Ticket&& ticket, TicketCallback callback) override;
+
+    bool supportsAsyncWait() const override {
+        return true;
+    }
+
+    Stats sessionStats() override;
+
+    void end(const SessionHandle& session) override;
+    void endAllSessions(transport::Session::TagMask tags) override;
+
+    void shutdown() override;
+
+private:
+    class ASIOSession;
+    class ASIOTicket;
+    class ASIOSourceTicket;
+    class ASIOSinkTicket;
+
+    using GenericSocket = asio::generic::stream_protocol::socket;
+    using GenericAcceptor = asio::basic_socket_acceptor<asio::generic::stream_protocol>;
+    using ASIOSessionHandle = std::shared_ptr<ASIOSession>;
+    using SessionEntry = stdx::list<std::weak_ptr<ASIOSession>>::iterator;
+
+    /**
+     * An implementation of the Session interface for this TransportLayer. Owns the socket for a
+     * single accepted connection.
+     */
+    class ASIOSession : public Session {
+        MONGO_DISALLOW_COPYING(ASIOSession);
+
+    public:
+        ASIOSession(TransportLayerASIO* tl, GenericSocket socket, long long connectionId);
+        ~ASIOSession();
+
+        TransportLayer* getTransportLayer() const override {
+            return _tl;
+        }
+
+        const HostAndPort& remote() const override {
+            return _remote;
+        }
+
+        const HostAndPort& local() const override {
+            return _local;
+        }
+
+        GenericSocket& socket() {
+            return _socket;
+        }
+
+        long long connectionId() const {
+            return _connectionId;
+        }
+
+        bool isClosed() const {
+            return _closed.load();
+        }
+
+        /**
+         * Shuts down the socket, causing any outstanding I/O on it to fail. Safe to call from any
+         * thread and idempotent; returns true only for the call that actually closed the session.
+         */
+        bool close();
+
+        void setIter(SessionEntry it) {
+            _entry = std::move(it);
+        }
+
+        SessionEntry getIter() const {
+            return _entry;
+        }
+
+    private:
+        TransportLayerASIO* const _tl;
+        GenericSocket _socket;
+        const long long _connectionId;
+
+        HostAndPort _remote;
+        HostAndPort _local;
+
+        AtomicWord<bool> _closed{false};
+
+        // A handle to this session's entry in the TL's session list
+        SessionEntry _entry;
+    };
+
+    /**
+     * Base class for the Tickets handed out by this TransportLayer. A ticket can be filled
+     * either by blocking on the socket, or by scheduling asynchronous operations on the
+     * io_service.
+     */
+    class ASIOTicket : public TicketImpl {
+        MONGO_DISALLOW_COPYING(ASIOTicket);
+
+    public:
+        ASIOTicket(const ASIOSessionHandle& session, Date_t expiration);
+
+        SessionId sessionId() const override;
+        Date_t expiration() const override;
+
+        /**
+         * If this ticket's session is still alive, return a shared_ptr. Otherwise,
+         * return nullptr.
+         */
+        ASIOSessionHandle getSession();
+
+        /**
+         * Performs this ticket's work on the calling thread.
+         */
+        virtual Status fillSync(ASIOSession* session) = 0;
+
+        /**
+         * Starts this ticket's work on the io_service. 'callback' is invoked on an I/O thread once
+         * the work completes. The caller must keep this ticket alive until then.
+         */
+        virtual void fillAsync(ASIOSessionHandle session, TicketCallback callback) = 0;
+
+    protected:
+        MessageCompressorManager& compressorManager() const {
+            return *_compressorMgr;
+        }
+
+    private:
+        std::weak_ptr<ASIOSession> _session;
+
+        SessionId _sessionId;
+        Date_t _expiration;
+
+        MessageCompressorManager* _compressorMgr;
+    };
+
+    /**
+     * Reads a single Message from a session.
+     */
+    class ASIOSourceTicket : public ASIOTicket {
+    public:
+        ASIOSourceTicket(const ASIOSessionHandle& session, Date_t expiration, Message* target);
+
+        Status fillSync(ASIOSession* session) override;
+        void fillAsync(ASIOSessionHandle session, TicketCallback callback) override;
+
+    private:
+        /**
+         * Validates the header read into '_buffer' and grows the buffer to hold the entire
+         * message. Returns the number of bytes still to be read.
+         */
+        StatusWith<size_t> _processHeader();
+
+        /**
+         * Installs the fully read '_buffer' into the target Message, decompressing it if needed.
+         */
+        Status _finish();
+
+        Message* _target;
+        SharedBuffer _buffer;
+    };
+
+    /**
+     * Writes a single Message to a session.
+     */
+    class ASIOSinkTicket : public ASIOTicket {
+    public:
+        ASIOSinkTicket(const ASIOSessionHandle& session, Date_t expiration, const Message& msg);
+
+        Status fillSync(ASIOSession* session) override;
+        void fillAsync(ASIOSessionHandle session, TicketCallback callback) override;
+
+    private:
+        /**
+         * Compresses the Message to send into '_toSend', if compression was negotiated.
+         */
+        Status _prepare();
+
+        Message _msgToSend;
+        Message _toSend;
+    };
+
+    /**
+     * Returns the live session for 'ticket' if the ticket may still be run, or the Status that
+     * the ticket should be completed with otherwise.
+     */
+    StatusWith<ASIOSessionHandle> _validateTicket(const Ticket& ticket);
+
+    void _acceptConnection(GenericAcceptor& acceptor);
+    void _handleNewConnection(GenericSocket socket);
+
+    void _closeSession(ASIOSession* session);
+    void _destroy(ASIOSession& session);
+
+    ServiceEntryPoint* const _sep;
+
+    asio::io_service _ioService;
+    std::unique_ptr<asio::io_service::work> _ioWork;
+    std::vector<stdx::thread> _ioThreads;
+
+    std::vector<std::pair<SockAddr, GenericAcceptor>> _acceptors;
+
+    // TransportLayerASIO holds non-owning pointers to all of its sessions.
+    mutable stdx::mutex _sessionsMutex;
+    stdx::list<std::weak_ptr<ASIOSession>> _sessions;
+
+    AtomicWord<bool> _running{false};
+
+    Options _options;
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include "mongo/db/server_options.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/net/listen.h"
+#include "mongo/util/net/sock.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Sources a single Message asynchronously and sinks it back to the client.
+ */
+class EchoServiceEntryPoint : public ServiceEntryPoint {
+public:
+    void startSession(transport::SessionHandle session) override {
+        session->sourceMessage(&_message).asyncWait([this, session](Status status) {
+            ASSERT_OK(status);
+            ASSERT_OK(session->sinkMessage(_message).wait());
+
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _done = true;
+            _cv.notify_one();
+        });
+    }
+
+    void waitForEcho() {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _cv.wait(lk, [&] { return _done; });
+    }
+
+private:
+    Message _message;
+    stdx::mutex _mutex;
+    stdx::condition_variable _cv;
+    bool _done = false;
+};
+
+TEST(TransportLayerASIO, EchoesMessageWithAsyncWait) {
+    // Disabled for the same reason as the TransportLayerLegacy tests, until we can figure out the
+    // best way to allocate port numbers for unit tests
+    return;
+
+    EchoServiceEntryPoint sep;
+
+    transport::TransportLayerASIO::Options opts;
+    opts.port = 27017;
+    opts.ipList = "127.0.0.1";
+    opts.ioThreads = 1;
+    transport::TransportLayerASIO tla(opts, &sep);
+
+    ASSERT_OK(tla.setup());
+    ASSERT_OK(tla.start());
+    ASSERT_TRUE(tla.supportsAsyncWait());
+
+    Socket s;
+    SockAddr sa{"127.0.0.1", 27017};
+    ASSERT_TRUE(s.connect(sa));
+
+    const char payload[] = "hello";
+    BufBuilder b;
+    b.skip(sizeof(MSGHEADER::Value));
+    b.appendBuf(payload, sizeof(payload));
+    MsgData::View header(b.buf());
+    header.setLen(b.len());
+    header.setId(1);
+    header.setResponseToMsgId(0);
+    header.setOperation(dbQuery);
+    const int len = b.len();
+    s.send(b.buf(), len, "echo");
+
+    std::vector<char> reply(len);
+    s.recv(reply.data(), len);
+    ASSERT_EQ(0, memcmp(b.buf(), reply.data(), len));
+
+    sep.waitForEcho();
+    tla.shutdown();
+    ASSERT_EQ(0, Listener::globalTicketHolder.used());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -292,7 +292,8 @@ Status TransportLayerLegacy::_runTicket(Ticket ticket) {
         return TransportLayer::ShutdownStatus;
     }
 
-    if (ticket.expiration() < Date_t::now()) {
+    const Date_t expiration = ticket.expiration();
+    if (expiration != Ticket::kNoExpirationDate && expiration < Date_t::now()) {
         return Ticket::ExpiredStatus;
     }
 
@@ -177,6 +177,21 @@ TEST_F(TransportLayerMockTest, Wait) {
     ASSERT_OK(status);
 }
 
+// A Ticket is valid until its expiration date, and forever without one
+TEST_F(TransportLayerMockTest, TicketValidUntilExpiration) {
+    SessionHandle session = tl()->createSession();
+    Ticket noExpiration = Ticket(tl(), stdx::make_unique<transport::MockTicket>(session));
+    ASSERT_TRUE(noExpiration.valid());
+
+    Ticket later =
+        Ticket(tl(), stdx::make_unique<transport::MockTicket>(session, Date_t::now() + Hours(1)));
+    ASSERT_TRUE(later.valid());
+
+    Ticket earlier = Ticket(tl(), stdx::make_unique<transport::MockTicket>(session, Date_t::now()));
+    ASSERT_FALSE(earlier.valid());
+    ASSERT_EQUALS(earlier.status().code(), ErrorCodes::ExceededTimeLimit);
+}
+
 // wait() returns an TicketExpired error status if the Ticket expired
 TEST_F(TransportLayerMockTest, WaitExpiredTicket) {
     SessionHandle session = tl()->createSession();
@@ -0,0 +1,220 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+namespace unittest {
+namespace {
+
+// Upper bound on the iterations of a call, in case a benchmark loop got optimized away.
+const long long kMaxIterations = 1000LL * 1000 * 1000;
+
+struct RegisteredBenchmark {
+    std::string caseName;
+    std::string benchmarkName;
+    BenchmarkFunction fn;
+};
+
+std::vector<RegisteredBenchmark>& registeredBenchmarks() {
+    static std::vector<RegisteredBenchmark> benchmarks;
+    return benchmarks;
+}
+
+/**
+ * Runs 'iterations' iterations of a benchmark and returns the time they took, in nanoseconds. If
+ * 'bytesPerIteration' is not null, it is set to the bytes the benchmark declared each iteration
+ * processes.
+ */
+long long runOnce(BenchmarkFunction fn, long long iterations, long long* bytesPerIteration) {
+    BenchmarkState state(iterations);
+    fn(state);
+    if (bytesPerIteration) {
+        *bytesPerIteration = state.bytesPerIteration();
+    }
+    return durationCount<Nanoseconds>(state.elapsed());
+}
+
+/**
+ * Statistics of the time per iteration over the repetitions of a benchmark, in nanoseconds.
+ */
+struct BenchmarkStats {
+    explicit BenchmarkStats(std::vector<double> nanosPerIteration) {
+        invariant(!nanosPerIteration.empty());
+        std::sort(nanosPerIteration.begin(), nanosPerIteration.end());
+
+        const size_t n = nanosPerIteration.size();
+        min = nanosPerIteration.front();
+        median = n % 2 ? nanosPerIteration[n / 2]
+                       : (nanosPerIteration[n / 2 - 1] + nanosPerIteration[n / 2]) / 2;
+
+        for (double value : nanosPerIteration) {
+            mean += value;
+        }
+        mean /= n;
+
+        if (n > 1) {
+            for (double value : nanosPerIteration) {
+                stddev += (value - mean) * (value - mean);
+            }
+            stddev = std::sqrt(stddev / (n - 1));
+        }
+    }
+
+    double mean = 0;
+    double median = 0;
+    double stddev = 0;
+    double min = 0;
+};
+
+}  // namespace
+
+BenchmarkState::BenchmarkState(long long iterations)
+    : _iterations(iterations), _remaining(iterations) {}
+
+void BenchmarkState::pauseTiming() {
+    _elapsed += Nanoseconds(
+        stdx::chrono::duration_cast<stdx::chrono::nanoseconds>(Clock::now() - _start).count());
+}
+
+void BenchmarkState::resumeTiming() {
+    _start = Clock::now();
+}
+
+BenchmarkRegistration::BenchmarkRegistration(std::string caseName,
+                                             std::string benchmarkName,
+                                             BenchmarkFunction fn) {
+    registeredBenchmarks().push_back({std::move(caseName), std::move(benchmarkName), fn});
+}
+
+int runBenchmarks(const BenchmarkOptions& options) {
+    const long long minTimeNanos = durationCount<Nanoseconds>(options.minTime);
+    BSONArrayBuilder results;
+    size_t ran = 0;
+
+    for (const auto& benchmark : registeredBenchmarks()) {
+        const std::string fullName = benchmark.caseName + "/" + benchmark.benchmarkName;
+        if (fullName.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        ++ran;
+
+        // Find the number of iterations which takes at least the minimum time. This also warms
+        // up the benchmark, so these calls are not reported. Grow by at most 10x at a time, since
+        // the first calls may be slowed down by the warmup.
+        long long iterations = 1;
+        while (true) {
+            const long long elapsed = runOnce(benchmark.fn, iterations, nullptr);
+            if (elapsed >= minTimeNanos || iterations >= kMaxIterations) {
+                break;
+            }
+
+            const double multiplier =
+                elapsed > 0 ? 1.4 * minTimeNanos / static_cast<double>(elapsed) : 10.0;
+            iterations = std::min(
+                kMaxIterations,
+                std::max(iterations + 1,
+                         static_cast<long long>(iterations * std::min(multiplier, 10.0))));
+        }
+
+        std::vector<double> nanosPerIteration;
+        long long bytesPerIteration = 0;
+        for (int i = 0; i < options.repetitions; ++i) {
+            nanosPerIteration.push_back(runOnce(benchmark.fn, iterations, &bytesPerIteration) /
+                                        static_cast<double>(iterations));
+        }
+
+        BSONObjBuilder result(results.subobjStart());
+        result.append("name", fullName);
+        result.appendNumber("iterations", iterations);
+        result.append("runsNanosPerIteration", nanosPerIteration);
+
+        const BenchmarkStats stats(std::move(nanosPerIteration));
+        result.append("meanNanos", stats.mean);
+        result.append("medianNanos", stats.median);
+        result.append("stddevNanos", stats.stddev);
+        result.append("minNanos", stats.min);
+
+        // The throughput at the median time per iteration.
+        const double megabytesPerSecond = bytesPerIteration > 0 && stats.median > 0
+            ? bytesPerIteration / stats.median * 1e9 / (1024 * 1024)
+            : 0;
+        if (bytesPerIteration > 0) {
+            result.appendNumber("bytesPerIteration", bytesPerIteration);
+            result.append("medianMegabytesPerSecond", megabytesPerSecond);
+        }
+        result.doneFast();
+
+        std::cout << std::left << std::setw(60) << fullName << std::right << std::fixed
+                  << std::setprecision(1) << " mean " << std::setw(12) << stats.mean << " ns"
+                  << " median " << std::setw(12) << stats.median << " ns"
+                  << " stddev " << std::setw(10) << stats.stddev << " ns";
+        if (bytesPerIteration > 0) {
+            std::cout << " " << std::setw(10) << megabytesPerSecond << " MB/s";
+        }
+        std::cout << " (" << iterations << " iterations x " << options.repetitions << ")"
+                  << std::endl;
+    }
+
+    if (ran == 0) {
+        std::cerr << "No benchmark matches the filter '" << options.filter << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!options.jsonOutputPath.empty()) {
+        BSONObjBuilder output;
+        output.append("repetitions", options.repetitions);
+        output.appendNumber("minTimeMillis", durationCount<Milliseconds>(options.minTime));
+        output.append("benchmarks", results.arr());
+
+        std::ofstream file(options.jsonOutputPath.c_str());
+        file << output.obj().jsonString(Strict, 1) << std::endl;
+        if (!file) {
+            std::cerr << "Failed to write the benchmark results to '" << options.jsonOutputPath
+                      << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+}  // namespace unittest
+}  // namespace mongo
@@ -0,0 +1,212 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * A framework for microbenchmarks of the server's hot paths.
+ *
+ * Define a benchmark with the BENCHMARK macro. Its body may do untimed setup, then runs the code
+ * to measure in a loop while state.keepRunning() returns true:
+ *
+ *     BENCHMARK(BSONObjBuilder, SmallDocument) {
+ *         while (state.keepRunning()) {
+ *             BSONObjBuilder builder;
+ *             builder.append("a", 1);
+ *             benchmarkDoNotOptimize(builder.obj());
+ *         }
+ *     }
+ *
+ * The runner first calls each benchmark with growing iteration counts until a call takes at least
+ * the minimum time, which also warms up caches and allocators. Those calls are not reported. It
+ * then repeats the benchmark with that iteration count, and reports statistics of the time per
+ * iteration over the repetitions.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/chrono.h"
+#include "mongo/util/duration.h"
+
+/**
+ * Defines a benchmark named BENCHMARK_NAME in the case CASE_NAME. The body has access to a
+ * BenchmarkState& named 'state'.
+ */
+#define BENCHMARK(CASE_NAME, BENCHMARK_NAME)                                                \
+    static void _BENCHMARK_FUNCTION_NAME(CASE_NAME, BENCHMARK_NAME)(                        \
+        ::mongo::unittest::BenchmarkState & state);                                         \
+    static const ::mongo::unittest::BenchmarkRegistration _BENCHMARK_REGISTRATION_NAME(     \
+        CASE_NAME, BENCHMARK_NAME)(                                                         \
+        #CASE_NAME, #BENCHMARK_NAME, &_BENCHMARK_FUNCTION_NAME(CASE_NAME, BENCHMARK_NAME)); \
+    static void _BENCHMARK_FUNCTION_NAME(CASE_NAME, BENCHMARK_NAME)(                        \
+        ::mongo::unittest::BenchmarkState & state)
+
+#define _BENCHMARK_FUNCTION_NAME(CASE_NAME, BENCHMARK_NAME) \
+    Benchmark__##CASE_NAME##__##BENCHMARK_NAME
+#define _BENCHMARK_REGISTRATION_NAME(CASE_NAME, BENCHMARK_NAME) \
+    BenchmarkRegistration__##CASE_NAME##__##BENCHMARK_NAME
+
+namespace mongo {
+namespace unittest {
+
+/**
+ * The state of one call of a benchmark, which counts its iterations and times them.
+ */
+class BenchmarkState {
+    MONGO_DISALLOW_COPYING(BenchmarkState);
+
+public:
+    explicit BenchmarkState(long long iterations);
+
+    /**
+     * Returns true as long as the benchmark should run another iteration. The clock starts on the
+     * first call and stops when it returns false.
+     */
+    bool keepRunning() {
+        if (_started) {
+            if (--_remaining > 0) {
+                return true;
+            }
+            pauseTiming();
+            return false;
+        }
+        _started = true;
+        resumeTiming();
+        return _remaining > 0;
+    }
+
+    /**
+     * Stops and restarts the clock, to leave per-iteration setup out of the timing. These take
+     * long enough to skew very short benchmarks, so per-iteration setup is better avoided.
+     */
+    void pauseTiming();
+    void resumeTiming();
+
+    /**
+     * Makes the next call to keepRunning() return false, for benchmarks which run all of their
+     * iterations at once, such as spread over several threads:
+     *
+     *     while (state.keepRunning()) {
+     *         runOnThreads(state.iterations());
+     *         state.skipRemainingIterations();
+     *     }
+     */
+    void skipRemainingIterations() {
+        _remaining = 1;
+    }
+
+    /**
+     * Declares the number of bytes each iteration processes, for benchmarks of throughput. The
+     * results then also report the bytes processed per second.
+     */
+    void setBytesPerIteration(long long bytes) {
+        _bytesPerIteration = bytes;
+    }
+
+    /**
+     * Returns the number of iterations asked of this call.
+     */
+    long long iterations() const {
+        return _iterations;
+    }
+
+    /**
+     * Returns the number of bytes each iteration processes, or 0 if it was not declared.
+     */
+    long long bytesPerIteration() const {
+        return _bytesPerIteration;
+    }
+
+    /**
+     * Returns the time spent in the iterations.
+     */
+    Nanoseconds elapsed() const {
+        return _elapsed;
+    }
+
+private:
+    using Clock = stdx::chrono::steady_clock;
+
+    const long long _iterations;
+    long long _remaining;
+    bool _started = false;
+    long long _bytesPerIteration = 0;
+
+    Clock::time_point _start;
+    Nanoseconds _elapsed{0};
+};
+
+using BenchmarkFunction = void (*)(BenchmarkState&);
+
+/**
+ * Registers a benchmark when constructed. Declared by the BENCHMARK macro.
+ */
+class BenchmarkRegistration {
+    MONGO_DISALLOW_COPYING(BenchmarkRegistration);
+
+public:
+    BenchmarkRegistration(std::string caseName, std::string benchmarkName, BenchmarkFunction fn);
+};
+
+struct BenchmarkOptions {
+    // Only the benchmarks whose "<case>/<name>" contains this are run.
+    std::string filter;
+
+    // Number of timed repetitions of each benchmark.
+    int repetitions = 5;
+
+    // Minimum duration of each repetition, which decides its number of iterations.
+    Milliseconds minTime{100};
+
+    // If not empty, the file to write the results to as JSON.
+    std::string jsonOutputPath;
+};
+
+/**
+ * Runs the registered benchmarks selected by 'options', prints their results and writes them to
+ * the JSON output file if asked to. Returns the exit code for the benchmark program.
+ */
+int runBenchmarks(const BenchmarkOptions& options);
+
+/**
+ * Keeps the compiler from optimizing away the computation of 'value' in a benchmark loop.
+ */
+template <typename T>
+inline void benchmarkDoNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+#endif
+}
+
+}  // namespace unittest
+}  // namespace mongo
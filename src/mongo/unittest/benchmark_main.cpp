@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mongo/base/initializer.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/options_parser/environment.h"
+#include "mongo/util/options_parser/option_section.h"
+#include "mongo/util/options_parser/startup_option_init.h"
+#include "mongo/util/options_parser/startup_options.h"
+#include "mongo/util/quick_exit.h"
+#include "mongo/util/signal_handlers_synchronous.h"
+
+using namespace mongo;
+
+namespace {
+
+unittest::BenchmarkOptions benchmarkOptions;
+
+const char kFilterFlag[] = "filter";
+const char kRepetitionsFlag[] = "repetitions";
+const char kMinTimeMillisFlag[] = "minTimeMillis";
+const char kJsonOutputFlag[] = "jsonOutput";
+
+}  // namespace
+
+int main(int argc, char** argv, char** envp) {
+    clearSignalMask();
+    setupSynchronousSignalHandlers();
+    runGlobalInitializersOrDie(argc, argv, envp);
+
+    return unittest::runBenchmarks(benchmarkOptions);
+}
+
+namespace moe = mongo::optionenvironment;
+
+MONGO_GENERAL_STARTUP_OPTIONS_REGISTER(BenchmarkOptions)(InitializerContext*) {
+    auto& opts = moe::startupOptions;
+    opts.addOptionChaining("help", "help", moe::Switch, "Display help");
+    opts.addOptionChaining(kFilterFlag,
+                           kFilterFlag,
+                           moe::String,
+                           "Only run the benchmarks whose <case>/<name> contains this string.")
+        .setDefault(moe::Value(std::string()));
+    opts.addOptionChaining(kRepetitionsFlag,
+                           kRepetitionsFlag,
+                           moe::Int,
+                           "The number of timed repetitions of each benchmark.")
+        .setDefault(moe::Value(benchmarkOptions.repetitions));
+    opts.addOptionChaining(kMinTimeMillisFlag,
+                           kMinTimeMillisFlag,
+                           moe::Int,
+                           "The minimum time of each repetition, from which its number of "
+                           "iterations is chosen.")
+        .setDefault(moe::Value(static_cast<int>(durationCount<Milliseconds>(
+            benchmarkOptions.minTime))));
+    opts.addOptionChaining(kJsonOutputFlag,
+                           kJsonOutputFlag,
+                           moe::String,
+                           "A file to write the results to as JSON.");
+    return Status::OK();
+}
+
+MONGO_STARTUP_OPTIONS_VALIDATE(BenchmarkOptions)(InitializerContext*) {
+    auto& env = moe::startupOptionsParsed;
+    auto& opts = moe::startupOptions;
+
+    auto ret = env.validate();
+
+    if (!ret.isOK()) {
+        return ret;
+    }
+
+    if (env.count("help")) {
+        std::cout << opts.helpString() << std::endl;
+        quickExit(EXIT_SUCCESS);
+    }
+
+    return Status::OK();
+}
+
+MONGO_STARTUP_OPTIONS_STORE(BenchmarkOptions)(InitializerContext*) {
+    auto& env = moe::startupOptionsParsed;
+
+    benchmarkOptions.filter = env[kFilterFlag].as<std::string>();
+
+    benchmarkOptions.repetitions = env[kRepetitionsFlag].as<int>();
+    if (benchmarkOptions.repetitions < 1) {
+        return Status(ErrorCodes::BadValue, "repetitions must be at least 1");
+    }
+
+    const int minTimeMillis = env[kMinTimeMillisFlag].as<int>();
+    if (minTimeMillis < 1) {
+        return Status(ErrorCodes::BadValue, "minTimeMillis must be at least 1");
+    }
+    benchmarkOptions.minTime = Milliseconds(minTimeMillis);
+
+    if (env.count(kJsonOutputFlag)) {
+        benchmarkOptions.jsonOutputPath = env[kJsonOutputFlag].as<std::string>();
+    }
+
+    return Status::OK();
+}
@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/benchmark.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+using unittest::BenchmarkState;
+
+TEST(BenchmarkStateTest, RunsAskedIterations) {
+    for (long long iterations : {0LL, 1LL, 2LL, 1000LL}) {
+        BenchmarkState state(iterations);
+        long long count = 0;
+        while (state.keepRunning()) {
+            ++count;
+        }
+        ASSERT_EQUALS(iterations, count);
+        ASSERT_EQUALS(iterations, state.iterations());
+    }
+}
+
+TEST(BenchmarkStateTest, SkipRemainingIterations) {
+    BenchmarkState state(1000);
+    long long count = 0;
+    while (state.keepRunning()) {
+        ++count;
+        state.skipRemainingIterations();
+    }
+    ASSERT_EQUALS(1, count);
+}
+
+TEST(BenchmarkStateTest, BytesPerIteration) {
+    BenchmarkState state(1);
+    ASSERT_EQUALS(0, state.bytesPerIteration());
+    state.setBytesPerIteration(1024);
+    ASSERT_EQUALS(1024, state.bytesPerIteration());
+}
+
+TEST(BenchmarkStateTest, PausedTimeIsNotCounted) {
+    BenchmarkState state(1);
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        sleepmillis(50);
+        state.resumeTiming();
+    }
+    ASSERT_LESS_THAN(state.elapsed(), Milliseconds(50));
+}
+
+}  // namespace
+}  // namespace mongo
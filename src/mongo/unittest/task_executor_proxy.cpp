@@ -109,5 +109,9 @@ void TaskExecutorProxy::appendConnectionStats(executor::ConnectionPoolStats* sta
     _executor->appendConnectionStats(stats);
 }
 
+void TaskExecutorProxy::warmUpConnections(const HostAndPort& hostAndPort) {
+    _executor->warmUpConnections(hostAndPort);
+}
+
 }  // namespace unittest
 }  // namespace mongo
@@ -37,6 +37,10 @@
 namespace mongo {
 namespace {
 
+// Users of OldThreadPool typically fan a batch of tasks out to all of the threads and wait for
+// them, so a thread that finishes its task is likely to be handed another one shortly.
+const Microseconds kIdleSpinTime{50};
+
 ThreadPool::Options makeOptions(int nThreads, const std::string& threadNamePrefix) {
     fassert(28706, nThreads > 0);
     ThreadPool::Options options;
@@ -45,6 +49,7 @@ ThreadPool::Options makeOptions(int nThreads, const std::string& threadNamePrefi
         options.poolName = str::stream() << threadNamePrefix << "Pool";
     }
     options.maxThreads = options.minThreads = static_cast<size_t>(nThreads);
+    options.idleSpinTime = kIdleSpinTime;
     return options;
 }
 
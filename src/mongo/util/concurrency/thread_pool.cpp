@@ -34,10 +34,12 @@
 
 #include "mongo/base/status.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/pause.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -187,6 +189,7 @@ Status ThreadPool::schedule(Task task) {
             MONGO_UNREACHABLE;
     }
     _pendingTasks.emplace_back(std::move(task));
+    _numPendingTasks.store(_pendingTasks.size());
     if (_state == preStart) {
         return Status::OK();
     }
@@ -196,7 +199,11 @@ Status ThreadPool::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
-    _workAvailable.notify_one();
+    // Threads which are not waiting are either busy, and will look at _pendingTasks once their
+    // current task is done, or spinning, and will see _numPendingTasks change.
+    if (_numWaitingThreads > 0) {
+        _workAvailable.notify_one();
+    }
     return Status::OK();
 }
 
@@ -244,8 +251,16 @@ void ThreadPool::_workerThreadBody(ThreadPool* pool, const std::string& threadNa
 
 void ThreadPool::_consumeTasks() {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
+    bool hasSpun = false;
     while (_state == running) {
         if (_pendingTasks.empty()) {
+            if (!hasSpun && _options.idleSpinTime > Microseconds{0}) {
+                hasSpun = true;
+                _spinForWork(&lk);
+                continue;
+            }
+
+            ++_numWaitingThreads;
             if (_threads.size() > _options.minThreads) {
                 // Since there are more than minThreads threads, this thread may be eligible for
                 // retirement. If it isn't now, it may be later, so it must put a time limit on how
@@ -254,6 +269,7 @@ void ThreadPool::_consumeTasks() {
                 const auto nextThreadRetirementDate =
                     _lastFullUtilizationDate + _options.maxIdleThreadAge;
                 if (now >= nextThreadRetirementDate) {
+                    --_numWaitingThreads;
                     _lastFullUtilizationDate = now;
                     LOG(1) << "Reaping this thread; next thread reaped no earlier than "
                            << _lastFullUtilizationDate + _options.maxIdleThreadAge;
@@ -272,9 +288,11 @@ void ThreadPool::_consumeTasks() {
                        << " the minimum number of threads is " << _options.minThreads;
                 _workAvailable.wait(lk);
             }
+            --_numWaitingThreads;
             continue;
         }
 
+        hasSpun = false;
         _doOneTask(&lk);
     }
 
@@ -315,12 +333,23 @@ void ThreadPool::_consumeTasks() {
     fassertFailedNoTrace(28703);
 }
 
+void ThreadPool::_spinForWork(stdx::unique_lock<stdx::mutex>* lk) {
+    const auto spinMicros = durationCount<Microseconds>(_options.idleSpinTime);
+    lk->unlock();
+    Timer timer;
+    while (_numPendingTasks.load() == 0 && timer.micros() < spinMicros) {
+        MONGO_YIELD_CORE_FOR_SMT();
+    }
+    lk->lock();
+}
+
 void ThreadPool::_doOneTask(stdx::unique_lock<stdx::mutex>* lk) {
     invariant(!_pendingTasks.empty());
     try {
         LOG(3) << "Executing a task on behalf of pool " << _options.poolName;
         Task task = std::move(_pendingTasks.front());
         _pendingTasks.pop_front();
+        _numPendingTasks.store(_pendingTasks.size());
         --_numIdleThreads;
         lk->unlock();
         task();
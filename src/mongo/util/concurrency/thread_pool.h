@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
@@ -82,6 +83,11 @@ public:
         // a thread.
         Milliseconds maxIdleThreadAge = Seconds{30};
 
+        // How long a thread which runs out of work keeps polling for new tasks before it goes to
+        // sleep on a condition variable. Pools which are fed tasks in quick bursts can set this
+        // so that their workers pick up the next task without a futex wait and wake-up.
+        Microseconds idleSpinTime{0};
+
         // This function is run before each worker thread begins consuming tasks.
         using OnCreateThreadFn = stdx::function<void(const std::string& threadName)>;
         OnCreateThreadFn onCreateThread = [](const std::string&) {};
@@ -185,6 +191,12 @@ private:
      */
     void _join_inlock(stdx::unique_lock<stdx::mutex>* lk);
 
+    /**
+     * Releases _mutex, owned by "lk", and polls for new tasks for up to _options.idleSpinTime
+     * before taking it back.
+     */
+    void _spinForWork(stdx::unique_lock<stdx::mutex>* lk);
+
     /**
      * Executes one task from _pendingTasks. "lk" must own _mutex, and _pendingTasks must have at
      * least one entry.
@@ -228,6 +240,13 @@ private:
     // Count of idle threads.
     size_t _numIdleThreads = 0;
 
+    // Count of idle threads blocked on _workAvailable. schedule() only signals _workAvailable when
+    // this is non-zero.
+    size_t _numWaitingThreads = 0;
+
+    // Copy of _pendingTasks.size(), which threads spinning in _spinForWork poll without _mutex.
+    AtomicWord<size_t> _numPendingTasks{0};
+
     // Id counter for assigning thread names
     size_t _nextThreadId = 0;
 
@@ -52,6 +52,11 @@ using namespace mongo;
 MONGO_INITIALIZER(ThreadPoolCommonTests)(InitializerContext*) {
     addTestsForThreadPool("ThreadPoolCommon",
                           []() { return stdx::make_unique<ThreadPool>(ThreadPool::Options()); });
+    addTestsForThreadPool("ThreadPoolCommonIdleSpin", []() {
+        ThreadPool::Options options;
+        options.idleSpinTime = Milliseconds(1);
+        return stdx::make_unique<ThreadPool>(std::move(options));
+    });
     return Status::OK();
 }
 
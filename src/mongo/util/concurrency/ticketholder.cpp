@@ -35,6 +35,7 @@
 
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -68,22 +69,56 @@ bool TicketHolder::tryAcquire() {
                 _check(-1);
         }
     }
+    _totalAcquired.fetchAndAdd(1);
     return true;
 }
 
 void TicketHolder::waitForTicket() {
-    while (0 != sem_wait(&_sem)) {
-        switch (errno) {
-            case EINTR:
-                break;
-            default:
-                _check(-1);
-        }
+    // Only take the fast path when nobody is queued, so that new arrivals don't overtake threads
+    // which have been waiting longer.
+    if (_numQueued.load() == 0 && tryAcquire()) {
+        return;
+    }
+    _waitInQueue();
+}
+
+void TicketHolder::_waitInQueue() {
+    stdx::unique_lock<stdx::mutex> lk(_queueMutex);
+
+    // Announce ourselves before the final attempt: a concurrent release() either posted its
+    // ticket before this point, in which case tryAcquire() sees it, or it will observe
+    // _numQueued and hand its ticket to the queue.
+    _numQueued.fetchAndAdd(1);
+    if (_queue.empty() && tryAcquire()) {
+        _numQueued.fetchAndSubtract(1);
+        return;
+    }
+
+    const auto start = curTimeMicros64();
+    Waiter waiter;
+    _queue.push_back(&waiter);
+    waiter.cv.wait(lk, [&] { return waiter.granted; });
+    _totalQueuedMicros.fetchAndAdd(curTimeMicros64() - start);
+}
+
+void TicketHolder::_grantQueued_inlock() {
+    while (!_queue.empty() && 0 == sem_trywait(&_sem)) {
+        auto waiter = _queue.front();
+        _queue.pop_front();
+        _numQueued.fetchAndSubtract(1);
+        _totalAcquired.fetchAndAdd(1);
+        waiter->granted = true;
+        waiter->cv.notify_one();
     }
 }
 
 void TicketHolder::release() {
     _check(sem_post(&_sem));
+
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<stdx::mutex> lk(_queueMutex);
+        _grantQueued_inlock();
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -134,28 +169,44 @@ TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
 TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    return _tryAcquire();
+    stdx::lock_guard<stdx::mutex> lk(_queueMutex);
+    return _queue.empty() && _tryAcquire();
 }
 
 void TicketHolder::waitForTicket() {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _waitInQueue();
+}
+
+void TicketHolder::_waitInQueue() {
+    stdx::unique_lock<stdx::mutex> lk(_queueMutex);
 
-    while (!_tryAcquire()) {
-        _newTicket.wait(lk);
+    if (_queue.empty() && _tryAcquire()) {
+        return;
     }
+
+    const auto start = curTimeMicros64();
+    Waiter waiter;
+    _queue.push_back(&waiter);
+    _numQueued.fetchAndAdd(1);
+    waiter.cv.wait(lk, [&] { return waiter.granted; });
+    _totalQueuedMicros.fetchAndAdd(curTimeMicros64() - start);
 }
 
 void TicketHolder::release() {
-    {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-        _num++;
+    stdx::lock_guard<stdx::mutex> lk(_queueMutex);
+    _num++;
+
+    while (!_queue.empty() && _tryAcquire()) {
+        auto waiter = _queue.front();
+        _queue.pop_front();
+        _numQueued.fetchAndSubtract(1);
+        waiter->granted = true;
+        waiter->cv.notify_one();
     }
-    _newTicket.notify_one();
 }
 
 Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    stdx::lock_guard<stdx::mutex> lk(_queueMutex);
 
     int used = _outof.load() - _num;
     if (used > newSize) {
@@ -171,8 +222,13 @@ Status TicketHolder::resize(int newSize) {
     _outof.store(newSize);
     _num = _outof.load() - used;
 
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
+    while (!_queue.empty() && _tryAcquire()) {
+        auto waiter = _queue.front();
+        _queue.pop_front();
+        _numQueued.fetchAndSubtract(1);
+        waiter->granted = true;
+        waiter->cv.notify_one();
+    }
     return Status::OK();
 }
 
@@ -196,6 +252,7 @@ bool TicketHolder::_tryAcquire() {
         return false;
     }
     _num--;
+    _totalAcquired.fetchAndAdd(1);
     return true;
 }
 #endif
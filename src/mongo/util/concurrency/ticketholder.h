@@ -30,13 +30,22 @@
 #include <semaphore.h>
 #endif
 
+#include <deque>
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/mutex.h"
 
 namespace mongo {
 
+/**
+ * A counting semaphore handing out a bounded number of tickets.
+ *
+ * Threads that block in waitForTicket() are queued and granted tickets in FIFO order as tickets
+ * are released, so that a waiter cannot be starved by later arrivals. tryAcquire() never queues.
+ */
 class TicketHolder {
     MONGO_DISALLOW_COPYING(TicketHolder);
 
@@ -58,8 +67,54 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of threads currently queued in waitForTicket().
+     */
+    int queued() const {
+        return _numQueued.load();
+    }
+
+    /**
+     * Returns the number of tickets handed out since this TicketHolder was created.
+     */
+    int64_t totalAcquired() const {
+        return _totalAcquired.loadRelaxed();
+    }
+
+    /**
+     * Returns the total time, in microseconds, that threads have spent queued for a ticket.
+     */
+    int64_t totalQueuedMicros() const {
+        return _totalQueuedMicros.loadRelaxed();
+    }
+
 private:
+    /**
+     * A thread blocked in waitForTicket(). Waiters are only accessed under _queueMutex.
+     */
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool granted = false;
+    };
+
+    /**
+     * Queues the calling thread and blocks until it has been granted a ticket.
+     */
+    void _waitInQueue();
+
+    stdx::mutex _queueMutex;
+    std::deque<Waiter*> _queue;
+    AtomicInt32 _numQueued;
+
+    AtomicInt64 _totalAcquired;
+    AtomicInt64 _totalQueuedMicros;
+
 #if defined(__linux__)
+    /**
+     * Hands tickets from the semaphore to queued waiters, in order. Requires _queueMutex.
+     */
+    void _grantQueued_inlock();
+
     mutable sem_t _sem;
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
@@ -68,10 +123,9 @@ private:
 #else
     bool _tryAcquire();
 
+    // Protected by _queueMutex.
     AtomicInt32 _outof;
     int _num;
-    stdx::mutex _mutex;
-    stdx::condition_variable _newTicket;
 #endif
 };
 
@@ -0,0 +1,514 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/cpu_profiler.h"
+
+#include "mongo/config.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/log.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+// for dlfcn.h, backtrace and setitimer
+#if defined(_POSIX_VERSION) && defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE)
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <map>
+#include <set>
+#include <signal.h>
+#include <sys/time.h>
+#include <unordered_map>
+#include <vector>
+
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/threadlocal.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+bool cpuProfilingEnabled = false;
+int cpuProfilingSampleIntervalMicros = 10 * 1000;
+
+ExportedServerParameter<bool, ServerParameterType::kStartupOnly> cpuProfilingEnabledParameter(
+    ServerParameterSet::getGlobal(), "cpuProfilingEnabled", &cpuProfilingEnabled);
+
+ExportedServerParameter<int, ServerParameterType::kStartupOnly>
+    cpuProfilingSampleIntervalMicrosParameter(ServerParameterSet::getGlobal(),
+                                              "cpuProfilingSampleIntervalMicros",
+                                              &cpuProfilingSampleIntervalMicros);
+
+const size_t kMaxCommandLength = 32;  // including the terminating NUL
+const size_t kMaxNsLength = 96;       // including the terminating NUL
+
+//
+// The operation a thread is running, written by the thread itself and read by the signal handler
+// when it interrupts that thread. As the handler runs on the thread it interrupts, the two never
+// run concurrently, but the handler may interrupt the thread in the middle of an update, which it
+// can tell from 'updating'.
+//
+struct ThreadOperation {
+    std::atomic<long long> samples;  // NOLINT
+    std::atomic<bool> updating;      // NOLINT
+    char command[kMaxCommandLength];
+    char ns[kMaxNsLength];
+};
+
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL ThreadOperation threadOperation;
+
+void copyTruncated(StringData source, char* dest, size_t destSize) {
+    const size_t length = std::min(source.size(), destSize - 1);
+    std::memcpy(dest, source.rawData(), length);
+    dest[length] = '\0';
+}
+
+//
+// The ring of samples, filled only by the signal handler and emptied only by the aggregator
+// thread. A slot is claimed by the handler when it is free and released by the aggregator once it
+// has read its sample. If the aggregator falls behind, samples that find their slot still in use
+// are dropped.
+//
+
+const int kMaxFramesPerStack = 64;
+const size_t kNumSampleSlots = 4096;
+
+enum SampleState { kFree, kWriting, kReady };
+
+struct Sample {
+    std::atomic<int> state{kFree};  // NOLINT
+    int numFrames = 0;
+    std::array<void*, kMaxFramesPerStack> frames;
+    char command[kMaxCommandLength];
+    char ns[kMaxNsLength];
+};
+
+Sample* sampleSlots = nullptr;
+std::atomic<unsigned long long> nextSampleSlot{0};  // NOLINT
+std::atomic<long long> totalSamples{0};             // NOLINT
+std::atomic<long long> droppedSamples{0};           // NOLINT
+std::atomic<bool> running{false};                   // NOLINT
+
+// Frames of the signal handler and of the signal trampoline at the top of each stack.
+const int kSkipStartFrames = 2;
+
+void takeSample(int) {
+    const int savedErrno = errno;
+
+    ThreadOperation& operation = threadOperation;
+    operation.samples.fetch_add(1, std::memory_order_relaxed);
+    totalSamples.fetch_add(1, std::memory_order_relaxed);
+
+    Sample& sample = sampleSlots[nextSampleSlot.fetch_add(1, std::memory_order_relaxed) %
+                                 kNumSampleSlots];
+    int expected = kFree;
+    if (!sample.state.compare_exchange_strong(expected, kWriting, std::memory_order_acquire)) {
+        droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        errno = savedErrno;
+        return;
+    }
+
+    sample.numFrames = backtrace(sample.frames.data(), kMaxFramesPerStack);
+    if (operation.updating.load(std::memory_order_relaxed)) {
+        sample.command[0] = '\0';
+        sample.ns[0] = '\0';
+    } else {
+        std::memcpy(sample.command, operation.command, kMaxCommandLength);
+        std::memcpy(sample.ns, operation.ns, kMaxNsLength);
+    }
+
+    sample.state.store(kReady, std::memory_order_release);
+    errno = savedErrno;
+}
+
+//
+// The aggregated samples, updated by the aggregator thread and read to generate the serverStatus
+// section.
+//
+
+const size_t kMaxStacks = 20000;      // samples of any further stack are only counted in total
+const size_t kMaxOperations = 10000;  // samples of any further operation are only counted in total
+
+// Number of stacks, and of operations, reported to serverStatus at the most.
+const size_t kMaxReportedStacks = 50;
+const size_t kMaxReportedOperations = 20;
+
+// The reported stacks and operations are reset every 4 hours at the default of 1 sample / sec.
+const int kMaxReportSamples = 4 * 3600;
+
+struct StackKey {
+    std::vector<void*> frames;
+
+    bool operator==(const StackKey& other) const {
+        return frames == other.frames;
+    }
+};
+
+struct StackKeyHasher {
+    size_t operator()(const StackKey& key) const {
+        uint32_t hash = 0;
+        MurmurHash3_x86_32(key.frames.data(), key.frames.size() * sizeof(void*), 0, &hash);
+        return hash;
+    }
+};
+
+struct StackInfo {
+    int stackNum = 0;  // used for stack short name
+    long long samples = 0;
+    BSONObj stackObj{};  // symbolized representation
+};
+
+struct OperationInfo {
+    int operationNum = 0;  // used for operation short name
+    long long samples = 0;
+};
+
+using OperationKey = std::pair<std::string, std::string>;  // command and namespace
+using OperationEntry = std::pair<const OperationKey*, OperationInfo*>;
+
+class SampleAggregator {
+public:
+    void drain() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (size_t i = 0; i < kNumSampleSlots; ++i) {
+            Sample& sample = sampleSlots[i];
+            if (sample.state.load(std::memory_order_acquire) != kReady) {
+                continue;
+            }
+            _add(sample);
+            sample.state.store(kFree, std::memory_order_release);
+        }
+    }
+
+    void appendServerStatusSection(BSONObjBuilder* builder) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        BSONObjBuilder statsBuilder(builder->subobjStart("stats"));
+        statsBuilder.appendNumber("sampleIntervalMicros", cpuProfilingSampleIntervalMicros);
+        statsBuilder.appendNumber("totalSamples", totalSamples.load());
+        statsBuilder.appendNumber("droppedSamples", droppedSamples.load());
+        statsBuilder.appendNumber("untrackedStackSamples", _untrackedStackSamples);
+        statsBuilder.appendNumber("untrackedOperationSamples", _untrackedOperationSamples);
+        statsBuilder.appendNumber("numStacks", static_cast<long long>(_stacks.size()));
+        statsBuilder.appendNumber("numOperations", static_cast<long long>(_operations.size()));
+        statsBuilder.doneFast();
+
+        // As in the heap profiler, the stacks and operations with the most samples are deemed
+        // "important", and remain so from then on. This keeps the set of reported stacks stable,
+        // and as they are always emitted in the order they were first seen, FTDC compresses them
+        // efficiently.
+        using StackEntry = std::pair<const StackKey*, StackInfo*>;
+        std::vector<StackEntry> stacks;
+        for (auto& entry : _stacks) {
+            stacks.emplace_back(&entry.first, &entry.second);
+        }
+        const auto topStacksEnd = stacks.begin() + std::min(kMaxReportedStacks, stacks.size());
+        std::partial_sort(stacks.begin(),
+                          topStacksEnd,
+                          stacks.end(),
+                          [](const StackEntry& a, const StackEntry& b) {
+                              return a.second->samples > b.second->samples;
+                          });
+        for (auto it = stacks.begin(); it != topStacksEnd; ++it) {
+            _generateStackIfNeeded(*it->first, it->second);
+            _importantStacks.insert(it->second);
+        }
+
+        BSONObjBuilder stacksBuilder(builder->subobjStart("stacks"));
+        for (StackInfo* stackInfo : _importantStacks) {
+            std::ostringstream shortName;
+            shortName << "stack" << stackInfo->stackNum;
+            BSONObjBuilder stackBuilder(stacksBuilder.subobjStart(shortName.str()));
+            stackBuilder.appendNumber("samples", stackInfo->samples);
+            stackBuilder.append("stack", stackInfo->stackObj);
+        }
+        stacksBuilder.doneFast();
+
+        std::vector<OperationEntry> operations;
+        for (auto& entry : _operations) {
+            operations.emplace_back(&entry.first, &entry.second);
+        }
+        const auto topOperationsEnd =
+            operations.begin() + std::min(kMaxReportedOperations, operations.size());
+        std::partial_sort(operations.begin(),
+                          topOperationsEnd,
+                          operations.end(),
+                          [](const OperationEntry& a, const OperationEntry& b) {
+                              return a.second->samples > b.second->samples;
+                          });
+        for (auto it = operations.begin(); it != topOperationsEnd; ++it) {
+            if (_importantOperations.emplace(it->second->operationNum, *it).second) {
+                log() << "cpuProfile op" << it->second->operationNum << ": "
+                      << it->first->first << " " << it->first->second;
+            }
+        }
+
+        BSONObjBuilder operationsBuilder(builder->subobjStart("operations"));
+        for (const auto& entry : _importantOperations) {
+            std::ostringstream shortName;
+            shortName << "op" << entry.first;
+            BSONObjBuilder operationBuilder(operationsBuilder.subobjStart(shortName.str()));
+            operationBuilder.append("command", entry.second.first->first);
+            operationBuilder.append("ns", entry.second.first->second);
+            operationBuilder.appendNumber("samples", entry.second.second->samples);
+        }
+        operationsBuilder.doneFast();
+
+        if (++_numReportSamples >= kMaxReportSamples) {
+            log() << "clearing important cpuProfile stacks and operations";
+            _importantStacks.clear();
+            _importantOperations.clear();
+            _numReportSamples = 0;
+        }
+    }
+
+private:
+    void _add(const Sample& sample) {
+        StackKey key;
+        if (sample.numFrames > kSkipStartFrames) {
+            key.frames.assign(sample.frames.begin() + kSkipStartFrames,
+                              sample.frames.begin() + sample.numFrames);
+        }
+
+        auto stackIt = _stacks.find(key);
+        if (stackIt == _stacks.end() && _stacks.size() < kMaxStacks) {
+            StackInfo newStackInfo;
+            newStackInfo.stackNum = _stacks.size();
+            stackIt = _stacks.emplace(std::move(key), newStackInfo).first;
+        }
+        if (stackIt != _stacks.end()) {
+            ++stackIt->second.samples;
+        } else {
+            ++_untrackedStackSamples;
+        }
+
+        OperationKey operationKey(sample.command, sample.ns);
+        auto operationIt = _operations.find(operationKey);
+        if (operationIt == _operations.end() && _operations.size() < kMaxOperations) {
+            OperationInfo newOperationInfo;
+            newOperationInfo.operationNum = _operations.size();
+            operationIt = _operations.emplace(std::move(operationKey), newOperationInfo).first;
+        }
+        if (operationIt != _operations.end()) {
+            ++operationIt->second.samples;
+        } else {
+            ++_untrackedOperationSamples;
+        }
+    }
+
+    void _generateStackIfNeeded(const StackKey& key, StackInfo* stackInfo) {
+        if (!stackInfo->stackObj.isEmpty())
+            return;
+        BSONArrayBuilder builder;
+        for (void* frame : key.frames) {
+            Dl_info dli;
+            std::string frameString;
+            if (dladdr(frame, &dli) && dli.dli_sname) {
+                int status;
+                char* demangled = abi::__cxa_demangle(dli.dli_sname, 0, 0, &status);
+                if (demangled) {
+                    // strip off function parameters as they are very verbose and not useful
+                    char* p = strchr(demangled, '(');
+                    frameString = p ? std::string(demangled, p - demangled) : demangled;
+                    free(demangled);
+                } else {
+                    frameString = dli.dli_sname;
+                }
+            }
+            if (frameString.empty()) {
+                std::ostringstream s;
+                s << frame;
+                frameString = s.str();
+            }
+            builder.append(frameString);
+        }
+        stackInfo->stackObj = builder.obj();
+        log() << "cpuProfile stack" << stackInfo->stackNum << ": " << stackInfo->stackObj;
+    }
+
+    stdx::mutex _mutex;
+
+    std::unordered_map<StackKey, StackInfo, StackKeyHasher> _stacks;
+    std::map<OperationKey, OperationInfo> _operations;
+    long long _untrackedStackSamples = 0;
+    long long _untrackedOperationSamples = 0;
+
+    std::set<StackInfo*, bool (*)(StackInfo*, StackInfo*)> _importantStacks{
+        [](StackInfo* a, StackInfo* b) -> bool { return a->stackNum < b->stackNum; }};
+    std::map<int, OperationEntry> _importantOperations;  // keyed by operationNum
+    int _numReportSamples = 0;
+};
+
+SampleAggregator* sampleAggregator = nullptr;
+
+// How often the aggregator thread empties the ring of samples.
+const Milliseconds kDrainInterval(100);
+
+void runAggregator() {
+    setThreadName("CpuProfiler");
+    while (true) {
+        sleepFor(kDrainInterval);
+        sampleAggregator->drain();
+    }
+}
+
+}  // namespace
+
+void CpuProfiler::startIfEnabled() {
+    if (!cpuProfilingEnabled || running.load()) {
+        return;
+    }
+    if (cpuProfilingSampleIntervalMicros <= 0) {
+        warning() << "cpuProfilingSampleIntervalMicros must be positive; CPU profiling disabled";
+        return;
+    }
+
+    sampleSlots = new Sample[kNumSampleSlots]();
+    sampleAggregator = new SampleAggregator();
+
+    // The first call to backtrace() may allocate, which is not safe in a signal handler.
+    void* warmUpFrames[kMaxFramesPerStack];
+    backtrace(warmUpFrames, kMaxFramesPerStack);
+
+    stdx::thread(runAggregator).detach();
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &takeSample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+        const int savedErrno = errno;
+        warning() << "failed to install the CPU profiling signal handler: "
+                  << errnoWithDescription(savedErrno);
+        return;
+    }
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = cpuProfilingSampleIntervalMicros / (1000 * 1000);
+    timer.it_interval.tv_usec = cpuProfilingSampleIntervalMicros % (1000 * 1000);
+    timer.it_value = timer.it_interval;
+    running.store(true);
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        const int savedErrno = errno;
+        running.store(false);
+        warning() << "failed to start the CPU profiling timer: "
+                  << errnoWithDescription(savedErrno);
+        return;
+    }
+
+    log() << "CPU profiling started, taking a sample every " << cpuProfilingSampleIntervalMicros
+          << " microseconds of CPU time";
+}
+
+bool CpuProfiler::isRunning() {
+    return running.load(std::memory_order_relaxed);
+}
+
+void CpuProfiler::setThreadOperation(StringData command, StringData ns) {
+    if (!isRunning()) {
+        return;
+    }
+    ThreadOperation& operation = threadOperation;
+    operation.updating.store(true, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    copyTruncated(command, operation.command, kMaxCommandLength);
+    copyTruncated(ns, operation.ns, kMaxNsLength);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    operation.updating.store(false, std::memory_order_relaxed);
+}
+
+void CpuProfiler::clearThreadOperation() {
+    setThreadOperation(StringData(), StringData());
+}
+
+const std::atomic<long long>* CpuProfiler::threadSampleCount() {  // NOLINT
+    return &threadOperation.samples;
+}
+
+void CpuProfiler::appendServerStatusSection(BSONObjBuilder* builder) {
+    if (isRunning()) {
+        sampleAggregator->appendServerStatusSection(builder);
+    }
+}
+
+}  // namespace mongo
+
+#else  // defined(_POSIX_VERSION) && defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE)
+
+namespace mongo {
+namespace {
+
+bool cpuProfilingEnabled = false;
+
+ExportedServerParameter<bool, ServerParameterType::kStartupOnly> cpuProfilingEnabledParameter(
+    ServerParameterSet::getGlobal(), "cpuProfilingEnabled", &cpuProfilingEnabled);
+
+std::atomic<long long> noSamples{0};  // NOLINT
+
+}  // namespace
+
+void CpuProfiler::startIfEnabled() {
+    if (cpuProfilingEnabled) {
+        warning() << "CPU profiling is not supported on this platform";
+    }
+}
+
+bool CpuProfiler::isRunning() {
+    return false;
+}
+
+void CpuProfiler::setThreadOperation(StringData command, StringData ns) {}
+
+void CpuProfiler::clearThreadOperation() {}
+
+const std::atomic<long long>* CpuProfiler::threadSampleCount() {  // NOLINT
+    return &noSamples;
+}
+
+void CpuProfiler::appendServerStatusSection(BSONObjBuilder* builder) {}
+
+}  // namespace mongo
+
+#endif  // defined(_POSIX_VERSION) && defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE)
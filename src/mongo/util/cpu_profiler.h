@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Statistical sampling CPU profiler.
+ *
+ * Once started, a profiling timer interrupts the thread using the CPU every so many microseconds
+ * of CPU time consumed by the process. The signal handler records the stack of the interrupted
+ * thread, along with the command and namespace of the operation the thread is running, into a
+ * pre-allocated ring of samples. It neither allocates nor locks. A background thread regularly
+ * moves the samples out of the ring into tables of samples per stack and per operation, from
+ * which the "cpuProfile" serverStatus section is generated.
+ *
+ * Enable at startup time (only) with
+ *     mongod --setParameter cpuProfilingEnabled=true
+ *
+ * The profiling timer uses SIGPROF, so this can't be combined with the gperftools CPU profiler of
+ * builds made with --use-cpu-profiler.
+ */
+class CpuProfiler {
+public:
+    /**
+     * Starts sampling if it was enabled at startup. Must be called after the process daemonized,
+     * as profiling timers are not inherited by forked processes.
+     */
+    static void startIfEnabled();
+
+    /**
+     * Returns true if samples are being taken.
+     */
+    static bool isRunning();
+
+    /**
+     * Sets the command, or operation type, and the namespace that the samples of the calling
+     * thread are charged to. Both are truncated to a fixed length.
+     */
+    static void setThreadOperation(StringData command, StringData ns);
+
+    /**
+     * Stops charging the samples of the calling thread to any operation.
+     */
+    static void clearThreadOperation();
+
+    /**
+     * Returns the address of the number of samples taken of the calling thread, for the thread to
+     * pass to others which report on its operations. It stays valid while the thread is alive.
+     */
+    static const std::atomic<long long>* threadSampleCount();  // NOLINT
+
+    /**
+     * Appends the "cpuProfile" serverStatus section.
+     */
+    static void appendServerStatusSection(BSONObjBuilder* builder);
+};
+
+}  // namespace mongo
@@ -102,7 +102,9 @@ public:
     };
 
     friend void intrusive_ptr_release(const RefCountable* ptr) {
-        if (ptr->_count.subtractAndFetch(1) == 0) {
+        // Most objects are released by their only owner. Since nobody else holds a reference in
+        // that case, nobody can add one concurrently and the atomic decrement can be skipped.
+        if (ptr->_count.load() == 1 || ptr->_count.subtractAndFetch(1) == 0) {
             delete ptr;  // uses subclass destructor and operator delete
         }
     };
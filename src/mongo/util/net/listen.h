@@ -47,6 +47,13 @@ const int DEFAULT_MAX_CONN = 1000000;
 
 class ServiceContext;
 
+/**
+ * Expands a comma separated list of ip addresses (as given by --bind_ip) into the addresses to
+ * listen on for 'port'. An empty list means all interfaces. If 'useUnixSockets' is true, the unix
+ * domain socket for 'port' is included as well.
+ */
+std::vector<SockAddr> ipToAddrs(const char* ips, int port, bool useUnixSockets);
+
 class Listener {
     MONGO_DISALLOW_COPYING(Listener);
 
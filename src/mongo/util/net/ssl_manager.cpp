@@ -36,6 +36,7 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/tss.hpp>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -46,6 +47,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/debug_util.h"
@@ -59,6 +61,7 @@
 #include "mongo/util/net/ssl_types.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/text.h"
+#include "mongo/util/timer.h"
 
 #ifdef MONGO_CONFIG_SSL
 #include <openssl/asn1.h>
@@ -113,8 +116,15 @@ ExportedServerParameter<bool, ServerParameterType::kStartupOnly>
 #define SSL_OP_NO_TLSv1_2 0
 #endif
 
+// Whether outgoing connections offer the last TLS session negotiated with the same host for
+// resumption, instead of always performing a full handshake.
+MONGO_EXPORT_SERVER_PARAMETER(sslClientSessionResumption, bool, true);
+
 namespace {
 
+// Bounds the number of remote hosts with a remembered client session.
+const size_t kMaxClientSessions = 10000;
+
 // clang-format off
 #ifndef MONGO_CONFIG_HAVE_ASN1_ANY_DEFINITIONS
 // Copies of OpenSSL before 1.0.0 do not have ASN1_SEQUENCE_ANY, ASN1_SET_ANY, or the helper
@@ -240,6 +250,8 @@ class SSLManager : public SSLManagerInterface {
 public:
     explicit SSLManager(const SSLParams& params, bool isServer);
 
+    ~SSLManager();
+
     /**
      * Initializes an OpenSSL context according to the provided settings. Only settings which are
      * acceptable on non-blocking connections are set.
@@ -258,6 +270,15 @@ public:
     StatusWith<boost::optional<SSLPeerInfo>> parseAndValidatePeerCertificate(
         SSL* conn, const std::string& remoteHost) final;
 
+    void prepareClientSession(SSL* ssl, const std::string& remoteHost) final;
+
+    void recordHandshake(SSL* ssl,
+                         ConnectionDirection direction,
+                         const std::string& remoteHost,
+                         Microseconds elapsed) final;
+
+    void appendHandshakeStats(BSONObjBuilder* builder) const final;
+
     virtual const SSLConfiguration& getSSLConfiguration() const {
         return _sslConfiguration;
     }
@@ -287,6 +308,22 @@ private:
     bool _allowInvalidHostnames;
     SSLConfiguration _sslConfiguration;
 
+    // The last session negotiated with each remote host, by client context. Holds a reference on
+    // each session, released when it is replaced or the manager is destroyed.
+    using ClientSessionKey = std::pair<SSL_CTX*, std::string>;
+    stdx::mutex _clientSessionsMutex;
+    std::map<ClientSessionKey, SSL_SESSION*> _clientSessions;
+
+    struct HandshakeStats {
+        AtomicUInt64 full;
+        AtomicUInt64 resumed;
+        AtomicUInt64 totalMicros;
+
+        void append(BSONObjBuilder* builder, StringData fieldName) const;
+    };
+    HandshakeStats _incomingHandshakes;
+    HandshakeStats _outgoingHandshakes;
+
     /**
      * creates an SSL object to be used for this file descriptor.
      * caller must SSL_free it.
@@ -535,6 +572,12 @@ BSONObj SSLConfiguration::getServerStatusBSON() const {
 
 SSLManagerInterface::~SSLManagerInterface() {}
 
+SSLManager::~SSLManager() {
+    for (auto&& entry : _clientSessions) {
+        ::SSL_SESSION_free(entry.second);
+    }
+}
+
 SSLManager::SSLManager(const SSLParams& params, bool isServer)
     : _serverContext(nullptr, _free_ssl_context),
       _clientContext(nullptr, _free_ssl_context),
@@ -1145,10 +1188,15 @@ SSLConnection* SSLManager::connect(Socket* socket) {
     std::unique_ptr<SSLConnection> sslConn =
         stdx::make_unique<SSLConnection>(_clientContext.get(), socket, (const char*)NULL, 0);
 
+    const auto remoteHost = socket->remoteString();
+    Timer timer;
+
     int ret = ::SSL_set_tlsext_host_name(sslConn->ssl, socket->remoteAddr().hostOrIp().c_str());
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
+    prepareClientSession(sslConn->ssl, remoteHost);
+
     do {
         ret = ::SSL_connect(sslConn->ssl);
     } while (!_doneWithSSLOp(sslConn.get(), ret));
@@ -1156,6 +1204,11 @@ SSLConnection* SSLManager::connect(Socket* socket) {
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
+    recordHandshake(sslConn->ssl,
+                    ConnectionDirection::kOutgoing,
+                    remoteHost,
+                    Microseconds(timer.micros()));
+
     return sslConn.release();
 }
 
@@ -1163,6 +1216,8 @@ SSLConnection* SSLManager::accept(Socket* socket, const char* initialBytes, int
     std::unique_ptr<SSLConnection> sslConn =
         stdx::make_unique<SSLConnection>(_serverContext.get(), socket, initialBytes, len);
 
+    Timer timer;
+
     int ret;
     do {
         ret = ::SSL_accept(sslConn->ssl);
@@ -1171,9 +1226,77 @@ SSLConnection* SSLManager::accept(Socket* socket, const char* initialBytes, int
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
+    recordHandshake(sslConn->ssl,
+                    ConnectionDirection::kIncoming,
+                    socket->remoteString(),
+                    Microseconds(timer.micros()));
+
     return sslConn.release();
 }
 
+void SSLManager::prepareClientSession(SSL* ssl, const std::string& remoteHost) {
+    if (!sslClientSessionResumption.load()) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_clientSessionsMutex);
+    auto iter = _clientSessions.find(ClientSessionKey(::SSL_get_SSL_CTX(ssl), remoteHost));
+    if (iter != _clientSessions.end()) {
+        // Takes its own reference on the session. If the server no longer knows the session, the
+        // handshake falls back to a full one.
+        ::SSL_set_session(ssl, iter->second);
+    }
+}
+
+void SSLManager::recordHandshake(SSL* ssl,
+                                 ConnectionDirection direction,
+                                 const std::string& remoteHost,
+                                 Microseconds elapsed) {
+    auto& stats =
+        direction == ConnectionDirection::kIncoming ? _incomingHandshakes : _outgoingHandshakes;
+    const bool resumed = ::SSL_session_reused(ssl);
+    (resumed ? stats.resumed : stats.full).fetchAndAdd(1);
+    stats.totalMicros.fetchAndAdd(durationCount<Microseconds>(elapsed));
+
+    if (direction != ConnectionDirection::kOutgoing || resumed ||
+        !sslClientSessionResumption.load()) {
+        return;
+    }
+
+    SSL_SESSION* session = ::SSL_get1_session(ssl);
+    if (!session) {
+        return;
+    }
+
+    ClientSessionKey key(::SSL_get_SSL_CTX(ssl), remoteHost);
+    stdx::lock_guard<stdx::mutex> lk(_clientSessionsMutex);
+    auto iter = _clientSessions.find(key);
+    if (iter != _clientSessions.end()) {
+        ::SSL_SESSION_free(iter->second);
+        iter->second = session;
+        return;
+    }
+
+    if (_clientSessions.size() >= kMaxClientSessions) {
+        ::SSL_SESSION_free(_clientSessions.begin()->second);
+        _clientSessions.erase(_clientSessions.begin());
+    }
+    _clientSessions.emplace(std::move(key), session);
+}
+
+void SSLManager::HandshakeStats::append(BSONObjBuilder* builder, StringData fieldName) const {
+    BSONObjBuilder sub(builder->subobjStart(fieldName));
+    sub.appendNumber("full", static_cast<long long>(full.load()));
+    sub.appendNumber("resumed", static_cast<long long>(resumed.load()));
+    sub.appendNumber("totalMicros", static_cast<long long>(totalMicros.load()));
+}
+
+void SSLManager::appendHandshakeStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder handshakes(builder->subobjStart("SSLHandshakes"));
+    _incomingHandshakes.append(&handshakes, "incoming");
+    _outgoingHandshakes.append(&handshakes, "outgoing");
+}
+
 // TODO SERVER-11601 Use NFC Unicode canonicalization
 bool SSLManager::_hostNameMatch(const char* nameToMatch, const char* certHostName) {
     if (strlen(certHostName) < 2) {
@@ -186,6 +186,27 @@ public:
      */
     virtual StatusWith<boost::optional<SSLPeerInfo>> parseAndValidatePeerCertificate(
         SSL* ssl, const std::string& remoteHost) = 0;
+
+    /**
+     * Offers the TLS session last negotiated with "remoteHost" from the same context for
+     * resumption, so that the client handshake about to start on "ssl" can skip the key exchange.
+     * Does nothing if there is no such session.
+     */
+    virtual void prepareClientSession(SSL* ssl, const std::string& remoteHost) = 0;
+
+    /**
+     * Records a successfully completed handshake for the serverStatus counters. For outgoing
+     * connections, the negotiated session is also kept for prepareClientSession().
+     */
+    virtual void recordHandshake(SSL* ssl,
+                                 ConnectionDirection direction,
+                                 const std::string& remoteHost,
+                                 Microseconds elapsed) = 0;
+
+    /**
+     * Appends the handshake counters, split by direction and by whether the session was resumed.
+     */
+    virtual void appendHandshakeStats(BSONObjBuilder* builder) const = 0;
 };
 
 // Access SSL functions through this instance.
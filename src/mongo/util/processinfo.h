@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/process_id.h"
@@ -124,6 +125,13 @@ public:
         return sysInfo().hasNuma;
     }
 
+    /**
+     * Get the CPUs of each NUMA node of the system. Empty where the topology is not known.
+     */
+    const std::vector<std::vector<unsigned>>& getNumaNodeCpus() const {
+        return sysInfo().numaNodeCpus;
+    }
+
     /**
      * Determine if file zeroing is necessary for newly allocated data files.
      */
@@ -198,6 +206,7 @@ private:
         unsigned long long pageSize;
         std::string cpuArch;
         bool hasNuma;
+        std::vector<std::vector<unsigned>> numaNodeCpus;
         BSONObj _extraStats;
 
         // This is an OS specific value, which determines whether files should be zero-filled
@@ -49,9 +49,12 @@
 #include <boost/filesystem.hpp>
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
+#include <map>
 
+#include "mongo/base/parse_number.h"
 #include "mongo/util/file.h"
 #include "mongo/util/log.h"
+#include "mongo/util/stringutils.h"
 
 using namespace std;
 
@@ -380,6 +383,52 @@ public:
         }
     }
 
+    /**
+    * Get the CPUs of each NUMA node, in node order, from their lists in sysfs such as "0-7,16-23"
+    */
+    static void getNumaNodeCpus(vector<vector<unsigned>>* nodeCpus, vector<string>* cpuLists) {
+        const boost::filesystem::path nodesPath("/sys/devices/system/node");
+        std::map<unsigned, string> lists;
+        try {
+            if (!boost::filesystem::exists(nodesPath))
+                return;
+            for (boost::filesystem::directory_iterator it(nodesPath), end; it != end; ++it) {
+                const string name = it->path().filename().string();
+                unsigned node;
+                if (name.compare(0, 4, "node") != 0 ||
+                    !parseNumberFromString(name.substr(4), &node).isOK())
+                    continue;
+                lists[node] = readLineFromFile((it->path() / "cpulist").string().c_str());
+            }
+        } catch (boost::filesystem::filesystem_error& e) {
+            log() << "Unable to collect NUMA topology: failed to probe \"" << e.path1().string()
+                  << "\": " << e.code().message();
+            return;
+        }
+
+        for (const auto& nodeAndList : lists) {
+            vector<string> ranges;
+            splitStringDelim(nodeAndList.second, &ranges, ',');
+
+            vector<unsigned> cpus;
+            for (const auto& range : ranges) {
+                const size_t dash = range.find('-');
+                unsigned first;
+                unsigned last;
+                if (!parseNumberFromString(range.substr(0, dash), &first).isOK())
+                    continue;
+                if (dash == string::npos)
+                    last = first;
+                else if (!parseNumberFromString(range.substr(dash + 1), &last).isOK())
+                    continue;
+                for (unsigned cpu = first; cpu <= last; cpu++)
+                    cpus.push_back(cpu);
+            }
+            nodeCpus->push_back(std::move(cpus));
+            cpuLists->push_back(nodeAndList.second);
+        }
+    }
+
     /**
     * Get system memory total
     */
@@ -485,6 +534,9 @@ void ProcessInfo::SystemInfo::collectSystemInfo() {
     cpuArch = unameData.machine;
     hasNuma = checkNumaEnabled();
 
+    vector<string> numaNodeCpuLists;
+    LinuxSysHelper::getNumaNodeCpus(&numaNodeCpus, &numaNodeCpuLists);
+
     BSONObjBuilder bExtra;
     bExtra.append("versionString", LinuxSysHelper::readLineFromFile("/proc/version"));
 #ifdef __UCLIBC__
@@ -504,6 +556,8 @@ void ProcessInfo::SystemInfo::collectSystemInfo() {
     bExtra.append("pageSize", static_cast<long long>(pageSize));
     bExtra.append("numPages", static_cast<int>(sysconf(_SC_PHYS_PAGES)));
     bExtra.append("maxOpenFiles", static_cast<int>(sysconf(_SC_OPEN_MAX)));
+    if (!numaNodeCpuLists.empty())
+        bExtra.append("numaNodeCpus", numaNodeCpuLists);
 
     _extraStats = bExtra.obj();
 }
@@ -30,6 +30,7 @@
 
 #include <boost/optional.hpp>
 #include <iostream>
+#include <set>
 #include <vector>
 
 #include "mongo/unittest/unittest.h"
@@ -69,4 +70,15 @@ TEST(ProcessInfo, GetNumCoresReturnsNonZeroNumberOfProcessors) {
     ProcessInfo::initializeSystemInfo();
     ASSERT_GREATER_THAN(processInfo.getNumCores(), 0u);
 }
+
+TEST(ProcessInfo, NumaNodesDoNotShareCpus) {
+    ProcessInfo processInfo;
+    ProcessInfo::initializeSystemInfo();
+    std::set<unsigned> seen;
+    for (const auto& cpus : processInfo.getNumaNodeCpus()) {
+        for (unsigned cpu : cpus) {
+            ASSERT_TRUE(seen.insert(cpu).second) << "cpu " << cpu << " is in several nodes";
+        }
+    }
+}
 }
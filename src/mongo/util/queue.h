@@ -30,8 +30,10 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <algorithm>
+#include <deque>
 #include <limits>
-#include <queue>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/stdx/chrono.h"
@@ -95,7 +97,7 @@ public:
 
         auto pushOne = [this](const T& obj) {
             size_t tSize = _getSize(obj);
-            _queue.push(obj);
+            _queue.push_back(obj);
             _currentSize += tSize;
         };
         std::for_each(begin, end, pushOne);
@@ -146,7 +148,7 @@ public:
     void clear() {
         stdx::lock_guard<stdx::mutex> lk(_lock);
         _clearing = true;
-        _queue = std::queue<T>();
+        _queue = std::deque<T>();
         _currentSize = 0;
         _cvNoLongerFull.notify_one();
         _cvNoLongerEmpty.notify_one();
@@ -158,7 +160,7 @@ public:
             return false;
 
         t = _queue.front();
-        _queue.pop();
+        _queue.pop_front();
         _currentSize -= _getSize(t);
         _cvNoLongerFull.notify_one();
 
@@ -175,7 +177,7 @@ public:
         }
 
         T t = _queue.front();
-        _queue.pop();
+        _queue.pop_front();
         _currentSize -= _getSize(t);
         _cvNoLongerFull.notify_one();
 
@@ -202,7 +204,7 @@ public:
             return false;
         }
         t = _queue.front();
-        _queue.pop();
+        _queue.pop_front();
         _currentSize -= _getSize(t);
         _cvNoLongerFull.notify_one();
         return true;
@@ -238,6 +240,39 @@ public:
         return true;
     }
 
+    /**
+     * Appends up to "maxCount" items from the front of the queue to "items", oldest first, without
+     * removing them. Returns the number of items appended.
+     *
+     * NOTE: Should only be used in a single consumer case.
+     */
+    size_t peekUpTo(size_t maxCount, std::vector<T>* items) {
+        stdx::lock_guard<stdx::mutex> lk(_lock);
+        const auto count = std::min(maxCount, _queue.size());
+        items->insert(items->end(), _queue.begin(), _queue.begin() + count);
+        return count;
+    }
+
+    /**
+     * Removes up to "maxCount" items from the front of the queue and appends them to "items",
+     * oldest first. Returns the number of items removed.
+     */
+    size_t tryPopUpTo(size_t maxCount, std::vector<T>* items) {
+        stdx::lock_guard<stdx::mutex> lk(_lock);
+        const auto count = std::min(maxCount, _queue.size());
+        if (count == 0) {
+            return 0;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            _currentSize -= _getSize(_queue.front());
+            items->push_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+        _cvNoLongerFull.notify_one();
+        return count;
+    }
+
     /**
      * Returns the item most recently added to the queue or nothing if the queue is empty.
      */
@@ -262,14 +297,14 @@ private:
 
     void pushImpl_inlock(const T& obj, size_t objSize) {
         _clearing = false;
-        _queue.push(obj);
+        _queue.push_back(obj);
         _currentSize += objSize;
         if (_queue.size() == 1)  // We were empty.
             _cvNoLongerEmpty.notify_one();
     }
 
     mutable stdx::mutex _lock;
-    std::queue<T> _queue;
+    std::deque<T> _queue;
     const size_t _maxSize;
     size_t _currentSize = 0;
     GetSizeFn _getSize;
@@ -34,6 +34,7 @@
 #include "mongo/platform/random.h"
 #include "mongo/platform/unordered_map.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/timer.h"
 
@@ -183,6 +184,48 @@ TEST(StringMapTest, Iterator3) {
 }
 
 
+TEST(StringMapTest, EraseAndReinsertAcrossGrowth) {
+    StringMap<int> m;
+    const int kKeys = 5000;
+    for (int i = 0; i < kKeys; i++) {
+        m[str::stream() << "key" << i] = i;
+    }
+
+    // Leaves deleted slots throughout the table, which later lookups must probe past.
+    for (int i = 0; i < kKeys; i += 3) {
+        ASSERT_EQUALS(1U, m.erase(str::stream() << "key" << i));
+    }
+    for (int i = 0; i < kKeys; i++) {
+        auto it = m.find(str::stream() << "key" << i);
+        if (i % 3 == 0) {
+            ASSERT(it == m.end());
+        } else {
+            ASSERT(it != m.end());
+            ASSERT_EQUALS(i, it->second);
+        }
+    }
+
+    // Reinsert the erased keys and grow the table past its size.
+    for (int i = 0; i < 2 * kKeys; i++) {
+        if (i >= kKeys || i % 3 == 0) {
+            ASSERT_TRUE(m.try_emplace(str::stream() << "key" << i, -i).second);
+        }
+    }
+    ASSERT_EQUALS(static_cast<size_t>(2 * kKeys), m.size());
+
+    StringMap<int> copy = m;
+    size_t iterated = 0;
+    for (auto&& entry : copy) {
+        ASSERT_EQUALS(entry.second, m[entry.first]);
+        iterated++;
+    }
+    ASSERT_EQUALS(m.size(), iterated);
+    for (int i = 0; i < 2 * kKeys; i++) {
+        const int expected = i >= kKeys || i % 3 == 0 ? -i : i;
+        ASSERT_EQUALS(expected, copy[str::stream() << "key" << i]);
+    }
+}
+
 TEST(StringMapTest, Copy1) {
     StringMap<int> m;
     m["eliot"] = 5;
@@ -35,6 +35,16 @@
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+void DoubleDoubleSummation::addDoubles(const double* values, size_t count) {
+    // Work on local copies of the state, so that it stays in registers for the whole loop rather
+    // than being stored back after every addition.
+    DoubleDoubleSummation local = *this;
+    for (size_t i = 0; i < count; ++i) {
+        local.addDouble(values[i]);
+    }
+    *this = local;
+}
+
 void DoubleDoubleSummation::addLong(long long x) {
     // Split 64-bit integers into two doubles, so the sum remains exact.
     int64_t high = x / (1ll << 32) * (1ll << 32);
@@ -44,6 +54,14 @@ void DoubleDoubleSummation::addLong(long long x) {
     addDouble(high);
 }
 
+void DoubleDoubleSummation::addLongs(const long long* values, size_t count) {
+    DoubleDoubleSummation local = *this;
+    for (size_t i = 0; i < count; ++i) {
+        local.addLong(values[i]);
+    }
+    *this = local;
+}
+
 /**
  * Returns whether the sum is in range of the 64-bit signed integer long long type.
  */
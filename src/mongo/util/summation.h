@@ -57,12 +57,24 @@ public:
         _addend += x;                                  // Store away lowest part of sum
     }
 
+    /**
+     * Adds each of the 'count' doubles at 'values' in order, with the same result as calling
+     * addDouble() on each of them.
+     */
+    void addDoubles(const double* values, size_t count);
+
     /**
      * Adds x to internal sum. Extra precision guarantees that sum is exact, unless intermediate
      * sums exceed a magnitude of 2**106.
      */
     void addLong(long long x);
 
+    /**
+     * Adds each of the 'count' integers at 'values' in order, with the same result as calling
+     * addLong() on each of them.
+     */
+    void addLongs(const long long* values, size_t count);
+
     /**
      * Adds x to internal sum. Adds as double as that is more efficient.
      */
@@ -198,4 +198,40 @@ TEST(Summation, AddDoubles) {
     ASSERT_EQUALS(sum.getDouble(), doubleValuesSum);
     ASSERT(straightSum != sum.getDouble());
 }
+
+TEST(Summation, AddDoublesInBulkMatchesAddDouble) {
+    DoubleDoubleSummation sum;
+    for (auto x : doubleValues) {
+        sum.addDouble(x);
+    }
+
+    // Start the bulk sum part way through, to check that existing state is carried over.
+    DoubleDoubleSummation bulkSum;
+    bulkSum.addDouble(doubleValues[0]);
+    bulkSum.addDoubles(doubleValues.data() + 1, doubleValues.size() - 1);
+    ASSERT(bulkSum.getDoubleDouble() == sum.getDoubleDouble());
+    ASSERT_EQUALS(bulkSum.getDouble(), doubleValuesSum);
+
+    std::vector<double> withSpecial(doubleValues);
+    withSpecial.push_back(std::numeric_limits<double>::quiet_NaN());
+    DoubleDoubleSummation specialSum;
+    specialSum.addDoubles(withSpecial.data(), withSpecial.size());
+    ASSERT(std::isnan(specialSum.getDouble()));
+}
+
+TEST(Summation, AddLongsInBulkMatchesAddLong) {
+    DoubleDoubleSummation sum;
+    for (auto x : longValues) {
+        sum.addLong(x);
+    }
+
+    DoubleDoubleSummation bulkSum;
+    bulkSum.addLongs(longValues.data(), longValues.size());
+    ASSERT(bulkSum.getDoubleDouble() == sum.getDoubleDouble());
+    ASSERT(bulkSum.isInteger());
+
+    DoubleDoubleSummation emptySum;
+    emptySum.addLongs(longValues.data(), 0);
+    ASSERT_EQUALS(emptySum.getLong(), 0);
+}
 }  // namespace mongo
@@ -155,6 +155,28 @@ public:
                 sub, "thread_cache_free_bytes", "tcmalloc.thread_cache_free_bytes");
             appendNumericPropertyIfAvailable(
                 sub, "aggressive_memory_decommit", "tcmalloc.aggressive_memory_decommit");
+            sub.append("release_rate", MallocExtension::instance()->GetMemoryReleaseRate());
+
+            // The share of the resident heap which is not allocated, whether it is held by the
+            // caches or by the page heap. A high value after a workload shift means memory is
+            // fragmented or waiting to be released.
+            size_t heapSize;
+            size_t unmapped;
+            size_t allocated;
+            if (MallocExtension::instance()->GetNumericProperty("generic.heap_size",
+                                                                &heapSize) &&
+                MallocExtension::instance()->GetNumericProperty(
+                    "tcmalloc.pageheap_unmapped_bytes", &unmapped) &&
+                MallocExtension::instance()->GetNumericProperty(
+                    "generic.current_allocated_bytes", &allocated) &&
+                heapSize > unmapped) {
+                const size_t resident = heapSize - unmapped;
+                sub.appendNumber("resident_heap_bytes", resident);
+                sub.append("fragmentation_ratio",
+                           resident > allocated
+                               ? static_cast<double>(resident - allocated) / resident
+                               : 0.0);
+            }
 
 #if MONGO_HAVE_GPERFTOOLS_SIZE_CLASS_STATS
             if (verbosity >= 2) {
@@ -128,6 +128,67 @@ TcmallocNumericPropertyServerParameter tcmallocMaxTotalThreadCacheBytesParameter
 TcmallocNumericPropertyServerParameter tcmallocAggressiveMemoryDecommit(
     "tcmallocAggressiveMemoryDecommit", "tcmalloc.aggressive_memory_decommit");
 
+/**
+ * Paces how quickly tcmalloc returns free pages of its page heap to the system, as with the
+ * TCMALLOC_RELEASE_RATE environment variable. 0 never releases memory, and higher values release
+ * it sooner after a workload shift at the cost of more page faults when it is needed again.
+ */
+class TcmallocReleaseRateServerParameter : public ServerParameter {
+    MONGO_DISALLOW_COPYING(TcmallocReleaseRateServerParameter);
+
+public:
+    TcmallocReleaseRateServerParameter()
+        : ServerParameter(ServerParameterSet::getGlobal(),
+                          "tcmallocReleaseRate",
+                          true /* change at startup */,
+                          true /* change at runtime */) {}
+
+    virtual void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) {
+        b.append(name, MallocExtension::instance()->GetMemoryReleaseRate());
+    }
+
+    virtual Status set(const BSONElement& newValueElement) {
+        if (!newValueElement.isNumber()) {
+            return Status(ErrorCodes::TypeMismatch,
+                          str::stream() << "Expected server parameter "
+                                        << newValueElement.fieldName()
+                                        << " to have numeric type, but found "
+                                        << newValueElement.toString(false)
+                                        << " of type "
+                                        << typeName(newValueElement.type()));
+        }
+        return _set(newValueElement.numberDouble());
+    }
+
+    virtual Status setFromString(const std::string& str) {
+        double value;
+        Status status = parseNumberFromString(str, &value);
+        if (!status.isOK()) {
+            return status;
+        }
+        return _set(value);
+    }
+
+private:
+    Status _set(double rate) {
+        // tcmalloc itself accepts any value, but documents 0 to 10 as the useful range.
+        if (!(rate >= 0 && rate <= kMaxReleaseRate)) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "Value " << rate << " is out of range for " << name()
+                                        << "; expected a value between 0 and "
+                                        << kMaxReleaseRate);
+        }
+        if (!RUNNING_ON_VALGRIND) {
+            MallocExtension::instance()->SetMemoryReleaseRate(rate);
+        }
+        return Status::OK();
+    }
+
+    static constexpr double kMaxReleaseRate = 10;
+} tcmallocReleaseRateParameter;
+
+constexpr double TcmallocReleaseRateServerParameter::kMaxReleaseRate;
+
 MONGO_INITIALIZER_GENERAL(TcmallocConfigurationDefaults,
                           ("SystemInfo"),
                           ("BeginStartupOptionHandling"))
@@ -335,6 +335,12 @@ Date_t jsTime();
 unsigned long long curTimeMicros64();
 unsigned long long curTimeMillis64();
 
+/**
+ * Returns the CPU time used so far by the calling thread, in microseconds, or -1 if it can't be
+ * measured on this platform.
+ */
+long long curThreadCpuTimeMicros64();
+
 // these are so that if you use one of them compilation will fail
 char* asctime(const struct tm* tm);
 char* ctime(const time_t* timep);
@@ -29,11 +29,18 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <type_traits>
 
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#endif
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -55,6 +62,12 @@ namespace mongo {
  *     const K_L& key() const;
  *     uint32_t hash() const; // Should be free to call repeatedly.
  * };
+ *
+ * The table uses open addressing. Besides the entries, it keeps one control byte per slot, which
+ * is either empty, deleted, or holds 7 bits of the hash of the slot's key. Lookups probe groups of
+ * 16 slots at a time by comparing the group's control bytes against the key's 7 bits, with SSE2 on
+ * x86-64, and only look at entries whose control bytes match. A lookup ends at the first group
+ * with an empty slot.
  */
 template <typename K_L,  // key lookup
           typename K_S,  // key storage
@@ -74,8 +87,7 @@ private:
     public:
         Entry() = default;
 
-        Entry(const Entry& other)
-            : _used(other._used), _everUsed(other.everUsed), _curHash(other._curHash) {
+        Entry(const Entry& other) : _used(other._used), _curHash(other._curHash) {
             if (other.isUsed()) {
                 new (&_data) value_type(other.getData());
             }
@@ -91,7 +103,6 @@ private:
             }
 
             _used = other._used;
-            _everUsed = other._everUsed;
             _curHash = other._curHash;
 
             if (other.isUsed()) {
@@ -111,7 +122,6 @@ private:
         void emplaceData(const HashedKey& key, Args&&... args) {
             dassert(!isUsed());
             _used = true;
-            _everUsed = true;
             _curHash = key.hash();
             new (&_data) value_type(std::piecewise_construct,
                                     std::forward_as_tuple(Traits::toStorage(key.key())),
@@ -122,10 +132,6 @@ private:
             return _used;
         }
 
-        bool wasEverUsed() const {
-            return _everUsed;
-        }
-
         uint32_t getCurHash() const {
             dassert(isUsed());
             return _curHash;
@@ -149,25 +155,41 @@ private:
 
     private:
         bool _used = false;
-        bool _everUsed = false;
         uint32_t _curHash;
         typename std::aligned_storage<sizeof(value_type),
                                       std::alignment_of<value_type>::value>::type _data;
     };
 
     struct Area {
+        // Slots are probed in groups of this many.
+        static const unsigned kGroupSize = 16;
+
+        // Control bytes of slots without an entry. Those of slots with one hold the top 7 bits of
+        // the entry's hash, so the high bit is only set for kEmpty and kDeleted.
+        static const uint8_t kEmpty = 0x80;
+        static const uint8_t kDeleted = 0xFE;
+
         Area() = default;  // TODO constexpr
 
         Area(unsigned capacity, unsigned maxProbe)
             : _hashMask(capacity - 1),
               _maxProbe(maxProbe),
-              _entries(capacity ? new Entry[capacity] : nullptr) {
-            // Capacity must be a power of two or zero. See the comment on _hashMask for why.
+              _entries(capacity ? new Entry[capacity] : nullptr),
+              _control(capacity ? new uint8_t[capacity] : nullptr) {
+            // Capacity must be a power of two or zero. See the comment on _hashMask for why. It
+            // must also be a whole number of groups.
             dassert((capacity & (capacity - 1)) == 0);
+            dassert(capacity % kGroupSize == 0);
+            if (capacity) {
+                memset(_control.get(), kEmpty, capacity);
+            }
         }
 
         Area(const Area& other) : Area(other.capacity(), other._maxProbe) {
             std::copy(other.begin(), other.end(), begin());
+            if (capacity()) {
+                memcpy(_control.get(), other._control.get(), capacity());
+            }
         }
 
         Area& operator=(const Area& other) {
@@ -179,11 +201,65 @@ private:
 
         bool transfer(Area* newArea) const;
 
+        /**
+         * Constructs the entry at 'pos', which must be free, and marks the slot as used.
+         */
+        template <typename... Args>
+        void emplace(int pos, const HashedKey& key, Args&&... args) {
+            _entries[pos].emplaceData(key, std::forward<Args>(args)...);
+            _control[pos] = hashTag(key.hash());
+        }
+
+        /**
+         * Destroys the entry at 'pos'. The slot is marked deleted rather than empty, so that
+         * lookups of keys placed after it keep probing past it.
+         */
+        void erase(int pos) {
+            _entries[pos].unUse();
+            _control[pos] = kDeleted;
+        }
+
         void swap(Area* other) {
             using std::swap;
             swap(_hashMask, other->_hashMask);
             swap(_maxProbe, other->_maxProbe);
             swap(_entries, other->_entries);
+            swap(_control, other->_control);
+        }
+
+        static uint8_t hashTag(uint32_t hash) {
+            return hash >> 25;
+        }
+
+        /**
+         * Returns a mask with bit i set if group[i] is 'tag'.
+         */
+        static uint32_t matchTag(const uint8_t* group, uint8_t tag) {
+#if defined(_M_AMD64) || defined(__amd64__)
+            const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(tag)));
+#else
+            uint32_t mask = 0;
+            for (unsigned i = 0; i < kGroupSize; ++i) {
+                mask |= uint32_t(group[i] == tag) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /**
+         * Returns a mask with bit i set if the slot of group[i] is empty or deleted.
+         */
+        static uint32_t matchFree(const uint8_t* group) {
+#if defined(_M_AMD64) || defined(__amd64__)
+            return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+            uint32_t mask = 0;
+            for (unsigned i = 0; i < kGroupSize; ++i) {
+                mask |= uint32_t(group[i] >> 7) << i;
+            }
+            return mask;
+#endif
         }
 
         unsigned capacity() const {
@@ -209,8 +285,9 @@ private:
         // store it directly and derive the capacity from it. The default capacity is 0 so the
         // default hashMask is -1.
         unsigned _hashMask = -1;
-        unsigned _maxProbe = 0;
+        unsigned _maxProbe = 0;  // the number of groups probed before giving up
         std::unique_ptr<Entry[]> _entries = {};
+        std::unique_ptr<uint8_t[]> _control = {};
     };
 
 public:
@@ -40,34 +40,31 @@ inline int UnorderedFastKeyTable<K_L, K_S, V, Traits>::Area::find(const HashedKe
     dassert(capacity());                        // Caller must special-case empty tables.
     dassert(!firstEmpty || *firstEmpty == -1);  // Caller must initialize *firstEmpty.
 
-    unsigned probe = 0;
-    do {
-        unsigned pos = (key.hash() + probe) & _hashMask;
-
-        if (!_entries[pos].isUsed()) {
-            // space is empty
-            if (firstEmpty && *firstEmpty == -1)
-                *firstEmpty = pos;
-            if (!_entries[pos].wasEverUsed())
-                return -1;
-            continue;
+    const uint8_t tag = hashTag(key.hash());
+    unsigned group = key.hash() & _hashMask & ~(kGroupSize - 1);
+    for (unsigned probe = 0; probe < _maxProbe; ++probe) {
+        const uint8_t* control = &_control[group];
+
+        for (uint32_t candidates = matchTag(control, tag); candidates;
+             candidates &= candidates - 1) {
+            const unsigned pos = group + countTrailingZeros64(candidates);
+            if (_entries[pos].getCurHash() == key.hash() &&
+                Traits::equals(key.key(), Traits::toLookup(_entries[pos].getData().first))) {
+                return pos;
+            }
         }
 
-        if (_entries[pos].getCurHash() != key.hash()) {
-            // space has something else
-            continue;
-        }
+        const uint32_t freeSlots = matchFree(control);
+        if (firstEmpty && *firstEmpty == -1 && freeSlots)
+            *firstEmpty = group + countTrailingZeros64(freeSlots);
 
-        if (!Traits::equals(key.key(), Traits::toLookup(_entries[pos].getData().first))) {
-            // hashes match
-            // strings are not equals
-            continue;
-        }
+        // The key would have been placed in this group's empty slot if it were not in an
+        // earlier group.
+        if (matchTag(control, kEmpty))
+            return -1;
 
-        // hashes and strings are equal
-        // yay!
-        return pos;
-    } while (++probe < _maxProbe);
+        group = (group + kGroupSize) & _hashMask;
+    }
     return -1;
 }
 
@@ -87,6 +84,7 @@ inline bool UnorderedFastKeyTable<K_L, K_S, V, Traits>::Area::transfer(Area* new
         }
 
         newArea->_entries[firstEmpty] = entry;
+        newArea->_control[firstEmpty] = hashTag(entry.getCurHash());
     }
     return true;
 }
@@ -121,7 +119,7 @@ inline size_t UnorderedFastKeyTable<K_L, K_S, V, Traits>::erase(const HashedKey&
         return 0;
 
     --_size;
-    _area._entries[pos].unUse();
+    _area.erase(pos);
     return 1;
 }
 
@@ -131,7 +129,7 @@ void UnorderedFastKeyTable<K_L, K_S, V, Traits>::erase(const_iterator it) {
     dassert(it._area == &_area);
 
     --_size;
-    _area._entries[it._position].unUse();
+    _area.erase(it._position);
 }
 
 template <typename K_L, typename K_S, typename V, typename Traits>
@@ -156,10 +154,16 @@ inline auto UnorderedFastKeyTable<K_L, K_S, V, Traits>::try_emplace(const Hashed
         }
 
         // key not in map
-        // need to add
+        // need to add, unless the table is full enough that probes would get long
+        const size_t kMaxLoadEighths = 7;
+        if (firstEmpty >= 0 && _size + 1 > _area.capacity() / 8 * kMaxLoadEighths) {
+            _grow();
+            continue;
+        }
+
         if (firstEmpty >= 0) {
             _size++;
-            _area._entries[firstEmpty].emplaceData(key, std::forward<Args>(args)...);
+            _area.emplace(firstEmpty, key, std::forward<Args>(args)...);
             return {iterator(&_area, firstEmpty), true};
         }
 
@@ -181,7 +185,7 @@ inline void UnorderedFastKeyTable<K_L, K_S, V, Traits>::_grow() {
         }
 
         const double kMaxProbeRatio = 0.05;
-        unsigned maxProbes = (capacity * kMaxProbeRatio) + 1;  // Round up
+        unsigned maxProbes = (capacity / Area::kGroupSize * kMaxProbeRatio) + 1;  // Round up
 
         Area newArea(capacity, maxProbes);
         bool success = _area.transfer(&newArea);